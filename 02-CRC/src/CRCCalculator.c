@@ -38,8 +38,20 @@
 #include <stdlib.h>
 /*## dependency string */
 #include <string.h>
+#include "CRCCalculator.h"
 
-static unsigned short crc_table[256] = {
+/* the carry-less-multiply kernel needs GCC/Clang builtins on x86-64; it is
+   only entered after a runtime check for PCLMULQDQ and SSSE3 */
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CRC_HAVE_CLMUL_KERNEL 1
+#else
+#define CRC_HAVE_CLMUL_KERNEL 0
+#endif
+
+#define CRC_POLY (0x11021u)
+
+static const unsigned short crc_table[256] = {
         0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5,
         0x60c6, 0x70e7, 0x8108, 0x9129, 0xa14a, 0xb16b,
         0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210,
@@ -85,14 +97,186 @@ static unsigned short crc_table[256] = {
         0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
 };
 
+/* crc_slice[k][v] is the CRC of byte v followed by k zero bytes, so eight
+   lookups advance the CRC by eight bytes; crc_slice[0] equals crc_table */
+static unsigned short crc_slice[8][256];
+/* appending n zero bytes multiplies a CRC by x^(8n) mod P: crc_zeros[n] holds
+   it for short runs, crc_zeros_pow[k] for runs of 2^k * CRC_ZEROS_TABLE bytes */
+#define CRC_ZEROS_TABLE (256)
+static unsigned short crc_zeros[CRC_ZEROS_TABLE];
+static unsigned short crc_zeros_pow[56];
+/* x^192 mod P and x^128 mod P fold a 128-bit block into the next one */
+static unsigned short crc_fold_192;
+static unsigned short crc_fold_128;
+static int crc_clmul_supported;
+
+static void buildTables(void) __attribute__((constructor));
+static unsigned short xPowMod(unsigned int n);
+static unsigned short mulMod(unsigned short a, unsigned short b);
+static unsigned short crcBytewise(unsigned int crc, const unsigned char * data, size_t length);
+static unsigned short crcSlicing8(unsigned int crc, const unsigned char * data, size_t length);
+static unsigned short appendZeros(unsigned short crc, size_t count);
+#if CRC_HAVE_CLMUL_KERNEL
+static unsigned short crcClmul(unsigned int crc, const unsigned char * data, size_t length);
+#endif
+
 unsigned short computeCRC(unsigned char * data, size_t length, unsigned short seed, unsigned short final) {
-    unsigned int crc = seed;
+#if CRC_HAVE_CLMUL_KERNEL
+    if (length >= CRC_CLMUL_MIN_LENGTH && crc_clmul_supported)
+        return (unsigned short)(crcClmul(seed, data, length) ^ final);
+#endif
+    return (unsigned short)(crcSlicing8(seed, data, length) ^ final);
+}
+
+unsigned short computeCRC_bytewise(const unsigned char * data, size_t length, unsigned short seed, unsigned short final) {
+    return (unsigned short)(crcBytewise(seed, data, length) ^ final);
+}
+
+unsigned short computeCRC_slicing8(const unsigned char * data, size_t length, unsigned short seed, unsigned short final) {
+    return (unsigned short)(crcSlicing8(seed, data, length) ^ final);
+}
+
+unsigned short computeCRC_clmul(const unsigned char * data, size_t length, unsigned short seed, unsigned short final) {
+#if CRC_HAVE_CLMUL_KERNEL
+    if (length >= 16 && crc_clmul_supported)
+        return (unsigned short)(crcClmul(seed, data, length) ^ final);
+#endif
+    return (unsigned short)(crcSlicing8(seed, data, length) ^ final);
+}
+
+int CRC_hasClmul(void) {
+    return crc_clmul_supported;
+}
+
+/* The CRC is linear in the data for a fixed length, so
+   crc(new) = crc(old) ^ crc0(old ^ new), where crc0 has zero seed and final.
+   old ^ new is zero outside the changed bytes: leading zeros leave crc0 at
+   zero and each trailing zero byte multiplies it by x^8 mod P. */
+unsigned short updateCRC(unsigned short crc, size_t recordLength, size_t offset,
+                         const unsigned char * oldBytes, const unsigned char * newBytes, size_t length) {
+    unsigned char chunk[64];
+    unsigned int delta = 0;
+
+    while (length > 0) {
+        size_t count = length < sizeof(chunk) ? length : sizeof(chunk);
+        for (size_t i = 0; i < count; ++i)
+            chunk[i] = oldBytes[i] ^ newBytes[i];
+        delta = crcSlicing8(delta, chunk, count);
+        oldBytes += count;
+        newBytes += count;
+        length -= count;
+        offset += count;
+    }
+    return (unsigned short)(crc ^ appendZeros((unsigned short)delta, recordLength - offset));
+}
+
+static void buildTables(void) {
+    for (int v = 0; v < 256; ++v) {
+        crc_slice[0][v] = crc_table[v];
+        for (int k = 1; k < 8; ++k) {
+            unsigned int prev = crc_slice[k - 1][v];
+            crc_slice[k][v] = (unsigned short)((prev << 8) ^ crc_table[prev >> 8]);
+        }
+    }
+    crc_zeros[0] = 1;
+    for (int n = 1; n < CRC_ZEROS_TABLE; ++n)
+        crc_zeros[n] = mulMod(crc_zeros[n - 1], 0x100);
+    crc_zeros_pow[0] = mulMod(crc_zeros[CRC_ZEROS_TABLE - 1], 0x100);
+    for (int k = 1; k < 56; ++k)
+        crc_zeros_pow[k] = mulMod(crc_zeros_pow[k - 1], crc_zeros_pow[k - 1]);
+    crc_fold_192 = xPowMod(192);
+    crc_fold_128 = xPowMod(128);
+#if CRC_HAVE_CLMUL_KERNEL
+    __builtin_cpu_init();
+    crc_clmul_supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#endif
+}
+
+/* one multiply for records up to CRC_ZEROS_TABLE bytes past the change */
+static unsigned short appendZeros(unsigned short crc, size_t count) {
+    size_t runs = count / CRC_ZEROS_TABLE;
+
+    for (int k = 0; runs != 0 && crc != 0; ++k, runs >>= 1) {
+        if (runs & 1u)
+            crc = mulMod(crc, crc_zeros_pow[k]);
+    }
+    return crc == 0 ? 0 : mulMod(crc, crc_zeros[count % CRC_ZEROS_TABLE]);
+}
+
+static unsigned short xPowMod(unsigned int n) {
+    unsigned int r = 1;
+    while (n--) {
+        r <<= 1;
+        if (r & 0x10000u)
+            r ^= CRC_POLY;
+    }
+    return (unsigned short)r;
+}
+
+/* a * b mod P: carry-less multiply, then reduce the high half through the
+   table, which holds h * x^16 mod P for each byte h */
+static unsigned short mulMod(unsigned short a, unsigned short b) {
+    unsigned int product = 0;
+    unsigned int high;
+    unsigned int crc;
+
+    for (int bit = 15; bit >= 0; --bit)
+        product = (product << 1) ^ (a & (0u - ((b >> bit) & 1u)));
+    high = product >> 16;
+    crc = crc_table[high >> 8];
+    crc = (crc_table[(high ^ (crc >> 8)) & 0xff] ^ (crc << 8)) & 0xffff;
+    return (unsigned short)(crc ^ (product & 0xffff));
+}
+
+static unsigned short crcBytewise(unsigned int crc, const unsigned char * data, size_t length) {
     unsigned int temp;
 
     for (size_t count = 0; count < length; ++count)
     {
         temp = (*data++ ^ (crc >> 8)) & 0xff;
-        crc = crc_table[temp] ^ (crc << 8);
+        crc = (crc_table[temp] ^ (crc << 8)) & 0xffff;
+    }
+    return (unsigned short)crc;
+}
+
+static unsigned short crcSlicing8(unsigned int crc, const unsigned char * data, size_t length) {
+    while (length >= 8) {
+        crc = crc_slice[7][data[0] ^ (crc >> 8)] ^ crc_slice[6][data[1] ^ (crc & 0xff)] ^
+              crc_slice[5][data[2]] ^ crc_slice[4][data[3]] ^ crc_slice[3][data[4]] ^
+              crc_slice[2][data[5]] ^ crc_slice[1][data[6]] ^ crc_slice[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    return crcBytewise(crc, data, length);
+}
+
+#if CRC_HAVE_CLMUL_KERNEL
+/* Treats each 16-byte block as a 128-bit polynomial, first byte highest, and
+   folds the running block into the next: X * x^128 + B with
+   X * x^128 = Xhi * x^192 + Xlo * x^128 == Xhi * (x^192 mod P) + Xlo * (x^128 mod P).
+   The seed enters as an xor into the first two bytes, and the last folded
+   block plus the tail go through slicing-by-8. Needs length >= 16. */
+__attribute__((target("pclmul,ssse3")))
+static unsigned short crcClmul(unsigned int crc, const unsigned char * data, size_t length) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i fold = _mm_set_epi64x(crc_fold_192, crc_fold_128);
+    unsigned char block[16];
+    __m128i x;
+
+    memcpy(block, data, sizeof(block));
+    block[0] ^= (unsigned char)(crc >> 8);
+    block[1] ^= (unsigned char)crc;
+    x = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block), reverse);
+    data += 16;
+    length -= 16;
+    while (length >= 16) {
+        __m128i next = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data), reverse);
+        x = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, fold, 0x11), _mm_clmulepi64_si128(x, fold, 0x00)),
+                          next);
+        data += 16;
+        length -= 16;
     }
-    return (unsigned short)(crc ^ final);
+    _mm_storeu_si128((__m128i *)block, _mm_shuffle_epi8(x, reverse));
+    return crcSlicing8(crcSlicing8(0, block, sizeof(block)), data, length);
 }
+#endif
@@ -0,0 +1,33 @@
+//
+// CRC-CCITT (polynomial 0x1021, non-reflected) engine
+//
+
+#ifndef INC_02_CRC_CRCCALCULATOR_H
+#define INC_02_CRC_CRCCALCULATOR_H
+
+#include <stddef.h>
+
+/* CRC of length bytes starting from seed, xor'ed with final. Uses the
+   carry-less-multiply kernel on CPUs with PCLMULQDQ for buffers of at least
+   CRC_CLMUL_MIN_LENGTH bytes, slicing-by-8 otherwise. */
+unsigned short computeCRC(unsigned char * data, size_t length, unsigned short seed, unsigned short final);
+
+/* the individual kernels, all giving the same result as computeCRC */
+unsigned short computeCRC_bytewise(const unsigned char * data, size_t length, unsigned short seed, unsigned short final);
+unsigned short computeCRC_slicing8(const unsigned char * data, size_t length, unsigned short seed, unsigned short final);
+unsigned short computeCRC_clmul(const unsigned char * data, size_t length, unsigned short seed, unsigned short final);
+
+/* nonzero if computeCRC_clmul runs the PCLMULQDQ kernel on this CPU;
+   otherwise it falls back to slicing-by-8 */
+int CRC_hasClmul(void);
+
+/* CRC of a recordLength-byte record after the length bytes at offset change
+   from oldBytes to newBytes, given its CRC before the change. Costs
+   O(length + log(recordLength)), independent of the rest of the record.
+   Seed and final are unchanged by construction. */
+unsigned short updateCRC(unsigned short crc, size_t recordLength, size_t offset,
+                         const unsigned char * oldBytes, const unsigned char * newBytes, size_t length);
+
+#define CRC_CLMUL_MIN_LENGTH (64)
+
+#endif //INC_02_CRC_CRCCALCULATOR_H
@@ -4,10 +4,34 @@
 
 #include "PatientData.h"
 #include "AlarmManager.h"
+#include "CRCCalculator.h"
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include "PatientData.h"
+
+#define FIELD(member) { offsetof(PatientDataType, member), sizeof(((PatientDataType *)0)->member) }
+
+/* where each PatientDataField lives inside PatientDataType */
+static const struct {
+    size_t offset;
+    size_t size;
+} fieldLayout[PD_FIELD_COUNT] = {
+    FIELD(age),
+    FIELD(bloodO2Conc),
+    FIELD(diastolicBP),
+    FIELD(gender),
+    FIELD(heartRate),
+    FIELD(name),
+    FIELD(patientID),
+    FIELD(systolicBP),
+    FIELD(temperature),
+    FIELD(weight)
+};
+
 static void cleanUpRelations(PatientData* const me);
+static unsigned short fieldCRC(PatientData* const me, PatientDataField field);
+static void setField(PatientData* const me, PatientDataField field, const void* value);
 
 void PatientData_Init(PatientData* const me) {
     me->itsAlarmManager = NULL;
@@ -22,6 +46,8 @@ void PatientData_Init(PatientData* const me) {
     me->pData.heartRate = 0;
     me->pData.bloodO2Conc = 0;
     me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
+    for (int field = 0; field < PD_FIELD_COUNT; ++field)
+        me->fieldCRC[field] = fieldCRC(me, (PatientDataField)field);
 }
 
 void PatientData_Cleanup(PatientData* const me) {
@@ -35,12 +61,16 @@ int PatientData_checkData(PatientData* const me) {
 
 }
 
+int PatientData_checkField(PatientData* const me, PatientDataField field) {
+    return fieldCRC(me, field) == me->fieldCRC[field];
+}
+
 void PatientData_errorHandler(PatientData* const me, ErrorCodeType errCode) {
     AlarmManager_addAlarm(me->itsAlarmManager, errCode);
 }
 
 unsigned short PatientData_getAge(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_AGE))
         return me->pData.age;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -49,7 +79,7 @@ unsigned short PatientData_getAge(PatientData* const me) {
 }
 
 unsigned short PatientData_getBloodO2Conc(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_BLOOD_O2_CONC))
         return me->pData.bloodO2Conc;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -58,7 +88,7 @@ unsigned short PatientData_getBloodO2Conc(PatientData* const me) {
 }
 
 unsigned short PatientData_getDiastolicBP(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_DIASTOLIC_BP))
         return me->pData.diastolicBP;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -67,7 +97,7 @@ unsigned short PatientData_getDiastolicBP(PatientData* const me) {
 }
 
 GenderType PatientData_getGender(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_GENDER))
         return me->pData.gender;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -76,7 +106,7 @@ GenderType PatientData_getGender(PatientData* const me) {
 }
 
 char* PatientData_getName(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_NAME))
         return me->pData.name;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -85,7 +115,7 @@ char* PatientData_getName(PatientData* const me) {
 }
 
 unsigned long PatientData_getPatientID(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_PATIENT_ID))
         return me->pData.patientID;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -94,7 +124,7 @@ unsigned long PatientData_getPatientID(PatientData* const me) {
 }
 
 unsigned short PatientData_getSystolicBP(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_SYSTOLIC_BP))
         return me->pData.systolicBP;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -103,7 +133,7 @@ unsigned short PatientData_getSystolicBP(PatientData* const me) {
 }
 
 unsigned short PatientData_getTemperature(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_TEMPERATURE))
         return me->pData.temperature;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -112,7 +142,7 @@ unsigned short PatientData_getTemperature(PatientData* const me) {
 }
 
 double PatientData_getWeight(PatientData* const me) {
-    if (PatientData_checkData(me))
+    if (PatientData_checkField(me, PD_WEIGHT))
         return me->pData.weight;
     else {
         PatientData_errorHandler(me, CORRUPT_DATA);
@@ -121,120 +151,47 @@ double PatientData_getWeight(PatientData* const me) {
 }
 
 void PatientData_setAge(PatientData* const me, unsigned short a) {
-    if (PatientData_checkData(me)) {
-        me->pData.age = a;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_AGE, &a);
 }
 
 void PatientData_setBloodO2Conc(PatientData* const me, unsigned short o2) {
-    if (PatientData_checkData(me)) {
-        me->pData.bloodO2Conc = o2;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_BLOOD_O2_CONC, &o2);
 }
 
 void PatientData_setDiastolicBP(PatientData* const me, unsigned short dBP) {
-    if (PatientData_checkData(me)) {
-        me->pData.diastolicBP = dBP;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_DIASTOLIC_BP, &dBP);
 }
 
 void PatientData_setGender(PatientData* const me, GenderType g) {
-    if (PatientData_checkData(me)) {
-        me->pData.gender = g;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_GENDER, &g);
 }
 
 void PatientData_setName(PatientData* const me, char* n) {
-    if (PatientData_checkData(me)) {
-        strcpy(me->pData.name, n);
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    char name[sizeof(me->pData.name)];
+    size_t length = strlen(n);
+
+    if (length >= sizeof(name))
+        length = sizeof(name) - 1;
+    memcpy(name, me->pData.name, sizeof(name));
+    memcpy(name, n, length);
+    name[length] = '\0';
+    setField(me, PD_NAME, name);
 }
 
 void PatientData_setPatientID(PatientData* const me, unsigned long id) {
-    if (PatientData_checkData(me)) {
-        me->pData.patientID = id;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_PATIENT_ID, &id);
 }
 
 void PatientData_setSystolicBP(PatientData* const me, unsigned short sBP) {
-    if (PatientData_checkData(me)) {
-        me->pData.systolicBP = sBP;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_SYSTOLIC_BP, &sBP);
 }
 
 void PatientData_setTemperature(PatientData* const me, unsigned short t) {
-    if (PatientData_checkData(me)) {
-        me->pData.temperature = t;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_TEMPERATURE, &t);
 }
 
 void PatientData_setWeight(PatientData* const me, double w) {
-    if (PatientData_checkData(me)) {
-        me->pData.weight = w;
-        me->crc = computeCRC((unsigned char *)&me->pData, sizeof(me->pData), 0xffff, 0);
-        if (!PatientData_checkData(me))
-            PatientData_errorHandler(me, CORRUPT_DATA);
-    }
-    else  {
-        printf("Set failed\n");
-        PatientData_errorHandler(me, CORRUPT_DATA);
-    };
+    setField(me, PD_WEIGHT, &w);
 }
 
 struct AlarmManager* PatientData_getItsAlarmManager(const PatientData* const me) {
@@ -258,6 +215,27 @@ void PatientData_Destroy(PatientData* const me) {
     free(me);
 }
 
+static unsigned short fieldCRC(PatientData* const me, PatientDataField field) {
+    return computeCRC((unsigned char *)&me->pData + fieldLayout[field].offset, fieldLayout[field].size, 0xffff, 0);
+}
+
+/* checks the field, then patches the record CRC for the changed bytes and
+   recomputes the field CRC, so the cost is O(field) rather than O(record) */
+static void setField(PatientData* const me, PatientDataField field, const void* value) {
+    unsigned char* bytes = (unsigned char *)&me->pData + fieldLayout[field].offset;
+
+    if (PatientData_checkField(me, field)) {
+        me->crc = updateCRC(me->crc, sizeof(me->pData), fieldLayout[field].offset, bytes,
+                            (const unsigned char *)value, fieldLayout[field].size);
+        memcpy(bytes, value, fieldLayout[field].size);
+        me->fieldCRC[field] = fieldCRC(me, field);
+    }
+    else  {
+        printf("Set failed\n");
+        PatientData_errorHandler(me, CORRUPT_DATA);
+    };
+}
+
 static void cleanUpRelations(PatientData* const me) {
     if(me->itsAlarmManager != NULL)
         me->itsAlarmManager = NULL;
@@ -8,10 +8,27 @@
 #include "CRCExample.h"
 struct AlarmManager;
 
+/* fields of PatientDataType, each guarded by its own CRC so a get or set
+   only has to check the bytes it touches */
+typedef enum PatientDataField {
+    PD_AGE,
+    PD_BLOOD_O2_CONC,
+    PD_DIASTOLIC_BP,
+    PD_GENDER,
+    PD_HEART_RATE,
+    PD_NAME,
+    PD_PATIENT_ID,
+    PD_SYSTOLIC_BP,
+    PD_TEMPERATURE,
+    PD_WEIGHT,
+    PD_FIELD_COUNT
+} PatientDataField;
+
 typedef struct PatientData PatientData;
 struct PatientData {
     PatientDataType pData;
-    unsigned short crc;
+    unsigned short crc;                        /* whole record, kept current incrementally */
+    unsigned short fieldCRC[PD_FIELD_COUNT];
     struct AlarmManager* itsAlarmManager;
 };
 
@@ -57,8 +74,12 @@ void PatientData_setTemperature(PatientData* const me, unsigned short t);
 
 void PatientData_setWeight(PatientData* const me, double w);
 
+/* verifies the whole record against crc */
 int PatientData_checkData(PatientData* const me);
 
+/* verifies one field against its own CRC */
+int PatientData_checkField(PatientData* const me, PatientDataField field);
+
 struct AlarmManager* PatientData_getItsAlarmManager(const PatientData* const me);
 
 void PatientData_setItsAlarmManager(PatientData* const me, struct AlarmManager* p_AlarmManager);
@@ -0,0 +1,169 @@
+//
+// Per-access cost of PatientData getters and setters
+//
+// The legacy accessors checked the whole PatientDataType with a byte-at-a-time
+// CRC on every get and three times per set. This benchmark times that scheme,
+// the same scheme on the slicing-by-8 and carry-less-multiply kernels, and the
+// current field-CRC accessors that only touch the bytes of the field.
+//
+// Categories:
+// - Whole-record CRC throughput per kernel
+// - Legacy get/set cost (whole-record checks) per kernel
+// - Field-CRC get/set cost (PatientData API)
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+
+#include "PatientData.h"
+#include "AlarmManager.h"
+#include "CRCCalculator.h"
+
+#define ITERATIONS 2000000L
+
+typedef unsigned short (*CRCKernel)(const unsigned char * data, size_t length, unsigned short seed, unsigned short final);
+
+static PatientData patient;
+static volatile unsigned long sink;
+
+/* AlarmManager has no implementation in this tree; nothing should raise one */
+void AlarmManager_addAlarm(AlarmManager* const me, ErrorCodeType errCode) {
+    (void)me;
+    (void)errCode;
+    TEST_FAIL_MESSAGE("unexpected alarm");
+}
+
+void setUp(void) {
+    PatientData_Init(&patient);
+    PatientData_setName(&patient, "Jane Q. Public");
+}
+
+void tearDown(void) {
+    PatientData_Cleanup(&patient);
+}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int legacyCheck(CRCKernel kernel) {
+    return kernel((unsigned char *)&patient.pData, sizeof(patient.pData), 0xffff, 0) == patient.crc;
+}
+
+/**
+ * @brief The old getAge: check the whole record, then read
+ */
+static unsigned short legacyGetAge(CRCKernel kernel) {
+    return legacyCheck(kernel) ? patient.pData.age : 0;
+}
+
+/**
+ * @brief The old setAge: check, write, recompute, check again
+ */
+static void legacySetAge(CRCKernel kernel, unsigned short age) {
+    if (legacyCheck(kernel)) {
+        patient.pData.age = age;
+        patient.crc = kernel((unsigned char *)&patient.pData, sizeof(patient.pData), 0xffff, 0);
+        sink += !legacyCheck(kernel);
+    }
+}
+
+static void reportLegacy(const char* label, CRCKernel kernel) {
+    double start = nowNanos();
+    for (long i = 0; i < ITERATIONS; i++) {
+        sink += legacyGetAge(kernel);
+    }
+    double get = (nowNanos() - start) / ITERATIONS;
+
+    start = nowNanos();
+    for (long i = 0; i < ITERATIONS; i++) {
+        legacySetAge(kernel, (unsigned short)i);
+    }
+    double set = (nowNanos() - start) / ITERATIONS;
+    printf("%-28s get %7.1f ns  set %7.1f ns\n", label, get, set);
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void test_Performance_RecordThroughput(void) {
+    static const struct {
+        const char* label;
+        CRCKernel kernel;
+    } kernels[] = {
+        {"bytewise", computeCRC_bytewise},
+        {"slicing-by-8", computeCRC_slicing8},
+        {"clmul", computeCRC_clmul},
+    };
+
+    printf("record is %zu bytes, PCLMULQDQ %s\n", sizeof(PatientDataType),
+           CRC_hasClmul() ? "available" : "not available (clmul falls back to slicing-by-8)");
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        double start = nowNanos();
+        for (long i = 0; i < ITERATIONS; i++) {
+            sink += kernels[k].kernel((unsigned char *)&patient.pData, sizeof(patient.pData), 0xffff, 0);
+        }
+        double elapsed = (nowNanos() - start) / ITERATIONS;
+        printf("%-28s %7.1f ns/record  %6.2f bytes/ns\n", kernels[k].label, elapsed,
+               sizeof(PatientDataType) / elapsed);
+    }
+}
+
+void test_Performance_LegacyAccessors(void) {
+    reportLegacy("whole record, bytewise:", computeCRC_bytewise);
+    reportLegacy("whole record, slicing-by-8:", computeCRC_slicing8);
+    reportLegacy("whole record, clmul:", computeCRC_clmul);
+    TEST_ASSERT_TRUE(PatientData_checkField(&patient, PD_NAME));
+}
+
+void test_Performance_FieldAccessors(void) {
+    double start = nowNanos();
+    for (long i = 0; i < ITERATIONS; i++) {
+        sink += PatientData_getAge(&patient);
+    }
+    double get = (nowNanos() - start) / ITERATIONS;
+
+    start = nowNanos();
+    for (long i = 0; i < ITERATIONS; i++) {
+        PatientData_setAge(&patient, (unsigned short)i);
+    }
+    double set = (nowNanos() - start) / ITERATIONS;
+    printf("%-28s get %7.1f ns  set %7.1f ns\n", "field CRC (getAge/setAge):", get, set);
+
+    start = nowNanos();
+    for (long i = 0; i < ITERATIONS; i++) {
+        PatientData_setName(&patient, (i & 1) ? "Jane Q. Public" : "John Q. Public");
+    }
+    printf("%-28s         %13s set %7.1f ns\n", "field CRC (setName):", "", (nowNanos() - start) / ITERATIONS);
+
+    TEST_ASSERT_EQUAL_UINT16((unsigned short)(ITERATIONS - 1), patient.pData.age);
+    TEST_ASSERT_EQUAL_HEX16(computeCRC((unsigned char *)&patient.pData, sizeof(patient.pData), 0xffff, 0), patient.crc);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== PatientData CRC Benchmark ===\n");
+    RUN_TEST(test_Performance_RecordThroughput);
+    RUN_TEST(test_Performance_LegacyAccessors);
+    RUN_TEST(test_Performance_FieldAccessors);
+
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <string.h>
+#include <unity.h>
+
+#include "PatientData.h"
+#include "AlarmManager.h"
+#include "CRCCalculator.h"
+
+static int alarms;
+static unsigned char buffer[1024];
+static PatientData patient;
+
+/* AlarmManager has no implementation in this tree; count what it is told */
+void AlarmManager_addAlarm(AlarmManager* const me, ErrorCodeType errCode) {
+    (void)me;
+    (void)errCode;
+    alarms++;
+}
+
+void setUp(void) {
+    unsigned int state = 12345u;
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        state = state * 1103515245u + 12345u;
+        buffer[i] = (unsigned char)(state >> 16);
+    }
+    alarms = 0;
+    PatientData_Init(&patient);
+}
+
+void tearDown(void) {
+    PatientData_Cleanup(&patient);
+}
+
+void test_crc_matches_ccitt_check_value(void) {
+    TEST_ASSERT_EQUAL_HEX16(0x29b1, computeCRC((unsigned char *)"123456789", 9, 0xffff, 0));
+}
+
+void test_crc_kernels_agree_for_every_length(void) {
+    for (size_t length = 0; length <= 300; length++) {
+        unsigned short expected = computeCRC_bytewise(buffer, length, 0xffff, 0);
+        TEST_ASSERT_EQUAL_HEX16(expected, computeCRC_slicing8(buffer, length, 0xffff, 0));
+        TEST_ASSERT_EQUAL_HEX16(expected, computeCRC_clmul(buffer, length, 0xffff, 0));
+        TEST_ASSERT_EQUAL_HEX16(expected ^ 0x5a5a, computeCRC(buffer, length, 0xffff, 0x5a5a));
+    }
+}
+
+void test_crc_kernels_agree_on_unaligned_data(void) {
+    for (size_t start = 1; start < 16; start++) {
+        unsigned short expected = computeCRC_bytewise(buffer + start, 500, 0x1d0f, 0);
+        TEST_ASSERT_EQUAL_HEX16(expected, computeCRC(buffer + start, 500, 0x1d0f, 0));
+    }
+}
+
+void test_update_crc_matches_recomputation(void) {
+    unsigned char changed[sizeof(buffer)];
+    const size_t cases[][2] = {{0, 1}, {0, 100}, {37, 8}, {500, 0}, {1000, 24}, {1023, 1}};
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        size_t offset = cases[i][0];
+        size_t length = cases[i][1];
+        unsigned short before = computeCRC(buffer, sizeof(buffer), 0xffff, 0);
+
+        memcpy(changed, buffer, sizeof(buffer));
+        for (size_t j = offset; j < offset + length; j++) {
+            changed[j] = (unsigned char)~changed[j];
+        }
+        TEST_ASSERT_EQUAL_HEX16(computeCRC(changed, sizeof(changed), 0xffff, 0),
+                                updateCRC(before, sizeof(buffer), offset, buffer + offset, changed + offset, length));
+    }
+}
+
+void test_setters_keep_record_crc_current(void) {
+    PatientData_setAge(&patient, 42);
+    PatientData_setName(&patient, "Jane Q. Public");
+    PatientData_setWeight(&patient, 71.5);
+    PatientData_setGender(&patient, FEMALE);
+    PatientData_setPatientID(&patient, 123456789ul);
+
+    TEST_ASSERT_TRUE(PatientData_checkData(&patient));
+    TEST_ASSERT_EQUAL_UINT16(42, PatientData_getAge(&patient));
+    TEST_ASSERT_EQUAL_STRING("Jane Q. Public", PatientData_getName(&patient));
+    TEST_ASSERT_EQUAL_INT(FEMALE, PatientData_getGender(&patient));
+    TEST_ASSERT_EQUAL_INT(0, alarms);
+}
+
+void test_corruption_is_detected(void) {
+    PatientData_setSystolicBP(&patient, 120);
+    patient.pData.systolicBP ^= 0x40;
+
+    TEST_ASSERT_FALSE(PatientData_checkData(&patient));
+    TEST_ASSERT_EQUAL_UINT16(0, PatientData_getSystolicBP(&patient));
+    PatientData_setSystolicBP(&patient, 130);
+    TEST_ASSERT_EQUAL_INT(2, alarms);
+
+    /* a field that was not touched still reads back */
+    TEST_ASSERT_EQUAL_UINT16(0, PatientData_getTemperature(&patient));
+    TEST_ASSERT_EQUAL_INT(2, alarms);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_matches_ccitt_check_value);
+    RUN_TEST(test_crc_kernels_agree_for_every_length);
+    RUN_TEST(test_crc_kernels_agree_on_unaligned_data);
+    RUN_TEST(test_update_crc_matches_recomputation);
+    RUN_TEST(test_setters_keep_record_crc_current);
+    RUN_TEST(test_corruption_is_detected);
+    return UNITY_END();
+}
@@ -8,6 +8,10 @@
 #include <math.h>
 #include <time.h>
 
+#define ANOMALY_RATE_POOR 0.05f  // More anomalies than this in the window is poor data
+#define SIGNAL_PERIOD 1000u      // Readings per cycle of the simulated signal
+#define TWO_PI 6.28318531f
+
 // Helper functions for string conversion
 static const char* stateToString(SensorState state) {
     switch(state) {
@@ -51,35 +55,89 @@ static const char* typeToString(SensorType type) {
     }
 }
 
-// Simulate sensor reading based on type
-static float simulateReading(SensorType type) {
-    static bool seeded = false;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = true;
+// Per-sensor xorshift32; rand() takes a lock on every call
+static unsigned int nextRandom(Sensor* const me) {
+    uint32_t x = me->noise_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    me->noise_seed = x;
+    return (unsigned int)x;
+}
+
+// Where each type's simulated signal sits and how far it swings
+static void signalBand(SensorType type, float* centre, float* swing) {
+    switch(type) {
+        case TEMPERATURE_SENSOR: *centre = 30.0f;   *swing = 10.0f;  break;  // 20-40°C
+        case HUMIDITY_SENSOR:    *centre = 55.0f;   *swing = 25.0f;  break;  // 30-80%
+        case PRESSURE_SENSOR:    *centre = 1050.0f; *swing = 50.0f;  break;  // 1000-1100 hPa
+        case LIGHT_SENSOR:       *centre = 500.0f;  *swing = 490.0f; break;  // 10-990 lux
+        default:                 *centre = 0.0f;    *swing = 0.0f;
     }
+}
 
-    float base_value;
-    float noise = ((rand() % 100) - 50) / 1000.0f;  // ±0.05 noise
+// The measured quantity sweeps its band, one cycle every SIGNAL_PERIOD readings
+static float driftSignal(Sensor* const me) {
+    float centre;
+    float swing;
+    signalBand(me->type, &centre, &swing);
 
-    switch(type) {
-        case TEMPERATURE_SENSOR:
-            base_value = 20.0f + (rand() % 20);  // 20-40°C
-            break;
-        case HUMIDITY_SENSOR:
-            base_value = 30.0f + (rand() % 50);  // 30-80%
+    me->phase += TWO_PI / (float)SIGNAL_PERIOD;
+    if (me->phase >= TWO_PI) {
+        me->phase -= TWO_PI;
+    }
+    return centre + swing * sinf(me->phase);
+}
+
+// Simulate sensor reading based on type; low power readings are noisier
+static float simulateReading(Sensor* const me) {
+    float noise = (float)((int)(nextRandom(me) % 100u) - 50) / 1000.0f;  // ±0.05 noise
+
+    switch (me->power_mode) {
+        case POWER_SLEEP:
+        case POWER_LOW:
+            noise *= 3.0f;
             break;
-        case PRESSURE_SENSOR:
-            base_value = 1000.0f + (rand() % 100);  // 1000-1100 hPa
+        case POWER_NORMAL:
             break;
-        case LIGHT_SENSOR:
-            base_value = (float)(rand() % 1000);  // 0-1000 lux
+        case POWER_HIGH:
+            noise *= 0.4f;
             break;
-        default:
-            base_value = 0.0f;
     }
 
-    return base_value + noise;
+    return driftSignal(me) + noise;
+}
+
+static void adjustCalibration(Sensor* const me) {
+    me->calibration_offset = (float)((int)(nextRandom(me) % 20u) - 10) / 100.0f;  // ±0.1 adjustment
+}
+
+// One reading into the statistics, without any output
+static bool sampleOnce(Sensor* const me) {
+    me->state = SENSOR_ACTIVE;
+    me->sample_count++;
+
+    me->current_value = simulateReading(me) + me->calibration_offset;
+
+    // Check if value is in valid range
+    if (me->current_value < me->min_value || me->current_value > me->max_value) {
+        me->error_count++;
+        SensorStats_pushError(&me->stats);
+        me->quality = QUALITY_INVALID;
+        return false;
+    }
+
+    SensorStats_push(&me->stats, me->current_value);
+    Sensor_updateQuality(me);
+    return true;
+}
+
+static bool shouldAutoCalibrate(const Sensor* const me) {
+    return me->auto_calibrate && me->quality == QUALITY_POOR && me->sample_count % 10 == 0;
+}
+
+static bool canSample(const Sensor* const me) {
+    return me != NULL && me->state != SENSOR_OFF && me->power_mode != POWER_SLEEP;
 }
 
 // Constructor/Destructor
@@ -103,6 +161,13 @@ void Sensor_Init(Sensor* const me, SensorType type, float min_val, float max_val
     me->noise_threshold = 0.1f;
     me->stability_threshold = 0.05f;
 
+    me->phase = 0.0f;
+    SensorStats_Init(&me->stats);
+    me->noise_seed = (uint32_t)time(NULL) ^ (uint32_t)(uintptr_t)me;
+    if (me->noise_seed == 0) {
+        me->noise_seed = 1;  // xorshift never leaves zero
+    }
+
     printf("Sensor initialized: %s sensor (%.1f - %.1f range)\n",
            typeToString(type), min_val, max_val);
 }
@@ -111,6 +176,7 @@ void Sensor_Cleanup(Sensor* const me) {
     if (me == NULL) return;
 
     me->state = SENSOR_OFF;
+    SensorStats_Cleanup(&me->stats);
     printf("Sensor cleaned up\n");
 }
 
@@ -161,7 +227,7 @@ void Sensor_calibrate(Sensor* const me) {
     printf("Calibrating sensor...\n");
 
     // Simulate calibration - adjust offset
-    me->calibration_offset = (rand() % 20 - 10) / 100.0f;  // ±0.1 adjustment
+    adjustCalibration(me);
 
     me->state = SENSOR_READY;
     printf("Calibration complete (offset: %.3f)\n", me->calibration_offset);
@@ -174,6 +240,7 @@ void Sensor_reset(Sensor* const me) {
     me->sample_count = 0;
     me->calibration_offset = 0.0f;
     me->quality = QUALITY_INVALID;
+    SensorStats_reset(&me->stats);
 
     if (me->state != SENSOR_OFF) {
         me->state = SENSOR_READY;
@@ -213,35 +280,21 @@ void Sensor_setThresholds(Sensor* const me, float noise_thresh, float stability_
 
 // Data operations
 bool Sensor_takeSample(Sensor* const me) {
-    if (me == NULL || me->state == SENSOR_OFF || me->power_mode == POWER_SLEEP) {
+    if (!canSample(me)) {
         return false;
     }
 
-    me->state = SENSOR_ACTIVE;
-    me->sample_count++;
-
-    // Simulate taking a reading
-    float raw_value = simulateReading(me->type);
-    me->current_value = raw_value + me->calibration_offset;
-
-    // Check if value is in valid range
-    if (me->current_value < me->min_value || me->current_value > me->max_value) {
-        me->error_count++;
-        me->quality = QUALITY_INVALID;
+    if (!sampleOnce(me)) {
         printf("Sample %d: ERROR - Value %.2f out of range\n",
-               me->sample_count, me->current_value);
+               me->sample_count, (double)me->current_value);
         return false;
     }
 
-    // Update quality assessment
-    Sensor_updateQuality(me);
-
     printf("Sample %d: %.2f (%s quality)\n",
-           me->sample_count, me->current_value, qualityToString(me->quality));
+           me->sample_count, (double)me->current_value, qualityToString(me->quality));
 
     // Auto-calibrate if enabled and quality is poor
-    if (me->auto_calibrate && me->quality == QUALITY_POOR &&
-        me->sample_count % 10 == 0) {
+    if (shouldAutoCalibrate(me)) {
         Sensor_calibrate(me);
     }
 
@@ -249,6 +302,27 @@ bool Sensor_takeSample(Sensor* const me) {
     return true;
 }
 
+// Same steps as takeSample for each reading, minus the per-reading output
+unsigned int Sensor_takeSamples(Sensor* const me, unsigned int count) {
+    unsigned int valid = 0;
+
+    if (!canSample(me)) {
+        return 0;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        if (!sampleOnce(me)) {
+            continue;
+        }
+        valid++;
+        if (shouldAutoCalibrate(me)) {
+            adjustCalibration(me);
+        }
+        me->state = SENSOR_READY;
+    }
+    return valid;
+}
+
 float Sensor_getValue(Sensor* const me) {
     return (me != NULL) ? me->current_value : 0.0f;
 }
@@ -267,27 +341,19 @@ bool Sensor_isReady(Sensor* const me) {
 void Sensor_updateQuality(Sensor* const me) {
     if (me == NULL || me->sample_count == 0) return;
 
-    float error_rate = (float)me->error_count / (float)me->sample_count;
+    float error_rate = SensorStats_getErrorRate(&me->stats);
+    float anomaly_rate = SensorStats_getAnomalyRate(&me->stats);
 
-    // Simulate noise level based on power mode
-    float noise_level = 0.0f;
-    switch (me->power_mode) {
-        case POWER_SLEEP:
-        case POWER_LOW:
-            noise_level = 0.15f;  // Higher noise in low power
-            break;
-        case POWER_NORMAL:
-            noise_level = 0.05f;
-            break;
-        case POWER_HIGH:
-            noise_level = 0.02f;  // Lower noise in high power
-            break;
-    }
+    // Noise is what the EWMA cannot follow over the window, as a fraction of
+    // the sensor's range; a signal sweeping the whole range is not noisy
+    float span = me->max_value - me->min_value;
+    float noise_level = SensorStats_getNoise(&me->stats) / ((span > 0.0f) ? span : 1.0f);
 
-    // Determine quality based on error rate and noise
+    // Determine quality based on error rate, noise and anomalies
     if (error_rate > 0.1f || noise_level > me->noise_threshold) {
         me->quality = QUALITY_INVALID;
-    } else if (error_rate > 0.05f || noise_level > me->stability_threshold) {
+    } else if (error_rate > 0.05f || noise_level > me->stability_threshold ||
+               anomaly_rate > ANOMALY_RATE_POOR) {
         me->quality = QUALITY_POOR;
     } else if (error_rate > 0.01f) {
         me->quality = QUALITY_GOOD;
@@ -316,6 +382,14 @@ void Sensor_displayStatus(Sensor* const me) {
                me->error_count,
                Sensor_getErrorRate(me) * 100.0f);
     }
+    if (SensorStats_getCount(&me->stats) > 0) {
+        printf("  Mean: %.2f | StdDev: %.3f | Median: %.2f | Window: %.2f..%.2f\n",
+               (double)SensorStats_getMean(&me->stats),
+               (double)SensorStats_getStdDev(&me->stats),
+               (double)SensorStats_getQuantile(&me->stats, SENSOR_STATS_MEDIAN),
+               (double)SensorStats_getWindowMin(&me->stats),
+               (double)SensorStats_getWindowMax(&me->stats));
+    }
 }
 
 const char* Sensor_getStateString(Sensor* const me) {
@@ -336,8 +410,7 @@ const char* Sensor_getTypeString(Sensor* const me) {
 
 // Statistics
 float Sensor_getErrorRate(Sensor* const me) {
-    if (me == NULL || me->sample_count == 0) return 0.0f;
-    return (float)me->error_count / (float)me->sample_count;
+    return (me != NULL) ? SensorStats_getErrorRate(&me->stats) : 0.0f;
 }
 
 unsigned int Sensor_getSampleCount(Sensor* const me) {
@@ -349,5 +422,10 @@ void Sensor_resetStatistics(Sensor* const me) {
 
     me->error_count = 0;
     me->sample_count = 0;
+    SensorStats_reset(&me->stats);
     printf("Sensor statistics reset\n");
 }
+
+const SensorStats* Sensor_getStats(Sensor* const me) {
+    return (me != NULL) ? &me->stats : NULL;
+}
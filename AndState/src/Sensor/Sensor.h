@@ -10,6 +10,8 @@
 #define ANDSTATE_SENSOR_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "SensorStats.h"
 
 typedef enum SensorState {
     SENSOR_OFF,
@@ -63,6 +65,11 @@ struct Sensor {
     // Thresholds for quality assessment
     float noise_threshold;      // Above this is considered noisy
     float stability_threshold;  // Required for good quality
+
+    // Streaming statistics over the readings; quality is judged from them
+    SensorStats stats;
+    float phase;                // Position in the simulated signal's cycle
+    uint32_t noise_seed;        // State of the simulated reading generator
 };
 
 // Constructor/Destructor
@@ -84,6 +91,7 @@ void Sensor_setThresholds(Sensor* const me, float noise_thresh, float stability_
 
 // Data operations
 bool Sensor_takeSample(Sensor* const me);  // Simulates taking a reading
+unsigned int Sensor_takeSamples(Sensor* const me, unsigned int count);  // Quietly, returns valid readings
 float Sensor_getValue(Sensor* const me);
 DataQuality Sensor_getQuality(Sensor* const me);
 bool Sensor_isReady(Sensor* const me);
@@ -96,9 +104,10 @@ const char* Sensor_getQualityString(Sensor* const me);
 const char* Sensor_getPowerModeString(Sensor* const me);
 const char* Sensor_getTypeString(Sensor* const me);
 
-// Statistics
+// Statistics - the error rate covers the last SENSOR_STATS_WINDOW readings
 float Sensor_getErrorRate(Sensor* const me);
 unsigned int Sensor_getSampleCount(Sensor* const me);
 void Sensor_resetStatistics(Sensor* const me);
+const SensorStats* Sensor_getStats(Sensor* const me);
 
 #endif //ANDSTATE_SENSOR_H
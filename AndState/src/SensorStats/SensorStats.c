@@ -0,0 +1,353 @@
+//
+// SensorStats Implementation
+// Window min/max keep only the readings that can still become the extreme:
+// a new reading drops every older one it beats, and the head falls out
+// once it is SENSOR_STATS_WINDOW readings old. Each reading is pushed and
+// popped at most once, so the cost is amortized O(1).
+// Noise is judged from residuals against the EWMA rather than from the
+// readings: a signal that moves smoothly leaves a steady residual (the
+// EWMA's lag), so only what the EWMA cannot follow counts as spread.
+//
+
+#include "SensorStats.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define WINDOW_MASK (SENSOR_STATS_WINDOW - 1u)
+#define WINDOW_BITS (~(uint64_t)0 >> (64u - SENSOR_STATS_WINDOW))
+
+static const double quantileProbabilities[SENSOR_STATS_QUANTILES] = {0.05, 0.5, 0.95};
+
+// Helper functions
+static void dequeClear(SensorStatsDeque* const dq) {
+    dq->head = 0;
+    dq->tail = 0;
+}
+
+// Pushes reading number `n`; unsigned differences keep the age right when n wraps
+static void dequePush(SensorStatsDeque* const dq, float value, uint32_t n) {
+    while (dq->head != dq->tail && n - dq->index[dq->head & WINDOW_MASK] >= SENSOR_STATS_WINDOW) {
+        dq->head++;
+    }
+    while (dq->head != dq->tail && dq->value[(dq->tail - 1u) & WINDOW_MASK] <= value) {
+        dq->tail--;
+    }
+    dq->value[dq->tail & WINDOW_MASK] = value;
+    dq->index[dq->tail & WINDOW_MASK] = n;
+    dq->tail++;
+}
+
+static float dequeFront(const SensorStatsDeque* const dq) {
+    return (dq->head != dq->tail) ? dq->value[dq->head & WINDOW_MASK] : 0.0f;
+}
+
+static void markersInit(SensorStatsMarkers* const q, double p) {
+    q->p = p;
+    for (unsigned int i = 0; i < SENSOR_STATS_MARKERS; i++) {
+        q->height[i] = 0.0;
+        q->position[i] = (double)(i + 1u);
+    }
+    q->desired[0] = 1.0;
+    q->desired[1] = 1.0 + 2.0 * p;
+    q->desired[2] = 1.0 + 4.0 * p;
+    q->desired[3] = 3.0 + 2.0 * p;
+    q->desired[4] = 5.0;
+    q->increment[0] = 0.0;
+    q->increment[1] = p / 2.0;
+    q->increment[2] = p;
+    q->increment[3] = (1.0 + p) / 2.0;
+    q->increment[4] = 1.0;
+}
+
+// Piecewise-parabolic prediction of marker i moved by d (+1 or -1)
+static double markersParabolic(const SensorStatsMarkers* const q, unsigned int i, double d) {
+    const double* h = q->height;
+    const double* n = q->position;
+
+    return h[i] + d / (n[i + 1] - n[i - 1]) *
+           ((n[i] - n[i - 1] + d) * (h[i + 1] - h[i]) / (n[i + 1] - n[i]) +
+            (n[i + 1] - n[i] - d) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+}
+
+static double markersLinear(const SensorStatsMarkers* const q, unsigned int i, int d) {
+    unsigned int j = (d > 0) ? i + 1u : i - 1u;
+    return q->height[i] + (double)d * (q->height[j] - q->height[i]) / (q->position[j] - q->position[i]);
+}
+
+// `count` is the number of readings including x
+static void markersAdd(SensorStatsMarkers* const q, double x, unsigned long count) {
+    double* h = q->height;
+    unsigned int k;
+
+    // The first five readings are the markers, kept sorted
+    if (count <= SENSOR_STATS_MARKERS) {
+        unsigned int i = (unsigned int)count - 1u;
+        while (i > 0 && h[i - 1] > x) {
+            h[i] = h[i - 1];
+            i--;
+        }
+        h[i] = x;
+        return;
+    }
+
+    // Cell the reading falls in; the extremes stretch to take it
+    if (x < h[0]) {
+        h[0] = x;
+        k = 0;
+    } else if (x >= h[4]) {
+        h[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (x >= h[k + 1]) {
+            k++;
+        }
+    }
+    for (unsigned int i = k + 1u; i < SENSOR_STATS_MARKERS; i++) {
+        q->position[i] += 1.0;
+    }
+    for (unsigned int i = 0; i < SENSOR_STATS_MARKERS; i++) {
+        q->desired[i] += q->increment[i];
+    }
+
+    // Move the middle markers towards where they should be
+    for (unsigned int i = 1; i < SENSOR_STATS_MARKERS - 1u; i++) {
+        double off = q->desired[i] - q->position[i];
+        if ((off >= 1.0 && q->position[i + 1] - q->position[i] > 1.0) ||
+            (off <= -1.0 && q->position[i - 1] - q->position[i] < -1.0)) {
+            int d = (off > 0.0) ? 1 : -1;
+            double moved = markersParabolic(q, i, (double)d);
+            if (!(h[i - 1] < moved && moved < h[i + 1])) {
+                moved = markersLinear(q, i, d);
+            }
+            h[i] = moved;
+            q->position[i] += (double)d;
+        }
+    }
+}
+
+static double markersEstimate(const SensorStatsMarkers* const q, unsigned long count) {
+    if (count == 0) {
+        return 0.0;
+    }
+    if (count <= SENSOR_STATS_MARKERS) {
+        // Nearest rank among the sorted readings so far
+        return q->height[(unsigned int)(q->p * (double)(count - 1u) + 0.5)];
+    }
+    return q->height[2];
+}
+
+// Shifts one reading into the error/anomaly windows
+static void windowRecord(SensorStats* const me, bool error, bool anomaly) {
+    if (me->observed >= SENSOR_STATS_WINDOW) {
+        me->window_errors -= (unsigned int)((me->error_bits >> (SENSOR_STATS_WINDOW - 1u)) & 1u);
+        me->window_anomalies -= (unsigned int)((me->anomaly_bits >> (SENSOR_STATS_WINDOW - 1u)) & 1u);
+    }
+    me->error_bits = ((me->error_bits << 1) | (uint64_t)error) & WINDOW_BITS;
+    me->anomaly_bits = ((me->anomaly_bits << 1) | (uint64_t)anomaly) & WINDOW_BITS;
+    me->window_errors += (unsigned int)error;
+    me->window_anomalies += (unsigned int)anomaly;
+    me->observed++;
+}
+
+// Replaces the oldest residual; the sums are rebuilt from the ring once per
+// window so rounding never accumulates
+static void residualRecord(SensorStats* const me, float residual) {
+    unsigned int slot = (unsigned int)(me->residuals & WINDOW_MASK);
+
+    if (me->residuals >= SENSOR_STATS_WINDOW) {
+        double old = (double)me->residual[slot];
+        me->residual_sum -= old;
+        me->residual_squares -= old * old;
+    }
+    me->residual[slot] = residual;
+    me->residual_sum += (double)residual;
+    me->residual_squares += (double)residual * (double)residual;
+    me->residuals++;
+
+    if ((me->residuals & WINDOW_MASK) == 0) {
+        me->residual_sum = 0.0;
+        me->residual_squares = 0.0;
+        for (unsigned int i = 0; i < SENSOR_STATS_WINDOW; i++) {
+            me->residual_sum += (double)me->residual[i];
+            me->residual_squares += (double)me->residual[i] * (double)me->residual[i];
+        }
+    }
+}
+
+static float windowRate(const SensorStats* const me, unsigned int hits) {
+    unsigned long span = (me->observed < SENSOR_STATS_WINDOW) ? me->observed : SENSOR_STATS_WINDOW;
+    return (span > 0) ? (float)hits / (float)span : 0.0f;
+}
+
+// Constructor/Destructor
+void SensorStats_Init(SensorStats* const me) {
+    if (me == NULL) return;
+
+    me->alpha = SENSOR_STATS_DEFAULT_ALPHA;
+    me->anomaly_z = SENSOR_STATS_DEFAULT_ANOMALY_Z;
+    SensorStats_reset(me);
+}
+
+void SensorStats_Cleanup(SensorStats* const me) {
+    if (me == NULL) return;
+
+    SensorStats_reset(me);
+}
+
+SensorStats* SensorStats_Create(void) {
+    SensorStats* me = (SensorStats*)malloc(sizeof(SensorStats));
+    if (me != NULL) {
+        SensorStats_Init(me);
+    }
+    return me;
+}
+
+void SensorStats_Destroy(SensorStats* const me) {
+    if (me != NULL) {
+        SensorStats_Cleanup(me);
+        free(me);
+    }
+}
+
+// Configuration
+void SensorStats_reset(SensorStats* const me) {
+    if (me == NULL) return;
+
+    me->count = 0;
+    me->mean = 0.0;
+    me->m2 = 0.0;
+    me->ewma = 0.0f;
+    dequeClear(&me->window_max);
+    dequeClear(&me->window_min);
+    me->residuals = 0;
+    me->residual_sum = 0.0;
+    me->residual_squares = 0.0;
+    for (unsigned int i = 0; i < SENSOR_STATS_QUANTILES; i++) {
+        markersInit(&me->quantiles[i], quantileProbabilities[i]);
+    }
+    me->last_score = 0.0f;
+    me->observed = 0;
+    me->error_bits = 0;
+    me->anomaly_bits = 0;
+    me->window_errors = 0;
+    me->window_anomalies = 0;
+}
+
+void SensorStats_setSmoothing(SensorStats* const me, float alpha) {
+    if (me == NULL || !(alpha > 0.0f && alpha <= 1.0f)) return;
+
+    me->alpha = alpha;
+}
+
+void SensorStats_setAnomalyThreshold(SensorStats* const me, float z) {
+    if (me == NULL || !(z > 0.0f)) return;
+
+    me->anomaly_z = z;
+}
+
+// Feeding readings
+float SensorStats_push(SensorStats* const me, float value) {
+    if (me == NULL) return 0.0f;
+
+    double x = (double)value;
+    float score = 0.0f;
+
+    // Score against what was known before this reading
+    if (me->count >= 2 && me->m2 > 0.0) {
+        double sd = sqrt(me->m2 / (double)(me->count - 1u));
+        score = (float)(fabs(x - me->mean) / sd);
+    }
+    me->last_score = score;
+
+    if (me->count > 0) {
+        residualRecord(me, value - me->ewma);
+    }
+
+    // Welford
+    me->count++;
+    double delta = x - me->mean;
+    me->mean += delta / (double)me->count;
+    me->m2 += delta * (x - me->mean);
+
+    me->ewma = (me->count == 1) ? value : me->ewma + me->alpha * (value - me->ewma);
+
+    uint32_t n = (uint32_t)me->count;
+    dequePush(&me->window_max, value, n);
+    dequePush(&me->window_min, -value, n);
+
+    for (unsigned int i = 0; i < SENSOR_STATS_QUANTILES; i++) {
+        markersAdd(&me->quantiles[i], x, me->count);
+    }
+
+    windowRecord(me, false, score > me->anomaly_z);
+    return score;
+}
+
+void SensorStats_pushError(SensorStats* const me) {
+    if (me == NULL) return;
+
+    me->last_score = 0.0f;
+    windowRecord(me, true, false);
+}
+
+// Running statistics
+unsigned long SensorStats_getCount(const SensorStats* const me) {
+    return (me != NULL) ? me->count : 0;
+}
+
+float SensorStats_getMean(const SensorStats* const me) {
+    return (me != NULL) ? (float)me->mean : 0.0f;
+}
+
+float SensorStats_getVariance(const SensorStats* const me) {
+    if (me == NULL || me->count < 2) return 0.0f;
+    return (float)(me->m2 / (double)(me->count - 1u));
+}
+
+float SensorStats_getStdDev(const SensorStats* const me) {
+    return sqrtf(SensorStats_getVariance(me));
+}
+
+float SensorStats_getEwma(const SensorStats* const me) {
+    return (me != NULL) ? me->ewma : 0.0f;
+}
+
+float SensorStats_getQuantile(const SensorStats* const me, SensorStatsQuantile which) {
+    if (me == NULL || which >= SENSOR_STATS_QUANTILES) return 0.0f;
+    return (float)markersEstimate(&me->quantiles[which], me->count);
+}
+
+// Sliding window statistics
+float SensorStats_getWindowMin(const SensorStats* const me) {
+    return (me != NULL && me->count > 0) ? -dequeFront(&me->window_min) : 0.0f;
+}
+
+float SensorStats_getWindowMax(const SensorStats* const me) {
+    return (me != NULL) ? dequeFront(&me->window_max) : 0.0f;
+}
+
+float SensorStats_getNoise(const SensorStats* const me) {
+    if (me == NULL || me->residuals < 2) return 0.0f;
+
+    double n = (double)((me->residuals < SENSOR_STATS_WINDOW) ? me->residuals : SENSOR_STATS_WINDOW);
+    double mean = me->residual_sum / n;
+    double variance = (me->residual_squares - n * mean * mean) / (n - 1.0);
+    return (variance > 0.0) ? (float)sqrt(variance) : 0.0f;
+}
+
+float SensorStats_getErrorRate(const SensorStats* const me) {
+    return (me != NULL) ? windowRate(me, me->window_errors) : 0.0f;
+}
+
+float SensorStats_getAnomalyRate(const SensorStats* const me) {
+    return (me != NULL) ? windowRate(me, me->window_anomalies) : 0.0f;
+}
+
+float SensorStats_getLastScore(const SensorStats* const me) {
+    return (me != NULL) ? me->last_score : 0.0f;
+}
+
+bool SensorStats_isAnomaly(const SensorStats* const me) {
+    return (me != NULL) && (me->anomaly_bits & 1u) != 0;
+}
@@ -0,0 +1,113 @@
+//
+// SensorStats Component - Streaming statistics for one sensor's readings
+// Every reading updates a Welford mean/variance, an EWMA, min and max over
+// the last SENSOR_STATS_WINDOW readings (monotonic deques, amortized O(1)),
+// the spread of its residual against the EWMA over the same window, and
+// P-square quantile estimates (five markers each, constant memory).
+// Nothing is allocated after Init and no reading is kept beyond the window.
+//
+
+#ifndef ANDSTATE_SENSORSTATS_H
+#define ANDSTATE_SENSORSTATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SENSOR_STATS_WINDOW 64u         // Readings in the sliding window (one bit each in a uint64_t)
+#define SENSOR_STATS_MARKERS 5u         // P-square markers per quantile
+#define SENSOR_STATS_DEFAULT_ALPHA 0.1f // EWMA smoothing
+#define SENSOR_STATS_DEFAULT_ANOMALY_Z 4.0f
+
+typedef enum SensorStatsQuantile {
+    SENSOR_STATS_P5,
+    SENSOR_STATS_MEDIAN,
+    SENSOR_STATS_P95,
+    SENSOR_STATS_QUANTILES
+} SensorStatsQuantile;
+
+// One quantile estimated by the P-square algorithm (Jain & Chlamtac)
+typedef struct SensorStatsMarkers SensorStatsMarkers;
+struct SensorStatsMarkers {
+    double p;                                   // Probability tracked
+    double height[SENSOR_STATS_MARKERS];        // Marker heights; the middle one is the estimate
+    double position[SENSOR_STATS_MARKERS];      // Actual marker positions
+    double desired[SENSOR_STATS_MARKERS];       // Desired marker positions
+    double increment[SENSOR_STATS_MARKERS];     // Desired position step per reading
+};
+
+// Window maximum: values decrease from head to tail, older ones first
+typedef struct SensorStatsDeque SensorStatsDeque;
+struct SensorStatsDeque {
+    float value[SENSOR_STATS_WINDOW];
+    uint32_t index[SENSOR_STATS_WINDOW];        // Reading number of each value
+    uint32_t head;
+    uint32_t tail;
+};
+
+typedef struct SensorStats SensorStats;
+struct SensorStats {
+    // Welford running mean and variance, in double so long runs stay exact
+    unsigned long count;        // Valid readings since reset
+    double mean;
+    double m2;                  // Sum of squared deviations from the mean
+
+    // Exponentially weighted moving average
+    float ewma;
+    float alpha;
+
+    // Sliding window min/max; the min deque holds negated values
+    SensorStatsDeque window_max;
+    SensorStatsDeque window_min;
+
+    // Residuals (reading minus the EWMA before it) over the last window of readings
+    float residual[SENSOR_STATS_WINDOW];
+    unsigned long residuals;    // Residuals recorded since reset
+    double residual_sum;        // Sums over the residuals still in the window
+    double residual_squares;
+
+    // Constant-memory quantiles
+    SensorStatsMarkers quantiles[SENSOR_STATS_QUANTILES];
+
+    // Anomaly scoring and error tracking over the last window of readings
+    float last_score;           // |z| of the latest reading against the stats before it
+    float anomaly_z;            // Scores above this are anomalies
+    unsigned long observed;     // Readings seen since reset, valid or not
+    uint64_t error_bits;        // Bit 0 is the latest reading
+    uint64_t anomaly_bits;
+    unsigned int window_errors;
+    unsigned int window_anomalies;
+};
+
+// Constructor/Destructor
+void SensorStats_Init(SensorStats* const me);
+void SensorStats_Cleanup(SensorStats* const me);
+SensorStats* SensorStats_Create(void);
+void SensorStats_Destroy(SensorStats* const me);
+
+// Configuration
+void SensorStats_reset(SensorStats* const me);  // Forget every reading, keep settings
+void SensorStats_setSmoothing(SensorStats* const me, float alpha);
+void SensorStats_setAnomalyThreshold(SensorStats* const me, float z);
+
+// Feeding readings - O(1) each; push returns the reading's anomaly score
+float SensorStats_push(SensorStats* const me, float value);
+void SensorStats_pushError(SensorStats* const me);  // A reading rejected as invalid
+
+// Running statistics over every valid reading since reset
+unsigned long SensorStats_getCount(const SensorStats* const me);
+float SensorStats_getMean(const SensorStats* const me);
+float SensorStats_getVariance(const SensorStats* const me);  // Sample variance
+float SensorStats_getStdDev(const SensorStats* const me);
+float SensorStats_getEwma(const SensorStats* const me);
+float SensorStats_getQuantile(const SensorStats* const me, SensorStatsQuantile which);
+
+// Sliding window statistics
+float SensorStats_getWindowMin(const SensorStats* const me);
+float SensorStats_getWindowMax(const SensorStats* const me);
+float SensorStats_getNoise(const SensorStats* const me);  // Residual standard deviation
+float SensorStats_getErrorRate(const SensorStats* const me);
+float SensorStats_getAnomalyRate(const SensorStats* const me);
+float SensorStats_getLastScore(const SensorStats* const me);
+bool SensorStats_isAnomaly(const SensorStats* const me);  // The latest reading
+
+#endif //ANDSTATE_SENSORSTATS_H
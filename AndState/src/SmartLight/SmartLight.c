@@ -3,6 +3,7 @@
 //
 
 #include "SmartLight.h"
+#include "SmartLightFleet.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -28,6 +29,17 @@ static const char* brightnessToString(BrightnessLevel level) {
     }
 }
 
+// Auto-off in TIMER mode, called by the wheel when the timer runs out
+static void onAutoTimerExpired(Timer* timer, void* context) {
+    SmartLight* me = (SmartLight*)context;
+    (void)timer;
+
+    if (me->mode == TIMER_MODE) {
+        printf("Auto-off timer expired\n");
+        SmartLight_turnOff(me);
+    }
+}
+
 // Constructor/Destructor
 void SmartLight_Init(SmartLight* const me) {
     if (me == NULL) return;
@@ -36,6 +48,7 @@ void SmartLight_Init(SmartLight* const me) {
     me->light = Light_Create();
     me->auto_timer = Timer_Create(5000, ONESHOT);  // 5 second auto-off
     me->fade_timer = Timer_Create(1000, ONESHOT);  // 1 second fade
+    me->timer_wheel = NULL;
     me->light_sensor = Sensor_Create(LIGHT_SENSOR, 0.0f, 1000.0f);
     me->motion_sensor = Sensor_Create(PRESSURE_SENSOR, 0.0f, 1.0f);  // Using pressure as motion
     
@@ -55,6 +68,8 @@ void SmartLight_Init(SmartLight* const me) {
     me->last_motion_state = false;
     me->last_light_level = 500.0f;
     me->manual_overrides = 0;
+    me->fleet = NULL;
+    me->fleet_index = 0;
     
     // Start sensors
     if (me->light_sensor) Sensor_turnOn(me->light_sensor);
@@ -64,7 +79,7 @@ void SmartLight_Init(SmartLight* const me) {
 }
 
 void SmartLight_Cleanup(SmartLight* const me) {
-    if (me == NULL) return;
+    if (me == NULL || me->fleet != NULL) return;
     
     // Cleanup all components
     Light_Destroy(me->light);
@@ -91,8 +106,47 @@ void SmartLight_Destroy(SmartLight* const me) {
     }
 }
 
+void SmartLight_InitView(SmartLight* const me, struct SmartLightFleet* fleet, size_t index) {
+    if (me == NULL) return;
+
+    // No components: every call below goes to the fleet slot instead
+    me->light = NULL;
+    me->auto_timer = NULL;
+    me->fade_timer = NULL;
+    me->timer_wheel = NULL;
+    me->light_sensor = NULL;
+    me->motion_sensor = NULL;
+
+    me->mode = MANUAL_MODE;
+    me->brightness = BRIGHTNESS_OFF;
+    me->motion_enabled = false;
+    me->auto_dimming = false;
+    me->energy_saving = false;
+    me->light_threshold = 0.0f;
+    me->fade_duration = 0;
+    me->auto_timeout = 0;
+    me->last_motion_state = false;
+    me->last_light_level = 0.0f;
+    me->manual_overrides = 0;
+
+    me->fleet = fleet;
+    me->fleet_index = index;
+}
+
+SmartLight* SmartLight_CreateView(struct SmartLightFleet* fleet, size_t index) {
+    SmartLight* me = (SmartLight*)malloc(sizeof(SmartLight));
+    if (me != NULL) {
+        SmartLight_InitView(me, fleet, index);
+    }
+    return me;
+}
+
 // Basic operations
 void SmartLight_turnOn(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_turnOn(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL || me->light == NULL) return;
     
     Light_turnOn(me->light);
@@ -111,6 +165,10 @@ void SmartLight_turnOn(SmartLight* const me) {
 }
 
 void SmartLight_turnOff(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_turnOff(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL || me->light == NULL) return;
     
     Light_turnOff(me->light);
@@ -123,9 +181,9 @@ void SmartLight_turnOff(SmartLight* const me) {
 }
 
 void SmartLight_toggle(SmartLight* const me) {
-    if (me == NULL || me->light == NULL) return;
+    if (me == NULL || (me->light == NULL && me->fleet == NULL)) return;
     
-    if (Light_isOn(me->light)) {
+    if (SmartLight_isOn(me)) {
         SmartLight_turnOff(me);
     } else {
         SmartLight_turnOn(me);
@@ -134,6 +192,10 @@ void SmartLight_toggle(SmartLight* const me) {
 
 // AND Pattern operations - these can be changed independently
 void SmartLight_setMode(SmartLight* const me, SmartMode mode) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setMode(me->fleet, me->fleet_index, mode);
+        return;
+    }
     if (me == NULL) return;
     
     me->mode = mode;
@@ -166,6 +228,10 @@ void SmartLight_setMode(SmartLight* const me, SmartMode mode) {
 }
 
 void SmartLight_setBrightness(SmartLight* const me, BrightnessLevel level) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setBrightness(me->fleet, me->fleet_index, level);
+        return;
+    }
     if (me == NULL || me->light == NULL) return;
     
     me->brightness = level;
@@ -196,6 +262,10 @@ void SmartLight_setBrightness(SmartLight* const me, BrightnessLevel level) {
 }
 
 void SmartLight_setColor(SmartLight* const me, ColorType color) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setColor(me->fleet, me->fleet_index, color);
+        return;
+    }
     if (me == NULL || me->light == NULL) return;
     
     Light_setColor(me->light, color);
@@ -205,6 +275,10 @@ void SmartLight_setColor(SmartLight* const me, ColorType color) {
 }
 
 void SmartLight_setFlashMode(SmartLight* const me, FlashType mode) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setFlashMode(me->fleet, me->fleet_index, mode);
+        return;
+    }
     if (me == NULL || me->light == NULL) return;
     
     Light_setMode(me->light, mode);
@@ -215,6 +289,10 @@ void SmartLight_setFlashMode(SmartLight* const me, FlashType mode) {
 
 // Feature control
 void SmartLight_enableMotionDetection(SmartLight* const me, bool enable) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_enableMotionDetection(me->fleet, me->fleet_index, enable);
+        return;
+    }
     if (me == NULL) return;
     
     me->motion_enabled = enable;
@@ -228,6 +306,10 @@ void SmartLight_enableMotionDetection(SmartLight* const me, bool enable) {
 }
 
 void SmartLight_enableAutoDimming(SmartLight* const me, bool enable) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_enableAutoDimming(me->fleet, me->fleet_index, enable);
+        return;
+    }
     if (me == NULL) return;
     
     me->auto_dimming = enable;
@@ -235,6 +317,10 @@ void SmartLight_enableAutoDimming(SmartLight* const me, bool enable) {
 }
 
 void SmartLight_enableEnergySaving(SmartLight* const me, bool enable) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_enableEnergySaving(me->fleet, me->fleet_index, enable);
+        return;
+    }
     if (me == NULL) return;
     
     me->energy_saving = enable;
@@ -251,6 +337,10 @@ void SmartLight_enableEnergySaving(SmartLight* const me, bool enable) {
 
 // Configuration
 void SmartLight_setLightThreshold(SmartLight* const me, float threshold) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setLightThreshold(me->fleet, me->fleet_index, threshold);
+        return;
+    }
     if (me == NULL) return;
     
     me->light_threshold = threshold;
@@ -258,6 +348,10 @@ void SmartLight_setLightThreshold(SmartLight* const me, float threshold) {
 }
 
 void SmartLight_setFadeDuration(SmartLight* const me, unsigned int duration_ms) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setFadeDuration(me->fleet, me->fleet_index, duration_ms);
+        return;
+    }
     if (me == NULL) return;
     
     me->fade_duration = duration_ms;
@@ -269,6 +363,10 @@ void SmartLight_setFadeDuration(SmartLight* const me, unsigned int duration_ms)
 }
 
 void SmartLight_setAutoTimeout(SmartLight* const me, unsigned int timeout_ms) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_setAutoTimeout(me->fleet, me->fleet_index, timeout_ms);
+        return;
+    }
     if (me == NULL) return;
     
     me->auto_timeout = timeout_ms;
@@ -279,13 +377,32 @@ void SmartLight_setAutoTimeout(SmartLight* const me, unsigned int timeout_ms) {
     printf("Auto timeout set to: %d ms\n", timeout_ms);
 }
 
+// Timer scheduling
+void SmartLight_attachTimerWheel(SmartLight* const me, TimerWheel* wheel) {
+    if (me == NULL || me->fleet != NULL) return;  // Fleet ticks keep time for views
+
+    me->timer_wheel = wheel;
+    if (me->auto_timer) {
+        Timer_attach(me->auto_timer, wheel);
+        Timer_setCallback(me->auto_timer, (wheel != NULL) ? onAutoTimerExpired : NULL, me);
+    }
+    if (me->fade_timer) Timer_attach(me->fade_timer, wheel);
+}
+
 // Smart operations
 void SmartLight_update(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        // React to the fleet's sensor inputs now; time moves on with fleet ticks
+        SmartLightFleet_updateRange(me->fleet, me->fleet_index, me->fleet_index + 1, 0);
+        return;
+    }
     if (me == NULL) return;
     
-    // Update all timers
-    if (me->auto_timer) Timer_update(me->auto_timer);
-    if (me->fade_timer) Timer_update(me->fade_timer);
+    // Update all timers, unless a wheel calls them back
+    if (me->timer_wheel == NULL) {
+        if (me->auto_timer) Timer_update(me->auto_timer);
+        if (me->fade_timer) Timer_update(me->fade_timer);
+    }
     
     // Take sensor readings
     if (me->light_sensor && Sensor_isReady(me->light_sensor)) {
@@ -305,7 +422,7 @@ void SmartLight_update(SmartLight* const me) {
             break;
             
         case TIMER_MODE:
-            if (me->auto_timer && Timer_isExpired(me->auto_timer)) {
+            if (me->timer_wheel == NULL && me->auto_timer && Timer_isExpired(me->auto_timer)) {
                 printf("Auto-off timer expired\n");
                 SmartLight_turnOff(me);
             }
@@ -324,6 +441,10 @@ void SmartLight_update(SmartLight* const me) {
 }
 
 void SmartLight_fadeToLevel(SmartLight* const me, BrightnessLevel target) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_fadeToLevel(me->fleet, me->fleet_index, target);
+        return;
+    }
     if (me == NULL) return;
     
     printf("Fading from %s to %s brightness\n",
@@ -341,6 +462,10 @@ void SmartLight_fadeToLevel(SmartLight* const me, BrightnessLevel target) {
 }
 
 void SmartLight_respondToMotion(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_respondToMotion(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL || !me->motion_enabled || me->motion_sensor == NULL) return;
     
     // Simulate motion detection (value > 0.5 means motion)
@@ -370,6 +495,10 @@ void SmartLight_respondToMotion(SmartLight* const me) {
 }
 
 void SmartLight_adjustToAmbientLight(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_adjustToAmbientLight(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL || !me->auto_dimming || me->light_sensor == NULL) return;
     
     float ambient_light = Sensor_getValue(me->light_sensor);
@@ -403,6 +532,17 @@ void SmartLight_displayStatus(SmartLight* const me) {
         return;
     }
     
+    if (me->fleet != NULL) {
+        printf("=== SmartLight Status (fleet light %lu) ===\n", (unsigned long)me->fleet_index);
+        printf("Mode: %s | Brightness: %s | On: %s\n",
+               SmartLight_getModeString(me),
+               SmartLight_getBrightnessString(me),
+               SmartLight_isOn(me) ? "YES" : "NO");
+        printf("Manual overrides: %d\n", SmartLight_getManualOverrides(me));
+        printf("========================\n");
+        return;
+    }
+    
     printf("=== SmartLight Status ===\n");
     printf("Mode: %s | Brightness: %s | On: %s\n",
            modeToString(me->mode),
@@ -436,23 +576,31 @@ void SmartLight_displayStatus(SmartLight* const me) {
 }
 
 bool SmartLight_isOn(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) return SmartLightFleet_isOn(me->fleet, me->fleet_index);
     return (me != NULL && me->light != NULL) ? Light_isOn(me->light) : false;
 }
 
 SmartMode SmartLight_getMode(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) return SmartLightFleet_getMode(me->fleet, me->fleet_index);
     return (me != NULL) ? me->mode : MANUAL_MODE;
 }
 
 BrightnessLevel SmartLight_getBrightness(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) return SmartLightFleet_getBrightness(me->fleet, me->fleet_index);
     return (me != NULL) ? me->brightness : BRIGHTNESS_OFF;
 }
 
 // Statistics and learning
 unsigned int SmartLight_getManualOverrides(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) return SmartLightFleet_getManualOverrides(me->fleet, me->fleet_index);
     return (me != NULL) ? me->manual_overrides : 0;
 }
 
 void SmartLight_resetStatistics(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_resetStatistics(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL) return;
     
     me->manual_overrides = 0;
@@ -464,6 +612,10 @@ void SmartLight_resetStatistics(SmartLight* const me) {
 }
 
 void SmartLight_learnFromUsage(SmartLight* const me) {
+    if (me != NULL && me->fleet != NULL) {
+        SmartLightFleet_learnFromUsage(me->fleet, me->fleet_index);
+        return;
+    }
     if (me == NULL) return;
     
     // Simple learning: adjust thresholds based on manual overrides
@@ -476,9 +628,9 @@ void SmartLight_learnFromUsage(SmartLight* const me) {
 
 // String conversion helpers
 const char* SmartLight_getModeString(SmartLight* const me) {
-    return (me != NULL) ? modeToString(me->mode) : "NULL";
+    return (me != NULL) ? modeToString(SmartLight_getMode(me)) : "NULL";
 }
 
 const char* SmartLight_getBrightnessString(SmartLight* const me) {
-    return (me != NULL) ? brightnessToString(me->brightness) : "NULL";
+    return (me != NULL) ? brightnessToString(SmartLight_getBrightness(me)) : "NULL";
 }
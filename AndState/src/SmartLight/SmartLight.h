@@ -13,6 +13,9 @@
 #include "Timer.h"
 #include "Sensor.h"
 #include <stdbool.h>
+#include <stddef.h>
+
+struct SmartLightFleet;
 
 typedef enum SmartMode {
     MANUAL_MODE,        // User controls everything
@@ -35,6 +38,7 @@ struct SmartLight {
     Light* light;               // Basic light functionality
     Timer* auto_timer;          // Automatic timing
     Timer* fade_timer;          // Smooth transitions
+    TimerWheel* timer_wheel;    // Drives both timers when set, else they are polled
     Sensor* light_sensor;       // Ambient light detection
     Sensor* motion_sensor;      // Motion detection
 
@@ -54,6 +58,10 @@ struct SmartLight {
     bool last_motion_state;     // Previous motion detection
     float last_light_level;     // Previous ambient light
     unsigned int manual_overrides; // Count of manual interventions
+
+    // Fleet view - when set, the state above is unused and lives in the fleet
+    struct SmartLightFleet* fleet;
+    size_t fleet_index;
 };
 
 // Constructor/Destructor
@@ -62,6 +70,10 @@ void SmartLight_Cleanup(SmartLight* const me);
 SmartLight* SmartLight_Create(void);
 void SmartLight_Destroy(SmartLight* const me);
 
+// Views of one light in a SmartLightFleet; no components of their own
+void SmartLight_InitView(SmartLight* const me, struct SmartLightFleet* fleet, size_t index);
+SmartLight* SmartLight_CreateView(struct SmartLightFleet* fleet, size_t index);
+
 // Basic operations
 void SmartLight_turnOn(SmartLight* const me);
 void SmartLight_turnOff(SmartLight* const me);
@@ -83,8 +95,11 @@ void SmartLight_setLightThreshold(SmartLight* const me, float threshold);
 void SmartLight_setFadeDuration(SmartLight* const me, unsigned int duration_ms);
 void SmartLight_setAutoTimeout(SmartLight* const me, unsigned int timeout_ms);
 
+// Timer scheduling - lets many lights share one wheel instead of polling timers
+void SmartLight_attachTimerWheel(SmartLight* const me, TimerWheel* wheel);
+
 // Smart operations
-void SmartLight_update(SmartLight* const me);  // Call regularly for smart behavior
+void SmartLight_update(SmartLight* const me);  // Call regularly for smart behavior (views: fleet ticks keep time)
 void SmartLight_fadeToLevel(SmartLight* const me, BrightnessLevel target);
 void SmartLight_respondToMotion(SmartLight* const me);
 void SmartLight_adjustToAmbientLight(SmartLight* const me);
@@ -0,0 +1,635 @@
+//
+// SmartLightFleet Implementation - Struct-of-arrays batch updates
+//
+// A tick runs the SmartLight_update logic as four passes over the fleet:
+// timers and fades, ambient light, motion, then TIMER mode auto-off. Each
+// pass computes masks and selects instead of branching, so the compiler
+// can vectorize it; passes run in the same order as the per-light calls,
+// which keeps the results identical to calling each light in turn.
+//
+
+#define _POSIX_C_SOURCE 200112L  // posix_memalign
+
+#include "SmartLightFleet.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE 64u
+
+// Bytes for one array of n elements, rounded up to whole cache lines
+static size_t arrayBytes(size_t n, size_t elementSize) {
+    return (n * elementSize + CACHE_LINE - 1u) & ~(size_t)(CACHE_LINE - 1u);
+}
+
+// Places every array in block, or just sums the sizes when block is NULL
+static size_t layout(SmartLightFleet* const me, unsigned char* block, size_t n) {
+    size_t offset = 0;
+
+#define CARVE(field)                                                 \
+    do {                                                             \
+        if (block != NULL) me->field = (void*)(block + offset);      \
+        offset += arrayBytes(n, sizeof(*me->field));                 \
+    } while (0)
+
+    CARVE(is_on);
+    CARVE(color);
+    CARVE(flash);
+    CARVE(brightness);
+    CARVE(mode);
+    CARVE(motion_enabled);
+    CARVE(auto_dimming);
+    CARVE(energy_saving);
+    CARVE(light_threshold);
+    CARVE(manual_overrides);
+    CARVE(ambient_lux);
+    CARVE(motion_level);
+    CARVE(last_light_level);
+    CARVE(last_motion);
+    CARVE(auto_timeout);
+    CARVE(auto_remaining);
+    CARVE(auto_expired);
+    CARVE(fade_duration);
+    CARVE(fade_elapsed);
+    CARVE(fade_from);
+    CARVE(fade_target);
+    CARVE(fading);
+    CARVE(scratch);
+
+#undef CARVE
+    return offset;
+}
+
+// Branch-free selects; cond is 0 or 1. Both sides are always computed,
+// which keeps the compiler from sinking work into branches it can't vectorize
+static inline uint8_t select8(uint8_t cond, uint8_t a, uint8_t b) {
+    uint8_t mask = (uint8_t)-cond;
+    return (uint8_t)((a & mask) | (b & (uint8_t)~mask));
+}
+
+static inline uint32_t select32(uint32_t cond, uint32_t a, uint32_t b) {
+    uint32_t mask = -cond;
+    return (a & mask) | (b & ~mask);
+}
+
+// Same brightness to colour mapping as SmartLight_setBrightness
+static inline uint8_t colorForLevel(uint8_t level) {
+    return select8(level >= BRIGHTNESS_BRIGHT, RED, select8(level == BRIGHTNESS_MEDIUM, YELLOW, GREEN));
+}
+
+// Starts a fade where mask is set; a zero duration lands at once
+static inline void startFade(uint8_t* restrict brightness, uint8_t* restrict color,
+                             const uint32_t* restrict durations, uint32_t* restrict elapsed,
+                             uint8_t* restrict from, uint8_t* restrict target, uint8_t* restrict fading,
+                             size_t i, uint8_t mask, uint8_t level, uint8_t on) {
+    uint8_t instant = mask & (durations[i] == 0);
+    uint8_t gradual = mask & !instant;
+
+    from[i] = select8(gradual, brightness[i], from[i]);
+    target[i] = select8(gradual, level, target[i]);
+    elapsed[i] = select32(gradual, 0u, elapsed[i]);
+    fading[i] = (uint8_t)((fading[i] & !instant) | gradual);
+    brightness[i] = select8(instant, level, brightness[i]);
+    color[i] = select8(instant & on, colorForLevel(level), color[i]);
+}
+
+// Kernels take their arrays as restrict parameters and stay out of line:
+// GCC drops restrict when it inlines them, and then gives up on the loop
+// over too many run-time alias checks. Loops mixing float math with
+// several byte arrays don't vectorize either, so those hand byte flags on
+// to a second loop through the scratch array.
+#define KERNEL static __attribute__((noinline)) void
+
+// Decisions left in scratch for applyActions
+#define ACTION_TURN_ON 0x01u
+#define ACTION_FADE 0x02u
+#define ACTION_LEVEL_SHIFT 2
+
+KERNEL countDown(size_t begin, size_t end, uint32_t dt,
+                 uint32_t* restrict remaining, uint8_t* restrict expired) {
+    for (size_t i = begin; i < end; i++) {
+        uint32_t left = remaining[i];
+        uint32_t step = (left < dt) ? left : dt;
+
+        expired[i] = (uint8_t)((left != 0u) & (left <= dt));
+        remaining[i] = left - step;
+    }
+}
+
+KERNEL advanceFades(size_t begin, size_t end, uint32_t dt, const uint8_t* restrict fading,
+                    const uint32_t* restrict durations, uint32_t* restrict elapsed,
+                    const uint8_t* restrict from, const uint8_t* restrict target,
+                    uint8_t* restrict brightness) {
+    for (size_t i = begin; i < end; i++) {
+        uint32_t duration = select32(durations[i] != 0u, durations[i], 1u);
+        uint32_t now = elapsed[i] + dt;
+        uint8_t active = fading[i];
+
+        now = (now < duration) ? now : duration;
+        float progress = (float)(int32_t)now / (float)(int32_t)duration;
+        float start = (float)from[i];
+        float level = start + ((float)target[i] - start) * progress + 0.5f;
+
+        elapsed[i] = select32(active, now, elapsed[i]);
+        brightness[i] = select8(active, (uint8_t)(int32_t)level, brightness[i]);
+    }
+}
+
+KERNEL settleFades(size_t begin, size_t end, const uint8_t* restrict is_on,
+                   const uint8_t* restrict brightness, const uint32_t* restrict durations,
+                   const uint32_t* restrict elapsed, uint8_t* restrict color, uint8_t* restrict fading) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t active = fading[i];
+        uint32_t duration = select32(durations[i] != 0u, durations[i], 1u);
+
+        color[i] = select8(active & is_on[i], colorForLevel(brightness[i]), color[i]);
+        fading[i] = (uint8_t)(active & (elapsed[i] < duration));
+    }
+}
+
+// Bit 0: a significant change (abs((int)delta) > 50 per light), bit 1: a dark room
+KERNEL compareAmbient(size_t begin, size_t end, uint8_t anyMode, const uint8_t* restrict modes,
+                      const uint8_t* restrict dimming, const float* restrict ambient,
+                      const float* restrict threshold, float* restrict last, uint8_t* restrict flags) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t mode = modes[i];
+        uint8_t active = (anyMode | (mode == AUTO_MODE) | (mode == ADAPTIVE_MODE)) & dimming[i];
+        float lux = ambient[i];
+        uint8_t significant = active & (fabsf(lux - last[i]) >= 51.0f);
+        uint8_t dark = significant & (lux < threshold[i]);
+
+        last[i] = significant ? lux : last[i];
+        flags[i] = (uint8_t)(significant | (dark << 1));
+    }
+}
+
+KERNEL decideAmbient(size_t begin, size_t end, const uint8_t* restrict is_on,
+                     const uint8_t* restrict brightness, uint8_t* restrict actions) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t significant = actions[i] & 1u;
+        uint8_t dark = (uint8_t)(actions[i] >> 1);
+        uint8_t bright = significant & !dark;
+        uint8_t on = is_on[i];
+        uint8_t toMedium = dark & on & (brightness[i] < BRIGHTNESS_MEDIUM);
+        uint8_t toDim = bright & on & (brightness[i] > BRIGHTNESS_DIM);
+        uint8_t level = select8(toMedium, BRIGHTNESS_MEDIUM, BRIGHTNESS_DIM);
+
+        actions[i] = (uint8_t)((dark & !on) | ((toMedium | toDim) << 1) | (level << ACTION_LEVEL_SHIFT));
+    }
+}
+
+KERNEL detectMotion(size_t begin, size_t end, const float* restrict motion, uint8_t* restrict detected) {
+    for (size_t i = begin; i < end; i++) {
+        detected[i] = motion[i] > 0.5f;
+    }
+}
+
+KERNEL decideMotion(size_t begin, size_t end, uint8_t anyMode, const uint8_t* restrict modes,
+                    const uint8_t* restrict enabled, const uint8_t* restrict is_on,
+                    const uint8_t* restrict brightness, const uint32_t* restrict timeouts,
+                    uint8_t* restrict last, uint32_t* restrict remaining, uint8_t* restrict actions) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t mode = modes[i];
+        uint8_t active = (anyMode | (mode == AUTO_MODE) | (mode == ADAPTIVE_MODE)) & enabled[i];
+        uint8_t detected = actions[i];
+        uint8_t changed = active & (detected != last[i]);
+        uint8_t arrived = changed & detected;
+        uint8_t left = changed & !detected & (mode == AUTO_MODE);
+        uint8_t on = is_on[i];
+        uint8_t brighten = arrived & on & (brightness[i] < BRIGHTNESS_BRIGHT);
+        uint32_t timeout = select32(timeouts[i] != 0u, timeouts[i], 1u);
+
+        last[i] = select8(changed, detected, last[i]);
+        remaining[i] = select32(left, timeout, remaining[i]);
+        actions[i] = (uint8_t)((arrived & !on) | (brighten << 1) | ((brightness[i] + 1u) << ACTION_LEVEL_SHIFT));
+    }
+}
+
+// Turns lights on and starts fades as decided; turning on in TIMER mode
+// arms the auto-off timer, as SmartLightFleet_turnOn does
+KERNEL applyActions(size_t begin, size_t end, const uint8_t* restrict actions,
+                    const uint8_t* restrict modes, const uint32_t* restrict timeouts,
+                    const uint8_t* restrict saving, uint8_t* restrict is_on,
+                    uint8_t* restrict brightness, uint8_t* restrict color,
+                    const uint32_t* restrict durations, uint32_t* restrict elapsed,
+                    uint8_t* restrict from, uint8_t* restrict target, uint8_t* restrict fading,
+                    uint32_t* restrict remaining) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t action = actions[i];
+        uint8_t turnOn = action & ACTION_TURN_ON;
+        uint8_t fade = (action & ACTION_FADE) >> 1;
+        uint8_t on = is_on[i];
+        uint8_t arm = turnOn & (modes[i] == TIMER_MODE);
+        uint32_t timeout = select32(timeouts[i] != 0u, timeouts[i], 1u);
+
+        is_on[i] = on | turnOn;
+        color[i] = select8(turnOn, select8(saving[i], GREEN, RED), color[i]);
+        remaining[i] = select32(arm, timeout, remaining[i]);
+        startFade(brightness, color, durations, elapsed, from, target, fading,
+                  i, fade, (uint8_t)(action >> ACTION_LEVEL_SHIFT), on);
+    }
+}
+
+KERNEL expireAutoOff(size_t begin, size_t end, const uint8_t* restrict modes,
+                     const uint8_t* restrict expired, uint8_t* restrict is_on, uint8_t* restrict fading) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t off = (modes[i] == TIMER_MODE) & expired[i];
+
+        is_on[i] = is_on[i] & !off;
+        fading[i] = fading[i] & !off;
+    }
+}
+
+// Pass 1: auto-off countdown and fade progress
+static void advanceTimers(SmartLightFleet* const me, size_t begin, size_t end, uint32_t dt) {
+    countDown(begin, end, dt, me->auto_remaining, me->auto_expired);
+    advanceFades(begin, end, dt, me->fading, me->fade_duration, me->fade_elapsed,
+                 me->fade_from, me->fade_target, me->brightness);
+    settleFades(begin, end, me->is_on, me->brightness, me->fade_duration, me->fade_elapsed,
+                me->color, me->fading);
+}
+
+static void applyScratchActions(SmartLightFleet* const me, size_t begin, size_t end) {
+    applyActions(begin, end, me->scratch, me->mode, me->auto_timeout, me->energy_saving, me->is_on,
+                 me->brightness, me->color, me->fade_duration, me->fade_elapsed, me->fade_from,
+                 me->fade_target, me->fading, me->auto_remaining);
+}
+
+// Pass 2: SmartLight_adjustToAmbientLight for AUTO and ADAPTIVE lights, or all when anyMode
+static void adjustToAmbientLight(SmartLightFleet* const me, size_t begin, size_t end, uint8_t anyMode) {
+    compareAmbient(begin, end, anyMode, me->mode, me->auto_dimming, me->ambient_lux,
+                   me->light_threshold, me->last_light_level, me->scratch);
+    decideAmbient(begin, end, me->is_on, me->brightness, me->scratch);
+    applyScratchActions(me, begin, end);
+}
+
+// Pass 3: SmartLight_respondToMotion for AUTO and ADAPTIVE lights, or all when anyMode
+static void respondToMotion(SmartLightFleet* const me, size_t begin, size_t end, uint8_t anyMode) {
+    detectMotion(begin, end, me->motion_level, me->scratch);
+    decideMotion(begin, end, anyMode, me->mode, me->motion_enabled, me->is_on, me->brightness,
+                 me->auto_timeout, me->last_motion, me->auto_remaining, me->scratch);
+    applyScratchActions(me, begin, end);
+}
+
+// Constructor/Destructor
+void SmartLightFleet_Init(SmartLightFleet* const me, size_t capacity) {
+    if (me == NULL) return;
+
+    memset(me, 0, sizeof(*me));
+    if (capacity > 0 && posix_memalign(&me->block, CACHE_LINE, layout(me, NULL, capacity)) != 0) {
+        me->block = NULL;
+    }
+    if (me->block != NULL) {
+        layout(me, (unsigned char*)me->block, capacity);
+        me->capacity = capacity;
+    }
+    me->workers = 1;
+    pthread_mutex_init(&me->lock, NULL);
+    pthread_cond_init(&me->start, NULL);
+    pthread_cond_init(&me->done, NULL);
+}
+
+void SmartLightFleet_Cleanup(SmartLightFleet* const me) {
+    if (me == NULL) return;
+
+    SmartLightFleet_setWorkers(me, 1);
+    pthread_cond_destroy(&me->done);
+    pthread_cond_destroy(&me->start);
+    pthread_mutex_destroy(&me->lock);
+    free(me->block);
+    me->block = NULL;
+    me->capacity = 0;
+    me->count = 0;
+}
+
+SmartLightFleet* SmartLightFleet_Create(size_t capacity) {
+    SmartLightFleet* me = (SmartLightFleet*)malloc(sizeof(SmartLightFleet));
+    if (me != NULL) {
+        SmartLightFleet_Init(me, capacity);
+        if (me->capacity == 0 && capacity > 0) {
+            SmartLightFleet_Cleanup(me);
+            free(me);
+            me = NULL;
+        }
+    }
+    return me;
+}
+
+void SmartLightFleet_Destroy(SmartLightFleet* const me) {
+    if (me != NULL) {
+        SmartLightFleet_Cleanup(me);
+        free(me);
+    }
+}
+
+// Fleet management
+size_t SmartLightFleet_add(SmartLightFleet* const me) {
+    if (me == NULL || me->count >= me->capacity) return SMART_LIGHT_FLEET_FULL;
+
+    // Same defaults as SmartLight_Init
+    size_t i = me->count++;
+    me->is_on[i] = false;
+    me->color[i] = RED;
+    me->flash[i] = STEADY;
+    me->brightness[i] = BRIGHTNESS_MEDIUM;
+    me->mode[i] = AUTO_MODE;
+    me->motion_enabled[i] = true;
+    me->auto_dimming[i] = true;
+    me->energy_saving[i] = false;
+    me->light_threshold[i] = 100.0f;
+    me->manual_overrides[i] = 0;
+    me->ambient_lux[i] = 500.0f;
+    me->motion_level[i] = 0.0f;
+    me->last_light_level[i] = 500.0f;
+    me->last_motion[i] = false;
+    me->auto_timeout[i] = 300000;
+    me->auto_remaining[i] = 0;
+    me->auto_expired[i] = false;
+    me->fade_duration[i] = 1000;
+    me->fade_elapsed[i] = 0;
+    me->fade_from[i] = BRIGHTNESS_MEDIUM;
+    me->fade_target[i] = BRIGHTNESS_MEDIUM;
+    me->fading[i] = false;
+    return i;
+}
+
+size_t SmartLightFleet_getCount(const SmartLightFleet* const me) {
+    return (me != NULL) ? me->count : 0;
+}
+
+// Worker w's share of the fleet, on whole cache lines of the byte arrays
+static void workerRange(const SmartLightFleet* const me, unsigned int w, size_t* begin, size_t* end) {
+    size_t share = (me->count + me->workers - 1u) / me->workers;
+    share = (share + SMART_LIGHT_FLEET_CHUNK - 1u) & ~(size_t)(SMART_LIGHT_FLEET_CHUNK - 1u);
+    *begin = (size_t)w * share;
+    *end = *begin + share;
+    if (*begin > me->count) *begin = me->count;
+    if (*end > me->count) *end = me->count;
+}
+
+static void* workerMain(void* arg) {
+    SmartLightFleetWorker* worker = (SmartLightFleetWorker*)arg;
+    SmartLightFleet* me = worker->fleet;
+
+    pthread_mutex_lock(&me->lock);
+    for (;;) {
+        while (me->generation == worker->seen && !me->stopping) {
+            pthread_cond_wait(&me->start, &me->lock);
+        }
+        if (me->stopping) break;
+        worker->seen = me->generation;
+        unsigned int dt = me->tick_ms;
+        size_t begin, end;
+        workerRange(me, worker->index, &begin, &end);
+        pthread_mutex_unlock(&me->lock);
+
+        SmartLightFleet_updateRange(me, begin, end, dt);
+
+        pthread_mutex_lock(&me->lock);
+        if (--me->pending == 0) {
+            pthread_cond_signal(&me->done);
+        }
+    }
+    pthread_mutex_unlock(&me->lock);
+    return NULL;
+}
+
+unsigned int SmartLightFleet_setWorkers(SmartLightFleet* const me, unsigned int workers) {
+    if (me == NULL) return 0;
+    if (workers == 0) workers = 1;
+    if (workers > SMART_LIGHT_FLEET_MAX_WORKERS) workers = SMART_LIGHT_FLEET_MAX_WORKERS;
+
+    // Stop the current pool, then start the new one
+    pthread_mutex_lock(&me->lock);
+    me->stopping = true;
+    pthread_cond_broadcast(&me->start);
+    pthread_mutex_unlock(&me->lock);
+    for (unsigned int w = 1; w < me->workers; w++) {
+        pthread_join(me->pool[w].thread, NULL);
+    }
+    me->stopping = false;
+    me->workers = 1;
+
+    for (unsigned int w = 1; w < workers; w++) {
+        me->pool[w].fleet = me;
+        me->pool[w].index = w;
+        me->pool[w].seen = me->generation;
+        if (pthread_create(&me->pool[w].thread, NULL, workerMain, &me->pool[w]) != 0) {
+            break;
+        }
+        me->workers = w + 1;
+    }
+    return me->workers;
+}
+
+// Batch operations
+void SmartLightFleet_tick(SmartLightFleet* const me, unsigned int elapsed_ms) {
+    if (me == NULL) return;
+
+    if (me->workers <= 1) {
+        SmartLightFleet_updateRange(me, 0, me->count, elapsed_ms);
+        return;
+    }
+
+    size_t begin, end;
+    pthread_mutex_lock(&me->lock);
+    me->tick_ms = elapsed_ms;
+    me->pending = me->workers - 1;
+    me->generation++;
+    pthread_cond_broadcast(&me->start);
+    workerRange(me, 0, &begin, &end);
+    pthread_mutex_unlock(&me->lock);
+
+    SmartLightFleet_updateRange(me, begin, end, elapsed_ms);
+
+    pthread_mutex_lock(&me->lock);
+    while (me->pending > 0) {
+        pthread_cond_wait(&me->done, &me->lock);
+    }
+    pthread_mutex_unlock(&me->lock);
+}
+
+void SmartLightFleet_updateRange(SmartLightFleet* const me, size_t begin, size_t end, unsigned int elapsed_ms) {
+    if (me == NULL) return;
+    if (end > me->count) end = me->count;
+    if (begin >= end) return;
+
+    advanceTimers(me, begin, end, elapsed_ms);
+    adjustToAmbientLight(me, begin, end, false);
+    respondToMotion(me, begin, end, false);
+    expireAutoOff(begin, end, me->mode, me->auto_expired, me->is_on, me->fading);
+}
+
+// Sensor inputs
+float* SmartLightFleet_ambientInputs(SmartLightFleet* const me) {
+    return (me != NULL) ? me->ambient_lux : NULL;
+}
+
+float* SmartLightFleet_motionInputs(SmartLightFleet* const me) {
+    return (me != NULL) ? me->motion_level : NULL;
+}
+
+void SmartLightFleet_setAmbientLight(SmartLightFleet* const me, size_t light, float lux) {
+    if (me == NULL || light >= me->count) return;
+    me->ambient_lux[light] = lux;
+}
+
+void SmartLightFleet_setMotion(SmartLightFleet* const me, size_t light, float level) {
+    if (me == NULL || light >= me->count) return;
+    me->motion_level[light] = level;
+}
+
+// Per-light operations
+void SmartLightFleet_turnOn(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+
+    me->is_on[light] = true;
+    me->color[light] = me->energy_saving[light] ? GREEN : RED;
+    if (me->mode[light] == TIMER_MODE) {
+        me->auto_remaining[light] = me->auto_timeout[light] ? me->auto_timeout[light] : 1u;
+    }
+}
+
+void SmartLightFleet_turnOff(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+
+    me->is_on[light] = false;
+    me->auto_remaining[light] = 0;
+    me->fading[light] = false;
+}
+
+void SmartLightFleet_setMode(SmartLightFleet* const me, size_t light, SmartMode mode) {
+    if (me == NULL || light >= me->count) return;
+
+    me->mode[light] = (uint8_t)mode;
+    switch (mode) {
+        case MANUAL_MODE:
+            me->auto_remaining[light] = 0;
+            break;
+
+        case TIMER_MODE:
+            if (me->is_on[light]) {
+                me->auto_remaining[light] = me->auto_timeout[light] ? me->auto_timeout[light] : 1u;
+            }
+            break;
+
+        case ADAPTIVE_MODE:
+            SmartLightFleet_learnFromUsage(me, light);
+            break;
+
+        case AUTO_MODE:
+            break;
+    }
+}
+
+void SmartLightFleet_setBrightness(SmartLightFleet* const me, size_t light, BrightnessLevel level) {
+    if (me == NULL || light >= me->count) return;
+
+    me->brightness[light] = (uint8_t)level;
+    me->fading[light] = false;
+    if (level == BRIGHTNESS_OFF) {
+        me->is_on[light] = false;
+    } else if (me->is_on[light]) {
+        me->color[light] = colorForLevel((uint8_t)level);
+    }
+}
+
+void SmartLightFleet_setColor(SmartLightFleet* const me, size_t light, ColorType color) {
+    if (me == NULL || light >= me->count) return;
+
+    me->color[light] = (uint8_t)color;
+    me->manual_overrides[light]++;
+}
+
+void SmartLightFleet_setFlashMode(SmartLightFleet* const me, size_t light, FlashType mode) {
+    if (me == NULL || light >= me->count) return;
+
+    me->flash[light] = (uint8_t)mode;
+    me->manual_overrides[light]++;
+}
+
+void SmartLightFleet_enableMotionDetection(SmartLightFleet* const me, size_t light, bool enable) {
+    if (me == NULL || light >= me->count) return;
+    me->motion_enabled[light] = enable;
+}
+
+void SmartLightFleet_enableAutoDimming(SmartLightFleet* const me, size_t light, bool enable) {
+    if (me == NULL || light >= me->count) return;
+    me->auto_dimming[light] = enable;
+}
+
+void SmartLightFleet_enableEnergySaving(SmartLightFleet* const me, size_t light, bool enable) {
+    if (me == NULL || light >= me->count) return;
+    me->energy_saving[light] = enable;
+}
+
+void SmartLightFleet_setLightThreshold(SmartLightFleet* const me, size_t light, float threshold) {
+    if (me == NULL || light >= me->count) return;
+    me->light_threshold[light] = threshold;
+}
+
+void SmartLightFleet_setFadeDuration(SmartLightFleet* const me, size_t light, unsigned int duration_ms) {
+    if (me == NULL || light >= me->count) return;
+    me->fade_duration[light] = duration_ms;
+}
+
+void SmartLightFleet_setAutoTimeout(SmartLightFleet* const me, size_t light, unsigned int timeout_ms) {
+    if (me == NULL || light >= me->count) return;
+    me->auto_timeout[light] = timeout_ms;
+}
+
+void SmartLightFleet_fadeToLevel(SmartLightFleet* const me, size_t light, BrightnessLevel target) {
+    if (me == NULL || light >= me->count) return;
+
+    if (target == BRIGHTNESS_OFF) {
+        SmartLightFleet_setBrightness(me, light, target);
+        return;
+    }
+    startFade(me->brightness, me->color, me->fade_duration, me->fade_elapsed, me->fade_from,
+              me->fade_target, me->fading, light, true, (uint8_t)target, me->is_on[light]);
+}
+
+void SmartLightFleet_respondToMotion(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+    respondToMotion(me, light, light + 1, true);
+}
+
+void SmartLightFleet_adjustToAmbientLight(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+    adjustToAmbientLight(me, light, light + 1, true);
+}
+
+void SmartLightFleet_resetStatistics(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+    me->manual_overrides[light] = 0;
+}
+
+void SmartLightFleet_learnFromUsage(SmartLightFleet* const me, size_t light) {
+    if (me == NULL || light >= me->count) return;
+
+    // Same rule as SmartLight_learnFromUsage
+    if (me->manual_overrides[light] > 10) {
+        me->light_threshold[light] *= 0.9f;
+    }
+}
+
+// Per-light status
+bool SmartLightFleet_isOn(const SmartLightFleet* const me, size_t light) {
+    return (me != NULL && light < me->count) ? me->is_on[light] : false;
+}
+
+SmartMode SmartLightFleet_getMode(const SmartLightFleet* const me, size_t light) {
+    return (me != NULL && light < me->count) ? (SmartMode)me->mode[light] : MANUAL_MODE;
+}
+
+BrightnessLevel SmartLightFleet_getBrightness(const SmartLightFleet* const me, size_t light) {
+    return (me != NULL && light < me->count) ? (BrightnessLevel)me->brightness[light] : BRIGHTNESS_OFF;
+}
+
+ColorType SmartLightFleet_getColor(const SmartLightFleet* const me, size_t light) {
+    return (me != NULL && light < me->count) ? (ColorType)me->color[light] : RED;
+}
+
+unsigned int SmartLightFleet_getManualOverrides(const SmartLightFleet* const me, size_t light) {
+    return (me != NULL && light < me->count) ? me->manual_overrides[light] : 0;
+}
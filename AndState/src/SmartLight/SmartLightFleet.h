@@ -0,0 +1,127 @@
+//
+// SmartLightFleet Component - Batch updates for building-scale fleets
+// Light, timer and sensor state for N lights lives in struct-of-arrays
+// blocks inside one allocation, so a tick is a handful of straight loops
+// over the whole fleet (vectorizable, optionally split across workers)
+// instead of N calls chasing five heap objects each. A SmartLight can be
+// a view of one fleet slot; the SmartLight_* calls then act on the fleet.
+//
+
+#ifndef ANDSTATE_SMARTLIGHTFLEET_H
+#define ANDSTATE_SMARTLIGHTFLEET_H
+
+#include "SmartLight.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SMART_LIGHT_FLEET_FULL ((size_t)-1)
+#define SMART_LIGHT_FLEET_MAX_WORKERS 64u
+#define SMART_LIGHT_FLEET_CHUNK 64u  // Worker ranges start on whole cache lines
+
+typedef struct SmartLightFleet SmartLightFleet;
+
+typedef struct SmartLightFleetWorker {
+    SmartLightFleet* fleet;
+    pthread_t thread;
+    unsigned int index;
+    unsigned long seen;         // Last generation this worker ran
+} SmartLightFleetWorker;
+
+struct SmartLightFleet {
+    size_t count;               // Lights in use
+    size_t capacity;            // Lights the arrays can hold
+    void* block;                // The one allocation behind every array
+
+    // Light aspects
+    uint8_t* is_on;
+    uint8_t* color;             // ColorType
+    uint8_t* flash;             // FlashType
+    uint8_t* brightness;        // BrightnessLevel
+
+    // SmartLight aspects
+    uint8_t* mode;              // SmartMode
+    uint8_t* motion_enabled;
+    uint8_t* auto_dimming;
+    uint8_t* energy_saving;
+    float* light_threshold;     // Lux level for auto operation
+    uint32_t* manual_overrides;
+
+    // Sensor inputs (written by the caller) and last values acted on
+    float* ambient_lux;
+    float* motion_level;        // Above 0.5 means motion
+    float* last_light_level;
+    uint8_t* last_motion;
+
+    // Timers, in milliseconds
+    uint32_t* auto_timeout;
+    uint32_t* auto_remaining;   // 0: auto-off timer stopped
+    uint8_t* auto_expired;      // Set by the tick that ran the timer out
+    uint32_t* fade_duration;
+    uint32_t* fade_elapsed;
+    uint8_t* fade_from;
+    uint8_t* fade_target;
+    uint8_t* fading;
+    uint8_t* scratch;           // Flags handed between the loops of one pass
+
+    // Worker pool; worker 0 is the thread calling tick
+    unsigned int workers;
+    SmartLightFleetWorker pool[SMART_LIGHT_FLEET_MAX_WORKERS];
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned long generation;   // Bumped once per parallel tick
+    unsigned int pending;       // Workers still busy with this tick
+    unsigned int tick_ms;
+    bool stopping;
+};
+
+// Constructor/Destructor
+void SmartLightFleet_Init(SmartLightFleet* const me, size_t capacity);  // capacity 0 if out of memory
+void SmartLightFleet_Cleanup(SmartLightFleet* const me);
+SmartLightFleet* SmartLightFleet_Create(size_t capacity);
+void SmartLightFleet_Destroy(SmartLightFleet* const me);
+
+// Fleet management
+size_t SmartLightFleet_add(SmartLightFleet* const me);  // Index, or SMART_LIGHT_FLEET_FULL
+size_t SmartLightFleet_getCount(const SmartLightFleet* const me);
+unsigned int SmartLightFleet_setWorkers(SmartLightFleet* const me, unsigned int workers);  // Returns workers running
+
+// Batch operations
+void SmartLightFleet_tick(SmartLightFleet* const me, unsigned int elapsed_ms);
+void SmartLightFleet_updateRange(SmartLightFleet* const me, size_t begin, size_t end, unsigned int elapsed_ms);
+
+// Sensor inputs - write whole arrays directly, or one light at a time
+float* SmartLightFleet_ambientInputs(SmartLightFleet* const me);
+float* SmartLightFleet_motionInputs(SmartLightFleet* const me);
+void SmartLightFleet_setAmbientLight(SmartLightFleet* const me, size_t light, float lux);
+void SmartLightFleet_setMotion(SmartLightFleet* const me, size_t light, float level);
+
+// Per-light operations, the same behaviour as the SmartLight_* calls
+void SmartLightFleet_turnOn(SmartLightFleet* const me, size_t light);
+void SmartLightFleet_turnOff(SmartLightFleet* const me, size_t light);
+void SmartLightFleet_setMode(SmartLightFleet* const me, size_t light, SmartMode mode);
+void SmartLightFleet_setBrightness(SmartLightFleet* const me, size_t light, BrightnessLevel level);
+void SmartLightFleet_setColor(SmartLightFleet* const me, size_t light, ColorType color);
+void SmartLightFleet_setFlashMode(SmartLightFleet* const me, size_t light, FlashType mode);
+void SmartLightFleet_enableMotionDetection(SmartLightFleet* const me, size_t light, bool enable);
+void SmartLightFleet_enableAutoDimming(SmartLightFleet* const me, size_t light, bool enable);
+void SmartLightFleet_enableEnergySaving(SmartLightFleet* const me, size_t light, bool enable);
+void SmartLightFleet_setLightThreshold(SmartLightFleet* const me, size_t light, float threshold);
+void SmartLightFleet_setFadeDuration(SmartLightFleet* const me, size_t light, unsigned int duration_ms);
+void SmartLightFleet_setAutoTimeout(SmartLightFleet* const me, size_t light, unsigned int timeout_ms);
+void SmartLightFleet_fadeToLevel(SmartLightFleet* const me, size_t light, BrightnessLevel target);
+void SmartLightFleet_respondToMotion(SmartLightFleet* const me, size_t light);
+void SmartLightFleet_adjustToAmbientLight(SmartLightFleet* const me, size_t light);
+void SmartLightFleet_resetStatistics(SmartLightFleet* const me, size_t light);
+void SmartLightFleet_learnFromUsage(SmartLightFleet* const me, size_t light);
+
+// Per-light status
+bool SmartLightFleet_isOn(const SmartLightFleet* const me, size_t light);
+SmartMode SmartLightFleet_getMode(const SmartLightFleet* const me, size_t light);
+BrightnessLevel SmartLightFleet_getBrightness(const SmartLightFleet* const me, size_t light);
+ColorType SmartLightFleet_getColor(const SmartLightFleet* const me, size_t light);
+unsigned int SmartLightFleet_getManualOverrides(const SmartLightFleet* const me, size_t light);
+
+#endif //ANDSTATE_SMARTLIGHTFLEET_H
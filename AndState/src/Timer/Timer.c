@@ -4,9 +4,12 @@
 //
 
 #include "Timer.h"
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+static void expire(Timer* const me);
+
 // Helper functions
 static const char* stateToString(TimerState state) {
     switch(state) {
@@ -27,6 +30,66 @@ static const char* modeToString(TimerMode mode) {
     }
 }
 
+static void onWheelExpiry(void* context) {
+    Timer* me = (Timer*)context;
+    me->elapsed_ms = me->duration_ms;
+    expire(me);
+}
+
+// Files the end of the current period in the wheel, if there is one
+static void schedule(Timer* const me) {
+    if (me->wheel != NULL) {
+        TimerWheel_scheduleAt(me->wheel, &me->entry, me->start_ms + me->duration_ms);
+    }
+}
+
+static void unschedule(Timer* const me) {
+    if (me->wheel != NULL) {
+        TimerWheel_cancel(me->wheel, &me->entry);
+    }
+}
+
+static void restart(Timer* const me, uint64_t from) {
+    me->state = TIMER_RUNNING;
+    me->start_ms = from;
+    me->elapsed_ms = (unsigned int)(Timer_now(me) - from);
+    schedule(me);
+}
+
+static void expire(Timer* const me) {
+    me->state = TIMER_EXPIRED;
+    printf("Timer expired! ");
+
+    // Handle different modes
+    switch (me->mode) {
+        case ONESHOT:
+            printf("(One-shot complete)\n");
+            break;
+
+        case REPEATING:
+            me->current_repeats++;
+            if (me->repeat_count == 0 || me->current_repeats < me->repeat_count) {
+                printf("(Repeating - cycle %d)\n", me->current_repeats);
+                // Next period starts where this one ended, so lateness does not add up
+                restart(me, me->start_ms + me->duration_ms);
+            } else {
+                printf("(Repeat limit reached)\n");
+            }
+            break;
+
+        case COUNTDOWN:
+            printf("(Countdown finished)\n");
+            if (me->auto_reset) {
+                restart(me, Timer_now(me));
+            }
+            break;
+    }
+
+    if (me->on_expire != NULL) {
+        me->on_expire(me, me->context);
+    }
+}
+
 // Constructor/Destructor
 void Timer_Init(Timer* const me, unsigned int duration_ms, TimerMode mode) {
     if (me == NULL) return;
@@ -35,10 +98,14 @@ void Timer_Init(Timer* const me, unsigned int duration_ms, TimerMode mode) {
     me->mode = mode;
     me->duration_ms = duration_ms;
     me->elapsed_ms = 0;
-    me->start_time = 0;
+    me->start_ms = 0;
     me->auto_reset = false;
     me->repeat_count = 0;  // Infinite by default
     me->current_repeats = 0;
+    me->wheel = NULL;
+    TimerWheelEntry_Init(&me->entry, onWheelExpiry, me);
+    me->on_expire = NULL;
+    me->context = NULL;
     
     printf("Timer initialized: %d ms, %s mode\n", duration_ms, modeToString(mode));
 }
@@ -46,6 +113,7 @@ void Timer_Init(Timer* const me, unsigned int duration_ms, TimerMode mode) {
 void Timer_Cleanup(Timer* const me) {
     if (me == NULL) return;
     
+    unschedule(me);
     me->state = TIMER_STOPPED;
     printf("Timer cleaned up\n");
 }
@@ -70,8 +138,9 @@ void Timer_start(Timer* const me) {
     if (me == NULL) return;
     
     me->state = TIMER_RUNNING;
-    me->start_time = clock();
+    me->start_ms = Timer_now(me);
     me->elapsed_ms = 0;
+    schedule(me);
     
     printf("Timer started (%s mode)\n", modeToString(me->mode));
 }
@@ -79,6 +148,7 @@ void Timer_start(Timer* const me) {
 void Timer_stop(Timer* const me) {
     if (me == NULL) return;
     
+    unschedule(me);
     me->state = TIMER_STOPPED;
     me->elapsed_ms = 0;
     me->current_repeats = 0;
@@ -90,6 +160,8 @@ void Timer_pause(Timer* const me) {
     if (me == NULL || me->state != TIMER_RUNNING) return;
     
     Timer_update(me);  // Update elapsed time before pausing
+    if (me->state != TIMER_RUNNING) return;  // Expired in that update
+    unschedule(me);
     me->state = TIMER_PAUSED;
     
     printf("Timer paused at %d ms\n", me->elapsed_ms);
@@ -99,7 +171,8 @@ void Timer_resume(Timer* const me) {
     if (me == NULL || me->state != TIMER_PAUSED) return;
     
     me->state = TIMER_RUNNING;
-    me->start_time = clock() - (me->elapsed_ms * CLOCKS_PER_SEC / 1000);
+    me->start_ms = Timer_now(me) - me->elapsed_ms;
+    schedule(me);
     
     printf("Timer resumed from %d ms\n", me->elapsed_ms);
 }
@@ -110,7 +183,8 @@ void Timer_reset(Timer* const me) {
     me->elapsed_ms = 0;
     me->current_repeats = 0;
     if (me->state == TIMER_RUNNING) {
-        me->start_time = clock();
+        me->start_ms = Timer_now(me);
+        schedule(me);
     }
     
     printf("Timer reset\n");
@@ -128,6 +202,9 @@ void Timer_setDuration(Timer* const me, unsigned int duration_ms) {
     if (me == NULL) return;
     
     me->duration_ms = duration_ms;
+    if (me->state == TIMER_RUNNING) {
+        schedule(me);  // Same start, new end
+    }
     printf("Timer duration changed to: %d ms\n", duration_ms);
 }
 
@@ -145,41 +222,41 @@ void Timer_setRepeatCount(Timer* const me, unsigned int count) {
     printf("Timer repeat count set to: %d (0 = infinite)\n", count);
 }
 
+// Scheduling
+void Timer_attach(Timer* const me, TimerWheel* wheel) {
+    if (me == NULL || me->wheel == wheel) return;
+
+    // Carry the elapsed time over from the old clock to the new one
+    Timer_update(me);
+    unschedule(me);
+    me->wheel = wheel;
+    if (me->state == TIMER_RUNNING) {
+        me->start_ms = Timer_now(me) - me->elapsed_ms;
+        schedule(me);
+    }
+}
+
+void Timer_setCallback(Timer* const me, TimerCallback callback, void* context) {
+    if (me == NULL) return;
+
+    me->on_expire = callback;
+    me->context = context;
+}
+
+uint64_t Timer_now(Timer* const me) {
+    return (me != NULL && me->wheel != NULL) ? TimerWheel_now(me->wheel) : TimerWheel_monotonicMs();
+}
+
 // Core update function
 void Timer_update(Timer* const me) {
     if (me == NULL || me->state != TIMER_RUNNING) return;
     
-    clock_t current_time = clock();
-    me->elapsed_ms = (unsigned int)((current_time - me->start_time) * 1000 / CLOCKS_PER_SEC);
+    uint64_t elapsed = Timer_now(me) - me->start_ms;
+    me->elapsed_ms = (elapsed > UINT_MAX) ? UINT_MAX : (unsigned int)elapsed;
     
-    // Check if timer expired
-    if (me->elapsed_ms >= me->duration_ms) {
-        me->state = TIMER_EXPIRED;
-        printf("Timer expired! ");
-        
-        // Handle different modes
-        switch (me->mode) {
-            case ONESHOT:
-                printf("(One-shot complete)\n");
-                break;
-                
-            case REPEATING:
-                me->current_repeats++;
-                if (me->repeat_count == 0 || me->current_repeats < me->repeat_count) {
-                    printf("(Repeating - cycle %d)\n", me->current_repeats);
-                    Timer_start(me);  // Restart automatically
-                } else {
-                    printf("(Repeat limit reached)\n");
-                }
-                break;
-                
-            case COUNTDOWN:
-                printf("(Countdown finished)\n");
-                if (me->auto_reset) {
-                    Timer_start(me);
-                }
-                break;
-        }
+    // An attached timer is expired by its wheel, exactly on time
+    if (me->wheel == NULL && me->elapsed_ms >= me->duration_ms) {
+        expire(me);
     }
 }
 
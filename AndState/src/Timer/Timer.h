@@ -7,8 +7,9 @@
 #ifndef ANDSTATE_TIMER_H
 #define ANDSTATE_TIMER_H
 
+#include "TimerWheel.h"
 #include <stdbool.h>
-#include <time.h>
+#include <stdint.h>
 
 typedef enum TimerState {
     TIMER_STOPPED,
@@ -24,6 +25,10 @@ typedef enum TimerMode {
 } TimerMode;
 
 typedef struct Timer Timer;
+
+// Called after the timer has handled its own expiry (restart, limits)
+typedef void (*TimerCallback)(Timer* timer, void* context);
+
 struct Timer {
     // AND Pattern: Timer has multiple independent aspects
     TimerState state;       // Current timer state
@@ -32,12 +37,18 @@ struct Timer {
     // Timing data
     unsigned int duration_ms;    // Timer duration in milliseconds
     unsigned int elapsed_ms;     // Time elapsed
-    clock_t start_time;          // When timer was started
+    uint64_t start_ms;           // When the current period started (see Timer_now)
 
     // Configuration
     bool auto_reset;        // Reset automatically when expired
     unsigned int repeat_count;   // How many times to repeat (0 = infinite)
     unsigned int current_repeats; // Current repeat count
+
+    // Scheduling
+    TimerWheel* wheel;           // NULL: expiry found by polling Timer_update
+    TimerWheelEntry entry;       // Filed in the wheel while running
+    TimerCallback on_expire;     // Optional expiry notification
+    void* context;
 };
 
 // Constructor/Destructor
@@ -59,8 +70,13 @@ void Timer_setDuration(Timer* const me, unsigned int duration_ms);
 void Timer_setAutoReset(Timer* const me, bool auto_reset);
 void Timer_setRepeatCount(Timer* const me, unsigned int count);
 
+// Scheduling - a timer attached to a wheel is called back, not polled
+void Timer_attach(Timer* const me, TimerWheel* wheel);  // NULL goes back to polling
+void Timer_setCallback(Timer* const me, TimerCallback callback, void* context);
+uint64_t Timer_now(Timer* const me);  // Wheel time if attached, else CLOCK_MONOTONIC ms
+
 // Status and utility functions
-void Timer_update(Timer* const me);  // Call this regularly to update timer
+void Timer_update(Timer* const me);  // Refreshes elapsed time; detects expiry when not attached
 bool Timer_isExpired(Timer* const me);
 bool Timer_isRunning(Timer* const me);
 unsigned int Timer_getRemainingTime(Timer* const me);
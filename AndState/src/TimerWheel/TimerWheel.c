@@ -0,0 +1,306 @@
+//
+// TimerWheel Implementation
+// Level L holds entries whose expiry first differs from `now` in bits
+// [8L, 8L+8); the slot is those bits. When the lower levels wrap, the
+// slot of level L that `now` has reached is emptied into lower levels.
+//
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "TimerWheel.h"
+#include <stdlib.h>
+#include <time.h>
+
+#define SLOT_MASK ((uint64_t)TIMER_WHEEL_SLOTS - 1u)
+
+// Helper functions
+static void listInit(TimerWheelLink* head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static bool listEmpty(const TimerWheelLink* head) {
+    return head->next == head;
+}
+
+static void listAppend(TimerWheelLink* head, TimerWheelLink* link) {
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void listUnlink(TimerWheelLink* link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = link;
+    link->prev = link;
+}
+
+// Moves every link of `from` onto the empty list `to`
+static void listTake(TimerWheelLink* to, TimerWheelLink* from) {
+    listInit(to);
+    if (!listEmpty(from)) {
+        to->next = from->next;
+        to->prev = from->prev;
+        to->next->prev = to;
+        to->prev->next = to;
+        listInit(from);
+    }
+}
+
+static void markSlot(TimerWheel* const me, unsigned int level, unsigned int slot) {
+    me->occupied[level][slot / 64u] |= (uint64_t)1 << (slot % 64u);
+}
+
+static void clearSlot(TimerWheel* const me, unsigned int level, unsigned int slot) {
+    me->occupied[level][slot / 64u] &= ~((uint64_t)1 << (slot % 64u));
+}
+
+// First non-empty slot of a level at or after `from`, or TIMER_WHEEL_SLOTS
+static unsigned int nextSlot(const TimerWheel* const me, unsigned int level, unsigned int from) {
+    while (from < TIMER_WHEEL_SLOTS) {
+        uint64_t bits = me->occupied[level][from / 64u] >> (from % 64u);
+        if (bits != 0) {
+            return from + (unsigned int)__builtin_ctzll(bits);
+        }
+        from = (from / 64u + 1u) * 64u;
+    }
+    return TIMER_WHEEL_SLOTS;
+}
+
+static void file(TimerWheel* const me, TimerWheelEntry* const entry) {
+    uint64_t diff = entry->expires ^ me->now;
+    unsigned int level = 0;
+
+    // Index of the highest differing bit, in whole levels
+    if (diff > SLOT_MASK) {
+        level = (unsigned int)(63 - __builtin_clzll(diff)) / TIMER_WHEEL_SLOT_BITS;
+    }
+    entry->level = (uint16_t)level;
+    entry->slot = (uint16_t)((entry->expires >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK);
+    listAppend(&me->slots[level][entry->slot], &entry->link);
+    markSlot(me, level, entry->slot);
+    entry->pending = true;
+}
+
+static void unfile(TimerWheel* const me, TimerWheelEntry* const entry) {
+    TimerWheelLink* head = &me->slots[entry->level][entry->slot];
+    listUnlink(&entry->link);
+    if (listEmpty(head)) {
+        clearSlot(me, entry->level, entry->slot);
+    }
+    entry->pending = false;
+}
+
+// Refiles a higher-level slot now that `now` has reached it
+static void cascade(TimerWheel* const me, unsigned int level, unsigned int slot) {
+    TimerWheelLink moving;
+    listTake(&moving, &me->slots[level][slot]);
+    clearSlot(me, level, slot);
+    while (!listEmpty(&moving)) {
+        TimerWheelEntry* entry = (TimerWheelEntry*)moving.next;
+        listUnlink(&entry->link);
+        file(me, entry);
+    }
+}
+
+static unsigned int expireSlot(TimerWheel* const me, unsigned int slot) {
+    TimerWheelLink due;
+    unsigned int fired = 0;
+
+    // Detached first: callbacks may start, stop or restart any entry
+    listTake(&due, &me->slots[0][slot]);
+    clearSlot(me, 0, slot);
+    while (!listEmpty(&due)) {
+        TimerWheelEntry* entry = (TimerWheelEntry*)due.next;
+        listUnlink(&entry->link);
+        entry->pending = false;
+        me->pending--;
+        me->expired++;
+        fired++;
+        if (entry->callback != NULL) {
+            entry->callback(entry->context);
+        }
+    }
+    return fired;
+}
+
+/*
+ * Next tick at which something happens: a level-0 slot to expire, or the
+ * wrap that reaches a non-empty slot further up. Slots in between are
+ * empty, so the wheel jumps straight there.
+ */
+static uint64_t nextEventTick(const TimerWheel* const me) {
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        unsigned int shift = level * TIMER_WHEEL_SLOT_BITS;
+        unsigned int current = (unsigned int)((me->now >> shift) & SLOT_MASK);
+        unsigned int slot = nextSlot(me, level, current + 1u);
+        if (slot < TIMER_WHEEL_SLOTS) {
+            uint64_t above = me->now & ~((SLOT_MASK << shift) | (((uint64_t)1 << shift) - 1u));
+            return above | ((uint64_t)slot << shift);
+        }
+    }
+    return UINT64_MAX;  // Unreachable while anything is pending
+}
+
+static unsigned int advanceTo(TimerWheel* const me, uint64_t target) {
+    unsigned int fired = 0;
+
+    while (me->now < target) {
+        uint64_t next;
+        if (me->pending == 0) {
+            me->now = target;  // Nothing can fire on the way
+            break;
+        }
+        next = nextEventTick(me);
+        if (next > target) {
+            me->now = target;  // Only empty slots before target
+            break;
+        }
+        me->now = next;
+        if ((me->now & SLOT_MASK) == 0) {
+            // Lowest level whose digit moved owns the entries due next
+            for (unsigned int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+                unsigned int slot = (unsigned int)((me->now >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK);
+                if (slot != 0) {
+                    cascade(me, level, slot);
+                    break;
+                }
+            }
+        }
+        fired += expireSlot(me, (unsigned int)(me->now & SLOT_MASK));
+    }
+    return fired;
+}
+
+// Constructor/Destructor
+void TimerWheel_Init(TimerWheel* const me) {
+    if (me == NULL) return;
+
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (unsigned int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            listInit(&me->slots[level][slot]);
+        }
+    }
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (unsigned int i = 0; i < TIMER_WHEEL_SLOTS / 64u; i++) {
+            me->occupied[level][i] = 0;
+        }
+    }
+    me->now = 0;
+    me->origin_ms = TimerWheel_monotonicMs();
+    me->pending = 0;
+    me->expired = 0;
+}
+
+void TimerWheel_Cleanup(TimerWheel* const me) {
+    if (me == NULL) return;
+
+    // Entries belong to their owners; just leave them unfiled
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (unsigned int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            TimerWheelLink* head = &me->slots[level][slot];
+            while (!listEmpty(head)) {
+                TimerWheelEntry* entry = (TimerWheelEntry*)head->next;
+                listUnlink(&entry->link);
+                entry->pending = false;
+            }
+            clearSlot(me, level, slot);
+        }
+    }
+    me->pending = 0;
+}
+
+TimerWheel* TimerWheel_Create(void) {
+    TimerWheel* me = (TimerWheel*)malloc(sizeof(TimerWheel));
+    if (me != NULL) {
+        TimerWheel_Init(me);
+    }
+    return me;
+}
+
+void TimerWheel_Destroy(TimerWheel* const me) {
+    if (me != NULL) {
+        TimerWheel_Cleanup(me);
+        free(me);
+    }
+}
+
+void TimerWheelEntry_Init(TimerWheelEntry* const entry, TimerWheelCallback callback, void* context) {
+    if (entry == NULL) return;
+
+    listInit(&entry->link);
+    entry->expires = 0;
+    entry->callback = callback;
+    entry->context = context;
+    entry->level = 0;
+    entry->slot = 0;
+    entry->pending = false;
+}
+
+// Scheduling
+void TimerWheel_schedule(TimerWheel* const me, TimerWheelEntry* const entry, unsigned int delay_ms) {
+    if (me == NULL) return;
+
+    TimerWheel_scheduleAt(me, entry, me->now + delay_ms);
+}
+
+void TimerWheel_scheduleAt(TimerWheel* const me, TimerWheelEntry* const entry, uint64_t tick) {
+    if (me == NULL || entry == NULL) return;
+
+    if (entry->pending) {
+        unfile(me, entry);
+        me->pending--;
+    }
+    // The current tick has been processed; the earliest it can fire is the next
+    if (tick <= me->now) {
+        tick = me->now + 1u;
+    }
+    entry->expires = tick;
+    file(me, entry);
+    me->pending++;
+}
+
+void TimerWheel_cancel(TimerWheel* const me, TimerWheelEntry* const entry) {
+    if (me == NULL || entry == NULL || !entry->pending) return;
+
+    unfile(me, entry);
+    me->pending--;
+}
+
+// Driving the wheel
+unsigned int TimerWheel_advance(TimerWheel* const me, unsigned int elapsed_ms) {
+    if (me == NULL) return 0;
+
+    return advanceTo(me, me->now + elapsed_ms);
+}
+
+unsigned int TimerWheel_poll(TimerWheel* const me) {
+    if (me == NULL) return 0;
+
+    return advanceTo(me, TimerWheel_monotonicMs() - me->origin_ms);
+}
+
+// Status
+uint64_t TimerWheel_now(const TimerWheel* const me) {
+    return (me != NULL) ? me->now : 0;
+}
+
+size_t TimerWheel_getPending(const TimerWheel* const me) {
+    return (me != NULL) ? me->pending : 0;
+}
+
+unsigned long TimerWheel_getExpired(const TimerWheel* const me) {
+    return (me != NULL) ? me->expired : 0;
+}
+
+bool TimerWheelEntry_isPending(const TimerWheelEntry* const entry) {
+    return (entry != NULL) && entry->pending;
+}
+
+uint64_t TimerWheel_monotonicMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
@@ -0,0 +1,73 @@
+//
+// TimerWheel Component - Hierarchical timing wheel on CLOCK_MONOTONIC
+// Timers register an entry once and are called back when they expire,
+// so nothing has to poll every timer on every tick. Start, stop and
+// expiry are O(1); an entry far in the future is moved down one level
+// at a time as its slot comes round (at most TIMER_WHEEL_LEVELS moves).
+//
+
+#ifndef ANDSTATE_TIMERWHEEL_H
+#define ANDSTATE_TIMERWHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMER_WHEEL_SLOT_BITS 8u
+#define TIMER_WHEEL_SLOTS (1u << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVELS 8u      // All 64 bits of ticks: any deadline has a level
+
+typedef void (*TimerWheelCallback)(void* context);
+
+typedef struct TimerWheelLink TimerWheelLink;
+struct TimerWheelLink {
+    TimerWheelLink* next;
+    TimerWheelLink* prev;
+};
+
+typedef struct TimerWheelEntry TimerWheelEntry;
+struct TimerWheelEntry {
+    TimerWheelLink link;          // Must stay first: slots hold links
+    uint64_t expires;             // Wheel tick to fire on
+    TimerWheelCallback callback;  // Called once per expiry
+    void* context;                // Passed to the callback
+    uint16_t level;               // Where the entry is filed while pending
+    uint16_t slot;
+    bool pending;                 // Filed in the wheel
+};
+
+typedef struct TimerWheel TimerWheel;
+struct TimerWheel {
+    TimerWheelLink slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t occupied[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS / 64u];  // Non-empty slots, for skipping idle time
+    uint64_t now;                 // Last tick processed
+    uint64_t origin_ms;           // CLOCK_MONOTONIC time of tick 0
+    size_t pending;               // Entries in the wheel
+    unsigned long expired;        // Callbacks made so far
+};
+
+// Constructor/Destructor - one tick is one millisecond
+void TimerWheel_Init(TimerWheel* const me);
+void TimerWheel_Cleanup(TimerWheel* const me);
+TimerWheel* TimerWheel_Create(void);
+void TimerWheel_Destroy(TimerWheel* const me);
+
+void TimerWheelEntry_Init(TimerWheelEntry* const entry, TimerWheelCallback callback, void* context);
+
+// Scheduling - a pending entry is moved, not added twice
+void TimerWheel_schedule(TimerWheel* const me, TimerWheelEntry* const entry, unsigned int delay_ms);
+void TimerWheel_scheduleAt(TimerWheel* const me, TimerWheelEntry* const entry, uint64_t tick);
+void TimerWheel_cancel(TimerWheel* const me, TimerWheelEntry* const entry);
+
+// Driving the wheel - both return the number of callbacks made
+unsigned int TimerWheel_advance(TimerWheel* const me, unsigned int elapsed_ms);  // Simulated time
+unsigned int TimerWheel_poll(TimerWheel* const me);  // Catch up with CLOCK_MONOTONIC
+
+// Status
+uint64_t TimerWheel_now(const TimerWheel* const me);
+size_t TimerWheel_getPending(const TimerWheel* const me);
+unsigned long TimerWheel_getExpired(const TimerWheel* const me);
+bool TimerWheelEntry_isPending(const TimerWheelEntry* const entry);
+uint64_t TimerWheel_monotonicMs(void);
+
+#endif //ANDSTATE_TIMERWHEEL_H
@@ -0,0 +1,341 @@
+//
+// SensorStats Tests - Streaming statistics checked against brute force
+// Readings come from a fixed generator so every run sees the same stream
+//
+
+#include "unity.h"
+#include "SensorStats.h"
+#include "Sensor.h"
+#include <math.h>
+
+#define READINGS 100000u
+
+static SensorStats* stats;
+static unsigned int seed;
+
+static float uniform(void) {
+    seed = seed * 1103515245u + 12345u;
+    return (float)(seed >> 8) / 16777216.0f;  // [0, 1)
+}
+
+// Roughly normal with mean 0 and standard deviation 1
+static float gaussian(void) {
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        sum += uniform();
+    }
+    return sum - 6.0f;
+}
+
+void setUp(void) {
+    stats = SensorStats_Create();
+    seed = 12345u;
+}
+
+void tearDown(void) {
+    SensorStats_Destroy(stats);
+    stats = NULL;
+}
+
+void test_SensorStats_Initial_State(void) {
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT_EQUAL_UINT(0, SensorStats_getCount(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getMean(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getVariance(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getWindowMin(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getWindowMax(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getQuantile(stats, SENSOR_STATS_MEDIAN));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getErrorRate(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getNoise(stats));
+    TEST_ASSERT_FALSE(SensorStats_isAnomaly(stats));
+}
+
+// Welford against a two-pass mean and variance, on a large offset
+void test_SensorStats_Mean_And_Variance(void) {
+    static float readings[READINGS];
+    double sum = 0.0;
+    double squares = 0.0;
+
+    for (unsigned int i = 0; i < READINGS; i++) {
+        readings[i] = 1000.0f + 5.0f * gaussian();
+        SensorStats_push(stats, readings[i]);
+        sum += (double)readings[i];
+    }
+    double mean = sum / READINGS;
+    for (unsigned int i = 0; i < READINGS; i++) {
+        squares += ((double)readings[i] - mean) * ((double)readings[i] - mean);
+    }
+
+    TEST_ASSERT_EQUAL_UINT(READINGS, SensorStats_getCount(stats));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)mean, SensorStats_getMean(stats));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)(squares / (READINGS - 1u)), SensorStats_getVariance(stats));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 5.0f, SensorStats_getStdDev(stats));
+}
+
+void test_SensorStats_Ewma_Follows_Steps(void) {
+    SensorStats_setSmoothing(stats, 0.5f);
+
+    SensorStats_push(stats, 10.0f);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, SensorStats_getEwma(stats));  // Starts at the first reading
+    SensorStats_push(stats, 20.0f);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, SensorStats_getEwma(stats));
+    for (int i = 0; i < 40; i++) {
+        SensorStats_push(stats, 20.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 20.0f, SensorStats_getEwma(stats));
+
+    SensorStats_setSmoothing(stats, 0.0f);  // Ignored
+    SensorStats_setSmoothing(stats, 1.5f);  // Ignored
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, stats->alpha);
+}
+
+// Window min/max against a scan of the last SENSOR_STATS_WINDOW readings
+void test_SensorStats_Window_Min_Max(void) {
+    static float readings[READINGS];
+
+    for (unsigned int i = 0; i < READINGS; i++) {
+        // Runs up and down so both deques grow long, with noise on top
+        readings[i] = (float)((i / 200u) % 2u ? 200u - i % 200u : i % 200u) + gaussian();
+        SensorStats_push(stats, readings[i]);
+
+        unsigned int first = (i + 1u > SENSOR_STATS_WINDOW) ? i + 1u - SENSOR_STATS_WINDOW : 0u;
+        float lo = readings[first];
+        float hi = readings[first];
+        for (unsigned int j = first; j <= i; j++) {
+            lo = fminf(lo, readings[j]);
+            hi = fmaxf(hi, readings[j]);
+        }
+        TEST_ASSERT_EQUAL_FLOAT(lo, SensorStats_getWindowMin(stats));
+        TEST_ASSERT_EQUAL_FLOAT(hi, SensorStats_getWindowMax(stats));
+    }
+}
+
+// A smooth sweep leaves the EWMA a steady lag behind, which is not noise
+void test_SensorStats_Noise_Ignores_A_Smooth_Sweep(void) {
+    for (unsigned int i = 0; i < 1000u; i++) {
+        SensorStats_push(stats, (float)i);
+    }
+    TEST_ASSERT_TRUE(SensorStats_getStdDev(stats) > 250.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, SensorStats_getNoise(stats));
+
+    for (unsigned int i = 0; i < 1000u; i++) {
+        SensorStats_push(stats, 500.0f + 490.0f * sinf(6.2831853f * (float)i / 1000.0f));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 0.0f, SensorStats_getNoise(stats));  // The lag drifts a little as the slope turns
+}
+
+void test_SensorStats_Noise_Measures_Jitter_On_A_Sweep(void) {
+    for (unsigned int i = 0; i < 1000u; i++) {
+        SensorStats_push(stats, (float)i + 2.0f * gaussian());
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.6f, 2.0f, SensorStats_getNoise(stats));
+}
+
+// Only the last SENSOR_STATS_WINDOW residuals count
+void test_SensorStats_Noise_Forgets_After_A_Window(void) {
+    for (unsigned int i = 0; i < 1000u; i++) {
+        SensorStats_push(stats, 50.0f + 10.0f * gaussian());
+    }
+    TEST_ASSERT_TRUE(SensorStats_getNoise(stats) > 5.0f);
+
+    // The EWMA settles within one window, the next one sees no noise at all
+    for (unsigned int i = 0; i < 2u * SENSOR_STATS_WINDOW; i++) {
+        SensorStats_push(stats, 50.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, SensorStats_getNoise(stats));
+}
+
+void test_SensorStats_Quantiles_Of_Uniform_Readings(void) {
+    for (unsigned int i = 0; i < READINGS; i++) {
+        SensorStats_push(stats, uniform());
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.05f, SensorStats_getQuantile(stats, SENSOR_STATS_P5));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, SensorStats_getQuantile(stats, SENSOR_STATS_MEDIAN));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.95f, SensorStats_getQuantile(stats, SENSOR_STATS_P95));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getQuantile(stats, SENSOR_STATS_QUANTILES));
+}
+
+void test_SensorStats_Quantiles_Of_Few_Readings(void) {
+    SensorStats_push(stats, 3.0f);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, SensorStats_getQuantile(stats, SENSOR_STATS_MEDIAN));
+
+    SensorStats_push(stats, 1.0f);
+    SensorStats_push(stats, 2.0f);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, SensorStats_getQuantile(stats, SENSOR_STATS_P5));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, SensorStats_getQuantile(stats, SENSOR_STATS_MEDIAN));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, SensorStats_getQuantile(stats, SENSOR_STATS_P95));
+}
+
+void test_SensorStats_Anomaly_Scoring(void) {
+    for (unsigned int i = 0; i < 1000u; i++) {
+        SensorStats_push(stats, 50.0f + gaussian());
+    }
+    TEST_ASSERT_FALSE(SensorStats_isAnomaly(stats));
+
+    float score = SensorStats_push(stats, 60.0f);  // About ten standard deviations out
+
+    TEST_ASSERT_TRUE(score > 8.0f);
+    TEST_ASSERT_EQUAL_FLOAT(score, SensorStats_getLastScore(stats));
+    TEST_ASSERT_TRUE(SensorStats_isAnomaly(stats));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f / SENSOR_STATS_WINDOW, SensorStats_getAnomalyRate(stats));
+
+    SensorStats_setAnomalyThreshold(stats, 20.0f);
+    SensorStats_push(stats, 60.0f);
+    TEST_ASSERT_FALSE(SensorStats_isAnomaly(stats));
+
+    // The anomaly leaves the window after SENSOR_STATS_WINDOW more readings
+    for (unsigned int i = 0; i < SENSOR_STATS_WINDOW; i++) {
+        SensorStats_push(stats, 50.0f + gaussian());
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getAnomalyRate(stats));
+}
+
+void test_SensorStats_Error_Rate_Window(void) {
+    SensorStats_pushError(stats);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, SensorStats_getErrorRate(stats));
+    SensorStats_push(stats, 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, SensorStats_getErrorRate(stats));
+    TEST_ASSERT_EQUAL_UINT(1, SensorStats_getCount(stats));  // Errors are not readings
+
+    for (unsigned int i = 0; i < SENSOR_STATS_WINDOW - 2u; i++) {
+        SensorStats_push(stats, 1.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f / SENSOR_STATS_WINDOW, SensorStats_getErrorRate(stats));
+    SensorStats_push(stats, 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getErrorRate(stats));
+}
+
+void test_SensorStats_Reset_Keeps_Settings(void) {
+    SensorStats_setSmoothing(stats, 0.25f);
+    SensorStats_setAnomalyThreshold(stats, 3.0f);
+    for (unsigned int i = 0; i < 100u; i++) {
+        SensorStats_push(stats, uniform());
+    }
+    SensorStats_pushError(stats);
+
+    SensorStats_reset(stats);
+
+    TEST_ASSERT_EQUAL_UINT(0, SensorStats_getCount(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getErrorRate(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getWindowMax(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getNoise(stats));
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, stats->alpha);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, stats->anomaly_z);
+    SensorStats_push(stats, 7.0f);
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, SensorStats_getQuantile(stats, SENSOR_STATS_MEDIAN));
+}
+
+// Sensor quality and error rate come from its statistics
+void test_Sensor_Takes_Batches_Into_Statistics(void) {
+    Sensor* sensor = Sensor_Create(TEMPERATURE_SENSOR, -50.0f, 150.0f);
+
+    TEST_ASSERT_EQUAL_UINT(0, Sensor_takeSamples(sensor, 100u));  // Still off
+    Sensor_turnOn(sensor);
+    TEST_ASSERT_EQUAL_UINT(10000u, Sensor_takeSamples(sensor, 10000u));
+
+    const SensorStats* s = Sensor_getStats(sensor);
+    TEST_ASSERT_EQUAL_UINT(10000u, SensorStats_getCount(s));
+    TEST_ASSERT_EQUAL_UINT(10000u, Sensor_getSampleCount(sensor));
+    TEST_ASSERT_FLOAT_WITHIN(0.15f, 30.0f, SensorStats_getMean(s));  // Ten full cycles around 30°C, calibrated to ±0.1
+    TEST_ASSERT_EQUAL(SENSOR_READY, sensor->state);
+    TEST_ASSERT_EQUAL(QUALITY_EXCELLENT, Sensor_getQuality(sensor));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, Sensor_getErrorRate(sensor));
+
+    Sensor_resetStatistics(sensor);
+    TEST_ASSERT_EQUAL_UINT(0, SensorStats_getCount(s));
+    Sensor_Destroy(sensor);
+}
+
+void test_Sensor_Quality_From_Errors_And_Noise(void) {
+    Sensor* cold = Sensor_Create(TEMPERATURE_SENSOR, -20.0f, 10.0f);   // Every reading falls outside
+    Sensor* light = Sensor_Create(LIGHT_SENSOR, 0.0f, 1000.0f);
+
+    Sensor_turnOn(cold);
+    Sensor_takeSamples(cold, 100u);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, Sensor_getErrorRate(cold));
+    TEST_ASSERT_EQUAL(100u, cold->error_count);
+    TEST_ASSERT_EQUAL(QUALITY_INVALID, Sensor_getQuality(cold));
+
+    // The reading sweeps most of the range: a wide spread, but little noise
+    Sensor_turnOn(light);
+    Sensor_takeSamples(light, 1000u);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, Sensor_getErrorRate(light));
+    TEST_ASSERT_TRUE(SensorStats_getStdDev(Sensor_getStats(light)) > 0.1f * 1000.0f);
+    TEST_ASSERT_EQUAL(QUALITY_EXCELLENT, Sensor_getQuality(light));
+    Sensor_setThresholds(light, 0.0f, 0.0f);  // Any residual at all is too much
+    Sensor_updateQuality(light);
+    TEST_ASSERT_EQUAL(QUALITY_INVALID, Sensor_getQuality(light));
+
+    Sensor_Destroy(cold);
+    Sensor_Destroy(light);
+}
+
+// Every type sweeps its band; the default thresholds accept it over a sensible range
+void test_Sensor_Default_Thresholds_Accept_Every_Type(void) {
+    static const struct {
+        SensorType type;
+        float min_value;
+        float max_value;
+    } ranges[] = {
+        {TEMPERATURE_SENSOR, 0.0f, 50.0f},
+        {HUMIDITY_SENSOR, 0.0f, 100.0f},
+        {PRESSURE_SENSOR, 900.0f, 1200.0f},
+        {LIGHT_SENSOR, 0.0f, 1000.0f},
+    };
+    static const PowerMode modes[] = {POWER_LOW, POWER_NORMAL, POWER_HIGH};
+
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            Sensor* sensor = Sensor_Create(ranges[i].type, ranges[i].min_value, ranges[i].max_value);
+
+            Sensor_turnOn(sensor);
+            Sensor_setPowerMode(sensor, modes[m]);
+            for (unsigned int round = 0; round < 50u; round++) {
+                TEST_ASSERT_EQUAL_UINT(200u, Sensor_takeSamples(sensor, 200u));
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, Sensor_getErrorRate(sensor));
+                TEST_ASSERT_TRUE(Sensor_getQuality(sensor) >= QUALITY_GOOD);
+            }
+            Sensor_Destroy(sensor);
+        }
+    }
+}
+
+void test_SensorStats_NULL_Safety(void) {
+    SensorStats_Init(NULL);
+    SensorStats_reset(NULL);
+    SensorStats_pushError(NULL);
+    SensorStats_setSmoothing(NULL, 0.5f);
+    SensorStats_setAnomalyThreshold(NULL, 3.0f);
+    SensorStats_Destroy(NULL);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_push(NULL, 1.0f));
+    TEST_ASSERT_EQUAL_UINT(0, SensorStats_getCount(NULL));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getStdDev(NULL));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getNoise(NULL));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorStats_getWindowMin(NULL));
+    TEST_ASSERT_FALSE(SensorStats_isAnomaly(NULL));
+    TEST_ASSERT_EQUAL_UINT(0, Sensor_takeSamples(NULL, 10u));
+    TEST_ASSERT_NULL(Sensor_getStats(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SensorStats_Initial_State);
+    RUN_TEST(test_SensorStats_Mean_And_Variance);
+    RUN_TEST(test_SensorStats_Ewma_Follows_Steps);
+    RUN_TEST(test_SensorStats_Window_Min_Max);
+    RUN_TEST(test_SensorStats_Noise_Ignores_A_Smooth_Sweep);
+    RUN_TEST(test_SensorStats_Noise_Measures_Jitter_On_A_Sweep);
+    RUN_TEST(test_SensorStats_Noise_Forgets_After_A_Window);
+    RUN_TEST(test_SensorStats_Quantiles_Of_Uniform_Readings);
+    RUN_TEST(test_SensorStats_Quantiles_Of_Few_Readings);
+    RUN_TEST(test_SensorStats_Anomaly_Scoring);
+    RUN_TEST(test_SensorStats_Error_Rate_Window);
+    RUN_TEST(test_SensorStats_Reset_Keeps_Settings);
+    RUN_TEST(test_Sensor_Takes_Batches_Into_Statistics);
+    RUN_TEST(test_Sensor_Quality_From_Errors_And_Noise);
+    RUN_TEST(test_Sensor_Default_Thresholds_Accept_Every_Type);
+    RUN_TEST(test_SensorStats_NULL_Safety);
+    return UNITY_END();
+}
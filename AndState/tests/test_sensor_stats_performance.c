@@ -0,0 +1,119 @@
+//
+// SensorStats Performance - Readings per second
+// Streaming updates are timed against recomputing the same window
+// statistics from a ring of the last SENSOR_STATS_WINDOW readings, and
+// Sensor_takeSamples is timed end to end (simulated reading included).
+//
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "unity.h"
+#include "SensorStats.h"
+#include "Sensor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define READINGS 4000000u
+#define RESCAN_READINGS 200000u
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int compareFloats(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// reference: keep the window and recompute everything from it per reading
+static float rescanWindow(const float* ring, size_t n) {
+    float sorted[SENSOR_STATS_WINDOW];
+    float lo = ring[0];
+    float hi = ring[0];
+    double sum = 0.0;
+    double squares = 0.0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += (double)ring[i];
+        lo = (ring[i] < lo) ? ring[i] : lo;
+        hi = (ring[i] > hi) ? ring[i] : hi;
+    }
+    double mean = sum / (double)n;
+    for (size_t i = 0; i < n; i++) {
+        squares += ((double)ring[i] - mean) * ((double)ring[i] - mean);
+    }
+    memcpy(sorted, ring, n * sizeof(float));
+    qsort(sorted, n, sizeof(float), compareFloats);
+    return (float)squares + lo + hi + sorted[n / 2];
+}
+
+static float* makeReadings(unsigned int count) {
+    float* readings = (float*)malloc(count * sizeof(float));
+
+    TEST_ASSERT_NOT_NULL(readings);
+    srand(7);
+    for (unsigned int i = 0; i < count; i++) {
+        readings[i] = 20.0f + (float)(rand() % 2000) / 100.0f;
+    }
+    return readings;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_SensorStats_Readings_Per_Second(void) {
+    float* readings = makeReadings(READINGS);
+    float ring[SENSOR_STATS_WINDOW];
+    volatile float sink = 0.0f;
+    SensorStats stats;
+    double start;
+
+    SensorStats_Init(&stats);
+    start = seconds();
+    for (unsigned int i = 0; i < READINGS; i++) {
+        SensorStats_push(&stats, readings[i]);
+    }
+    double streaming = READINGS / (seconds() - start);
+    sink = SensorStats_getQuantile(&stats, SENSOR_STATS_MEDIAN);
+
+    start = seconds();
+    for (unsigned int i = 0; i < RESCAN_READINGS; i++) {
+        ring[i % SENSOR_STATS_WINDOW] = readings[i];
+        sink = rescanWindow(ring, (i < SENSOR_STATS_WINDOW) ? i + 1u : SENSOR_STATS_WINDOW);
+    }
+    double rescan = RESCAN_READINGS / (seconds() - start);
+    (void)sink;
+
+    Sensor* sensor = Sensor_Create(TEMPERATURE_SENSOR, -50.0f, 150.0f);
+    Sensor_turnOn(sensor);
+    start = seconds();
+    unsigned int valid = Sensor_takeSamples(sensor, READINGS);
+    double batch = READINGS / (seconds() - start);
+
+    printf("\n  %-28s %12s\n", "readings per second", "M/s");
+    printf("  %-28s %12.2f\n", "window rescan (reference)", rescan / 1e6);
+    printf("  %-28s %12.2f\n", "SensorStats_push", streaming / 1e6);
+    printf("  %-28s %12.2f\n", "Sensor_takeSamples", batch / 1e6);
+
+    TEST_ASSERT_EQUAL_UINT(READINGS, valid);
+    TEST_ASSERT_EQUAL_UINT(READINGS, SensorStats_getCount(Sensor_getStats(sensor)));
+    TEST_ASSERT_TRUE(streaming > rescan);
+    TEST_ASSERT_TRUE(streaming > 1e6);
+
+    Sensor_Destroy(sensor);
+    free(readings);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SensorStats_Readings_Per_Second);
+    return UNITY_END();
+}
@@ -0,0 +1,365 @@
+//
+// SmartLightFleet Tests - Batch ticks over struct-of-arrays state
+// Sensor inputs are written straight into the fleet, so behaviour is exact
+//
+
+#include "unity.h"
+#include "SmartLightFleet.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RANDOM_FLEET 10007  // Not a multiple of the worker chunk
+#define RANDOM_TICKS 200
+#define MATCH_STEPS 4000
+
+static SmartLightFleet* fleet;
+
+void setUp(void) {
+    fleet = SmartLightFleet_Create(16);
+}
+
+void tearDown(void) {
+    SmartLightFleet_Destroy(fleet);
+    fleet = NULL;
+}
+
+// Test new lights start like SmartLight_Init and the fleet stops when full
+void test_SmartLightFleet_Add_Uses_SmartLight_Defaults(void) {
+    TEST_ASSERT_NOT_NULL(fleet);
+    for (size_t i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL(i, SmartLightFleet_add(fleet));
+    }
+    TEST_ASSERT_EQUAL(SMART_LIGHT_FLEET_FULL, SmartLightFleet_add(fleet));
+    TEST_ASSERT_EQUAL(16, SmartLightFleet_getCount(fleet));
+
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, 3));
+    TEST_ASSERT_EQUAL(AUTO_MODE, SmartLightFleet_getMode(fleet, 3));
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MEDIUM, SmartLightFleet_getBrightness(fleet, 3));
+    TEST_ASSERT_EQUAL(0, SmartLightFleet_getManualOverrides(fleet, 3));
+
+    // Out of range lights read as off and ignore writes
+    SmartLightFleet_turnOn(fleet, 16);
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, 16));
+}
+
+// Test the arrays come from one cache-line aligned block
+void test_SmartLightFleet_Arrays_Are_Aligned(void) {
+    SmartLightFleet_add(fleet);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)fleet->is_on % 64);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)fleet->ambient_lux % 64);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)fleet->fade_elapsed % 64);
+    TEST_ASSERT_TRUE((unsigned char*)fleet->fading > (unsigned char*)fleet->block);
+    TEST_ASSERT_EQUAL_PTR(fleet->ambient_lux, SmartLightFleet_ambientInputs(fleet));
+    TEST_ASSERT_EQUAL_PTR(fleet->motion_level, SmartLightFleet_motionInputs(fleet));
+}
+
+// Test darkness turns AUTO lights on, in green when saving energy
+void test_SmartLightFleet_Dark_Ambient_Turns_Lights_On(void) {
+    size_t plain = SmartLightFleet_add(fleet);
+    size_t saving = SmartLightFleet_add(fleet);
+    size_t manual = SmartLightFleet_add(fleet);
+
+    SmartLightFleet_enableEnergySaving(fleet, saving, true);
+    SmartLightFleet_setMode(fleet, manual, MANUAL_MODE);
+    for (size_t i = 0; i < 3; i++) {
+        SmartLightFleet_setAmbientLight(fleet, i, 20.0f);
+    }
+    SmartLightFleet_tick(fleet, 10);
+
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, plain));
+    TEST_ASSERT_EQUAL(RED, SmartLightFleet_getColor(fleet, plain));
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, saving));
+    TEST_ASSERT_EQUAL(GREEN, SmartLightFleet_getColor(fleet, saving));
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, manual));
+
+    // Changes of 50 lux or less are ignored
+    SmartLightFleet_setAmbientLight(fleet, plain, 70.0f);
+    SmartLightFleet_tick(fleet, 10);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, fleet->last_light_level[plain]);
+}
+
+// Test a bright room fades the light down over the fade duration
+void test_SmartLightFleet_Bright_Ambient_Fades_To_Dim(void) {
+    size_t light = SmartLightFleet_add(fleet);
+
+    SmartLightFleet_turnOn(fleet, light);
+    SmartLightFleet_setAmbientLight(fleet, light, 900.0f);
+    SmartLightFleet_tick(fleet, 0);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MEDIUM, SmartLightFleet_getBrightness(fleet, light));
+
+    SmartLightFleet_tick(fleet, 400);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MEDIUM, SmartLightFleet_getBrightness(fleet, light));
+    SmartLightFleet_tick(fleet, 200);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_DIM, SmartLightFleet_getBrightness(fleet, light));
+    TEST_ASSERT_EQUAL(GREEN, SmartLightFleet_getColor(fleet, light));
+    TEST_ASSERT_TRUE(fleet->fading[light]);
+    SmartLightFleet_tick(fleet, 400);
+    TEST_ASSERT_FALSE(fleet->fading[light]);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_DIM, SmartLightFleet_getBrightness(fleet, light));
+
+    // Without a fade duration the level lands at once
+    SmartLightFleet_setFadeDuration(fleet, light, 0);
+    SmartLightFleet_fadeToLevel(fleet, light, BRIGHTNESS_MAX);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MAX, SmartLightFleet_getBrightness(fleet, light));
+    TEST_ASSERT_EQUAL(RED, SmartLightFleet_getColor(fleet, light));
+}
+
+// Test motion turns lights on, brightens them, and arms the auto-off timer
+void test_SmartLightFleet_Motion_Edges(void) {
+    size_t light = SmartLightFleet_add(fleet);
+
+    SmartLightFleet_setFadeDuration(fleet, light, 0);
+    SmartLightFleet_setAutoTimeout(fleet, light, 5000);
+    SmartLightFleet_setMotion(fleet, light, 0.9f);
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, light));
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MEDIUM, SmartLightFleet_getBrightness(fleet, light));
+
+    // Steady motion is not a new edge
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_MEDIUM, SmartLightFleet_getBrightness(fleet, light));
+
+    SmartLightFleet_setMotion(fleet, light, 0.1f);
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_EQUAL(5000, fleet->auto_remaining[light]);
+
+    SmartLightFleet_setMotion(fleet, light, 0.8f);
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_BRIGHT, SmartLightFleet_getBrightness(fleet, light));
+
+    // The countdown runs out in AUTO mode without switching the light off
+    SmartLightFleet_tick(fleet, 5000);
+    TEST_ASSERT_EQUAL(0, fleet->auto_remaining[light]);
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, light));
+
+    SmartLightFleet_enableMotionDetection(fleet, light, false);
+    SmartLightFleet_setMotion(fleet, light, 0.0f);
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_TRUE(fleet->last_motion[light]);
+}
+
+// Test TIMER mode lights switch themselves off after the timeout
+void test_SmartLightFleet_Timer_Mode_Auto_Off(void) {
+    size_t light = SmartLightFleet_add(fleet);
+
+    SmartLightFleet_setAutoTimeout(fleet, light, 3000);
+    SmartLightFleet_setMode(fleet, light, TIMER_MODE);
+    SmartLightFleet_turnOn(fleet, light);
+    SmartLightFleet_setAmbientLight(fleet, light, 0.0f);  // Ignored in TIMER mode
+    SmartLightFleet_setMotion(fleet, light, 1.0f);
+
+    SmartLightFleet_tick(fleet, 2999);
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, light));
+    SmartLightFleet_tick(fleet, 1);
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, light));
+    SmartLightFleet_tick(fleet, 10000);
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, light));
+
+    // Entering TIMER mode while on starts the countdown too
+    SmartLightFleet_setMode(fleet, light, MANUAL_MODE);
+    SmartLightFleet_turnOn(fleet, light);
+    TEST_ASSERT_EQUAL(0, fleet->auto_remaining[light]);
+    SmartLightFleet_setMode(fleet, light, TIMER_MODE);
+    TEST_ASSERT_EQUAL(3000, fleet->auto_remaining[light]);
+}
+
+// Test a SmartLight view drives the fleet through the usual SmartLight calls
+void test_SmartLightFleet_SmartLight_View(void) {
+    size_t index = SmartLightFleet_add(fleet);
+    SmartLight* view = SmartLight_CreateView(fleet, index);
+
+    TEST_ASSERT_NOT_NULL(view);
+    TEST_ASSERT_NULL(view->light);
+    TEST_ASSERT_EQUAL_STRING("AUTO", SmartLight_getModeString(view));
+    TEST_ASSERT_EQUAL_STRING("MEDIUM", SmartLight_getBrightnessString(view));
+
+    SmartLight_toggle(view);
+    TEST_ASSERT_TRUE(SmartLightFleet_isOn(fleet, index));
+    TEST_ASSERT_TRUE(SmartLight_isOn(view));
+
+    SmartLight_setBrightness(view, BRIGHTNESS_BRIGHT);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_BRIGHT, SmartLightFleet_getBrightness(fleet, index));
+    SmartLight_setColor(view, YELLOW);
+    SmartLight_setFlashMode(view, QUICKLY);
+    TEST_ASSERT_EQUAL(2, SmartLight_getManualOverrides(view));
+    TEST_ASSERT_EQUAL(QUICKLY, fleet->flash[index]);
+    SmartLight_resetStatistics(view);
+    TEST_ASSERT_EQUAL(0, SmartLightFleet_getManualOverrides(fleet, index));
+
+    // update reacts to the fleet's inputs; the bright room starts a fade
+    SmartLightFleet_setAmbientLight(fleet, index, 1000.0f);
+    SmartLight_update(view);
+    TEST_ASSERT_TRUE(fleet->fading[index]);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_DIM, fleet->fade_target[index]);
+    SmartLightFleet_tick(fleet, 1000);
+    TEST_ASSERT_EQUAL(BRIGHTNESS_DIM, SmartLight_getBrightness(view));
+
+    SmartLight_setMode(view, MANUAL_MODE);
+    TEST_ASSERT_EQUAL(MANUAL_MODE, SmartLight_getMode(view));
+    SmartLight_turnOff(view);
+    TEST_ASSERT_FALSE(SmartLightFleet_isOn(fleet, index));
+
+    // Destroying the view leaves the fleet slot alone
+    SmartLight_Destroy(view);
+    TEST_ASSERT_EQUAL(MANUAL_MODE, SmartLightFleet_getMode(fleet, index));
+}
+
+// Test a fleet light follows a SmartLight through the same inputs, ticks and calls
+void test_SmartLightFleet_Matches_SmartLight(void) {
+    static const SmartMode modes[] = {AUTO_MODE, TIMER_MODE, ADAPTIVE_MODE, MANUAL_MODE};
+    static const unsigned int ticks[] = {0, 20, 50, 120};
+    size_t index = SmartLightFleet_add(fleet);
+    SmartLight* view = SmartLight_CreateView(fleet, index);
+    SmartLight* light = SmartLight_Create();
+    TimerWheel* wheel = TimerWheel_Create();
+    SmartLight* both[2] = {light, view};
+    unsigned int timerOffs = 0;
+    char step_name[32];
+
+    TEST_ASSERT_NOT_NULL(light);
+    TEST_ASSERT_NOT_NULL(wheel);
+    // The SmartLight reads the inputs written below instead of sampling
+    Sensor_turnOff(light->light_sensor);
+    Sensor_turnOff(light->motion_sensor);
+    SmartLight_attachTimerWheel(light, wheel);
+    for (int l = 0; l < 2; l++) {
+        SmartLight_setFadeDuration(both[l], 0);  // SmartLight lands fades at once
+        SmartLight_setAutoTimeout(both[l], 300);
+    }
+
+    srand(7);
+    for (int step = 0; step < MATCH_STEPS; step++) {
+        float lux = (float)(rand() % 10) * 100.0f;
+        float motion = (rand() % 2) ? 0.9f : 0.1f;
+        unsigned int dt = ticks[rand() % 4];
+        int call = rand() % 12;
+        SmartMode mode = modes[rand() % 4];
+        bool wasOn = SmartLight_isOn(view);
+
+        light->light_sensor->current_value = lux;
+        light->motion_sensor->current_value = motion;
+        SmartLightFleet_setAmbientLight(fleet, index, lux);
+        SmartLightFleet_setMotion(fleet, index, motion);
+        TimerWheel_advance(wheel, dt);
+        SmartLight_update(light);
+        SmartLightFleet_tick(fleet, dt);
+        if (wasOn && !SmartLight_isOn(view) && SmartLight_getMode(view) == TIMER_MODE) {
+            timerOffs++;
+        }
+
+        for (int l = 0; l < 2; l++) {
+            switch (call) {
+                case 0: SmartLight_setMode(both[l], mode); break;
+                case 1: SmartLight_respondToMotion(both[l]); break;
+                case 2: SmartLight_adjustToAmbientLight(both[l]); break;
+                case 3: SmartLight_turnOff(both[l]); break;
+                default: break;
+            }
+        }
+
+        snprintf(step_name, sizeof(step_name), "step %d", step);
+        TEST_ASSERT_EQUAL_MESSAGE(SmartLight_getMode(light), SmartLight_getMode(view), step_name);
+        TEST_ASSERT_EQUAL_MESSAGE(SmartLight_isOn(light), SmartLight_isOn(view), step_name);
+        TEST_ASSERT_EQUAL_MESSAGE(SmartLight_getBrightness(light), SmartLight_getBrightness(view), step_name);
+        TEST_ASSERT_EQUAL_MESSAGE(Light_getColor(light->light), SmartLightFleet_getColor(fleet, index), step_name);
+    }
+    // Lights turned on by motion or darkness in TIMER mode must go off again
+    TEST_ASSERT_TRUE(timerOffs > 0);
+
+    SmartLight_Destroy(light);
+    SmartLight_Destroy(view);
+    TimerWheel_Destroy(wheel);
+}
+
+// Random configuration and inputs, identical in both fleets
+static void randomise(SmartLightFleet* a, SmartLightFleet* b, unsigned int seed) {
+    srand(seed);
+    for (size_t i = 0; i < RANDOM_FLEET; i++) {
+        SmartLightFleet_add(a);
+        SmartLightFleet_add(b);
+        SmartMode mode = (SmartMode)(rand() % 4);
+        unsigned int fade = (unsigned int)(rand() % 3) * 500u;
+        unsigned int timeout = 100u + (unsigned int)(rand() % 2000);
+        bool saving = rand() % 2;
+        SmartLightFleet* both[2] = {a, b};
+        for (int f = 0; f < 2; f++) {
+            SmartLightFleet_setMode(both[f], i, mode);
+            SmartLightFleet_setFadeDuration(both[f], i, fade);
+            SmartLightFleet_setAutoTimeout(both[f], i, timeout);
+            SmartLightFleet_enableEnergySaving(both[f], i, saving);
+        }
+    }
+}
+
+static void randomInputs(SmartLightFleet* a, SmartLightFleet* b) {
+    for (size_t i = 0; i < RANDOM_FLEET; i++) {
+        if (rand() % 8 == 0) {
+            a->ambient_lux[i] = b->ambient_lux[i] = (float)(rand() % 1000);
+        }
+        if (rand() % 8 == 0) {
+            a->motion_level[i] = b->motion_level[i] = (float)(rand() % 100) / 100.0f;
+        }
+    }
+}
+
+#define ASSERT_SAME_ARRAY(field)                                                              \
+    TEST_ASSERT_EQUAL_MEMORY(a->field, b->field, RANDOM_FLEET * sizeof(*a->field))
+
+// Test per-light steps, one-thread ticks and worker ticks all agree
+void test_SmartLightFleet_Workers_Match_Per_Light_Updates(void) {
+    SmartLightFleet* a = SmartLightFleet_Create(RANDOM_FLEET);
+    SmartLightFleet* b = SmartLightFleet_Create(RANDOM_FLEET);
+
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    randomise(a, b, 42);
+    TEST_ASSERT_EQUAL(4, SmartLightFleet_setWorkers(b, 4));
+
+    for (int t = 0; t < RANDOM_TICKS; t++) {
+        unsigned int dt = 1u + (unsigned int)(rand() % 50);
+        randomInputs(a, b);
+        for (size_t i = 0; i < RANDOM_FLEET; i++) {
+            SmartLightFleet_updateRange(a, i, i + 1, dt);
+        }
+        SmartLightFleet_tick(b, dt);
+        if (t == RANDOM_TICKS / 2) {
+            TEST_ASSERT_EQUAL(3, SmartLightFleet_setWorkers(b, 3));
+        }
+    }
+
+    // The inputs must have exercised the logic, not left every light idle
+    size_t on = 0, changed = 0;
+    for (size_t i = 0; i < RANDOM_FLEET; i++) {
+        on += a->is_on[i];
+        changed += (a->brightness[i] != BRIGHTNESS_MEDIUM);
+    }
+    TEST_ASSERT_TRUE(on > RANDOM_FLEET / 10 && on < RANDOM_FLEET);
+    TEST_ASSERT_TRUE(changed > RANDOM_FLEET / 10);
+
+    ASSERT_SAME_ARRAY(is_on);
+    ASSERT_SAME_ARRAY(color);
+    ASSERT_SAME_ARRAY(brightness);
+    ASSERT_SAME_ARRAY(last_light_level);
+    ASSERT_SAME_ARRAY(last_motion);
+    ASSERT_SAME_ARRAY(auto_remaining);
+    ASSERT_SAME_ARRAY(fade_elapsed);
+    ASSERT_SAME_ARRAY(fading);
+
+    SmartLightFleet_Destroy(a);
+    SmartLightFleet_Destroy(b);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SmartLightFleet_Add_Uses_SmartLight_Defaults);
+    RUN_TEST(test_SmartLightFleet_Arrays_Are_Aligned);
+    RUN_TEST(test_SmartLightFleet_Dark_Ambient_Turns_Lights_On);
+    RUN_TEST(test_SmartLightFleet_Bright_Ambient_Fades_To_Dim);
+    RUN_TEST(test_SmartLightFleet_Motion_Edges);
+    RUN_TEST(test_SmartLightFleet_Timer_Mode_Auto_Off);
+    RUN_TEST(test_SmartLightFleet_SmartLight_View);
+    RUN_TEST(test_SmartLightFleet_Matches_SmartLight);
+    RUN_TEST(test_SmartLightFleet_Workers_Match_Per_Light_Updates);
+    return UNITY_END();
+}
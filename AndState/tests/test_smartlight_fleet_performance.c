@@ -0,0 +1,101 @@
+//
+// SmartLightFleet Performance - Lights updated per millisecond
+// Per-light calls walk the fleet one light at a time, the way N separate
+// SmartLights would be updated; batch ticks run the vectorized passes over
+// the whole fleet, on one thread and split across workers.
+//
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "unity.h"
+#include "SmartLightFleet.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TICK_MS 10u
+#define LIGHT_TICKS 4000000u  // lights x ticks per measurement
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+static SmartLightFleet* makeFleet(size_t lights) {
+    SmartLightFleet* fleet = SmartLightFleet_Create(lights);
+
+    TEST_ASSERT_NOT_NULL(fleet);
+    srand(7);
+    for (size_t i = 0; i < lights; i++) {
+        SmartLightFleet_add(fleet);
+        SmartLightFleet_setMode(fleet, i, (SmartMode)(rand() % 4));
+        SmartLightFleet_setAutoTimeout(fleet, i, 500u + (unsigned int)(rand() % 5000));
+    }
+    return fleet;
+}
+
+// A fresh set of readings for every light; not timed
+static void newReadings(SmartLightFleet* fleet) {
+    float* ambient = SmartLightFleet_ambientInputs(fleet);
+    float* motion = SmartLightFleet_motionInputs(fleet);
+
+    for (size_t i = 0; i < SmartLightFleet_getCount(fleet); i++) {
+        ambient[i] = (float)(rand() % 1000);
+        motion[i] = (float)(rand() % 100) / 100.0f;
+    }
+}
+
+// Returns lights updated per millisecond
+static double measure(size_t lights, unsigned int workers, bool perLight) {
+    SmartLightFleet* fleet = makeFleet(lights);
+    unsigned int ticks = (unsigned int)(LIGHT_TICKS / lights);
+    double elapsed = 0.0;
+
+    SmartLightFleet_setWorkers(fleet, workers);
+    for (unsigned int t = 0; t < ticks; t++) {
+        if (t % 20 == 0) {
+            newReadings(fleet);
+        }
+        double start = nowMs();
+        if (perLight) {
+            for (size_t i = 0; i < lights; i++) {
+                SmartLightFleet_updateRange(fleet, i, i + 1, TICK_MS);
+            }
+        } else {
+            SmartLightFleet_tick(fleet, TICK_MS);
+        }
+        elapsed += nowMs() - start;
+    }
+    SmartLightFleet_Destroy(fleet);
+    return (double)lights * ticks / elapsed;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_SmartLightFleet_Lights_Per_Millisecond(void) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+
+    printf("\n  %ld online CPUs; lights updated per ms\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  %8s %12s %12s %12s %12s\n", "lights", "per-light", "batch", "2 workers", "4 workers");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        double single = measure(sizes[i], 1, true);
+        double batch = measure(sizes[i], 1, false);
+        double two = measure(sizes[i], 2, false);
+        double four = measure(sizes[i], 4, false);
+
+        printf("  %8lu %12.0f %12.0f %12.0f %12.0f\n", (unsigned long)sizes[i], single, batch, two, four);
+        TEST_ASSERT_TRUE(batch > single);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SmartLightFleet_Lights_Per_Millisecond);
+    return UNITY_END();
+}
@@ -0,0 +1,338 @@
+//
+// TimerWheel Tests - Scheduled callbacks instead of polled timers
+// Time is simulated with TimerWheel_advance, so every expiry is exact
+//
+
+#include "unity.h"
+#include "TimerWheel.h"
+#include "Timer.h"
+#include "SmartLight.h"
+
+#define MANY_TIMERS 5000
+
+static TimerWheel* wheel;
+
+typedef struct {
+    TimerWheelEntry entry;
+    uint64_t fired_at;
+    unsigned int fired;
+} Probe;
+
+static void onProbe(void* context) {
+    Probe* probe = (Probe*)context;
+    probe->fired_at = TimerWheel_now(wheel);
+    probe->fired++;
+}
+
+static void probeInit(Probe* probe) {
+    TimerWheelEntry_Init(&probe->entry, onProbe, probe);
+    probe->fired_at = 0;
+    probe->fired = 0;
+}
+
+void setUp(void) {
+    wheel = TimerWheel_Create();
+}
+
+void tearDown(void) {
+    TimerWheel_Destroy(wheel);
+    wheel = NULL;
+}
+
+// Test every level of the wheel fires on the exact tick
+void test_TimerWheel_Fires_On_Exact_Tick_At_Every_Level(void) {
+    static const unsigned int delays[] = {1, 2, 255, 256, 257, 1000, 65535, 65536, 65537,
+                                          70000, 16777216 + 7, 300000000};
+    enum { COUNT = sizeof(delays) / sizeof(delays[0]) };
+    Probe probes[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        probeInit(&probes[i]);
+        TimerWheel_schedule(wheel, &probes[i].entry, delays[i]);
+    }
+    TEST_ASSERT_EQUAL(COUNT, TimerWheel_getPending(wheel));
+
+    // One tick short of each deadline nothing fires; on it exactly one does
+    for (int i = 0; i < COUNT; i++) {
+        TimerWheel_advance(wheel, (unsigned int)(delays[i] - 1 - TimerWheel_now(wheel)));
+        TEST_ASSERT_EQUAL(0, probes[i].fired);
+        TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+        TEST_ASSERT_EQUAL(1, probes[i].fired);
+        TEST_ASSERT_EQUAL(delays[i], probes[i].fired_at);
+    }
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+}
+
+// Test deadlines across the 2^32 tick boundary use the top level
+void test_TimerWheel_Crosses_32_Bit_Tick_Boundary(void) {
+    Probe near;
+    Probe far;
+    probeInit(&near);
+    probeInit(&far);
+
+    TimerWheel_advance(wheel, 0xFFFFFFF0u);  // Empty wheel: one jump
+    TimerWheel_schedule(wheel, &near.entry, 100);
+    TimerWheel_schedule(wheel, &far.entry, 0xFFFFFFFFu);
+    TEST_ASSERT_EQUAL(4, near.entry.level);
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 100));
+    TEST_ASSERT_EQUAL(0xFFFFFFF0ull + 100u, near.fired_at);
+    TimerWheel_advance(wheel, 0xFFFFFFFFu - 101u);
+    TEST_ASSERT_EQUAL(0, far.fired);
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+    TEST_ASSERT_EQUAL(0xFFFFFFF0ull + 0xFFFFFFFFull, far.fired_at);
+}
+
+// Test deadlines across the 2^40 tick boundary get a level of their own
+void test_TimerWheel_Crosses_40_Bit_Tick_Boundary(void) {
+    const uint64_t boundary = (uint64_t)1 << 40;
+    Probe before;
+    Probe across;
+    Probe far;
+    probeInit(&before);
+    probeInit(&across);
+    probeInit(&far);
+
+    for (int i = 0; i < 256; i++) {
+        TimerWheel_advance(wheel, 0xFFFFFFFFu);  // Empty wheel: one jump each
+    }
+    TimerWheel_advance(wheel, (unsigned int)(boundary - 16u - TimerWheel_now(wheel)));
+    TEST_ASSERT_EQUAL_UINT64(boundary - 16u, TimerWheel_now(wheel));
+
+    TimerWheel_schedule(wheel, &before.entry, 10);
+    TimerWheel_schedule(wheel, &across.entry, 0x100000);
+    TimerWheel_schedule(wheel, &far.entry, 0xFFFFFFFFu);
+    TEST_ASSERT_EQUAL(5, across.entry.level);
+    TEST_ASSERT_EQUAL(5, far.entry.level);
+
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 10));
+    TEST_ASSERT_EQUAL_UINT64(boundary - 6u, before.fired_at);
+    TimerWheel_advance(wheel, 0x100000 - 11u);
+    TEST_ASSERT_EQUAL(0, across.fired);
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+    TEST_ASSERT_EQUAL_UINT64(boundary - 16u + 0x100000, across.fired_at);
+
+    TimerWheel_advance(wheel, 0xFFFFFFFFu - 0x100000 - 1u);
+    TEST_ASSERT_EQUAL(0, far.fired);
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+    TEST_ASSERT_EQUAL_UINT64(boundary - 16u + 0xFFFFFFFFu, far.fired_at);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+}
+
+// Test a long jump fires everything in deadline order
+void test_TimerWheel_Long_Jump_Fires_In_Order(void) {
+    static Probe probes[MANY_TIMERS];
+    unsigned int state = 1;
+
+    for (int i = 0; i < MANY_TIMERS; i++) {
+        state = state * 1103515245u + 12345u;
+        probeInit(&probes[i]);
+        TimerWheel_schedule(wheel, &probes[i].entry, 1 + (state >> 8) % 200000u);
+    }
+    TEST_ASSERT_EQUAL(MANY_TIMERS, TimerWheel_advance(wheel, 200000));
+    for (int i = 0; i < MANY_TIMERS; i++) {
+        TEST_ASSERT_EQUAL(1, probes[i].fired);
+        TEST_ASSERT_EQUAL(probes[i].entry.expires, probes[i].fired_at);
+    }
+}
+
+// Test stop and restart are O(1) moves, never duplicates
+void test_TimerWheel_Cancel_And_Reschedule(void) {
+    Probe a;
+    Probe b;
+    probeInit(&a);
+    probeInit(&b);
+
+    TimerWheel_schedule(wheel, &a.entry, 10);
+    TimerWheel_schedule(wheel, &b.entry, 10);
+    TimerWheel_cancel(wheel, &a.entry);
+    TimerWheel_cancel(wheel, &a.entry);  // Cancelling twice is harmless
+    TEST_ASSERT_FALSE(TimerWheelEntry_isPending(&a.entry));
+    TEST_ASSERT_EQUAL(1, TimerWheel_getPending(wheel));
+
+    TimerWheel_schedule(wheel, &b.entry, 500);  // Moves b, does not add it twice
+    TEST_ASSERT_EQUAL(1, TimerWheel_getPending(wheel));
+    TEST_ASSERT_EQUAL(0, TimerWheel_advance(wheel, 499));
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+    TEST_ASSERT_EQUAL(0, a.fired);
+    TEST_ASSERT_EQUAL(500, b.fired_at);
+
+    // A deadline already passed fires on the next tick
+    TimerWheel_scheduleAt(wheel, &a.entry, 3);
+    TEST_ASSERT_EQUAL(1, TimerWheel_advance(wheel, 1));
+    TEST_ASSERT_EQUAL(501, a.fired_at);
+}
+
+// Callback that restarts its own entry and cancels a peer in the same slot
+static Probe peer;
+static void onRestart(void* context) {
+    Probe* probe = (Probe*)context;
+    probe->fired++;
+    TimerWheel_cancel(wheel, &peer.entry);
+    if (probe->fired < 3) {
+        TimerWheel_schedule(wheel, &probe->entry, 100);
+    }
+}
+
+void test_TimerWheel_Callbacks_May_Reschedule_And_Cancel(void) {
+    Probe self;
+    TimerWheelEntry_Init(&self.entry, onRestart, &self);
+    self.fired = 0;
+    probeInit(&peer);
+
+    TimerWheel_schedule(wheel, &self.entry, 100);
+    TimerWheel_schedule(wheel, &peer.entry, 100);
+    TEST_ASSERT_EQUAL(3, TimerWheel_advance(wheel, 1000));
+    TEST_ASSERT_EQUAL(3, self.fired);
+    TEST_ASSERT_EQUAL(0, peer.fired);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+}
+
+// Test Timer modes become scheduled callbacks
+static unsigned int notified;
+static void onTimer(Timer* timer, void* context) {
+    (void)timer;
+    (void)context;
+    notified++;
+}
+
+void test_Timer_Oneshot_On_Wheel(void) {
+    Timer* timer = Timer_Create(250, ONESHOT);
+    notified = 0;
+    Timer_attach(timer, wheel);
+    Timer_setCallback(timer, onTimer, NULL);
+    Timer_start(timer);
+
+    TimerWheel_advance(wheel, 249);
+    TEST_ASSERT_EQUAL(TIMER_RUNNING, timer->state);
+    TEST_ASSERT_EQUAL(1, Timer_getRemainingTime(timer));
+    TimerWheel_advance(wheel, 1);
+    TEST_ASSERT_EQUAL(TIMER_EXPIRED, timer->state);
+    TEST_ASSERT_EQUAL(1, notified);
+    TimerWheel_advance(wheel, 1000);
+    TEST_ASSERT_EQUAL(1, notified);
+    Timer_Destroy(timer);
+}
+
+void test_Timer_Repeating_On_Wheel_Keeps_Phase_And_Limit(void) {
+    Timer* timer = Timer_Create(100, REPEATING);
+    notified = 0;
+    Timer_attach(timer, wheel);
+    Timer_setCallback(timer, onTimer, NULL);
+    Timer_setRepeatCount(timer, 5);
+    Timer_start(timer);
+
+    TimerWheel_advance(wheel, 350);
+    TEST_ASSERT_EQUAL(3, notified);
+    TEST_ASSERT_EQUAL(300, timer->start_ms);  // Periods start at 0, 100, 200, 300
+    TEST_ASSERT_EQUAL(50, Timer_getElapsedTime(timer));
+    TimerWheel_advance(wheel, 10000);
+    TEST_ASSERT_EQUAL(5, notified);
+    TEST_ASSERT_EQUAL(TIMER_EXPIRED, timer->state);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+    Timer_Destroy(timer);
+}
+
+void test_Timer_Countdown_Auto_Reset_On_Wheel(void) {
+    Timer* timer = Timer_Create(40, COUNTDOWN);
+    notified = 0;
+    Timer_attach(timer, wheel);
+    Timer_setCallback(timer, onTimer, NULL);
+    Timer_setAutoReset(timer, true);
+    Timer_start(timer);
+
+    TimerWheel_advance(wheel, 120);
+    TEST_ASSERT_EQUAL(3, notified);
+    TEST_ASSERT_EQUAL(TIMER_RUNNING, timer->state);
+
+    Timer_setAutoReset(timer, false);
+    TimerWheel_advance(wheel, 40);
+    TEST_ASSERT_EQUAL(4, notified);
+    TEST_ASSERT_EQUAL(TIMER_EXPIRED, timer->state);
+    Timer_Destroy(timer);
+}
+
+void test_Timer_Pause_Stop_And_Duration_On_Wheel(void) {
+    Timer* timer = Timer_Create(100, ONESHOT);
+    notified = 0;
+    Timer_attach(timer, wheel);
+    Timer_setCallback(timer, onTimer, NULL);
+
+    Timer_start(timer);
+    TimerWheel_advance(wheel, 60);
+    Timer_pause(timer);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+    TimerWheel_advance(wheel, 500);  // Paused time does not count
+    Timer_resume(timer);
+    TimerWheel_advance(wheel, 39);
+    TEST_ASSERT_EQUAL(0, notified);
+    TimerWheel_advance(wheel, 1);
+    TEST_ASSERT_EQUAL(1, notified);
+
+    Timer_start(timer);
+    Timer_setDuration(timer, 20);  // Same start, earlier end
+    TimerWheel_advance(wheel, 20);
+    TEST_ASSERT_EQUAL(2, notified);
+
+    Timer_start(timer);
+    Timer_stop(timer);
+    TimerWheel_advance(wheel, 1000);
+    TEST_ASSERT_EQUAL(2, notified);
+
+    // Destroying a running timer takes it out of the wheel
+    Timer_start(timer);
+    Timer_Destroy(timer);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+}
+
+// Test SmartLight auto-off comes from the wheel, not from update()
+void test_SmartLight_Auto_Off_On_Wheel(void) {
+    SmartLight* smart = SmartLight_Create();
+    SmartLight_attachTimerWheel(smart, wheel);
+    SmartLight_setMode(smart, TIMER_MODE);
+    SmartLight_setAutoTimeout(smart, 1000);
+    SmartLight_turnOn(smart);
+    TEST_ASSERT_TRUE(SmartLight_isOn(smart));
+
+    TimerWheel_advance(wheel, 999);
+    TEST_ASSERT_TRUE(SmartLight_isOn(smart));
+    TimerWheel_advance(wheel, 1);
+    TEST_ASSERT_FALSE(SmartLight_isOn(smart));
+    SmartLight_Destroy(smart);
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+}
+
+// Test the wheel follows CLOCK_MONOTONIC when polled
+void test_TimerWheel_Poll_Tracks_Monotonic_Clock(void) {
+    Probe probe;
+    uint64_t start = TimerWheel_monotonicMs();
+    probeInit(&probe);
+
+    TimerWheel_schedule(wheel, &probe.entry, 20);
+    while (probe.fired == 0 && TimerWheel_monotonicMs() - start < 1000) {
+        TimerWheel_poll(wheel);
+    }
+    TEST_ASSERT_EQUAL(1, probe.fired);
+    TEST_ASSERT_TRUE(TimerWheel_monotonicMs() - start >= 19);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Wheel mechanics
+    RUN_TEST(test_TimerWheel_Fires_On_Exact_Tick_At_Every_Level);
+    RUN_TEST(test_TimerWheel_Crosses_32_Bit_Tick_Boundary);
+    RUN_TEST(test_TimerWheel_Crosses_40_Bit_Tick_Boundary);
+    RUN_TEST(test_TimerWheel_Long_Jump_Fires_In_Order);
+    RUN_TEST(test_TimerWheel_Cancel_And_Reschedule);
+    RUN_TEST(test_TimerWheel_Callbacks_May_Reschedule_And_Cancel);
+    RUN_TEST(test_TimerWheel_Poll_Tracks_Monotonic_Clock);
+
+    // Timers registered with the wheel
+    RUN_TEST(test_Timer_Oneshot_On_Wheel);
+    RUN_TEST(test_Timer_Repeating_On_Wheel_Keeps_Phase_And_Limit);
+    RUN_TEST(test_Timer_Countdown_Auto_Reset_On_Wheel);
+    RUN_TEST(test_Timer_Pause_Stop_And_Duration_On_Wheel);
+    RUN_TEST(test_SmartLight_Auto_Off_On_Wheel);
+
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+//
+// TimerWheel Performance - 100k concurrent timers
+// Compares the wheel with polling every timer on every tick, which is
+// what calling Timer_update on each timer amounts to
+//
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "unity.h"
+#include "TimerWheel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TIMERS 100000
+#define MAX_DELAY_MS 60000u     // Deadlines spread over a minute
+#define WHEEL_TICKS 60000u      // Simulated milliseconds for the wheel
+#define POLLED_TICKS 1000u      // The polled baseline is too slow for a minute
+
+typedef struct {
+    TimerWheelEntry entry;
+    unsigned int period;
+} BenchTimer;
+
+static TimerWheel* wheel;
+static BenchTimer* timers;
+static unsigned int seed = 12345u;
+
+static unsigned int nextDelay(void) {
+    seed = seed * 1103515245u + 12345u;
+    return 1u + (seed >> 8) % MAX_DELAY_MS;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Repeating: every expiry files the next period, so 100k stay pending
+static void onExpire(void* context) {
+    BenchTimer* timer = (BenchTimer*)context;
+    TimerWheel_schedule(wheel, &timer->entry, timer->period);
+}
+
+void setUp(void) {
+    wheel = TimerWheel_Create();
+    timers = (BenchTimer*)malloc(TIMERS * sizeof(BenchTimer));
+    TEST_ASSERT_NOT_NULL(wheel);
+    TEST_ASSERT_NOT_NULL(timers);
+}
+
+void tearDown(void) {
+    TimerWheel_Destroy(wheel);
+    free(timers);
+}
+
+void test_TimerWheel_100k_Concurrent_Timers(void) {
+    double start;
+    double startNs;
+    double tickNs;
+    double stopNs;
+    double polledTickNs;
+    unsigned long fired = 0;
+    unsigned long polledFired = 0;
+    uint64_t* deadlines = (uint64_t*)malloc(TIMERS * sizeof(uint64_t));
+    TEST_ASSERT_NOT_NULL(deadlines);
+
+    // Start
+    start = nowSeconds();
+    for (int i = 0; i < TIMERS; i++) {
+        TimerWheelEntry_Init(&timers[i].entry, onExpire, &timers[i]);
+        timers[i].period = nextDelay();
+        TimerWheel_schedule(wheel, &timers[i].entry, timers[i].period);
+    }
+    startNs = (nowSeconds() - start) * 1e9 / TIMERS;
+    TEST_ASSERT_EQUAL(TIMERS, TimerWheel_getPending(wheel));
+
+    // Expire: one tick at a time, as a 1 ms system tick would drive it
+    start = nowSeconds();
+    for (unsigned int t = 0; t < WHEEL_TICKS; t++) {
+        fired += TimerWheel_advance(wheel, 1);
+    }
+    tickNs = (nowSeconds() - start) * 1e9 / WHEEL_TICKS;
+    TEST_ASSERT_EQUAL(TIMERS, TimerWheel_getPending(wheel));
+    TEST_ASSERT_TRUE(fired >= TIMERS);  // Every timer fired at least once in the minute
+
+    // Stop
+    start = nowSeconds();
+    for (int i = 0; i < TIMERS; i++) {
+        TimerWheel_cancel(wheel, &timers[i].entry);
+    }
+    stopNs = (nowSeconds() - start) * 1e9 / TIMERS;
+    TEST_ASSERT_EQUAL(0, TimerWheel_getPending(wheel));
+
+    // Polled baseline: every timer checked every tick, same deadlines
+    seed = 12345u;
+    for (int i = 0; i < TIMERS; i++) {
+        timers[i].period = nextDelay();
+        deadlines[i] = timers[i].period;
+    }
+    start = nowSeconds();
+    for (uint64_t t = 1; t <= POLLED_TICKS; t++) {
+        for (int i = 0; i < TIMERS; i++) {
+            if (deadlines[i] <= t) {
+                deadlines[i] += timers[i].period;
+                polledFired++;
+            }
+        }
+    }
+    polledTickNs = (nowSeconds() - start) * 1e9 / POLLED_TICKS;
+    TEST_ASSERT_TRUE(polledFired > 0);
+
+    printf("\n  %d concurrent timers, deadlines 1..%u ms\n", TIMERS, MAX_DELAY_MS);
+    printf("  %-28s %12.1f ns\n", "wheel start (per timer)", startNs);
+    printf("  %-28s %12.1f ns\n", "wheel stop (per timer)", stopNs);
+    printf("  %-28s %12.1f ns  (%lu expiries over %u ticks)\n", "wheel tick incl. expiries", tickNs, fired,
+           WHEEL_TICKS);
+    printf("  %-28s %12.1f ns  (%.0fx the wheel)\n", "polled tick (scan all)", polledTickNs, polledTickNs / tickNs);
+    free(deadlines);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_TimerWheel_100k_Concurrent_Timers);
+    return UNITY_END();
+}
@@ -24,7 +24,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include "../src/Multireceptor/MultiReceptor.h"
 #include "../src/mutex/Mutex.h"
 
@@ -126,46 +125,44 @@ int main(int argc, char* argv[]) {
  * @param tokenizer Pointer to initialized TokenizerMultiReceptor instance
  * @param input String containing numbers to be parsed
  * 
- * This function takes an input string and processes each character through
- * the finite state machine tokenizer. It handles:
+ * This function hands the whole input string to the tokenizer's bulk
+ * feed API, which takes the mutex once for the entire buffer. It handles:
  * - Digit characters (0-9): Processed as numeric input
  * - Decimal points (.): Transition to fractional processing
  * - Whitespace: Acts as number separator
  * - Other characters: Ignored
  */
 void processString(TokenizerMultiReceptor* tokenizer, const char* input) {
+    double numbers[64];
+    double last;
+
     if (tokenizer == NULL || input == NULL) {
         return;
     }
     
     // Reset tokenizer state for new input processing
+    Mutex* mutex = TokenizerMultiReceptor_getItsMutex(tokenizer);
     TokenizerMultiReceptor_Init(tokenizer);
     
     // Re-associate the mutex (since Init clears all associations)
-    Mutex* mutex = TokenizerMultiReceptor_getItsMutex(tokenizer);
     TokenizerMultiReceptor_setItsMutex(tokenizer, mutex);
     
-    printf("Processing characters: ");
-    
-    // Process each character in the input string
-    for (size_t i = 0; input[i] != '\0'; i++) {
-        char c = input[i];
-        printf("'%c' ", c);
-        
-        // Dispatch character to appropriate event handler
-        if (isdigit(c)) {
-            TokenizerMultiReceptor_evDigit(tokenizer, c);
-        } else if (c == '.') {
-            TokenizerMultiReceptor_evDot(tokenizer);
-        } else if (isspace(c)) {
-            TokenizerMultiReceptor_evWhiteSpace(tokenizer);
-        }
-        // Other characters are ignored (could be extended for error handling)
+    // Parse the whole string in one call
+    size_t count = TokenizerMultiReceptor_feed(tokenizer, input, strlen(input),
+                                               numbers, sizeof(numbers) / sizeof(numbers[0]));
+    if (count > sizeof(numbers) / sizeof(numbers[0])) {
+        printf("(only the first %zu of %zu numbers are shown)\n",
+               sizeof(numbers) / sizeof(numbers[0]), count);
+        count = sizeof(numbers) / sizeof(numbers[0]);
+    }
+    for (size_t i = 0; i < count; i++) {
+        printf("Number: %g\n", numbers[i]);
     }
     
     // Signal end of string to finalize any pending number
-    printf("\nProcessing end of string...\n");
-    TokenizerMultiReceptor_evEndOfString(tokenizer);
+    if (TokenizerMultiReceptor_flush(tokenizer, &last)) {
+        printf("Number: %g\n", last);
+    }
     printf("---\n");
 }
 
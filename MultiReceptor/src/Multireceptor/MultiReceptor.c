@@ -9,11 +9,28 @@
 
 #include "MultiReceptor.h"
 #include "../mutex/Mutex.h"
+#include "NumberScanner.h"
 #include <stdlib.h>
 
+/*
+ * Per-character tracing is compiled in only when MULTIRECEPTOR_TRACE is
+ * defined (see the ENABLE_TOKENIZER_TRACE CMake option). With tracing off
+ * the state machine does no stdio work at all.
+ */
+#ifdef MULTIRECEPTOR_TRACE
+#define TOKENIZER_TRACE(...) printf(__VA_ARGS__)
+#else
+#define TOKENIZER_TRACE(...) ((void)0)
+#endif
+
 // Forward declaration for internal cleanup function
 static void cleanUpRelations(TokenizerMultiReceptor* const me);
 
+// Forward declarations for the unlocked state machine steps
+static void processDigit(TokenizerMultiReceptor* const me, char c);
+static void processDot(TokenizerMultiReceptor* const me);
+static int completeNumber(TokenizerMultiReceptor* const me, double* value);
+
 /**
  * @brief Converts a character digit to its numeric value
  * @param c Character representing a digit ('0'-'9')
@@ -49,53 +66,7 @@ void TokenizerMultiReceptor_Cleanup(TokenizerMultiReceptor* const me) {
 void TokenizerMultiReceptor_evDigit(TokenizerMultiReceptor* const me, char c) {
     // Acquire mutex lock for thread safety
     Mutex_lock(me->itsMutex);
-    
-    switch (me->stateID) {
-        case NONUMBER_STATE:
-            /* Transition from no number to processing a number */
-            TokenizerMultiReceptor_exit_NoNumber(me);
-            me->ch = c;  // Store the current character
-            TokenizerMultiReceptor_enter_GotNumber(me);
-            me->stateID = GOTNUMBER_STATE;
-            TokenizerMultiReceptor_enter_ProcessingWholePart(me);
-            me->subStateID = PROCESSINGWHOLEPART_SSTATE;
-            printf("Current value of result: %g\n", me->result);
-            break;
-            
-        case GOTNUMBER_STATE:
-            switch (me->subStateID) {
-                case PROCESSINGWHOLEPART_SSTATE:
-                    /* Continue processing whole number part */
-                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
-                    me->ch = c;
-                    TokenizerMultiReceptor_enter_ProcessingWholePart(me);
-                    printf("Current value of result: %g\n", me->result);
-                    break;
-                    
-                case PROCESSINGFRACTIONALPART_SSTATE:
-                    /* Process fractional digits after decimal point */
-                    TokenizerMultiReceptor_exit_ProcessingFractionalPart(me);
-                    me->ch = c;
-                    // Add fractional digit to result using current decimal place
-                    me->result += digit(me->ch) / me->tensPlace;
-                    me->tensPlace *= 10.0;  // Move to next decimal place
-                    TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
-                    printf("Current value of result: %g\n", me->result);
-                    break;
-                    
-                case NULL_SSTATE:
-                default:
-                    /* Invalid substate - ignore the digit */
-                    break;
-            };
-            break;
-            
-        case NULL_STATE:
-        default:
-            /* Invalid state - ignore the digit */
-            break;
-    };
-    
+    processDigit(me, c);
     // Release mutex lock
     Mutex_release(me->itsMutex);
 }
@@ -115,41 +86,7 @@ void TokenizerMultiReceptor_evDigit(TokenizerMultiReceptor* const me, char c) {
 void TokenizerMultiReceptor_evDot(TokenizerMultiReceptor* const me) {
     // Acquire mutex lock for thread safety
     Mutex_lock(me->itsMutex);
-    me->ch = '.';  // Store the decimal point character
-    
-    switch (me->stateID) {
-        case NONUMBER_STATE:
-            /* Start processing a fractional number (e.g., ".5") */
-            TokenizerMultiReceptor_exit_NoNumber(me);
-            TokenizerMultiReceptor_enter_GotNumber(me);
-            me->stateID = GOTNUMBER_STATE;
-            TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
-            me->subStateID = PROCESSINGFRACTIONALPART_SSTATE;
-            break;
-            
-        case GOTNUMBER_STATE:
-            switch (me->subStateID) {
-                case PROCESSINGWHOLEPART_SSTATE:
-                    /* Transition from whole part to fractional part */
-                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
-                    TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
-                    me->subStateID = PROCESSINGFRACTIONALPART_SSTATE;
-                    break;
-                    
-                case PROCESSINGFRACTIONALPART_SSTATE:
-                case NULL_SSTATE:
-                default:
-                    /* Already processing fractional part or invalid state - ignore */
-                    break;
-            };
-            break;
-            
-        case NULL_STATE:
-        default:
-            /* Invalid state - ignore the decimal point */
-            break;
-    };
-    
+    processDot(me);
     // Release mutex lock
     Mutex_release(me->itsMutex);
 }
@@ -159,50 +96,18 @@ void TokenizerMultiReceptor_evDot(TokenizerMultiReceptor* const me) {
  * @param me Pointer to the TokenizerMultiReceptor instance
  * 
  * This function is called when the end of input string is reached.
- * It finalizes the current number being processed and outputs the result.
+ * It finalizes the current number being processed (printed when tracing is enabled).
  * Thread-safe through mutex locking.
  * 
  * State transitions:
  * - GOTNUMBER_STATE -> NONUMBER_STATE (resets for next number)
  */
 void TokenizerMultiReceptor_evEndOfString(TokenizerMultiReceptor* const me) {
+    double value;
+
     // Acquire mutex lock for thread safety
     Mutex_lock(me->itsMutex);
-    
-    switch (me->stateID) {
-        case GOTNUMBER_STATE:
-            /* Finalize the current number being processed */
-            switch (me->subStateID) {
-                case PROCESSINGWHOLEPART_SSTATE:
-                    /* Exit from whole part processing */
-                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
-                    break;
-                    
-                case PROCESSINGFRACTIONALPART_SSTATE:
-                    /* Exit from fractional part processing */
-                    TokenizerMultiReceptor_exit_ProcessingFractionalPart(me);
-                    break;
-                    
-                case NULL_SSTATE:
-                default:
-                    /* Invalid substate - ignore */
-                    break;
-            };
-            
-            /* Complete number processing and output result */
-            TokenizerMultiReceptor_exit_GotNumber(me);
-            printf("Number: %g\n", me->result);
-            TokenizerMultiReceptor_enter_NoNumber(me);
-            me->stateID = NONUMBER_STATE;
-            break;
-            
-        case NONUMBER_STATE:
-        case NULL_STATE:
-        default:
-            /* No number being processed or invalid state - nothing to do */
-            break;
-    };
-    
+    (void)completeNumber(me, &value);
     // Release mutex lock
     Mutex_release(me->itsMutex);
 }
@@ -220,45 +125,149 @@ void TokenizerMultiReceptor_evEndOfString(TokenizerMultiReceptor* const me) {
  * - GOTNUMBER_STATE -> NONUMBER_STATE (completes current number)
  */
 void TokenizerMultiReceptor_evWhiteSpace(TokenizerMultiReceptor* const me) {
+    double value;
+
     // Acquire mutex lock for thread safety
     Mutex_lock(me->itsMutex);
-    
-    switch (me->stateID) {
-        case GOTNUMBER_STATE:
-            /* Complete the current number when whitespace is encountered */
-            switch (me->subStateID) {
-                case PROCESSINGWHOLEPART_SSTATE:
-                    /* Exit from whole part processing */
-                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
-                    break;
-                    
-                case PROCESSINGFRACTIONALPART_SSTATE:
-                    /* Exit from fractional part processing */
-                    TokenizerMultiReceptor_exit_ProcessingFractionalPart(me);
-                    break;
-                    
-                case NULL_SSTATE:
-                default:
-                    /* Invalid substate - ignore */
-                    break;
-            };
-            
-            /* Complete number processing and output result */
-            TokenizerMultiReceptor_exit_GotNumber(me);
-            printf("Number: %g\n", me->result);
-            TokenizerMultiReceptor_enter_NoNumber(me);
-            me->stateID = NONUMBER_STATE;
-            break;
-            
-        case NONUMBER_STATE:
-        case NULL_STATE:
-        default:
-            /* No number being processed or invalid state - whitespace is ignored */
-            break;
-    };
-    
+    (void)completeNumber(me, &value);
+    // Release mutex lock
+    Mutex_release(me->itsMutex);
+}
+
+/*
+ * ============================================================================
+ * BULK BUFFER PROCESSING
+ * ============================================================================
+ */
+
+/**
+ * @brief Classifies a character as a number separator
+ * @param c Character to classify
+ * @return Non-zero for space, tab, newline, carriage return, vertical tab
+ *         or form feed (the same set isspace() accepts in the "C" locale)
+ */
+static int isWhiteSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Parses a whole buffer of characters in a single critical section
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param buf Characters to process (need not be NUL-terminated)
+ * @param len Number of characters in buf
+ * @param out Caller-supplied array receiving completed numbers (may be NULL if cap is 0)
+ * @param cap Capacity of out
+ * @return Number of numbers completed in this buffer
+ *
+ * The mutex is taken once for the whole buffer instead of once per
+ * character, and runs of digits or separators are skipped in bulk by the
+ * NumberScanner kernel. Digits, '.' and whitespace drive exactly the same transitions
+ * as evDigit/evDot/evWhiteSpace; any other character is ignored. A number
+ * that is still in progress at the end of the buffer stays in the state
+ * machine and continues with the next call, so numbers split across buffer
+ * boundaries parse correctly. Use TokenizerMultiReceptor_flush() once the
+ * stream ends.
+ *
+ * If more than cap numbers complete, only the first cap are stored but all
+ * are counted, so a return value greater than cap signals truncation.
+ */
+size_t TokenizerMultiReceptor_feed(TokenizerMultiReceptor* const me, const char* buf, size_t len,
+                                   double* out, size_t cap) {
+    size_t count = 0;
+    double value;
+
+    if (me == NULL || buf == NULL) {
+        return 0;
+    }
+    if (out == NULL) {
+        cap = 0;
+    }
+
+    // Acquire mutex lock once for the whole buffer
+    Mutex_lock(me->itsMutex);
+
+    for (size_t block = 0; block < len; block += NUMBERSCANNER_BLOCK_SIZE) {
+        NumberScanMasks masks;
+        const char* chunk = buf + block;
+        size_t chunkLen = NumberScanner_classify(chunk, len - block, &masks);
+
+        for (size_t i = 0; i < chunkLen; i++) {
+            char c = chunk[i];
+
+#ifndef MULTIRECEPTOR_TRACE
+            /*
+             * Fast path: jump over whole runs that do not change state -
+             * separators while no number is in progress, digits while one
+             * is. Only characters at run edges go through the state
+             * machine below. Skipped when tracing, which reports every digit.
+             */
+            size_t run = 0;
+            if (me->stateID == NONUMBER_STATE) {
+                run = NumberScanner_runLength(~(masks.digit | masks.dot), i, chunkLen);
+            } else if (me->stateID == GOTNUMBER_STATE) {
+                run = NumberScanner_runLength(masks.digit, i, chunkLen);
+                if (run == 0) {
+                    // Not a digit - handled by the state machine below
+                } else if (me->subStateID == PROCESSINGWHOLEPART_SSTATE) {
+                    me->result = NumberScanner_appendWhole(me->result, chunk + i, run);
+                    me->ch = chunk[i + run - 1];
+                } else if (me->subStateID == PROCESSINGFRACTIONALPART_SSTATE) {
+                    me->result = NumberScanner_appendFraction(me->result, &me->tensPlace, chunk + i, run);
+                    me->ch = chunk[i + run - 1];
+                } else {
+                    run = 0;  // Invalid substate - leave it to the state machine
+                }
+            }
+            if (run > 0) {
+                i += run - 1;
+                continue;
+            }
+#endif
+
+            if (c >= '0' && c <= '9') {
+                processDigit(me, c);
+            } else if (c == '.') {
+                processDot(me);
+            } else if (isWhiteSpace(c) && completeNumber(me, &value)) {
+                if (count < cap) {
+                    out[count] = value;
+                }
+                count++;
+            }
+            // Other characters are ignored
+        }
+    }
+
     // Release mutex lock
     Mutex_release(me->itsMutex);
+
+    return count;
+}
+
+/**
+ * @brief Completes the number left pending by previous feed calls
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param out Receives the completed number (may be NULL to discard it)
+ * @return 1 if a number was completed, 0 if no number was in progress
+ *
+ * This is the bulk-API counterpart of evEndOfString.
+ */
+int TokenizerMultiReceptor_flush(TokenizerMultiReceptor* const me, double* out) {
+    double value;
+    int completed;
+
+    if (me == NULL) {
+        return 0;
+    }
+
+    Mutex_lock(me->itsMutex);
+    completed = completeNumber(me, &value);
+    Mutex_release(me->itsMutex);
+
+    if (completed && out != NULL) {
+        *out = value;
+    }
+    return completed;
 }
 
 /*
@@ -479,4 +488,153 @@ static void cleanUpRelations(TokenizerMultiReceptor* const me) {
     if(me->itsMutex != NULL) {
         me->itsMutex = NULL;  // Remove reference without destroying the mutex
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Unlocked digit transition shared by evDigit and feed
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param c The digit character to process ('0'-'9')
+ *
+ * State transitions:
+ * - NONUMBER_STATE -> GOTNUMBER_STATE (ProcessingWholePart substate)
+ * - GOTNUMBER_STATE remains, but may switch between substates
+ */
+static void processDigit(TokenizerMultiReceptor* const me, char c) {
+    switch (me->stateID) {
+        case NONUMBER_STATE:
+            /* Transition from no number to processing a number */
+            TokenizerMultiReceptor_exit_NoNumber(me);
+            me->ch = c;  // Store the current character
+            TokenizerMultiReceptor_enter_GotNumber(me);
+            me->stateID = GOTNUMBER_STATE;
+            TokenizerMultiReceptor_enter_ProcessingWholePart(me);
+            me->subStateID = PROCESSINGWHOLEPART_SSTATE;
+            TOKENIZER_TRACE("Current value of result: %g\n", me->result);
+            break;
+
+        case GOTNUMBER_STATE:
+            switch (me->subStateID) {
+                case PROCESSINGWHOLEPART_SSTATE:
+                    /* Continue processing whole number part */
+                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
+                    me->ch = c;
+                    TokenizerMultiReceptor_enter_ProcessingWholePart(me);
+                    TOKENIZER_TRACE("Current value of result: %g\n", me->result);
+                    break;
+
+                case PROCESSINGFRACTIONALPART_SSTATE:
+                    /* Process fractional digits after decimal point */
+                    TokenizerMultiReceptor_exit_ProcessingFractionalPart(me);
+                    me->ch = c;
+                    // Add fractional digit to result using current decimal place
+                    me->result += digit(me->ch) / me->tensPlace;
+                    me->tensPlace *= 10.0;  // Move to next decimal place
+                    TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
+                    TOKENIZER_TRACE("Current value of result: %g\n", me->result);
+                    break;
+
+                case NULL_SSTATE:
+                default:
+                    /* Invalid substate - ignore the digit */
+                    break;
+            };
+            break;
+
+        case NULL_STATE:
+        default:
+            /* Invalid state - ignore the digit */
+            break;
+    };
+}
+
+/**
+ * @brief Unlocked decimal point transition shared by evDot and feed
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ *
+ * State transitions:
+ * - NONUMBER_STATE -> GOTNUMBER_STATE (ProcessingFractionalPart substate)
+ * - GOTNUMBER_STATE: ProcessingWholePart -> ProcessingFractionalPart substate
+ */
+static void processDot(TokenizerMultiReceptor* const me) {
+    me->ch = '.';  // Store the decimal point character
+
+    switch (me->stateID) {
+        case NONUMBER_STATE:
+            /* Start processing a fractional number (e.g., ".5") */
+            TokenizerMultiReceptor_exit_NoNumber(me);
+            TokenizerMultiReceptor_enter_GotNumber(me);
+            me->stateID = GOTNUMBER_STATE;
+            TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
+            me->subStateID = PROCESSINGFRACTIONALPART_SSTATE;
+            break;
+
+        case GOTNUMBER_STATE:
+            switch (me->subStateID) {
+                case PROCESSINGWHOLEPART_SSTATE:
+                    /* Transition from whole part to fractional part */
+                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
+                    TokenizerMultiReceptor_enter_ProcessingFractionalPart(me);
+                    me->subStateID = PROCESSINGFRACTIONALPART_SSTATE;
+                    break;
+
+                case PROCESSINGFRACTIONALPART_SSTATE:
+                case NULL_SSTATE:
+                default:
+                    /* Already processing fractional part or invalid state - ignore */
+                    break;
+            };
+            break;
+
+        case NULL_STATE:
+        default:
+            /* Invalid state - ignore the decimal point */
+            break;
+    };
+}
+
+/**
+ * @brief Unlocked number completion shared by evWhiteSpace, evEndOfString,
+ *        feed and flush
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param value Receives the completed number
+ * @return 1 if a number was completed, 0 otherwise
+ *
+ * State transitions:
+ * - GOTNUMBER_STATE -> NONUMBER_STATE (completes current number)
+ */
+static int completeNumber(TokenizerMultiReceptor* const me, double* value) {
+    switch (me->stateID) {
+        case GOTNUMBER_STATE:
+            /* Finalize the current number being processed */
+            switch (me->subStateID) {
+                case PROCESSINGWHOLEPART_SSTATE:
+                    /* Exit from whole part processing */
+                    TokenizerMultiReceptor_exit_ProcessingWholePart(me);
+                    break;
+
+                case PROCESSINGFRACTIONALPART_SSTATE:
+                    /* Exit from fractional part processing */
+                    TokenizerMultiReceptor_exit_ProcessingFractionalPart(me);
+                    break;
+
+                case NULL_SSTATE:
+                default:
+                    /* Invalid substate - ignore */
+                    break;
+            };
+
+            /* Complete number processing and hand out the result */
+            TokenizerMultiReceptor_exit_GotNumber(me);
+            *value = me->result;
+            TOKENIZER_TRACE("Number: %g\n", me->result);
+            TokenizerMultiReceptor_enter_NoNumber(me);
+            me->stateID = NONUMBER_STATE;
+            return 1;
+
+        case NONUMBER_STATE:
+        case NULL_STATE:
+        default:
+            /* No number being processed or invalid state - nothing to do */
+            return 0;
+    };
+}
@@ -14,6 +14,7 @@
 #ifndef MULTIRECEPTOR_MULTIRECEPTOR_H
 #define MULTIRECEPTOR_MULTIRECEPTOR_H
 
+#include <stddef.h>
 #include <stdio.h>
 
 // Forward declaration for Mutex structure (defined in Mutex.h)
@@ -169,6 +170,36 @@ void TokenizerMultiReceptor_evEndOfString(TokenizerMultiReceptor* const me);
  */
 void TokenizerMultiReceptor_evWhiteSpace(TokenizerMultiReceptor* const me);
 
+/*
+ * ============================================================================
+ * BULK BUFFER PROCESSING
+ * ============================================================================
+ */
+
+/**
+ * @brief Parse a buffer of characters while holding the mutex only once
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param buf Characters to process (need not be NUL-terminated)
+ * @param len Number of characters in buf
+ * @param out Caller-supplied array receiving the completed numbers
+ * @param cap Capacity of out
+ * @return Number of numbers completed; only the first cap are stored in out
+ *
+ * Equivalent to dispatching every character to evDigit/evDot/evWhiteSpace,
+ * but without per-character locking. A number still in progress at the end
+ * of buf is carried over to the next call.
+ */
+size_t TokenizerMultiReceptor_feed(TokenizerMultiReceptor* const me, const char* buf, size_t len,
+                                   double* out, size_t cap);
+
+/**
+ * @brief Finish the number carried over from previous feed calls
+ * @param me Pointer to the TokenizerMultiReceptor instance
+ * @param out Receives the completed number (may be NULL)
+ * @return 1 if a number was completed, 0 if none was in progress
+ */
+int TokenizerMultiReceptor_flush(TokenizerMultiReceptor* const me, double* out);
+
 /*
  * ============================================================================
  * STATE ENTRY AND EXIT ACTION FUNCTIONS
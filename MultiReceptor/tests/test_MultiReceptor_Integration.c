@@ -454,6 +454,78 @@ void test_ErrorRecovery(void) {
                                      "Should parse digit correctly after reset");
 }
 
+/*
+ * ============================================================================
+ * BULK FEED API TESTS
+ * ============================================================================
+ */
+
+/**
+ * @brief Test that feed produces the same numbers as per-character events
+ */
+void test_Feed_MatchesPerCharacterEvents(void) {
+    const char* input = "123 45.67\t.5 extra 0.001\n999.999  42";
+    double expected[] = {123.0, 45.67, 0.5, 0.001, 999.999, 42.0};
+    double numbers[8];
+    double last = 0.0;
+
+    size_t count = TokenizerMultiReceptor_feed(tokenizer, input, strlen(input), numbers, 8);
+
+    // The trailing "42" is still pending until the stream is flushed
+    TEST_ASSERT_EQUAL_INT(5, (int)count);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(expected[i], numbers[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(1, TokenizerMultiReceptor_flush(tokenizer, &last));
+    TEST_ASSERT_EQUAL_DOUBLE(expected[5], last);
+    TEST_ASSERT_EQUAL_INT(NONUMBER_STATE, tokenizer->stateID);
+
+    // Nothing left to flush
+    TEST_ASSERT_EQUAL_INT(0, TokenizerMultiReceptor_flush(tokenizer, &last));
+}
+
+/**
+ * @brief Test numbers split across buffer boundaries at every position
+ */
+void test_Feed_NumbersSplitAcrossBuffers(void) {
+    const char* input = "3.14159 2718.28 .75 ";
+    size_t len = strlen(input);
+    double expected[] = {3.14159, 2718.28, 0.75};
+
+    for (size_t split = 0; split <= len; split++) {
+        double numbers[4];
+
+        TokenizerMultiReceptor_Init(tokenizer);
+        TokenizerMultiReceptor_setItsMutex(tokenizer, test_mutex);
+
+        size_t count = TokenizerMultiReceptor_feed(tokenizer, input, split, numbers, 4);
+        count += TokenizerMultiReceptor_feed(tokenizer, input + split, len - split,
+                                             numbers + count, 4 - count);
+
+        TEST_ASSERT_EQUAL_INT(3, (int)count);
+        for (size_t i = 0; i < count; i++) {
+            TEST_ASSERT_EQUAL_DOUBLE(expected[i], numbers[i]);
+        }
+    }
+}
+
+/**
+ * @brief Test that feed counts numbers beyond the output capacity
+ */
+void test_Feed_ReportsTruncation(void) {
+    const char* input = "1 2 3 4 5 ";
+    double numbers[2];
+
+    size_t count = TokenizerMultiReceptor_feed(tokenizer, input, strlen(input), numbers, 2);
+
+    TEST_ASSERT_EQUAL_INT(5, (int)count);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, numbers[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, numbers[1]);
+
+    // A NULL output array only counts
+    TEST_ASSERT_EQUAL_INT(5, (int)TokenizerMultiReceptor_feed(tokenizer, input, strlen(input), NULL, 0));
+}
+
 /*
  * ============================================================================
  * MAIN INTEGRATION TEST RUNNER
@@ -487,5 +559,10 @@ int main(void) {
     // Error recovery tests
     RUN_TEST(test_ErrorRecovery);
     
+    // Bulk feed API tests
+    RUN_TEST(test_Feed_MatchesPerCharacterEvents);
+    RUN_TEST(test_Feed_NumbersSplitAcrossBuffers);
+    RUN_TEST(test_Feed_ReportsTruncation);
+    
     return UNITY_END();
 }
@@ -281,6 +281,68 @@ void test_Performance_MutexOverhead(void) {
                                   "Mutex overhead should be minimal");
 }
 
+/**
+ * @brief Compare per-character events against the bulk feed API
+ */
+void test_Performance_FeedVersusPerCharacter(void) {
+    const char* pattern = "123 456.78 999.999 0.5 1000 ";
+    const size_t PATTERN_LEN = strlen(pattern);
+    const size_t REPEATS = 20000;
+    const size_t BUFFER_LEN = PATTERN_LEN * REPEATS;
+    const size_t CHUNK = 4096;
+    size_t per_char_count = 0;
+    size_t feed_count = 0;
+    double numbers[1024];
+
+    char* buffer = malloc(BUFFER_LEN);
+    TEST_ASSERT_NOT_NULL(buffer);
+    for (size_t i = 0; i < REPEATS; i++) {
+        memcpy(buffer + i * PATTERN_LEN, pattern, PATTERN_LEN);
+    }
+
+    // Per-character events: one lock/unlock per character
+    TokenizerMultiReceptor_Init(tokenizer);
+    TokenizerMultiReceptor_setItsMutex(tokenizer, test_mutex);
+    long start_time = getCurrentTimeMicros();
+    for (size_t i = 0; i < BUFFER_LEN; i++) {
+        char c = buffer[i];
+        if (c >= '0' && c <= '9') {
+            TokenizerMultiReceptor_evDigit(tokenizer, c);
+        } else if (c == '.') {
+            TokenizerMultiReceptor_evDot(tokenizer);
+        } else if (c == ' ') {
+            if (tokenizer->stateID == GOTNUMBER_STATE) {
+                per_char_count++;
+            }
+            TokenizerMultiReceptor_evWhiteSpace(tokenizer);
+        }
+    }
+    long per_char_time = getCurrentTimeMicros() - start_time;
+
+    // Bulk feed: one lock/unlock per chunk
+    TokenizerMultiReceptor_Init(tokenizer);
+    TokenizerMultiReceptor_setItsMutex(tokenizer, test_mutex);
+    start_time = getCurrentTimeMicros();
+    for (size_t offset = 0; offset < BUFFER_LEN; offset += CHUNK) {
+        size_t len = BUFFER_LEN - offset < CHUNK ? BUFFER_LEN - offset : CHUNK;
+        feed_count += TokenizerMultiReceptor_feed(tokenizer, buffer + offset, len, numbers, 1024);
+    }
+    long feed_time = getCurrentTimeMicros() - start_time;
+
+    printf("\n--- Feed vs Per-Character Performance ---\n");
+    printf("Buffer size: %zu bytes, chunk size: %zu bytes\n", BUFFER_LEN, CHUNK);
+    printf("Per-character events: %ld microseconds (%.1f MB/s)\n", per_char_time,
+           per_char_time > 0 ? (double)BUFFER_LEN / (double)per_char_time : 0.0);
+    printf("Bulk feed: %ld microseconds (%.1f MB/s)\n", feed_time,
+           feed_time > 0 ? (double)BUFFER_LEN / (double)feed_time : 0.0);
+    printf("Speedup: %.2fx\n", feed_time > 0 ? (double)per_char_time / (double)feed_time : 0.0);
+
+    free(buffer);
+
+    TEST_ASSERT_EQUAL_INT(5 * (int)REPEATS, (int)per_char_count);
+    TEST_ASSERT_EQUAL_INT(5 * (int)REPEATS, (int)feed_count);
+}
+
 /*
  * ============================================================================
  * MEMORY USAGE TESTS
@@ -360,6 +422,7 @@ int main(void) {
     RUN_TEST(test_Performance_MultiNumber);
     RUN_TEST(test_Performance_ObjectLifecycle);
     RUN_TEST(test_Performance_MutexOverhead);
+    RUN_TEST(test_Performance_FeedVersusPerCharacter);
     
     // Memory usage tests
     RUN_TEST(test_MemoryUsage_TokenizerSize);
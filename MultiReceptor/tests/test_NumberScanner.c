@@ -0,0 +1,239 @@
+//
+// Unit Tests for the NumberScanner kernel
+//
+// This file verifies the vectorized character classification and the bulk
+// accumulation helpers, and checks that the scanner-backed feed path is
+// bit-identical to the per-character state machine.
+//
+// Test Framework: Unity (C unit testing framework)
+// Test Categories:
+// - Block classification (vector and scalar tail)
+// - Run-length lookup on class masks
+// - Bit-identical bulk accumulation
+// - Feed versus per-character equivalence
+//
+
+#include "unity.h"
+#include "NumberScanner.h"
+#include "MultiReceptor.h"
+#include "Mutex.h"
+#include <stdlib.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Reference whole-part accumulation (the original per-digit loop)
+ */
+static double referenceWhole(double result, const char* digits, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        result = result * 10 + digit(digits[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Parse a string one event at a time, collecting completed numbers
+ */
+static size_t parsePerCharacter(const char* input, size_t len, double* out, size_t cap) {
+    TokenizerMultiReceptor* tokenizer = TokenizerMultiReceptor_Create();
+    size_t count = 0;
+
+    for (size_t i = 0; i <= len; i++) {
+        char c = i < len ? input[i] : '\0';
+
+        if (c >= '0' && c <= '9') {
+            TokenizerMultiReceptor_evDigit(tokenizer, c);
+        } else if (c == '.') {
+            TokenizerMultiReceptor_evDot(tokenizer);
+        } else if (c == ' ' || (c >= '\t' && c <= '\r') || c == '\0') {
+            if (tokenizer->stateID == GOTNUMBER_STATE && count < cap) {
+                out[count++] = tokenizer->result;
+            }
+            if (c == '\0') {
+                TokenizerMultiReceptor_evEndOfString(tokenizer);
+            } else {
+                TokenizerMultiReceptor_evWhiteSpace(tokenizer);
+            }
+        }
+    }
+
+    TokenizerMultiReceptor_Destroy(tokenizer);
+    return count;
+}
+
+/*
+ * ============================================================================
+ * CLASSIFICATION TESTS
+ * ============================================================================
+ */
+
+/**
+ * @brief Test masks for a full 32-byte block
+ */
+void test_Classify_FullBlock(void) {
+    const char* block = "12.5 \t\nab9\r\v\f.x0123456789 .  Z!#";
+    NumberScanMasks masks;
+    uint32_t digit = 0;
+    uint32_t dot = 0;
+    uint32_t space = 0;
+
+    for (int i = 0; i < 32; i++) {
+        char c = block[i];
+        if (c >= '0' && c <= '9') {
+            digit |= 1u << i;
+        } else if (c == '.') {
+            dot |= 1u << i;
+        } else if (c == ' ' || (c >= '\t' && c <= '\r')) {
+            space |= 1u << i;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(32, (int)NumberScanner_classify(block, strlen(block), &masks));
+    TEST_ASSERT_EQUAL_HEX32(digit, masks.digit);
+    TEST_ASSERT_EQUAL_HEX32(dot, masks.dot);
+    TEST_ASSERT_EQUAL_HEX32(space, masks.space);
+}
+
+/**
+ * @brief Test that short tails and high-bit bytes are classified correctly
+ */
+void test_Classify_ShortTailAndHighBytes(void) {
+    const char tail[5] = {'7', (char)0xB9, '.', ' ', (char)0x80};
+    NumberScanMasks masks;
+
+    TEST_ASSERT_EQUAL_INT(5, (int)NumberScanner_classify(tail, 5, &masks));
+    TEST_ASSERT_EQUAL_HEX32(0x01, masks.digit);
+    TEST_ASSERT_EQUAL_HEX32(0x04, masks.dot);
+    TEST_ASSERT_EQUAL_HEX32(0x08, masks.space);
+}
+
+/**
+ * @brief Test run lengths across a mask and at the block limit
+ */
+void test_RunLength(void) {
+    TEST_ASSERT_EQUAL_INT(3, (int)NumberScanner_runLength(0x0Eu, 1, 32));
+    TEST_ASSERT_EQUAL_INT(0, (int)NumberScanner_runLength(0x0Eu, 0, 32));
+    TEST_ASSERT_EQUAL_INT(32, (int)NumberScanner_runLength(0xFFFFFFFFu, 0, 32));
+    TEST_ASSERT_EQUAL_INT(5, (int)NumberScanner_runLength(0xFFFFFFFFu, 0, 5));
+    TEST_ASSERT_EQUAL_INT(0, (int)NumberScanner_runLength(0xFFFFFFFFu, 5, 5));
+}
+
+/*
+ * ============================================================================
+ * BULK ACCUMULATION TESTS
+ * ============================================================================
+ */
+
+/**
+ * @brief Test whole-part accumulation is bit-identical, including past 2^53
+ */
+void test_AppendWhole_BitIdentical(void) {
+    const char* digits = "98765432109876543210987654321";
+    size_t len = strlen(digits);
+
+    for (size_t start = 0; start < len; start++) {
+        for (size_t n = 1; start + n <= len; n++) {
+            double seed = referenceWhole(0.0, digits, start);
+            double expected = referenceWhole(seed, digits + start, n);
+            double actual = NumberScanner_appendWhole(seed, digits + start, n);
+            TEST_ASSERT_EQUAL_MEMORY(&expected, &actual, sizeof(double));
+        }
+    }
+}
+
+/**
+ * @brief Test fractional accumulation keeps the original rounding sequence
+ */
+void test_AppendFraction_BitIdentical(void) {
+    const char* digits = "14159265358979323846";
+    double expected = 3.0;
+    double expectedPlace = 10.0;
+    double place = 10.0;
+
+    for (size_t i = 0; digits[i] != '\0'; i++) {
+        expected += digit(digits[i]) / expectedPlace;
+        expectedPlace *= 10.0;
+    }
+    double actual = NumberScanner_appendFraction(3.0, &place, digits, strlen(digits));
+
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &actual, sizeof(double));
+    TEST_ASSERT_EQUAL_MEMORY(&expectedPlace, &place, sizeof(double));
+}
+
+/*
+ * ============================================================================
+ * FEED EQUIVALENCE TESTS
+ * ============================================================================
+ */
+
+/**
+ * @brief Test feed against per-character events on pseudo-random input
+ */
+void test_Feed_BitIdenticalToPerCharacter(void) {
+    const char alphabet[] = "0123456789012345678901234567890123456789.. \t\nx";
+    const size_t LEN = 20000;
+    char* input = malloc(LEN);
+    double* expected = malloc(LEN * sizeof(double));
+    double* actual = malloc(LEN * sizeof(double));
+    unsigned seed = 12345u;
+
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(expected);
+    TEST_ASSERT_NOT_NULL(actual);
+    for (size_t i = 0; i < LEN; i++) {
+        seed = seed * 1103515245u + 12345u;
+        input[i] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+
+    size_t expectedCount = parsePerCharacter(input, LEN, expected, LEN);
+
+    // Odd-sized pieces so numbers straddle both buffer and block edges
+    TokenizerMultiReceptor* tokenizer = TokenizerMultiReceptor_Create();
+    size_t actualCount = 0;
+    for (size_t offset = 0; offset < LEN; offset += 77) {
+        size_t len = LEN - offset < 77 ? LEN - offset : 77;
+        actualCount += TokenizerMultiReceptor_feed(tokenizer, input + offset, len,
+                                                   actual + actualCount, LEN - actualCount);
+    }
+    actualCount += (size_t)TokenizerMultiReceptor_flush(tokenizer, actual + actualCount);
+    TokenizerMultiReceptor_Destroy(tokenizer);
+
+    TEST_ASSERT_EQUAL_INT((int)expectedCount, (int)actualCount);
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, expectedCount * sizeof(double));
+
+    free(input);
+    free(expected);
+    free(actual);
+}
+
+/*
+ * ============================================================================
+ * MAIN TEST RUNNER
+ * ============================================================================
+ */
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Classification tests
+    RUN_TEST(test_Classify_FullBlock);
+    RUN_TEST(test_Classify_ShortTailAndHighBytes);
+    RUN_TEST(test_RunLength);
+
+    // Bulk accumulation tests
+    RUN_TEST(test_AppendWhole_BitIdentical);
+    RUN_TEST(test_AppendFraction_BitIdentical);
+
+    // Feed equivalence tests
+    RUN_TEST(test_Feed_BitIdenticalToPerCharacter);
+
+    return UNITY_END();
+}
@@ -69,6 +69,7 @@ void demonstrate_single_receptor_pattern(const char* input_string) {
 
     // Clean up
     TokenizerSyncSingleReceptor_Destroy(receptor);
+    TSREventQueue_Cleanup(&eventQueue);
 
     // Destroy the mutex
     if (Mutex_destroy(&mutex) != 0) {
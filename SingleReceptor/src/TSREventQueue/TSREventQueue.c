@@ -1,6 +1,14 @@
+#define _POSIX_C_SOURCE 200112L  // read/write, sched_yield
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 #include "TSREventQueue.h"
 #include "Mutex.h"
 #include "TokenizeAsyncSinglePkg.h"
@@ -8,19 +16,256 @@
 // Internal helper to clean up relations (mutex pointer)
 static void cleanUpRelations(TSREventQueue* const eventQueue);
 
+// Internal helpers for blocking the consumer (shared by both queue modes)
+static void wakeConsumer(TSREventQueue* const eventQueue);
+static void blockConsumer(TSREventQueue* const eventQueue);
+static void closeWakeFd(TSREventQueue* const eventQueue);
+
+#ifdef TSREVENTQUEUE_SPSC
+
 // Initialize the event queue
 void TSREventQueue_Init(TSREventQueue* const eventQueue) {
+    (void)TSREventQueue_InitWithCapacity(eventQueue, TSREVENTQUEUE_DEFAULT_CAPACITY);
+}
+
+// Initialize the event queue with a power-of-two ring of at least capacity slots
+int TSREventQueue_InitWithCapacity(TSREventQueue* const eventQueue, size_t capacity) {
+    size_t slots = 1;
+
+    if (eventQueue == NULL) {
+        return -1; // Fail gracefully if queue is null
+    }
+    memset(eventQueue, 0, sizeof(*eventQueue));
+    eventQueue->wakeFd = -1;
+    eventQueue->mutexPtr = NULL;
+    if (capacity == 0 || capacity > SIZE_MAX / (2 * sizeof(Event))) {
+        return -1; // Queue stays at capacity 0: always full and empty
+    }
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    eventQueue->ring = (Event *) malloc(slots * sizeof(Event));
+    if (eventQueue->ring == NULL) {
+        return -1;
+    }
+    eventQueue->capacity = slots;
+    eventQueue->mask = slots - 1;
+    return 0;
+}
+
+// Cleanup the event queue
+void TSREventQueue_Cleanup(TSREventQueue* const eventQueue) {
+    if (eventQueue == NULL) {
+        return;
+    }
+    free(eventQueue->ring);
+    eventQueue->ring = NULL;
+    eventQueue->capacity = 0;
+    eventQueue->mask = 0;
+    closeWakeFd(eventQueue);
+    cleanUpRelations(eventQueue);
+}
+
+// Check if the event queue is empty (safe to call from either side)
+int TSREventQueue_isEmpty(TSREventQueue* const eventQueue) {
+    if (eventQueue == NULL) {
+        return 1; // Consider null queue as empty
+    }
+    return __atomic_load_n(&eventQueue->head, __ATOMIC_ACQUIRE) ==
+           __atomic_load_n(&eventQueue->tail, __ATOMIC_ACQUIRE);
+}
+
+// Check if the event queue is full (safe to call from either side)
+int TSREventQueue_isFull(TSREventQueue* const eventQueue) {
     if (eventQueue == NULL) {
-        return; // Fail gracefully if queue is null
+        return 1; // Consider null queue as full to prevent writes
+    }
+    return __atomic_load_n(&eventQueue->head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&eventQueue->tail, __ATOMIC_ACQUIRE) >= eventQueue->capacity;
+}
+
+// Get the maximum number of events the queue can hold
+size_t TSREventQueue_capacity(const TSREventQueue* const eventQueue) {
+    return eventQueue == NULL ? 0 : eventQueue->capacity;
+}
+
+// Number of free slots as seen by the producer, refreshing its view of tail
+// only when the cached one does not leave room for wanted events
+static size_t producerSpace(TSREventQueue* const eventQueue, size_t head, size_t wanted) {
+    size_t space = eventQueue->capacity - (head - eventQueue->cachedTail);
+
+    if (space < wanted) {
+        eventQueue->cachedTail = __atomic_load_n(&eventQueue->tail, __ATOMIC_ACQUIRE);
+        space = eventQueue->capacity - (head - eventQueue->cachedTail);
+    }
+    return space;
+}
+
+// Number of queued events as seen by the consumer, refreshing its view of head
+// only when the cached one does not cover wanted events
+static size_t consumerAvailable(TSREventQueue* const eventQueue, size_t tail, size_t wanted) {
+    size_t available = eventQueue->cachedHead - tail;
+
+    if (available < wanted) {
+        eventQueue->cachedHead = __atomic_load_n(&eventQueue->head, __ATOMIC_ACQUIRE);
+        available = eventQueue->cachedHead - tail;
+    }
+    return available;
+}
+
+// Post an event to the queue and signal its presence
+// Producer side only
+int TSREventQueue_post(TSREventQueue* const eventQueue, Event event) {
+    size_t head;
+
+    if (eventQueue == NULL) {
+        return 0; // Fail if queue is null
+    }
+
+    head = eventQueue->head;
+    if (producerSpace(eventQueue, head, 1) == 0) {
+        return 0;
+    }
+    eventQueue->ring[head & eventQueue->mask] = event;
+    __atomic_store_n(&eventQueue->head, head + 1, __ATOMIC_RELEASE);
+    wakeConsumer(eventQueue);
+    return 1;
+}
+
+// Pull the oldest event from the queue
+// Consumer side only; returns an empty event if there is none
+Event TSREventQueue_pull(TSREventQueue* const eventQueue) {
+    Event event = {0}; // Initialize to prevent garbage data
+    size_t tail;
+
+    if (eventQueue == NULL) {
+        return event; // Return empty event if queue is null
+    }
+
+    tail = eventQueue->tail;
+    if (consumerAvailable(eventQueue, tail, 1) == 0) {
+        return event;
+    }
+    event = eventQueue->ring[tail & eventQueue->mask];
+    __atomic_store_n(&eventQueue->tail, tail + 1, __ATOMIC_RELEASE);
+    return event;
+}
+
+// Post up to count events with a single index publish and at most one wakeup
+// Producer side only
+size_t TSREventQueue_postN(TSREventQueue* const eventQueue, const Event* events, size_t count) {
+    size_t head;
+    size_t space;
+    size_t first;
+    size_t offset;
+
+    if (eventQueue == NULL || events == NULL || count == 0) {
+        return 0;
+    }
+
+    head = eventQueue->head;
+    space = producerSpace(eventQueue, head, count);
+    if (count > space) {
+        count = space;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // Copy in at most two pieces: up to the end of the ring, then from its start
+    offset = head & eventQueue->mask;
+    first = eventQueue->capacity - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(&eventQueue->ring[offset], events, first * sizeof(Event));
+    memcpy(&eventQueue->ring[0], events + first, (count - first) * sizeof(Event));
+    __atomic_store_n(&eventQueue->head, head + count, __ATOMIC_RELEASE);
+    wakeConsumer(eventQueue);
+    return count;
+}
+
+// Pull up to maxCount events with a single index publish
+// Consumer side only
+size_t TSREventQueue_pullN(TSREventQueue* const eventQueue, Event* events, size_t maxCount) {
+    size_t tail;
+    size_t count;
+    size_t first;
+    size_t offset;
+
+    if (eventQueue == NULL || events == NULL || maxCount == 0) {
+        return 0;
+    }
+
+    tail = eventQueue->tail;
+    count = consumerAvailable(eventQueue, tail, maxCount);
+    if (count > maxCount) {
+        count = maxCount;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    offset = tail & eventQueue->mask;
+    first = eventQueue->capacity - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(events, &eventQueue->ring[offset], first * sizeof(Event));
+    memcpy(events + first, &eventQueue->ring[0], (count - first) * sizeof(Event));
+    __atomic_store_n(&eventQueue->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+// Block the consumer until the queue holds at least one event
+void TSREventQueue_wait(TSREventQueue* const eventQueue) {
+    if (eventQueue == NULL) {
+        return;
+    }
+
+    while (consumerAvailable(eventQueue, eventQueue->tail, 1) == 0) {
+        // Announce the sleep before the final check; pairs with the fence in wakeConsumer
+        __atomic_store_n(&eventQueue->sleeping, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (consumerAvailable(eventQueue, eventQueue->tail, 1) == 0) {
+            blockConsumer(eventQueue);
+        }
+        __atomic_store_n(&eventQueue->sleeping, 0, __ATOMIC_RELAXED);
+    }
+}
+
+#else
+
+// Initialize the event queue
+void TSREventQueue_Init(TSREventQueue* const eventQueue) {
+    (void)TSREventQueue_InitWithCapacity(eventQueue, QSIZE - 1);
+}
+
+// Initialize the event queue with room for capacity events (at most QSIZE)
+int TSREventQueue_InitWithCapacity(TSREventQueue* const eventQueue, size_t capacity) {
+    if (eventQueue == NULL) {
+        return -1; // Fail gracefully if queue is null
     }
     eventQueue->head = 0;
     eventQueue->size = 0;
     eventQueue->tail = 0;
+    eventQueue->capacity = 0;
+    eventQueue->sleeping = 0;
+    eventQueue->wakeFd = -1;
     eventQueue->mutexPtr = NULL;
+    if (capacity == 0 || capacity > QSIZE) {
+        return -1;
+    }
+    eventQueue->capacity = (int)capacity;
+    return 0;
 }
 
 // Cleanup the event queue
 void TSREventQueue_Cleanup(TSREventQueue* const eventQueue) {
+    if (eventQueue == NULL) {
+        return;
+    }
+    closeWakeFd(eventQueue);
     cleanUpRelations(eventQueue);
 }
 
@@ -37,7 +282,12 @@ int TSREventQueue_isFull(TSREventQueue* const eventQueue) {
     if (eventQueue == NULL) {
         return 1; // Consider null queue as full to prevent writes
     }
-    return eventQueue->size >= QSIZE-1;
+    return eventQueue->size >= eventQueue->capacity;
+}
+
+// Get the maximum number of events the queue can hold
+size_t TSREventQueue_capacity(const TSREventQueue* const eventQueue) {
+    return eventQueue == NULL ? 0 : (size_t)eventQueue->capacity;
 }
 
 // Post an event to the queue and signal its presence
@@ -53,6 +303,7 @@ int TSREventQueue_post(TSREventQueue* const eventQueue, Event event) {
         eventQueue->size += 1;
         Mutex_release(eventQueue->mutexPtr);
         postSignal(); // Signal that an event is present
+        wakeConsumer(eventQueue);
         return 1;
     }
     Mutex_release(eventQueue->mutexPtr);
@@ -77,6 +328,71 @@ Event TSREventQueue_pull(TSREventQueue* const eventQueue) {
     return event;
 }
 
+// Post up to count events under a single lock
+size_t TSREventQueue_postN(TSREventQueue* const eventQueue, const Event* events, size_t count) {
+    size_t posted = 0;
+
+    if (eventQueue == NULL || events == NULL || count == 0) {
+        return 0;
+    }
+
+    Mutex_lock(eventQueue->mutexPtr);
+    while (posted < count && !TSREventQueue_isFull(eventQueue)) {
+        eventQueue->queue[eventQueue->head] = events[posted++];
+        eventQueue->head = (eventQueue->head + 1) % QSIZE;
+        eventQueue->size += 1;
+    }
+    Mutex_release(eventQueue->mutexPtr);
+    if (posted > 0) {
+        postSignal(); // Signal that events are present
+        wakeConsumer(eventQueue);
+    }
+    return posted;
+}
+
+// Pull up to maxCount events under a single lock
+size_t TSREventQueue_pullN(TSREventQueue* const eventQueue, Event* events, size_t maxCount) {
+    size_t pulled = 0;
+
+    if (eventQueue == NULL || events == NULL) {
+        return 0;
+    }
+
+    Mutex_lock(eventQueue->mutexPtr);
+    while (pulled < maxCount && !TSREventQueue_isEmpty(eventQueue)) {
+        events[pulled++] = eventQueue->queue[eventQueue->tail];
+        eventQueue->tail = (eventQueue->tail + 1) % QSIZE;
+        eventQueue->size -= 1;
+    }
+    Mutex_release(eventQueue->mutexPtr);
+    return pulled;
+}
+
+// Block the consumer until the queue holds at least one event
+void TSREventQueue_wait(TSREventQueue* const eventQueue) {
+    int empty;
+
+    if (eventQueue == NULL) {
+        return;
+    }
+
+    for (;;) {
+        // Announce the sleep before checking under the lock; a producer that posts
+        // after the check sees the flag once it has released the lock
+        __atomic_store_n(&eventQueue->sleeping, 1, __ATOMIC_SEQ_CST);
+        Mutex_lock(eventQueue->mutexPtr);
+        empty = TSREventQueue_isEmpty(eventQueue);
+        Mutex_release(eventQueue->mutexPtr);
+        if (!empty) {
+            break;
+        }
+        blockConsumer(eventQueue);
+    }
+    __atomic_store_n(&eventQueue->sleeping, 0, __ATOMIC_RELAXED);
+}
+
+#endif
+
 // Get the mutex associated with the event queue
 struct Mutex* TSREventQueue_getItsMutex(const TSREventQueue* const eventQueue) {
     return (struct Mutex*)eventQueue->mutexPtr;
@@ -96,6 +412,17 @@ TSREventQueue * TSREventQueue_Create(void) {
     return eventQueue;
 }
 
+// Create a new event queue instance with room for capacity events
+TSREventQueue * TSREventQueue_CreateWithCapacity(size_t capacity) {
+    TSREventQueue* eventQueue = (TSREventQueue *) malloc(sizeof(TSREventQueue));
+    if(eventQueue != NULL && TSREventQueue_InitWithCapacity(eventQueue, capacity) != 0) {
+        TSREventQueue_Cleanup(eventQueue);
+        free(eventQueue);
+        eventQueue = NULL;
+    }
+    return eventQueue;
+}
+
 // Destroy an event queue instance
 void TSREventQueue_Destroy(TSREventQueue* const eventQueue) {
     if(eventQueue != NULL) {
@@ -110,3 +437,59 @@ static void cleanUpRelations(TSREventQueue* const eventQueue) {
         eventQueue->mutexPtr = NULL;
     }
 }
+
+// Wake the consumer if it is blocked in TSREventQueue_wait
+// Called by the producer after publishing; costs a fence and a load when nobody sleeps
+static void wakeConsumer(TSREventQueue* const eventQueue) {
+    int fd;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&eventQueue->sleeping, __ATOMIC_RELAXED)) {
+        return;
+    }
+    fd = __atomic_load_n(&eventQueue->wakeFd, __ATOMIC_ACQUIRE);
+    if (fd >= 0) {
+        uint64_t one = 1;
+        if (write(fd, &one, sizeof(one)) != (ssize_t)sizeof(one)) {
+            // Nothing to recover: the consumer re-checks the queue whenever it wakes
+        }
+    }
+}
+
+// Sleep until a producer calls wakeConsumer (or briefly, without an eventfd)
+// Pending wakeups are counted by the eventfd, so a post that races with the
+// consumer going to sleep is never lost
+static void blockConsumer(TSREventQueue* const eventQueue) {
+#ifdef __linux__
+    int fd = __atomic_load_n(&eventQueue->wakeFd, __ATOMIC_ACQUIRE);
+
+    if (fd < 0) {
+        // Opened on first use, before sleeping is re-checked, so producers that
+        // see the flag also see the descriptor
+        fd = eventfd(0, EFD_CLOEXEC);
+        if (fd < 0) {
+            sched_yield(); // No eventfd available: poll politely
+            return;
+        }
+        __atomic_store_n(&eventQueue->wakeFd, fd, __ATOMIC_RELEASE);
+        return; // Re-check the queue now that wakeups can be delivered
+    }
+    {
+        uint64_t count;
+        if (read(fd, &count, sizeof(count)) < 0) {
+            sched_yield(); // Interrupted: the caller re-checks the queue
+        }
+    }
+#else
+    (void)eventQueue;
+    sched_yield(); // No eventfd: poll politely
+#endif
+}
+
+// Close the wakeup descriptor, if one was opened
+static void closeWakeFd(TSREventQueue* const eventQueue) {
+    if (eventQueue->wakeFd >= 0) {
+        close(eventQueue->wakeFd);
+    }
+    eventQueue->wakeFd = -1;
+}
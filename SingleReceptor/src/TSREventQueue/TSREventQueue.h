@@ -2,23 +2,60 @@
 #ifndef TSREventQueue_H
 #define TSREventQueue_H
 
+#include <stddef.h>
 #include "../TokenizeAsyncSinglePkg/TokenizeAsyncSinglePkg.h"
 
 struct Mutex;
 
+// Cache line size used to keep producer and consumer indices apart (SPSC mode)
+#define TSREVENTQUEUE_CACHE_LINE 64
+
+// Default ring capacity in SPSC mode (power of two)
+#define TSREVENTQUEUE_DEFAULT_CAPACITY 128
+
 // Event queue structure for thread-safe event management
 typedef struct TSREventQueue TSREventQueue;
+
+#ifdef TSREVENTQUEUE_SPSC
+// Single-producer/single-consumer lock-free ring (build with ENABLE_SPSC_QUEUE)
+// head and tail grow without wrapping and are masked on access, so every slot is
+// usable. Each index sits on its own cache line next to the owner's cached copy of
+// the other side's index, so the fast path never touches a line the other thread writes.
+struct TSREventQueue {
+    size_t head;           // Next insertion index (written by the producer only)
+    size_t cachedTail;     // Producer's last view of tail
+    char headPad[TSREVENTQUEUE_CACHE_LINE - 2 * sizeof(size_t)];
+    size_t tail;           // Next removal index (written by the consumer only)
+    size_t cachedHead;     // Consumer's last view of head
+    char tailPad[TSREVENTQUEUE_CACHE_LINE - 2 * sizeof(size_t)];
+    Event* ring;           // Event storage, capacity entries
+    size_t capacity;       // Number of slots (power of two, 0 if Init failed)
+    size_t mask;           // capacity - 1
+    int sleeping;          // Set while the consumer is blocked in TSREventQueue_wait
+    int wakeFd;            // eventfd used to wake the consumer (-1 until first wait)
+    struct Mutex* mutexPtr;// Unused in SPSC mode, kept for API compatibility
+};
+#else
 struct TSREventQueue {
     Event queue[QSIZE];    // Array of events
     int size;              // Current number of events in the queue
     int head;              // Index for next event insertion
     int tail;              // Index for next event removal
+    int capacity;          // Maximum number of queued events (at most QSIZE)
+    int sleeping;          // Set while the consumer is blocked in TSREventQueue_wait
+    int wakeFd;            // eventfd used to wake the consumer (-1 until first wait)
     struct Mutex* mutexPtr;// Pointer to mutex for thread safety
 };
+#endif
 
 // Initialize the event queue
 void TSREventQueue_Init(TSREventQueue* const eventQueue);
 
+// Initialize the event queue with room for capacity events
+// SPSC mode rounds capacity up to a power of two; the mutex queue accepts up to QSIZE
+// Returns 0 on success, -1 on invalid capacity or allocation failure
+int TSREventQueue_InitWithCapacity(TSREventQueue* const eventQueue, size_t capacity);
+
 // Cleanup the event queue
 void TSREventQueue_Cleanup(TSREventQueue* const queue);
 
@@ -28,12 +65,25 @@ int TSREventQueue_isEmpty(TSREventQueue* const eventQueue);
 // Check if the event queue is full
 int TSREventQueue_isFull(TSREventQueue* const eventQueue);
 
+// Get the maximum number of events the queue can hold
+size_t TSREventQueue_capacity(const TSREventQueue* const eventQueue);
+
 // Post an event to the queue
 int TSREventQueue_post(TSREventQueue* const eventQueue, Event event);
 
 // Pull the oldest event from the queue
 Event TSREventQueue_pull(TSREventQueue* const eventQueue);
 
+// Post up to count events in order, returning how many fit
+size_t TSREventQueue_postN(TSREventQueue* const eventQueue, const Event* events, size_t count);
+
+// Pull up to maxCount of the oldest events, returning how many were pulled
+size_t TSREventQueue_pullN(TSREventQueue* const eventQueue, Event* events, size_t maxCount);
+
+// Block the consumer until the queue holds at least one event
+// Producers only make a system call to wake it while it is actually blocked
+void TSREventQueue_wait(TSREventQueue* const eventQueue);
+
 // Get the mutex associated with the event queue
 struct Mutex* TSREventQueue_getItsMutex(const TSREventQueue* const eventQueue);
 
@@ -43,6 +93,9 @@ void TSREventQueue_setItsMutex(TSREventQueue* const queue, struct Mutex* mutexPt
 // Create a new event queue instance
 TSREventQueue * TSREventQueue_Create(void);
 
+// Create a new event queue instance with room for capacity events
+TSREventQueue * TSREventQueue_CreateWithCapacity(size_t capacity);
+
 // Destroy an event queue instance
 void TSREventQueue_Destroy(TSREventQueue* const eventQueue);
 
@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TSRPriorityEventQueue.h"
+
+// Internal lane helpers (bounded MPMC ring with per-slot sequence numbers)
+static int laneInit(TSRLane* const lane, size_t capacity);
+static void laneCleanup(TSRLane* const lane);
+static int lanePush(TSRLane* const lane, Event event);
+static int lanePop(TSRLane* const lane, Event* event);
+
+// Initialize the queue with laneCount lanes of laneCapacity events each
+int TSRPriorityEventQueue_Init(TSRPriorityEventQueue* const queue, size_t laneCount, size_t laneCapacity) {
+    if (queue == NULL) {
+        return -1; // Fail gracefully if queue is null
+    }
+    memset(queue, 0, sizeof(*queue));
+    if (laneCount == 0 || laneCount > TSRPRIORITYQUEUE_MAX_LANES) {
+        return -1;
+    }
+
+    for (size_t lane = 0; lane < laneCount; lane++) {
+        if (laneInit(&queue->lanes[lane], laneCapacity) != 0) {
+            TSRPriorityEventQueue_Cleanup(queue);
+            return -1;
+        }
+    }
+    queue->laneCount = laneCount;
+
+    // Default mapping: flushes overtake data
+    for (int type = 0; type < TSRPRIORITYQUEUE_EVENT_TYPES; type++) {
+        size_t lane = (type == EVENDOFSTRING) ? TSRPRIORITYQUEUE_CONTROL_LANE : TSRPRIORITYQUEUE_DATA_LANE;
+        queue->laneOf[type] = (unsigned char)(lane < laneCount ? lane : laneCount - 1);
+    }
+    return 0;
+}
+
+// Cleanup the queue
+void TSRPriorityEventQueue_Cleanup(TSRPriorityEventQueue* const queue) {
+    if (queue == NULL) {
+        return;
+    }
+    for (size_t lane = 0; lane < TSRPRIORITYQUEUE_MAX_LANES; lane++) {
+        laneCleanup(&queue->lanes[lane]);
+    }
+    queue->laneCount = 0;
+}
+
+// Route an event type to a lane
+int TSRPriorityEventQueue_mapEventType(TSRPriorityEventQueue* const queue, EventType type, size_t lane) {
+    if (queue == NULL || (int)type < 0 || (int)type >= TSRPRIORITYQUEUE_EVENT_TYPES || lane >= queue->laneCount) {
+        return -1;
+    }
+    queue->laneOf[type] = (unsigned char)lane;
+    return 0;
+}
+
+// Post an event to the lane of its type
+int TSRPriorityEventQueue_post(TSRPriorityEventQueue* const queue, Event event) {
+    TSRLane* lane;
+
+    if (queue == NULL || queue->laneCount == 0 || (int)event.eType < 0 ||
+        (int)event.eType >= TSRPRIORITYQUEUE_EVENT_TYPES) {
+        return 0; // Fail if queue is null, uninitialized or the type is unknown
+    }
+
+    lane = &queue->lanes[queue->laneOf[event.eType]];
+    if (!lanePush(lane, event)) {
+        __atomic_fetch_add(&lane->dropped, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    postSignal(); // Signal that an event is present
+    return 1;
+}
+
+// Pull the oldest event of the highest-priority non-empty lane
+int TSRPriorityEventQueue_pull(TSRPriorityEventQueue* const queue, Event* event) {
+    if (queue == NULL || event == NULL) {
+        return 0;
+    }
+    for (size_t lane = 0; lane < queue->laneCount; lane++) {
+        if (lanePop(&queue->lanes[lane], event)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Check if every lane is empty
+int TSRPriorityEventQueue_isEmpty(TSRPriorityEventQueue* const queue) {
+    if (queue == NULL) {
+        return 1; // Consider null queue as empty
+    }
+    for (size_t lane = 0; lane < queue->laneCount; lane++) {
+        if (__atomic_load_n(&queue->lanes[lane].enqueuePos, __ATOMIC_ACQUIRE) !=
+            __atomic_load_n(&queue->lanes[lane].dequeuePos, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Read the counters of a lane
+int TSRPriorityEventQueue_getLaneStats(TSRPriorityEventQueue* const queue, size_t lane, TSRLaneStats* stats) {
+    const TSRLane* source;
+
+    if (queue == NULL || stats == NULL || lane >= queue->laneCount) {
+        return -1;
+    }
+    source = &queue->lanes[lane];
+    // Read pulled before posted so occupancy never comes out negative
+    stats->pulled = __atomic_load_n(&source->dequeuePos, __ATOMIC_ACQUIRE);
+    stats->posted = __atomic_load_n(&source->enqueuePos, __ATOMIC_ACQUIRE);
+    stats->occupancy = stats->posted - stats->pulled;
+    stats->capacity = source->mask + 1;
+    stats->dropped = __atomic_load_n(&source->dropped, __ATOMIC_RELAXED);
+    return 0;
+}
+
+// Create a new queue instance
+TSRPriorityEventQueue * TSRPriorityEventQueue_Create(size_t laneCount, size_t laneCapacity) {
+    TSRPriorityEventQueue* queue = (TSRPriorityEventQueue *) malloc(sizeof(TSRPriorityEventQueue));
+    if(queue != NULL && TSRPriorityEventQueue_Init(queue, laneCount, laneCapacity) != 0) {
+        free(queue);
+        queue = NULL;
+    }
+    return queue;
+}
+
+// Destroy a queue instance
+void TSRPriorityEventQueue_Destroy(TSRPriorityEventQueue* const queue) {
+    if(queue != NULL) {
+        TSRPriorityEventQueue_Cleanup(queue);
+    }
+    free(queue);
+}
+
+// Allocate a lane of at least capacity slots (rounded up to a power of two)
+// Slot i starts out ready for position i
+static int laneInit(TSRLane* const lane, size_t capacity) {
+    size_t slots = 2; // The sequence scheme needs at least two slots
+
+    if (capacity == 0 || capacity > SIZE_MAX / (2 * sizeof(TSRLaneCell))) {
+        return -1;
+    }
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    lane->cells = (TSRLaneCell *) malloc(slots * sizeof(TSRLaneCell));
+    if (lane->cells == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < slots; i++) {
+        lane->cells[i].sequence = i;
+    }
+    lane->mask = slots - 1;
+    lane->enqueuePos = 0;
+    lane->dequeuePos = 0;
+    lane->dropped = 0;
+    return 0;
+}
+
+// Free the slots of a lane
+static void laneCleanup(TSRLane* const lane) {
+    free(lane->cells);
+    lane->cells = NULL;
+    lane->mask = 0;
+}
+
+// Claim the next position with a CAS, fill its slot, then hand it to consumers
+// by advancing the slot's sequence. Positions are claimed in order, so events
+// from one producer keep their order.
+static int lanePush(TSRLane* const lane, Event event) {
+    size_t pos = __atomic_load_n(&lane->enqueuePos, __ATOMIC_RELAXED);
+    TSRLaneCell* cell;
+
+    for (;;) {
+        cell = &lane->cells[pos & lane->mask];
+        size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&lane->enqueuePos, &pos, pos + 1, 1, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+            // pos was reloaded by the failed CAS
+        } else if (diff < 0) {
+            return 0; // Slot still holds an event from one lap ago: full
+        } else {
+            pos = __atomic_load_n(&lane->enqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+    cell->event = event;
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Claim the oldest filled position, take its event, then free the slot for
+// the producer one lap ahead
+static int lanePop(TSRLane* const lane, Event* event) {
+    size_t pos = __atomic_load_n(&lane->dequeuePos, __ATOMIC_RELAXED);
+    TSRLaneCell* cell;
+
+    for (;;) {
+        cell = &lane->cells[pos & lane->mask];
+        size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&lane->dequeuePos, &pos, pos + 1, 1, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0; // Slot not filled yet: empty
+        } else {
+            pos = __atomic_load_n(&lane->dequeuePos, __ATOMIC_RELAXED);
+        }
+    }
+    *event = cell->event;
+    __atomic_store_n(&cell->sequence, pos + lane->mask + 1, __ATOMIC_RELEASE);
+    return 1;
+}
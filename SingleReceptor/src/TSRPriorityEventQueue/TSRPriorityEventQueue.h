@@ -0,0 +1,94 @@
+
+#ifndef TSRPriorityEventQueue_H
+#define TSRPriorityEventQueue_H
+
+#include <stddef.h>
+#include "../TokenizeAsyncSinglePkg/TokenizeAsyncSinglePkg.h"
+
+// Maximum number of lanes (one per event type at most)
+#define TSRPRIORITYQUEUE_MAX_LANES 4
+
+// Number of event types that can be mapped to lanes
+#define TSRPRIORITYQUEUE_EVENT_TYPES (EVENDOFSTRING + 1)
+
+// Lanes used by the default mapping: end-of-string overtakes everything else
+#define TSRPRIORITYQUEUE_CONTROL_LANE 0
+#define TSRPRIORITYQUEUE_DATA_LANE 1
+
+// Cache line size used to keep the producer and consumer positions of a lane apart
+#define TSRPRIORITYQUEUE_CACHE_LINE 64
+
+// Slot of a lane: the sequence number tells producers and consumers whose turn it is
+typedef struct TSRLaneCell {
+    size_t sequence;       // Position this slot is ready for
+    Event event;           // Stored event
+} TSRLaneCell;
+
+// Bounded lock-free multi-producer/multi-consumer FIFO holding one priority level
+typedef struct TSRLane {
+    size_t enqueuePos;     // Next position to claim for posting (= events posted)
+    char enqueuePad[TSRPRIORITYQUEUE_CACHE_LINE - sizeof(size_t)];
+    size_t dequeuePos;     // Next position to claim for pulling (= events pulled)
+    char dequeuePad[TSRPRIORITYQUEUE_CACHE_LINE - sizeof(size_t)];
+    TSRLaneCell* cells;    // capacity slots
+    size_t mask;           // capacity - 1
+    size_t dropped;        // Posts rejected because the lane was full
+    char statsPad[TSRPRIORITYQUEUE_CACHE_LINE - 3 * sizeof(size_t)];
+} TSRLane;
+
+// Counters of one lane (a snapshot; may be slightly stale under concurrent use)
+typedef struct TSRLaneStats {
+    size_t occupancy;      // Events currently queued
+    size_t capacity;       // Maximum number of queued events
+    size_t posted;         // Events accepted since Init
+    size_t pulled;         // Events removed since Init
+    size_t dropped;        // Events rejected because the lane was full
+} TSRLaneStats;
+
+// Event queue with priority lanes keyed by event type
+// Any number of threads may post and pull concurrently. Pull serves the lowest
+// numbered non-empty lane first, so control events overtake queued data; within a
+// lane events keep the order each producer posted them in.
+typedef struct TSRPriorityEventQueue TSRPriorityEventQueue;
+struct TSRPriorityEventQueue {
+    TSRLane lanes[TSRPRIORITYQUEUE_MAX_LANES];            // Lane 0 has the highest priority
+    size_t laneCount;                                      // Lanes in use
+    unsigned char laneOf[TSRPRIORITYQUEUE_EVENT_TYPES];   // Event type -> lane
+};
+
+// Initialize the queue with laneCount lanes of laneCapacity events each
+// laneCapacity is rounded up to a power of two; event types start on the default
+// mapping (EVENDOFSTRING on the control lane, everything else on the data lane;
+// with a single lane both share it)
+// Returns 0 on success, -1 on invalid arguments or allocation failure
+int TSRPriorityEventQueue_Init(TSRPriorityEventQueue* const queue, size_t laneCount, size_t laneCapacity);
+
+// Cleanup the queue
+void TSRPriorityEventQueue_Cleanup(TSRPriorityEventQueue* const queue);
+
+// Route an event type to a lane (configure before producers start)
+// Returns 0 on success, -1 on an unknown type or lane
+int TSRPriorityEventQueue_mapEventType(TSRPriorityEventQueue* const queue, EventType type, size_t lane);
+
+// Post an event to the lane of its type
+// Returns 1 on success, 0 if the lane is full (the event is dropped and counted)
+int TSRPriorityEventQueue_post(TSRPriorityEventQueue* const queue, Event event);
+
+// Pull the oldest event of the highest-priority non-empty lane into *event
+// Returns 1 if an event was pulled, 0 if all lanes were empty
+int TSRPriorityEventQueue_pull(TSRPriorityEventQueue* const queue, Event* event);
+
+// Check if every lane is empty
+int TSRPriorityEventQueue_isEmpty(TSRPriorityEventQueue* const queue);
+
+// Read the counters of a lane
+// Returns 0 on success, -1 on an unknown lane
+int TSRPriorityEventQueue_getLaneStats(TSRPriorityEventQueue* const queue, size_t lane, TSRLaneStats* stats);
+
+// Create a new queue instance
+TSRPriorityEventQueue * TSRPriorityEventQueue_Create(size_t laneCount, size_t laneCapacity);
+
+// Destroy a queue instance
+void TSRPriorityEventQueue_Destroy(TSRPriorityEventQueue* const queue);
+
+#endif
@@ -2,6 +2,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "TSRSyncSingleReceptor.h"
+#include "NumberScanner.h"
 
 // Enter GotNumber state: initialize tens place for fractional part
 void TokenizerSyncSingleReceptor_enter_GotNumber(TokenizerSyncSingleReceptor* const receptor) {
@@ -56,14 +57,12 @@ void TokenizerSyncSingleReceptor_Init(TokenizerSyncSingleReceptor* const recepto
     receptor->subStateID = NULL_SSTATE;
 }
 
-// Dispatch an event to the state machine
-// Handles digit, dot, whitespace, and end-of-string events
-void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* const receptor, Event event) {
-    if (receptor == NULL) {
-        return; // Fail gracefully if receptor is null
-    }
+// Run one event through the state machine without locking
+// Returns 1 and stores the value in *number when the event completes a number;
+// progress is printed only when verbose is set
+static int handleEvent(TokenizerSyncSingleReceptor* const receptor, Event event, int verbose, double* number) {
+    int completed = 0;
 
-    Mutex_lock(receptor->itsMutex);
     switch (event.eType) {
         case EVDIGIT:
             // Handle digit input
@@ -76,7 +75,9 @@ void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* cons
                     receptor->stateID = GOTNUMBER_STATE;
                     TokenizerSyncSingleReceptor_enter_ProcessingWholePart(receptor);
                     receptor->subStateID = PROCESSINGWHOLEPART_SSTATE;
-                    printf("Current value of result: %g\n", receptor->result);
+                    if (verbose) {
+                        printf("Current value of result: %g\n", receptor->result);
+                    }
                     break;
                 case GOTNUMBER_STATE:
                     // Already processing a number
@@ -86,7 +87,9 @@ void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* cons
                             TokenizerSyncSingleReceptor_exit_ProcessingWholePart(receptor);
                             receptor->ch = event.ed.c;
                             TokenizerSyncSingleReceptor_enter_ProcessingWholePart(receptor);
-                            printf("Current value of result: %g\n", receptor->result);
+                            if (verbose) {
+                                printf("Current value of result: %g\n", receptor->result);
+                            }
                             break;
                         case PROCESSINGFRACTIONALPART_SSTATE:
                             // Add digit to fractional part
@@ -95,7 +98,9 @@ void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* cons
                             receptor->result += digit(receptor->ch) / receptor->tensPlace;
                             receptor->tensPlace *= TENS_PLACE_INITIAL;
                             TokenizerSyncSingleReceptor_enter_ProcessingFractionalPart(receptor);
-                            printf("Current value of result: %g\n", receptor->result);
+                            if (verbose) {
+                                printf("Current value of result: %g\n", receptor->result);
+                            }
                             break;
                         case NULL_SSTATE:
                             // No substate, ignore
@@ -158,7 +163,11 @@ void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* cons
                             break;
                     }
                     TokenizerSyncSingleReceptor_exit_GotNumber(receptor);
-                    printf("Number: %g\n", receptor->result);
+                    *number = receptor->result;
+                    completed = 1;
+                    if (verbose) {
+                        printf("Number: %g\n", receptor->result);
+                    }
                     TokenizerSyncSingleReceptor_enter_NoNumber(receptor);
                     receptor->stateID = NONUMBER_STATE;
                     break;
@@ -171,7 +180,118 @@ void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* cons
             }
             break;
     }
+    return completed;
+}
+
+// Dispatch an event to the state machine
+// Handles digit, dot, whitespace, and end-of-string events
+void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* const receptor, Event event) {
+    double number;
+
+    if (receptor == NULL) {
+        return; // Fail gracefully if receptor is null
+    }
+
+    Mutex_lock(receptor->itsMutex);
+    (void)handleEvent(receptor, event, 1, &number);
+    Mutex_release(receptor->itsMutex);
+}
+
+// Dispatch a whole buffer of characters under a single lock
+// Digits, '.' and whitespace become EVDIGIT, EVDOT and EVWHITESPACE events; other
+// characters are ignored. Runs of digits and separators are consumed in bulk with
+// the NumberScanner kernel, so the state machine only steps at run edges. Completed
+// numbers go to out (the first cap of them); the return value counts all of them.
+// A number still in progress at the end of buf carries over to the next call.
+size_t TokenizerSyncSingleReceptor_dispatchBuffer(TokenizerSyncSingleReceptor* const receptor, const char* buf,
+                                                  size_t len, double* out, size_t cap) {
+    size_t count = 0;
+    double number;
+
+    if (receptor == NULL || buf == NULL) {
+        return 0; // Fail gracefully if receptor or buffer is null
+    }
+    if (out == NULL) {
+        cap = 0;
+    }
+
+    Mutex_lock(receptor->itsMutex);
+    for (size_t block = 0; block < len; block += NUMBERSCANNER_BLOCK_SIZE) {
+        NumberScanMasks masks;
+        const char* chunk = buf + block;
+        size_t chunkLen = NumberScanner_classify(chunk, len - block, &masks);
+
+        for (size_t i = 0; i < chunkLen; i++) {
+            size_t run = 0;
+            Event event;
+
+            // Skip separators while idle, accumulate digit runs while in a number
+            if (receptor->stateID == NONUMBER_STATE) {
+                run = NumberScanner_runLength(~(masks.digit | masks.dot), i, chunkLen);
+            } else if (receptor->stateID == GOTNUMBER_STATE) {
+                run = NumberScanner_runLength(masks.digit, i, chunkLen);
+                if (run == 0) {
+                    // Not a digit, handled as a single event below
+                } else if (receptor->subStateID == PROCESSINGWHOLEPART_SSTATE) {
+                    receptor->result = NumberScanner_appendWhole(receptor->result, chunk + i, run);
+                    receptor->ch = chunk[i + run - 1];
+                } else if (receptor->subStateID == PROCESSINGFRACTIONALPART_SSTATE) {
+                    receptor->result = NumberScanner_appendFraction(receptor->result, &receptor->tensPlace,
+                                                                    chunk + i, run);
+                    receptor->ch = chunk[i + run - 1];
+                } else {
+                    run = 0; // No substate, leave it to the state machine
+                }
+            }
+            if (run > 0) {
+                i += run - 1;
+                continue;
+            }
+
+            // Run edge: step the state machine for this one character
+            event.ed.c = chunk[i];
+            if ((masks.digit >> i) & 1u) {
+                event.eType = EVDIGIT;
+            } else if ((masks.dot >> i) & 1u) {
+                event.eType = EVDOT;
+            } else if ((masks.space >> i) & 1u) {
+                event.eType = EVWHITESPACE;
+            } else {
+                continue; // Ignore other characters
+            }
+            if (handleEvent(receptor, event, 0, &number)) {
+                if (count < cap) {
+                    out[count] = number;
+                }
+                count++;
+            }
+        }
+    }
     Mutex_release(receptor->itsMutex);
+    return count;
+}
+
+// Finish the number carried over from previous dispatchBuffer calls
+// Returns 1 and stores it in *out (if not NULL) when a number was in progress
+int TokenizerSyncSingleReceptor_flush(TokenizerSyncSingleReceptor* const receptor, double* out) {
+    Event event;
+    double number;
+    int completed;
+
+    if (receptor == NULL) {
+        return 0; // Fail gracefully if receptor is null
+    }
+
+    event.eType = EVENDOFSTRING;
+    event.ed.c = '\0';
+    Mutex_lock(receptor->itsMutex);
+    completed = handleEvent(receptor, event, 0, &number);
+    Mutex_release(receptor->itsMutex);
+
+    if (completed && out != NULL) {
+        *out = number;
+    }
+    return completed;
 }
 
 // Get the mutex associated with the state machine
@@ -1,5 +1,6 @@
 
 #include "../TokenizeAsyncSinglePkg/TokenizeAsyncSinglePkg.h"
+#include <stddef.h>
 #include <stdio.h>
 #include "../mutex/Mutex.h"
 
@@ -38,6 +39,13 @@ void TokenizerSyncSingleReceptor_exit_ProcessingWholePart(TokenizerSyncSingleRec
 void TokenizerSyncSingleReceptor_Init(TokenizerSyncSingleReceptor* const receptor);
 void TokenizerSyncSingleReceptor_Cleanup(TokenizerSyncSingleReceptor* const receptor);
 void TokenizerSyncSingleReceptor_eventDispatch(TokenizerSyncSingleReceptor* const receptor, Event event);
+
+// Bulk processing: dispatch a whole character buffer under one lock, returning the
+// number of completed numbers (the first cap are stored in out); flush finishes the
+// number left pending at the end of the stream
+size_t TokenizerSyncSingleReceptor_dispatchBuffer(TokenizerSyncSingleReceptor* const receptor, const char* buf,
+                                                  size_t len, double* out, size_t cap);
+int TokenizerSyncSingleReceptor_flush(TokenizerSyncSingleReceptor* const receptor, double* out);
 Mutex* TokenizerSyncSingleReceptor_getItsMutex(const TokenizerSyncSingleReceptor* const receptor);
 void TokenizerSyncSingleReceptor_setItsMutex(TokenizerSyncSingleReceptor* const receptor, Mutex* mutex);
 TokenizerSyncSingleReceptor* TokenizerSyncSingleReceptor_Create(void);
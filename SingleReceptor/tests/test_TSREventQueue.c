@@ -1,10 +1,22 @@
+#include <pthread.h>
 #include <unity.h>
 #include "../src/TSREventQueue/TSREventQueue.h"
 #include "../src/TokenizeAsyncSinglePkg/TokenizeAsyncSinglePkg.h"
+#include "../src/mutex/Mutex.h"
+
+#define THREADED_EVENT_COUNT 200000
+#define THREADED_BATCH 16
 
 void setUp(void) {}
 void tearDown(void) {}
 
+static Event makeEvent(size_t sequence) {
+    Event event;
+    event.eType = EVDIGIT;
+    event.ed.c = (char)('0' + sequence % 10);
+    return event;
+}
+
 void test_TSREventQueue_basic(void) {
     TSREventQueue queue;
     TSREventQueue_Init(&queue);
@@ -18,10 +30,139 @@ void test_TSREventQueue_basic(void) {
     TEST_ASSERT_EQUAL(EVDIGIT, pulled.eType);
     TEST_ASSERT_EQUAL('5', pulled.ed.c);
     TEST_ASSERT_TRUE(TSREventQueue_isEmpty(&queue));
+    TSREventQueue_Cleanup(&queue);
+}
+
+void test_TSREventQueue_capacity(void) {
+    TSREventQueue queue;
+    TEST_ASSERT_EQUAL(-1, TSREventQueue_InitWithCapacity(&queue, 0));
+    TEST_ASSERT_EQUAL(0, TSREventQueue_InitWithCapacity(&queue, 5));
+#ifdef TSREVENTQUEUE_SPSC
+    TEST_ASSERT_EQUAL(8, TSREventQueue_capacity(&queue)); // Rounded up to a power of two
+#else
+    TEST_ASSERT_EQUAL(5, TSREventQueue_capacity(&queue));
+#endif
+    TSREventQueue_Cleanup(&queue);
+    TEST_ASSERT_NULL(TSREventQueue_CreateWithCapacity(0));
+}
+
+void test_TSREventQueue_fill_and_drain(void) {
+    TSREventQueue* queue = TSREventQueue_CreateWithCapacity(8);
+    TEST_ASSERT_NOT_NULL(queue);
+    size_t capacity = TSREventQueue_capacity(queue);
+
+    // Every slot is usable, no more
+    for (size_t i = 0; i < capacity; i++) {
+        TEST_ASSERT_TRUE(TSREventQueue_post(queue, makeEvent(i)));
+    }
+    TEST_ASSERT_TRUE(TSREventQueue_isFull(queue));
+    TEST_ASSERT_FALSE(TSREventQueue_post(queue, makeEvent(capacity)));
+
+    for (size_t i = 0; i < capacity; i++) {
+        TEST_ASSERT_EQUAL(makeEvent(i).ed.c, TSREventQueue_pull(queue).ed.c);
+    }
+    TEST_ASSERT_TRUE(TSREventQueue_isEmpty(queue));
+    TSREventQueue_Destroy(queue);
+}
+
+void test_TSREventQueue_batches_wrap_around(void) {
+    TSREventQueue* queue = TSREventQueue_CreateWithCapacity(8);
+    Event in[5];
+    Event out[8];
+    size_t sequence = 0;
+
+    // Batches of 5 against 8 slots make every copy split at the ring end sooner or later
+    for (int round = 0; round < 20; round++) {
+        for (size_t i = 0; i < 5; i++) {
+            in[i] = makeEvent(sequence + i);
+        }
+        TEST_ASSERT_EQUAL(5, TSREventQueue_postN(queue, in, 5));
+        TEST_ASSERT_EQUAL(5, TSREventQueue_pullN(queue, out, 8));
+        for (size_t i = 0; i < 5; i++) {
+            TEST_ASSERT_EQUAL(in[i].ed.c, out[i].ed.c);
+        }
+        sequence += 5;
+    }
+    TEST_ASSERT_EQUAL(0, TSREventQueue_pullN(queue, out, 8));
+    TSREventQueue_Destroy(queue);
+}
+
+void test_TSREventQueue_postN_stops_when_full(void) {
+    TSREventQueue* queue = TSREventQueue_CreateWithCapacity(8);
+    size_t capacity = TSREventQueue_capacity(queue);
+    Event in[20];
+    Event out[20];
+
+    for (size_t i = 0; i < 20; i++) {
+        in[i] = makeEvent(i);
+    }
+    TEST_ASSERT_EQUAL(capacity, TSREventQueue_postN(queue, in, 20));
+    TEST_ASSERT_EQUAL(0, TSREventQueue_postN(queue, in, 20));
+    TEST_ASSERT_EQUAL(3, TSREventQueue_pullN(queue, out, 3));
+    TEST_ASSERT_EQUAL(3, TSREventQueue_postN(queue, in + capacity, 20 - capacity));
+    TEST_ASSERT_EQUAL(capacity, TSREventQueue_pullN(queue, out + 3, 20));
+    for (size_t i = 0; i < capacity + 3; i++) {
+        TEST_ASSERT_EQUAL(in[i].ed.c, out[i].ed.c);
+    }
+    TSREventQueue_Destroy(queue);
+}
+
+static void* producerThread(void* arg) {
+    TSREventQueue* queue = (TSREventQueue*)arg;
+    Event batch[THREADED_BATCH];
+    size_t sent = 0;
+
+    // Mix single posts and batches
+    while (sent < THREADED_EVENT_COUNT) {
+        if (sent % 3 == 0) {
+            sent += (size_t)TSREventQueue_post(queue, makeEvent(sent));
+        } else {
+            size_t count = THREADED_EVENT_COUNT - sent < THREADED_BATCH ? THREADED_EVENT_COUNT - sent : THREADED_BATCH;
+            for (size_t i = 0; i < count; i++) {
+                batch[i] = makeEvent(sent + i);
+            }
+            sent += TSREventQueue_postN(queue, batch, count);
+        }
+    }
+    return NULL;
+}
+
+void test_TSREventQueue_one_producer_one_consumer(void) {
+    TSREventQueue* queue = TSREventQueue_CreateWithCapacity(64);
+    Mutex mutex;
+    pthread_t producer;
+    Event batch[THREADED_BATCH];
+    size_t received = 0;
+    size_t mismatches = 0;
+
+    TEST_ASSERT_EQUAL(0, Mutex_init(&mutex));
+    TSREventQueue_setItsMutex(queue, &mutex); // Ignored in SPSC mode
+    TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, producerThread, queue));
+
+    // Block until events arrive, then drain what is there in one go
+    while (received < THREADED_EVENT_COUNT) {
+        TSREventQueue_wait(queue);
+        size_t count = TSREventQueue_pullN(queue, batch, THREADED_BATCH);
+        for (size_t i = 0; i < count; i++) {
+            mismatches += batch[i].ed.c != makeEvent(received + i).ed.c;
+        }
+        received += count;
+    }
+
+    pthread_join(producer, NULL);
+    TEST_ASSERT_EQUAL(0, mismatches);
+    TEST_ASSERT_TRUE(TSREventQueue_isEmpty(queue));
+    TSREventQueue_Destroy(queue);
+    Mutex_destroy(&mutex);
 }
 
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_TSREventQueue_basic);
+    RUN_TEST(test_TSREventQueue_capacity);
+    RUN_TEST(test_TSREventQueue_fill_and_drain);
+    RUN_TEST(test_TSREventQueue_batches_wrap_around);
+    RUN_TEST(test_TSREventQueue_postN_stops_when_full);
+    RUN_TEST(test_TSREventQueue_one_producer_one_consumer);
     return UNITY_END();
 }
@@ -0,0 +1,218 @@
+//
+// Throughput and latency benchmark for TSREventQueue
+//
+// Built twice by tests/CMakeLists.txt, once per queue mode (mutex and lock-free
+// SPSC), so the two runs can be compared side by side. Each run also checks
+// that every event arrives exactly once and in order.
+//
+// Categories:
+// - Throughput, one event per post/pull
+// - Throughput, batched postN/pullN
+// - Round-trip latency through two queues with blocking waits
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include "unity.h"
+#include "TSREventQueue.h"
+#include "TokenizeAsyncSinglePkg.h"
+#include "Mutex.h"
+
+#ifdef TSREVENTQUEUE_SPSC
+#define QUEUE_MODE "spsc"
+#else
+#define QUEUE_MODE "mutex"
+#endif
+
+#define THROUGHPUT_EVENTS 2000000
+#define BATCH_SIZE 32
+#define PING_PONG_ROUNDS 20000
+#define QUEUE_CAPACITY 64 // Fits both modes (the mutex queue holds at most QSIZE)
+
+// Test fixture: one queue per direction, each with its own mutex for the mutex mode
+static TSREventQueue* forward;
+static TSREventQueue* backward;
+static Mutex forwardMutex;
+static Mutex backwardMutex;
+
+void setUp(void) {
+    forward = TSREventQueue_CreateWithCapacity(QUEUE_CAPACITY);
+    backward = TSREventQueue_CreateWithCapacity(QUEUE_CAPACITY);
+    TEST_ASSERT_NOT_NULL(forward);
+    TEST_ASSERT_NOT_NULL(backward);
+    TEST_ASSERT_EQUAL_INT(0, Mutex_init(&forwardMutex));
+    TEST_ASSERT_EQUAL_INT(0, Mutex_init(&backwardMutex));
+    TSREventQueue_setItsMutex(forward, &forwardMutex);
+    TSREventQueue_setItsMutex(backward, &backwardMutex);
+}
+
+void tearDown(void) {
+    TSREventQueue_Destroy(forward);
+    TSREventQueue_Destroy(backward);
+    Mutex_destroy(&forwardMutex);
+    Mutex_destroy(&backwardMutex);
+}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds (threads run in parallel, so CPU time would mislead)
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Event carrying the low bits of a sequence number, for order checks
+ */
+static Event sequenceEvent(long sequence) {
+    Event event;
+    event.eType = EVDIGIT;
+    event.ed.c = (char)(sequence & 0x7f);
+    return event;
+}
+
+/**
+ * @brief Producer posting THROUGHPUT_EVENTS one at a time, yielding while the queue is full
+ */
+static void* singleProducer(void* arg) {
+    (void)arg;
+    for (long sent = 0; sent < THROUGHPUT_EVENTS;) {
+        if (TSREventQueue_post(forward, sequenceEvent(sent))) {
+            sent++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Producer posting THROUGHPUT_EVENTS in batches of BATCH_SIZE
+ */
+static void* batchProducer(void* arg) {
+    Event batch[BATCH_SIZE];
+
+    (void)arg;
+    for (long sent = 0; sent < THROUGHPUT_EVENTS;) {
+        size_t count = 0;
+        while (count < BATCH_SIZE && sent + (long)count < THROUGHPUT_EVENTS) {
+            batch[count] = sequenceEvent(sent + (long)count);
+            count++;
+        }
+        size_t posted = TSREventQueue_postN(forward, batch, count);
+        if (posted == 0) {
+            sched_yield();
+        }
+        sent += (long)posted;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Echo thread: returns every event from forward on backward
+ */
+static void* echoThread(void* arg) {
+    (void)arg;
+    for (long round = 0; round < PING_PONG_ROUNDS; round++) {
+        TSREventQueue_wait(forward);
+        Event event = TSREventQueue_pull(forward);
+        while (!TSREventQueue_post(backward, event)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void test_Performance_SingleEventThroughput(void) {
+    pthread_t producer;
+    long received = 0;
+    long outOfOrder = 0;
+
+    double start = nowNanos();
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, singleProducer, NULL));
+    while (received < THROUGHPUT_EVENTS) {
+        TSREventQueue_wait(forward);
+        while (!TSREventQueue_isEmpty(forward)) {
+            Event event = TSREventQueue_pull(forward);
+            outOfOrder += event.ed.c != sequenceEvent(received).ed.c;
+            received++;
+        }
+    }
+    pthread_join(producer, NULL);
+    double elapsed = nowNanos() - start;
+
+    printf("[%s] post/pull:   %.1f Mevents/s (%.1f ns/event)\n", QUEUE_MODE,
+           THROUGHPUT_EVENTS / elapsed * 1e3, elapsed / THROUGHPUT_EVENTS);
+    TEST_ASSERT_EQUAL_INT(0, outOfOrder);
+}
+
+void test_Performance_BatchThroughput(void) {
+    pthread_t producer;
+    Event batch[BATCH_SIZE];
+    long received = 0;
+    long outOfOrder = 0;
+
+    double start = nowNanos();
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, batchProducer, NULL));
+    while (received < THROUGHPUT_EVENTS) {
+        TSREventQueue_wait(forward);
+        size_t count = TSREventQueue_pullN(forward, batch, BATCH_SIZE);
+        for (size_t i = 0; i < count; i++) {
+            outOfOrder += batch[i].ed.c != sequenceEvent(received + (long)i).ed.c;
+        }
+        received += (long)count;
+    }
+    pthread_join(producer, NULL);
+    double elapsed = nowNanos() - start;
+
+    printf("[%s] postN/pullN: %.1f Mevents/s (%.1f ns/event, batches of %d)\n", QUEUE_MODE,
+           THROUGHPUT_EVENTS / elapsed * 1e3, elapsed / THROUGHPUT_EVENTS, BATCH_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, outOfOrder);
+}
+
+void test_Performance_RoundTripLatency(void) {
+    pthread_t echo;
+    long mismatches = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&echo, NULL, echoThread, NULL));
+    double start = nowNanos();
+    for (long round = 0; round < PING_PONG_ROUNDS; round++) {
+        TEST_ASSERT_TRUE(TSREventQueue_post(forward, sequenceEvent(round)));
+        TSREventQueue_wait(backward);
+        mismatches += TSREventQueue_pull(backward).ed.c != sequenceEvent(round).ed.c;
+    }
+    double elapsed = nowNanos() - start;
+    pthread_join(echo, NULL);
+
+    printf("[%s] round trip:  %.2f us (blocking waits on both sides)\n", QUEUE_MODE,
+           elapsed / PING_PONG_ROUNDS / 1e3);
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== TSREventQueue Benchmark (%s mode) ===\n", QUEUE_MODE);
+    RUN_TEST(test_Performance_SingleEventThroughput);
+    RUN_TEST(test_Performance_BatchThroughput);
+    RUN_TEST(test_Performance_RoundTripLatency);
+
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+#include <pthread.h>
+#include <sched.h>
+#include <unity.h>
+#include "../src/TSRPriorityEventQueue/TSRPriorityEventQueue.h"
+#include "../src/TokenizeAsyncSinglePkg/TokenizeAsyncSinglePkg.h"
+
+#define PRODUCERS 4
+#define CONSUMERS 2
+#define EVENTS_PER_PRODUCER 20000
+
+static TSRPriorityEventQueue* queue;
+
+void setUp(void) {
+    queue = TSRPriorityEventQueue_Create(2, 8);
+    TEST_ASSERT_NOT_NULL(queue);
+}
+
+void tearDown(void) {
+    TSRPriorityEventQueue_Destroy(queue);
+    queue = NULL;
+}
+
+static Event makeEvent(EventType type, char c) {
+    Event event;
+    event.eType = type;
+    event.ed.c = c;
+    return event;
+}
+
+// Tag an event with its producer (high nibble) and a sequence number (low nibble)
+static Event taggedEvent(int producer, long sequence) {
+    return makeEvent(EVDIGIT, (char)((producer << 4) | (int)(sequence & 0x0f)));
+}
+
+void test_priority_queue_should_reject_bad_arguments(void) {
+    TSRPriorityEventQueue other;
+    TEST_ASSERT_EQUAL(-1, TSRPriorityEventQueue_Init(&other, 0, 8));
+    TEST_ASSERT_EQUAL(-1, TSRPriorityEventQueue_Init(&other, TSRPRIORITYQUEUE_MAX_LANES + 1, 8));
+    TEST_ASSERT_EQUAL(-1, TSRPriorityEventQueue_Init(&other, 2, 0));
+    TEST_ASSERT_NULL(TSRPriorityEventQueue_Create(0, 8));
+    TEST_ASSERT_EQUAL(-1, TSRPriorityEventQueue_mapEventType(queue, EVDOT, 2));
+    TEST_ASSERT_EQUAL(-1, TSRPriorityEventQueue_getLaneStats(queue, 2, &(TSRLaneStats){0}));
+    TEST_ASSERT_EQUAL(0, TSRPriorityEventQueue_post(NULL, makeEvent(EVDIGIT, '1')));
+}
+
+void test_priority_queue_should_let_end_of_string_overtake_data(void) {
+    Event event;
+
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_post(queue, makeEvent(EVDIGIT, '1')));
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_post(queue, makeEvent(EVDOT, '.')));
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_post(queue, makeEvent(EVENDOFSTRING, '\0')));
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_post(queue, makeEvent(EVWHITESPACE, ' ')));
+
+    // Control first, then the data lane in posting order
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_EQUAL(EVENDOFSTRING, event.eType);
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_EQUAL(EVDIGIT, event.eType);
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_EQUAL(EVDOT, event.eType);
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_EQUAL(EVWHITESPACE, event.eType);
+    TEST_ASSERT_FALSE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_isEmpty(queue));
+}
+
+void test_priority_queue_should_follow_custom_mapping(void) {
+    Event event;
+
+    // Whitespace promoted to the control lane
+    TEST_ASSERT_EQUAL(0, TSRPriorityEventQueue_mapEventType(queue, EVWHITESPACE, TSRPRIORITYQUEUE_CONTROL_LANE));
+    TSRPriorityEventQueue_post(queue, makeEvent(EVDIGIT, '7'));
+    TSRPriorityEventQueue_post(queue, makeEvent(EVWHITESPACE, ' '));
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_pull(queue, &event));
+    TEST_ASSERT_EQUAL(EVWHITESPACE, event.eType);
+}
+
+void test_priority_queue_should_count_occupancy_and_drops(void) {
+    TSRLaneStats stats;
+
+    for (int i = 0; i < 10; i++) {
+        TSRPriorityEventQueue_post(queue, makeEvent(EVDIGIT, '0'));
+    }
+    TSRPriorityEventQueue_post(queue, makeEvent(EVENDOFSTRING, '\0'));
+
+    TEST_ASSERT_EQUAL(0, TSRPriorityEventQueue_getLaneStats(queue, TSRPRIORITYQUEUE_DATA_LANE, &stats));
+    TEST_ASSERT_EQUAL(8, stats.capacity);
+    TEST_ASSERT_EQUAL(8, stats.occupancy);
+    TEST_ASSERT_EQUAL(8, stats.posted);
+    TEST_ASSERT_EQUAL(2, stats.dropped);
+
+    // A full data lane does not block control traffic
+    TEST_ASSERT_EQUAL(0, TSRPriorityEventQueue_getLaneStats(queue, TSRPRIORITYQUEUE_CONTROL_LANE, &stats));
+    TEST_ASSERT_EQUAL(1, stats.occupancy);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+
+    Event event;
+    TSRPriorityEventQueue_pull(queue, &event);
+    TSRPriorityEventQueue_pull(queue, &event);
+    TSRPriorityEventQueue_getLaneStats(queue, TSRPRIORITYQUEUE_DATA_LANE, &stats);
+    TEST_ASSERT_EQUAL(7, stats.occupancy);
+    TEST_ASSERT_EQUAL(1, stats.pulled);
+}
+
+static void* producerThread(void* arg) {
+    int producer = (int)(size_t)arg;
+    for (long sent = 0; sent < EVENTS_PER_PRODUCER;) {
+        if (TSRPriorityEventQueue_post(queue, taggedEvent(producer, sent))) {
+            sent++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+typedef struct ConsumerResult {
+    long received;
+    long outOfOrder;
+} ConsumerResult;
+
+static long remaining;
+
+// Pull until every event has been taken; a sole consumer also checks that each
+// producer's events arrive in exactly the order they were posted
+static void* consumerThread(void* arg) {
+    ConsumerResult* result = (ConsumerResult*)arg;
+    int nextSequence[PRODUCERS] = {0};
+    Event event;
+
+    while (__atomic_load_n(&remaining, __ATOMIC_RELAXED) > 0) {
+        if (!TSRPriorityEventQueue_pull(queue, &event)) {
+            sched_yield();
+            continue;
+        }
+        __atomic_fetch_sub(&remaining, 1, __ATOMIC_RELAXED);
+        int producer = (event.ed.c >> 4) & 0x0f;
+        int sequence = event.ed.c & 0x0f;
+        if (sequence != nextSequence[producer]) {
+            result->outOfOrder++;
+        }
+        nextSequence[producer] = (sequence + 1) & 0x0f;
+        result->received++;
+    }
+    return NULL;
+}
+
+static void runProducersAndConsumers(int consumerCount, ConsumerResult* results) {
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+
+    TSRPriorityEventQueue_Destroy(queue);
+    queue = TSRPriorityEventQueue_Create(2, 256);
+    remaining = (long)PRODUCERS * EVENTS_PER_PRODUCER;
+
+    for (int c = 0; c < consumerCount; c++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&consumers[c], NULL, consumerThread, &results[c]));
+    }
+    for (int p = 0; p < PRODUCERS; p++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&producers[p], NULL, producerThread, (void*)(size_t)p));
+    }
+    for (int p = 0; p < PRODUCERS; p++) {
+        pthread_join(producers[p], NULL);
+    }
+    for (int c = 0; c < consumerCount; c++) {
+        pthread_join(consumers[c], NULL);
+    }
+}
+
+void test_priority_queue_should_keep_per_producer_order(void) {
+    ConsumerResult result = {0, 0};
+
+    runProducersAndConsumers(1, &result);
+    TEST_ASSERT_EQUAL((long)PRODUCERS * EVENTS_PER_PRODUCER, result.received);
+    TEST_ASSERT_EQUAL(0, result.outOfOrder);
+}
+
+void test_priority_queue_should_survive_many_producers_and_consumers(void) {
+    ConsumerResult results[CONSUMERS] = {{0, 0}};
+    TSRLaneStats stats;
+
+    runProducersAndConsumers(CONSUMERS, results);
+    TEST_ASSERT_EQUAL((long)PRODUCERS * EVENTS_PER_PRODUCER, results[0].received + results[1].received);
+    TSRPriorityEventQueue_getLaneStats(queue, TSRPRIORITYQUEUE_DATA_LANE, &stats);
+    TEST_ASSERT_EQUAL(0, stats.occupancy);
+    TEST_ASSERT_EQUAL(stats.posted, stats.pulled);
+    TEST_ASSERT_TRUE(TSRPriorityEventQueue_isEmpty(queue));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_queue_should_reject_bad_arguments);
+    RUN_TEST(test_priority_queue_should_let_end_of_string_overtake_data);
+    RUN_TEST(test_priority_queue_should_follow_custom_mapping);
+    RUN_TEST(test_priority_queue_should_count_occupancy_and_drops);
+    RUN_TEST(test_priority_queue_should_keep_per_producer_order);
+    RUN_TEST(test_priority_queue_should_survive_many_producers_and_consumers);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+//
+// Contention benchmark for TSRPriorityEventQueue
+//
+// 1 to 16 producer threads flood the data lane with EVDIGIT events while a probe
+// thread posts one EVENDOFSTRING at a time and a single consumer drains the queue.
+// For each producer count it reports data throughput and how long the flush took
+// to reach the consumer, once with the default control lane and once with
+// EVENDOFSTRING mapped onto the data lane (the behaviour of a single FIFO).
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include "unity.h"
+#include "TSRPriorityEventQueue.h"
+#include "TokenizeAsyncSinglePkg.h"
+
+#define MAX_PRODUCERS 16
+#define DATA_EVENTS 1000000L
+#define LANE_CAPACITY 4096
+#define PROBE_INTERVAL_NS 20000L
+
+static TSRPriorityEventQueue* queue;
+static long dataRemaining;      // Data events the consumer still has to pull
+static int probeInFlight;       // 1 while an EVENDOFSTRING is queued
+static double probePostedAt;    // When the queued EVENDOFSTRING was posted
+static double probeLatencySum;
+static long probeCount;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void* producerThread(void* arg) {
+    long quota = (long)(size_t)arg;
+    Event event = {EVDIGIT, {'5'}};
+
+    for (long sent = 0; sent < quota;) {
+        if (TSRPriorityEventQueue_post(queue, event)) {
+            sent++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// Posts one flush at a time, at most every PROBE_INTERVAL_NS, until the data is drained
+static void* probeThread(void* arg) {
+    Event flush = {EVENDOFSTRING, {'\0'}};
+    double next = nowNanos();
+
+    (void)arg;
+    while (__atomic_load_n(&dataRemaining, __ATOMIC_ACQUIRE) > 0) {
+        if (__atomic_load_n(&probeInFlight, __ATOMIC_ACQUIRE) || nowNanos() < next) {
+            sched_yield();
+            continue;
+        }
+        // A flush must not be lost: retry while its lane is full, timing from the first try
+        probePostedAt = nowNanos();
+        __atomic_store_n(&probeInFlight, 1, __ATOMIC_RELEASE);
+        while (!TSRPriorityEventQueue_post(queue, flush)) {
+            if (__atomic_load_n(&dataRemaining, __ATOMIC_ACQUIRE) == 0) {
+                return NULL;
+            }
+            sched_yield();
+        }
+        next = probePostedAt + PROBE_INTERVAL_NS;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run one round and print its numbers
+ * @param producers Number of producer threads
+ * @param controlLane Lane EVENDOFSTRING is mapped to
+ */
+static void runRound(int producers, size_t controlLane) {
+    pthread_t producerIds[MAX_PRODUCERS];
+    pthread_t probe;
+    TSRLaneStats stats;
+    Event event;
+
+    queue = TSRPriorityEventQueue_Create(2, LANE_CAPACITY);
+    TEST_ASSERT_NOT_NULL(queue);
+    TEST_ASSERT_EQUAL_INT(0, TSRPriorityEventQueue_mapEventType(queue, EVENDOFSTRING, controlLane));
+    dataRemaining = DATA_EVENTS;
+    probeInFlight = 0;
+    probeLatencySum = 0.0;
+    probeCount = 0;
+
+    double start = nowNanos();
+    for (int p = 0; p < producers; p++) {
+        long quota = DATA_EVENTS / producers + (p < DATA_EVENTS % producers ? 1 : 0);
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producerIds[p], NULL, producerThread, (void*)(size_t)quota));
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&probe, NULL, probeThread, NULL));
+
+    while (__atomic_load_n(&dataRemaining, __ATOMIC_RELAXED) > 0) {
+        if (!TSRPriorityEventQueue_pull(queue, &event)) {
+            sched_yield();
+        } else if (event.eType == EVENDOFSTRING) {
+            probeLatencySum += nowNanos() - probePostedAt;
+            probeCount++;
+            __atomic_store_n(&probeInFlight, 0, __ATOMIC_RELEASE);
+        } else {
+            __atomic_fetch_sub(&dataRemaining, 1, __ATOMIC_RELEASE);
+        }
+    }
+    double elapsed = nowNanos() - start;
+
+    for (int p = 0; p < producers; p++) {
+        pthread_join(producerIds[p], NULL);
+    }
+    pthread_join(probe, NULL);
+
+    TSRPriorityEventQueue_getLaneStats(queue, TSRPRIORITYQUEUE_DATA_LANE, &stats);
+    printf("  %2d producers, flush on %-7s lane: %6.2f Mevents/s, ", producers,
+           controlLane == TSRPRIORITYQUEUE_CONTROL_LANE ? "control" : "data", DATA_EVENTS / elapsed * 1e3);
+    if (probeCount > 0) {
+        printf("flush latency %8.1f us (%ld flushes)", probeLatencySum / probeCount / 1e3, probeCount);
+    } else {
+        printf("no flush got through the full lane");
+    }
+    printf(", full-lane rejects %zu\n", stats.dropped);
+    TEST_ASSERT_EQUAL(DATA_EVENTS, stats.pulled);
+
+    TSRPriorityEventQueue_Destroy(queue);
+}
+
+void test_Performance_ProducerContention(void) {
+    printf("\n=== TSRPriorityEventQueue Contention Benchmark ===\n");
+    for (int producers = 1; producers <= MAX_PRODUCERS; producers *= 2) {
+        runRound(producers, TSRPRIORITYQUEUE_CONTROL_LANE);
+        runRound(producers, TSRPRIORITYQUEUE_DATA_LANE);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Performance_ProducerContention);
+    return UNITY_END();
+}
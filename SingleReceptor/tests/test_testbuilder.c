@@ -1,3 +1,4 @@
+#include <string.h>
 #include <unity.h>
 #include "TokenizeAsyncSinglePkg.h"
 #include "TSREventQueue.h"
@@ -5,6 +6,13 @@
 #include "Mutex.h"
 
 #define EXPECTED_DIGIT_VALUE 7.0
+#define MAX_NUMBERS 32
+
+// Mixed input: short and long numbers (past 2^53), fractions, stray dots and
+// non-numeric characters, spanning several scanner blocks
+static const char BULK_INPUT[] = "12.5 3.25x 4 ..7 \t1234567890123456789.0123456789  9\n"
+                                 "0.000001 42. .5 7..8 abc 99999999999999999999 3.14159265358979\r\n"
+                                 "18014398509481985 1 22 333 4444 55555 666666 7777777 88888888 987654321";
 
 void setUp(void) {
     // Initialize before each test
@@ -51,6 +59,7 @@ void test_event_queue_should_handle_basic_operations(void) {
     TEST_ASSERT_EQUAL(EVDIGIT, pulled.eType);
     TEST_ASSERT_EQUAL('5', pulled.ed.c);
     TEST_ASSERT_TRUE(TSREventQueue_isEmpty(&queue));
+    TSREventQueue_Cleanup(&queue);
 }
 
 // Test single receptor pattern: only one receptor processes events sequentially
@@ -74,6 +83,73 @@ void test_single_receptor_pattern_should_process_digit_events(void) {
     TokenizerSyncSingleReceptor_Destroy(receptor);
 }
 
+// Tokenize a string one event at a time, collecting the values the receptor completes
+static size_t tokenize_per_event(const char* text, double* numbers) {
+    TokenizerSyncSingleReceptor* receptor = TokenizerSyncSingleReceptor_Create();
+    size_t count = 0;
+
+    for (size_t i = 0; i <= strlen(text); i++) {
+        Event event;
+        char c = text[i];
+
+        event.ed.c = c;
+        if (c >= '0' && c <= '9') {
+            event.eType = EVDIGIT;
+        } else if (c == '.') {
+            event.eType = EVDOT;
+        } else if (c == '\0') {
+            event.eType = EVENDOFSTRING;
+        } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f') {
+            event.eType = EVWHITESPACE;
+        } else {
+            continue;
+        }
+        if (receptor->stateID == GOTNUMBER_STATE && (event.eType == EVWHITESPACE || event.eType == EVENDOFSTRING)) {
+            numbers[count++] = receptor->result;
+        }
+        TokenizerSyncSingleReceptor_eventDispatch(receptor, event);
+    }
+    TokenizerSyncSingleReceptor_Destroy(receptor);
+    return count;
+}
+
+// Test bulk dispatch: a buffer must yield exactly the numbers per-event dispatch does
+void test_dispatch_buffer_should_match_per_event_dispatch(void) {
+    double expected[MAX_NUMBERS];
+    double actual[MAX_NUMBERS];
+    size_t expectedCount = tokenize_per_event(BULK_INPUT, expected);
+    TokenizerSyncSingleReceptor* receptor = TokenizerSyncSingleReceptor_Create();
+    size_t count = 0;
+    size_t len = strlen(BULK_INPUT);
+
+    // Feed in uneven pieces so numbers straddle buffer boundaries
+    for (size_t pos = 0; pos < len; pos += 7) {
+        size_t piece = (len - pos < 7) ? len - pos : 7;
+        count += TokenizerSyncSingleReceptor_dispatchBuffer(receptor, BULK_INPUT + pos, piece, actual + count,
+                                                            MAX_NUMBERS - count);
+    }
+    count += (size_t)TokenizerSyncSingleReceptor_flush(receptor, actual + count);
+
+    TEST_ASSERT_EQUAL(expectedCount, count);
+    // Bit-identical, not just close
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, count * sizeof(double));
+
+    TokenizerSyncSingleReceptor_Destroy(receptor);
+}
+
+// Test bulk dispatch reports every number even when the output array is too small
+void test_dispatch_buffer_should_count_numbers_past_capacity(void) {
+    TokenizerSyncSingleReceptor* receptor = TokenizerSyncSingleReceptor_Create();
+    double numbers[2] = {0.0, 0.0};
+
+    TEST_ASSERT_EQUAL(3, TokenizerSyncSingleReceptor_dispatchBuffer(receptor, "1 2.5 3 ", 8, numbers, 2));
+    TEST_ASSERT_EQUAL(1.0, numbers[0]);
+    TEST_ASSERT_EQUAL(2.5, numbers[1]);
+    TEST_ASSERT_EQUAL(0, TokenizerSyncSingleReceptor_flush(receptor, NULL));
+
+    TokenizerSyncSingleReceptor_Destroy(receptor);
+}
+
 // Test mutex functionality
 void test_mutex_should_initialize_and_work_correctly(void) {
     Mutex mutex;
@@ -107,5 +183,9 @@ int main(void) {
     RUN_TEST(test_event_queue_should_handle_basic_operations);
     RUN_TEST(test_single_receptor_pattern_should_process_digit_events);
 
+    // Test bulk buffer dispatch
+    RUN_TEST(test_dispatch_buffer_should_match_per_event_dispatch);
+    RUN_TEST(test_dispatch_buffer_should_count_numbers_past_capacity);
+
     return UNITY_END();
 }
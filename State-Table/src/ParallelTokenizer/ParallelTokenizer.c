@@ -0,0 +1,258 @@
+//
+// ParallelTokenizer Implementation
+//
+// Two passes over the chunks, each on its own set of threads:
+// 1. every worker tokenizes its chunk into a private, growing array;
+// 2. once the counts are known, every worker copies its array into its
+//    slice of the final result, so stitching is parallel too.
+//
+
+#define _POSIX_C_SOURCE 200112L  // posix_madvise
+
+#include "ParallelTokenizer.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * ============================================================================
+ * CHUNK JOBS
+ * ============================================================================
+ */
+
+typedef struct ChunkJob {
+    const char* begin;     // First character of the chunk
+    size_t len;            // Characters in the chunk
+    TokenizerMode mode;    // Engine to run
+    double* numbers;       // Private output of pass 1
+    size_t count;          // Numbers in the private output
+    size_t capacity;       // Room in the private output
+    double* destination;   // Where pass 2 copies the private output
+    int failed;            // Set when the private output could not grow
+} ChunkJob;
+
+static int reserve(ChunkJob* job, size_t needed) {
+    size_t capacity = job->capacity ? job->capacity : 1024;
+    double* numbers;
+
+    if (needed <= job->capacity) {
+        return 0;
+    }
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    numbers = realloc(job->numbers, capacity * sizeof(double));
+    if (numbers == NULL) {
+        return -1;
+    }
+    job->numbers = numbers;
+    job->capacity = capacity;
+    return 0;
+}
+
+// Pass 1: a private tokenizer over one chunk
+static void* tokenize_chunk(void* arg) {
+    ChunkJob* job = (ChunkJob*)arg;
+    NumberTokenizer tokenizer = {STATE_WAITING, 0.0, 10.0};
+    size_t offset = 0;
+
+    // A rough guess of one number per 8 bytes saves most regrowth
+    if (reserve(job, job->len / 8 + 1) != 0) {
+        job->failed = 1;
+        return NULL;
+    }
+    while (offset < job->len) {
+        size_t slice = job->len - offset;
+        if (slice > PARALLEL_TOKENIZER_SLICE) {
+            slice = PARALLEL_TOKENIZER_SLICE;
+        }
+        // Each finished number consumes at least one character of the slice
+        if (reserve(job, job->count + slice) != 0) {
+            job->failed = 1;
+            return NULL;
+        }
+        job->count += tokenize_buffer(&tokenizer, job->mode, job->begin + offset, slice,
+                                      job->numbers + job->count, job->capacity - job->count);
+        offset += slice;
+    }
+    // The chunk ends where a separator (or the input) ends the open number
+    if (reserve(job, job->count + 1) != 0) {
+        job->failed = 1;
+        return NULL;
+    }
+    job->count += (size_t)finish_buffer(&tokenizer, job->numbers + job->count);
+    return NULL;
+}
+
+// Pass 2: stitch the private output into place
+static void* copy_chunk(void* arg) {
+    ChunkJob* job = (ChunkJob*)arg;
+
+    if (job->count > 0) {
+        memcpy(job->destination, job->numbers, job->count * sizeof(double));
+    }
+    return NULL;
+}
+
+// Runs fn over every job, job 0 on the calling thread
+static int run_jobs(ChunkJob* jobs, int count, void* (*fn)(void*)) {
+    pthread_t threads[PARALLEL_TOKENIZER_MAX_THREADS];
+    int started = 1;
+    int status = 0;
+
+    while (started < count) {
+        if (pthread_create(&threads[started], NULL, fn, &jobs[started]) != 0) {
+            break;
+        }
+        started++;
+    }
+    // Jobs the pool could not start still run, just on this thread
+    for (int i = started; i < count; i++) {
+        fn(&jobs[i]);
+    }
+    fn(&jobs[0]);
+    for (int i = 1; i < started; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/*
+ * ============================================================================
+ * API
+ * ============================================================================
+ */
+
+size_t parallel_chunk_start(const char* buf, size_t len, size_t pos) {
+    while (pos < len) {
+        Event event = tokenizer_char_class(buf[pos]);
+        if (event == EVENT_SPACE || event == EVENT_END) {
+            break;
+        }
+        pos++;
+    }
+    return pos < len ? pos : len;
+}
+
+int parallel_tokenize_buffer(const char* buf, size_t len, int threads, TokenizerMode mode,
+                             TokenizedNumbers* result) {
+    ChunkJob jobs[PARALLEL_TOKENIZER_MAX_THREADS];
+    size_t start = 0;
+    size_t total = 0;
+    int status = 0;
+
+    if (result == NULL) {
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+    if ((buf == NULL && len > 0) || threads < 1 || threads > PARALLEL_TOKENIZER_MAX_THREADS) {
+        return -1;
+    }
+
+    // Even split, each cut pushed forward to the next separator
+    memset(jobs, 0, sizeof(jobs));
+    for (int i = 0; i < threads; i++) {
+        size_t end = (i == threads - 1)
+                   ? len
+                   : parallel_chunk_start(buf, len, len / (size_t)threads * (size_t)(i + 1));
+        if (end < start) {
+            end = start;
+        }
+        jobs[i].begin = buf + start;
+        jobs[i].len = end - start;
+        jobs[i].mode = mode;
+        start = end;
+    }
+
+    if (run_jobs(jobs, threads, tokenize_chunk) != 0) {
+        status = -1;
+    }
+    for (int i = 0; i < threads; i++) {
+        if (jobs[i].failed) {
+            status = -1;
+        }
+        total += jobs[i].count;
+    }
+
+    if (status == 0) {
+        result->numbers = malloc((total ? total : 1) * sizeof(double));
+        if (result->numbers == NULL) {
+            status = -1;
+        }
+    }
+    if (status == 0) {
+        double* destination = result->numbers;
+        for (int i = 0; i < threads; i++) {
+            jobs[i].destination = destination;
+            destination += jobs[i].count;
+        }
+        status = run_jobs(jobs, threads, copy_chunk);
+    }
+
+    for (int i = 0; i < threads; i++) {
+        free(jobs[i].numbers);
+    }
+    if (status != 0) {
+        free(result->numbers);
+        result->numbers = NULL;
+        return -1;
+    }
+    result->count = total;
+    result->bytes = len;
+    return 0;
+}
+
+int parallel_tokenize_file(const char* path, int threads, TokenizerMode mode,
+                           TokenizedNumbers* result) {
+    struct stat info;
+    void* map;
+    int fd;
+    int status;
+
+    if (result == NULL) {
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+    if (path == NULL) {
+        return -1;
+    }
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (info.st_size == 0) {
+        close(fd);
+        return parallel_tokenize_buffer("", 0, threads, mode, result);  // mmap rejects length 0
+    }
+
+    map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    // Every worker streams forward through its own chunk
+    posix_madvise(map, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+
+    status = parallel_tokenize_buffer((const char*)map, (size_t)info.st_size, threads, mode, result);
+    munmap(map, (size_t)info.st_size);
+    return status;
+}
+
+void free_tokenized_numbers(TokenizedNumbers* result) {
+    if (result != NULL) {
+        free(result->numbers);
+        result->numbers = NULL;
+        result->count = 0;
+        result->bytes = 0;
+    }
+}
@@ -0,0 +1,101 @@
+//
+// ParallelTokenizer Header File
+//
+// This header defines a parallel front end for the tokenizer state machine.
+// A large input (usually a memory-mapped file) is cut into one chunk per
+// worker thread, each chunk is tokenized by its own NumberTokenizer, and the
+// per-chunk numbers are stitched back together in input order.
+//
+// Chunks only ever start on a separator character (anything that is not a
+// digit or '.'), where every state of the table goes back to STATE_WAITING.
+// A number can therefore never straddle two chunks, and the result is
+// exactly what one tokenizer would produce over the whole input.
+//
+
+#ifndef PARALLELTOKENIZER_H
+#define PARALLELTOKENIZER_H
+
+#include <stddef.h>
+#include "TokenizerStateTable.h"
+
+/*
+ * ============================================================================
+ * CONFIGURATION
+ * ============================================================================
+ */
+
+/**
+ * @brief Largest number of worker threads (and chunks) per call
+ */
+#define PARALLEL_TOKENIZER_MAX_THREADS 64
+
+/**
+ * @brief Bytes handed to tokenize_buffer per call inside a chunk
+ *
+ * Keeps the output headroom each worker reserves small.
+ */
+#define PARALLEL_TOKENIZER_SLICE (64u * 1024u)
+
+/*
+ * ============================================================================
+ * RESULT
+ * ============================================================================
+ */
+
+/**
+ * @brief Every number found in the input, in input order
+ */
+typedef struct TokenizedNumbers {
+    double* numbers;  // Owned by the caller, release with free_tokenized_numbers
+    size_t count;     // Numbers found
+    size_t bytes;     // Input bytes tokenized
+} TokenizedNumbers;
+
+/*
+ * ============================================================================
+ * API
+ * ============================================================================
+ */
+
+/**
+ * @brief Tokenize a buffer on several threads
+ * @param buf Characters to process (need not be NUL-terminated)
+ * @param len Number of characters in buf
+ * @param threads Worker threads to use, 1 .. PARALLEL_TOKENIZER_MAX_THREADS
+ * @param mode Engine each worker runs (see TokenizerMode)
+ * @param result Receives the numbers; zeroed on failure
+ * @return 0 on success, -1 on bad arguments or allocation/thread failure
+ *
+ * The buffer is treated as one string: the last number is finished at the
+ * end of buf, as process_string does with its end-of-string event.
+ */
+int parallel_tokenize_buffer(const char* buf, size_t len, int threads, TokenizerMode mode,
+                             TokenizedNumbers* result);
+
+/**
+ * @brief Memory-map a file and tokenize it on several threads
+ * @param path File to read
+ * @param threads Worker threads to use, 1 .. PARALLEL_TOKENIZER_MAX_THREADS
+ * @param mode Engine each worker runs (see TokenizerMode)
+ * @param result Receives the numbers; zeroed on failure
+ * @return 0 on success, -1 if the file cannot be mapped or tokenizing fails
+ */
+int parallel_tokenize_file(const char* path, int threads, TokenizerMode mode,
+                           TokenizedNumbers* result);
+
+/**
+ * @brief Release the numbers of a successful call
+ * @param result Result to release (can be NULL)
+ */
+void free_tokenized_numbers(TokenizedNumbers* result);
+
+/**
+ * @brief Find where a chunk that should start at pos may start
+ * @param buf Input characters
+ * @param len Number of characters in buf
+ * @param pos Preferred start
+ * @return The first index >= pos holding a separator, or len if none does
+ */
+size_t parallel_chunk_start(const char* buf, size_t len, size_t pos);
+
+#endif // PARALLELTOKENIZER_H
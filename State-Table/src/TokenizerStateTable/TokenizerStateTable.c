@@ -13,97 +13,85 @@
  */
 
 #include "TokenizerStateTable.h"
+#include "NumberScanner.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// === HELPER FUNCTIONS ===
+// === SHARED TABLES ===
+// Built by the compiler into read-only memory and shared by every tokenizer,
+// so creating one costs no table setup and no per-instance copy.
 
 /**
- * @brief Convert a character to an event type
- * @param ch The character to classify
- * @return The corresponding event type
+ * @brief Event for every possible byte value
+ * 
+ * Digits and '.' have their own events, '\0' ends the input and everything
+ * else (whitespace and unknown characters alike) counts as a space.
  */
-static Event char_to_event(char ch) {
-    if (ch >= '0' && ch <= '9') {
-        return EVENT_DIGIT;
-    } else if (ch == '.') {
-        return EVENT_DOT;
-    } else if (ch == ' ' || ch == '\t' || ch == '\n') {
-        return EVENT_SPACE;
-    } else if (ch == '\0') {
-        return EVENT_END;
-    } else {
-        return EVENT_SPACE; // Treat unknown chars as whitespace
-    }
-}
+#define SP EVENT_SPACE
+#define SPACE_ROW SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP
+static const unsigned char char_class[256] = {
+    EVENT_END, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP,        // 0x00
+    SPACE_ROW,                                                                 // 0x10
+    SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, SP, EVENT_DOT, SP,     // 0x20: '.'
+    EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT,           // 0x30: '0'-'9'
+    EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT, EVENT_DIGIT,
+    SP, SP, SP, SP, SP, SP,
+    SPACE_ROW, SPACE_ROW, SPACE_ROW, SPACE_ROW,                                // 0x40-0x7f
+    SPACE_ROW, SPACE_ROW, SPACE_ROW, SPACE_ROW,                                // 0x80-0xff
+    SPACE_ROW, SPACE_ROW, SPACE_ROW, SPACE_ROW
+};
+#undef SPACE_ROW
+#undef SP
 
 /**
- * @brief Initialize the state transition table
- * @param tokenizer The tokenizer whose table to initialize
+ * @brief The state transition table: transitions[currentState][event]
  * 
  * This is where we define the "rules" of our state machine.
  * Reading this table should tell you exactly how the tokenizer behaves.
  */
-static void setup_state_table(NumberTokenizer* tokenizer) {
-    StateTableEntry* table = &tokenizer->stateTable[0][0];
-    
-    // Clear the entire table first
-    memset(table, 0, sizeof(tokenizer->stateTable));
-    
-    // === STATE_WAITING transitions ===
-    
-    // WAITING + DIGIT → start a new number
-    tokenizer->stateTable[STATE_WAITING][EVENT_DIGIT].nextState = STATE_WHOLE;
-    tokenizer->stateTable[STATE_WAITING][EVENT_DIGIT].action = action_start_number;
-    
-    // WAITING + DOT → start a decimal number (like ".5")
-    tokenizer->stateTable[STATE_WAITING][EVENT_DOT].nextState = STATE_DECIMAL;
-    tokenizer->stateTable[STATE_WAITING][EVENT_DOT].action = action_start_decimal;
-    
-    // WAITING + SPACE → stay waiting (ignore whitespace)
-    tokenizer->stateTable[STATE_WAITING][EVENT_SPACE].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_WAITING][EVENT_SPACE].action = NULL; // No action needed
-    
-    // WAITING + END → stay waiting (nothing to do)
-    tokenizer->stateTable[STATE_WAITING][EVENT_END].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_WAITING][EVENT_END].action = NULL;
-    
-    // === STATE_WHOLE transitions ===
-    
-    // WHOLE + DIGIT → add another digit to whole part
-    tokenizer->stateTable[STATE_WHOLE][EVENT_DIGIT].nextState = STATE_WHOLE;
-    tokenizer->stateTable[STATE_WHOLE][EVENT_DIGIT].action = action_add_digit;
-    
-    // WHOLE + DOT → start decimal part
-    tokenizer->stateTable[STATE_WHOLE][EVENT_DOT].nextState = STATE_DECIMAL;
-    tokenizer->stateTable[STATE_WHOLE][EVENT_DOT].action = action_start_decimal;
-    
-    // WHOLE + SPACE → finish number, go back to waiting
-    tokenizer->stateTable[STATE_WHOLE][EVENT_SPACE].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_WHOLE][EVENT_SPACE].action = action_finish_number;
-    
-    // WHOLE + END → finish number, go back to waiting
-    tokenizer->stateTable[STATE_WHOLE][EVENT_END].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_WHOLE][EVENT_END].action = action_finish_number;
-    
-    // === STATE_DECIMAL transitions ===
-    
-    // DECIMAL + DIGIT → add digit to decimal part
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_DIGIT].nextState = STATE_DECIMAL;
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_DIGIT].action = action_add_decimal_digit;
-    
-    // DECIMAL + DOT → error! Can't have two dots (treat as space)
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_DOT].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_DOT].action = action_finish_number;
-    
-    // DECIMAL + SPACE → finish number, go back to waiting
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_SPACE].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_SPACE].action = action_finish_number;
-    
-    // DECIMAL + END → finish number, go back to waiting
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_END].nextState = STATE_WAITING;
-    tokenizer->stateTable[STATE_DECIMAL][EVENT_END].action = action_finish_number;
+static const TokenizerTransition transitions[3][4] = {
+    [STATE_WAITING] = {
+        [EVENT_DIGIT] = {STATE_WHOLE,   TOKENIZER_ACTION_START_NUMBER},   // start a new number
+        [EVENT_DOT]   = {STATE_DECIMAL, TOKENIZER_ACTION_START_DECIMAL},  // a decimal like ".5"
+        [EVENT_SPACE] = {STATE_WAITING, TOKENIZER_ACTION_NONE},           // ignore whitespace
+        [EVENT_END]   = {STATE_WAITING, TOKENIZER_ACTION_NONE},           // nothing to do
+    },
+    [STATE_WHOLE] = {
+        [EVENT_DIGIT] = {STATE_WHOLE,   TOKENIZER_ACTION_ADD_DIGIT},      // another whole digit
+        [EVENT_DOT]   = {STATE_DECIMAL, TOKENIZER_ACTION_START_DECIMAL},  // start decimal part
+        [EVENT_SPACE] = {STATE_WAITING, TOKENIZER_ACTION_FINISH_NUMBER},  // number done
+        [EVENT_END]   = {STATE_WAITING, TOKENIZER_ACTION_FINISH_NUMBER},
+    },
+    [STATE_DECIMAL] = {
+        [EVENT_DIGIT] = {STATE_DECIMAL, TOKENIZER_ACTION_ADD_DECIMAL_DIGIT},
+        [EVENT_DOT]   = {STATE_WAITING, TOKENIZER_ACTION_FINISH_NUMBER},  // two dots: treat as space
+        [EVENT_SPACE] = {STATE_WAITING, TOKENIZER_ACTION_FINISH_NUMBER},
+        [EVENT_END]   = {STATE_WAITING, TOKENIZER_ACTION_FINISH_NUMBER},
+    },
+};
+
+/**
+ * @brief The printing action for each code, used only by process_character
+ */
+static const ActionFunction traced_actions[TOKENIZER_ACTION_COUNT] = {
+    [TOKENIZER_ACTION_NONE]              = NULL,
+    [TOKENIZER_ACTION_START_NUMBER]      = action_start_number,
+    [TOKENIZER_ACTION_ADD_DIGIT]         = action_add_digit,
+    [TOKENIZER_ACTION_START_DECIMAL]     = action_start_decimal,
+    [TOKENIZER_ACTION_ADD_DECIMAL_DIGIT] = action_add_decimal_digit,
+    [TOKENIZER_ACTION_FINISH_NUMBER]     = action_finish_number,
+};
+
+const TokenizerTransition* tokenizer_transition(State state, Event event) {
+    if ((unsigned)state > STATE_DECIMAL || (unsigned)event > EVENT_END) {
+        return NULL;
+    }
+    return &transitions[state][event];
+}
+
+Event tokenizer_char_class(char ch) {
+    return (Event)char_class[(unsigned char)ch];
 }
 
 // === CONSTRUCTION AND DESTRUCTION ===
@@ -114,14 +102,11 @@ NumberTokenizer* create_tokenizer(void) {
         return NULL; // Memory allocation failed
     }
     
-    // Initialize the tokenizer state
+    // Initialize the tokenizer state; the transition table is shared
     tokenizer->currentState = STATE_WAITING;
     tokenizer->result = 0.0;
     tokenizer->decimalPlace = 10.0;
     
-    // Set up the state transition table
-    setup_state_table(tokenizer);
-    
     return tokenizer;
 }
 
@@ -139,10 +124,11 @@ void process_character(NumberTokenizer* tokenizer, char ch) {
     }
     
     // Convert character to event
-    Event event = char_to_event(ch);
+    Event event = tokenizer_char_class(ch);
     
     // Look up what to do in the state table
-    StateTableEntry* entry = &tokenizer->stateTable[tokenizer->currentState][event];
+    const TokenizerTransition* entry = &transitions[tokenizer->currentState][event];
+    ActionFunction action = traced_actions[entry->action];
     
     // Debug output (can be removed for production)
     printf("State: %s, Event: %s ('%c') -> ", 
@@ -151,12 +137,12 @@ void process_character(NumberTokenizer* tokenizer, char ch) {
            ch == '\0' ? '0' : ch);
     
     // Execute the action if there is one
-    if (entry->action != NULL) {
-        entry->action(tokenizer, ch);
+    if (action != NULL) {
+        action(tokenizer, ch);
     }
     
     // Change to the new state
-    tokenizer->currentState = entry->nextState;
+    tokenizer->currentState = (State)entry->nextState;
     
     // Debug output continued
     printf("Next State: %s\n", state_to_string(tokenizer->currentState));
@@ -180,6 +166,247 @@ void process_string(NumberTokenizer* tokenizer, const char* input) {
     printf("String processing complete.\n\n");
 }
 
+/**
+ * @brief Silent counterpart of the table actions, used by the buffer engines
+ * @param tokenizer The tokenizer to update
+ * @param action The TokenizerAction from the transition table
+ * @param ch The character that triggered it
+ * @param finished Receives the number when the action finishes one
+ * @return 1 if the action finished a number, 0 otherwise
+ */
+static inline int run_action_quietly(NumberTokenizer* tokenizer, unsigned char action, char ch, double* finished) {
+    switch (action) {
+        case TOKENIZER_ACTION_START_NUMBER:
+            tokenizer->result = (double)(ch - '0');
+            tokenizer->decimalPlace = 10.0;
+            break;
+        case TOKENIZER_ACTION_ADD_DIGIT:
+            tokenizer->result = tokenizer->result * 10.0 + (ch - '0');
+            break;
+        case TOKENIZER_ACTION_START_DECIMAL:
+            tokenizer->decimalPlace = 10.0;
+            break;
+        case TOKENIZER_ACTION_ADD_DECIMAL_DIGIT:
+            tokenizer->result += (ch - '0') / tokenizer->decimalPlace;
+            tokenizer->decimalPlace *= 10.0;
+            break;
+        case TOKENIZER_ACTION_FINISH_NUMBER:
+            *finished = tokenizer->result;
+            tokenizer->result = 0.0;
+            tokenizer->decimalPlace = 10.0;
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/**
+ * @brief TOKENIZER_MODE_TABLE: one shared-table lookup per character
+ */
+static size_t process_buffer_table(NumberTokenizer* tokenizer, const char* buf, size_t len, double* out, size_t cap) {
+    NumberTokenizer local = *tokenizer;  // keep the hot state in registers
+    size_t count = 0;
+    double finished;
+
+    for (size_t i = 0; i < len; i++) {
+        const TokenizerTransition* entry = &transitions[local.currentState][char_class[(unsigned char)buf[i]]];
+        if (run_action_quietly(&local, entry->action, buf[i], &finished)) {
+            if (count < cap) {
+                out[count] = finished;
+            }
+            count++;
+        }
+        local.currentState = (State)entry->nextState;
+    }
+    *tokenizer = local;
+    return count;
+}
+
+/**
+ * @brief TOKENIZER_MODE_COMPILED: the transition table written out as code
+ * 
+ * Each state is a label and each transition a goto, so the current state is
+ * where the program counter is. The switch only picks the entry label for a
+ * state carried over from the previous call. Must stay in step with
+ * transitions[][] above; the unit tests compare the two on the same input.
+ */
+static size_t process_buffer_compiled(NumberTokenizer* tokenizer, const char* buf, size_t len, double* out,
+                                      size_t cap) {
+    const char* p = buf;
+    const char* end = buf + len;
+    double result = tokenizer->result;
+    double place = tokenizer->decimalPlace;
+    size_t count = 0;
+    State state;
+    unsigned char event;
+
+#define EMIT_NUMBER()              \
+    do {                           \
+        if (count < cap) {         \
+            out[count] = result;   \
+        }                          \
+        count++;                   \
+        result = 0.0;              \
+        place = 10.0;              \
+    } while (0)
+
+    switch (tokenizer->currentState) {
+        case STATE_WHOLE:   goto whole;
+        case STATE_DECIMAL: goto decimal;
+        default:            goto waiting;
+    }
+
+waiting:
+    while (p < end) {
+        event = char_class[(unsigned char)*p];
+        if (event == EVENT_DIGIT) {
+            result = (double)(*p++ - '0');
+            place = 10.0;
+            goto whole;
+        }
+        p++;
+        if (event == EVENT_DOT) {
+            place = 10.0;
+            goto decimal;
+        }
+    }
+    state = STATE_WAITING;
+    goto done;
+
+whole:
+    while (p < end) {
+        event = char_class[(unsigned char)*p];
+        if (event == EVENT_DIGIT) {
+            result = result * 10.0 + (*p++ - '0');
+            continue;
+        }
+        p++;
+        if (event == EVENT_DOT) {
+            place = 10.0;
+            goto decimal;
+        }
+        EMIT_NUMBER();
+        goto waiting;
+    }
+    state = STATE_WHOLE;
+    goto done;
+
+decimal:
+    while (p < end) {
+        event = char_class[(unsigned char)*p];
+        if (event == EVENT_DIGIT) {
+            result += (*p++ - '0') / place;
+            place *= 10.0;
+            continue;
+        }
+        p++;
+        EMIT_NUMBER();
+        goto waiting;
+    }
+    state = STATE_DECIMAL;
+
+done:
+#undef EMIT_NUMBER
+    tokenizer->currentState = state;
+    tokenizer->result = result;
+    tokenizer->decimalPlace = place;
+    return count;
+}
+
+size_t process_buffer(NumberTokenizer* tokenizer, const char* buf, size_t len, double* out, size_t cap) {
+    size_t count = 0;
+
+    if (tokenizer == NULL || buf == NULL) {
+        return 0;
+    }
+    if (out == NULL) {
+        cap = 0;
+    }
+
+    for (size_t block = 0; block < len; block += NUMBERSCANNER_BLOCK_SIZE) {
+        NumberScanMasks masks;
+        const char* chunk = buf + block;
+        size_t chunkLen = NumberScanner_classify(chunk, len - block, &masks);
+
+        for (size_t i = 0; i < chunkLen; i++) {
+            size_t run = 0;
+            const TokenizerTransition* entry;
+            Event event;
+            double finished;
+
+            // Bulk part: skip separators while waiting, absorb digit runs inside a number.
+            // Unknown characters count as spaces, so everything but digits and dots is skipped.
+            if (tokenizer->currentState == STATE_WAITING) {
+                run = NumberScanner_runLength(~(masks.digit | masks.dot), i, chunkLen);
+            } else {
+                run = NumberScanner_runLength(masks.digit, i, chunkLen);
+                if (run > 0 && tokenizer->currentState == STATE_WHOLE) {
+                    tokenizer->result = NumberScanner_appendWhole(tokenizer->result, chunk + i, run);
+                } else if (run > 0) {
+                    tokenizer->result = NumberScanner_appendFraction(tokenizer->result, &tokenizer->decimalPlace,
+                                                                     chunk + i, run);
+                }
+            }
+            if (run > 0) {
+                i += run - 1;
+                continue;
+            }
+
+            // Run edge: one ordinary table lookup
+            if ((masks.digit >> i) & 1u) {
+                event = EVENT_DIGIT;
+            } else if ((masks.dot >> i) & 1u) {
+                event = EVENT_DOT;
+            } else {
+                event = EVENT_SPACE; // '\0' inside a buffer behaves the same way
+            }
+            entry = &transitions[tokenizer->currentState][event];
+            if (run_action_quietly(tokenizer, entry->action, chunk[i], &finished)) {
+                if (count < cap) {
+                    out[count] = finished;
+                }
+                count++;
+            }
+            tokenizer->currentState = (State)entry->nextState;
+        }
+    }
+    return count;
+}
+
+size_t tokenize_buffer(NumberTokenizer* tokenizer, TokenizerMode mode, const char* buf, size_t len,
+                       double* out, size_t cap) {
+    if (tokenizer == NULL || buf == NULL) {
+        return 0;
+    }
+    if (out == NULL) {
+        cap = 0;
+    }
+    switch (mode) {
+        case TOKENIZER_MODE_TABLE:    return process_buffer_table(tokenizer, buf, len, out, cap);
+        case TOKENIZER_MODE_COMPILED: return process_buffer_compiled(tokenizer, buf, len, out, cap);
+        default:                      return process_buffer(tokenizer, buf, len, out, cap);
+    }
+}
+
+int finish_buffer(NumberTokenizer* tokenizer, double* out) {
+    const TokenizerTransition* entry;
+    double finished;
+    int completed;
+
+    if (tokenizer == NULL) {
+        return 0;
+    }
+
+    entry = &transitions[tokenizer->currentState][EVENT_END];
+    completed = run_action_quietly(tokenizer, entry->action, '\0', &finished);
+    tokenizer->currentState = (State)entry->nextState;
+    if (completed && out != NULL) {
+        *out = finished;
+    }
+    return completed;
+}
+
 // === ACTION FUNCTIONS ===
 // These are the functions that actually DO things when state transitions happen.
 // They're much simpler than the original version.
@@ -18,13 +18,55 @@
 #ifndef STATE_TABLE_TOKENIZERSTATETABLE_H
 #define STATE_TABLE_TOKENIZERSTATETABLE_H
 
+#include <stddef.h>
 #include "StateTablePattern.h"
 
+/**
+ * @brief What a transition does, as a small code instead of a function pointer
+ * 
+ * The silent engines switch on the code directly; process_character maps it
+ * to the matching action_* function so the traced path still prints.
+ */
+typedef enum {
+    TOKENIZER_ACTION_NONE,
+    TOKENIZER_ACTION_START_NUMBER,
+    TOKENIZER_ACTION_ADD_DIGIT,
+    TOKENIZER_ACTION_START_DECIMAL,
+    TOKENIZER_ACTION_ADD_DECIMAL_DIGIT,
+    TOKENIZER_ACTION_FINISH_NUMBER,
+    TOKENIZER_ACTION_COUNT
+} TokenizerAction;
+
+/**
+ * @brief One cell of the shared transition table (two bytes)
+ */
+typedef struct {
+    unsigned char nextState;   // State to go to next
+    unsigned char action;      // TokenizerAction to run on the way
+} TokenizerTransition;
+
+/**
+ * @brief How a buffer is pushed through the state machine
+ * 
+ * All modes follow the same transition table and give identical results:
+ * - TABLE: one shared-table lookup per character, action chosen by switch
+ * - COMPILED: the table unrolled into code, one label per state, so the
+ *   current state is the program counter and there is no lookup at all
+ * - SCANNER: runs of digits and separators skipped in bulk by the
+ *   NumberScanner, table consulted only at run edges (process_buffer)
+ */
+typedef enum {
+    TOKENIZER_MODE_TABLE,
+    TOKENIZER_MODE_COMPILED,
+    TOKENIZER_MODE_SCANNER
+} TokenizerMode;
+
 /**
  * @brief The main structure for our number tokenizer
  * 
  * This is much simpler than the original version - we store just the
- * essential data needed to parse numbers.
+ * essential data needed to parse numbers. The transition table is not
+ * stored here: every tokenizer shares one read-only table.
  */
 typedef struct NumberTokenizer {
     // Current state of the tokenizer
@@ -36,10 +78,6 @@ typedef struct NumberTokenizer {
     // For decimal numbers: tracks which decimal place we're at
     // (10.0 for first decimal place, 100.0 for second, etc.)
     double decimalPlace;
-    
-    // The 2D state transition table
-    // Usage: stateTable[currentState][event] tells us what to do
-    StateTableEntry stateTable[3][4];  // 3 states × 4 events
 } NumberTokenizer;
 
 // === CONSTRUCTION AND DESTRUCTION ===
@@ -76,6 +114,63 @@ void process_character(NumberTokenizer* tokenizer, char ch);
  */
 void process_string(NumberTokenizer* tokenizer, const char* input);
 
+// === SHARED TABLES ===
+/**
+ * @brief Look up a cell of the shared, read-only transition table
+ * @param state Current state
+ * @param event Input event
+ * @return The transition, or NULL if state or event is out of range
+ */
+const TokenizerTransition* tokenizer_transition(State state, Event event);
+
+/**
+ * @brief Classify a character through the shared 256-entry class table
+ * @param ch The character to classify
+ * @return EVENT_DIGIT, EVENT_DOT, EVENT_END for '\0', EVENT_SPACE otherwise
+ */
+Event tokenizer_char_class(char ch);
+
+// === BULK BUFFER PROCESSING ===
+/**
+ * @brief Process a whole buffer of characters without per-character output
+ * @param tokenizer The tokenizer to use
+ * @param buf Characters to process (need not be NUL-terminated)
+ * @param len Number of characters in buf
+ * @param out Array receiving finished numbers (may be NULL)
+ * @param cap Capacity of out
+ * @return Number of numbers finished in buf; only the first cap are stored
+ * 
+ * Follows the same state table as process_character, but runs of digits and
+ * separators are consumed in bulk by the NumberScanner, so the table is only
+ * consulted where a run ends. A number still open at the end of buf carries
+ * over to the next call.
+ */
+size_t process_buffer(NumberTokenizer* tokenizer, const char* buf, size_t len, double* out, size_t cap);
+
+/**
+ * @brief Process a whole buffer with the chosen engine
+ * @param tokenizer The tokenizer to use
+ * @param mode TOKENIZER_MODE_TABLE, _COMPILED or _SCANNER
+ * @param buf Characters to process (need not be NUL-terminated)
+ * @param len Number of characters in buf
+ * @param out Array receiving finished numbers (may be NULL)
+ * @param cap Capacity of out
+ * @return Number of numbers finished in buf; only the first cap are stored
+ * 
+ * Same contract as process_buffer, and the modes can be mixed between calls
+ * on one tokenizer. '\0' inside buf ends a number like a space does.
+ */
+size_t tokenize_buffer(NumberTokenizer* tokenizer, TokenizerMode mode, const char* buf, size_t len,
+                       double* out, size_t cap);
+
+/**
+ * @brief Send the "end of string" event after a series of process_buffer calls
+ * @param tokenizer The tokenizer to use
+ * @param out Receives the number that was still open (may be NULL)
+ * @return 1 if a number was finished, 0 otherwise
+ */
+int finish_buffer(NumberTokenizer* tokenizer, double* out);
+
 // === SIMPLE ACTION FUNCTIONS ===
 // These are the functions that get called when state transitions happen.
 // They're much simpler than the original version - just regular functions
@@ -0,0 +1,161 @@
+/**
+ * @file test_parallel_tokenizer.c
+ * @brief The parallel front end must match one tokenizer over the whole input
+ */
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <unity.h>
+#include "../src/ParallelTokenizer/ParallelTokenizer.h"
+
+#define MAX_NUMBERS 16384  // more than any test input can hold
+
+static double expected[MAX_NUMBERS];
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// === HELPERS ===
+
+// Reference: one tokenizer over the whole buffer, then end of string
+static size_t tokenize_sequentially(const char* buf, size_t len) {
+    NumberTokenizer* tokenizer = create_tokenizer();
+    size_t count = tokenize_buffer(tokenizer, TOKENIZER_MODE_TABLE, buf, len, expected, MAX_NUMBERS);
+
+    count += (size_t)finish_buffer(tokenizer, &expected[count]);
+    destroy_tokenizer(tokenizer);
+    return count;
+}
+
+static void assert_matches_sequential(const char* buf, size_t len, int threads, TokenizerMode mode) {
+    TokenizedNumbers result;
+    size_t count = tokenize_sequentially(buf, len);
+
+    TEST_ASSERT_EQUAL_INT(0, parallel_tokenize_buffer(buf, len, threads, mode, &result));
+    TEST_ASSERT_EQUAL_UINT(count, result.count);
+    TEST_ASSERT_EQUAL_UINT(len, result.bytes);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(expected[i], result.numbers[i]);
+    }
+    free_tokenized_numbers(&result);
+}
+
+// === CHUNK BOUNDARIES ===
+
+void test_chunk_start_moves_to_next_separator(void) {
+    const char* text = "123.45 67,8";
+
+    TEST_ASSERT_EQUAL_UINT(6, parallel_chunk_start(text, 11, 0));  // not on '1'
+    TEST_ASSERT_EQUAL_UINT(6, parallel_chunk_start(text, 11, 3));  // not on '.'
+    TEST_ASSERT_EQUAL_UINT(6, parallel_chunk_start(text, 11, 6));
+    TEST_ASSERT_EQUAL_UINT(9, parallel_chunk_start(text, 11, 7));
+    TEST_ASSERT_EQUAL_UINT(11, parallel_chunk_start(text, 11, 10));  // no separator left
+}
+
+// === MATCHING THE SEQUENTIAL TOKENIZER ===
+
+void test_every_thread_count_matches_sequential(void) {
+    const char* text = "3.14 42 .5 1.2.3 7. 1000000 0.001\t88\n9";
+
+    for (int threads = 1; threads <= 12; threads++) {
+        assert_matches_sequential(text, strlen(text), threads, TOKENIZER_MODE_SCANNER);
+    }
+}
+
+void test_every_mode_matches_sequential(void) {
+    const char* text = "12.5 abc 34, 56..78 .9";
+
+    assert_matches_sequential(text, strlen(text), 4, TOKENIZER_MODE_TABLE);
+    assert_matches_sequential(text, strlen(text), 4, TOKENIZER_MODE_COMPILED);
+    assert_matches_sequential(text, strlen(text), 4, TOKENIZER_MODE_SCANNER);
+}
+
+void test_numbers_straddling_even_splits(void) {
+    // A long number sits across every even cut point; no separators inside
+    const char* text = "1 12345678901234.5678901234 2";
+    TokenizedNumbers result;
+
+    assert_matches_sequential(text, strlen(text), 8, TOKENIZER_MODE_SCANNER);
+    TEST_ASSERT_EQUAL_INT(0, parallel_tokenize_buffer(text, strlen(text), 8, TOKENIZER_MODE_SCANNER, &result));
+    TEST_ASSERT_EQUAL_UINT(3, result.count);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, result.numbers[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 12345678901234.5678901234, result.numbers[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, result.numbers[2]);
+    free_tokenized_numbers(&result);
+}
+
+void test_generated_text_matches_sequential(void) {
+    static char text[32 * 1024];
+    unsigned int state = 7u;
+    size_t pos = 0;
+
+    while (pos + 32 < sizeof(text)) {
+        state = state * 1103515245u + 12345u;
+        pos += (size_t)sprintf(text + pos, (state >> 16) % 4 ? "%u.%u " : "%u,.",
+                               (state >> 8) % 100000u, (state >> 4) % 1000u);
+    }
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        assert_matches_sequential(text, pos, threads, TOKENIZER_MODE_SCANNER);
+    }
+}
+
+// === EDGE CASES ===
+
+void test_empty_input_and_bad_arguments(void) {
+    TokenizedNumbers result;
+
+    TEST_ASSERT_EQUAL_INT(0, parallel_tokenize_buffer("", 0, 4, TOKENIZER_MODE_TABLE, &result));
+    TEST_ASSERT_EQUAL_UINT(0, result.count);
+    free_tokenized_numbers(&result);
+
+    TEST_ASSERT_EQUAL_INT(-1, parallel_tokenize_buffer("1", 1, 0, TOKENIZER_MODE_TABLE, &result));
+    TEST_ASSERT_EQUAL_INT(-1, parallel_tokenize_buffer("1", 1, PARALLEL_TOKENIZER_MAX_THREADS + 1,
+                                                       TOKENIZER_MODE_TABLE, &result));
+    TEST_ASSERT_EQUAL_INT(-1, parallel_tokenize_buffer(NULL, 1, 1, TOKENIZER_MODE_TABLE, &result));
+    TEST_ASSERT_NULL(result.numbers);
+    TEST_ASSERT_EQUAL_INT(-1, parallel_tokenize_file("/nonexistent/numbers.txt", 2, TOKENIZER_MODE_TABLE, &result));
+}
+
+void test_memory_mapped_file(void) {
+    char path[] = "/tmp/parallel_tokenizer_XXXXXX";
+    const char* text = "10 20.5 30\n40.25 50";
+    TokenizedNumbers result;
+    int fd = mkstemp(path);
+
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT((int)strlen(text), (int)write(fd, text, strlen(text)));
+    close(fd);
+
+    TEST_ASSERT_EQUAL_INT(0, parallel_tokenize_file(path, 3, TOKENIZER_MODE_SCANNER, &result));
+    unlink(path);
+    TEST_ASSERT_EQUAL_UINT(5, result.count);
+    TEST_ASSERT_EQUAL_DOUBLE(10.0, result.numbers[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(20.5, result.numbers[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(30.0, result.numbers[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(40.25, result.numbers[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, result.numbers[4]);
+    free_tokenized_numbers(&result);
+}
+
+// === MAIN TEST RUNNER ===
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_chunk_start_moves_to_next_separator);
+    RUN_TEST(test_every_thread_count_matches_sequential);
+    RUN_TEST(test_every_mode_matches_sequential);
+    RUN_TEST(test_numbers_straddling_even_splits);
+    RUN_TEST(test_generated_text_matches_sequential);
+    RUN_TEST(test_empty_input_and_bad_arguments);
+    RUN_TEST(test_memory_mapped_file);
+
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file test_parallel_tokenizer_performance.c
+ * @brief GB/s of parallel_tokenize_file for each thread count
+ *
+ * Writes a large file of generated readings, memory-maps it once per thread
+ * count and checks every run finds the same numbers. Warm page cache, so the
+ * figures are tokenizing plus stitching, not disk speed.
+ */
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime, mkstemp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <unity.h>
+#include "../src/ParallelTokenizer/ParallelTokenizer.h"
+
+// Multi-gigabyte runs: build with -DFILE_SIZE=(4096ull * 1024u * 1024u)
+#ifndef FILE_SIZE
+#define FILE_SIZE (128u * 1024u * 1024u)
+#endif
+#define BLOCK_SIZE (1024u * 1024u)
+#define REPEATS 2
+
+static char path[] = "/tmp/parallel_tokenizer_bench_XXXXXX";
+static size_t fileBytes;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// === HELPERS ===
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Same mix of integers, decimals and separators as the engine benchmark
+static void write_file(void) {
+    char* block = malloc(BLOCK_SIZE + 64);
+    unsigned int state = 2024u;
+    size_t written = 0;
+    FILE* file;
+    int fd = mkstemp(path);
+
+    TEST_ASSERT_TRUE(fd >= 0);
+    file = fdopen(fd, "w");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_NOT_NULL(block);
+    while (written < FILE_SIZE) {
+        size_t pos = 0;
+        while (pos < BLOCK_SIZE) {
+            state = state * 1103515245u + 12345u;
+            pos += (size_t)sprintf(block + pos, (state >> 16) % 3 ? "%u.%u " : "%u, ",
+                                   (state >> 8) % 100000u, (state >> 4) % 1000u);
+        }
+        TEST_ASSERT_EQUAL_UINT(pos, fwrite(block, 1, pos, file));
+        written += pos;
+    }
+    fclose(file);
+    free(block);
+    fileBytes = written;
+}
+
+static double best_seconds(int threads, size_t* count, double* checksum) {
+    double best = 0.0;
+
+    for (int r = 0; r < REPEATS; r++) {
+        TokenizedNumbers result;
+        double start = now_seconds();
+        TEST_ASSERT_EQUAL_INT(0, parallel_tokenize_file(path, threads, TOKENIZER_MODE_SCANNER, &result));
+        double elapsed = now_seconds() - start;
+
+        *count = result.count;
+        *checksum = result.numbers[0] + result.numbers[result.count / 2] + result.numbers[result.count - 1];
+        free_tokenized_numbers(&result);
+        if (r == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+// === BENCHMARK ===
+
+void test_gigabytes_per_second_by_thread_count(void) {
+    static const int threadCounts[] = {1, 2, 4, 8};
+    double single = 0.0;
+    size_t firstCount = 0;
+    double firstChecksum = 0.0;
+
+    write_file();
+    printf("\n  %d MiB file, %ld online CPUs\n", (int)(fileBytes >> 20), sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  %8s %10s %10s\n", "threads", "GB/s", "speedup");
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        size_t count;
+        double checksum;
+        double seconds = best_seconds(threadCounts[i], &count, &checksum);
+        double rate = (double)fileBytes / seconds / 1e9;
+
+        if (i == 0) {
+            single = rate;
+            firstCount = count;
+            firstChecksum = checksum;
+        }
+        TEST_ASSERT_EQUAL_UINT(firstCount, count);
+        TEST_ASSERT_EQUAL_DOUBLE(firstChecksum, checksum);
+        printf("  %8d %10.2f %9.2fx\n", threadCounts[i], rate, rate / single);
+    }
+    unlink(path);
+}
+
+// === MAIN TEST RUNNER ===
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_gigabytes_per_second_by_thread_count);
+
+    return UNITY_END();
+}
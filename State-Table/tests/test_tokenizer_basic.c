@@ -6,6 +6,7 @@
  * simplified tokenizer works correctly with basic number parsing.
  */
 
+#include <string.h>
 #include <unity.h>
 #include "../src/TokenizerStateTable/TokenizerStateTable.h"
 
@@ -75,6 +76,121 @@ void test_multiple_numbers_in_sequence(void) {
     TEST_ASSERT_EQUAL(0.0, tokenizer->result); // Reset after finishing
 }
 
+// === BULK BUFFER TESTS ===
+
+// Step a string through process_character, collecting every finished number
+static size_t collect_per_character(const char* text, double* numbers) {
+    size_t count = 0;
+
+    for (size_t i = 0; i <= strlen(text); i++) {
+        Event event = EVENT_SPACE;
+        char ch = text[i];
+
+        if (ch >= '0' && ch <= '9') {
+            event = EVENT_DIGIT;
+        } else if (ch == '.') {
+            event = EVENT_DOT;
+        } else if (ch == '\0') {
+            event = EVENT_END;
+        }
+        if (tokenizer_transition(tokenizer->currentState, event)->action == TOKENIZER_ACTION_FINISH_NUMBER) {
+            numbers[count++] = tokenizer->result;
+        }
+        process_character(tokenizer, ch);
+    }
+    return count;
+}
+
+void test_process_buffer_matches_per_character(void) {
+    const char* text = "12.5 3.25x4 ..7 1.2.3 1234567890123456789.0123456789 0.000001 42. .5 "
+                       "99999999999999999999 3.14159265358979 18014398509481985 7\t8\n9";
+    double expected[32];
+    double actual[32];
+    size_t expectedCount = collect_per_character(text, expected);
+    size_t count = 0;
+    size_t len = strlen(text);
+
+    // Uneven pieces so numbers straddle buffer boundaries
+    for (size_t pos = 0; pos < len; pos += 5) {
+        size_t piece = (len - pos < 5) ? len - pos : 5;
+        count += process_buffer(tokenizer, text + pos, piece, actual + count, 32 - count);
+    }
+    count += (size_t)finish_buffer(tokenizer, actual + count);
+
+    TEST_ASSERT_EQUAL(expectedCount, count);
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, count * sizeof(double)); // Bit-identical
+    TEST_ASSERT_EQUAL(STATE_WAITING, tokenizer->currentState);
+}
+
+void test_process_buffer_counts_past_capacity(void) {
+    double numbers[1] = {0.0};
+
+    TEST_ASSERT_EQUAL(3, process_buffer(tokenizer, "1 2 3.5 ", 8, numbers, 1));
+    TEST_ASSERT_EQUAL(1.0, numbers[0]);
+    TEST_ASSERT_EQUAL(0, finish_buffer(tokenizer, NULL));
+}
+
+void test_every_mode_matches_per_character(void) {
+    static const TokenizerMode modes[] = {TOKENIZER_MODE_TABLE, TOKENIZER_MODE_COMPILED, TOKENIZER_MODE_SCANNER};
+    const char* text = "12.5 3.25x4 ..7 1.2.3 1234567890123456789.0123456789 0.000001 42. .5 "
+                       "99999999999999999999 3.14159265358979 18014398509481985 7\t8\n9";
+    double expected[32];
+    size_t expectedCount = collect_per_character(text, expected);
+    size_t len = strlen(text);
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        double actual[32];
+        size_t count = 0;
+
+        // Switch modes between pieces too, so carried-over state is exercised
+        for (size_t pos = 0; pos < len; pos += 7) {
+            size_t piece = (len - pos < 7) ? len - pos : 7;
+            TokenizerMode mode = modes[(m + pos / 7) % 3];
+            count += tokenize_buffer(tokenizer, mode, text + pos, piece, actual + count, 32 - count);
+        }
+        count += (size_t)finish_buffer(tokenizer, actual + count);
+
+        TEST_ASSERT_EQUAL(expectedCount, count);
+        TEST_ASSERT_EQUAL_MEMORY(expected, actual, count * sizeof(double));
+        TEST_ASSERT_EQUAL(STATE_WAITING, tokenizer->currentState);
+    }
+}
+
+void test_compiled_mode_follows_the_table(void) {
+    // Every state and event pair, reached from a fresh tokenizer
+    static const char* prefixes[] = {"", "1", "."};
+    static const char inputs[] = {'7', '.', ' ', '\0'};
+
+    for (int state = STATE_WAITING; state <= STATE_DECIMAL; state++) {
+        for (int event = EVENT_DIGIT; event <= EVENT_END; event++) {
+            NumberTokenizer table = {STATE_WAITING, 0.0, 10.0};
+            NumberTokenizer compiled = {STATE_WAITING, 0.0, 10.0};
+            char input[2] = {0, 0};
+            const TokenizerTransition* entry = tokenizer_transition((State)state, (Event)event);
+
+            tokenize_buffer(&table, TOKENIZER_MODE_TABLE, prefixes[state], strlen(prefixes[state]), NULL, 0);
+            tokenize_buffer(&compiled, TOKENIZER_MODE_COMPILED, prefixes[state], strlen(prefixes[state]), NULL, 0);
+            TEST_ASSERT_EQUAL(state, table.currentState);
+            input[0] = inputs[event];
+            TEST_ASSERT_EQUAL(event, tokenizer_char_class(input[0]));
+            tokenize_buffer(&table, TOKENIZER_MODE_TABLE, input, 1, NULL, 0);
+            tokenize_buffer(&compiled, TOKENIZER_MODE_COMPILED, input, 1, NULL, 0);
+            TEST_ASSERT_NOT_NULL(entry);
+            TEST_ASSERT_EQUAL(entry->nextState, table.currentState);
+            TEST_ASSERT_EQUAL(entry->nextState, compiled.currentState);
+            TEST_ASSERT_EQUAL_MEMORY(&table.result, &compiled.result, sizeof(double));
+        }
+    }
+    TEST_ASSERT_NULL(tokenizer_transition((State)3, EVENT_DIGIT));
+}
+
+void test_tokenizers_share_the_table(void) {
+    // Only the state and the two accumulators are per instance
+    TEST_ASSERT_TRUE(sizeof(NumberTokenizer) <= 3 * sizeof(double));
+    TEST_ASSERT_EQUAL(EVENT_SPACE, tokenizer_char_class('x'));
+    TEST_ASSERT_EQUAL(EVENT_SPACE, tokenizer_char_class((char)0xff));
+}
+
 // === UTILITY FUNCTION TESTS ===
 
 void test_state_string_conversion(void) {
@@ -96,6 +212,8 @@ void test_null_tokenizer_handling(void) {
     // These should not crash
     process_character(NULL, '5');
     process_string(NULL, "123");
+    TEST_ASSERT_EQUAL(0, process_buffer(NULL, "123", 3, NULL, 0));
+    TEST_ASSERT_EQUAL(0, finish_buffer(NULL, NULL));
     print_tokenizer_state(NULL);
     destroy_tokenizer(NULL);
 }
@@ -118,6 +236,13 @@ int main(void) {
     // Multiple numbers
     RUN_TEST(test_multiple_numbers_in_sequence);
     
+    // Bulk buffer processing
+    RUN_TEST(test_process_buffer_matches_per_character);
+    RUN_TEST(test_process_buffer_counts_past_capacity);
+    RUN_TEST(test_every_mode_matches_per_character);
+    RUN_TEST(test_compiled_mode_follows_the_table);
+    RUN_TEST(test_tokenizers_share_the_table);
+    
     // Utility functions
     RUN_TEST(test_state_string_conversion);
     RUN_TEST(test_event_string_conversion);
@@ -0,0 +1,126 @@
+/**
+ * @file test_tokenizer_performance.c
+ * @brief Characters per second for each tokenizer engine
+ * 
+ * Pushes the same generated text through every TokenizerMode and checks they
+ * all find the same numbers. The traced process_character path is timed on a
+ * smaller slice with stdout sent to /dev/null, as the old baseline.
+ */
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime, fileno
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <unity.h>
+#include "../src/TokenizerStateTable/TokenizerStateTable.h"
+
+#define TEXT_SIZE (8u * 1024u * 1024u)
+#define TRACE_SIZE (256u * 1024u)
+#define REPEATS 5
+
+static char* text;
+static NumberTokenizer* tokenizer;
+
+void setUp(void) {
+    tokenizer = create_tokenizer();
+    TEST_ASSERT_NOT_NULL(tokenizer);
+}
+
+void tearDown(void) {
+    destroy_tokenizer(tokenizer);
+}
+
+// === HELPERS ===
+
+static double now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// A mix of integers, decimals and separators, like a log of sensor readings
+static void build_text(void) {
+    unsigned int state = 2024u;
+    size_t pos = 0;
+
+    text = malloc(TEXT_SIZE);
+    TEST_ASSERT_NOT_NULL(text);
+    while (pos + 32 < TEXT_SIZE) {
+        state = state * 1103515245u + 12345u;
+        pos += (size_t)sprintf(text + pos, (state >> 16) % 3 ? "%u.%u " : "%u, ",
+                               (state >> 8) % 100000u, (state >> 4) % 1000u);
+    }
+    memset(text + pos, ' ', TEXT_SIZE - pos);
+}
+
+static double run_mode(TokenizerMode mode, size_t* numbers) {
+    double best = 0.0;
+
+    for (int r = 0; r < REPEATS; r++) {
+        double start = now_nanos();
+        size_t count = tokenize_buffer(tokenizer, mode, text, TEXT_SIZE, NULL, 0);
+        count += (size_t)finish_buffer(tokenizer, NULL);
+        double rate = TEXT_SIZE / (now_nanos() - start) * 1e9;
+        best = rate > best ? rate : best;
+        *numbers = count;
+    }
+    return best;
+}
+
+static double run_traced(void) {
+    int saved = dup(fileno(stdout));
+    int devNull = open("/dev/null", O_WRONLY);
+    double start;
+    double elapsed;
+
+    fflush(stdout);
+    dup2(devNull, fileno(stdout));
+    close(devNull);
+    start = now_nanos();
+    for (size_t i = 0; i < TRACE_SIZE; i++) {
+        process_character(tokenizer, text[i]);
+    }
+    fflush(stdout);
+    elapsed = now_nanos() - start;
+    dup2(saved, fileno(stdout));
+    close(saved);
+    return TRACE_SIZE / elapsed * 1e9;
+}
+
+// === BENCHMARK ===
+
+void test_mode_throughput(void) {
+    static const struct {
+        TokenizerMode mode;
+        const char* name;
+    } modes[] = {
+        {TOKENIZER_MODE_TABLE, "table"},
+        {TOKENIZER_MODE_COMPILED, "compiled"},
+        {TOKENIZER_MODE_SCANNER, "scanner"},
+    };
+    size_t reference = 0;
+
+    build_text();
+    printf("tokenizer: %zu bytes per instance, %u MiB of text\n", sizeof(NumberTokenizer), TEXT_SIZE >> 20);
+    printf("%-10s %8.1f Mchars/s (process_character with tracing)\n", "traced", run_traced() / 1e6);
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        size_t numbers = 0;
+        double rate = run_mode(modes[m].mode, &numbers);
+        printf("%-10s %8.1f Mchars/s, %zu numbers\n", modes[m].name, rate / 1e6, numbers);
+        if (m == 0) {
+            reference = numbers;
+        }
+        TEST_ASSERT_EQUAL(reference, numbers);
+    }
+    free(text);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mode_throughput);
+    return UNITY_END();
+}
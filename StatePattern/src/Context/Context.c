@@ -155,3 +155,151 @@ void Context_processString(Context* context, const char* str) {
     Context_processEndOfString(context);
     printf("String processing complete\n\n");
 }
+
+// Fast path - the state pointer is resolved once per buffer and each state
+// consumes its whole run of characters in a tight loop
+enum { BUFFER_NO_NUMBER, BUFFER_WHOLE, BUFFER_FRACTION };
+
+static int isDigitChar(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+static void storeNumber(double value, double* numbers, int capacity, int* count) {
+    if (numbers != NULL && *count < capacity) {
+        numbers[*count] = value;
+    }
+    (*count)++;
+}
+
+// A number completes when a separator or the end of the string takes the
+// context from a number state back to NoNumberState
+static void collectNumber(Context* context, const State* before, double value,
+                          double* numbers, int capacity, int* count) {
+    if (before != NoNumberState && context->currentState == NoNumberState) {
+        storeNumber(value, numbers, capacity, count);
+    }
+}
+
+static int processBufferSlow(Context* context, const char* buffer, size_t length,
+                             double* numbers, int capacity) {
+    // Unknown state object: fall back to the per-character State calls. The
+    // mutex is already held, so the handlers are called directly.
+    int count = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        char ch = buffer[i];
+        if (isDigitChar(ch)) {
+            context->currentState->onDigit(context, ch);
+        } else if (ch == '.') {
+            context->currentState->onDot(context);
+        } else {
+            const State* before = context->currentState;
+            double value = context->result;
+            context->currentState->onWhiteSpace(context);
+            collectNumber(context, before, value, numbers, capacity, &count);
+        }
+    }
+    const State* before = context->currentState;
+    double value = context->result;
+    context->currentState->onEndOfString(context);
+    collectNumber(context, before, value, numbers, capacity, &count);
+    return count;
+}
+
+int Context_processBuffer(Context* context, const char* buffer, size_t length,
+                          double* numbers, int capacity) {
+    if (context == NULL || context->currentState == NULL
+        || (buffer == NULL && length > 0)) return 0;
+
+    // The state is only read under the lock, so a concurrent event cannot
+    // change it between choosing the path and running it
+    if (context->mutex != NULL) {
+        Mutex_lock(context->mutex);
+    }
+
+    int state;
+    if (context->currentState == NoNumberState) {
+        state = BUFFER_NO_NUMBER;
+    } else if (context->currentState == ProcessingWholeState) {
+        state = BUFFER_WHOLE;
+    } else if (context->currentState == ProcessingFractionState) {
+        state = BUFFER_FRACTION;
+    } else {
+        int count = processBufferSlow(context, buffer, length, numbers, capacity);
+        if (context->mutex != NULL) {
+            Mutex_release(context->mutex);
+        }
+        return count;
+    }
+
+    double result = context->result;
+    int fractionalDigits = context->fractionalDigits;
+    int count = 0;
+    size_t i = 0;
+
+    while (i < length) {
+        switch (state) {
+        case BUFFER_NO_NUMBER:
+            // dots and separators are ignored until a number starts
+            while (i < length && !isDigitChar(buffer[i])) {
+                i++;
+            }
+            if (i < length) {
+                result = (double)(buffer[i++] - '0');
+                state = BUFFER_WHOLE;
+            }
+            break;
+
+        case BUFFER_WHOLE:
+            while (i < length && isDigitChar(buffer[i])) {
+                result = result * 10.0 + (buffer[i++] - '0');
+            }
+            if (i < length) {
+                if (buffer[i++] == '.') {
+                    fractionalDigits = 0;
+                    state = BUFFER_FRACTION;
+                } else {
+                    storeNumber(result, numbers, capacity, &count);
+                    result = 0.0;
+                    state = BUFFER_NO_NUMBER;
+                }
+            }
+            break;
+
+        default:  // BUFFER_FRACTION - extra dots are ignored
+            while (i < length && (isDigitChar(buffer[i]) || buffer[i] == '.')) {
+                if (buffer[i] != '.') {
+                    // Same arithmetic as the ProcessingFraction state, so
+                    // both paths produce identical doubles
+                    double fractionalValue = (double)(buffer[i] - '0');
+                    for (int k = 0; k <= fractionalDigits; k++) {
+                        fractionalValue /= 10.0;
+                    }
+                    result += fractionalValue;
+                    fractionalDigits++;
+                }
+                i++;
+            }
+            if (i < length) {
+                i++;
+                storeNumber(result, numbers, capacity, &count);
+                result = 0.0;
+                state = BUFFER_NO_NUMBER;
+            }
+            break;
+        }
+    }
+
+    // End of string
+    if (state != BUFFER_NO_NUMBER) {
+        storeNumber(result, numbers, capacity, &count);
+    }
+    context->result = 0.0;
+    context->fractionalDigits = fractionalDigits;
+    context->currentState = NoNumberState;
+
+    if (context->mutex != NULL) {
+        Mutex_release(context->mutex);
+    }
+    return count;
+}
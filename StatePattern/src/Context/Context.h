@@ -5,6 +5,8 @@
 #ifndef STATEPATTERN_CONTEXT_H
 #define STATEPATTERN_CONTEXT_H
 
+#include <stddef.h>
+
 // Forward declarations
 struct State;
 struct Mutex;
@@ -21,6 +23,24 @@ typedef struct Context {
 Context* Context_Create(void);
 void Context_Destroy(Context* context);
 
+// Pooled contexts - fixed capacity, no malloc and no global lock.
+// Each thread keeps a small cache of free contexts and only touches the
+// shared lock-free free list when that cache runs dry or overflows.
+// Acquire never takes from another thread's cache, so it can return NULL
+// while Context_PoolAvailable() is still positive: up to
+// CONTEXT_POOL_THREAD_CACHE free slots per thread stay with their owner
+// until it releases past its cache size or exits.
+#ifndef CONTEXT_POOL_CAPACITY
+#define CONTEXT_POOL_CAPACITY 256
+#endif
+#ifndef CONTEXT_POOL_THREAD_CACHE
+#define CONTEXT_POOL_THREAD_CACHE 16
+#endif
+
+Context* Context_Acquire(void);          // NULL when no slot is free outside other threads' caches
+void Context_Release(Context* context);  // ignores contexts not from the pool
+int Context_PoolAvailable(void);         // free slots, including thread caches
+
 // Context operations
 void Context_setState(Context* context, struct State* newState);
 struct State* Context_getState(Context* context);
@@ -42,4 +62,12 @@ void Context_processEndOfString(Context* context);
 // Convenience function to process a string
 void Context_processString(Context* context, const char* str);
 
+// Fast path: runs the same state machine over a whole buffer without a
+// per-character State call, locking the mutex once per buffer and staying
+// quiet. Every completed number is stored in numbers[] (up to capacity);
+// the return value is how many numbers completed. The buffer is treated as
+// one string, so it ends with an end-of-string event.
+int Context_processBuffer(Context* context, const char* buffer, size_t length,
+                          double* numbers, int capacity);
+
 #endif //STATEPATTERN_CONTEXT_H
@@ -0,0 +1,145 @@
+//
+// Fixed-capacity Context pool with per-thread free lists
+//
+
+#include "Context.h"
+#include "../State/State.h"
+#include <pthread.h>
+#include <stdint.h>
+
+// Pool storage - slots are handed out fresh until the bump index reaches the
+// capacity, after which only released slots come back through the free list
+static Context pool[CONTEXT_POOL_CAPACITY];
+static uint32_t poolNext[CONTEXT_POOL_CAPACITY];  // free-list link, slot index + 1 (0 = end)
+static uint32_t poolFresh;                        // first never-used slot
+static uint64_t poolHead;                         // free-list top: ABA tag << 32 | slot index + 1
+static int poolShared;                            // slots sitting on the shared free list
+
+// Per-thread cache - only its owner touches it
+typedef struct ContextCache {
+    Context* slots[CONTEXT_POOL_THREAD_CACHE];
+    int count;
+    int registered;
+} ContextCache;
+
+static __thread ContextCache cache;
+static pthread_key_t cacheKey;
+static pthread_once_t cacheKeyOnce = PTHREAD_ONCE_INIT;
+static int cached;  // slots sitting in any thread cache
+
+static uint32_t slotOf(const Context* context) {
+    return (uint32_t)(context - pool);
+}
+
+// Shared free list: a Treiber stack over slot indices, tagged against ABA
+static void sharedPush(Context* context) {
+    uint32_t slot = slotOf(context);
+    uint64_t head = __atomic_load_n(&poolHead, __ATOMIC_RELAXED);
+    uint64_t next;
+
+    do {
+        __atomic_store_n(&poolNext[slot], (uint32_t)head, __ATOMIC_RELAXED);
+        next = ((head >> 32) + 1) << 32 | (slot + 1);
+    } while (!__atomic_compare_exchange_n(&poolHead, &head, next, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_fetch_add(&poolShared, 1, __ATOMIC_RELAXED);
+}
+
+static Context* sharedPop(void) {
+    uint64_t head = __atomic_load_n(&poolHead, __ATOMIC_ACQUIRE);
+    uint64_t next;
+
+    do {
+        uint32_t top = (uint32_t)head;
+        if (top == 0) {
+            return NULL;
+        }
+        next = ((head >> 32) + 1) << 32 | __atomic_load_n(&poolNext[top - 1], __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&poolHead, &head, next, 1,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+    __atomic_fetch_sub(&poolShared, 1, __ATOMIC_RELAXED);
+    return &pool[(uint32_t)head - 1];
+}
+
+static Context* freshSlot(void) {
+    uint32_t slot = __atomic_load_n(&poolFresh, __ATOMIC_RELAXED);
+
+    do {
+        if (slot >= CONTEXT_POOL_CAPACITY) {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&poolFresh, &slot, slot + 1, 1,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    return &pool[slot];
+}
+
+// A thread's cached slots go back to the shared list when it exits
+static void flushCache(void* arg) {
+    ContextCache* threadCache = (ContextCache*)arg;
+
+    while (threadCache->count > 0) {
+        sharedPush(threadCache->slots[--threadCache->count]);
+        __atomic_fetch_sub(&cached, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void createCacheKey(void) {
+    pthread_key_create(&cacheKey, flushCache);
+}
+
+static void registerCache(void) {
+    pthread_once(&cacheKeyOnce, createCacheKey);
+    pthread_setspecific(cacheKey, &cache);
+    cache.registered = 1;
+}
+
+Context* Context_Acquire(void) {
+    Context* context;
+
+    if (!cache.registered) {
+        registerCache();
+    }
+    if (cache.count > 0) {
+        context = cache.slots[--cache.count];
+        __atomic_fetch_sub(&cached, 1, __ATOMIC_RELAXED);
+    } else {
+        context = sharedPop();
+        if (context == NULL) {
+            context = freshSlot();
+        }
+        if (context == NULL) {
+            return NULL;
+        }
+    }
+
+    context->currentState = NoNumberState;
+    context->result = 0.0;
+    context->fractionalDigits = 0;
+    context->mutex = NULL;
+    return context;
+}
+
+void Context_Release(Context* context) {
+    if (context < pool || context >= pool + CONTEXT_POOL_CAPACITY) {
+        return;
+    }
+    if (!cache.registered) {
+        registerCache();
+    }
+    if (cache.count == CONTEXT_POOL_THREAD_CACHE) {
+        // Full cache: hand half back so other threads can use it
+        while (cache.count > CONTEXT_POOL_THREAD_CACHE / 2) {
+            sharedPush(cache.slots[--cache.count]);
+            __atomic_fetch_sub(&cached, 1, __ATOMIC_RELAXED);
+        }
+    }
+    cache.slots[cache.count++] = context;
+    __atomic_fetch_add(&cached, 1, __ATOMIC_RELAXED);
+}
+
+int Context_PoolAvailable(void) {
+    int fresh = CONTEXT_POOL_CAPACITY - (int)__atomic_load_n(&poolFresh, __ATOMIC_RELAXED);
+
+    return fresh + __atomic_load_n(&poolShared, __ATOMIC_RELAXED)
+                 + __atomic_load_n(&cached, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_context_performance.c
+ * @brief Per-message cost of Create/processString/Destroy versus
+ *        Acquire/processBuffer/Release
+ *
+ * Each "message" is parsed by a fresh context, the way the ingestion service
+ * uses them. Allocations are counted by wrapping malloc (glibc only); the
+ * chatty State objects print to /dev/null while the old path is timed.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <unity.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../src/Context/Context.h"
+#include "../src/State/State.h"
+
+#define MESSAGE_COUNT 8
+#define SLOW_MESSAGES 20000L
+#define FAST_MESSAGES 2000000L
+
+static const char* messages[MESSAGE_COUNT] = {
+    "12.5 300 7.25", "42 0.001 1999.99", "3.14159 2.71828", "100 200 300 400",
+    "temp 21.5 rh 40.25", "0.5 .75 8.", "65535 1.0.1 9", "7 77 777 7777 77777"
+};
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void __libc_free(void* ptr);
+static long allocations;
+
+void* malloc(size_t size) {
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+#define ALLOCATIONS() __atomic_load_n(&allocations, __ATOMIC_RELAXED)
+#else
+#define ALLOCATIONS() 0L
+#endif
+
+typedef struct Result {
+    double perMessageAllocations;
+    double messagesPerSecond;
+    double checksum;
+} Result;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int silence_stdout(void) {
+    int saved;
+    int devNull = open("/dev/null", O_WRONLY);
+
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    dup2(devNull, STDOUT_FILENO);
+    close(devNull);
+    return saved;
+}
+
+static void restore_stdout(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+// Before: one malloc'd context per message, one State call per character
+static Result run_create_destroy(long count) {
+    Result result = {0.0, 0.0, 0.0};
+    int saved = silence_stdout();
+    long before = ALLOCATIONS();
+    double start = now_seconds();
+
+    for (long m = 0; m < count; m++) {
+        Context* context = Context_Create();
+        Context_processString(context, messages[m % MESSAGE_COUNT]);
+        result.checksum += (double)(Context_getState(context) == NoNumberState);
+        Context_Destroy(context);
+    }
+
+    double elapsed = now_seconds() - start;
+    result.perMessageAllocations = (double)(ALLOCATIONS() - before) / (double)count;
+    restore_stdout(saved);
+    result.messagesPerSecond = (double)count / elapsed;
+    return result;
+}
+
+// After: pooled context, one fast-path call per message
+static Result run_pool_buffer(long count) {
+    Result result = {0.0, 0.0, 0.0};
+    size_t lengths[MESSAGE_COUNT];
+    double numbers[8];
+
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        lengths[i] = strlen(messages[i]);
+    }
+
+    long before = ALLOCATIONS();
+    double start = now_seconds();
+
+    for (long m = 0; m < count; m++) {
+        Context* context = Context_Acquire();
+        int found = Context_processBuffer(context, messages[m % MESSAGE_COUNT],
+                                          lengths[m % MESSAGE_COUNT], numbers, 8);
+        result.checksum += found > 0 ? numbers[0] : 0.0;
+        Context_Release(context);
+    }
+
+    double elapsed = now_seconds() - start;
+    result.perMessageAllocations = (double)(ALLOCATIONS() - before) / (double)count;
+    result.messagesPerSecond = (double)count / elapsed;
+    return result;
+}
+
+// Test setup - called before each test
+void setUp(void) {
+}
+
+// Test teardown - called after each test
+void tearDown(void) {
+}
+
+void test_pooled_fast_path_per_message_cost(void) {
+    Result slow = run_create_destroy(SLOW_MESSAGES);
+    Result fast = run_pool_buffer(FAST_MESSAGES);
+
+    printf("\n  %-34s %14s %16s\n", "path", "allocs/message", "messages/s");
+    printf("  %-34s %14.2f %16.0f\n", "Create + processString + Destroy",
+           slow.perMessageAllocations, slow.messagesPerSecond);
+    printf("  %-34s %14.2f %16.0f\n", "Acquire + processBuffer + Release",
+           fast.perMessageAllocations, fast.messagesPerSecond);
+    printf("  speedup %.1fx\n", fast.messagesPerSecond / slow.messagesPerSecond);
+
+    TEST_ASSERT_EQUAL_DOUBLE((double)SLOW_MESSAGES, slow.checksum);
+    TEST_ASSERT_TRUE(fast.checksum > 0.0);
+#ifdef __GLIBC__
+    TEST_ASSERT_TRUE(slow.perMessageAllocations >= 1.0);
+#endif
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, fast.perMessageAllocations);
+    TEST_ASSERT_TRUE(fast.messagesPerSecond > slow.messagesPerSecond);
+}
+
+// === MAIN TEST RUNNER ===
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pooled_fast_path_per_message_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/**
+ * @file test_context_pool.c
+ * @brief Tests for pooled contexts and the Context_processBuffer fast path
+ */
+
+#include <unity.h>
+#include <pthread.h>
+#include <string.h>
+#include "../src/Context/Context.h"
+#include "../src/State/State.h"
+#include "../src/mutex/Mutex.h"
+
+#define POOL_THREADS 4
+#define POOL_ROUNDS 20000
+
+// Test setup - called before each test
+void setUp(void) {
+    States_Init();
+}
+
+// Test teardown - called after each test
+void tearDown(void) {
+}
+
+// Reference: drive the State objects one character at a time and record the
+// result each time a number completes
+static int parse_with_states(const char* str, double* numbers, int capacity) {
+    Context* context = Context_Create();
+    int count = 0;
+
+    for (const char* ptr = str; ; ptr++) {
+        char ch = *ptr;
+        int terminates = !(ch >= '0' && ch <= '9') && ch != '.';
+        if (terminates && Context_getState(context) != NoNumberState && count < capacity) {
+            numbers[count++] = Context_getResult(context);
+        }
+        if (ch == '\0') {
+            Context_processEndOfString(context);
+            break;
+        } else if (ch >= '0' && ch <= '9') {
+            Context_processDigit(context, ch);
+        } else if (ch == '.') {
+            Context_processDot(context);
+        } else {
+            Context_processWhiteSpace(context);
+        }
+    }
+    Context_Destroy(context);
+    return count;
+}
+
+// === POOL TESTS ===
+
+void test_acquire_starts_in_no_number_state(void) {
+    Context* context = Context_Acquire();
+
+    TEST_ASSERT_NOT_NULL(context);
+    TEST_ASSERT_EQUAL_PTR(NoNumberState, Context_getState(context));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, Context_getResult(context));
+    TEST_ASSERT_EQUAL(0, Context_getFractionalDigits(context));
+    Context_Release(context);
+}
+
+void test_released_context_is_reset_on_reuse(void) {
+    Context* context = Context_Acquire();
+    Context_processDigit(context, '7');
+    Context_Release(context);
+
+    Context* again = Context_Acquire();
+    TEST_ASSERT_EQUAL_PTR(context, again);  // last released comes back first
+    TEST_ASSERT_EQUAL_PTR(NoNumberState, Context_getState(again));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, Context_getResult(again));
+    Context_Release(again);
+}
+
+void test_pool_exhaustion_and_recovery(void) {
+    static Context* held[CONTEXT_POOL_CAPACITY];
+    int available = Context_PoolAvailable();
+
+    TEST_ASSERT_EQUAL(CONTEXT_POOL_CAPACITY, available);
+    for (int i = 0; i < CONTEXT_POOL_CAPACITY; i++) {
+        held[i] = Context_Acquire();
+        TEST_ASSERT_NOT_NULL(held[i]);
+    }
+    TEST_ASSERT_NULL(Context_Acquire());
+    TEST_ASSERT_EQUAL(0, Context_PoolAvailable());
+
+    for (int i = 0; i < CONTEXT_POOL_CAPACITY; i++) {
+        Context_Release(held[i]);
+    }
+    TEST_ASSERT_EQUAL(CONTEXT_POOL_CAPACITY, Context_PoolAvailable());
+}
+
+void test_release_ignores_foreign_contexts(void) {
+    Context* context = Context_Create();
+    int available = Context_PoolAvailable();
+
+    Context_Release(context);
+    Context_Release(NULL);
+    TEST_ASSERT_EQUAL(available, Context_PoolAvailable());
+    Context_Destroy(context);
+}
+
+static void* pool_worker(void* arg) {
+    long* failures = (long*)arg;
+    Context* held[3];
+    double numbers[4];
+
+    for (int round = 0; round < POOL_ROUNDS; round++) {
+        for (int i = 0; i < 3; i++) {
+            held[i] = Context_Acquire();
+        }
+        for (int i = 0; i < 3; i++) {
+            if (held[i] == NULL
+                || Context_processBuffer(held[i], "12 3.5", 6, numbers, 4) != 2
+                || numbers[0] != 12.0 || numbers[1] != 3.5) {
+                (*failures)++;
+            }
+            Context_Release(held[i]);
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_acquire_release(void) {
+    pthread_t threads[POOL_THREADS];
+    long failures[POOL_THREADS] = {0};
+
+    for (int t = 0; t < POOL_THREADS; t++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[t], NULL, pool_worker, &failures[t]));
+    }
+    for (int t = 0; t < POOL_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        TEST_ASSERT_EQUAL(0, failures[t]);
+    }
+    // Exited threads hand their cached slots back
+    TEST_ASSERT_EQUAL(CONTEXT_POOL_CAPACITY, Context_PoolAvailable());
+}
+
+// === FAST PATH TESTS ===
+
+void test_process_buffer_matches_state_objects(void) {
+    static const char* inputs[] = {
+        "123", "45.67", "12 34 56", "", "   ", "12.5 abc 34", ".5", "1.2.3",
+        "5.", "0.001\t9\n10", "..7..8 x9y", "3.14159265 2.71828 1.41421"
+    };
+    double expected[8];
+    double actual[8];
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        Context* context = Context_Acquire();
+        int expectedCount = parse_with_states(inputs[i], expected, 8);
+        int count = Context_processBuffer(context, inputs[i], strlen(inputs[i]), actual, 8);
+
+        TEST_ASSERT_EQUAL_MESSAGE(expectedCount, count, inputs[i]);
+        // Bit for bit: both paths must do the same arithmetic
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected, actual, (size_t)count * sizeof(double), inputs[i]);
+        TEST_ASSERT_EQUAL_PTR(NoNumberState, Context_getState(context));
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, Context_getResult(context));
+        Context_Release(context);
+    }
+}
+
+void test_process_buffer_continues_from_current_state(void) {
+    Context* context = Context_Acquire();
+    double numbers[2];
+
+    double expected[2];
+
+    TEST_ASSERT_EQUAL(2, parse_with_states("4.25 8", expected, 2));
+    Context_processDigit(context, '4');
+    Context_processDot(context);
+    Context_processDigit(context, '2');
+    TEST_ASSERT_EQUAL(2, Context_processBuffer(context, "5 8", 3, numbers, 2));
+    TEST_ASSERT_EQUAL_MEMORY(expected, numbers, sizeof(numbers));
+    Context_Release(context);
+}
+
+void test_process_buffer_slow_path_collects_numbers(void) {
+    Context* context = Context_Acquire();
+    State unknown = *NoNumberState;  // Same behaviour, not a state the fast path knows
+    Mutex mutex;
+    double expected[4];
+    double numbers[4];
+
+    Mutex_init(&mutex);
+    Context_setMutex(context, &mutex);
+    Context_setState(context, &unknown);
+    int expectedCount = parse_with_states("12 3.25 .5 x7", expected, 4);
+    TEST_ASSERT_EQUAL(expectedCount, Context_processBuffer(context, "12 3.25 .5 x7", 13, numbers, 4));
+    TEST_ASSERT_EQUAL_MEMORY(expected, numbers, (size_t)expectedCount * sizeof(double));
+    TEST_ASSERT_EQUAL_PTR(NoNumberState, Context_getState(context));
+    Context_Release(context);
+    Mutex_destroy(&mutex);
+}
+
+void test_process_buffer_counts_past_capacity(void) {
+    Context* context = Context_Acquire();
+    Mutex mutex;
+    double numbers[2] = {0.0, 0.0};
+
+    Mutex_init(&mutex);
+    Context_setMutex(context, &mutex);
+    TEST_ASSERT_EQUAL(4, Context_processBuffer(context, "1 2 3 4", 7, numbers, 2));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, numbers[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, numbers[1]);
+    TEST_ASSERT_EQUAL(3, Context_processBuffer(context, "9 8 7", 5, NULL, 0));
+    Context_Release(context);
+    Mutex_destroy(&mutex);
+}
+
+// === MAIN TEST RUNNER ===
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_acquire_starts_in_no_number_state);
+    RUN_TEST(test_released_context_is_reset_on_reuse);
+    RUN_TEST(test_pool_exhaustion_and_recovery);
+    RUN_TEST(test_release_ignores_foreign_contexts);
+    RUN_TEST(test_concurrent_acquire_release);
+    RUN_TEST(test_process_buffer_matches_state_objects);
+    RUN_TEST(test_process_buffer_continues_from_current_state);
+    RUN_TEST(test_process_buffer_slow_path_collects_numbers);
+    RUN_TEST(test_process_buffer_counts_past_capacity);
+
+    return UNITY_END();
+}
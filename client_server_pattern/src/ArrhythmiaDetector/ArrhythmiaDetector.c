@@ -2,10 +2,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/* adds the samples outside QRS spikes to *sum, returns how many there were */
+static int sumBaseline(const struct TimeMarkedData* samples, int count, long* sum) {
+    int n = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (samples[i].dataValue <= ECG_QRS_THRESHOLD) {
+            *sum += samples[i].dataValue;
+            n++;
+        }
+    }
+    return n;
+}
 
 void ArrhythmiaDetector_Init(ArrhythmiaDetector* const self){
-    (void)self;
-    self->index = 0;
+    self->STSegmentHeight = 0;
+    self->reader.nextSequence = 0;
+    self->reader.overruns = 0;
+    self->itsTMDQueue = NULL;
 }
 
 void ArrhythmiaDetector_Cleanup(ArrhythmiaDetector* const self){
@@ -18,15 +33,57 @@ void ArrhythmiaDetector_indentifyArrhythmia(ArrhythmiaDetector* const self){
 }
 
 void ArrhythmiaDetector_getDataSample(ArrhythmiaDetector* const self){
-    TimeMarkedData tmd;
-    tmd = TMDQueue_remove(self->itsTMDQueue, self->index);
-    printf("ArrhythmiaDetector index: %d TimeInterval: %ld  DataValue: %d\n", self->index,
-                   tmd.timeInterval, tmd.dataValue);
-    self->index = TMDQueue_getNextIndex(self->itsTMDQueue, self->index);
+    TMDQueueSpan span;
+    if (TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 1) == 0) {
+        printf("ArrhythmiaDetector: no new sample\n");
+        return;
+    }
+    if (span.lost > 0) {
+        printf("ArrhythmiaDetector overrun: %ld samples lost\n", span.lost);
+    }
+    printf("ArrhythmiaDetector sample #%ld TimeInterval: %ld  DataValue: %d\n", span.startSequence,
+                   span.first[0].timeInterval, span.first[0].dataValue);
+}
+
+/* processes every sample inserted since the last read in place, one block per wake-up */
+int ArrhythmiaDetector_getDataBlock(ArrhythmiaDetector* const self){
+    TMDQueueSpan span;
+    int count = TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 0);
+    if (span.lost > 0) {
+        printf("ArrhythmiaDetector overrun: %ld samples lost\n", span.lost);
+    }
+    if (count > 0) {
+        long sum = 0;
+        int n = sumBaseline(span.first, span.firstCount, &sum) + sumBaseline(span.second, span.secondCount, &sum);
+
+        printf("ArrhythmiaDetector block: samples #%ld..#%ld\n", span.startSequence,
+                       span.startSequence + count - 1);
+        if (n > 0) {
+            self->STSegmentHeight = (int)(sum / n);
+        }
+        ArrhythmiaDetector_indentifyArrhythmia(self);
+    }
+    return count;
+}
+
+/* ECGSampleHandler for ECGAcquisition: tracks STSegmentHeight as the mean of
+   the block's samples outside QRS spikes. Subscribe per channel */
+void ArrhythmiaDetector_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count){
+    ArrhythmiaDetector* self = (ArrhythmiaDetector*)instance;
+    long sum = 0;
+    int n = sumBaseline(samples, count, &sum);
+
+    (void)channel;
+    if (n > 0) {
+        self->STSegmentHeight = (int)(sum / n);
+    }
 }
 
 void ArrhythmiaDetector_setItsTMDQueue(ArrhythmiaDetector* const self, struct TMDQueue* p_TMDQueue){
     self->itsTMDQueue = p_TMDQueue;
+    if (p_TMDQueue != NULL) {
+        TMDQueue_registerReader(p_TMDQueue, &self->reader);
+    }
 }
 
 ArrhythmiaDetector * ArrhythmiaDetector_Create(void){
@@ -44,4 +101,5 @@ ArrhythmiaDetector * ArrhythmiaDetector_Destroy(ArrhythmiaDetector* const self){
         ArrhythmiaDetector_Cleanup(self);
     }
     free(self);
+    return NULL;
 }
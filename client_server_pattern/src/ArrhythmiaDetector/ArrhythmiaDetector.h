@@ -15,7 +15,7 @@ struct ArrhythmiaDetector
     int Two_one_heartBlock;
     int prematureAtrialContraction;
     int flbrillation;
-    int index;
+    TMDQueueReader reader;
     struct TMDQueue* itsTMDQueue;
 };
 
@@ -25,6 +25,8 @@ void ArrhythmiaDetector_Cleanup(ArrhythmiaDetector* const self);
 
 void ArrhythmiaDetector_indentifyArrhythmia(ArrhythmiaDetector* const self);
 void ArrhythmiaDetector_getDataSample(ArrhythmiaDetector* const self);
+int  ArrhythmiaDetector_getDataBlock(ArrhythmiaDetector* const self);
+void ArrhythmiaDetector_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count);
 void ArrhythmiaDetector_setItsTMDQueue(ArrhythmiaDetector* const self, struct TMDQueue* p_TMDQueue);
 
 ArrhythmiaDetector * ArrhythmiaDetector_Create(void);
@@ -0,0 +1,336 @@
+//
+// Multi-channel ECG acquisition on a thread pool
+//
+
+#define _POSIX_C_SOURCE 200112L  // posix_memalign
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ECGAcquisition.h"
+
+typedef struct ECGWorker {
+    ECGAcquisition* self;
+    int worker;
+} ECGWorker;
+
+static void* acquisitionWorker(void* arg);
+static void* dispatchWorker(void* arg);
+static void acquireChannels(ECGAcquisition* const self, int worker);
+static void dispatchChannels(ECGAcquisition* const self, int worker);
+static void stopThreads(ECGAcquisition* const self);
+static size_t acquireInto(ECGChannel* const channel);
+static size_t dispatchFrom(const ECGAcquisition* const self, ECGChannel* const channel, int index);
+static size_t roundUpPowerOfTwo(size_t value);
+
+int ECGAcquisition_Init(ECGAcquisition* const self, int channelCount, int workerCount, size_t ringCapacity) {
+    size_t capacity = roundUpPowerOfTwo(ringCapacity < ECG_ACQ_BLOCK ? ECG_ACQ_BLOCK : ringCapacity);
+    void* channels = NULL;
+    int c;
+    int w;
+
+    memset(self, 0, sizeof(*self));
+    if (channelCount <= 0 || workerCount <= 0) {
+        return -1;
+    }
+    if (workerCount > channelCount) {
+        workerCount = channelCount;
+    }
+    if (posix_memalign(&channels, ECG_ACQ_CACHE_LINE, sizeof(ECGChannel) * (size_t)channelCount) != 0) {
+        return -1;
+    }
+    self->channels = (ECGChannel*)channels;
+    self->nChannels = channelCount;
+    self->nWorkers = workerCount;
+    memset(self->channels, 0, sizeof(ECGChannel) * (size_t)channelCount);
+    for (c = 0; c < channelCount; c++) {
+        ECGChannel* channel = &self->channels[c];
+        ECG_Module_Init(&channel->module);
+        ECG_Module_setLeadPair(&channel->module, c % 3, (c + 1) % 3);
+        channel->ring = (struct TimeMarkedData*)malloc(sizeof(struct TimeMarkedData) * capacity);
+        channel->mask = capacity - 1;
+        if (channel->ring == NULL) {
+            ECGAcquisition_Cleanup(self);
+            return -1;
+        }
+    }
+    self->threads = (pthread_t*)malloc(sizeof(pthread_t) * 2 * (size_t)workerCount);
+    if (self->threads == NULL) {
+        ECGAcquisition_Cleanup(self);
+        return -1;
+    }
+    /* from here on, workers != NULL means the lock and conditions exist */
+    self->workers = (ECGWorker*)malloc(sizeof(ECGWorker) * (size_t)workerCount);
+    if (self->workers == NULL) {
+        ECGAcquisition_Cleanup(self);
+        return -1;
+    }
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->start, NULL);
+    pthread_cond_init(&self->done, NULL);
+    for (w = 0; w < workerCount; w++) {
+        self->workers[w].self = self;
+        self->workers[w].worker = w;
+        if (pthread_create(&self->threads[self->nThreads], NULL, dispatchWorker, &self->workers[w]) != 0) {
+            break;
+        }
+        self->nThreads++;
+        if (pthread_create(&self->threads[self->nThreads], NULL, acquisitionWorker, &self->workers[w]) != 0) {
+            break;
+        }
+        self->nThreads++;
+    }
+    if (self->nThreads < 2 * workerCount) {
+        ECGAcquisition_Cleanup(self);
+        return -1;
+    }
+    return 0;
+}
+
+void ECGAcquisition_Cleanup(ECGAcquisition* const self) {
+    int c;
+
+    if (self->workers != NULL) {
+        stopThreads(self);
+    }
+    if (self->channels != NULL) {
+        for (c = 0; c < self->nChannels; c++) {
+            ECG_Module_Cleanup(&self->channels[c].module);
+            free(self->channels[c].ring);
+        }
+    }
+    free(self->channels);
+    free(self->threads);
+    free(self->workers);
+    self->channels = NULL;
+    self->threads = NULL;
+    self->workers = NULL;
+    self->nChannels = 0;
+}
+
+/* operation subscribe(int, void*, ECGSampleHandler) */
+int ECGAcquisition_subscribe(ECGAcquisition* const self, int channel, void* instance, ECGSampleHandler handler) {
+    ECGSubscriber* list;
+    int* count;
+
+    if (handler == NULL) {
+        return -1;
+    }
+    if (channel == ECG_ACQ_ALL_CHANNELS) {
+        list = self->allSubscribers;
+        count = &self->nAllSubscribers;
+    } else if (channel >= 0 && channel < self->nChannels) {
+        list = self->channels[channel].subscribers;
+        count = &self->channels[channel].nSubscribers;
+    } else {
+        return -1;
+    }
+    if (*count >= ECG_ACQ_MAX_SUBSCRIBERS) {
+        return -1;
+    }
+    list[*count].handler = handler;
+    list[*count].instance = instance;
+    ++*count;
+    return 0;
+}
+
+/* operation run(long) */
+int ECGAcquisition_run(ECGAcquisition* const self, long samplesPerChannel) {
+    int c;
+
+    if (self->workers == NULL) {
+        return -1;
+    }
+    pthread_mutex_lock(&self->lock);
+    for (c = 0; c < self->nChannels; c++) {
+        self->channels[c].target = self->channels[c].dispatched + samplesPerChannel;
+    }
+    self->active = self->nThreads;
+    self->generation++;
+    pthread_cond_broadcast(&self->start);
+    while (self->active > 0) {
+        pthread_cond_wait(&self->done, &self->lock);
+    }
+    pthread_mutex_unlock(&self->lock);
+    return 0;
+}
+
+ECG_Module* ECGAcquisition_getModule(ECGAcquisition* const self, int channel) {
+    return (channel >= 0 && channel < self->nChannels) ? &self->channels[channel].module : NULL;
+}
+
+long ECGAcquisition_getDispatched(const ECGAcquisition* const self, int channel) {
+    return (channel >= 0 && channel < self->nChannels) ? self->channels[channel].dispatched : -1;
+}
+
+ECGAcquisition * ECGAcquisition_Create(int channelCount, int workerCount, size_t ringCapacity) {
+    ECGAcquisition* self = (ECGAcquisition *) malloc(sizeof(ECGAcquisition));
+    if (self != NULL && ECGAcquisition_Init(self, channelCount, workerCount, ringCapacity) != 0) {
+        free(self);
+        self = NULL;
+    }
+    return self;
+}
+
+void ECGAcquisition_Destroy(ECGAcquisition* const self) {
+    if (self != NULL) {
+        ECGAcquisition_Cleanup(self);
+    }
+    free(self);
+}
+
+/* wait for the next run (or shutdown); returns 0 when the thread should exit */
+static int awaitRun(ECGAcquisition* const self, long* const seen) {
+    int go;
+
+    pthread_mutex_lock(&self->lock);
+    while (self->generation == *seen && !self->shutdown) {
+        pthread_cond_wait(&self->start, &self->lock);
+    }
+    go = !self->shutdown;
+    *seen = self->generation;
+    pthread_mutex_unlock(&self->lock);
+    return go;
+}
+
+static void finishRun(ECGAcquisition* const self) {
+    pthread_mutex_lock(&self->lock);
+    if (--self->active == 0) {
+        pthread_cond_signal(&self->done);
+    }
+    pthread_mutex_unlock(&self->lock);
+}
+
+static void* acquisitionWorker(void* arg) {
+    const ECGWorker* worker = (const ECGWorker*)arg;
+    long seen = 0;
+
+    while (awaitRun(worker->self, &seen)) {
+        acquireChannels(worker->self, worker->worker);
+        finishRun(worker->self);
+    }
+    return NULL;
+}
+
+static void* dispatchWorker(void* arg) {
+    const ECGWorker* worker = (const ECGWorker*)arg;
+    long seen = 0;
+
+    while (awaitRun(worker->self, &seen)) {
+        dispatchChannels(worker->self, worker->worker);
+        finishRun(worker->self);
+    }
+    return NULL;
+}
+
+static void stopThreads(ECGAcquisition* const self) {
+    int t;
+
+    pthread_mutex_lock(&self->lock);
+    self->shutdown = 1;
+    pthread_cond_broadcast(&self->start);
+    pthread_mutex_unlock(&self->lock);
+    for (t = 0; t < self->nThreads; t++) {
+        pthread_join(self->threads[t], NULL);
+    }
+    self->nThreads = 0;
+    pthread_cond_destroy(&self->done);
+    pthread_cond_destroy(&self->start);
+    pthread_mutex_destroy(&self->lock);
+}
+
+/* acquisition worker w fills the rings of channels w, w + nWorkers, ... */
+static void acquireChannels(ECGAcquisition* const self, int worker) {
+    int busy = 1;
+
+    while (busy) {
+        size_t moved = 0;
+        busy = 0;
+        for (int c = worker; c < self->nChannels; c += self->nWorkers) {
+            ECGChannel* channel = &self->channels[c];
+            if ((long)channel->module.dataNum < channel->target) {
+                busy = 1;
+                moved += acquireInto(channel);
+            }
+        }
+        if (busy && moved == 0) {
+            sched_yield(); /* every ring is full: let the dispatchers catch up */
+        }
+    }
+}
+
+/* dispatch worker w drains the same channels its acquisition twin fills */
+static void dispatchChannels(ECGAcquisition* const self, int worker) {
+    int busy = 1;
+
+    while (busy) {
+        size_t moved = 0;
+        busy = 0;
+        for (int c = worker; c < self->nChannels; c += self->nWorkers) {
+            ECGChannel* channel = &self->channels[c];
+            if (channel->dispatched < channel->target) {
+                busy = 1;
+                moved += dispatchFrom(self, channel, c);
+            }
+        }
+        if (busy && moved == 0) {
+            sched_yield(); /* every ring is empty: let the acquirers run */
+        }
+    }
+}
+
+/* producer side: acquire up to one block straight into the ring's free space */
+static size_t acquireInto(ECGChannel* const channel) {
+    size_t head = channel->head;
+    size_t tail = __atomic_load_n(&channel->tail, __ATOMIC_ACQUIRE);
+    size_t space = channel->mask + 1 - (head - tail);
+    size_t start = head & channel->mask;
+    long remaining = channel->target - (long)channel->module.dataNum;
+    size_t count = space < ECG_ACQ_BLOCK ? space : ECG_ACQ_BLOCK;
+
+    if ((long)count > remaining) {
+        count = (size_t)remaining;
+    }
+    if (count > channel->mask + 1 - start) {
+        count = channel->mask + 1 - start; /* stop at the end of the ring; the rest comes next pass */
+    }
+    if (count == 0) {
+        return 0;
+    }
+    ECG_Module_acquireBlock(&channel->module, &channel->ring[start], (int)count);
+    __atomic_store_n(&channel->head, head + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+/* consumer side: hand the next contiguous run of samples to every subscriber */
+static size_t dispatchFrom(const ECGAcquisition* const self, ECGChannel* const channel, int index) {
+    size_t tail = channel->tail;
+    size_t head = __atomic_load_n(&channel->head, __ATOMIC_ACQUIRE);
+    size_t start = tail & channel->mask;
+    size_t count = head - tail;
+    int s;
+
+    if (count > channel->mask + 1 - start) {
+        count = channel->mask + 1 - start;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    for (s = 0; s < channel->nSubscribers; s++) {
+        channel->subscribers[s].handler(channel->subscribers[s].instance, index, &channel->ring[start], (int)count);
+    }
+    for (s = 0; s < self->nAllSubscribers; s++) {
+        self->allSubscribers[s].handler(self->allSubscribers[s].instance, index, &channel->ring[start], (int)count);
+    }
+    channel->dispatched += (long)count;
+    __atomic_store_n(&channel->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+static size_t roundUpPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
@@ -0,0 +1,102 @@
+//
+// Multi-channel ECG acquisition on a thread pool
+//
+
+#ifndef CLIENT_SERVER_PATTERN_ECGACQUISITION_H
+#define CLIENT_SERVER_PATTERN_ECGACQUISITION_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "ECGPkg.h"
+#include "ECG_Module.h"
+#include "TimeMarkedData.h"
+
+#define ECG_ACQ_ALL_CHANNELS (-1)    /* subscribe to every channel */
+#define ECG_ACQ_MAX_SUBSCRIBERS (8)  /* per channel, and for all channels */
+#define ECG_ACQ_BLOCK (64)           /* samples moved per acquire or dispatch step */
+#define ECG_ACQ_CACHE_LINE (64)
+
+/* observer callback: count consecutive samples of one channel, oldest first */
+typedef void (*ECGSampleHandler)(void* instance, int channel, const struct TimeMarkedData* samples, int count);
+
+typedef struct ECGSubscriber {
+    ECGSampleHandler handler;
+    void* instance;
+} ECGSubscriber;
+
+/* compile-time check that the producer's fields leave room for headPad: the
+   array size goes negative, and the build fails, once ECG_Module outgrows a
+   cache line (C99 has no _Static_assert) */
+typedef char ECGChannelHeadFitsCacheLine[(sizeof(size_t) + sizeof(ECG_Module) < ECG_ACQ_CACHE_LINE) ? 1 : -1];
+
+/* one acquisition channel: an ECG_Module feeding a lock-free single-producer/
+   single-consumer ring. The first cache line is written only by the
+   acquisition worker, the second only by the dispatch worker, and the rest is
+   read-only while running; channels are cache-line aligned so neighbours
+   never share a line either. */
+typedef struct ECGChannel {
+    size_t head;                  /* next slot to fill */
+    ECG_Module module;
+    char headPad[ECG_ACQ_CACHE_LINE - sizeof(size_t) - sizeof(ECG_Module)];
+    size_t tail;                  /* next slot to dispatch */
+    long dispatched;              /* samples handed to subscribers so far */
+    char tailPad[ECG_ACQ_CACHE_LINE - sizeof(size_t) - sizeof(long)];
+    struct TimeMarkedData* ring;
+    size_t mask;
+    long target;                  /* samples to acquire in the current run */
+    int nSubscribers;
+    ECGSubscriber subscribers[ECG_ACQ_MAX_SUBSCRIBERS];
+} __attribute__((aligned(ECG_ACQ_CACHE_LINE))) ECGChannel;
+
+/* class ECGAcquisition
+   channel c is acquired by acquisition worker c % nWorkers and dispatched by
+   dispatch worker c % nWorkers, so each ring has exactly one producer and one
+   consumer and channels never share a lock. Per-channel subscribers are only
+   ever called from their channel's dispatch worker; all-channel subscribers
+   are called from every dispatch worker and must be thread-safe.
+   The worker threads are started once by Init and sleep on `start` between
+   runs; each run() wakes them with a new generation and waits on `done`. */
+typedef struct ECGAcquisition ECGAcquisition;
+struct ECGAcquisition {
+    int nChannels;
+    int nWorkers;
+    ECGChannel* channels;
+    int nAllSubscribers;
+    ECGSubscriber allSubscribers[ECG_ACQ_MAX_SUBSCRIBERS];
+    pthread_t* threads;           /* dispatch and acquisition thread of each worker */
+    struct ECGWorker* workers;    /* per-worker thread arguments */
+    int nThreads;                 /* threads started so far */
+    pthread_mutex_t lock;         /* guards everything below */
+    pthread_cond_t start;
+    pthread_cond_t done;
+    long generation;              /* incremented by every run() */
+    int active;                   /* threads still working on the current run */
+    int shutdown;                 /* set by Cleanup: threads exit */
+};
+
+/* Constructors and destructors:*/
+
+/* ringCapacity is rounded up to a power of two of at least ECG_ACQ_BLOCK.
+   Starts 2 * workerCount threads. Returns 0 on success, -1 on bad arguments,
+   allocation failure or if the threads could not be started */
+int ECGAcquisition_Init(ECGAcquisition* const self, int channelCount, int workerCount, size_t ringCapacity);
+void ECGAcquisition_Cleanup(ECGAcquisition* const self);
+
+/* Operations */
+
+/* register handler for one channel or ECG_ACQ_ALL_CHANNELS; not while running.
+   Returns 0, or -1 if the channel is out of range or its subscriber list is full */
+int ECGAcquisition_subscribe(ECGAcquisition* const self, int channel, void* instance, ECGSampleHandler handler);
+
+/* acquire samplesPerChannel more samples on every channel and deliver them to
+   the subscribers on the threads started by Init; blocks until all of them
+   have been dispatched. Returns 0, or -1 if the acquisition is not initialised */
+int ECGAcquisition_run(ECGAcquisition* const self, long samplesPerChannel);
+
+ECG_Module* ECGAcquisition_getModule(ECGAcquisition* const self, int channel);
+long ECGAcquisition_getDispatched(const ECGAcquisition* const self, int channel);
+
+ECGAcquisition * ECGAcquisition_Create(int channelCount, int workerCount, size_t ringCapacity);
+void ECGAcquisition_Destroy(ECGAcquisition* const self);
+
+#endif //CLIENT_SERVER_PATTERN_ECGACQUISITION_H
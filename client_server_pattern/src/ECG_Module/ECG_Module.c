@@ -9,6 +9,9 @@ static void cleanUpRelations(ECG_Module* const self);
 
 void ECG_Module_Init(ECG_Module* const self) {
     self->dataNum = 0;
+    self->lead1 = 0;
+    self->lead2 = 0;
+    self->noiseState = 1u;
     self->itsTMDQueue = NULL;
 }
 void ECG_Module_Cleanup(ECG_Module* const self) {
@@ -24,10 +27,33 @@ void ECG_Module_acquireValue(ECG_Module* const self) {
     TMDQueue_insert(self->itsTMDQueue, tmd);
 }
 
+/* operation acquireBlock(TimeMarkedData*, int)
+   fills samples with the next count values measured across the lead pair,
+   without touching the queue; safe to call concurrently on different modules.
+   The simulated signal is a QRS-like spike every ECG_BEAT_PERIOD samples whose
+   height depends on the lead pair, plus a little noise. */
+int ECG_Module_acquireBlock(ECG_Module* const self, struct TimeMarkedData* const samples, int count) {
+    int spike = 200 * (self->lead1 - self->lead2 + 4);
+    int i;
+
+    for (i = 0; i < count; i++) {
+        self->noiseState = self->noiseState * 1103515245u + 12345u;
+        ++self->dataNum;
+        samples[i].timeInterval = self->dataNum;
+        samples[i].dataValue = (int)((self->noiseState >> 16) % 41) - 20;
+        if (self->dataNum % ECG_BEAT_PERIOD < 4) {
+            samples[i].dataValue += spike;
+        }
+        samples[i].itsTMDQueue = NULL;
+    }
+    return count;
+}
+
 /* operation setLeadPair(int,int) */
 void ECG_Module_setLeadPair(ECG_Module* const self, int lead1, int lead2) {
     self->lead1 = lead1;
     self->lead2 = lead2;
+    self->noiseState = (unsigned int)(lead1 * 31 + lead2) * 2654435761u + 1u;
 }
 
 struct TMDQueue* ECG_Module_getItsTMDQueue(const ECG_Module* const self) {
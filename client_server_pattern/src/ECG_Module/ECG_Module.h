@@ -16,6 +16,7 @@ struct ECG_Module {
     int dataNum;
     int lead1;
     int lead2;
+    unsigned int noiseState;      /* per-module generator, so modules can run on separate threads */
     struct TMDQueue* itsTMDQueue;
 };
 /* Constructors and destructors:*/
@@ -26,6 +27,7 @@ void ECG_Module_Cleanup(ECG_Module* const self);
 /* Operations */
 
 void ECG_Module_acquireValue(ECG_Module* const self);
+int ECG_Module_acquireBlock(ECG_Module* const self, struct TimeMarkedData* const samples, int count);
 void ECG_Module_setLeadPair(ECG_Module* const self, int lead1, int lead2);
 struct TMDQueue* ECG_Module_getItsTMDQueue(const ECG_Module* const self);
 void ECG_Module_setItsTMDQueue(ECG_Module* const self, struct TMDQueue* p_TMDQueue);
@@ -20,4 +20,10 @@ typedef unsigned char boolean;
 
 #define QUEUE_SIZE (20000)
 
+/* samples between simulated beats from ECG_Module_acquireBlock */
+#define ECG_BEAT_PERIOD (160)
+#define ECG_SAMPLE_RATE_HZ (200)
+/* sample value a simulated QRS spike always crosses and noise never does */
+#define ECG_QRS_THRESHOLD (300)
+
 #endif //CLIENT_SERVER_PATTERN_ECGPKG_H
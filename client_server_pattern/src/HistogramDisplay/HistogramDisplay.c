@@ -9,7 +9,12 @@
 static void cleanUpRelations(HistogramDisplay* const self);
 
 void HistogramDisplay_Init(HistogramDisplay* const self) {
-    self->index = 0;
+    int bin;
+    for (bin = 0; bin < HISTOGRAM_BINS; bin++) {
+        self->bins[bin] = 0;
+    }
+    self->reader.nextSequence = 0;
+    self->reader.overruns = 0;
     self->itsTMDQueue = NULL;
 }
 
@@ -19,10 +24,16 @@ void HistogramDisplay_Cleanup(HistogramDisplay* const self) {
 
 /* operation getValue() */
 void HistogramDisplay_getValue(HistogramDisplay* const self) {
-    TimeMarkedData tmd;
-    tmd = TMDQueue_remove(self->itsTMDQueue, self->index);
-    printf("Histogram index: %d TimeInterval: %ld DataValue:%d\n", self->index, tmd.timeInterval, tmd.dataValue);
-    self->index = TMDQueue_getNextIndex(self->itsTMDQueue, self->index);
+    TMDQueueSpan span;
+    if (TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 1) == 0) {
+        printf("Histogram: no new sample\n");
+        return;
+    }
+    if (span.lost > 0) {
+        printf("Histogram overrun: %ld samples lost\n", span.lost);
+    }
+    printf("Histogram sample #%ld TimeInterval: %ld DataValue:%d\n", span.startSequence,
+           span.first[0].timeInterval, span.first[0].dataValue);
 }
 
 /* operation updateHistogram() */
@@ -32,12 +43,41 @@ void HistogramDisplay_updateHistogram(HistogramDisplay* const self) {
     (void)self;
 }
 
+/* ECGSampleHandler for ECGAcquisition. Safe to subscribe to all channels: the
+   block is binned locally and merged with one atomic add per touched bin, so
+   dispatch threads only meet on the shared bins once per block */
+void HistogramDisplay_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count) {
+    HistogramDisplay* self = (HistogramDisplay*)instance;
+    long local[HISTOGRAM_BINS] = {0};
+    int bin;
+    int i;
+
+    (void)channel;
+    for (i = 0; i < count; i++) {
+        int offset = samples[i].dataValue - HISTOGRAM_MIN;
+        bin = offset < 0 ? 0 : offset / HISTOGRAM_BIN_WIDTH;
+        local[bin < HISTOGRAM_BINS ? bin : HISTOGRAM_BINS - 1]++;
+    }
+    for (bin = 0; bin < HISTOGRAM_BINS; bin++) {
+        if (local[bin] != 0) {
+            __atomic_fetch_add(&self->bins[bin], local[bin], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+long HistogramDisplay_getBinCount(const HistogramDisplay* const self, int bin) {
+    return (bin >= 0 && bin < HISTOGRAM_BINS) ? __atomic_load_n(&self->bins[bin], __ATOMIC_RELAXED) : 0;
+}
+
 struct TMDQueue* HistogramDisplay_getItsTMDQueue(const HistogramDisplay* const self) {
     return (struct TMDQueue*)self->itsTMDQueue;
 }
 
 void HistogramDisplay_setItsTMDQueue(HistogramDisplay* const self, struct TMDQueue* p_TMDQueue) {
     self->itsTMDQueue = p_TMDQueue;
+    if (p_TMDQueue != NULL) {
+        TMDQueue_registerReader(p_TMDQueue, &self->reader);
+    }
 }
 
 HistogramDisplay * HistogramDisplay_Create(void) {
@@ -9,11 +9,16 @@
 #include "TMDQueue.h"
 
 
+#define HISTOGRAM_BINS (16)
+#define HISTOGRAM_MIN (-100)        /* lower edge of the first bin */
+#define HISTOGRAM_BIN_WIDTH (100)   /* values outside the range land in the end bins */
+
 /* class HistogramDisplay */
 typedef struct HistogramDisplay HistogramDisplay;
 
 struct HistogramDisplay {
-    int index;
+    long bins[HISTOGRAM_BINS];    /* updated atomically, see HistogramDisplay_onSamples */
+    TMDQueueReader reader;
     struct TMDQueue* itsTMDQueue;
 };
 
@@ -26,6 +31,8 @@ void HistogramDisplay_Cleanup(HistogramDisplay* const self);
 
 void HistogramDisplay_getValue(HistogramDisplay* const self);
 void HistogramDisplay_updateHistogram(HistogramDisplay* const self);
+void HistogramDisplay_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count);
+long HistogramDisplay_getBinCount(const HistogramDisplay* const self, int bin);
 struct TMDQueue* HistogramDisplay_getItsTMDQueue(const HistogramDisplay* const self);
 void HistogramDisplay_setItsTMDQueue(HistogramDisplay* const self, struct TMDQueue* p_TMDQueue);
 
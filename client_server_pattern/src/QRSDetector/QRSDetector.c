@@ -8,9 +8,30 @@
 
 static void cleanUpRelations(QRSDetector* const self);
 
+/* one rising edge through ECG_QRS_THRESHOLD per beat, heart rate from the latest R-R interval */
+static void detectBeats(QRSDetector* const self, const struct TimeMarkedData* samples, int count) {
+    int i;
+
+    for (i = 0; i < count; i++) {
+        int above = samples[i].dataValue > ECG_QRS_THRESHOLD;
+        if (above && !self->aboveThreshold) {
+            if (self->lastBeatTime >= 0 && samples[i].timeInterval > self->lastBeatTime) {
+                self->heartRate = (int)(60L * ECG_SAMPLE_RATE_HZ / (samples[i].timeInterval - self->lastBeatTime));
+            }
+            self->lastBeatTime = samples[i].timeInterval;
+            self->beatCount++;
+        }
+        self->aboveThreshold = above;
+    }
+}
+
 void QRSDetector_Init(QRSDetector* const self){
     self->heartRate = 0;
-    self->index = 0;
+    self->aboveThreshold = 0;
+    self->lastBeatTime = -1;
+    self->beatCount = 0;
+    self->reader.nextSequence = 0;
+    self->reader.overruns = 0;
     self->itsTMDQueue = NULL;
 }
 
@@ -23,14 +44,45 @@ void QRSDetector_computeHR(QRSDetector* const self){
 }
 
 void QRSDetector_getDataSample(QRSDetector* const self){
-    TimeMarkedData tmd;
-    tmd = TMDQueue_remove(self->itsTMDQueue, self->index);
-    printf("QRSDetector index: %d TimeInterval: %d  DataValue: %d\n", self->index, tmd.timeInterval, tmd.dataValue);
-    self->index = TMDQueue_getNextIndex(self->itsTMDQueue, self->index);
+    TMDQueueSpan span;
+    if (TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 1) == 0) {
+        printf("QRSDetector: no new sample\n");
+        return;
+    }
+    if (span.lost > 0) {
+        printf("QRSDetector overrun: %ld samples lost\n", span.lost);
+    }
+    printf("QRSDetector sample #%ld TimeInterval: %ld  DataValue: %d\n", span.startSequence,
+           span.first[0].timeInterval, span.first[0].dataValue);
+}
+
+/* processes every sample inserted since the last read in place, one block per wake-up */
+int QRSDetector_getDataBlock(QRSDetector* const self){
+    TMDQueueSpan span;
+    int count = TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 0);
+    if (span.lost > 0) {
+        printf("QRSDetector overrun: %ld samples lost\n", span.lost);
+    }
+    if (count > 0) {
+        printf("QRSDetector block: samples #%ld..#%ld\n", span.startSequence, span.startSequence + count - 1);
+        detectBeats(self, span.first, span.firstCount);
+        detectBeats(self, span.second, span.secondCount);
+    }
+    return count;
+}
+
+/* ECGSampleHandler for ECGAcquisition: same beat detection as getDataBlock.
+   Subscribe per channel */
+void QRSDetector_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count){
+    (void)channel;
+    detectBeats((QRSDetector*)instance, samples, count);
 }
 
 void QRSDetector_setItsTMDQueue(QRSDetector* const self, struct TMDQueue* p_TMDQueue){
     self->itsTMDQueue = p_TMDQueue;
+    if (p_TMDQueue != NULL) {
+        TMDQueue_registerReader(p_TMDQueue, &self->reader);
+    }
 }
 
 struct TMDQueue* QRSDetector_getItsTMDQueue(const QRSDetector* const self){
@@ -52,6 +104,7 @@ QRSDetector * QRSDetector_Destroy(QRSDetector* const self){
         QRSDetector_Cleanup(self);
     }
     free(self);
+    return NULL;
 }
 
 static void cleanUpRelations(QRSDetector* const self) {
@@ -15,7 +15,10 @@ typedef struct QRSDetector QRSDetector;
 struct QRSDetector
 {
     int heartRate;
-    int index;
+    int aboveThreshold;       /* last sample seen was inside a QRS spike */
+    long lastBeatTime;        /* timeInterval of the last rising edge, -1 if none */
+    long beatCount;
+    TMDQueueReader reader;
     struct TMDQueue* itsTMDQueue;
 };
 
@@ -25,6 +28,8 @@ void QRSDetector_Cleanup(QRSDetector* const self);
 
 void QRSDetector_computeHR(QRSDetector* const self);
 void QRSDetector_getDataSample(QRSDetector* const self);
+int  QRSDetector_getDataBlock(QRSDetector* const self);
+void QRSDetector_onSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count);
 void QRSDetector_setItsTMDQueue(QRSDetector* const self, struct TMDQueue* p_TMDQueue);
 struct TMDQueue* QRSDetector_getItsTMDQueue(const QRSDetector* const self);
 
@@ -2,7 +2,6 @@
 // Created by mahon on 12/27/2023.
 //
 
-#include <stdio.h>
 #include <stdlib.h>
 #include "TMDQueue.h"
 
@@ -12,6 +11,8 @@ static void cleanUpRelations(TMDQueue* const self);
 void TMDQueue_Init(TMDQueue* const self) {
     self->head = 0;
     self->size = 0;
+    self->sequence = 0;
+    self->writing = 0;
     initRelations(self);
 }
 void TMDQueue_Cleanup(TMDQueue* const self) {
@@ -28,13 +29,16 @@ void TMDQueue_insert(TMDQueue* const self, const struct TimeMarkedData tmd) {
     /* note that because we never ’remove’ data from this leaky queue, size only increases to
     the queue size and then stops increasing. Insertion always takes place at the head.
     */
-    printf("Inserting at: %d Data #: %ld", self->head, tmd.timeInterval);
+    /* announce the slot before overwriting it, so a reader validating a span
+       over it sees the overwrite even while it is still in progress */
+    __atomic_store_n(&self->writing, self->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
     self->buffer[self->head] = tmd;
     self->head = TMDQueue_getNextIndex(self, self->head);
     if (self->size < QUEUE_SIZE) {
         ++self->size;
         }
-    printf(" Storing data value: %d\n", tmd.dataValue);
+    __atomic_store_n(&self->sequence, self->sequence + 1, __ATOMIC_RELEASE);
 }
 /* operation isEmpty() */
 int TMDQueue_isEmpty(TMDQueue* const self) {
@@ -57,6 +61,64 @@ int TMDQueue_getBuffer(const TMDQueue* const self) {
     int iter = 0;
     return iter;
 }
+/* operation registerReader(TMDQueueReader)
+   the reader starts at the oldest sample still held, so nothing already
+   inserted is missed */
+void TMDQueue_registerReader(const TMDQueue* const self, TMDQueueReader* const reader) {
+    reader->nextSequence = self->sequence - self->size;
+    reader->overruns = 0;
+}
+/* operation readSpan(TMDQueueReader, TMDQueueSpan, int)
+   hands out up to maxCount unread samples (all of them if maxCount <= 0) as at
+   most two slices of the buffer, without copying, and advances the reader past
+   them. A reader that fell more than QUEUE_SIZE samples behind is moved up to the
+   oldest sample still held; the skipped samples are reported in span->lost and
+   added to reader->overruns. Returns the number of samples in the span.
+*/
+int TMDQueue_readSpan(const TMDQueue* const self, TMDQueueReader* const reader, TMDQueueSpan* const span,
+                      int maxCount) {
+    long sequence = __atomic_load_n(&self->sequence, __ATOMIC_ACQUIRE);
+    long oldest = (sequence > QUEUE_SIZE) ? sequence - QUEUE_SIZE : 0;
+    long available;
+    int count;
+    int start;
+
+    span->lost = 0;
+    if (reader->nextSequence < oldest) {
+        span->lost = oldest - reader->nextSequence;
+        reader->overruns += span->lost;
+        reader->nextSequence = oldest;
+    }
+
+    available = sequence - reader->nextSequence;
+    count = (maxCount > 0 && available > maxCount) ? maxCount : (int)available;
+    start = (int)(reader->nextSequence % QUEUE_SIZE);
+
+    span->startSequence = reader->nextSequence;
+    span->first = &self->buffer[start];
+    span->firstCount = (count < QUEUE_SIZE - start) ? count : QUEUE_SIZE - start;
+    span->second = &self->buffer[0];
+    span->secondCount = count - span->firstCount;
+
+    reader->nextSequence += count;
+    return count;
+}
+/* operation validateSpan(TMDQueueSpan)
+   re-checks a span after its samples were used: returns 1 if none of them has
+   been overwritten since readSpan handed it out, 0 if the writer lapped the
+   reader meanwhile and whatever was computed from the span must be dropped.
+   The oldest sample of a span is span->startSequence, and the writer marks a
+   slot in writing before storing into it, so that is the only value to check.
+*/
+int TMDQueue_validateSpan(const TMDQueue* const self, const TMDQueueSpan* const span) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&self->writing, __ATOMIC_RELAXED) <= span->startSequence + QUEUE_SIZE;
+}
+/* operation getSequence()
+   total number of samples inserted so far */
+long TMDQueue_getSequence(const TMDQueue* const self) {
+    return self->sequence;
+}
 TMDQueue * TMDQueue_Create(void) {
     TMDQueue* self = (TMDQueue *) malloc(sizeof(TMDQueue));
     if (self != NULL){
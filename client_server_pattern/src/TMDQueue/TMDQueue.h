@@ -13,8 +13,37 @@ typedef struct TMDQueue TMDQueue;
 struct TMDQueue {
     int head;
     int size;
+    long sequence;       /* number of samples ever inserted; sample n lives at buffer[n % QUEUE_SIZE] */
+    long writing;        /* sequence + 1 while an insert is storing its sample, else sequence */
     TimeMarkedData buffer[QUEUE_SIZE];
 };
+
+/* class TMDQueueReader
+   Cursor of one registered reader: the sequence number of the next sample it
+   wants, plus how many samples it lost because the writer lapped it. */
+typedef struct TMDQueueReader TMDQueueReader;
+
+struct TMDQueueReader {
+    long nextSequence;
+    long overruns;
+};
+
+/* class TMDQueueSpan
+   Unread samples handed out in place: first[0..firstCount) followed by
+   second[0..secondCount) when the block wraps around the end of the buffer.
+   The pointers stay valid until the writer inserts over them again; a reader
+   that may be lapped checks TMDQueue_validateSpan after using the samples and
+   discards its results if it fails, or copies the samples out first. */
+typedef struct TMDQueueSpan TMDQueueSpan;
+
+struct TMDQueueSpan {
+    const TimeMarkedData* first;
+    int firstCount;
+    const TimeMarkedData* second;
+    int secondCount;
+    long startSequence;  /* sequence number of first[0] */
+    long lost;           /* samples skipped by this read because the reader was lapped */
+};
 /* Constructors and destructors:*/
 void TMDQueue_Init(TMDQueue* const self);
 void TMDQueue_Cleanup(TMDQueue* const self);
@@ -26,6 +55,13 @@ int  TMDQueue_isEmpty(TMDQueue* const self);
 struct TimeMarkedData TMDQueue_remove(TMDQueue* const self, int index);
 int  TMDQueue_getBuffer(const TMDQueue* const self);
 
+/* Cursor-based reading */
+void TMDQueue_registerReader(const TMDQueue* const self, TMDQueueReader* const reader);
+int  TMDQueue_readSpan(const TMDQueue* const self, TMDQueueReader* const reader, TMDQueueSpan* const span,
+                       int maxCount);
+int  TMDQueue_validateSpan(const TMDQueue* const self, const TMDQueueSpan* const span);
+long TMDQueue_getSequence(const TMDQueue* const self);
+
 TMDQueue * TMDQueue_Create(void);
 void TMDQueue_Destroy(TMDQueue* const self);
 
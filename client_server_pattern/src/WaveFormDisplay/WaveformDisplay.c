@@ -7,7 +7,9 @@
 
 
 void WaveformDisplay_Init(WaveformDisplay* const self){
-
+    self->reader.nextSequence = 0;
+    self->reader.overruns = 0;
+    self->itsTMDQueue = NULL;
 }
 
 void WaveformDisplay_Cleanup(WaveformDisplay* const self){
@@ -15,14 +17,23 @@ void WaveformDisplay_Cleanup(WaveformDisplay* const self){
 }
 
 void WaveformDisplay_getScalarValue(WaveformDisplay* const self){
-    TimeMarkedData tmd;
-    tmd = TMDQueue_remove(self->itsTMDQueue, self->index);
-    printf("WaveformDisplay index: %d TimeInterval: %ld  DataValue: %d\n", self->index, tmd.timeInterval, tmd.dataValue);
-    self->index = TMDQueue_getNextIndex(self->itsTMDQueue, self->index);
+    TMDQueueSpan span;
+    if (TMDQueue_readSpan(self->itsTMDQueue, &self->reader, &span, 1) == 0) {
+        printf("WaveformDisplay: no new sample\n");
+        return;
+    }
+    if (span.lost > 0) {
+        printf("WaveformDisplay overrun: %ld samples lost\n", span.lost);
+    }
+    printf("WaveformDisplay sample #%ld TimeInterval: %ld  DataValue: %d\n", span.startSequence,
+           span.first[0].timeInterval, span.first[0].dataValue);
 }
 
 void WaveformDisplay_setItsTMDQueue(WaveformDisplay* const self, struct TMDQueue* p_TMDQueue){
     self->itsTMDQueue = p_TMDQueue;
+    if (p_TMDQueue != NULL) {
+        TMDQueue_registerReader(p_TMDQueue, &self->reader);
+    }
 }
 
 WaveformDisplay* WaveformDisplay_Create(void){
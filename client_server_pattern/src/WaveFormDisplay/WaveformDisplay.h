@@ -13,7 +13,7 @@
 typedef struct WaveformDisplay WaveformDisplay;
 struct WaveformDisplay
 {
-    int index;
+    TMDQueueReader reader;
     struct TMDQueue* itsTMDQueue;
 };
 
@@ -0,0 +1,138 @@
+#include <unity.h>
+#include <string.h>
+#include "ECGAcquisition.h"
+#include "HistogramDisplay.h"
+#include "QRSDetector.h"
+#include "ArrhythmiaDetector.h"
+
+#define CHANNELS 6
+#define SAMPLES 10000L
+
+/* Per-channel observer that checks it sees its channel's samples in order */
+typedef struct {
+    int channel;
+    long samples;
+    long lastTime;
+    long outOfOrder;
+    long wrongChannel;
+} Recorder;
+
+static ECGAcquisition acquisition;
+static Recorder recorders[CHANNELS];
+static long allChannelSamples;
+
+static void recordSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count) {
+    Recorder* recorder = (Recorder*)instance;
+    recorder->wrongChannel += channel != recorder->channel;
+    for (int i = 0; i < count; i++) {
+        recorder->outOfOrder += samples[i].timeInterval != recorder->lastTime + 1;
+        recorder->lastTime = samples[i].timeInterval;
+    }
+    recorder->samples += count;
+}
+
+static void countSamples(void* instance, int channel, const struct TimeMarkedData* samples, int count) {
+    (void)instance;
+    (void)channel;
+    (void)samples;
+    __atomic_fetch_add(&allChannelSamples, (long)count, __ATOMIC_RELAXED);
+}
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_Init(&acquisition, CHANNELS, 3, 256));
+    for (int c = 0; c < CHANNELS; c++) {
+        recorders[c] = (Recorder){c, 0, 0, 0, 0};
+        TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_subscribe(&acquisition, c, &recorders[c], recordSamples));
+    }
+    allChannelSamples = 0;
+}
+
+void tearDown(void) {
+    ECGAcquisition_Cleanup(&acquisition);
+}
+
+void test_every_sample_reaches_its_channel_in_order(void) {
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_subscribe(&acquisition, ECG_ACQ_ALL_CHANNELS, NULL, countSamples));
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, SAMPLES));
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, SAMPLES / 2));
+    for (int c = 0; c < CHANNELS; c++) {
+        TEST_ASSERT_EQUAL_INT(SAMPLES * 3 / 2, recorders[c].samples);
+        TEST_ASSERT_EQUAL_INT(SAMPLES * 3 / 2, ECGAcquisition_getDispatched(&acquisition, c));
+        TEST_ASSERT_EQUAL_INT(0, recorders[c].outOfOrder);
+        TEST_ASSERT_EQUAL_INT(0, recorders[c].wrongChannel);
+    }
+    TEST_ASSERT_EQUAL_INT(CHANNELS * SAMPLES * 3 / 2, allChannelSamples);
+}
+
+static pthread_t deliveringThread;
+
+static void recordThread(void* instance, int channel, const struct TimeMarkedData* samples, int count) {
+    (void)instance;
+    (void)channel;
+    (void)samples;
+    (void)count;
+    deliveringThread = pthread_self();
+}
+
+void test_runs_reuse_the_worker_threads(void) {
+    pthread_t threads[2 * CHANNELS];
+    pthread_t firstRun;
+
+    TEST_ASSERT_EQUAL_INT(6, acquisition.nThreads);  // 3 workers, a dispatch and an acquisition thread each
+    memcpy(threads, acquisition.threads, sizeof(pthread_t) * (size_t)acquisition.nThreads);
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_subscribe(&acquisition, 0, NULL, recordThread));
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, 10));
+    firstRun = deliveringThread;
+    for (int run = 0; run < 1000; run++) {
+        TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, 1));
+        TEST_ASSERT_TRUE(pthread_equal(firstRun, deliveringThread));
+    }
+    for (int t = 0; t < acquisition.nThreads; t++) {
+        TEST_ASSERT_TRUE(pthread_equal(threads[t], acquisition.threads[t]));
+    }
+    TEST_ASSERT_EQUAL_INT(1010, ECGAcquisition_getDispatched(&acquisition, 0));
+}
+
+void test_subscribe_rejects_bad_channels(void) {
+    TEST_ASSERT_EQUAL_INT(-1, ECGAcquisition_subscribe(&acquisition, CHANNELS, NULL, countSamples));
+    TEST_ASSERT_EQUAL_INT(-1, ECGAcquisition_subscribe(&acquisition, -2, NULL, countSamples));
+    TEST_ASSERT_EQUAL_INT(-1, ECGAcquisition_subscribe(&acquisition, 0, NULL, NULL));
+}
+
+void test_detectors_observe_channels(void) {
+    HistogramDisplay histogram;
+    QRSDetector qrs;
+    ArrhythmiaDetector arrhythmia;
+    long total = 0;
+
+    HistogramDisplay_Init(&histogram);
+    QRSDetector_Init(&qrs);
+    ArrhythmiaDetector_Init(&arrhythmia);
+    ECGAcquisition_subscribe(&acquisition, ECG_ACQ_ALL_CHANNELS, &histogram, HistogramDisplay_onSamples);
+    ECGAcquisition_subscribe(&acquisition, 1, &qrs, QRSDetector_onSamples);
+    ECGAcquisition_subscribe(&acquisition, 1, &arrhythmia, ArrhythmiaDetector_onSamples);
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, SAMPLES));
+
+    for (int bin = 0; bin < HISTOGRAM_BINS; bin++) {
+        total += HistogramDisplay_getBinCount(&histogram, bin);
+    }
+    TEST_ASSERT_EQUAL_INT(CHANNELS * SAMPLES, total);
+    TEST_ASSERT_EQUAL_INT(SAMPLES / ECG_BEAT_PERIOD + 1, qrs.beatCount); // first spike at t = 1
+    TEST_ASSERT_EQUAL_INT(60 * ECG_SAMPLE_RATE_HZ / ECG_BEAT_PERIOD, qrs.heartRate);
+    TEST_ASSERT_INT_WITHIN(20, 0, arrhythmia.STSegmentHeight);
+
+    QRSDetector_Cleanup(&qrs);
+    ArrhythmiaDetector_Cleanup(&arrhythmia);
+    HistogramDisplay_Cleanup(&histogram);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_every_sample_reaches_its_channel_in_order);
+    RUN_TEST(test_runs_reuse_the_worker_threads);
+    RUN_TEST(test_subscribe_rejects_bad_channels);
+    RUN_TEST(test_detectors_observe_channels);
+
+    return UNITY_END();
+}
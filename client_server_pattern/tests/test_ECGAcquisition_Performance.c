@@ -0,0 +1,116 @@
+//
+// Scaling benchmark for ECGAcquisition
+//
+// Acquires the same number of samples on CHANNELS channels with 1, 2, 4 and
+// 8 workers and reports channel-samples per second, the speedup over one
+// worker and how many 200 Hz channels that throughput would sustain. Each
+// channel has a QRSDetector and an ArrhythmiaDetector, and one
+// HistogramDisplay watches every channel, so the work per sample resembles a
+// real monitor. Speedup can only approach the worker count when the machine
+// has at least twice that many cores (one acquisition and one dispatch thread
+// per worker); with fewer cores the extra workers just time-share.
+//
+// Categories:
+// - Throughput and speedup versus worker count
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime, sysconf
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "unity.h"
+#include "ECGAcquisition.h"
+#include "HistogramDisplay.h"
+#include "QRSDetector.h"
+#include "ArrhythmiaDetector.h"
+
+#define CHANNELS 16
+#define SAMPLES_PER_CHANNEL 2000000L
+#define RING_CAPACITY 4096
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Run one acquisition with the given worker count, return channel-samples/s
+ */
+static double measure(int workers) {
+    ECGAcquisition acquisition;
+    QRSDetector qrs[CHANNELS];
+    ArrhythmiaDetector arrhythmia[CHANNELS];
+    HistogramDisplay histogram;
+
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_Init(&acquisition, CHANNELS, workers, RING_CAPACITY));
+    HistogramDisplay_Init(&histogram);
+    ECGAcquisition_subscribe(&acquisition, ECG_ACQ_ALL_CHANNELS, &histogram, HistogramDisplay_onSamples);
+    for (int c = 0; c < CHANNELS; c++) {
+        QRSDetector_Init(&qrs[c]);
+        ArrhythmiaDetector_Init(&arrhythmia[c]);
+        ECGAcquisition_subscribe(&acquisition, c, &qrs[c], QRSDetector_onSamples);
+        ECGAcquisition_subscribe(&acquisition, c, &arrhythmia[c], ArrhythmiaDetector_onSamples);
+    }
+
+    double start = nowNanos();
+    TEST_ASSERT_EQUAL_INT(0, ECGAcquisition_run(&acquisition, SAMPLES_PER_CHANNEL));
+    double elapsed = nowNanos() - start;
+
+    for (int c = 0; c < CHANNELS; c++) {
+        TEST_ASSERT_EQUAL_INT(SAMPLES_PER_CHANNEL, ECGAcquisition_getDispatched(&acquisition, c));
+        TEST_ASSERT_EQUAL_INT(60 * ECG_SAMPLE_RATE_HZ / ECG_BEAT_PERIOD, qrs[c].heartRate);
+        QRSDetector_Cleanup(&qrs[c]);
+        ArrhythmiaDetector_Cleanup(&arrhythmia[c]);
+    }
+    HistogramDisplay_Cleanup(&histogram);
+    ECGAcquisition_Cleanup(&acquisition);
+    return (double)CHANNELS * SAMPLES_PER_CHANNEL / elapsed * 1e9;
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_Performance_WorkerScaling(void) {
+    static const int workerCounts[] = {1, 2, 4, 8};
+    double baseline = 0.0;
+
+    printf("%d channels, %ld samples each, %ld online CPUs\n",
+           CHANNELS, SAMPLES_PER_CHANNEL, sysconf(_SC_NPROCESSORS_ONLN));
+    for (size_t i = 0; i < sizeof(workerCounts) / sizeof(workerCounts[0]); i++) {
+        double rate = measure(workerCounts[i]);
+        if (i == 0) {
+            baseline = rate;
+        }
+        printf("%d worker(s): %7.1f Msamples/s  speedup %.2fx  (~%.0f channels at %d Hz)\n",
+               workerCounts[i], rate / 1e6, rate / baseline, rate / ECG_SAMPLE_RATE_HZ, ECG_SAMPLE_RATE_HZ);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== ECGAcquisition Scaling Benchmark ===\n");
+    RUN_TEST(test_Performance_WorkerScaling);
+
+    return UNITY_END();
+}
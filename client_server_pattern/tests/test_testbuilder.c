@@ -1,23 +1,193 @@
 #include <unity.h>
+#include "TMDQueue.h"
+#include "TimeMarkedData.h"
+#include "QRSDetector.h"
+#include "ArrhythmiaDetector.h"
+
+static TMDQueue* queue;
 
 void setUp(void) {
-    // Initialize before each test
+    queue = TMDQueue_Create();
 }
 
 void tearDown(void) {
-    // Clean up after each test
+    TMDQueue_Destroy(queue);
+}
+
+static void insertSamples(long first, long count) {
+    TimeMarkedData tmd;
+    for (long i = first; i < first + count; i++) {
+        tmd.timeInterval = i;
+        tmd.dataValue = (int)(i % 1000);
+        TMDQueue_insert(queue, tmd);
+    }
+}
+
+/* walks both slices of a span and checks they hold consecutive samples from expectedFirst */
+static void assertSpanIsConsecutive(const TMDQueueSpan* span, long expectedFirst) {
+    long expected = expectedFirst;
+    for (int i = 0; i < span->firstCount; i++, expected++) {
+        TEST_ASSERT_EQUAL_INT(expected, span->first[i].timeInterval);
+    }
+    for (int i = 0; i < span->secondCount; i++, expected++) {
+        TEST_ASSERT_EQUAL_INT(expected, span->second[i].timeInterval);
+    }
+}
+
+void test_readSpan_returns_new_samples_in_order(void) {
+    TMDQueueReader reader;
+    TMDQueueSpan span;
+
+    TMDQueue_registerReader(queue, &reader);
+    TEST_ASSERT_EQUAL_INT(0, TMDQueue_readSpan(queue, &reader, &span, 0));
+
+    insertSamples(0, 10);
+    TEST_ASSERT_EQUAL_INT(4, TMDQueue_readSpan(queue, &reader, &span, 4));
+    TEST_ASSERT_EQUAL_INT(0, span.startSequence);
+    TEST_ASSERT_EQUAL_INT(4, span.firstCount);
+    TEST_ASSERT_EQUAL_INT(0, span.secondCount);
+    assertSpanIsConsecutive(&span, 0);
+
+    TEST_ASSERT_EQUAL_INT(6, TMDQueue_readSpan(queue, &reader, &span, 0));
+    TEST_ASSERT_EQUAL_INT(4, span.startSequence);
+    TEST_ASSERT_EQUAL_INT(0, span.lost);
+    assertSpanIsConsecutive(&span, 4);
+    TEST_ASSERT_EQUAL_INT(10, TMDQueue_getSequence(queue));
+}
+
+void test_readSpan_splits_at_the_end_of_the_buffer(void) {
+    TMDQueueReader reader;
+    TMDQueueSpan span;
+
+    insertSamples(0, QUEUE_SIZE - 3);
+    TMDQueue_registerReader(queue, &reader);
+    TEST_ASSERT_EQUAL_INT(QUEUE_SIZE - 3, TMDQueue_readSpan(queue, &reader, &span, 0));
+
+    insertSamples(QUEUE_SIZE - 3, 8);
+    TEST_ASSERT_EQUAL_INT(8, TMDQueue_readSpan(queue, &reader, &span, 0));
+    TEST_ASSERT_EQUAL_INT(3, span.firstCount);
+    TEST_ASSERT_EQUAL_INT(5, span.secondCount);
+    assertSpanIsConsecutive(&span, QUEUE_SIZE - 3);
+}
+
+void test_readSpan_reports_overrun(void) {
+    TMDQueueReader reader;
+    TMDQueueSpan span;
+
+    TMDQueue_registerReader(queue, &reader);
+    insertSamples(0, QUEUE_SIZE + 25);
+
+    TEST_ASSERT_EQUAL_INT(QUEUE_SIZE, TMDQueue_readSpan(queue, &reader, &span, 0));
+    TEST_ASSERT_EQUAL_INT(25, span.lost);
+    TEST_ASSERT_EQUAL_INT(25, reader.overruns);
+    TEST_ASSERT_EQUAL_INT(25, span.startSequence);
+    assertSpanIsConsecutive(&span, 25);
 }
 
-// Example test
-void test_function_should_do_something(void) {
-    TEST_ASSERT_EQUAL(1, 1);
+void test_readers_have_independent_cursors(void) {
+    TMDQueueReader fast;
+    TMDQueueReader slow;
+    TMDQueueSpan span;
+
+    TMDQueue_registerReader(queue, &fast);
+    TMDQueue_registerReader(queue, &slow);
+    insertSamples(0, 6);
+
+    TEST_ASSERT_EQUAL_INT(6, TMDQueue_readSpan(queue, &fast, &span, 0));
+    TEST_ASSERT_EQUAL_INT(1, TMDQueue_readSpan(queue, &slow, &span, 1));
+    TEST_ASSERT_EQUAL_INT(0, span.startSequence);
+
+    insertSamples(6, 2);
+    TEST_ASSERT_EQUAL_INT(2, TMDQueue_readSpan(queue, &fast, &span, 0));
+    TEST_ASSERT_EQUAL_INT(6, span.startSequence);
+    TEST_ASSERT_EQUAL_INT(7, TMDQueue_readSpan(queue, &slow, &span, 0));
+    TEST_ASSERT_EQUAL_INT(1, span.startSequence);
+    assertSpanIsConsecutive(&span, 1);
+}
+
+void test_validateSpan_detects_a_lapping_writer(void) {
+    TMDQueueReader reader;
+    TMDQueueSpan span;
+
+    TMDQueue_registerReader(queue, &reader);
+    insertSamples(0, 10);
+    TEST_ASSERT_EQUAL_INT(10, TMDQueue_readSpan(queue, &reader, &span, 0));
+    insertSamples(10, QUEUE_SIZE - 10);
+    TEST_ASSERT_EQUAL_INT(1, TMDQueue_validateSpan(queue, &span));  /* buffer full, nothing reused yet */
+
+    insertSamples(QUEUE_SIZE, 1);
+    TEST_ASSERT_EQUAL_INT(0, TMDQueue_validateSpan(queue, &span));  /* sample 0 overwritten */
+}
+
+void test_validateSpan_sees_an_insert_in_progress(void) {
+    TMDQueueReader reader;
+    TMDQueueSpan span;
+
+    insertSamples(0, QUEUE_SIZE);
+    TMDQueue_registerReader(queue, &reader);
+    TEST_ASSERT_EQUAL_INT(QUEUE_SIZE, TMDQueue_readSpan(queue, &reader, &span, 0));
+    TEST_ASSERT_EQUAL_INT(1, TMDQueue_validateSpan(queue, &span));
+
+    queue->writing = queue->sequence + 1;  /* writer has claimed the oldest slot, not stored yet */
+    TEST_ASSERT_EQUAL_INT(0, TMDQueue_validateSpan(queue, &span));
+}
+
+void test_detector_block_read_consumes_everything_new(void) {
+    QRSDetector detector;
+
+    QRSDetector_Init(&detector);
+    QRSDetector_setItsTMDQueue(&detector, queue);
+    insertSamples(0, 50);
+    TEST_ASSERT_EQUAL_INT(50, QRSDetector_getDataBlock(&detector));
+    TEST_ASSERT_EQUAL_INT(0, QRSDetector_getDataBlock(&detector));
+    QRSDetector_Cleanup(&detector);
+}
+
+/* beats every ECG_BEAT_PERIOD samples on a flat baseline, read in blocks that wrap the buffer */
+void test_detector_blocks_process_their_samples(void) {
+    QRSDetector qrs;
+    ArrhythmiaDetector arrhythmia;
+    TimeMarkedData tmd;
+    long start = QUEUE_SIZE - 500;
+
+    QRSDetector_Init(&qrs);
+    ArrhythmiaDetector_Init(&arrhythmia);
+    QRSDetector_setItsTMDQueue(&qrs, queue);
+    ArrhythmiaDetector_setItsTMDQueue(&arrhythmia, queue);
+    for (long i = 0; i < start; i++) {
+        tmd.timeInterval = i;
+        tmd.dataValue = 0;
+        TMDQueue_insert(queue, tmd);
+    }
+    TEST_ASSERT_EQUAL_INT(start, QRSDetector_getDataBlock(&qrs));
+    TEST_ASSERT_EQUAL_INT(start, ArrhythmiaDetector_getDataBlock(&arrhythmia));
+    TEST_ASSERT_EQUAL_INT(0, qrs.beatCount);
+    for (long i = 0; i < 1000; i++) {
+        tmd.timeInterval = start + i;
+        tmd.dataValue = (i % ECG_BEAT_PERIOD == 0) ? 1000 : 50;
+        TMDQueue_insert(queue, tmd);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1000, QRSDetector_getDataBlock(&qrs));
+    TEST_ASSERT_EQUAL_INT(1000, ArrhythmiaDetector_getDataBlock(&arrhythmia));
+    TEST_ASSERT_EQUAL_INT(7, qrs.beatCount);
+    TEST_ASSERT_EQUAL_INT(60 * ECG_SAMPLE_RATE_HZ / ECG_BEAT_PERIOD, qrs.heartRate);
+    TEST_ASSERT_EQUAL_INT(50, arrhythmia.STSegmentHeight);
+    QRSDetector_Cleanup(&qrs);
+    ArrhythmiaDetector_Cleanup(&arrhythmia);
 }
 
 int main(void) {
     UNITY_BEGIN();
 
-    // Register tests here
-    RUN_TEST(test_function_should_do_something);
+    RUN_TEST(test_readSpan_returns_new_samples_in_order);
+    RUN_TEST(test_readSpan_splits_at_the_end_of_the_buffer);
+    RUN_TEST(test_readSpan_reports_overrun);
+    RUN_TEST(test_readers_have_independent_cursors);
+    RUN_TEST(test_validateSpan_detects_a_lapping_writer);
+    RUN_TEST(test_validateSpan_sees_an_insert_in_progress);
+    RUN_TEST(test_detector_block_read_consumes_everything_new);
+    RUN_TEST(test_detector_blocks_process_their_samples);
 
     return UNITY_END();
 }
@@ -0,0 +1,194 @@
+//
+// NumberScanner Implementation
+//
+// This file implements the character-class scanning kernel. The vector
+// paths compare a whole block of bytes against the digit, dot and
+// whitespace classes at once and turn the results into bitmasks; run
+// lengths are then found with a count-trailing-zeros on the inverted mask,
+// so a caller classifies each block once and jumps between boundaries.
+//
+
+#include "NumberScanner.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NUMBERSCANNER_USE_SSE2
+#endif
+
+/*
+ * ============================================================================
+ * INTERNAL HELPERS
+ * ============================================================================
+ */
+
+/**
+ * @brief Scalar classification of bytes [from, len) of a block
+ */
+static void classifyScalar(const char* buf, size_t from, size_t len, NumberScanMasks* masks) {
+    for (size_t i = from; i < len; i++) {
+        unsigned char c = (unsigned char)buf[i];
+        uint32_t bit = (uint32_t)1u << i;
+
+        if (c >= '0' && c <= '9') {
+            masks->digit |= bit;
+        } else if (c == '.') {
+            masks->dot |= bit;
+        } else if (c == ' ' || (c >= '\t' && c <= '\r')) {
+            masks->space |= bit;
+        }
+    }
+}
+
+#if defined(NUMBERSCANNER_USE_SSE2)
+/**
+ * @brief SSE2 classification of 16 bytes starting at buf
+ */
+static void classify16(const char* buf, uint32_t* digit, uint32_t* dot, uint32_t* space) {
+    const __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)buf);
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                          _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+    const __m128i isDot = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('.'));
+    const __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                         _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('\t' - 1)),
+                                                       _mm_cmplt_epi8(bytes, _mm_set1_epi8('\r' + 1))));
+
+    *digit = (uint32_t)_mm_movemask_epi8(isDigit);
+    *dot = (uint32_t)_mm_movemask_epi8(isDot);
+    *space = (uint32_t)_mm_movemask_epi8(isSpace);
+}
+#endif
+
+/*
+ * ============================================================================
+ * SCANNING FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Classify up to NUMBERSCANNER_BLOCK_SIZE bytes at once
+ * @param buf Input bytes
+ * @param len Number of bytes to classify (bytes beyond 32 are ignored)
+ * @param masks Receives the digit, dot and whitespace masks
+ * @return Number of bytes classified
+ *
+ * Full blocks go through the widest vector path available; a short tail is
+ * classified with scalar code so no byte past buf + len is ever read.
+ */
+size_t NumberScanner_classify(const char* buf, size_t len, NumberScanMasks* masks) {
+    size_t done = 0;
+
+    if (len > NUMBERSCANNER_BLOCK_SIZE) {
+        len = NUMBERSCANNER_BLOCK_SIZE;
+    }
+    masks->digit = 0;
+    masks->dot = 0;
+    masks->space = 0;
+
+#if defined(__AVX2__)
+    if (len == NUMBERSCANNER_BLOCK_SIZE) {
+        const __m256i bytes = _mm256_loadu_si256((const __m256i*)(const void*)buf);
+        const __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('0' - 1)),
+                                                 _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bytes));
+        const __m256i isDot = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('.'));
+        const __m256i isSpace = _mm256_or_si256(
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+            _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('\t' - 1)),
+                             _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), bytes)));
+
+        masks->digit = (uint32_t)_mm256_movemask_epi8(isDigit);
+        masks->dot = (uint32_t)_mm256_movemask_epi8(isDot);
+        masks->space = (uint32_t)_mm256_movemask_epi8(isSpace);
+        done = NUMBERSCANNER_BLOCK_SIZE;
+    }
+#elif defined(NUMBERSCANNER_USE_SSE2)
+    for (; done + 16 <= len; done += 16) {
+        uint32_t digit;
+        uint32_t dot;
+        uint32_t space;
+
+        classify16(buf + done, &digit, &dot, &space);
+        masks->digit |= digit << done;
+        masks->dot |= dot << done;
+        masks->space |= space << done;
+    }
+#endif
+
+    classifyScalar(buf, done, len, masks);
+    return len;
+}
+
+/*
+ * ============================================================================
+ * BULK ACCUMULATION FUNCTIONS
+ * ============================================================================
+ */
+
+// Largest integer such that every smaller integer is exactly representable
+#define EXACT_INTEGER_LIMIT 9007199254740992ULL  // 2^53
+
+/**
+ * @brief Convert up to eight digits to their integer value
+ * @param digits Digit characters
+ * @param n Number of digits (1-8)
+ * @return Integer value of the digits
+ */
+static uint64_t parseGroup(const char* digits, size_t n) {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        value = value * 10u + (uint64_t)(digits[i] - '0');
+    }
+    return value;
+}
+
+double NumberScanner_appendWhole(double result, const char* digits, size_t n) {
+    static const uint64_t powersOfTen[9] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL
+    };
+    // Largest prefix that still stays below 2^53 after appending g digits
+    static const uint64_t prefixLimit[9] = {
+        EXACT_INTEGER_LIMIT / 1ULL - 2u, EXACT_INTEGER_LIMIT / 10ULL - 2u,
+        EXACT_INTEGER_LIMIT / 100ULL - 2u, EXACT_INTEGER_LIMIT / 1000ULL - 2u,
+        EXACT_INTEGER_LIMIT / 10000ULL - 2u, EXACT_INTEGER_LIMIT / 100000ULL - 2u,
+        EXACT_INTEGER_LIMIT / 1000000ULL - 2u, EXACT_INTEGER_LIMIT / 10000000ULL - 2u,
+        EXACT_INTEGER_LIMIT / 100000000ULL - 2u
+    };
+    size_t i = 0;
+
+    // Bulk path: exact integer arithmetic, eight digits at a time
+    if (result >= 0.0 && result < (double)EXACT_INTEGER_LIMIT) {
+        uint64_t value = (uint64_t)result;
+
+        if ((double)value == result) {
+            while (i < n) {
+                size_t group = n - i < 8 ? n - i : 8;
+
+                if (value > prefixLimit[group]) {
+                    break;  // The next group could leave the exact range
+                }
+                value = value * powersOfTen[group] + parseGroup(digits + i, group);
+                i += group;
+            }
+            result = (double)value;
+        }
+    }
+
+    // Sequential path for anything outside the exact range
+    for (; i < n; i++) {
+        result = result * 10 + (digits[i] - '0');
+    }
+    return result;
+}
+
+double NumberScanner_appendFraction(double result, double* tensPlace, const char* digits, size_t n) {
+    double place = *tensPlace;
+
+    for (size_t i = 0; i < n; i++) {
+        result += (digits[i] - '0') / place;
+        place *= 10.0;
+    }
+    *tensPlace = place;
+    return result;
+}
@@ -6,6 +6,7 @@
 #include "Button.h"
 #include "MicrowaveEmitter.h"
 #include "Timer.h"
+#include "DebounceEngine.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -16,6 +17,13 @@
  */
 static void cleanUpRelations(ButtonDriver* const me);
 
+/**
+ * @brief Act on a debounced button state
+ * @param me Pointer to the ButtonDriver instance
+ * @param currentState Debounced button state
+ */
+static void handleState(ButtonDriver* const me, int currentState);
+
 void ButtonDriver_Init(ButtonDriver* const me) {
     if (me != NULL) {
         me->oldState = 0;
@@ -23,6 +31,8 @@ void ButtonDriver_Init(ButtonDriver* const me) {
         me->itsButton = NULL;
         me->itsMicrowaveEmitter = NULL;
         me->itsTimer = NULL;
+        me->itsDebounceEngine = NULL;
+        me->debounceInput = 0;
     }
 }
 
@@ -38,20 +48,40 @@ void ButtonDriver_Cleanup(ButtonDriver* const me) {
  */
 void ButtonDriver_eventReceive(ButtonDriver* const me) {
     /* Ensure all required components are available */
-    if (me == NULL || me->itsTimer == NULL || me->itsButton == NULL || me->itsMicrowaveEmitter == NULL) {
+    if (me == NULL || (me->itsTimer == NULL && me->itsDebounceEngine == NULL) ||
+        me->itsButton == NULL || me->itsMicrowaveEmitter == NULL) {
         printf("ButtonDriver: Missing required components\n");
         return;
     }
 
+    /* Hand the edge to the debounce engine; it calls back once the level is stable */
+    if (me->itsDebounceEngine != NULL) {
+        DebounceEngine_edge(me->itsDebounceEngine, me->debounceInput, Button_getState(me->itsButton),
+                            DebounceEngine_now(me->itsDebounceEngine));
+        return;
+    }
+
     /* Apply debounce delay */
     printf("ButtonDriver: Applying debounce delay of %d ms\n", DEBOUNCE_TIME);
     Timer_delay(me->itsTimer, DEBOUNCE_TIME);
 
+    handleState(me, Button_getState(me->itsButton));
+}
+
+void ButtonDriver_debounced(void* context, const struct DebounceEvent* event) {
+    ButtonDriver* me = (ButtonDriver*)context;
+    if (me == NULL || event == NULL || me->itsButton == NULL || me->itsMicrowaveEmitter == NULL) {
+        return;
+    }
+
+    handleState(me, event->level);
+}
+
+static void handleState(ButtonDriver* const me, int currentState) {
     /* Check if button state has changed */
-    int currentState = Button_getState(me->itsButton);
     if (currentState != me->oldState) {
         /* Update stored state with the new button state */
-        me->oldState = currentState;
+        me->oldState = (unsigned char)currentState;
         printf("ButtonDriver: Button state changed to %s\n",
                currentState ? "PRESSED" : "RELEASED");
 
@@ -110,6 +140,21 @@ void ButtonDriver_setItsTimer(ButtonDriver* const me, struct Timer* p_Timer) {
     }
 }
 
+struct DebounceEngine* ButtonDriver_getItsDebounceEngine(const ButtonDriver* const me) {
+    return (me != NULL) ? me->itsDebounceEngine : NULL;
+}
+
+void ButtonDriver_setItsDebounceEngine(ButtonDriver* const me, struct DebounceEngine* p_DebounceEngine, size_t input) {
+    if (me != NULL) {
+        if (me->itsDebounceEngine != NULL) {
+            DebounceEngine_setHandler(me->itsDebounceEngine, me->debounceInput, NULL, NULL);
+        }
+        me->itsDebounceEngine = p_DebounceEngine;
+        me->debounceInput = input;
+        DebounceEngine_setHandler(p_DebounceEngine, input, ButtonDriver_debounced, me);
+    }
+}
+
 ButtonDriver* ButtonDriver_Create(void) {
     ButtonDriver* me = (ButtonDriver*)malloc(sizeof(ButtonDriver));
     if (me != NULL) {
@@ -138,6 +183,11 @@ static void cleanUpRelations(ButtonDriver* const me) {
         me->itsButton = NULL;
     }
 
+    if (me->itsDebounceEngine != NULL) {
+        DebounceEngine_setHandler(me->itsDebounceEngine, me->debounceInput, NULL, NULL);
+        me->itsDebounceEngine = NULL;
+    }
+
     me->itsMicrowaveEmitter = NULL;
     me->itsTimer = NULL;
 }
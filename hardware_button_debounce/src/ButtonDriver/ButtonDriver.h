@@ -13,10 +13,14 @@
 #define BUTTON_OFF       (0)
 #define BUTTON_ON        (1)
 
+#include <stddef.h>
+
 // Forward declarations
 struct Button;
 struct MicrowaveEmitter;
 struct Timer;
+struct DebounceEngine;
+struct DebounceEvent;
 
 /**
  * @brief ButtonDriver structure for handling button interactions
@@ -28,6 +32,8 @@ struct ButtonDriver {
     struct Button* itsButton; // Associated button
     struct MicrowaveEmitter* itsMicrowaveEmitter; // Controlled emitter
     struct Timer* itsTimer;   // Timer for debouncing
+    struct DebounceEngine* itsDebounceEngine; // Shared non-blocking debouncer, or NULL
+    size_t debounceInput;     // This button's input on itsDebounceEngine
 };
 
 /**
@@ -45,9 +51,20 @@ void ButtonDriver_Cleanup(ButtonDriver* const me);
 /**
  * @brief Process button events and handle device control
  * @param me Pointer to the ButtonDriver instance
+ *
+ * With a DebounceEngine attached the button's level is recorded as an edge
+ * and the call returns at once; the toggle happens when the engine reports
+ * the level as stable. Without one the Timer delay is applied first.
  */
 void ButtonDriver_eventReceive(ButtonDriver* const me);
 
+/**
+ * @brief Handle a stable transition reported by a DebounceEngine
+ * @param context The ButtonDriver registered for the input
+ * @param event The transition
+ */
+void ButtonDriver_debounced(void* context, const struct DebounceEvent* event);
+
 /**
  * @brief Get the associated Button
  * @param me Pointer to the ButtonDriver instance
@@ -90,6 +107,21 @@ struct Timer* ButtonDriver_getItsTimer(const ButtonDriver* const me);
  */
 void ButtonDriver_setItsTimer(ButtonDriver* const me, struct Timer* p_Timer);
 
+/**
+ * @brief Get the associated DebounceEngine
+ * @param me Pointer to the ButtonDriver instance
+ * @return Pointer to the associated DebounceEngine, NULL if none
+ */
+struct DebounceEngine* ButtonDriver_getItsDebounceEngine(const ButtonDriver* const me);
+
+/**
+ * @brief Debounce this button on one input of a shared DebounceEngine
+ * @param me Pointer to the ButtonDriver instance
+ * @param p_DebounceEngine Engine to use, NULL to go back to the Timer delay
+ * @param input Input index reserved for this button
+ */
+void ButtonDriver_setItsDebounceEngine(ButtonDriver* const me, struct DebounceEngine* p_DebounceEngine, size_t input);
+
 /**
  * @brief Create a new ButtonDriver instance
  * @return Pointer to the created ButtonDriver, NULL if creation failed
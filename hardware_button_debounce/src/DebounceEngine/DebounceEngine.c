@@ -0,0 +1,281 @@
+//
+// DebounceEngine - bit-parallel quiet-period debouncing
+//
+// Each word of 64 inputs has a vertical counter: DEBOUNCE_COUNTER_BITS
+// words whose bit b together form input b's count. One sample increments
+// the count of every settling input in a word with a ripple-carry over the
+// bit planes, and compares all 64 counts with the threshold in one pass.
+//
+
+#include "DebounceEngine.h"
+#include <stdlib.h>
+
+#define WORD_BITS (64u)
+
+static uint64_t bitOf(size_t input) {
+    return (uint64_t)1 << (input % WORD_BITS);
+}
+
+static unsigned int lowestBit(uint64_t bits) {
+    return (unsigned int)__builtin_ctzll(bits);
+}
+
+static void activate(DebounceEngine* const me, size_t word) {
+    uint64_t bit = bitOf(word);
+    if ((me->active[word / WORD_BITS] & bit) == 0) {
+        me->active[word / WORD_BITS] |= bit;
+        me->activeWords++;
+    }
+}
+
+static void deactivate(DebounceEngine* const me, size_t word) {
+    me->active[word / WORD_BITS] &= ~bitOf(word);
+    me->activeWords--;
+}
+
+static void report(DebounceEngine* const me, size_t input, int level, uint32_t timeMs) {
+    DebounceEvent event;
+    uint32_t latency = timeMs - me->firstEdgeMs[input];
+
+    me->transitions++;
+    me->latencyTotalMs += latency;
+    if (latency > me->latencyMaxMs) {
+        me->latencyMaxMs = latency;
+    }
+    if (me->handlers[input] != NULL) {
+        event.input = input;
+        event.level = level;
+        event.firstEdgeMs = me->firstEdgeMs[input];
+        event.stableMs = timeMs;
+        me->handlers[input](me->contexts[input], &event);
+    }
+}
+
+/**
+ * @brief One sample of one word: count, then settle the inputs that reached the threshold
+ * @return Number of transitions reported
+ */
+static size_t sampleWord(DebounceEngine* const me, size_t word, uint32_t timeMs) {
+    uint64_t* planes = &me->counters[word * DEBOUNCE_COUNTER_BITS];
+    uint64_t settling = me->settling[word];
+    uint64_t carry = settling;
+    uint64_t reached = settling;
+    size_t reported = 0;
+
+    for (unsigned int p = 0; p < DEBOUNCE_COUNTER_BITS; p++) {
+        uint64_t next = planes[p] & carry;
+        planes[p] ^= carry;
+        carry = next;
+        reached &= ((me->samples >> p) & 1u) ? planes[p] : ~planes[p];
+    }
+    if (reached == 0) {
+        return 0;
+    }
+
+    uint64_t changed = reached & (me->raw[word] ^ me->stable[word]);
+    me->glitches += (unsigned long)__builtin_popcountll(reached & ~changed);
+    me->stable[word] ^= changed;
+    me->settling[word] = settling & ~reached;
+    for (unsigned int p = 0; p < DEBOUNCE_COUNTER_BITS; p++) {
+        planes[p] &= ~reached;
+    }
+    if (me->settling[word] == 0) {
+        deactivate(me, word);
+    }
+
+    while (changed != 0) {
+        size_t input = word * WORD_BITS + lowestBit(changed);
+        report(me, input, (int)((me->stable[word] >> (input % WORD_BITS)) & 1u), timeMs);
+        changed &= changed - 1u;
+        reported++;
+    }
+    return reported;
+}
+
+static size_t sampleActive(DebounceEngine* const me, uint32_t timeMs) {
+    size_t reported = 0;
+
+    for (size_t i = 0; i * WORD_BITS < me->words; i++) {
+        uint64_t bits = me->active[i];
+        while (bits != 0) {
+            reported += sampleWord(me, i * WORD_BITS + lowestBit(bits), timeMs);
+            bits &= bits - 1u;
+        }
+    }
+    return reported;
+}
+
+void DebounceEngine_Init(DebounceEngine* const me, size_t inputs, uint32_t debounceMs, uint32_t sampleMs) {
+    if (me == NULL) {
+        return;
+    }
+
+    size_t words = (inputs + WORD_BITS - 1u) / WORD_BITS;
+    size_t summary = (words + WORD_BITS - 1u) / WORD_BITS;
+
+    me->sampleMs = (sampleMs > 0) ? sampleMs : 1u;
+    me->samples = debounceMs / me->sampleMs;
+    if (me->samples == 0) {
+        me->samples = 1;
+    } else if (me->samples > DEBOUNCE_MAX_SAMPLES) {
+        me->samples = DEBOUNCE_MAX_SAMPLES;
+    }
+    me->lastSampleMs = 0;
+    me->nowMs = 0;
+    me->activeWords = 0;
+    me->edges = 0;
+    me->transitions = 0;
+    me->glitches = 0;
+    me->latencyTotalMs = 0;
+    me->latencyMaxMs = 0;
+
+    me->raw = (uint64_t*)calloc(words, sizeof(uint64_t));
+    me->stable = (uint64_t*)calloc(words, sizeof(uint64_t));
+    me->settling = (uint64_t*)calloc(words, sizeof(uint64_t));
+    me->counters = (uint64_t*)calloc(words * DEBOUNCE_COUNTER_BITS, sizeof(uint64_t));
+    me->active = (uint64_t*)calloc(summary, sizeof(uint64_t));
+    me->firstEdgeMs = (uint32_t*)calloc(inputs, sizeof(uint32_t));
+    me->handlers = (DebounceHandler*)calloc(inputs, sizeof(DebounceHandler));
+    me->contexts = (void**)calloc(inputs, sizeof(void*));
+    me->inputs = inputs;
+    me->words = words;
+
+    if (inputs > 0 && (me->raw == NULL || me->stable == NULL || me->settling == NULL || me->counters == NULL ||
+                       me->active == NULL || me->firstEdgeMs == NULL || me->handlers == NULL || me->contexts == NULL)) {
+        DebounceEngine_Cleanup(me);
+    }
+}
+
+void DebounceEngine_Cleanup(DebounceEngine* const me) {
+    if (me == NULL) {
+        return;
+    }
+
+    free(me->raw);
+    free(me->stable);
+    free(me->settling);
+    free(me->counters);
+    free(me->active);
+    free(me->firstEdgeMs);
+    free(me->handlers);
+    free(me->contexts);
+    me->raw = NULL;
+    me->stable = NULL;
+    me->settling = NULL;
+    me->counters = NULL;
+    me->active = NULL;
+    me->firstEdgeMs = NULL;
+    me->handlers = NULL;
+    me->contexts = NULL;
+    me->inputs = 0;
+    me->words = 0;
+    me->activeWords = 0;
+}
+
+DebounceEngine* DebounceEngine_Create(size_t inputs, uint32_t debounceMs, uint32_t sampleMs) {
+    DebounceEngine* me = (DebounceEngine*)malloc(sizeof(DebounceEngine));
+    if (me != NULL) {
+        DebounceEngine_Init(me, inputs, debounceMs, sampleMs);
+        if (me->inputs != inputs) {
+            free(me);
+            me = NULL;
+        }
+    }
+    return me;
+}
+
+void DebounceEngine_Destroy(DebounceEngine* const me) {
+    if (me != NULL) {
+        DebounceEngine_Cleanup(me);
+        free(me);
+    }
+}
+
+void DebounceEngine_setHandler(DebounceEngine* const me, size_t input, DebounceHandler handler, void* context) {
+    if (me != NULL && input < me->inputs) {
+        me->handlers[input] = handler;
+        me->contexts[input] = context;
+    }
+}
+
+void DebounceEngine_edge(DebounceEngine* const me, size_t input, int level, uint32_t timeMs) {
+    if (me == NULL || input >= me->inputs) {
+        return;
+    }
+
+    size_t word = input / WORD_BITS;
+    uint64_t bit = bitOf(input);
+
+    /* Samples before the edge must not count towards its quiet time */
+    DebounceEngine_tick(me, timeMs);
+    if (((me->raw[word] & bit) != 0) == (level != 0)) {
+        return;
+    }
+
+    me->raw[word] ^= bit;
+    me->edges++;
+    for (unsigned int p = 0; p < DEBOUNCE_COUNTER_BITS; p++) {
+        me->counters[word * DEBOUNCE_COUNTER_BITS + p] &= ~bit;
+    }
+    if ((me->settling[word] & bit) == 0) {
+        me->settling[word] |= bit;
+        me->firstEdgeMs[input] = me->nowMs;
+        activate(me, word);
+    }
+}
+
+size_t DebounceEngine_tick(DebounceEngine* const me, uint32_t nowMs) {
+    size_t reported = 0;
+
+    if (me == NULL || (int32_t)(nowMs - me->nowMs) < 0) {
+        return 0;  /* Time never runs backwards */
+    }
+
+    me->nowMs = nowMs;
+    while (nowMs - me->lastSampleMs >= me->sampleMs) {
+        if (me->activeWords == 0) {
+            /* Nothing is settling: skip straight to the last sample due */
+            me->lastSampleMs += (nowMs - me->lastSampleMs) / me->sampleMs * me->sampleMs;
+            break;
+        }
+        me->lastSampleMs += me->sampleMs;
+        reported += sampleActive(me, me->lastSampleMs);
+    }
+    return reported;
+}
+
+uint32_t DebounceEngine_now(const DebounceEngine* const me) {
+    return (me != NULL) ? me->nowMs : 0;
+}
+
+int DebounceEngine_getStable(const DebounceEngine* const me, size_t input) {
+    if (me == NULL || input >= me->inputs) {
+        return 0;
+    }
+    return (me->stable[input / WORD_BITS] & bitOf(input)) != 0;
+}
+
+int DebounceEngine_getRaw(const DebounceEngine* const me, size_t input) {
+    if (me == NULL || input >= me->inputs) {
+        return 0;
+    }
+    return (me->raw[input / WORD_BITS] & bitOf(input)) != 0;
+}
+
+int DebounceEngine_isSettling(const DebounceEngine* const me, size_t input) {
+    if (me == NULL || input >= me->inputs) {
+        return 0;
+    }
+    return (me->settling[input / WORD_BITS] & bitOf(input)) != 0;
+}
+
+size_t DebounceEngine_getInputCount(const DebounceEngine* const me) {
+    return (me != NULL) ? me->inputs : 0;
+}
+
+double DebounceEngine_getAverageLatency(const DebounceEngine* const me) {
+    if (me == NULL || me->transitions == 0) {
+        return 0.0;
+    }
+    return (double)me->latencyTotalMs / (double)me->transitions;
+}
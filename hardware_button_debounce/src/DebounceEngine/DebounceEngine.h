@@ -0,0 +1,180 @@
+//
+// DebounceEngine - non-blocking debouncing for many inputs at once
+//
+// Raw edges are recorded with their timestamp and return immediately. A
+// periodic timer calls DebounceEngine_tick, which samples every input that
+// is still settling, 64 inputs per machine word, and reports an input's
+// new stable level once it has seen no edge for the debounce time. A burst
+// that ends at the level it started from is dropped as a glitch.
+//
+
+#ifndef BUTTON_DEBOUNCE_DEBOUNCEENGINE_H
+#define BUTTON_DEBOUNCE_DEBOUNCEENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Constants for the debounce engine
+ */
+#define DEBOUNCE_COUNTER_BITS  (8)    // Bit planes of each word's vertical counter
+#define DEBOUNCE_MAX_SAMPLES   ((1u << DEBOUNCE_COUNTER_BITS) - 1u)
+#define DEBOUNCE_SAMPLE_MS     (1)    // Default sampling period in milliseconds
+
+/**
+ * @brief A stable transition reported by the engine
+ */
+typedef struct DebounceEvent DebounceEvent;
+struct DebounceEvent {
+    size_t input;          // Input that settled
+    int level;             // New stable level (0 or 1)
+    uint32_t firstEdgeMs;  // First edge of the burst that led here
+    uint32_t stableMs;     // Sample at which the level was accepted
+};
+
+/**
+ * @brief Called from DebounceEngine_tick for each stable transition
+ * @param context Context registered for the input
+ * @param event The transition
+ */
+typedef void (*DebounceHandler)(void* context, const DebounceEvent* event);
+
+/**
+ * @brief Debounce state of a set of inputs, one bit per input
+ *
+ * counters holds DEBOUNCE_COUNTER_BITS bit planes per word: bit b of plane
+ * p is bit p of input b's count of samples since its last edge.
+ */
+typedef struct DebounceEngine DebounceEngine;
+struct DebounceEngine {
+    size_t inputs;          // Number of inputs
+    size_t words;           // Words of 64 inputs
+    uint64_t* raw;          // Latest raw level of each input
+    uint64_t* stable;       // Debounced level of each input
+    uint64_t* settling;     // Inputs with edges not yet settled
+    uint64_t* counters;     // words * DEBOUNCE_COUNTER_BITS bit planes
+    uint64_t* active;       // Words with settling inputs, one bit per word
+    size_t activeWords;     // Number of bits set in active
+    uint32_t* firstEdgeMs;  // Start of each input's current burst
+    DebounceHandler* handlers;
+    void** contexts;
+
+    uint32_t sampleMs;      // Sampling period
+    uint32_t samples;       // Quiet samples needed to settle
+    uint32_t lastSampleMs;  // Time of the latest sample taken
+    uint32_t nowMs;         // Latest time seen
+
+    unsigned long edges;        // Raw edges recorded
+    unsigned long transitions;  // Stable transitions reported
+    unsigned long glitches;     // Bursts that ended where they started
+    uint64_t latencyTotalMs;    // Sum of firstEdgeMs-to-stableMs latencies
+    uint32_t latencyMaxMs;
+};
+
+/**
+ * @brief Initialize a DebounceEngine instance, all inputs stable at 0
+ * @param me Pointer to the DebounceEngine instance
+ * @param inputs Number of inputs
+ * @param debounceMs Quiet time before a level is accepted
+ * @param sampleMs Sampling period; debounceMs / sampleMs is capped at DEBOUNCE_MAX_SAMPLES
+ *
+ * On allocation failure the engine is left with no inputs.
+ */
+void DebounceEngine_Init(DebounceEngine* const me, size_t inputs, uint32_t debounceMs, uint32_t sampleMs);
+
+/**
+ * @brief Clean up DebounceEngine resources
+ * @param me Pointer to the DebounceEngine instance
+ */
+void DebounceEngine_Cleanup(DebounceEngine* const me);
+
+/**
+ * @brief Create a new DebounceEngine instance
+ * @param inputs Number of inputs
+ * @param debounceMs Quiet time before a level is accepted
+ * @param sampleMs Sampling period
+ * @return Pointer to the created DebounceEngine, NULL if creation failed
+ */
+DebounceEngine* DebounceEngine_Create(size_t inputs, uint32_t debounceMs, uint32_t sampleMs);
+
+/**
+ * @brief Destroy a DebounceEngine instance and free its memory
+ * @param me Pointer to the DebounceEngine instance
+ */
+void DebounceEngine_Destroy(DebounceEngine* const me);
+
+/**
+ * @brief Register the handler for an input's stable transitions
+ * @param me Pointer to the DebounceEngine instance
+ * @param input Input index
+ * @param handler Called on each transition, NULL for none
+ * @param context Passed to the handler
+ */
+void DebounceEngine_setHandler(DebounceEngine* const me, size_t input, DebounceHandler handler, void* context);
+
+/**
+ * @brief Record a raw edge; does not block or report anything for this input
+ * @param me Pointer to the DebounceEngine instance
+ * @param input Input index
+ * @param level Raw level after the edge (0 or non-zero)
+ * @param timeMs Time of the edge; edges must arrive in time order
+ *
+ * Samples due before timeMs are taken first, so their transitions may be
+ * reported from this call.
+ */
+void DebounceEngine_edge(DebounceEngine* const me, size_t input, int level, uint32_t timeMs);
+
+/**
+ * @brief Timer callback: take every sample due up to nowMs
+ * @param me Pointer to the DebounceEngine instance
+ * @param nowMs Current time
+ * @return Number of stable transitions reported
+ */
+size_t DebounceEngine_tick(DebounceEngine* const me, uint32_t nowMs);
+
+/**
+ * @brief Get the latest time the engine has seen
+ * @param me Pointer to the DebounceEngine instance
+ * @return Time in milliseconds
+ */
+uint32_t DebounceEngine_now(const DebounceEngine* const me);
+
+/**
+ * @brief Get the debounced level of an input
+ * @param me Pointer to the DebounceEngine instance
+ * @param input Input index
+ * @return Stable level (0 or 1)
+ */
+int DebounceEngine_getStable(const DebounceEngine* const me, size_t input);
+
+/**
+ * @brief Get the latest raw level of an input
+ * @param me Pointer to the DebounceEngine instance
+ * @param input Input index
+ * @return Raw level (0 or 1)
+ */
+int DebounceEngine_getRaw(const DebounceEngine* const me, size_t input);
+
+/**
+ * @brief Check whether an input has edges that have not settled yet
+ * @param me Pointer to the DebounceEngine instance
+ * @param input Input index
+ * @return 1 if settling, 0 otherwise
+ */
+int DebounceEngine_isSettling(const DebounceEngine* const me, size_t input);
+
+/**
+ * @brief Get the number of inputs
+ * @param me Pointer to the DebounceEngine instance
+ * @return Number of inputs, 0 if the engine could not be allocated
+ */
+size_t DebounceEngine_getInputCount(const DebounceEngine* const me);
+
+/**
+ * @brief Get the average latency from first edge to stable level
+ * @param me Pointer to the DebounceEngine instance
+ * @return Average latency in milliseconds, 0 before any transition
+ */
+double DebounceEngine_getAverageLatency(const DebounceEngine* const me);
+
+#endif //BUTTON_DEBOUNCE_DEBOUNCEENGINE_H
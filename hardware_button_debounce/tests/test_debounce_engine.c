@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <stdlib.h>
+#include "DebounceEngine.h"
+#include "ButtonDriver.h"
+#include "Button.h"
+#include "MicrowaveEmitter.h"
+
+#define INPUTS (1000)
+
+// Test fixtures
+DebounceEngine* p_Engine;
+DebounceEvent lastEvent;
+unsigned int eventCount;
+
+static void recordEvent(void* context, const DebounceEvent* event) {
+    (void)context;
+    lastEvent = *event;
+    eventCount++;
+}
+
+void setUp(void) {
+    p_Engine = DebounceEngine_Create(INPUTS, DEBOUNCE_TIME, DEBOUNCE_SAMPLE_MS);
+    for (size_t i = 0; i < INPUTS; i++) {
+        DebounceEngine_setHandler(p_Engine, i, recordEvent, NULL);
+    }
+    eventCount = 0;
+}
+
+void tearDown(void) {
+    DebounceEngine_Destroy(p_Engine);
+}
+
+// A single clean edge is accepted after the debounce time, not before
+void test_clean_edge_settles_after_debounce_time(void) {
+    DebounceEngine_edge(p_Engine, 3, 1, 100);
+    TEST_ASSERT_EQUAL(1, DebounceEngine_getRaw(p_Engine, 3));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_getStable(p_Engine, 3));
+    TEST_ASSERT_EQUAL(1, DebounceEngine_isSettling(p_Engine, 3));
+
+    TEST_ASSERT_EQUAL(0, DebounceEngine_tick(p_Engine, 100 + DEBOUNCE_TIME - 1));
+    TEST_ASSERT_EQUAL(0, eventCount);
+
+    TEST_ASSERT_EQUAL(1, DebounceEngine_tick(p_Engine, 100 + DEBOUNCE_TIME));
+    TEST_ASSERT_EQUAL(1, eventCount);
+    TEST_ASSERT_EQUAL(3, lastEvent.input);
+    TEST_ASSERT_EQUAL(1, lastEvent.level);
+    TEST_ASSERT_EQUAL_UINT32(100, lastEvent.firstEdgeMs);
+    TEST_ASSERT_EQUAL_UINT32(100 + DEBOUNCE_TIME, lastEvent.stableMs);
+    TEST_ASSERT_EQUAL(1, DebounceEngine_getStable(p_Engine, 3));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_isSettling(p_Engine, 3));
+}
+
+// Bounces restart the quiet time; one transition is reported for the burst
+void test_bouncing_press_reports_one_transition(void) {
+    static const uint32_t times[] = {10, 11, 13, 14, 18};
+    int level = 1;
+
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); i++) {
+        DebounceEngine_edge(p_Engine, 70, level, times[i]);
+        level = !level;
+    }
+    DebounceEngine_tick(p_Engine, 18 + DEBOUNCE_TIME - 1);
+    TEST_ASSERT_EQUAL(0, eventCount);
+
+    DebounceEngine_tick(p_Engine, 1000);
+    TEST_ASSERT_EQUAL(1, eventCount);
+    TEST_ASSERT_EQUAL(1, lastEvent.level);
+    TEST_ASSERT_EQUAL_UINT32(10, lastEvent.firstEdgeMs);
+    TEST_ASSERT_EQUAL_UINT32(18 + DEBOUNCE_TIME, lastEvent.stableMs);
+    TEST_ASSERT_EQUAL_UINT32(5, p_Engine->edges);
+    TEST_ASSERT_EQUAL_UINT32(8 + DEBOUNCE_TIME, p_Engine->latencyMaxMs);
+}
+
+// A burst that ends at the old level is a glitch, not a transition
+void test_glitch_is_filtered(void) {
+    DebounceEngine_edge(p_Engine, 5, 1, 0);
+    DebounceEngine_edge(p_Engine, 5, 0, 3);
+    DebounceEngine_edge(p_Engine, 5, 0, 4);  // No change: ignored
+    DebounceEngine_tick(p_Engine, 1000);
+
+    TEST_ASSERT_EQUAL(0, eventCount);
+    TEST_ASSERT_EQUAL(0, DebounceEngine_getStable(p_Engine, 5));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_isSettling(p_Engine, 5));
+    TEST_ASSERT_EQUAL_UINT32(1, p_Engine->glitches);
+    TEST_ASSERT_EQUAL_UINT32(2, p_Engine->edges);
+}
+
+// Every input in every word settles independently
+void test_inputs_settle_independently(void) {
+    for (uint32_t t = 0; t < 7; t++) {
+        for (size_t i = t; i < INPUTS; i += 7) {
+            DebounceEngine_edge(p_Engine, i, 1, t);
+        }
+    }
+    DebounceEngine_tick(p_Engine, 6 + DEBOUNCE_TIME - 1);
+    TEST_ASSERT_EQUAL(INPUTS - INPUTS / 7, eventCount);  // All but the edges at t=6
+
+    DebounceEngine_tick(p_Engine, 6 + DEBOUNCE_TIME);
+    TEST_ASSERT_EQUAL(INPUTS, eventCount);
+    for (size_t i = 0; i < INPUTS; i++) {
+        TEST_ASSERT_EQUAL(1, DebounceEngine_getStable(p_Engine, i));
+    }
+    TEST_ASSERT_EQUAL(0, p_Engine->activeWords);
+    TEST_ASSERT_EQUAL_DOUBLE(DEBOUNCE_TIME, DebounceEngine_getAverageLatency(p_Engine));
+}
+
+// A late timer call still reports the transition at the sample it happened
+void test_late_tick_catches_up(void) {
+    DebounceEngine_edge(p_Engine, 999, 1, 50);
+    TEST_ASSERT_EQUAL(1, DebounceEngine_tick(p_Engine, 100000));
+    TEST_ASSERT_EQUAL_UINT32(50 + DEBOUNCE_TIME, lastEvent.stableMs);
+    TEST_ASSERT_EQUAL_UINT32(100000, DebounceEngine_now(p_Engine));
+
+    DebounceEngine_edge(p_Engine, 999, 0, 100001);
+    TEST_ASSERT_EQUAL(1, DebounceEngine_tick(p_Engine, 100001 + DEBOUNCE_TIME));
+    TEST_ASSERT_EQUAL(0, lastEvent.level);
+}
+
+// The ButtonDriver toggles from the engine callback instead of blocking
+void test_button_driver_with_debounce_engine(void) {
+    ButtonDriver* p_ButtonDriver = ButtonDriver_Create();
+    Button* p_Button = Button_Create();
+    MicrowaveEmitter* p_MicrowaveEmitter = MicrowaveEmitter_Create();
+
+    ButtonDriver_setItsButton(p_ButtonDriver, p_Button);
+    ButtonDriver_setItsMicrowaveEmitter(p_ButtonDriver, p_MicrowaveEmitter);
+    ButtonDriver_setItsDebounceEngine(p_ButtonDriver, p_Engine, 42);
+    TEST_ASSERT_EQUAL_PTR(p_Engine, ButtonDriver_getItsDebounceEngine(p_ButtonDriver));
+
+    /* Press, with a bounce */
+    p_Button->deviceState = BUTTON_STATE_PRESSED;
+    ButtonDriver_eventReceive(p_ButtonDriver);
+    DebounceEngine_tick(p_Engine, 2);
+    p_Button->deviceState = BUTTON_STATE_RELEASED;
+    ButtonDriver_eventReceive(p_ButtonDriver);
+    p_Button->deviceState = BUTTON_STATE_PRESSED;
+    ButtonDriver_eventReceive(p_ButtonDriver);
+    TEST_ASSERT_EQUAL(0, p_ButtonDriver->oldState);
+    DebounceEngine_tick(p_Engine, 2 + DEBOUNCE_TIME);
+    TEST_ASSERT_EQUAL(BUTTON_STATE_PRESSED, p_ButtonDriver->oldState);
+    TEST_ASSERT_EQUAL(BUTTON_OFF, p_ButtonDriver->toggleOn);
+
+    /* Release toggles the emitter on, once stable */
+    p_Button->deviceState = BUTTON_STATE_RELEASED;
+    ButtonDriver_eventReceive(p_ButtonDriver);
+    TEST_ASSERT_EQUAL(BUTTON_OFF, p_ButtonDriver->toggleOn);
+    DebounceEngine_tick(p_Engine, 100);
+    TEST_ASSERT_EQUAL(BUTTON_ON, p_ButtonDriver->toggleOn);
+    TEST_ASSERT_EQUAL(1, p_Button->backlight);
+    TEST_ASSERT_EQUAL(EMITTER_ON, p_MicrowaveEmitter->deviceState);
+
+    ButtonDriver_Destroy(p_ButtonDriver);
+    TEST_ASSERT_NULL(p_Engine->handlers[42]);
+    Button_Destroy(p_Button);
+    MicrowaveEmitter_Destroy(p_MicrowaveEmitter);
+}
+
+// Test NULL pointer safety
+void test_null_safety(void) {
+    DebounceEngine_edge(NULL, 0, 1, 0);
+    DebounceEngine_edge(p_Engine, INPUTS, 1, 0);
+    DebounceEngine_setHandler(NULL, 0, NULL, NULL);
+    DebounceEngine_Destroy(NULL);
+
+    TEST_ASSERT_EQUAL(0, DebounceEngine_tick(NULL, 10));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_getStable(NULL, 0));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_getRaw(p_Engine, INPUTS));
+    TEST_ASSERT_EQUAL(0, DebounceEngine_getInputCount(NULL));
+    TEST_ASSERT_EQUAL(INPUTS, DebounceEngine_getInputCount(p_Engine));
+    TEST_ASSERT_EQUAL_UINT32(0, p_Engine->edges);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Register tests
+    RUN_TEST(test_clean_edge_settles_after_debounce_time);
+    RUN_TEST(test_bouncing_press_reports_one_transition);
+    RUN_TEST(test_glitch_is_filtered);
+    RUN_TEST(test_inputs_settle_independently);
+    RUN_TEST(test_late_tick_catches_up);
+    RUN_TEST(test_button_driver_with_debounce_engine);
+    RUN_TEST(test_null_safety);
+
+    return UNITY_END();
+}
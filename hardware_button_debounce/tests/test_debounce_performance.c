@@ -0,0 +1,199 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "DebounceEngine.h"
+#include "ButtonDriver.h"
+
+/*
+    Simulation harness: every input is pressed and released a few times,
+    each edge bouncing, with the occasional glitch in between. The whole
+    trace is sorted by time and replayed through one DebounceEngine, with a
+    timer tick at every millisecond an edge arrives in. The same trace is
+    replayed through a per-input debouncer that visits every input on each
+    sample, the usual way to debounce a bank of buttons, as the reference.
+*/
+
+#define CYCLES 4u        // Press/release cycles per input
+#define MAX_BOUNCES 4u   // Extra bounce pairs per edge
+
+typedef struct {
+    uint32_t timeMs;
+    uint32_t input;
+    int level;
+} Edge;
+
+typedef struct {
+    Edge* edges;
+    size_t count;
+    size_t capacity;
+    unsigned long transitions;  // Expected stable transitions
+    uint64_t latencyTotalMs;    // Expected sum of latencies
+    uint32_t endMs;
+} Trace;
+
+static void addEdge(Trace* trace, uint32_t timeMs, size_t input, int level) {
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2u : 1024u;
+        trace->edges = (Edge*)realloc(trace->edges, trace->capacity * sizeof(Edge));
+        TEST_ASSERT_NOT_NULL(trace->edges);
+    }
+    trace->edges[trace->count].timeMs = timeMs;
+    trace->edges[trace->count].input = (uint32_t)input;
+    trace->edges[trace->count].level = level;
+    trace->count++;
+    if (timeMs > trace->endMs) {
+        trace->endMs = timeMs;
+    }
+}
+
+/* A bouncing edge to `level`; returns the time of its last edge */
+static uint32_t addBurst(Trace* trace, uint32_t timeMs, size_t input, int level) {
+    unsigned int bounces = (unsigned int)rand() % (MAX_BOUNCES + 1u);
+    uint32_t start = timeMs;
+
+    addEdge(trace, timeMs, input, level);
+    for (unsigned int b = 0; b < bounces; b++) {
+        timeMs += 1u + (uint32_t)rand() % 3u;
+        addEdge(trace, timeMs, input, !level);
+        timeMs += 1u + (uint32_t)rand() % 3u;
+        addEdge(trace, timeMs, input, level);
+    }
+    trace->transitions++;
+    trace->latencyTotalMs += timeMs - start + DEBOUNCE_TIME;
+    return timeMs;
+}
+
+static int compareEdges(const void* a, const void* b) {
+    const Edge* x = (const Edge*)a;
+    const Edge* y = (const Edge*)b;
+    return (x->timeMs > y->timeMs) - (x->timeMs < y->timeMs);
+}
+
+static Trace makeTrace(size_t inputs) {
+    Trace trace = {NULL, 0, 0, 0, 0, 0};
+
+    srand(11);
+    for (size_t i = 0; i < inputs; i++) {
+        uint32_t t = 1u + (uint32_t)rand() % 100u;
+        for (unsigned int c = 0; c < CYCLES; c++) {
+            t = addBurst(&trace, t, i, 1) + DEBOUNCE_TIME + 10u + (uint32_t)rand() % 200u;
+            t = addBurst(&trace, t, i, 0) + DEBOUNCE_TIME + 10u + (uint32_t)rand() % 200u;
+            if (rand() % 4 == 0) {
+                /* A glitch: settles back where it started */
+                addEdge(&trace, t, i, 1);
+                addEdge(&trace, t + 2u, i, 0);
+                t += 2u + DEBOUNCE_TIME + 10u;
+            }
+        }
+    }
+    qsort(trace.edges, trace.count, sizeof(Edge), compareEdges);
+    return trace;
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Returns edges replayed per second */
+static double replayEngine(const Trace* trace, size_t inputs, DebounceEngine** out) {
+    DebounceEngine* engine = DebounceEngine_Create(inputs, DEBOUNCE_TIME, DEBOUNCE_SAMPLE_MS);
+    double start;
+
+    TEST_ASSERT_NOT_NULL(engine);
+    start = seconds();
+    for (size_t i = 0; i < trace->count; i++) {
+        const Edge* e = &trace->edges[i];
+        DebounceEngine_tick(engine, e->timeMs);
+        DebounceEngine_edge(engine, e->input, e->level, e->timeMs);
+    }
+    DebounceEngine_tick(engine, trace->endMs + DEBOUNCE_TIME + 1u);
+    *out = engine;
+    return (double)trace->count / (seconds() - start);
+}
+
+/* reference: one counter per input, every input visited on every sample */
+static double replayPerInput(const Trace* trace, size_t inputs, unsigned long* transitions) {
+    unsigned char* raw = (unsigned char*)calloc(inputs, 1);
+    unsigned char* stable = (unsigned char*)calloc(inputs, 1);
+    unsigned char* settling = (unsigned char*)calloc(inputs, 1);
+    unsigned char* count = (unsigned char*)calloc(inputs, 1);
+    uint32_t now = 0;
+    size_t next = 0;
+    double start;
+
+    TEST_ASSERT_TRUE(raw && stable && settling && count);
+    *transitions = 0;
+    start = seconds();
+    while (now <= trace->endMs + DEBOUNCE_TIME) {
+        for (; next < trace->count && trace->edges[next].timeMs == now; next++) {
+            const Edge* e = &trace->edges[next];
+            if (raw[e->input] != e->level) {
+                raw[e->input] = (unsigned char)e->level;
+                settling[e->input] = 1;
+                count[e->input] = 0;
+            }
+        }
+        now++;
+        for (size_t i = 0; i < inputs; i++) {
+            if (settling[i] && ++count[i] == DEBOUNCE_TIME / DEBOUNCE_SAMPLE_MS) {
+                settling[i] = 0;
+                if (stable[i] != raw[i]) {
+                    stable[i] = raw[i];
+                    (*transitions)++;
+                }
+            }
+        }
+    }
+    double rate = (double)trace->count / (seconds() - start);
+
+    free(raw);
+    free(stable);
+    free(settling);
+    free(count);
+    return rate;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_replay_bouncing_traces(void) {
+    static const size_t sizes[] = {1000, 10000, 100000};
+
+    printf("\n  blocking %d ms delay per event: %d events/s per driver\n", DEBOUNCE_TIME, 1000 / DEBOUNCE_TIME);
+    printf("  %8s %10s %16s %16s %12s %12s\n", "inputs", "edges", "per-input M/s", "engine M/s", "avg lat ms",
+           "max lat ms");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        Trace trace = makeTrace(sizes[s]);
+        DebounceEngine* engine = NULL;
+        unsigned long referenceTransitions = 0;
+
+        double reference = replayPerInput(&trace, sizes[s], &referenceTransitions);
+        double rate = replayEngine(&trace, sizes[s], &engine);
+
+        printf("  %8lu %10lu %16.2f %16.2f %12.2f %12u\n", (unsigned long)sizes[s], (unsigned long)trace.count,
+               reference / 1e6, rate / 1e6, DebounceEngine_getAverageLatency(engine), engine->latencyMaxMs);
+
+        TEST_ASSERT_EQUAL_UINT32(trace.transitions, engine->transitions);
+        TEST_ASSERT_EQUAL_UINT32(trace.transitions, referenceTransitions);
+        TEST_ASSERT_EQUAL_UINT64(trace.latencyTotalMs, engine->latencyTotalMs);
+        TEST_ASSERT_EQUAL_UINT32(0, engine->activeWords);
+        TEST_ASSERT_TRUE(rate > reference);
+
+        DebounceEngine_Destroy(engine);
+        free(trace.edges);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_replay_bouncing_traces);
+    return UNITY_END();
+}
@@ -1,22 +1,34 @@
 #include <stdio.h>
 #include "Led.h"
 #include "ButtonHandler.h"
+#include "InterruptController.h"
 
 
 int main(void)
 {
 
     LED* itsLED;
+    InterruptController* itsController;
 
     itsLED = LED_Create();
+    itsController = InterruptController_Create(ISRAddress, 10);
 
     for (int j=0;j<9;j++) {
         ISRAddress[j] = NULL;
         oldVectors[j] = NULL;
     }
     ButtonHandler_setItsLED(itsLED);
+    ButtonHandler_setItsInterruptController(itsController);
     install(); /* install interrupt vectors */
+    InterruptController_start(itsController);
     /* normal system execution stuff */
 
+    InterruptController_raise(itsController, 0); /* button pushed */
+    InterruptController_waitIdle(itsController);
+    printf("LED after push: %d\n", itsLED->LEDStatus);
+
+    InterruptController_Destroy(itsController);
+    deinstall();
+    LED_Destroy(itsLED);
     return 0;
 }
@@ -3,24 +3,39 @@
 //
 
 #include "ButtonHandler.h"
+#include "InterruptController.h"
 #include "Led.h"
 #include "RobotInterruptVectorTable.h"
 
 ButtonVectorPtr oldVectors[10];
 
 static struct LED* itsLED;
+static struct InterruptController* itsInterruptController;
 
 void deinstall(void) {
     ISRAddress[0] = oldVectors[0];
     ISRAddress[1] = oldVectors[1];
 }
 
+/* Bottom halves: run by the interrupt controller outside interrupt context */
+static void lightOn(void* led) {
+    LED_LightOn((LED*)led);
+}
+
+static void lightOff(void* led) {
+    LED_LightOff((LED*)led);
+}
+
 void handleButtonPushInterrupt(void) {
-    LED_LightOn(itsLED);
+    if (itsInterruptController == NULL || !InterruptController_defer(itsInterruptController, lightOn, itsLED)) {
+        LED_LightOn(itsLED);
+    }
 }
 
 void handleButtonReleaseInterrupt(void) {
-    LED_LightOff(itsLED);
+    if (itsInterruptController == NULL || !InterruptController_defer(itsInterruptController, lightOff, itsLED)) {
+        LED_LightOff(itsLED);
+    }
 }
 
 void install(void) {
@@ -37,3 +52,11 @@ struct LED* ButtonHandler_getItsLED(void) {
 void ButtonHandler_setItsLED(struct LED* p_LED) {
     itsLED = p_LED;
 }
+
+struct InterruptController* ButtonHandler_getItsInterruptController(void) {
+    return itsInterruptController;
+}
+
+void ButtonHandler_setItsInterruptController(struct InterruptController* p_InterruptController) {
+    itsInterruptController = p_InterruptController;
+}
@@ -7,6 +7,7 @@
 
 typedef void (*ButtonVectorPtr)(void);
 struct LED;
+struct InterruptController;
 
 extern ButtonVectorPtr oldVectors[10];
 extern ButtonVectorPtr ISRAddress[10];
@@ -21,4 +22,8 @@ void handleButtonReleaseInterrupt(void);
 struct LED* ButtonHandler_getItsLED(void);
 void ButtonHandler_setItsLED(struct LED* p_LED);
 
+/* With a controller the handlers only defer the LED update as a bottom half */
+struct InterruptController* ButtonHandler_getItsInterruptController(void);
+void ButtonHandler_setItsInterruptController(struct InterruptController* p_InterruptController);
+
 #endif //UNTITLED1_BUTTONHANDLER_H
@@ -0,0 +1,417 @@
+//
+// Simulated interrupt controller: a signal handler on the CPU thread is
+// the interrupt entry. It is installed with SA_NODEFER, so a raise that
+// arrives while a handler runs enters the handler again on top of it; the
+// nested entry dispatches only vectors more urgent than the one running,
+// like an NVIC preempting on priority. The entry and everything handlers
+// are expected to call (raise, defer) are lock-free and async-signal-safe.
+//
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime, pthread_kill, sigaction
+
+#include "InterruptController.h"
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define INTERRUPT_SIGNAL SIGUSR1
+
+#define LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+
+/* The controller whose CPU thread takes INTERRUPT_SIGNAL */
+static InterruptController* active;
+static struct sigaction previous;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bitOf(unsigned int vector) {
+    return (uint32_t)1 << vector;
+}
+
+/* Pending vectors allowed to interrupt right now */
+static uint32_t ready(const InterruptController* const me) {
+    if (!LOAD(&me->enabled)) {
+        return 0;
+    }
+    return LOAD(&me->pending) & LOAD(&me->unmasked);
+}
+
+/* Interrupt the CPU thread */
+static void kick(InterruptController* const me) {
+    if (LOAD(&me->started) && !LOAD(&me->stopping)) {
+        pthread_kill(me->cpu, INTERRUPT_SIGNAL);
+    }
+}
+
+static void record(InterruptController* const me, unsigned int vector, uint64_t latency) {
+    InterruptStats* stats = &me->stats[vector];
+
+    if (ADD(&stats->dispatched, 1u) == 0 || latency < LOAD(&stats->latencyMinNs)) {
+        STORE(&stats->latencyMinNs, latency);
+    }
+    if (latency > LOAD(&stats->latencyMaxNs)) {
+        STORE(&stats->latencyMaxNs, latency);
+    }
+    ADD(&stats->latencyTotalNs, latency);
+}
+
+/**
+ * Run every ready vector more urgent than the one being serviced, most
+ * urgent first, lowest vector first within a priority.
+ */
+static void dispatch(InterruptController* const me) {
+    for (;;) {
+        unsigned int running = LOAD(&me->running);
+        uint32_t bits = 0;
+        unsigned int p;
+
+        uint32_t candidates = ready(me);
+        for (p = 0; p < running && candidates != 0; p++) {
+            bits = candidates & LOAD(&me->priorityMask[p]);
+            if (bits != 0) {
+                break;
+            }
+        }
+        if (bits == 0) {
+            return;
+        }
+
+        unsigned int vector = (unsigned int)__builtin_ctz(bits);
+        uint32_t bit = bitOf(vector);
+        uint64_t raisedAt = LOAD(&me->raisedNs[vector]);
+
+        /* Count the handler before claiming so waitIdle never sees neither */
+        unsigned int depth = ADD(&me->depth, 1u) + 1u;
+        if ((__atomic_fetch_and(&me->pending, ~bit, __ATOMIC_ACQ_REL) & bit) == 0) {
+            ADD(&me->depth, -1u);  /* A nested entry took it */
+            continue;
+        }
+        record(me, vector, nowNs() - raisedAt);
+        if (depth > me->maxDepth) {
+            STORE(&me->maxDepth, depth);
+        }
+
+        STORE(&me->running, p);
+        InterruptVector isr = LOAD(&me->table[vector]);
+        if (isr != NULL) {
+            isr();
+        }
+        STORE(&me->running, running);
+        ADD(&me->depth, -1u);
+    }
+}
+
+static void interruptEntry(int signo) {
+    int savedErrno = errno;
+    InterruptController* me = LOAD(&active);
+
+    (void)signo;
+    if (me != NULL) {
+        dispatch(me);
+    }
+    errno = savedErrno;
+}
+
+/* Single consumer: only the CPU thread dequeues */
+static int runBottomHalf(InterruptController* const me) {
+    size_t pos = me->dequeuePos;
+    InterruptBottomHalfSlot* slot = &me->bottomHalves[pos & (INTERRUPT_BOTTOM_HALVES - 1u)];
+
+    if (LOAD(&slot->sequence) != pos + 1u) {
+        return 0;  /* Empty, or the producer has not published yet */
+    }
+    BottomHalf work = slot->work;
+    void* arg = slot->arg;
+
+    STORE(&me->dequeuePos, pos + 1u);
+    STORE(&slot->sequence, pos + INTERRUPT_BOTTOM_HALVES);
+    work(arg);
+    ADD(&me->bottomHalvesRun, 1u);
+    return 1;
+}
+
+static void* cpuThread(void* arg) {
+    InterruptController* me = (InterruptController*)arg;
+
+    while (!LOAD(&me->stopping)) {
+        while (sem_wait(&me->work) != 0 && errno == EINTR) {
+            /* Interrupted by an interrupt: keep waiting */
+        }
+        while (runBottomHalf(me)) {
+        }
+    }
+    while (runBottomHalf(me)) {
+    }
+    return NULL;
+}
+
+static int createCpuThread(InterruptController* const me) {
+    pthread_attr_t attr;
+    struct sched_param param;
+    int created = -1;
+
+    /* As urgent as the host allows: needs CAP_SYS_NICE or an rtprio limit */
+    if (pthread_attr_init(&attr) == 0) {
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+        if (pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0 &&
+            pthread_attr_setschedpolicy(&attr, SCHED_FIFO) == 0 && pthread_attr_setschedparam(&attr, &param) == 0) {
+            created = pthread_create(&me->cpu, &attr, cpuThread, me);
+        }
+        pthread_attr_destroy(&attr);
+    }
+    me->realtime = (created == 0);
+    if (created != 0) {
+        created = pthread_create(&me->cpu, NULL, cpuThread, me);
+    }
+    return created == 0;
+}
+
+void InterruptController_Init(InterruptController* const me, InterruptVector* table, unsigned int vectors) {
+    if (me == NULL) {
+        return;
+    }
+
+    memset(me, 0, sizeof(*me));
+    me->table = table;
+    me->vectors = (vectors < INTERRUPT_MAX_VECTORS) ? vectors : INTERRUPT_MAX_VECTORS;
+    me->unmasked = (me->vectors < 32u) ? bitOf(me->vectors) - 1u : ~(uint32_t)0;
+    me->enabled = 1;
+    me->running = INTERRUPT_PRIORITY_LEVELS;
+
+    /* Fixed priority out of reset: the lower the vector, the more urgent */
+    for (unsigned int v = 0; v < me->vectors; v++) {
+        unsigned int p = (v < INTERRUPT_PRIORITY_LEVELS) ? v : INTERRUPT_PRIORITY_LEVELS - 1u;
+        me->priority[v] = (unsigned char)p;
+        me->priorityMask[p] |= bitOf(v);
+    }
+    for (size_t i = 0; i < INTERRUPT_BOTTOM_HALVES; i++) {
+        me->bottomHalves[i].sequence = i;
+    }
+    sem_init(&me->work, 0, 0);
+}
+
+void InterruptController_Cleanup(InterruptController* const me) {
+    if (me == NULL) {
+        return;
+    }
+
+    InterruptController_stop(me);
+    sem_destroy(&me->work);
+}
+
+InterruptController* InterruptController_Create(InterruptVector* table, unsigned int vectors) {
+    InterruptController* me = (InterruptController*)malloc(sizeof(InterruptController));
+    if (me != NULL) {
+        InterruptController_Init(me, table, vectors);
+    }
+    return me;
+}
+
+void InterruptController_Destroy(InterruptController* const me) {
+    if (me != NULL) {
+        InterruptController_Cleanup(me);
+    }
+    free(me);
+}
+
+int InterruptController_start(InterruptController* const me) {
+    struct sigaction action;
+    InterruptController* expected = NULL;
+
+    if (me == NULL || me->started ||
+        !__atomic_compare_exchange_n(&active, &expected, me, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = interruptEntry;
+    action.sa_flags = SA_NODEFER | SA_RESTART;  /* Let urgent vectors nest */
+    sigemptyset(&action.sa_mask);
+    if (sigaction(INTERRUPT_SIGNAL, &action, &previous) != 0) {
+        STORE(&active, NULL);
+        return 0;
+    }
+
+    STORE(&me->stopping, 0);
+    if (!createCpuThread(me)) {
+        sigaction(INTERRUPT_SIGNAL, &previous, NULL);
+        STORE(&active, NULL);
+        return 0;
+    }
+    STORE(&me->started, 1);
+    kick(me);  /* Whatever was raised before the start */
+    return 1;
+}
+
+void InterruptController_stop(InterruptController* const me) {
+    if (me == NULL || !me->started) {
+        return;
+    }
+
+    STORE(&me->stopping, 1);
+    sem_post(&me->work);
+    pthread_join(me->cpu, NULL);
+    STORE(&me->started, 0);
+    sigaction(INTERRUPT_SIGNAL, &previous, NULL);
+    STORE(&active, NULL);
+}
+
+void InterruptController_setPriority(InterruptController* const me, unsigned int vector, unsigned int priority) {
+    if (me == NULL || vector >= me->vectors || priority >= INTERRUPT_PRIORITY_LEVELS) {
+        return;
+    }
+
+    unsigned int old = me->priority[vector];
+    uint32_t bit = bitOf(vector);
+
+    /* Briefly at both levels rather than none, so it is never lost */
+    __atomic_fetch_or(&me->priorityMask[priority], bit, __ATOMIC_ACQ_REL);
+    me->priority[vector] = (unsigned char)priority;
+    if (old != priority) {
+        __atomic_fetch_and(&me->priorityMask[old], ~bit, __ATOMIC_ACQ_REL);
+    }
+    if (ready(me) & bit) {
+        kick(me);
+    }
+}
+
+void InterruptController_mask(InterruptController* const me, unsigned int vector) {
+    if (me != NULL && vector < me->vectors) {
+        __atomic_fetch_and(&me->unmasked, ~bitOf(vector), __ATOMIC_ACQ_REL);
+    }
+}
+
+void InterruptController_unmask(InterruptController* const me, unsigned int vector) {
+    if (me != NULL && vector < me->vectors) {
+        __atomic_fetch_or(&me->unmasked, bitOf(vector), __ATOMIC_ACQ_REL);
+        if (ready(me) & bitOf(vector)) {
+            kick(me);
+        }
+    }
+}
+
+void InterruptController_disable(InterruptController* const me) {
+    if (me != NULL) {
+        STORE(&me->enabled, 0);
+    }
+}
+
+void InterruptController_enable(InterruptController* const me) {
+    if (me != NULL) {
+        STORE(&me->enabled, 1);
+        if (ready(me) != 0) {
+            kick(me);
+        }
+    }
+}
+
+int InterruptController_raise(InterruptController* const me, unsigned int vector) {
+    if (me == NULL || vector >= me->vectors) {
+        return 0;
+    }
+
+    uint32_t bit = bitOf(vector);
+
+    ADD(&me->stats[vector].raised, 1u);
+    if ((LOAD(&me->pending) & bit) == 0) {
+        STORE(&me->raisedNs[vector], nowNs());
+    }
+    if (__atomic_fetch_or(&me->pending, bit, __ATOMIC_ACQ_REL) & bit) {
+        ADD(&me->stats[vector].coalesced, 1u);  /* Still pending: one dispatch serves both */
+    } else if (ready(me) & bit) {
+        kick(me);
+    }
+    return 1;
+}
+
+int InterruptController_defer(InterruptController* const me, BottomHalf work, void* arg) {
+    if (me == NULL || work == NULL) {
+        return 0;
+    }
+
+    size_t pos = LOAD(&me->enqueuePos);
+    InterruptBottomHalfSlot* slot;
+
+    for (;;) {
+        slot = &me->bottomHalves[pos & (INTERRUPT_BOTTOM_HALVES - 1u)];
+        size_t sequence = LOAD(&slot->sequence);
+
+        if (sequence == pos) {
+            if (__atomic_compare_exchange_n(&me->enqueuePos, &pos, pos + 1u, 1, __ATOMIC_ACQ_REL,
+                                            __ATOMIC_ACQUIRE)) {
+                break;
+            }
+        } else if ((ptrdiff_t)(sequence - pos) < 0) {
+            ADD(&me->bottomHalvesDropped, 1u);  /* Full: the consumer is a lap behind */
+            return 0;
+        } else {
+            pos = LOAD(&me->enqueuePos);
+        }
+    }
+    slot->work = work;
+    slot->arg = arg;
+    STORE(&slot->sequence, pos + 1u);
+    sem_post(&me->work);
+    return 1;
+}
+
+void InterruptController_waitIdle(InterruptController* const me) {
+    if (me == NULL || !me->started) {
+        return;
+    }
+
+    while (ready(me) != 0 || LOAD(&me->depth) != 0 || LOAD(&me->bottomHalvesRun) != LOAD(&me->enqueuePos)) {
+        sched_yield();
+    }
+}
+
+void InterruptController_getStats(const InterruptController* const me, unsigned int vector, InterruptStats* out) {
+    if (out == NULL) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (me != NULL && vector < me->vectors) {
+        const InterruptStats* stats = &me->stats[vector];
+        out->raised = LOAD(&stats->raised);
+        out->coalesced = LOAD(&stats->coalesced);
+        out->dispatched = LOAD(&stats->dispatched);
+        out->latencyTotalNs = LOAD(&stats->latencyTotalNs);
+        out->latencyMinNs = LOAD(&stats->latencyMinNs);
+        out->latencyMaxNs = LOAD(&stats->latencyMaxNs);
+    }
+}
+
+int InterruptController_isPending(const InterruptController* const me, unsigned int vector) {
+    if (me == NULL || vector >= me->vectors) {
+        return 0;
+    }
+    return (LOAD(&me->pending) & bitOf(vector)) != 0;
+}
+
+unsigned int InterruptController_getMaxDepth(const InterruptController* const me) {
+    return (me != NULL) ? LOAD(&me->maxDepth) : 0;
+}
+
+unsigned int InterruptController_getDepth(const InterruptController* const me) {
+    return (me != NULL) ? LOAD(&me->depth) : 0;
+}
+
+size_t InterruptController_getBottomHalvesRun(const InterruptController* const me) {
+    return (me != NULL) ? LOAD(&me->bottomHalvesRun) : 0;
+}
+
+unsigned long InterruptController_getBottomHalvesDropped(const InterruptController* const me) {
+    return (me != NULL) ? LOAD(&me->bottomHalvesDropped) : 0;
+}
@@ -0,0 +1,117 @@
+//
+// Simulated interrupt controller for Linux hosts.
+//
+// A dedicated "CPU" thread plays the processor. Raising a vector sets its
+// pending bit and signals that thread (SIGUSR1); the signal handler is the
+// interrupt entry and dispatches the most urgent pending, unmasked vector
+// through the vector table. Handlers run with the signal unblocked, so a more
+// urgent vector raised meanwhile nests on top of them. Handlers should do
+// the minimum and defer the rest as a bottom half, which the CPU thread
+// runs outside interrupt context.
+//
+// Only one controller can be started at a time: the signal handler is
+// process-wide.
+//
+
+#ifndef UNTITLED1_INTERRUPTCONTROLLER_H
+#define UNTITLED1_INTERRUPTCONTROLLER_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define INTERRUPT_MAX_VECTORS 32        /* One bit per vector */
+#define INTERRUPT_PRIORITY_LEVELS 8     /* 0 is the most urgent */
+#define INTERRUPT_BOTTOM_HALVES 1024    /* Deferred work queue, power of two */
+
+typedef void (*InterruptVector)(void);
+typedef void (*BottomHalf)(void* arg);
+
+typedef struct InterruptStats InterruptStats;
+struct InterruptStats
+{
+    unsigned long raised;       /* InterruptController_raise calls */
+    unsigned long coalesced;    /* Raised while already pending */
+    unsigned long dispatched;   /* Handler entries */
+    uint64_t latencyTotalNs;    /* Raise to handler entry */
+    uint64_t latencyMinNs;
+    uint64_t latencyMaxNs;
+};
+
+typedef struct InterruptBottomHalfSlot InterruptBottomHalfSlot;
+struct InterruptBottomHalfSlot
+{
+    size_t sequence;
+    BottomHalf work;
+    void* arg;
+};
+
+typedef struct InterruptController InterruptController;
+struct InterruptController
+{
+    InterruptVector* table;     /* Vector table, read at every dispatch */
+    unsigned int vectors;
+
+    uint32_t pending;           /* Raised, not yet dispatched */
+    uint32_t unmasked;          /* Vectors allowed to interrupt */
+    uint32_t priorityMask[INTERRUPT_PRIORITY_LEVELS];   /* Vectors at each priority */
+    unsigned char priority[INTERRUPT_MAX_VECTORS];
+    int enabled;                /* Global interrupt enable */
+    uint64_t raisedNs[INTERRUPT_MAX_VECTORS];
+    InterruptStats stats[INTERRUPT_MAX_VECTORS];
+
+    /* CPU thread state, only written on that thread */
+    unsigned int running;       /* Priority being serviced, LEVELS in thread mode */
+    unsigned int depth;         /* Handlers currently nested */
+    unsigned int maxDepth;
+
+    /* Bottom halves: bounded multi-producer queue, drained by the CPU thread */
+    InterruptBottomHalfSlot bottomHalves[INTERRUPT_BOTTOM_HALVES];
+    size_t enqueuePos;
+    size_t dequeuePos;
+    size_t bottomHalvesRun;
+    unsigned long bottomHalvesDropped;
+    sem_t work;
+
+    pthread_t cpu;
+    int started;
+    int stopping;
+    int realtime;               /* CPU thread got SCHED_FIFO */
+};
+
+void InterruptController_Init(InterruptController* const me, InterruptVector* table, unsigned int vectors);
+void InterruptController_Cleanup(InterruptController* const me);
+
+InterruptController* InterruptController_Create(InterruptVector* table, unsigned int vectors);
+void InterruptController_Destroy(InterruptController* const me);
+
+/* Start and stop the CPU thread; stop raising before stopping */
+int InterruptController_start(InterruptController* const me);
+void InterruptController_stop(InterruptController* const me);
+
+/* Configuration */
+void InterruptController_setPriority(InterruptController* const me, unsigned int vector, unsigned int priority);
+void InterruptController_mask(InterruptController* const me, unsigned int vector);
+void InterruptController_unmask(InterruptController* const me, unsigned int vector);
+void InterruptController_disable(InterruptController* const me);
+void InterruptController_enable(InterruptController* const me);
+
+/* The "hardware" side: callable from any thread, including handlers */
+int InterruptController_raise(InterruptController* const me, unsigned int vector);
+
+/* Called by handlers: queue work for the CPU thread, 0 if the queue is full */
+int InterruptController_defer(InterruptController* const me, BottomHalf work, void* arg);
+
+/* Wait until nothing is pending, running or deferred (unmasked vectors only) */
+void InterruptController_waitIdle(InterruptController* const me);
+
+/* Instrumentation */
+void InterruptController_getStats(const InterruptController* const me, unsigned int vector, InterruptStats* out);
+int InterruptController_isPending(const InterruptController* const me, unsigned int vector);
+unsigned int InterruptController_getMaxDepth(const InterruptController* const me);
+unsigned int InterruptController_getDepth(const InterruptController* const me);
+size_t InterruptController_getBottomHalvesRun(const InterruptController* const me);
+unsigned long InterruptController_getBottomHalvesDropped(const InterruptController* const me);
+
+#endif //UNTITLED1_INTERRUPTCONTROLLER_H
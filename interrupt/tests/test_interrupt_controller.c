@@ -0,0 +1,277 @@
+#include <unity.h>
+#include "InterruptController.h"
+#include "ButtonHandler.h"
+#include "Led.h"
+
+#define VECTORS (8)
+
+// Test fixtures
+InterruptController* p_Controller;
+InterruptVector table[VECTORS];
+unsigned int order[16];
+unsigned int depthAt[VECTORS];
+unsigned int entries;
+
+static void logEntry(unsigned int vector) {
+    depthAt[vector] = InterruptController_getDepth(p_Controller);
+    if (entries < sizeof(order) / sizeof(order[0])) {
+        order[entries] = vector;
+    }
+    entries++;
+}
+
+static void isr1(void) {
+    logEntry(1);
+}
+
+static void isr3(void) {
+    logEntry(3);
+}
+
+static void isr5(void) {
+    logEntry(5);
+}
+
+// Raises something more urgent than itself, then finishes
+static void isr6RaisesUrgent(void) {
+    logEntry(6);
+    InterruptController_raise(p_Controller, 1);
+    order[entries++] = 100 + InterruptController_getDepth(p_Controller);
+}
+
+// Raises something less urgent than itself, then finishes
+static void isr1RaisesLater(void) {
+    logEntry(1);
+    InterruptController_raise(p_Controller, 6);
+    order[entries++] = 100 + InterruptController_getDepth(p_Controller);
+}
+
+static void isr6(void) {
+    logEntry(6);
+}
+
+static void countWork(void* arg) {
+    (*(unsigned int*)arg)++;
+}
+
+void setUp(void) {
+    for (unsigned int v = 0; v < VECTORS; v++) {
+        table[v] = NULL;
+        depthAt[v] = 0;
+    }
+    entries = 0;
+    p_Controller = InterruptController_Create(table, VECTORS);
+}
+
+void tearDown(void) {
+    InterruptController_Destroy(p_Controller);
+}
+
+// A raised vector runs its handler once and is instrumented
+void test_raise_dispatches_handler(void) {
+    InterruptStats stats;
+
+    table[3] = isr3;
+    TEST_ASSERT_EQUAL(1, InterruptController_start(p_Controller));
+    TEST_ASSERT_EQUAL(1, InterruptController_raise(p_Controller, 3));
+    InterruptController_waitIdle(p_Controller);
+
+    TEST_ASSERT_EQUAL(1, entries);
+    TEST_ASSERT_EQUAL(3, order[0]);
+    TEST_ASSERT_EQUAL(1, depthAt[3]);
+    TEST_ASSERT_EQUAL(0, InterruptController_isPending(p_Controller, 3));
+
+    InterruptController_getStats(p_Controller, 3, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.raised);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dispatched);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT64(stats.latencyTotalNs, stats.latencyMaxNs);
+    TEST_ASSERT_EQUAL_UINT64(stats.latencyMinNs, stats.latencyMaxNs);
+}
+
+// A masked vector stays pending until it is unmasked
+void test_masked_vector_waits_for_unmask(void) {
+    table[3] = isr3;
+    InterruptController_start(p_Controller);
+    InterruptController_mask(p_Controller, 3);
+    InterruptController_raise(p_Controller, 3);
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(0, entries);
+    TEST_ASSERT_EQUAL(1, InterruptController_isPending(p_Controller, 3));
+
+    InterruptController_unmask(p_Controller, 3);
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(1, entries);
+    TEST_ASSERT_EQUAL(0, InterruptController_isPending(p_Controller, 3));
+}
+
+// Vectors pending while interrupts are disabled run most urgent first
+void test_pending_vectors_run_in_priority_order(void) {
+    table[1] = isr1;
+    table[3] = isr3;
+    table[5] = isr5;
+    InterruptController_setPriority(p_Controller, 5, 0);
+    InterruptController_start(p_Controller);
+
+    InterruptController_disable(p_Controller);
+    InterruptController_raise(p_Controller, 3);
+    InterruptController_raise(p_Controller, 1);
+    InterruptController_raise(p_Controller, 5);
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(0, entries);
+
+    InterruptController_enable(p_Controller);
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(3, entries);
+    TEST_ASSERT_EQUAL(5, order[0]);
+    TEST_ASSERT_EQUAL(1, order[1]);
+    TEST_ASSERT_EQUAL(3, order[2]);
+    TEST_ASSERT_EQUAL(1, InterruptController_getMaxDepth(p_Controller));
+}
+
+// A more urgent vector preempts the handler that raised it
+void test_urgent_vector_nests(void) {
+    table[6] = isr6RaisesUrgent;
+    table[1] = isr1;
+    InterruptController_start(p_Controller);
+    InterruptController_raise(p_Controller, 6);
+    InterruptController_waitIdle(p_Controller);
+
+    TEST_ASSERT_EQUAL(3, entries);
+    TEST_ASSERT_EQUAL(6, order[0]);
+    TEST_ASSERT_EQUAL(1, order[1]);    // Before the raising handler finished
+    TEST_ASSERT_EQUAL(101, order[2]);  // Back in vector 6 at depth 1
+    TEST_ASSERT_EQUAL(1, depthAt[6]);
+    TEST_ASSERT_EQUAL(2, depthAt[1]);
+    TEST_ASSERT_EQUAL(2, InterruptController_getMaxDepth(p_Controller));
+}
+
+// A less urgent vector waits for the running handler to return
+void test_less_urgent_vector_does_not_nest(void) {
+    table[1] = isr1RaisesLater;
+    table[6] = isr6;
+    InterruptController_start(p_Controller);
+    InterruptController_raise(p_Controller, 1);
+    InterruptController_waitIdle(p_Controller);
+
+    TEST_ASSERT_EQUAL(3, entries);
+    TEST_ASSERT_EQUAL(1, order[0]);
+    TEST_ASSERT_EQUAL(101, order[1]);
+    TEST_ASSERT_EQUAL(6, order[2]);
+    TEST_ASSERT_EQUAL(1, depthAt[6]);
+    TEST_ASSERT_EQUAL(1, InterruptController_getMaxDepth(p_Controller));
+}
+
+// Raises while a vector is pending are served by one dispatch
+void test_raises_coalesce_while_pending(void) {
+    InterruptStats stats;
+
+    table[4] = isr3;
+    InterruptController_start(p_Controller);
+    InterruptController_disable(p_Controller);
+    for (int i = 0; i < 3; i++) {
+        InterruptController_raise(p_Controller, 4);
+    }
+    InterruptController_enable(p_Controller);
+    InterruptController_waitIdle(p_Controller);
+
+    InterruptController_getStats(p_Controller, 4, &stats);
+    TEST_ASSERT_EQUAL(1, entries);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.raised);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dispatched);
+}
+
+// Bottom halves queue up to capacity and run on the CPU thread
+void test_bottom_halves_overflow_and_drain(void) {
+    unsigned int ran = 0;
+
+    for (int i = 0; i < INTERRUPT_BOTTOM_HALVES; i++) {
+        TEST_ASSERT_EQUAL(1, InterruptController_defer(p_Controller, countWork, &ran));
+    }
+    TEST_ASSERT_EQUAL(0, InterruptController_defer(p_Controller, countWork, &ran));
+    TEST_ASSERT_EQUAL_UINT32(1, InterruptController_getBottomHalvesDropped(p_Controller));
+
+    InterruptController_start(p_Controller);
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(INTERRUPT_BOTTOM_HALVES, ran);
+    TEST_ASSERT_EQUAL(INTERRUPT_BOTTOM_HALVES, InterruptController_getBottomHalvesRun(p_Controller));
+
+    TEST_ASSERT_EQUAL(1, InterruptController_defer(p_Controller, countWork, &ran));
+    InterruptController_waitIdle(p_Controller);
+    TEST_ASSERT_EQUAL(INTERRUPT_BOTTOM_HALVES + 1, ran);
+}
+
+// The button handlers only defer the LED update to a bottom half
+void test_button_handlers_defer_led(void) {
+    InterruptController* p_Robot = InterruptController_Create(ISRAddress, 10);
+    LED* p_LED = LED_Create();
+
+    InterruptController_Destroy(p_Controller);
+    p_Controller = NULL;
+    for (int i = 0; i < 10; i++) {
+        ISRAddress[i] = NULL;
+    }
+    ButtonHandler_setItsLED(p_LED);
+    ButtonHandler_setItsInterruptController(p_Robot);
+    TEST_ASSERT_EQUAL_PTR(p_Robot, ButtonHandler_getItsInterruptController());
+    install();
+    InterruptController_start(p_Robot);
+
+    InterruptController_raise(p_Robot, 0);
+    InterruptController_waitIdle(p_Robot);
+    TEST_ASSERT_EQUAL(LED_ON, p_LED->LEDStatus);
+
+    InterruptController_raise(p_Robot, 1);
+    InterruptController_waitIdle(p_Robot);
+    TEST_ASSERT_EQUAL(LED_OFF, p_LED->LEDStatus);
+    TEST_ASSERT_EQUAL(2, InterruptController_getBottomHalvesRun(p_Robot));
+
+    /* Without a controller the handlers still work when called directly */
+    InterruptController_Destroy(p_Robot);
+    ButtonHandler_setItsInterruptController(NULL);
+    handleButtonPushInterrupt();
+    TEST_ASSERT_EQUAL(LED_ON, p_LED->LEDStatus);
+    deinstall();
+    LED_Destroy(p_LED);
+}
+
+// Test NULL pointer and range safety
+void test_null_safety(void) {
+    InterruptStats stats;
+
+    TEST_ASSERT_EQUAL(0, InterruptController_raise(NULL, 0));
+    TEST_ASSERT_EQUAL(0, InterruptController_raise(p_Controller, VECTORS));
+    TEST_ASSERT_EQUAL(0, InterruptController_defer(NULL, countWork, NULL));
+    TEST_ASSERT_EQUAL(0, InterruptController_defer(p_Controller, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, InterruptController_start(NULL));
+    InterruptController_setPriority(p_Controller, 0, INTERRUPT_PRIORITY_LEVELS);
+    InterruptController_mask(NULL, 0);
+    InterruptController_stop(p_Controller);  // Not started
+    InterruptController_waitIdle(p_Controller);
+    InterruptController_getStats(p_Controller, VECTORS, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.raised);
+
+    /* Only one controller takes the interrupt signal at a time */
+    InterruptController* p_Other = InterruptController_Create(table, VECTORS);
+    TEST_ASSERT_EQUAL(1, InterruptController_start(p_Controller));
+    TEST_ASSERT_EQUAL(0, InterruptController_start(p_Other));
+    InterruptController_Destroy(p_Other);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Register tests
+    RUN_TEST(test_raise_dispatches_handler);
+    RUN_TEST(test_masked_vector_waits_for_unmask);
+    RUN_TEST(test_pending_vectors_run_in_priority_order);
+    RUN_TEST(test_urgent_vector_nests);
+    RUN_TEST(test_less_urgent_vector_does_not_nest);
+    RUN_TEST(test_raises_coalesce_while_pending);
+    RUN_TEST(test_bottom_halves_overflow_and_drain);
+    RUN_TEST(test_button_handlers_defer_led);
+    RUN_TEST(test_null_safety);
+
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#define _POSIX_C_SOURCE 200809L  // clock_gettime, nanosleep
+
+#include <unity.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include "InterruptController.h"
+
+/*
+    Host measurements: interrupt-to-handler latency of lone raises, then a
+    storm of raises from several "peripheral" threads at once. Handlers do
+    the minimum, as the button handlers do: count, and defer the rest.
+*/
+
+#define VECTORS (8)
+#define RAISERS (4)
+#define LONE_RAISES (20000)
+#define STORM_MS (200)
+
+// Test fixtures
+InterruptController* p_Controller;
+InterruptVector table[VECTORS];
+unsigned long handled[VECTORS];
+unsigned long deferredWork;
+int raising;
+
+typedef struct {
+    uint32_t seed;
+    unsigned long raises;
+} Raiser;
+
+static void bottomHalf(void* arg) {
+    (void)arg;
+    deferredWork++;
+}
+
+#define HANDLER(v)                                                                                                     \
+    static void isr##v(void) {                                                                                         \
+        handled[v]++;                                                                                                  \
+        InterruptController_defer(p_Controller, bottomHalf, NULL);                                                     \
+    }
+HANDLER(0)
+HANDLER(1)
+HANDLER(2)
+HANDLER(3)
+HANDLER(4)
+HANDLER(5)
+HANDLER(6)
+HANDLER(7)
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void* raiseStorm(void* arg) {
+    Raiser* raiser = (Raiser*)arg;
+
+    while (__atomic_load_n(&raising, __ATOMIC_ACQUIRE)) {
+        raiser->seed ^= raiser->seed << 13;
+        raiser->seed ^= raiser->seed >> 17;
+        raiser->seed ^= raiser->seed << 5;
+        InterruptController_raise(p_Controller, raiser->seed % VECTORS);
+        raiser->raises++;
+    }
+    return NULL;
+}
+
+static void printStats(double elapsed) {
+    unsigned long dispatched = 0;
+
+    printf("  %6s %8s %10s %10s %10s %12s %12s\n", "vector", "priority", "raised", "coalesced", "dispatched",
+           "avg lat us", "max lat us");
+    for (unsigned int v = 0; v < VECTORS; v++) {
+        InterruptStats stats;
+        InterruptController_getStats(p_Controller, v, &stats);
+        printf("  %6u %8u %10lu %10lu %10lu %12.2f %12.2f\n", v, (unsigned int)p_Controller->priority[v],
+               stats.raised, stats.coalesced, stats.dispatched,
+               stats.dispatched ? (double)stats.latencyTotalNs / (double)stats.dispatched / 1e3 : 0.0,
+               (double)stats.latencyMaxNs / 1e3);
+        dispatched += stats.dispatched;
+    }
+    printf("  %.0f dispatches/s, max nesting %u, cpu thread %s\n", (double)dispatched / elapsed,
+           InterruptController_getMaxDepth(p_Controller), p_Controller->realtime ? "SCHED_FIFO" : "default policy");
+}
+
+static void checkAccounting(void) {
+    unsigned long dispatched = 0;
+
+    for (unsigned int v = 0; v < VECTORS; v++) {
+        InterruptStats stats;
+        InterruptController_getStats(p_Controller, v, &stats);
+        /* Every raise is either served by its own dispatch or merged into one */
+        TEST_ASSERT_EQUAL_UINT32(stats.raised, stats.dispatched + stats.coalesced);
+        TEST_ASSERT_EQUAL_UINT32(stats.dispatched, handled[v]);
+        TEST_ASSERT_TRUE(stats.latencyMinNs <= stats.latencyMaxNs);
+        dispatched += stats.dispatched;
+    }
+    TEST_ASSERT_EQUAL_UINT32(dispatched, deferredWork + InterruptController_getBottomHalvesDropped(p_Controller));
+}
+
+void setUp(void) {
+    static const InterruptVector handlers[VECTORS] = {isr0, isr1, isr2, isr3, isr4, isr5, isr6, isr7};
+
+    for (unsigned int v = 0; v < VECTORS; v++) {
+        table[v] = handlers[v];
+        handled[v] = 0;
+    }
+    deferredWork = 0;
+    p_Controller = InterruptController_Create(table, VECTORS);
+    TEST_ASSERT_NOT_NULL(p_Controller);
+    TEST_ASSERT_EQUAL(1, InterruptController_start(p_Controller));
+}
+
+void tearDown(void) {
+    InterruptController_Destroy(p_Controller);
+}
+
+void test_lone_raise_latency(void) {
+    double start = seconds();
+
+    for (unsigned int i = 0; i < LONE_RAISES; i++) {
+        InterruptController_raise(p_Controller, i % VECTORS);
+        InterruptController_waitIdle(p_Controller);
+    }
+    double elapsed = seconds() - start;
+
+    printf("\n  lone raises, each waited for:\n");
+    printStats(elapsed);
+    checkAccounting();
+    for (unsigned int v = 0; v < VECTORS; v++) {
+        TEST_ASSERT_EQUAL_UINT32(LONE_RAISES / VECTORS, handled[v]);
+    }
+}
+
+void test_raise_storm(void) {
+    pthread_t threads[RAISERS];
+    Raiser raisers[RAISERS];
+    struct timespec storm = {0, STORM_MS * 1000000L};
+    unsigned long raises = 0;
+
+    __atomic_store_n(&raising, 1, __ATOMIC_RELEASE);
+    double start = seconds();
+    for (unsigned int i = 0; i < RAISERS; i++) {
+        raisers[i].seed = 2463534242u + i;
+        raisers[i].raises = 0;
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, raiseStorm, &raisers[i]));
+    }
+    nanosleep(&storm, NULL);
+    __atomic_store_n(&raising, 0, __ATOMIC_RELEASE);
+    for (unsigned int i = 0; i < RAISERS; i++) {
+        pthread_join(threads[i], NULL);
+        raises += raisers[i].raises;
+    }
+    InterruptController_waitIdle(p_Controller);
+    double elapsed = seconds() - start;
+
+    printf("\n  storm: %u raisers, %lu raises in %.0f ms:\n", RAISERS, raises, elapsed * 1e3);
+    printStats(elapsed);
+    checkAccounting();
+    TEST_ASSERT_TRUE(InterruptController_getMaxDepth(p_Controller) <= INTERRUPT_PRIORITY_LEVELS);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_lone_raise_latency);
+    RUN_TEST(test_raise_storm);
+    return UNITY_END();
+}
@@ -42,9 +42,24 @@ void ArrhythmiaDetector_update(void* instance, const struct TimeMarkedData tmd)
     printf("Observer (ArrhythmiaDetector) received update: TimeInterval: %ld DataValue: %d\n", 
            tmd.timeInterval, tmd.dataValue);
     // In a real implementation, this would analyze the ECG for arrhythmias
+    ArrhythmiaDetector_measureSTSegment(self, tmd.dataValue);
     ArrhythmiaDetector_indentifyArrhythmia(self);
 }
 
+/**
+ * Measure the ST segment height of a sample against the recent baseline
+ */
+int ArrhythmiaDetector_measureSTSegment(ArrhythmiaDetector* const self, int dataValue){
+    int64_t sum;
+    int n;
+
+    if (self->itsTMDQueue != NULL &&
+        (n = TMDQueue_windowSum(self->itsTMDQueue, ST_BASELINE_WINDOW, &sum)) > 0) {
+        self->STSegmentHeight = dataValue - (int)(sum / n);
+    }
+    return self->STSegmentHeight;
+}
+
 /**
  * Analyze ECG data to detect arrhythmias
  */
@@ -12,6 +12,9 @@
  * It analyzes ECG data to detect various heart arrhythmias.
  */
 
+/* Samples averaged for the baseline the ST segment is measured against */
+#define ST_BASELINE_WINDOW (200)
+
 typedef struct ArrhythmiaDetector ArrhythmiaDetector;
 struct ArrhythmiaDetector
 {
@@ -47,6 +50,11 @@ void ArrhythmiaDetector_update(void* instance, const struct TimeMarkedData tmd);
  */
 void ArrhythmiaDetector_indentifyArrhythmia(ArrhythmiaDetector* const self);
 
+/**
+ * Measure the ST segment height of a sample against the recent baseline
+ */
+int ArrhythmiaDetector_measureSTSegment(ArrhythmiaDetector* const self, int dataValue);
+
 /**
  * Get a data sample from the subject's queue
  */
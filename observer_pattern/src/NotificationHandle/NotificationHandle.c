@@ -16,6 +16,7 @@ static void cleanUpRelations(NotificationHandle* const self);
 void NotificationHandle_Init(NotificationHandle* const self) {
     self->itsNotificationHandle = NULL;
     self->updateAddr = NULL;
+    self->batchUpdateAddr = NULL;
     self->observerInstance = NULL;
 }
 
@@ -15,8 +15,12 @@ typedef struct NotificationHandle NotificationHandle;
 /* Forward declaration of function pointer type for observer's update method */
 typedef void (*UpdateFuncPtr)(void* observer, const struct TimeMarkedData tmd);
 
+/* Batch update method: receives count consecutive samples, oldest first, in one call */
+typedef void (*BatchUpdateFuncPtr)(void* observer, const struct TimeMarkedData* samples, int count);
+
 struct NotificationHandle {
     UpdateFuncPtr updateAddr;                     // Function pointer to observer's update method
+    BatchUpdateFuncPtr batchUpdateAddr;           // Batch update method, used instead when set
     void* observerInstance;                       // Pointer to the observer object
     struct NotificationHandle* itsNotificationHandle; // Next observer in the list
 };
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "QRSDetector.h"
 
 /**
@@ -14,14 +15,22 @@
  */
 
 static void cleanUpRelations(QRSDetector* const self);
+static void engineInit(QRSEngine* const engine);
+static int detectPeak(QRSEngine* const engine, int64_t peak, long peakSample);
+static void acceptBeat(QRSEngine* const engine, long beatSample, long beatTime);
+static long rSampleTime(const QRSEngine* const engine, long peakSample);
+static int rollingRate(const QRSEngine* const engine);
 
 /**
  * Initialize the QRSDetector observer
  */
 void QRSDetector_Init(QRSDetector* const self){
     self->heartRate = 0;
+    self->qrsAmplitude = 0;
+    self->batched = 0;
     self->index = 0;
     self->itsTMDQueue = NULL;
+    engineInit(&self->engine);
 }
 
 /**
@@ -29,7 +38,11 @@ void QRSDetector_Init(QRSDetector* const self){
  */
 void QRSDetector_Cleanup(QRSDetector* const self){
     if (self->itsTMDQueue != NULL) {
-        TMDQueue_unsubscribe(self->itsTMDQueue, (UpdateFuncPtr)QRSDetector_update);
+        if (self->batched) {
+            TMDQueue_unsubscribeBatch(self->itsTMDQueue, QRSDetector_updateBatch);
+        } else {
+            TMDQueue_unsubscribe(self->itsTMDQueue, (UpdateFuncPtr)QRSDetector_update);
+        }
     }
     cleanUpRelations(self);
 }
@@ -43,18 +56,128 @@ void QRSDetector_update(void* instance, const struct TimeMarkedData tmd) {
     QRSDetector* self = (QRSDetector*)instance;
     printf("Observer (QRSDetector) received update: TimeInterval: %ld DataValue: %d\n", 
            tmd.timeInterval, tmd.dataValue);
-    // In a real implementation, this would analyze the ECG waveform for QRS complexes
-    QRSDetector_computeHR(self);
+    QRSDetector_measureAmplitude(self);
+    if (QRSDetector_processSample(self, &tmd)) {
+        QRSDetector_computeHR(self);
+    }
+}
+
+/**
+ * Observer Pattern: batch UPDATE method implementation
+ */
+void QRSDetector_updateBatch(void* instance, const struct TimeMarkedData* samples, int count) {
+    QRSDetector* self = (QRSDetector*)instance;
+    int beats = 0;
+
+    for (int i = 0; i < count; i++) {
+        beats += QRSDetector_processSample(self, &samples[i]);
+    }
+    if (beats > 0) {
+        self->heartRate = rollingRate(&self->engine);
+    }
+}
+
+/**
+ * Feed one sample through the Pan-Tompkins chain
+ *
+ * band-pass (integer low-pass then high-pass), five-point derivative,
+ * squaring, moving-window integration, then adaptive thresholding of the
+ * integrator's local maxima with a 200 ms refractory period and a
+ * search-back for beats missed after 166% of the average RR interval
+ */
+int QRSDetector_processSample(QRSDetector* const self, const struct TimeMarkedData* const tmd) {
+    QRSEngine* const e = &self->engine;
+    const long n = e->n++;
+    const int i = (int)(n & (QRS_DELAY_LINE - 1));
+#define QRS_AT(k) ((int)((n - (k)) & (QRS_DELAY_LINE - 1)))
+    int32_t x = tmd->dataValue;
+    int64_t derivative;
+    int64_t mwi;
+    int beat = 0;
+
+    x = (x > QRS_INPUT_LIMIT) ? QRS_INPUT_LIMIT : (x < -QRS_INPUT_LIMIT) ? -QRS_INPUT_LIMIT : x;
+    e->raw[i] = x;
+    e->times[i] = tmd->timeInterval;
+
+    /* low-pass: y[n] = 2y[n-1] - y[n-2] + x[n] - 2x[n-6] + x[n-12] (delay lines start zeroed) */
+    e->lowPass[i] = 2 * e->lowPass[QRS_AT(1)] - e->lowPass[QRS_AT(2)]
+                  + x - 2 * e->raw[QRS_AT(6)] + e->raw[QRS_AT(12)];
+
+    /* high-pass: all-pass delay of 16 minus the 32-sample running mean */
+    e->lowPassSum += e->lowPass[i] - e->lowPass[QRS_AT(32)];
+    e->highPass[i] = e->lowPass[QRS_AT(16)] - e->lowPassSum / 32;
+
+    /* derivative, squaring and moving-window integration */
+    derivative = (2 * e->highPass[i] + e->highPass[QRS_AT(1)]
+                  - e->highPass[QRS_AT(3)] - 2 * e->highPass[QRS_AT(4)]) / 8;
+    e->squared[i] = derivative * derivative;
+    e->mwiSum += e->squared[i] - e->squared[QRS_AT(QRS_MWI_WINDOW)];
+    mwi = e->mwiSum;
+#undef QRS_AT
+
+    if (n >= QRS_SETTLE_SAMPLES && n < QRS_SETTLE_SAMPLES + QRS_LEARNING_SAMPLES) {
+        /* learning phase: seed the thresholds from the signal itself */
+        e->learnMax = (mwi > e->learnMax) ? mwi : e->learnMax;
+        e->learnSum += mwi;
+        if (n == QRS_SETTLE_SAMPLES + QRS_LEARNING_SAMPLES - 1) {
+            e->signalPeak = e->learnMax / 3;
+            e->noisePeak = e->learnSum / QRS_LEARNING_SAMPLES / 2;
+            e->threshold = e->noisePeak + (e->signalPeak - e->noisePeak) / 4;
+        }
+    } else if (n >= QRS_SETTLE_SAMPLES + QRS_LEARNING_SAMPLES) {
+        if (e->mwiPrev > e->mwiPrev2 && e->mwiPrev >= mwi) {
+            beat = detectPeak(e, e->mwiPrev, n - 1);
+        }
+        if (!beat && e->nRR > 0 && e->candidatePeak > 0 &&
+            (n - e->lastBeatSample) * 100 > (e->rrSum / e->nRR) * 166) {
+            /* search-back: take the best peak above half the threshold */
+            e->signalPeak = (e->candidatePeak + 3 * e->signalPeak) / 4;
+            acceptBeat(e, e->candidateSample, e->candidateTime);
+            beat = 1;
+        }
+    }
+    e->mwiPrev2 = e->mwiPrev;
+    e->mwiPrev = mwi;
+    return beat;
+}
+
+/**
+ * Measure the peak-to-peak amplitude over the last QRS_WINDOW_SAMPLES samples
+ */
+int QRSDetector_measureAmplitude(QRSDetector* const self){
+    int lo;
+    int hi;
+
+    if (self->itsTMDQueue != NULL &&
+        TMDQueue_windowMinMax(self->itsTMDQueue, QRS_WINDOW_SAMPLES, &lo, &hi) > 0) {
+        self->qrsAmplitude = hi - lo;
+    }
+    return self->qrsAmplitude;
 }
 
 /**
  * Compute heart rate based on QRS detection
  */
 void QRSDetector_computeHR(QRSDetector* const self){
-    self->heartRate = self->heartRate + 10;
+    self->heartRate = rollingRate(&self->engine);
     printf("QRSDetector: Heart rate computed: %d BPM\n", self->heartRate);
 }
 
+long QRSDetector_getBeatCount(const QRSDetector* const self){
+    return self->engine.nBeats;
+}
+
+int QRSDetector_getBeatTimes(const QRSDetector* const self, long* const times, int maxCount){
+    const QRSEngine* const e = &self->engine;
+    long kept = (e->nBeats < QRS_BEAT_HISTORY) ? e->nBeats : QRS_BEAT_HISTORY;
+    int count = (maxCount < kept) ? maxCount : (int)kept;
+
+    for (int k = 0; k < count; k++) {
+        times[k] = e->beatTimes[(e->nBeats - count + k) % QRS_BEAT_HISTORY];
+    }
+    return count;
+}
+
 /**
  * Get a data sample from the subject's queue
  */
@@ -79,6 +202,18 @@ void QRSDetector_setItsTMDQueue(QRSDetector* const self, struct TMDQueue* p_TMDQ
     }
 }
 
+/**
+ * Connect to the subject with the batch update method
+ */
+void QRSDetector_setItsTMDQueueBatched(QRSDetector* const self, struct TMDQueue* p_TMDQueue){
+    self->itsTMDQueue = p_TMDQueue;
+    self->batched = 1;
+    if (p_TMDQueue != NULL) {
+        printf("QRSDetector: Subscribing to TMDQueue for batches\n");
+        TMDQueue_subscribeBatch(p_TMDQueue, self, QRSDetector_updateBatch);
+    }
+}
+
 /**
  * Get reference to the subject
  */
@@ -116,3 +251,80 @@ static void cleanUpRelations(QRSDetector* const self) {
         self->itsTMDQueue = NULL;
     }
 }
+
+static void engineInit(QRSEngine* const engine) {
+    memset(engine, 0, sizeof(*engine));
+    engine->lastBeatSample = -1;
+}
+
+/**
+ * Classify an integrator peak as signal or noise and adapt the thresholds
+ */
+static int detectPeak(QRSEngine* const engine, int64_t peak, long peakSample) {
+    if (engine->lastBeatSample >= 0 && peakSample - engine->lastBeatSample < QRS_REFRACTORY) {
+        return 0;
+    }
+    if (peak > engine->threshold) {
+        engine->signalPeak = (peak + 7 * engine->signalPeak) / 8;
+        acceptBeat(engine, peakSample, rSampleTime(engine, peakSample));
+        return 1;
+    }
+    engine->noisePeak = (peak + 7 * engine->noisePeak) / 8;
+    engine->threshold = engine->noisePeak + (engine->signalPeak - engine->noisePeak) / 4;
+    if (peak > engine->threshold / 2 && peak > engine->candidatePeak) {
+        engine->candidatePeak = peak;
+        engine->candidateSample = peakSample;
+        engine->candidateTime = rSampleTime(engine, peakSample);
+    }
+    return 0;
+}
+
+/**
+ * Timestamp of the R peak behind an integrator peak: the largest band-pass
+ * excursion inside the integration window, shifted back by the band-pass
+ * delay. Costs one window scan per peak, not per sample.
+ */
+static long rSampleTime(const QRSEngine* const engine, long peakSample) {
+    long bestSample = peakSample - QRS_DERIVATIVE_DELAY;
+    int64_t best = -1;
+
+    for (long s = bestSample; s > peakSample - QRS_DERIVATIVE_DELAY - QRS_MWI_WINDOW && s >= 0; s--) {
+        int64_t value = engine->highPass[s & (QRS_DELAY_LINE - 1)];
+        value = (value < 0) ? -value : value;
+        if (value > best) {
+            best = value;
+            bestSample = s;
+        }
+    }
+    bestSample -= QRS_BANDPASS_DELAY;
+    return engine->times[(bestSample < 0 ? 0 : bestSample) & (QRS_DELAY_LINE - 1)];
+}
+
+/**
+ * Heart rate in BPM from the average of the recent RR intervals
+ */
+static int rollingRate(const QRSEngine* const engine) {
+    return (engine->nRR > 0) ? (int)(60L * QRS_SAMPLE_RATE_HZ * engine->nRR / engine->rrSum) : 0;
+}
+
+/**
+ * Record a beat at beatSample: RR history, timestamp, fresh search-back state
+ */
+static void acceptBeat(QRSEngine* const engine, long beatSample, long beatTime) {
+    if (engine->lastBeatSample >= 0) {
+        long rr = beatSample - engine->lastBeatSample;
+        if (engine->nRR == QRS_RR_HISTORY) {
+            engine->rrSum -= engine->rr[engine->rrNext];
+        } else {
+            engine->nRR++;
+        }
+        engine->rr[engine->rrNext] = rr;
+        engine->rrSum += rr;
+        engine->rrNext = (engine->rrNext + 1) % QRS_RR_HISTORY;
+    }
+    engine->beatTimes[engine->nBeats % QRS_BEAT_HISTORY] = beatTime;
+    engine->nBeats++;
+    engine->lastBeatSample = beatSample;
+    engine->threshold = engine->noisePeak + (engine->signalPeak - engine->noisePeak) / 4;
+    engine->candidatePeak = 0;
+}
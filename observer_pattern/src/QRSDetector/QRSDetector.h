@@ -5,6 +5,7 @@
 #ifndef CLIENT_SERVER_PATTERN_QRSDETECTOR_H
 #define CLIENT_SERVER_PATTERN_QRSDETECTOR_H
 
+#include <stdint.h>
 #include "ECGPkg.h"
 #include "TMDQueue.h"
 
@@ -16,10 +17,69 @@
  * See: https://en.wikipedia.org/wiki/QRS_complex
  */
 
+/* Samples scanned for the QRS peak-to-peak amplitude on every update */
+#define QRS_WINDOW_SAMPLES (40)
+
+/**
+ * Pan-Tompkins detection engine settings
+ *
+ * The integer filters are the classic ones designed for 200 Hz sampling,
+ * so all durations below are in samples at that rate. Inputs are treated
+ * as signed ADC counts and clamped to +/-QRS_INPUT_LIMIT so the squared
+ * slope cannot overflow.
+ */
+#define QRS_SAMPLE_RATE_HZ (200)
+#define QRS_INPUT_LIMIT (32767)
+#define QRS_DELAY_LINE (64)          // Ring length for every filter stage (power of two)
+#define QRS_MWI_WINDOW (30)          // Moving-window integration, 150 ms
+#define QRS_BANDPASS_DELAY (21)      // Band-pass output lags the input by 5 + 16 samples
+#define QRS_DERIVATIVE_DELAY (2)
+#define QRS_REFRACTORY (40)          // No second beat within 200 ms
+#define QRS_SETTLE_SAMPLES (QRS_DELAY_LINE) // Filter start-up ignored by the learning phase
+#define QRS_LEARNING_SAMPLES (400)   // 2 s used to seed the thresholds
+#define QRS_RR_HISTORY (8)           // RR intervals averaged for the heart rate
+#define QRS_BEAT_HISTORY (16)        // Most recent beat timestamps kept
+
+/**
+ * Fixed-size state of the streaming detector: one delay line per filter
+ * stage, the integrator and the adaptive thresholds. Every sample costs a
+ * constant amount of work and nothing is allocated.
+ */
+typedef struct QRSEngine {
+    long n;                                // Samples processed so far
+    int64_t lowPass[QRS_DELAY_LINE];       // Band-pass stage 1 output (gain 36)
+    int64_t highPass[QRS_DELAY_LINE];      // Band-pass stage 2 output
+    int64_t squared[QRS_DELAY_LINE];       // Squared derivative
+    int32_t raw[QRS_DELAY_LINE];           // Clamped input
+    long times[QRS_DELAY_LINE];            // Input timestamps, to date the beats
+    int64_t lowPassSum;                    // Running sum inside the high-pass stage
+    int64_t mwiSum;                        // Moving-window integral
+    int64_t mwiPrev;                       // Integral one and two samples back,
+    int64_t mwiPrev2;                      // for local maximum detection
+    int64_t signalPeak;                    // SPKI: running estimate of QRS peaks
+    int64_t noisePeak;                     // NPKI: running estimate of noise peaks
+    int64_t threshold;                     // THRESHOLD I1
+    int64_t learnMax;
+    int64_t learnSum;
+    int64_t candidatePeak;                 // Largest sub-threshold peak since the last beat
+    long candidateSample;
+    long candidateTime;
+    long lastBeatSample;                   // -1 before the first beat
+    long rr[QRS_RR_HISTORY];               // Recent RR intervals in samples
+    int nRR;
+    int rrNext;
+    long rrSum;
+    long beatTimes[QRS_BEAT_HISTORY];      // Ring of beat timestamps
+    long nBeats;                           // Beats detected so far
+} QRSEngine;
+
 typedef struct QRSDetector QRSDetector;
 struct QRSDetector
 {
     int heartRate;               // Computed heart rate 
+    int qrsAmplitude;            // Peak-to-peak amplitude over the last QRS window
+    boolean batched;             // Subscribed with QRSDetector_updateBatch
+    QRSEngine engine;            // Streaming QRS detection state
     int index;                   // Current position in the queue
     struct TMDQueue* itsTMDQueue; // Reference to the subject
 };
@@ -42,10 +102,36 @@ void QRSDetector_Cleanup(QRSDetector* const self);
 void QRSDetector_update(void* instance, const struct TimeMarkedData tmd);
 
 /**
- * Compute heart rate based on QRS detection
+ * Observer Pattern: batch UPDATE method
+ *
+ * Runs the detector over a whole batch without printing per sample
+ */
+void QRSDetector_updateBatch(void* instance, const struct TimeMarkedData* samples, int count);
+
+/**
+ * Feed one sample to the detection engine
+ *
+ * Returns 1 when the sample confirms a new beat, 0 otherwise
+ */
+int QRSDetector_processSample(QRSDetector* const self, const struct TimeMarkedData* const tmd);
+
+/**
+ * Compute heart rate from the average of the recent RR intervals
  */
 void QRSDetector_computeHR(QRSDetector* const self);
 
+/**
+ * Detection results: beats so far, and up to maxCount of the most recent
+ * beat timestamps, oldest first (returns how many were copied)
+ */
+long QRSDetector_getBeatCount(const QRSDetector* const self);
+int QRSDetector_getBeatTimes(const QRSDetector* const self, long* const times, int maxCount);
+
+/**
+ * Measure the peak-to-peak amplitude over the last QRS_WINDOW_SAMPLES samples
+ */
+int QRSDetector_measureAmplitude(QRSDetector* const self);
+
 /**
  * Get a data sample from the subject's queue
  */
@@ -60,6 +146,11 @@ void QRSDetector_getDataSample(QRSDetector* const self);
  */
 void QRSDetector_setItsTMDQueue(QRSDetector* const self, struct TMDQueue* p_TMDQueue);
 
+/**
+ * Like QRSDetector_setItsTMDQueue, but subscribes the batch update method
+ */
+void QRSDetector_setItsTMDQueueBatched(QRSDetector* const self, struct TMDQueue* p_TMDQueue);
+
 /**
  * Get reference to the subject
  */
@@ -2,11 +2,25 @@
 // Created by mahon on 12/27/2023.
 //
 
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include "TMDQueue.h"
 #include "NotificationHandle.h"
 
+/*
+ * Per-sample and per-delivery tracing is compiled in only when
+ * TMDQUEUE_TRACE is defined (see the ENABLE_TMDQUEUE_TRACE CMake option).
+ * With tracing off, inserting and notifying do no stdio work at all.
+ */
+#ifdef TMDQUEUE_TRACE
+#define TMDQUEUE_TRACE_PRINT(...) printf(__VA_ARGS__)
+#else
+#define TMDQUEUE_TRACE_PRINT(...) ((void)0)
+#endif
+
 /**
  * Observer Pattern: Subject Implementation
  * 
@@ -16,6 +30,14 @@
 
 static void initRelations(TMDQueue* const me);
 static void cleanUpRelations(TMDQueue* const me);
+static struct NotificationHandle* appendHandle(TMDQueue* const me);
+static int removeHandle(TMDQueue* const me, const UpdateFuncPtr updateFuncAddr,
+                        const BatchUpdateFuncPtr batchUpdateFuncAddr);
+static void deliverPending(TMDQueue* const me);
+static int64_t nowMicros(void);
+static int windowRuns(const TMDQueue* const me, int count, int* const start, int* const firstLength);
+static void scanMinMax(const TMDQueue* const me, int start, int length, int* const lo, int* const hi);
+static int64_t scanSum(const TMDQueue* const me, int start, int length);
 
 /**
  * Initialize the subject
@@ -24,6 +46,10 @@ void TMDQueue_Init(TMDQueue* const me) {
     me->head = 0;
     me->nSubscribers = 0;
     me->size = 0;
+    me->batchSize = 1;
+    me->batchMicros = 0;
+    me->nPending = 0;
+    me->pendingSinceMicros = 0;
     me->itsNotificationHandle = NULL;
     initRelations(me);
 }
@@ -47,12 +73,31 @@ void TMDQueue_insert(TMDQueue* const me, const struct TimeMarkedData tmd) {
     leaky queue, size only increases to the queue size and
     then stops increasing. Inserion always takes place at the head.
     */
-    printf("Inderting at: %d    Data #: %ld", me->head, tmd.timeInterval);
+    TMDQUEUE_TRACE_PRINT("Inderting at: %d    Data #: %ld", me->head, tmd.timeInterval);
+#ifdef TMDQUEUE_SOA
+    me->values[me->head] = (int32_t)tmd.dataValue;
+    me->times[me->head] = (int64_t)tmd.timeInterval;
+#else
     me->buffer[me->head] = tmd;
+#endif
     me->head = TMDQueue_getNextIndex(me, me->head);
     if (me->size < QUEUE_SIZE) ++me->size;
-    printf("  Storing data value: %d\n", tmd.dataValue);
-    TMDQueue_notify(me, tmd);
+    TMDQUEUE_TRACE_PRINT("  Storing data value: %d\n", tmd.dataValue);
+    if (me->batchSize <= 1 && me->batchMicros <= 0) {
+        TMDQueue_notify(me, tmd);
+        return;
+    }
+
+    /* batched: hold the sample back until the policy says to deliver */
+    if (me->nPending == 0 && me->batchMicros > 0) {
+        me->pendingSinceMicros = nowMicros();
+    }
+    me->pending[me->nPending++] = tmd;
+    if (me->nPending >= me->batchSize) {
+        TMDQueue_flush(me);
+    } else {
+        TMDQueue_flushIfDue(me);
+    }
 }
 
 boolean TMDQueue_isEmpty(TMDQueue* const me) {
@@ -71,12 +116,45 @@ void TMDQueue_notify(TMDQueue* const me, const struct TimeMarkedData tmd) {
     // Traverse the list of observers and notify each one
     while (current != NULL) {
         // Call the observer's update method
-        printf("Notifying observer with data value: %d\n", tmd.dataValue);
-        current->updateAddr(current->observerInstance, tmd);
+        TMDQUEUE_TRACE_PRINT("Notifying observer with data value: %d\n", tmd.dataValue);
+        if (current->batchUpdateAddr != NULL) {
+            current->batchUpdateAddr(current->observerInstance, &tmd, 1);
+        } else {
+            current->updateAddr(current->observerInstance, tmd);
+        }
         current = current->itsNotificationHandle;
     }
 }
 
+void TMDQueue_setBatchPolicy(TMDQueue* const me, int batchSize, long batchMicros) {
+    TMDQueue_flush(me);
+    if (batchSize < 1) {
+        batchSize = 1;
+    }
+    me->batchSize = (batchSize < TMDQUEUE_MAX_BATCH) ? batchSize : TMDQUEUE_MAX_BATCH;
+    me->batchMicros = (batchMicros > 0) ? batchMicros : 0;
+}
+
+/**
+ * Deliver every pending sample now
+ */
+void TMDQueue_flush(TMDQueue* const me) {
+    if (me->nPending > 0) {
+        deliverPending(me);
+    }
+}
+
+/**
+ * Deliver the pending samples if the oldest has waited batchMicros;
+ * call it periodically when the producer may go quiet
+ */
+void TMDQueue_flushIfDue(TMDQueue* const me) {
+    if (me->nPending > 0 && me->batchMicros > 0 &&
+        nowMicros() - me->pendingSinceMicros >= me->batchMicros) {
+        deliverPending(me);
+    }
+}
+
 struct TimeMarkedData TMDQueue_remove(TMDQueue* const me, int index) {
      TimeMarkedData tmd;
      tmd.timeInterval=-1; /* sentinel values */
@@ -86,11 +164,52 @@ struct TimeMarkedData TMDQueue_remove(TMDQueue* const me, int index) {
         (index>=0) &&
         (index < QUEUE_SIZE)
         && (index < me->size)) {
+#ifdef TMDQUEUE_SOA
+        tmd.dataValue = (int)me->values[index];
+        tmd.timeInterval = (long)me->times[index];
+#else
         tmd = me->buffer[index];
+#endif
     }
+#ifdef TMDQUEUE_SOA
+    tmd.itsTMDQueue = me;
+#endif
     return tmd;
 }
 
+int TMDQueue_windowMinMax(const TMDQueue* const me, int count, int* const minValue, int* const maxValue) {
+    int start;
+    int firstLength;
+    int n = windowRuns(me, count, &start, &firstLength);
+    int lo = INT32_MAX;
+    int hi = INT32_MIN;
+
+    if (n == 0) {
+        return 0;
+    }
+    scanMinMax(me, start, firstLength, &lo, &hi);
+    scanMinMax(me, 0, n - firstLength, &lo, &hi);
+    *minValue = lo;
+    *maxValue = hi;
+    return n;
+}
+
+int TMDQueue_windowSum(const TMDQueue* const me, int count, int64_t* const sum) {
+    int start;
+    int firstLength;
+    int n = windowRuns(me, count, &start, &firstLength);
+
+    if (n == 0) {
+        return 0;
+    }
+    *sum = scanSum(me, start, firstLength) + scanSum(me, 0, n - firstLength);
+    return n;
+}
+
+size_t TMDQueue_footprint(void) {
+    return sizeof(TMDQueue);
+}
+
 /**
  * Observer Pattern: SUBSCRIBE method
  * 
@@ -98,22 +217,7 @@ struct TimeMarkedData TMDQueue_remove(TMDQueue* const me, int index) {
  * when the subject's state changes.
  */
 void TMDQueue_subscribe(TMDQueue* const me, void* observerInstance, const UpdateFuncPtr updateFuncAddr) {
-    struct NotificationHandle *pNH = me->itsNotificationHandle;
-
-    if (pNH == NULL) {
-        // Empty list - create first observer node
-        me->itsNotificationHandle = NotificationHandle_Create();
-        pNH = me->itsNotificationHandle;
-    } else {
-        // Find end of observer list
-        while (pNH->itsNotificationHandle != NULL) {
-            pNH = pNH->itsNotificationHandle;
-        }
-
-        // Add new observer at the end
-        pNH->itsNotificationHandle = NotificationHandle_Create();
-        pNH = pNH->itsNotificationHandle;
-    }
+    struct NotificationHandle *pNH = appendHandle(me);
 
     // Store the update function, observer instance, and increment subscriber count
     pNH->updateAddr = updateFuncAddr;
@@ -122,6 +226,18 @@ void TMDQueue_subscribe(TMDQueue* const me, void* observerInstance, const Update
     printf("Added new observer - total subscribers: %d\n", me->nSubscribers);
 }
 
+/**
+ * Register an observer that takes whole batches of samples
+ */
+void TMDQueue_subscribeBatch(TMDQueue* const me, void* observerInstance, const BatchUpdateFuncPtr batchUpdateFuncAddr) {
+    struct NotificationHandle *pNH = appendHandle(me);
+
+    pNH->batchUpdateAddr = batchUpdateFuncAddr;
+    pNH->observerInstance = observerInstance;
+    ++me->nSubscribers;
+    printf("Added new batch observer - total subscribers: %d\n", me->nSubscribers);
+}
+
 /**
  * Observer Pattern: UNSUBSCRIBE method
  * 
@@ -133,43 +249,17 @@ int TMDQueue_unsubscribe(TMDQueue* const me, const UpdateFuncPtr updateFuncAddr)
     if (!me || !updateFuncAddr) {
         return 0;
     }
+    return removeHandle(me, updateFuncAddr, NULL);
+}
 
-    struct NotificationHandle *current = me->itsNotificationHandle;
-    struct NotificationHandle *previous = NULL;
-
-    // If no observers, return 0
-    if (current == NULL) {
+/**
+ * Remove a batch observer from the notification list
+ */
+int TMDQueue_unsubscribeBatch(TMDQueue* const me, const BatchUpdateFuncPtr batchUpdateFuncAddr) {
+    if (!me || !batchUpdateFuncAddr) {
         return 0;
     }
-
-    // If first observer matches, remove it
-    if (current->updateAddr == updateFuncAddr) {
-        me->itsNotificationHandle = current->itsNotificationHandle;
-        NotificationHandle_Destroy(current);
-        --me->nSubscribers;
-        printf("Removed observer (first in list) - remaining subscribers: %d\n", me->nSubscribers);
-        return 1;
-    }
-
-    // Search for the observer in the list
-    while (current != NULL) {
-        if (current->updateAddr == updateFuncAddr) {
-            // Found the observer - remove it
-            previous->itsNotificationHandle = current->itsNotificationHandle;
-            NotificationHandle_Destroy(current);
-            --me->nSubscribers;
-            printf("Removed observer - remaining subscribers: %d\n", me->nSubscribers);
-            return 1;
-        }
-
-        // Move to next observer
-        previous = current;
-        current = current->itsNotificationHandle;
-    }
-
-    // If the target element was not found in the list, return 0
-    printf(">>>>>> Didn't remove any subscribers\n");
-    return 0;
+    return removeHandle(me, NULL, batchUpdateFuncAddr);
 }
 
 int TMDQueue_getBuffer(const TMDQueue* const me) {
@@ -202,7 +292,79 @@ void TMDQueue_Destroy(TMDQueue* const me) {
     free(me);
 }
 
+/**
+ * Locate the last count samples: they start at *start and run for
+ * *firstLength slots to the end of the buffer; the rest wrap to index 0.
+ * Returns the clamped window length.
+ */
+static int windowRuns(const TMDQueue* const me, int count, int* const start, int* const firstLength) {
+    int n = (count < me->size) ? count : me->size;
+
+    if (n <= 0) {
+        *start = 0;
+        *firstLength = 0;
+        return 0;
+    }
+    *start = (me->head - n + QUEUE_SIZE) % QUEUE_SIZE;
+    *firstLength = (n < QUEUE_SIZE - *start) ? n : QUEUE_SIZE - *start;
+    return n;
+}
+
+#ifdef TMDQUEUE_SOA
+static void scanMinMax(const TMDQueue* const me, int start, int length, int* const lo, int* const hi) {
+    const int32_t* values = me->values + start;
+    int32_t low = *lo;
+    int32_t high = *hi;
+
+    for (int i = 0; i < length; i++) {
+        low = (values[i] < low) ? values[i] : low;
+        high = (values[i] > high) ? values[i] : high;
+    }
+    *lo = low;
+    *hi = high;
+}
+
+static int64_t scanSum(const TMDQueue* const me, int start, int length) {
+    const int32_t* values = me->values + start;
+    int64_t sum = 0;
+
+    for (int i = 0; i < length; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+#else
+static void scanMinMax(const TMDQueue* const me, int start, int length, int* const lo, int* const hi) {
+    const struct TimeMarkedData* samples = me->buffer + start;
+    int low = *lo;
+    int high = *hi;
+
+    for (int i = 0; i < length; i++) {
+        low = (samples[i].dataValue < low) ? samples[i].dataValue : low;
+        high = (samples[i].dataValue > high) ? samples[i].dataValue : high;
+    }
+    *lo = low;
+    *hi = high;
+}
+
+static int64_t scanSum(const TMDQueue* const me, int start, int length) {
+    const struct TimeMarkedData* samples = me->buffer + start;
+    int64_t sum = 0;
+
+    for (int i = 0; i < length; i++) {
+        sum += samples[i].dataValue;
+    }
+    return sum;
+}
+
+#endif
+
 static void initRelations(TMDQueue* const me) {
+#ifdef TMDQUEUE_SOA
+    /* the columns need no per-slot setup: only written slots are ever read */
+    (void)me;
+#else
     {
         int iter = 0;
         while (iter < QUEUE_SIZE){
@@ -211,9 +373,11 @@ static void initRelations(TMDQueue* const me) {
             iter++;
         }
     }
+#endif
 }
 
 static void cleanUpRelations(TMDQueue* const me) {
+#ifndef TMDQUEUE_SOA
     {
         int iter = 0;
         while (iter < QUEUE_SIZE){
@@ -221,8 +385,103 @@ static void cleanUpRelations(TMDQueue* const me) {
             iter++;
         }
     }
+#endif
     if(me->itsNotificationHandle != NULL)
     {
         me->itsNotificationHandle = NULL;
     }
 }
+
+/**
+ * Unlink and destroy the first handle registered with either update method
+ * (the other one is NULL)
+ */
+static int removeHandle(TMDQueue* const me, const UpdateFuncPtr updateFuncAddr,
+                        const BatchUpdateFuncPtr batchUpdateFuncAddr) {
+    struct NotificationHandle *current = me->itsNotificationHandle;
+    struct NotificationHandle *previous = NULL;
+
+    // If no observers, return 0
+    if (current == NULL) {
+        return 0;
+    }
+
+    // If first observer matches, remove it
+    if (current->updateAddr == updateFuncAddr && current->batchUpdateAddr == batchUpdateFuncAddr) {
+        me->itsNotificationHandle = current->itsNotificationHandle;
+        NotificationHandle_Destroy(current);
+        --me->nSubscribers;
+        printf("Removed observer (first in list) - remaining subscribers: %d\n", me->nSubscribers);
+        return 1;
+    }
+
+    // Search for the observer in the list
+    while (current != NULL) {
+        if (current->updateAddr == updateFuncAddr && current->batchUpdateAddr == batchUpdateFuncAddr) {
+            // Found the observer - remove it
+            previous->itsNotificationHandle = current->itsNotificationHandle;
+            NotificationHandle_Destroy(current);
+            --me->nSubscribers;
+            printf("Removed observer - remaining subscribers: %d\n", me->nSubscribers);
+            return 1;
+        }
+
+        // Move to next observer
+        previous = current;
+        current = current->itsNotificationHandle;
+    }
+
+    // If the target element was not found in the list, return 0
+    printf(">>>>>> Didn't remove any subscribers\n");
+    return 0;
+}
+
+/**
+ * Find the end of the observer list and append a fresh handle there
+ */
+static struct NotificationHandle* appendHandle(TMDQueue* const me) {
+    struct NotificationHandle *pNH = me->itsNotificationHandle;
+
+    if (pNH == NULL) {
+        // Empty list - create first observer node
+        me->itsNotificationHandle = NotificationHandle_Create();
+        return me->itsNotificationHandle;
+    }
+
+    // Find end of observer list
+    while (pNH->itsNotificationHandle != NULL) {
+        pNH = pNH->itsNotificationHandle;
+    }
+
+    // Add new observer at the end
+    pNH->itsNotificationHandle = NotificationHandle_Create();
+    return pNH->itsNotificationHandle;
+}
+
+/**
+ * Hand the pending batch to every observer: one call per batch observer,
+ * one call per sample for the others
+ */
+static void deliverPending(TMDQueue* const me) {
+    struct NotificationHandle *current = me->itsNotificationHandle;
+    int count = me->nPending;
+
+    me->nPending = 0;
+    while (current != NULL) {
+        TMDQUEUE_TRACE_PRINT("Notifying observer with %d samples\n", count);
+        if (current->batchUpdateAddr != NULL) {
+            current->batchUpdateAddr(current->observerInstance, me->pending, count);
+        } else {
+            for (int i = 0; i < count; i++) {
+                current->updateAddr(current->observerInstance, me->pending[i]);
+            }
+        }
+        current = current->itsNotificationHandle;
+    }
+}
+
+static int64_t nowMicros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -5,12 +5,16 @@
 #ifndef CLIENT_SERVER_PATTERN_TMDQUEUE_H
 #define CLIENT_SERVER_PATTERN_TMDQUEUE_H
 
+#include <stdint.h>
 #include "ECGPkg.h"
 #include "TimeMarkedData.h"
 #include "NotificationHandle.h" // Include NotificationHandle.h which has the UpdateFuncPtr definition
 
 typedef struct TMDQueue TMDQueue;
 
+/* Most samples a batched notification can hold back */
+#define TMDQUEUE_MAX_BATCH (256)
+
 /**
  * Observer Pattern: SUBJECT class
  * 
@@ -18,13 +22,41 @@ typedef struct TMDQueue TMDQueue;
  * It maintains a list of observers (NotificationHandles) and notifies 
  * them when new data is added to the queue.
  */
+#ifdef TMDQUEUE_SOA
+/**
+ * Struct-of-arrays storage (build with ENABLE_SOA_QUEUE)
+ *
+ * Values and timestamps live in separate contiguous columns and the
+ * samples carry no back-pointer, so a scan over the signal touches
+ * nothing but signal and compiles to a plain vectorizable loop.
+ */
+struct TMDQueue {
+    int head;                                   // Current position in circular buffer
+    int nSubscribers;                           // Number of observers
+    int size;                                   // Current size of data in the buffer
+    int32_t values[QUEUE_SIZE];                 // ECG values, column by column
+    int64_t times[QUEUE_SIZE];                  // Timestamps, same index as values
+    int batchSize;                              // Deliver once this many samples are pending
+    long batchMicros;                           // ...or once the oldest is this old (0 = no limit)
+    int nPending;                               // Samples inserted but not yet delivered
+    int64_t pendingSinceMicros;                 // Insertion time of the oldest pending sample
+    struct TimeMarkedData pending[TMDQUEUE_MAX_BATCH]; // Samples waiting for delivery
+    struct NotificationHandle* itsNotificationHandle; // Linked list of observers
+};
+#else
 struct TMDQueue {
     int head;                                   // Current position in circular buffer
     int nSubscribers;                           // Number of observers
     int size;                                   // Current size of data in the buffer
     struct TimeMarkedData buffer[QUEUE_SIZE];   // Circular buffer of data
+    int batchSize;                              // Deliver once this many samples are pending
+    long batchMicros;                           // ...or once the oldest is this old (0 = no limit)
+    int nPending;                               // Samples inserted but not yet delivered
+    int64_t pendingSinceMicros;                 // Insertion time of the oldest pending sample
+    struct TimeMarkedData pending[TMDQUEUE_MAX_BATCH]; // Samples waiting for delivery
     struct NotificationHandle* itsNotificationHandle; // Linked list of observers
 };
+#endif
 
 /* Constructors and destructors:*/
 void TMDQueue_Init(TMDQueue* const me);
@@ -36,6 +68,21 @@ void TMDQueue_insert(TMDQueue* const me, const struct TimeMarkedData tmd);
 boolean TMDQueue_isEmpty(TMDQueue* const me);
 struct TimeMarkedData TMDQueue_remove(TMDQueue* const me, int index);
 
+/**
+ * Window scans over the most recent samples
+ *
+ * The window covers the last count samples (clamped to the queue size).
+ * Both return the number of samples scanned and leave the outputs alone
+ * when that is 0. They walk the value column in at
+ * most two contiguous runs, so in SoA mode each run is a straight loop
+ * over int32_t.
+ */
+int TMDQueue_windowMinMax(const TMDQueue* const me, int count, int* const minValue, int* const maxValue);
+int TMDQueue_windowSum(const TMDQueue* const me, int count, int64_t* const sum);
+
+/* Storage footprint of one queue in bytes, for comparing the two layouts */
+size_t TMDQueue_footprint(void);
+
 /**
  * Observer Pattern: Core Subject Methods
  * 
@@ -48,6 +95,24 @@ void TMDQueue_notify(TMDQueue* const me, const struct TimeMarkedData tmd);
 void TMDQueue_subscribe(TMDQueue* const me, void* observerInstance, const UpdateFuncPtr updateFuncAddr);
 int TMDQueue_unsubscribe(TMDQueue* const me, const UpdateFuncPtr updateFuncAddr);
 
+/**
+ * Observer Pattern: Batched notification
+ *
+ * By default every insert notifies every observer straight away. With a
+ * batch policy, inserts only append to a pending batch, which is delivered
+ * once batchSize samples are pending (clamped to TMDQUEUE_MAX_BATCH), once
+ * the oldest pending sample is batchMicros old (checked on insert and by
+ * TMDQueue_flushIfDue; 0 disables the age limit), or on TMDQueue_flush.
+ * Batch observers get the whole batch in one call; per-sample observers
+ * still get one update per sample, just later. batchSize 1 with no age
+ * limit restores immediate delivery. Changing the policy flushes first.
+ */
+void TMDQueue_setBatchPolicy(TMDQueue* const me, int batchSize, long batchMicros);
+void TMDQueue_flush(TMDQueue* const me);
+void TMDQueue_flushIfDue(TMDQueue* const me);
+void TMDQueue_subscribeBatch(TMDQueue* const me, void* observerInstance, const BatchUpdateFuncPtr batchUpdateFuncAddr);
+int TMDQueue_unsubscribeBatch(TMDQueue* const me, const BatchUpdateFuncPtr batchUpdateFuncAddr);
+
 /* Accessor methods */
 int TMDQueue_getBuffer(const TMDQueue* const me);
 struct NotificationHandle* TMDQueue_getItsNotificationHandle(const TMDQueue* const me);
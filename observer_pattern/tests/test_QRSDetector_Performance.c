@@ -0,0 +1,181 @@
+//
+// Accuracy and throughput benchmark for the QRSDetector engine
+//
+// Runs the streaming Pan-Tompkins detector over a synthetic 200 Hz ECG
+// with known R-peak positions, checks the beats and heart rate it finds,
+// then reports samples per second on one core and how many 200 Hz channels
+// that would keep up with.
+//
+// Categories:
+// - Detection accuracy on synthetic ECG (beats, timing, heart rate)
+// - Per-sample throughput (QRSDetector_processSample)
+// - Batch throughput (QRSDetector_updateBatch)
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <stdio.h>
+#include <time.h>
+#include "unity.h"
+#include "QRSDetector.h"
+
+#define SIGNAL_SECONDS 60
+#define SIGNAL_SAMPLES (SIGNAL_SECONDS * QRS_SAMPLE_RATE_HZ)
+#define MAX_BEATS 256
+#define THROUGHPUT_SAMPLES 20000000L
+#define BATCH_SIZE 64
+
+static struct TimeMarkedData signal[SIGNAL_SAMPLES];
+static long rPeaks[MAX_BEATS];
+static int nPeaks;
+static QRSDetector detector;
+
+void setUp(void) {
+    QRSDetector_Init(&detector);
+}
+
+void tearDown(void) {
+    QRSDetector_Cleanup(&detector);
+}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Triangle pulse of the given height and half-width centred on 0
+ */
+static int pulse(long offset, int height, int halfWidth) {
+    long distance = offset < 0 ? -offset : offset;
+    return distance >= halfWidth ? 0 : (int)(height * (halfWidth - distance) / halfWidth);
+}
+
+/**
+ * @brief Synthetic ECG: P, QRS and T waves around each R peak, RR varying
+ * between 150 and 180 samples (67-80 BPM), baseline wander and noise
+ */
+static void buildSignal(void) {
+    unsigned int noiseState = 12345u;
+    long r = 120;
+    int beat = 0;
+
+    nPeaks = 0;
+    while (r < SIGNAL_SAMPLES && nPeaks < MAX_BEATS) {
+        rPeaks[nPeaks++] = r;
+        r += 150 + (beat * 7) % 31;
+        beat++;
+    }
+    for (long n = 0; n < SIGNAL_SAMPLES; n++) {
+        int value = 0;
+        for (int k = 0; k < nPeaks; k++) {
+            long d = n - rPeaks[k];
+            if (d < -60 || d > 100) {
+                continue;
+            }
+            value += pulse(d + 36, 120, 12);   // P wave
+            value += pulse(d + 5, -150, 3);    // Q
+            value += pulse(d, 1200, 5);        // R
+            value += pulse(d - 5, -300, 3);    // S
+            value += pulse(d - 60, 300, 25);   // T wave
+        }
+        value += pulse((n % 700) - 350, 400, 350) - 200; // Baseline wander
+        noiseState = noiseState * 1103515245u + 12345u;
+        value += (int)((noiseState >> 16) % 61) - 30;     // +/-30 counts of noise
+        signal[n].timeInterval = n;
+        signal[n].dataValue = value;
+        signal[n].itsTMDQueue = NULL;
+    }
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void test_Accuracy_SyntheticEcg(void) {
+    long beats[QRS_BEAT_HISTORY];
+    long matched = 0;
+    long firstDetectable = QRS_SETTLE_SAMPLES + QRS_LEARNING_SAMPLES;
+    int expected = 0;
+    long rrSum = 0;
+
+    buildSignal();
+    for (long n = 0; n < SIGNAL_SAMPLES; n++) {
+        QRSDetector_processSample(&detector, &signal[n]);
+    }
+    for (int k = 0; k < nPeaks; k++) {
+        expected += rPeaks[k] >= firstDetectable;
+    }
+    for (int k = nPeaks - QRS_RR_HISTORY; k < nPeaks; k++) {
+        rrSum += rPeaks[k] - rPeaks[k - 1];
+    }
+
+    // The most recent beats must line up with real R peaks
+    int kept = QRSDetector_getBeatTimes(&detector, beats, QRS_BEAT_HISTORY);
+    for (int b = 0; b < kept; b++) {
+        for (int k = 0; k < nPeaks; k++) {
+            long error = beats[b] - rPeaks[k];
+            matched += error >= -6 && error <= 6;
+        }
+    }
+    QRSDetector_computeHR(&detector);
+    int trueRate = (int)(60L * QRS_SAMPLE_RATE_HZ * QRS_RR_HISTORY / rrSum);
+
+    printf("beats: %ld detected / %d expected, %ld of the last %d within 30 ms, %d BPM (true %d)\n",
+           QRSDetector_getBeatCount(&detector), expected, matched, kept, detector.heartRate, trueRate);
+    TEST_ASSERT_INT_WITHIN(1, expected, QRSDetector_getBeatCount(&detector));
+    TEST_ASSERT_EQUAL_INT(kept, matched);
+    TEST_ASSERT_INT_WITHIN(2, trueRate, detector.heartRate);
+}
+
+void test_Performance_PerSample(void) {
+    buildSignal();
+    double start = nowNanos();
+    for (long n = 0; n < THROUGHPUT_SAMPLES; n++) {
+        QRSDetector_processSample(&detector, &signal[n % SIGNAL_SAMPLES]);
+    }
+    double elapsed = nowNanos() - start;
+    double rate = THROUGHPUT_SAMPLES / elapsed * 1e9;
+
+    printf("processSample: %.1f Msamples/s per core (%.1f ns/sample, ~%.0f channels at %d Hz)\n",
+           rate / 1e6, elapsed / THROUGHPUT_SAMPLES, rate / QRS_SAMPLE_RATE_HZ, QRS_SAMPLE_RATE_HZ);
+    TEST_ASSERT_TRUE(QRSDetector_getBeatCount(&detector) > 0);
+}
+
+void test_Performance_Batch(void) {
+    buildSignal();
+    double start = nowNanos();
+    for (long n = 0; n < THROUGHPUT_SAMPLES; n += BATCH_SIZE) {
+        long offset = n % (SIGNAL_SAMPLES - SIGNAL_SAMPLES % BATCH_SIZE);
+        QRSDetector_updateBatch(&detector, &signal[offset], BATCH_SIZE);
+    }
+    double elapsed = nowNanos() - start;
+    double rate = THROUGHPUT_SAMPLES / elapsed * 1e9;
+
+    printf("updateBatch:   %.1f Msamples/s per core (%.1f ns/sample, batches of %d)\n",
+           rate / 1e6, elapsed / THROUGHPUT_SAMPLES, BATCH_SIZE);
+    TEST_ASSERT_TRUE(detector.heartRate > 0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== QRSDetector Benchmark ===\n");
+    RUN_TEST(test_Accuracy_SyntheticEcg);
+    RUN_TEST(test_Performance_PerSample);
+    RUN_TEST(test_Performance_Batch);
+
+    return UNITY_END();
+}
@@ -0,0 +1,187 @@
+//
+// Observer notification benchmark for TMDQueue
+//
+// Times the producer side of TMDQueue_insert with several observers
+// subscribed, once with immediate per-sample notification and once per
+// batch size, and checks every observer saw every sample in order.
+// stdout is sent to /dev/null while timing so that a build with
+// ENABLE_TMDQUEUE_TRACE does not time the console instead of the queue.
+//
+// Categories:
+// - Per-sample notification (default policy)
+// - Batched notification to batch observers
+// - Batched notification to per-sample observers
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime, fileno
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "unity.h"
+#include "TMDQueue.h"
+
+#define SAMPLE_COUNT 200000
+#define OBSERVER_COUNT 4
+
+/* Observer that checks ordering and sums what it sees, like a cheap display */
+typedef struct {
+    long samples;
+    long lastTime;
+    long outOfOrder;
+    long sum;
+} Observer;
+
+static TMDQueue* queue;
+static Observer observers[OBSERVER_COUNT];
+static int savedStdout;
+
+void setUp(void) {
+    queue = TMDQueue_Create();
+    TEST_ASSERT_NOT_NULL(queue);
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        observers[i] = (Observer){0, -1, 0, 0};
+    }
+}
+
+void tearDown(void) {
+    TMDQueue_Destroy(queue);
+}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void silenceStdout(void) {
+    int devNull = open("/dev/null", O_WRONLY);
+    fflush(stdout);
+    savedStdout = dup(fileno(stdout));
+    dup2(devNull, fileno(stdout));
+    close(devNull);
+}
+
+static void restoreStdout(void) {
+    fflush(stdout);
+    dup2(savedStdout, fileno(stdout));
+    close(savedStdout);
+}
+
+static void observeSample(Observer* observer, const struct TimeMarkedData* tmd) {
+    observer->outOfOrder += tmd->timeInterval != observer->lastTime + 1;
+    observer->lastTime = tmd->timeInterval;
+    observer->sum += tmd->dataValue;
+    observer->samples++;
+}
+
+static void sampleUpdate(void* instance, const struct TimeMarkedData tmd) {
+    observeSample((Observer*)instance, &tmd);
+}
+
+static void batchUpdate(void* instance, const struct TimeMarkedData* samples, int count) {
+    for (int i = 0; i < count; i++) {
+        observeSample((Observer*)instance, &samples[i]);
+    }
+}
+
+/**
+ * @brief Insert SAMPLE_COUNT samples, flush, and return the elapsed nanoseconds
+ */
+static double produce(void) {
+    struct TimeMarkedData tmd;
+
+    silenceStdout();
+    double start = nowNanos();
+    for (long i = 0; i < SAMPLE_COUNT; i++) {
+        tmd.timeInterval = i;
+        tmd.dataValue = (int)(i & 0x3ff);
+        TMDQueue_insert(queue, tmd);
+    }
+    TMDQueue_flush(queue);
+    double elapsed = nowNanos() - start;
+    restoreStdout();
+    return elapsed;
+}
+
+static void assertAllDelivered(void) {
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TEST_ASSERT_EQUAL_INT(SAMPLE_COUNT, observers[i].samples);
+        TEST_ASSERT_EQUAL_INT(0, observers[i].outOfOrder);
+    }
+}
+
+static void report(const char* label, double elapsed) {
+    printf("%-32s %.1f ns/sample (%d observers)\n", label, elapsed / SAMPLE_COUNT, OBSERVER_COUNT);
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void test_Performance_PerSampleNotify(void) {
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_subscribe(queue, &observers[i], sampleUpdate);
+    }
+    report("per-sample:", produce());
+    assertAllDelivered();
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_unsubscribe(queue, sampleUpdate);
+    }
+}
+
+void test_Performance_BatchNotify(void) {
+    static const int batchSizes[] = {16, 64, TMDQUEUE_MAX_BATCH};
+    char label[64];
+
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_subscribeBatch(queue, &observers[i], batchUpdate);
+    }
+    for (size_t b = 0; b < sizeof(batchSizes) / sizeof(batchSizes[0]); b++) {
+        for (int i = 0; i < OBSERVER_COUNT; i++) {
+            observers[i] = (Observer){0, -1, 0, 0};
+        }
+        TMDQueue_setBatchPolicy(queue, batchSizes[b], 0);
+        snprintf(label, sizeof(label), "batch observers, batch %d:", batchSizes[b]);
+        report(label, produce());
+        assertAllDelivered();
+    }
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_unsubscribeBatch(queue, batchUpdate);
+    }
+}
+
+void test_Performance_BatchToPerSampleObservers(void) {
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_subscribe(queue, &observers[i], sampleUpdate);
+    }
+    TMDQueue_setBatchPolicy(queue, 64, 0);
+    report("per-sample observers, batch 64:", produce());
+    assertAllDelivered();
+    for (int i = 0; i < OBSERVER_COUNT; i++) {
+        TMDQueue_unsubscribe(queue, sampleUpdate);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== TMDQueue Notification Benchmark ===\n");
+    RUN_TEST(test_Performance_PerSampleNotify);
+    RUN_TEST(test_Performance_BatchNotify);
+    RUN_TEST(test_Performance_BatchToPerSampleObservers);
+
+    return UNITY_END();
+}
@@ -0,0 +1,148 @@
+//
+// Memory footprint and window scan benchmark for TMDQueue
+//
+// Built twice by tests/CMakeLists.txt, once per storage layout (array of
+// TimeMarkedData structs and struct-of-arrays columns), so the two runs can
+// be compared side by side. Each run also checks the scans against a
+// reference computed from TMDQueue_remove.
+//
+// Categories:
+// - Memory footprint of one queue
+// - Peak-to-peak scan over a QRS-sized window
+// - Baseline sum over the whole buffer
+//
+
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "unity.h"
+#include "TMDQueue.h"
+
+#ifdef TMDQUEUE_SOA
+#define QUEUE_LAYOUT "soa"
+#else
+#define QUEUE_LAYOUT "aos"
+#endif
+
+#define SCAN_ROUNDS 2000
+#define SHORT_WINDOW 40
+
+static TMDQueue* queue;
+static volatile long sink; // Keeps the scans from being optimized away
+
+void setUp(void) {
+    queue = TMDQueue_Create();
+    TEST_ASSERT_NOT_NULL(queue);
+}
+
+void tearDown(void) {
+    TMDQueue_Destroy(queue);
+}
+
+/*
+ * ============================================================================
+ * HELPER FUNCTIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds
+ */
+static double nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Fill the whole buffer, plus some, so the windows wrap around
+ */
+static void fillQueue(void) {
+    struct TimeMarkedData tmd;
+    for (long i = 0; i < QUEUE_SIZE + QUEUE_SIZE / 3; i++) {
+        tmd.timeInterval = i;
+        tmd.dataValue = (int)((i * 7919) % 2001) - 1000;
+        TMDQueue_insert(queue, tmd);
+    }
+}
+
+/**
+ * @brief Index of the sample inserted back samples ago (0 is the newest)
+ */
+static int recentIndex(int back) {
+    return (queue->head - 1 - back + QUEUE_SIZE) % QUEUE_SIZE;
+}
+
+/*
+ * ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+void test_Performance_Footprint(void) {
+    size_t bytes = TMDQueue_footprint();
+
+    printf("[%s] footprint:  %zu bytes (%.1f bytes/sample, TimeMarkedData is %zu bytes)\n", QUEUE_LAYOUT,
+           bytes, (double)bytes / QUEUE_SIZE, sizeof(struct TimeMarkedData));
+    TEST_ASSERT_TRUE(bytes >= QUEUE_SIZE * (sizeof(int32_t) + sizeof(int64_t)));
+}
+
+void test_Performance_ShortWindowMinMax(void) {
+    int lo = 0;
+    int hi = 0;
+    int expectedLo = 1 << 30;
+    int expectedHi = -(1 << 30);
+
+    fillQueue();
+    for (int back = 0; back < SHORT_WINDOW; back++) {
+        int value = TMDQueue_remove(queue, recentIndex(back)).dataValue;
+        expectedLo = value < expectedLo ? value : expectedLo;
+        expectedHi = value > expectedHi ? value : expectedHi;
+    }
+
+    double start = nowNanos();
+    for (int round = 0; round < SCAN_ROUNDS * 100; round++) {
+        TMDQueue_windowMinMax(queue, SHORT_WINDOW, &lo, &hi);
+        sink += hi - lo;
+    }
+    double elapsed = nowNanos() - start;
+
+    printf("[%s] min/max:    %.1f ns per %d-sample window\n", QUEUE_LAYOUT,
+           elapsed / (SCAN_ROUNDS * 100), SHORT_WINDOW);
+    TEST_ASSERT_EQUAL_INT(expectedLo, lo);
+    TEST_ASSERT_EQUAL_INT(expectedHi, hi);
+}
+
+void test_Performance_FullBufferSum(void) {
+    int64_t sum = 0;
+    int64_t expected = 0;
+
+    fillQueue();
+    for (int index = 0; index < QUEUE_SIZE; index++) {
+        expected += TMDQueue_remove(queue, index).dataValue;
+    }
+
+    double start = nowNanos();
+    for (int round = 0; round < SCAN_ROUNDS; round++) {
+        TEST_ASSERT_EQUAL_INT(QUEUE_SIZE, TMDQueue_windowSum(queue, QUEUE_SIZE, &sum));
+        sink += (long)sum;
+    }
+    double elapsed = nowNanos() - start;
+
+    printf("[%s] sum:        %.1f us per %d-sample window (%.2f ns/sample)\n", QUEUE_LAYOUT,
+           elapsed / SCAN_ROUNDS / 1e3, QUEUE_SIZE, elapsed / SCAN_ROUNDS / QUEUE_SIZE);
+    TEST_ASSERT_TRUE(expected == sum);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    printf("\n=== TMDQueue Benchmark (%s layout) ===\n", QUEUE_LAYOUT);
+    RUN_TEST(test_Performance_Footprint);
+    RUN_TEST(test_Performance_ShortWindowMinMax);
+    RUN_TEST(test_Performance_FullBufferSum);
+
+    return UNITY_END();
+}
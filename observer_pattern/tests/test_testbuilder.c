@@ -1,12 +1,58 @@
 #include <unity.h>
+#include "TMDQueue.h"
+#include "QRSDetector.h"
 
+/* Observer that records what it is told, for checking delivery */
+typedef struct {
+    int calls;
+    int samples;
+    long lastTime;
+    int outOfOrder;
+} Recorder;
+
+static TMDQueue* queue;
+static Recorder perSample;
+static Recorder batched;
+
+static void recordSample(void* instance, const struct TimeMarkedData tmd) {
+    Recorder* recorder = (Recorder*)instance;
+    recorder->outOfOrder += tmd.timeInterval != recorder->lastTime + 1;
+    recorder->lastTime = tmd.timeInterval;
+    recorder->calls++;
+    recorder->samples++;
+}
+
+static void recordBatch(void* instance, const struct TimeMarkedData* samples, int count) {
+    Recorder* recorder = (Recorder*)instance;
+    for (int i = 0; i < count; i++) {
+        recorder->outOfOrder += samples[i].timeInterval != recorder->lastTime + 1;
+        recorder->lastTime = samples[i].timeInterval;
+    }
+    recorder->calls++;
+    recorder->samples += count;
+}
+
+static void insertSamples(long first, long count) {
+    struct TimeMarkedData tmd;
+    for (long i = first; i < first + count; i++) {
+        tmd.timeInterval = i;
+        tmd.dataValue = (int)i;
+        TMDQueue_insert(queue, tmd);
+    }
+}
 
 void setUp(void) {
-    // Initialize before each test
+    queue = TMDQueue_Create();
+    perSample = (Recorder){0, 0, -1, 0};
+    batched = (Recorder){0, 0, -1, 0};
+    TMDQueue_subscribe(queue, &perSample, recordSample);
+    TMDQueue_subscribeBatch(queue, &batched, recordBatch);
 }
 
 void tearDown(void) {
-    // Clean up after each test
+    TMDQueue_unsubscribe(queue, recordSample);
+    TMDQueue_unsubscribeBatch(queue, recordBatch);
+    TMDQueue_Destroy(queue);
 }
 
 // Example test
@@ -14,11 +60,78 @@ void test_function_should_do_something(void) {
     TEST_ASSERT_EQUAL(1, 1);
 }
 
+void test_default_policy_notifies_every_insert(void) {
+    insertSamples(0, 5);
+    TEST_ASSERT_EQUAL_INT(5, perSample.calls);
+    TEST_ASSERT_EQUAL_INT(5, batched.calls);
+    TEST_ASSERT_EQUAL_INT(5, batched.samples);
+}
+
+void test_batch_policy_delivers_every_n_samples(void) {
+    TMDQueue_setBatchPolicy(queue, 8, 0);
+    insertSamples(0, 7);
+    TEST_ASSERT_EQUAL_INT(0, batched.samples);
+    TEST_ASSERT_EQUAL_INT(0, perSample.samples);
+
+    insertSamples(7, 13);
+    TEST_ASSERT_EQUAL_INT(2, batched.calls);
+    TEST_ASSERT_EQUAL_INT(16, batched.samples);
+    TEST_ASSERT_EQUAL_INT(16, perSample.samples);
+
+    TMDQueue_flush(queue);
+    TEST_ASSERT_EQUAL_INT(3, batched.calls);
+    TEST_ASSERT_EQUAL_INT(20, batched.samples);
+    TEST_ASSERT_EQUAL_INT(20, perSample.calls);
+    TEST_ASSERT_EQUAL_INT(0, batched.outOfOrder);
+    TEST_ASSERT_EQUAL_INT(0, perSample.outOfOrder);
+}
+
+void test_batch_policy_delivers_by_age(void) {
+    TMDQueue_setBatchPolicy(queue, TMDQUEUE_MAX_BATCH, 1);
+    insertSamples(0, 1);
+    while (batched.samples == 0) {
+        TMDQueue_flushIfDue(queue);
+    }
+    TEST_ASSERT_EQUAL_INT(1, batched.calls);
+    TEST_ASSERT_EQUAL_INT(1, perSample.samples);
+}
+
+void test_changing_policy_flushes_pending_samples(void) {
+    TMDQueue_setBatchPolicy(queue, 1000, 0); // Clamped to TMDQUEUE_MAX_BATCH
+    TEST_ASSERT_EQUAL_INT(TMDQUEUE_MAX_BATCH, queue->batchSize);
+    insertSamples(0, 3);
+    TMDQueue_setBatchPolicy(queue, 1, 0);
+    TEST_ASSERT_EQUAL_INT(3, batched.samples);
+    insertSamples(3, 1);
+    TEST_ASSERT_EQUAL_INT(2, batched.calls);
+}
+
+void test_qrs_detector_finds_no_beats_on_a_flat_line(void) {
+    QRSDetector detector;
+
+    QRSDetector_Init(&detector);
+    QRSDetector_setItsTMDQueueBatched(&detector, queue);
+    TMDQueue_setBatchPolicy(queue, 64, 0);
+    for (long i = 0; i < 2000; i++) {
+        struct TimeMarkedData tmd = {i, 500, NULL};
+        TMDQueue_insert(queue, tmd);
+    }
+    TMDQueue_flush(queue);
+    TEST_ASSERT_EQUAL_INT(0, QRSDetector_getBeatCount(&detector));
+    TEST_ASSERT_EQUAL_INT(0, detector.heartRate);
+    QRSDetector_Cleanup(&detector);
+}
+
 int main(void) {
     UNITY_BEGIN();
 
     // Register tests here
     RUN_TEST(test_function_should_do_something);
+    RUN_TEST(test_default_policy_notifies_every_insert);
+    RUN_TEST(test_batch_policy_delivers_every_n_samples);
+    RUN_TEST(test_batch_policy_delivers_by_age);
+    RUN_TEST(test_changing_policy_flushes_pending_samples);
+    RUN_TEST(test_qrs_detector_finds_no_beats_on_a_flat_line);
 
     return UNITY_END();
 }
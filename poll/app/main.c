@@ -1,9 +1,35 @@
 
 #include "BCPeriodicPoller.h"
+#include "BCTimer.h"
+#include "BreathingCircuitSensor.h"
+#include "MedicalDisplay.h"
 
 int main(int argc, char const *argv[])
 {
     BCPeriodicPoller* p_BCPeriodicPoller = BCPeriodicPoller_Create();
-    BCPeriodicPoller_poll(p_BCPeriodicPoller);
+    BCTimer* p_BCTimer = BCTimer_Create();
+    MedicalDisplay* p_MedicalDisplay = MedicalDisplay_Create();
+    BreathingCircuitSensor* o2 = BreathingCircuitSensor_Create();
+    BreathingCircuitSensor* flow = BreathingCircuitSensor_Create();
+    BreathingCircuitSensor* pressure = BreathingCircuitSensor_Create();
+
+    BCPeriodicPoller_setItsBCTimer(p_BCPeriodicPoller, p_BCTimer);
+    BCPeriodicPoller_setItsMedicalDisplay(p_BCPeriodicPoller, p_MedicalDisplay);
+    BCPeriodicPoller_setPollTime(p_BCPeriodicPoller, 100);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, o2);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, flow);
+    // Pressure changes fastest, so it gets its own, faster rate
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, pressure, BC_READ_CIRCUIT_PRESSURE, 50, 25);
+
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    BCPeriodicPoller_run(p_BCPeriodicPoller, 10);
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+
+    BCPeriodicPoller_Destroy(p_BCPeriodicPoller);
+    BCTimer_Destroy(p_BCTimer);
+    MedicalDisplay_Destroy(p_MedicalDisplay);
+    BreathingCircuitSensor_Destroy(o2);
+    BreathingCircuitSensor_Destroy(flow);
+    BreathingCircuitSensor_Destroy(pressure);
     return 0;
 }
@@ -8,37 +8,127 @@
 #include "MedicalDisplay.h"
 #include <stdlib.h>
 
+/* How often run() looks at the stop flag when no timer fires */
+#define RUN_STOP_CHECK_MS (100)
+
 static void cleanUpRelations(BCPeriodicPoller* const me);
+static void registerGroups(BCPeriodicPoller* const me);
+
+static int findOrAddGroup(BCPeriodicPoller* const me, unsigned long periodMs, unsigned long phaseMs) {
+    BCPollGroup* group;
+    int g;
+    for (g = 0; g < me->nGroups; ++g) {
+        if (me->groups[g].periodMs == periodMs && me->groups[g].phaseMs == phaseMs) {
+            return g;
+        }
+    }
+    if (me->nGroups == MAX_POLL_GROUPS) {
+        return -1;
+    }
+    group = &me->groups[me->nGroups];
+    group->periodMs = periodMs;
+    group->phaseMs = phaseMs;
+    group->timerGroup = -1;
+    group->members = NULL;
+    group->nMembers = 0;
+    group->capacity = 0;
+    group->releases = 0;
+    group->missedDeadlines = 0;
+    return me->nGroups++;
+}
+
+static int addMember(BCPollGroup* const group, int device) {
+    if (group->nMembers == group->capacity) {
+        int capacity = group->capacity ? group->capacity * 2 : MAX_POLL_DEVICES;
+        int* members = (int*)realloc(group->members, (size_t)capacity * sizeof(int));
+        if (members == NULL) {
+            return -1;
+        }
+        group->members = members;
+        group->capacity = capacity;
+    }
+    group->members[group->nMembers++] = device;
+    return 0;
+}
+
+static void pollDevice(BCPolledDevice* const device, MedicalDisplayFrame* const frame) {
+    int data = BreathingCircuitSensor_getData(device->sensor);
+    switch (device->reading) {
+        case BC_READ_O2_CONCENTRATION:
+            frame->o2Concentration = data;
+            frame->updated |= MEDICAL_DISPLAY_O2_CONCENTRATION;
+            break;
+        case BC_READ_GAS_FLOW:
+            frame->gasFlow = data;
+            frame->gasFlowStatus = BreathingCircuitSensor_getState(device->sensor);
+            frame->updated |= MEDICAL_DISPLAY_GAS_FLOW | MEDICAL_DISPLAY_GAS_FLOW_STATUS;
+            break;
+        case BC_READ_CIRCUIT_PRESSURE:
+            frame->circuitPressure = data;
+            frame->updated |= MEDICAL_DISPLAY_CIRCUIT_PRESSURE;
+            break;
+    }
+    frame->readings++;
+    device->polls++;
+}
+
+static int pollGroup(BCPeriodicPoller* const me, BCPollGroup* const group, MedicalDisplayFrame* const frame) {
+    int polled = 0;
+    int m;
+    for (m = 0; m < group->nMembers; ++m) {
+        BCPolledDevice* device = &me->devices[group->members[m]];
+        if (device->sensor != NULL) {
+            pollDevice(device, frame);
+            polled++;
+        }
+    }
+    return polled;
+}
+
+static void showFrame(BCPeriodicPoller* const me, const MedicalDisplayFrame* const frame) {
+    if (me->itsMedicalDisplay != NULL) {
+        MedicalDisplay_showFrame(me->itsMedicalDisplay, frame);
+    }
+}
 
 void BCPeriodicPoller_Init(BCPeriodicPoller* const me) {
+    int pos;
     me->pollTime = DEFAULT_POLL_TIME;
     me->itsBCTimer = NULL;
-    int pos;
-    for(pos = 0; pos < 3; ++pos)
-        me->itsBreathingCircuitSensor[pos] = NULL;
+    me->devices = NULL;
+    me->nDevices = 0;
+    me->deviceCapacity = 0;
+    me->nActive = 0;
+    me->nGroups = 0;
+    for (pos = 0; pos < MAX_POLL_GROUPS; ++pos)
+        me->timerToGroup[pos] = -1;
     me->itsMedicalDisplay = NULL;
-    BCTimer_installInterruptHandler(me->itsBCTimer);
-    me->pollTime = DEFAULT_POLL_TIME;
+    me->polling = 0;
+    me->wakeups = 0;
+    me->missedDeadlines = 0;
 }
 
 void BCPeriodicPoller_Cleanup(BCPeriodicPoller* const me) {
-    BCTimer_stopTimer(me->itsBCTimer);
-    BCTimer_removeInterruptHandler(me->itsBCTimer);
+    if (me->itsBCTimer != NULL) {
+        BCTimer_stopTimer(me->itsBCTimer);
+        BCTimer_removeInterruptHandler(me->itsBCTimer);
+    }
+    BCPeriodicPoller_clearItsBreathingCircuitSensor(me);
+    free(me->devices);
+    me->devices = NULL;
+    me->deviceCapacity = 0;
     cleanUpRelations(me);
 }
 
+/* Reads every registered device once, outside the timer, with one display update */
 void BCPeriodicPoller_poll(BCPeriodicPoller* const me) {
-    int state, data;
-    data = BreathingCircuitSensor_getData(me->itsBreathingCircuitSensor[0]);
-    MedicalDisplay_showO2Concentration(me->itsMedicalDisplay, data);
-
-    data = BreathingCircuitSensor_getData(me->itsBreathingCircuitSensor[1]);
-    state = BreathingCircuitSensor_getState(me->itsBreathingCircuitSensor[1]);
-    MedicalDisplay_showGasFlow(me->itsMedicalDisplay, data);
-    MedicalDisplay_showGasFlowStatus(me->itsMedicalDisplay, state);
-
-    data = BreathingCircuitSensor_getData(me->itsBreathingCircuitSensor[2]);
-    MedicalDisplay_showCircuitPressure(me->itsMedicalDisplay, data);
+    MedicalDisplayFrame frame;
+    int g;
+    MedicalDisplay_clearFrame(&frame);
+    for (g = 0; g < me->nGroups; ++g) {
+        pollGroup(me, &me->groups[g], &frame);
+    }
+    showFrame(me, &frame);
 }
 
 void BCPeriodicPoller_setPollTime(BCPeriodicPoller* const me, unsigned long t) {
@@ -46,11 +136,118 @@ void BCPeriodicPoller_setPollTime(BCPeriodicPoller* const me, unsigned long t) {
 }
 
 void BCPeriodicPoller_startPolling(BCPeriodicPoller* const me) {
-    BCTimer_startTimer(me->itsBCTimer, me->pollTime);
+    if (me->itsBCTimer == NULL) {
+        return;
+    }
+    registerGroups(me);
+    __atomic_store_n(&me->polling, 1, __ATOMIC_RELEASE);
+    BCTimer_startTimer(me->itsBCTimer, (int)me->pollTime);
 }
 
 void BCPeriodicPoller_stopPolling(BCPeriodicPoller* const me) {
-    BCTimer_stopTimer(me->itsBCTimer);
+    __atomic_store_n(&me->polling, 0, __ATOMIC_RELEASE);
+    if (me->itsBCTimer != NULL) {
+        BCTimer_stopTimer(me->itsBCTimer);
+    }
+}
+
+int BCPeriodicPoller_addDevice(BCPeriodicPoller* const me, struct BreathingCircuitSensor* p_BreathingCircuitSensor,
+                               BCReading reading, unsigned long periodMs, unsigned long phaseMs) {
+    BCPolledDevice* device;
+    int g;
+
+    if (p_BreathingCircuitSensor == NULL || periodMs == 0) {
+        return -1;
+    }
+    if (me->nDevices == me->deviceCapacity) {
+        int capacity = me->deviceCapacity ? me->deviceCapacity * 2 : MAX_POLL_DEVICES;
+        BCPolledDevice* devices = (BCPolledDevice*)realloc(me->devices, (size_t)capacity * sizeof(BCPolledDevice));
+        if (devices == NULL) {
+            return -1;
+        }
+        me->devices = devices;
+        me->deviceCapacity = capacity;
+    }
+    g = findOrAddGroup(me, periodMs, phaseMs % periodMs);
+    if (g < 0 || addMember(&me->groups[g], me->nDevices) != 0) {
+        return -1;
+    }
+    device = &me->devices[me->nDevices];
+    device->sensor = p_BreathingCircuitSensor;
+    device->reading = reading;
+    device->group = g;
+    device->polls = 0;
+    me->nActive++;
+    registerGroups(me);  // a new rate joins a running timer straight away
+    return me->nDevices++;
+}
+
+int BCPeriodicPoller_runOnce(BCPeriodicPoller* const me, int timeoutMs) {
+    int ready[MAX_POLL_GROUPS];
+    unsigned long long expirations[MAX_POLL_GROUPS];
+    MedicalDisplayFrame frame;
+    int polled = 0;
+    int n;
+    int i;
+
+    if (me->itsBCTimer == NULL) {
+        return -1;
+    }
+    n = BCTimer_wait(me->itsBCTimer, timeoutMs, ready, expirations, MAX_POLL_GROUPS);
+    if (n <= 0) {
+        return n;
+    }
+    // Groups released together are served together and drawn once
+    MedicalDisplay_clearFrame(&frame);
+    for (i = 0; i < n; ++i) {
+        int g = me->timerToGroup[ready[i]];
+        BCPollGroup* group;
+        if (g < 0) {
+            continue;
+        }
+        group = &me->groups[g];
+        group->releases += (unsigned long)expirations[i];
+        if (expirations[i] > 1) {
+            // Every release beyond the first since the last read went unserved
+            group->missedDeadlines += (unsigned long)(expirations[i] - 1);
+            me->missedDeadlines += (unsigned long)(expirations[i] - 1);
+        }
+        polled += pollGroup(me, group, &frame);
+    }
+    showFrame(me, &frame);
+    me->wakeups++;
+    return polled;
+}
+
+void BCPeriodicPoller_run(BCPeriodicPoller* const me, unsigned long maxWakeups) {
+    unsigned long start = me->wakeups;
+    while (__atomic_load_n(&me->polling, __ATOMIC_ACQUIRE)) {
+        if (maxWakeups != 0 && me->wakeups - start >= maxWakeups) {
+            break;
+        }
+        if (BCPeriodicPoller_runOnce(me, RUN_STOP_CHECK_MS) < 0) {
+            break;
+        }
+    }
+}
+
+unsigned long BCPeriodicPoller_getWakeups(const BCPeriodicPoller* const me) {
+    return me->wakeups;
+}
+
+unsigned long BCPeriodicPoller_getMissedDeadlines(const BCPeriodicPoller* const me) {
+    return me->missedDeadlines;
+}
+
+unsigned long BCPeriodicPoller_getDevicePolls(const BCPeriodicPoller* const me, int device) {
+    if (device < 0 || device >= me->nDevices) {
+        return 0;
+    }
+    return me->devices[device].polls;
+}
+
+int BCPeriodicPoller_getGroupCount(const BCPeriodicPoller* const me) {
+    return me->nGroups;
 }
 
 struct BCTimer* BCPeriodicPoller_getItsBCTimer(const BCPeriodicPoller* const me) {
@@ -58,45 +255,54 @@ struct BCTimer* BCPeriodicPoller_getItsBCTimer(const BCPeriodicPoller* const me)
 }
 
 void BCPeriodicPoller_setItsBCTimer(BCPeriodicPoller* const me, struct BCTimer* p_BCTimer) {
+    int g;
     if(p_BCTimer != NULL)
     {
         BCTimer_setItsBCPeriodicPoller(p_BCTimer, me);
+        BCTimer_installInterruptHandler(p_BCTimer);
     }
     BCPeriodicPoller_setItsBCTimer1(me, p_BCTimer);
+    // Group indices belonged to the previous timer
+    for (g = 0; g < me->nGroups; ++g)
+        me->groups[g].timerGroup = -1;
+    for (g = 0; g < MAX_POLL_GROUPS; ++g)
+        me->timerToGroup[g] = -1;
+    registerGroups(me);
 }
 
 int BCPeriodicPoller_getItsBreathingCircuitSensor(const BCPeriodicPoller* const me) {
-    int iter = 0;
-    return iter;
+    return me->nActive;
 }
 
+/* Polled at pollTime; the first three feed O2, gas flow and pressure, in that order */
 void BCPeriodicPoller_addItsBreathingCircuitSensor(BCPeriodicPoller* const me, struct BreathingCircuitSensor * p_BreathingCircuitSensor) {
-    int pos;
-    for(pos = 0; pos < 3; ++pos) {
-        if (!me->itsBreathingCircuitSensor[pos]) {
-            me->itsBreathingCircuitSensor[pos] = p_BreathingCircuitSensor;
-            break;
-        }
-    }
+    BCPeriodicPoller_addDevice(me, p_BreathingCircuitSensor, (BCReading)(me->nActive % 3), me->pollTime, 0);
 }
 
 void BCPeriodicPoller_removeItsBreathingCircuitSensor(BCPeriodicPoller* const me, struct BreathingCircuitSensor * p_BreathingCircuitSensor) {
     int pos;
-    for(pos = 0; pos < 3; ++pos) {
-        if (me->itsBreathingCircuitSensor[pos] == p_BreathingCircuitSensor) {
-            me->itsBreathingCircuitSensor[pos] = NULL;
+    for(pos = 0; pos < me->nDevices; ++pos) {
+        if (me->devices[pos].sensor == p_BreathingCircuitSensor && p_BreathingCircuitSensor != NULL) {
+            me->devices[pos].sensor = NULL;
+            me->nActive--;
         }
     }
 }
 
 void BCPeriodicPoller_clearItsBreathingCircuitSensor(BCPeriodicPoller* const me) {
-    {
-        int pos;
-        for(pos = 0; pos < 3; ++pos)
-        {
-            me->itsBreathingCircuitSensor[pos] = NULL;
-        }
+    int g;
+    for (g = 0; g < me->nGroups; ++g) {
+        free(me->groups[g].members);
+    }
+    for (g = 0; g < MAX_POLL_GROUPS; ++g) {
+        me->timerToGroup[g] = -1;
     }
+    if (me->itsBCTimer != NULL) {
+        BCTimer_clearGroups(me->itsBCTimer);
+    }
+    me->nGroups = 0;
+    me->nDevices = 0;
+    me->nActive = 0;
 }
 
 struct MedicalDisplay* BCPeriodicPoller_getItsMedicalDisplay(const BCPeriodicPoller* const me) {
@@ -156,3 +362,19 @@ void BCPeriodicPoller_setItsBCTimer1(BCPeriodicPoller* const me, struct BCTimer*
 void BCPeriodicPoller_clearItsBCTimer(BCPeriodicPoller* const me) {
     me->itsBCTimer = NULL;
 }
+
+static void registerGroups(BCPeriodicPoller* const me) {
+    int g;
+    if (me->itsBCTimer == NULL) {
+        return;
+    }
+    for (g = 0; g < me->nGroups; ++g) {
+        if (me->groups[g].timerGroup < 0) {
+            int t = BCTimer_addGroup(me->itsBCTimer, me->groups[g].periodMs, me->groups[g].phaseMs);
+            if (t >= 0) {
+                me->groups[g].timerGroup = t;
+                me->timerToGroup[t] = g;
+            }
+        }
+    }
+}
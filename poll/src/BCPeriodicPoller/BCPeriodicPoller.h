@@ -10,19 +10,57 @@ typedef int deviceData;
 
 typedef void (*timerVectorPtr)(void);
 
-#define MAX_POLL_DEVICES (10)
+#define MAX_POLL_DEVICES (10)     /* initial device table size, it grows on demand */
+#define MAX_POLL_GROUPS (64)      /* distinct (period, phase) pairs */
 #define DEFAULT_POLL_TIME (1000)
 
 struct BCTimer;
 struct BreathingCircuitSensor;
 struct MedicalDisplay;
 
+/* Which display field a device feeds */
+typedef enum BCReading {
+    BC_READ_O2_CONCENTRATION,
+    BC_READ_GAS_FLOW,           /* flow and its status */
+    BC_READ_CIRCUIT_PRESSURE
+} BCReading;
+
+typedef struct BCPolledDevice BCPolledDevice;
+struct BCPolledDevice {
+    struct BreathingCircuitSensor* sensor;   /* NULL once removed */
+    BCReading reading;
+    int group;
+    unsigned long polls;
+};
+
+/* Devices sharing a period and phase; one timer and one wake-up for all of them */
+typedef struct BCPollGroup BCPollGroup;
+struct BCPollGroup {
+    unsigned long periodMs;
+    unsigned long phaseMs;
+    int timerGroup;             /* index in itsBCTimer, -1 until registered */
+    int* members;               /* device indices */
+    int nMembers;
+    int capacity;
+    unsigned long releases;     /* periods served, missed ones included */
+    unsigned long missedDeadlines;
+};
+
 typedef struct BCPeriodicPoller BCPeriodicPoller;
 struct BCPeriodicPoller {
     unsigned long pollTime;
     struct BCTimer* itsBCTimer;
-    struct BreathingCircuitSensor *itsBreathingCircuitSensor[3];
+    BCPolledDevice* devices;
+    int nDevices;
+    int deviceCapacity;
+    int nActive;
+    BCPollGroup groups[MAX_POLL_GROUPS];
+    int nGroups;
+    int timerToGroup[MAX_POLL_GROUPS];
     struct MedicalDisplay* itsMedicalDisplay;
+    int polling;                /* cleared by stopPolling, read by run */
+    unsigned long wakeups;
+    unsigned long missedDeadlines;
 };
 
 
@@ -35,6 +73,29 @@ void BCPeriodicPoller_setPollTime(BCPeriodicPoller* const me, unsigned long t);
 void BCPeriodicPoller_startPolling(BCPeriodicPoller* const me);
 void BCPeriodicPoller_stopPolling(BCPeriodicPoller* const me);
 
+/*
+    Registers a device polled every periodMs, offset by phaseMs from the start
+    of polling. Devices with the same period and phase share one timer.
+    Returns the device id, or -1 when out of memory or out of groups.
+*/
+int BCPeriodicPoller_addDevice(BCPeriodicPoller* const me, struct BreathingCircuitSensor* p_BreathingCircuitSensor,
+                               BCReading reading, unsigned long periodMs, unsigned long phaseMs);
+
+/*
+    Serves one timer wake-up: polls every device of every group that fired and
+    updates the display once. Waits up to timeoutMs (-1 forever). Returns the
+    devices polled, 0 on timeout, -1 on error.
+*/
+int BCPeriodicPoller_runOnce(BCPeriodicPoller* const me, int timeoutMs);
+
+/* Serves wake-ups until stopPolling, or until maxWakeups when it is not 0 */
+void BCPeriodicPoller_run(BCPeriodicPoller* const me, unsigned long maxWakeups);
+
+unsigned long BCPeriodicPoller_getWakeups(const BCPeriodicPoller* const me);
+unsigned long BCPeriodicPoller_getMissedDeadlines(const BCPeriodicPoller* const me);
+unsigned long BCPeriodicPoller_getDevicePolls(const BCPeriodicPoller* const me, int device);
+int BCPeriodicPoller_getGroupCount(const BCPeriodicPoller* const me);
+
 struct BCTimer* BCPeriodicPoller_getItsBCTimer(const BCPeriodicPoller* const me);
 void BCPeriodicPoller_setItsBCTimer(BCPeriodicPoller* const me, struct BCTimer* p_BCTimer);
 
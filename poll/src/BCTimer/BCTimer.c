@@ -2,15 +2,62 @@
 // Created by mahon on 1/13/2024.
 //
 
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
 #include "BCTimer.h"
+#include <errno.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NS_PER_MS (1000000LL)
+#define NS_PER_S (1000000000LL)
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * NS_PER_S + ts.tv_nsec;
+}
 
+static struct timespec toTimespec(long long ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / NS_PER_S);
+    ts.tv_nsec = (long)(ns % NS_PER_S);
+    return ts;
+}
 
-void BCTimer_Init(BCTimer* const me){
+/* First release on the group's grid at or after `from` */
+static int armGroup(BCTimer* const me, int index, long long from) {
+    BCTimerGroup* group = &me->groups[index];
+    long long period = (long long)group->periodMs * NS_PER_MS;
+    long long release = me->startNs + (long long)group->phaseMs * NS_PER_MS;
+    struct itimerspec spec;
 
+    if (release < from) {
+        release += ((from - release + period - 1) / period) * period;
+    }
+    spec.it_value = toTimespec(release);
+    spec.it_interval = toTimespec(period);
+    return timerfd_settime(group->fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+static void disarmGroup(BCTimer* const me, int index) {
+    struct itimerspec spec = {{0, 0}, {0, 0}};
+    timerfd_settime(me->groups[index].fd, 0, &spec, NULL);
 }
-void BCTimer_Cleanup(BCTimer* const me){
 
+void BCTimer_Init(BCTimer* const me){
+    me->poller = NULL;
+    me->epollFd = -1;
+    me->nGroups = 0;
+    me->running = 0;
+    me->startNs = 0;
+}
+void BCTimer_Cleanup(BCTimer* const me){
+    BCTimer_removeInterruptHandler(me);
 }
 
 BCTimer* BCTimer_Create(){
@@ -30,20 +77,105 @@ void BCTimer_Destroy(BCTimer* me){
     free(me);
 }
 
+/* pollTime only matters when nobody registered a group: it becomes the single group */
 void BCTimer_startTimer(BCTimer* const me, int pollTime){
-
+    int i;
+    if (me->nGroups == 0 && pollTime > 0) {
+        BCTimer_addGroup(me, (unsigned long)pollTime, 0);
+    }
+    me->startNs = nowNs();
+    me->running = 1;
+    for (i = 0; i < me->nGroups; ++i) {
+        armGroup(me, i, me->startNs);
+    }
 }
 
 void BCTimer_stopTimer(BCTimer* const me){
-
+    int i;
+    me->running = 0;
+    for (i = 0; i < me->nGroups; ++i) {
+        disarmGroup(me, i);
+    }
 }
 
 void BCTimer_installInterruptHandler(BCTimer* const me){
-
+    if (me->epollFd < 0) {
+        me->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    }
 }
 
 void BCTimer_removeInterruptHandler(BCTimer* const me){
+    BCTimer_stopTimer(me);
+    BCTimer_clearGroups(me);
+    if (me->epollFd >= 0) {
+        close(me->epollFd);
+        me->epollFd = -1;
+    }
+}
+
+int BCTimer_addGroup(BCTimer* const me, unsigned long periodMs, unsigned long phaseMs){
+    struct epoll_event event;
+    int fd;
+
+    BCTimer_installInterruptHandler(me);
+    if (me->epollFd < 0 || me->nGroups == MAX_POLL_GROUPS || periodMs == 0) {
+        return -1;
+    }
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    event.events = EPOLLIN;
+    event.data.u32 = (uint32_t)me->nGroups;
+    if (epoll_ctl(me->epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        close(fd);
+        return -1;
+    }
+    me->groups[me->nGroups].fd = fd;
+    me->groups[me->nGroups].periodMs = periodMs;
+    me->groups[me->nGroups].phaseMs = phaseMs % periodMs;
+    if (me->running) {
+        armGroup(me, me->nGroups, nowNs());  // joins the grid of the groups already running
+    }
+    return me->nGroups++;
+}
 
+void BCTimer_clearGroups(BCTimer* const me){
+    int i;
+    for (i = 0; i < me->nGroups; ++i) {
+        close(me->groups[i].fd);  // closing also drops it from the epoll set
+    }
+    me->nGroups = 0;
+}
+
+int BCTimer_getGroupCount(const BCTimer* const me){
+    return me->nGroups;
+}
+
+int BCTimer_wait(BCTimer* const me, int timeoutMs, int* groups, unsigned long long* expirations, int max){
+    struct epoll_event events[MAX_POLL_GROUPS];
+    int ready = 0;
+    int n;
+    int i;
+
+    if (me->epollFd < 0 || max <= 0) {
+        return -1;
+    }
+    n = epoll_wait(me->epollFd, events, max < MAX_POLL_GROUPS ? max : MAX_POLL_GROUPS, timeoutMs);
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    for (i = 0; i < n; ++i) {
+        int index = (int)events[i].data.u32;
+        uint64_t count;
+        // A stop between the wake-up and this read leaves nothing to read
+        if (index < me->nGroups && read(me->groups[index].fd, &count, sizeof(count)) == (ssize_t)sizeof(count)) {
+            groups[ready] = index;
+            expirations[ready] = (unsigned long long)count;
+            ready++;
+        }
+    }
+    return ready;
 }
 
 void BCTimer_setItsBCPeriodicPoller(BCTimer* const me, BCPeriodicPoller* const poller){
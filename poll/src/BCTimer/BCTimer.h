@@ -9,10 +9,28 @@
 
 struct BCPeriodicPoller;
 
+/*
+    One timerfd per rate group, all registered on a single epoll instance.
+    A group fires at start + phase + k * period; every group is measured from
+    the same start so phases line up across groups.
+*/
+typedef struct BCTimerGroup BCTimerGroup;
+struct BCTimerGroup
+{
+    int fd;
+    unsigned long periodMs;
+    unsigned long phaseMs;
+};
+
 typedef struct BCTimer BCTimer;
 struct BCTimer
 {
     BCPeriodicPoller* poller;
+    int epollFd;                              /* -1 until the handler is installed */
+    BCTimerGroup groups[MAX_POLL_GROUPS];
+    int nGroups;
+    int running;
+    long long startNs;                        /* CLOCK_MONOTONIC time of startTimer */
 };
 
 void BCTimer_Init(BCTimer* const me);
@@ -27,6 +45,19 @@ void BCTimer_stopTimer(BCTimer* const me);
 void BCTimer_installInterruptHandler(BCTimer* const me);
 void BCTimer_removeInterruptHandler(BCTimer* const me);
 
+/* Returns the group index, or -1 when the table is full or the fd cannot be made */
+int BCTimer_addGroup(BCTimer* const me, unsigned long periodMs, unsigned long phaseMs);
+void BCTimer_clearGroups(BCTimer* const me);
+int BCTimer_getGroupCount(const BCTimer* const me);
+
+/*
+    Waits up to timeoutMs (-1 forever) for groups to fire. Fills groups[] with
+    the ready group indices and expirations[] with how many periods elapsed
+    since each was last read (more than 1 means deadlines were missed).
+    Returns the number of ready groups, 0 on timeout, -1 on error.
+*/
+int BCTimer_wait(BCTimer* const me, int timeoutMs, int* groups, unsigned long long* expirations, int max);
+
 void BCTimer_setItsBCPeriodicPoller(BCTimer* const me, BCPeriodicPoller* const poller);
 BCPeriodicPoller* BCTimer_getItsBCPeriodicPoller(BCTimer* const me);
 
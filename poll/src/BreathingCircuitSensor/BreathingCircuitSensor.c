@@ -6,7 +6,8 @@
 #include <stdlib.h>
 
 void BreathingCircuitSensor_Init(BreathingCircuitSensor* const me){
-
+    me->data = 0;
+    me->state = 0;
 }
 void BreathingCircuitSensor_Cleanup(BreathingCircuitSensor* const me){
 
@@ -30,9 +31,9 @@ void BreathingCircuitSensor_Destroy(BreathingCircuitSensor* me){
 }
 
 int BreathingCircuitSensor_getData(BreathingCircuitSensor* const me){
-
+    return me->data;
 }
 
 int BreathingCircuitSensor_getState(BreathingCircuitSensor* const me){
-
+    return me->state;
 }
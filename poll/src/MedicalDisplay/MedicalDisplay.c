@@ -7,7 +7,8 @@
 #include <stdlib.h>
 
 void MedicalDisplay_Init(MedicalDisplay* const me){
-
+    me->echo = 1;
+    me->updates = 0;
 }
 void MedicalDisplay_Cleanup(MedicalDisplay* const me){
 
@@ -41,4 +42,46 @@ void MedicalDisplay_showGasFlowStatus(MedicalDisplay* const me, int state){
 }
 void MedicalDisplay_showCircuitPressure(MedicalDisplay* const me, int data){
     printf("call MedicalDisplay_showCircuitPressure, data:%d\n", data);
-}
\ No newline at end of file
+}
+
+void MedicalDisplay_clearFrame(MedicalDisplayFrame* const frame){
+    frame->o2Concentration = 0;
+    frame->gasFlow = 0;
+    frame->gasFlowStatus = 0;
+    frame->circuitPressure = 0;
+    frame->updated = 0;
+    frame->readings = 0;
+}
+
+/* One redraw for everything a wake-up read, instead of one per reading */
+void MedicalDisplay_showFrame(MedicalDisplay* const me, const MedicalDisplayFrame* const frame){
+    if (frame->updated == 0) {
+        return;
+    }
+    me->updates++;
+    if (!me->echo) {
+        return;
+    }
+    printf("call MedicalDisplay_showFrame, readings:%lu", frame->readings);
+    if (frame->updated & MEDICAL_DISPLAY_O2_CONCENTRATION) {
+        printf(" o2:%d", frame->o2Concentration);
+    }
+    if (frame->updated & MEDICAL_DISPLAY_GAS_FLOW) {
+        printf(" flow:%d", frame->gasFlow);
+    }
+    if (frame->updated & MEDICAL_DISPLAY_GAS_FLOW_STATUS) {
+        printf(" flowStatus:%d", frame->gasFlowStatus);
+    }
+    if (frame->updated & MEDICAL_DISPLAY_CIRCUIT_PRESSURE) {
+        printf(" pressure:%d", frame->circuitPressure);
+    }
+    printf("\n");
+}
+
+void MedicalDisplay_setEcho(MedicalDisplay* const me, int echo){
+    me->echo = echo;
+}
+
+unsigned long MedicalDisplay_getUpdates(const MedicalDisplay* const me){
+    return me->updates;
+}
@@ -6,10 +6,29 @@
 #define POLL_MEDICALDISPLAY_H
 
 
+/* Fields carried by a MedicalDisplayFrame */
+#define MEDICAL_DISPLAY_O2_CONCENTRATION (0x1u)
+#define MEDICAL_DISPLAY_GAS_FLOW (0x2u)
+#define MEDICAL_DISPLAY_GAS_FLOW_STATUS (0x4u)
+#define MEDICAL_DISPLAY_CIRCUIT_PRESSURE (0x8u)
+
+/* Latest value of every field read during one poller wake-up */
+typedef struct MedicalDisplayFrame MedicalDisplayFrame;
+struct MedicalDisplayFrame
+{
+    int o2Concentration;
+    int gasFlow;
+    int gasFlowStatus;
+    int circuitPressure;
+    unsigned int updated;    /* MEDICAL_DISPLAY_* bits set by this wake-up */
+    unsigned long readings;  /* sensor reads folded into the frame */
+};
+
 typedef struct MedicalDisplay MedicalDisplay;
 struct MedicalDisplay
 {
-
+    int echo;                /* print every update, on by default */
+    unsigned long updates;   /* frames shown so far */
 };
 
 void MedicalDisplay_Init(MedicalDisplay* const me);
@@ -23,6 +42,11 @@ void MedicalDisplay_showGasFlow(MedicalDisplay* const me, int data);
 void MedicalDisplay_showGasFlowStatus(MedicalDisplay* const me, int state);
 void MedicalDisplay_showCircuitPressure(MedicalDisplay* const me, int data);
 
+void MedicalDisplay_clearFrame(MedicalDisplayFrame* const frame);
+void MedicalDisplay_showFrame(MedicalDisplay* const me, const MedicalDisplayFrame* const frame);
+void MedicalDisplay_setEcho(MedicalDisplay* const me, int echo);
+unsigned long MedicalDisplay_getUpdates(const MedicalDisplay* const me);
+
 
 
 #endif //POLL_MEDICALDISPLAY_H
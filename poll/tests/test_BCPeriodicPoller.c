@@ -0,0 +1,205 @@
+#define _POSIX_C_SOURCE 200809L  // nanosleep
+
+#include <unity.h>
+#include <time.h>
+#include "BCPeriodicPoller.h"
+#include "BCTimer.h"
+#include "BreathingCircuitSensor.h"
+#include "MedicalDisplay.h"
+
+#define SENSORS 8
+
+// Test fixtures
+BCPeriodicPoller* p_BCPeriodicPoller;
+BCTimer* p_BCTimer;
+MedicalDisplay* p_MedicalDisplay;
+BreathingCircuitSensor* sensors[SENSORS];
+
+void setUp(void) {
+    p_BCPeriodicPoller = BCPeriodicPoller_Create();
+    p_BCTimer = BCTimer_Create();
+    p_MedicalDisplay = MedicalDisplay_Create();
+    MedicalDisplay_setEcho(p_MedicalDisplay, 0);
+    for (int i = 0; i < SENSORS; i++) {
+        sensors[i] = BreathingCircuitSensor_Create();
+        sensors[i]->data = 100 + i;
+        sensors[i]->state = i;
+    }
+    BCPeriodicPoller_setItsBCTimer(p_BCPeriodicPoller, p_BCTimer);
+    BCPeriodicPoller_setItsMedicalDisplay(p_BCPeriodicPoller, p_MedicalDisplay);
+}
+
+void tearDown(void) {
+    BCPeriodicPoller_Destroy(p_BCPeriodicPoller);
+    BCTimer_Destroy(p_BCTimer);
+    MedicalDisplay_Destroy(p_MedicalDisplay);
+    for (int i = 0; i < SENSORS; i++) {
+        BreathingCircuitSensor_Destroy(sensors[i]);
+    }
+}
+
+static void sleepMs(long ms) {
+    struct timespec pause = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&pause, NULL);
+}
+
+void test_devices_sharing_period_and_phase_share_a_group(void) {
+    TEST_ASSERT_EQUAL_INT(0, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 10, 0));
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[1], BC_READ_GAS_FLOW, 10, 0));
+    TEST_ASSERT_EQUAL_INT(2, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[2], BC_READ_GAS_FLOW, 10, 5));
+    TEST_ASSERT_EQUAL_INT(3, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[3], BC_READ_GAS_FLOW, 10, 15));  // phase wraps to 5
+    TEST_ASSERT_EQUAL_INT(4, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[4], BC_READ_CIRCUIT_PRESSURE, 20, 0));
+
+    TEST_ASSERT_EQUAL_INT(3, BCPeriodicPoller_getGroupCount(p_BCPeriodicPoller));
+    TEST_ASSERT_EQUAL_INT(3, BCTimer_getGroupCount(p_BCTimer));
+    TEST_ASSERT_EQUAL_INT(5, BCPeriodicPoller_getItsBreathingCircuitSensor(p_BCPeriodicPoller));
+}
+
+void test_device_table_grows_past_its_initial_size(void) {
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(i, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[i % SENSORS],
+                                                            BC_READ_O2_CONCENTRATION, (unsigned long)(1 + i % 4), 0));
+    }
+    TEST_ASSERT_EQUAL_INT(1000, BCPeriodicPoller_getItsBreathingCircuitSensor(p_BCPeriodicPoller));
+    TEST_ASSERT_EQUAL_INT(4, BCPeriodicPoller_getGroupCount(p_BCPeriodicPoller));
+}
+
+void test_bad_devices_and_too_many_rates_are_rejected(void) {
+    TEST_ASSERT_EQUAL_INT(-1, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, NULL, BC_READ_GAS_FLOW, 10, 0));
+    TEST_ASSERT_EQUAL_INT(-1, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_GAS_FLOW, 0, 0));
+    for (unsigned long p = 1; p <= MAX_POLL_GROUPS; p++) {
+        TEST_ASSERT_TRUE(BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_GAS_FLOW, p, 0) >= 0);
+    }
+    TEST_ASSERT_EQUAL_INT(-1, BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_GAS_FLOW,
+                                                         MAX_POLL_GROUPS + 1, 0));
+    // An existing rate still takes more devices
+    TEST_ASSERT_TRUE(BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[1], BC_READ_GAS_FLOW, 1, 0) >= 0);
+}
+
+void test_manual_poll_reads_every_device_into_one_display_update(void) {
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[0]);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[1]);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[2]);
+
+    BCPeriodicPoller_poll(p_BCPeriodicPoller);
+    TEST_ASSERT_EQUAL_UINT(1, MedicalDisplay_getUpdates(p_MedicalDisplay));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT(1, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, i));
+    }
+}
+
+void test_frame_carries_the_legacy_field_mapping(void) {
+    MedicalDisplayFrame frame;
+    MedicalDisplay_clearFrame(&frame);
+    TEST_ASSERT_EQUAL_UINT(0, frame.updated);
+
+    // With nothing read the display is not redrawn
+    MedicalDisplay_showFrame(p_MedicalDisplay, &frame);
+    TEST_ASSERT_EQUAL_UINT(0, MedicalDisplay_getUpdates(p_MedicalDisplay));
+
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[0]);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[1]);
+    BCPeriodicPoller_addItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[2]);
+    TEST_ASSERT_EQUAL(BC_READ_O2_CONCENTRATION, p_BCPeriodicPoller->devices[0].reading);
+    TEST_ASSERT_EQUAL(BC_READ_GAS_FLOW, p_BCPeriodicPoller->devices[1].reading);
+    TEST_ASSERT_EQUAL(BC_READ_CIRCUIT_PRESSURE, p_BCPeriodicPoller->devices[2].reading);
+    TEST_ASSERT_EQUAL_UINT(DEFAULT_POLL_TIME, p_BCPeriodicPoller->groups[0].periodMs);
+}
+
+void test_coincident_rates_are_served_in_one_wake_up(void) {
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 10, 0);
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[1], BC_READ_GAS_FLOW, 10, 0);
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[2], BC_READ_CIRCUIT_PRESSURE, 20, 0);
+
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    BCPeriodicPoller_run(p_BCPeriodicPoller, 10);
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+
+    // One display update per wake-up, however many groups fired in it
+    TEST_ASSERT_EQUAL_UINT(10, BCPeriodicPoller_getWakeups(p_BCPeriodicPoller));
+    TEST_ASSERT_EQUAL_UINT(10, MedicalDisplay_getUpdates(p_MedicalDisplay));
+    TEST_ASSERT_EQUAL_UINT(BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0),
+                           BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 1));
+    TEST_ASSERT_TRUE(BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0) >= 9);
+    TEST_ASSERT_UINT_WITHIN(1, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0) / 2,
+                            BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 2));
+}
+
+void test_phase_offsets_a_rate_into_its_own_wake_ups(void) {
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 20, 0);
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[1], BC_READ_GAS_FLOW, 20, 10);
+
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    for (int i = 0; i < 6; i++) {
+        // Never both at once: every wake-up serves exactly one device
+        TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 1000));
+        TEST_ASSERT_EQUAL_UINT(i % 2 == 0, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0) >
+                                           BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 1));
+    }
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+    TEST_ASSERT_EQUAL_UINT(3, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0));
+    TEST_ASSERT_EQUAL_UINT(3, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 1));
+}
+
+void test_late_service_reports_missed_deadlines(void) {
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 10, 0);
+
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    sleepMs(55);  // releases at 0, 10, ..., 50 go unserved
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 1000));
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+
+    // The late wake-up polls once; the other releases count as missed
+    TEST_ASSERT_EQUAL_UINT(1, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0));
+    TEST_ASSERT_TRUE(BCPeriodicPoller_getMissedDeadlines(p_BCPeriodicPoller) >= 4);
+    TEST_ASSERT_EQUAL_UINT(BCPeriodicPoller_getMissedDeadlines(p_BCPeriodicPoller),
+                           p_BCPeriodicPoller->groups[0].missedDeadlines);
+    TEST_ASSERT_EQUAL_UINT(p_BCPeriodicPoller->groups[0].missedDeadlines + 1, p_BCPeriodicPoller->groups[0].releases);
+}
+
+void test_removed_devices_are_no_longer_polled(void) {
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 10, 0);
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[1], BC_READ_GAS_FLOW, 10, 0);
+    BCPeriodicPoller_removeItsBreathingCircuitSensor(p_BCPeriodicPoller, sensors[0]);
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_getItsBreathingCircuitSensor(p_BCPeriodicPoller));
+
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 1000));
+    TEST_ASSERT_EQUAL_UINT(0, BCPeriodicPoller_getDevicePolls(p_BCPeriodicPoller, 0));
+
+    BCPeriodicPoller_clearItsBreathingCircuitSensor(p_BCPeriodicPoller);
+    TEST_ASSERT_EQUAL_INT(0, BCPeriodicPoller_getGroupCount(p_BCPeriodicPoller));
+    TEST_ASSERT_EQUAL_INT(0, BCTimer_getGroupCount(p_BCTimer));
+    TEST_ASSERT_EQUAL_INT(0, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 30));
+
+    // A rate added while polling joins the running timer
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[2], BC_READ_CIRCUIT_PRESSURE, 5, 0);
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 1000));
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+}
+
+void test_stopped_poller_times_out(void) {
+    BCPeriodicPoller_addDevice(p_BCPeriodicPoller, sensors[0], BC_READ_O2_CONCENTRATION, 10, 0);
+    BCPeriodicPoller_startPolling(p_BCPeriodicPoller);
+    TEST_ASSERT_EQUAL_INT(1, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 1000));
+    BCPeriodicPoller_stopPolling(p_BCPeriodicPoller);
+
+    TEST_ASSERT_EQUAL_INT(0, BCPeriodicPoller_runOnce(p_BCPeriodicPoller, 30));
+    BCPeriodicPoller_run(p_BCPeriodicPoller, 0);  // returns at once when stopped
+    TEST_ASSERT_EQUAL_UINT(1, BCPeriodicPoller_getWakeups(p_BCPeriodicPoller));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_devices_sharing_period_and_phase_share_a_group);
+    RUN_TEST(test_device_table_grows_past_its_initial_size);
+    RUN_TEST(test_bad_devices_and_too_many_rates_are_rejected);
+    RUN_TEST(test_manual_poll_reads_every_device_into_one_display_update);
+    RUN_TEST(test_frame_carries_the_legacy_field_mapping);
+    RUN_TEST(test_coincident_rates_are_served_in_one_wake_up);
+    RUN_TEST(test_phase_offsets_a_rate_into_its_own_wake_ups);
+    RUN_TEST(test_late_service_reports_missed_deadlines);
+    RUN_TEST(test_removed_devices_are_no_longer_polled);
+    RUN_TEST(test_stopped_poller_times_out);
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "BCPeriodicPoller.h"
+#include "BCTimer.h"
+#include "BreathingCircuitSensor.h"
+#include "MedicalDisplay.h"
+
+/*
+    Serves 10 to 10,000 devices spread over four rates (1, 2, 5 and 10 ms)
+    and every phase of each, 18 timer groups in all, for RUN_MS. Reports the
+    wake-ups, display updates, missed deadlines and the CPU spent per wake-up.
+*/
+
+#define RUN_MS 500
+#define MAX_DEVICES 10000
+
+static const unsigned long periods[] = {1, 2, 5, 10};
+
+static BreathingCircuitSensor sensors[MAX_DEVICES];
+
+static double seconds(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void run(int devices) {
+    BCPeriodicPoller* poller = BCPeriodicPoller_Create();
+    BCTimer* timer = BCTimer_Create();
+    MedicalDisplay* display = MedicalDisplay_Create();
+    unsigned long polls = 0;
+    double start;
+    double cpuStart;
+    double elapsed;
+    double cpu;
+
+    MedicalDisplay_setEcho(display, 0);
+    BCPeriodicPoller_setItsBCTimer(poller, timer);
+    BCPeriodicPoller_setItsMedicalDisplay(poller, display);
+    for (int i = 0; i < devices; i++) {
+        unsigned long period = periods[i % 4];
+        BreathingCircuitSensor_Init(&sensors[i]);
+        sensors[i].data = i;
+        TEST_ASSERT_EQUAL_INT(i, BCPeriodicPoller_addDevice(poller, &sensors[i], (BCReading)(i % 3), period,
+                                                            (unsigned long)(i / 4) % period));
+    }
+
+    start = seconds(CLOCK_MONOTONIC);
+    cpuStart = seconds(CLOCK_PROCESS_CPUTIME_ID);
+    BCPeriodicPoller_startPolling(poller);
+    do {
+        int n = BCPeriodicPoller_runOnce(poller, 100);
+        TEST_ASSERT_TRUE(n >= 0);
+        polls += (unsigned long)n;
+    } while ((elapsed = seconds(CLOCK_MONOTONIC) - start) < RUN_MS / 1e3);
+    BCPeriodicPoller_stopPolling(poller);
+    cpu = seconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+
+    TEST_ASSERT_EQUAL_UINT(BCPeriodicPoller_getWakeups(poller), MedicalDisplay_getUpdates(display));
+    printf("  %8d %7d %8lu %12.0f %8lu %7.1f%% %10.2f\n", devices, BCPeriodicPoller_getGroupCount(poller),
+           BCPeriodicPoller_getWakeups(poller), (double)polls / elapsed, BCPeriodicPoller_getMissedDeadlines(poller),
+           100.0 * cpu / elapsed, 1e6 * cpu / (double)BCPeriodicPoller_getWakeups(poller));
+
+    BCPeriodicPoller_Destroy(poller);
+    BCTimer_Destroy(timer);
+    MedicalDisplay_Destroy(display);
+}
+
+void test_polling_cost_by_device_count(void) {
+    static const int deviceCounts[] = {10, 100, 1000, 10000};
+
+    printf("\n  %8s %7s %8s %12s %8s %8s %10s\n", "devices", "groups", "wakeups", "polls/s", "missed", "CPU",
+           "us/wakeup");
+    for (size_t i = 0; i < sizeof(deviceCounts) / sizeof(deviceCounts[0]); i++) {
+        run(deviceCounts[i]);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_polling_cost_by_device_count);
+    return UNITY_END();
+}
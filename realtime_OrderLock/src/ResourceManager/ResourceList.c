@@ -4,58 +4,294 @@
 
 #include "ResourceList.h"
 #include "Mutex.h"
+#include <sched.h>
+#include <stdlib.h>
 
-static char isInOrder(ResourceList* const me, int rID);
+/* IDs the calling thread holds in one ResourceList. A slot with no IDs is free */
+typedef struct HeldLocks HeldLocks;
+struct HeldLocks {
+    const ResourceList* owner;
+    int nIDs;
+    int rIDList[RESOURCE_LIST_MAX_HELD];
+    unsigned long long locked;  /* bit rID: its mutex was taken by acquire_set */
+};
+
+static __thread HeldLocks heldLists[RESOURCE_LIST_MAX_LISTS];
+
+static const HeldLocks noneHeld;
+
+static HeldLocks* findHeld(const ResourceList* const me);
+
+static HeldLocks* claimHeld(const ResourceList* const me);
+
+static char isInOrder(ResourceList* const me, const HeldLocks* held, int rID);
+
+static char isHeld(const HeldLocks* held, int rID);
+
+static char reaches(const ResourceList* const me, int from, int to);
+
+static void recordOrder(ResourceList* const me, const HeldLocks* held, int rID);
+
+static void backoff(int round);
 
 static void cleanUpRelations(ResourceList* const me);
 
 void ResourceList_Init(ResourceList* const me) {
-    me->nIDs = 0;
+    int j;
+
+    for (j=0; j<RESOURCE_LIST_MAX_RESOURCES; j++) {
+        pthread_mutex_init(&me->resourceLocks[j], NULL);
+        me->orderGraph[j] = 0;
+    }
+    me->trackOrder = 0;
+    me->potentialDeadlocks = 0;
+    me->backoffs = 0;
     me->itsMutex = NULL;
 }
 
 void ResourceList_Cleanup(ResourceList* const me) {
+    int j;
+
+    for (j=0; j<RESOURCE_LIST_MAX_RESOURCES; j++)
+        pthread_mutex_destroy(&me->resourceLocks[j]);
     cleanUpRelations(me);
 }
 
 int ResourceList_addLock(ResourceList* const me, int rID) {
+    HeldLocks* held = claimHeld(me);
     int retVal;
-    Mutex_lock(me->itsMutex);
-    if (isInOrder(me,rID)) {
-        me->rIDList[me->nIDs++] = rID;
-        retVal = 0;
-    }
+    if (held == NULL || held->nIDs >= RESOURCE_LIST_MAX_HELD)
+        retVal = RESOURCE_LIST_TOO_MANY_LOCKS;
     else
-    if (rID == me->rIDList[me->nIDs])
+    if (isHeld(held, rID))
         retVal = DUPLICATED_IDS;
+    else
+    if (isInOrder(me, held, rID)) {
+        recordOrder(me, held, rID);
+        held->rIDList[held->nIDs++] = rID;
+        retVal = 0;
+    }
     else
         retVal = POORLY_ORDERED_ACCESS;
-    Mutex_release(me->itsMutex);
     return retVal;
 }
 
 void ResourceList_removeLock(ResourceList* const me, int rID) {
+    HeldLocks* held = findHeld(me);
     int j,k;
 
-    if (me->nIDs) {
-        for (j=0; j<me->nIDs; j++) {
-            if (rID == me->rIDList[j]) {
-                for (k=j; k<me->nIDs-1; k++)
-                    me->rIDList[k] = me->rIDList[k+1];
-                --me->nIDs;
+    if (held != NULL) {
+        for (j=0; j<held->nIDs; j++) {
+            if (rID == held->rIDList[j]) {
+                for (k=j; k<held->nIDs-1; k++)
+                    held->rIDList[k] = held->rIDList[k+1];
+                --held->nIDs;
+                if (rID >= 0 && rID < RESOURCE_LIST_MAX_RESOURCES)
+                    held->locked &= ~(1ull << rID);
                 break;
             };
         };
     };
 }
 
-static char isInOrder(ResourceList* const me, int rID) {
-    if (me->nIDs)
-        return rID > me->rIDList[me->nIDs-1];
+int ResourceList_acquire_set(ResourceList* const me, const int* ids, int n) {
+    HeldLocks* held = claimHeld(me);
+    int sorted[RESOURCE_LIST_MAX_HELD];
+    int highest = -1;
+    int got, round, j, k;
+
+    if (held == NULL || n < 0 || n > RESOURCE_LIST_MAX_HELD - held->nIDs)
+        return RESOURCE_LIST_TOO_MANY_LOCKS;
+
+    /* sort into the global order */
+    for (j=0; j<n; j++) {
+        int rID = ids[j];
+        if (rID < 0 || rID >= RESOURCE_LIST_MAX_RESOURCES)
+            return RESOURCE_LIST_UNKNOWN_ID;
+        for (k=j; k>0 && sorted[k-1] > rID; k--)
+            sorted[k] = sorted[k-1];
+        sorted[k] = rID;
+    }
+    for (j=0; j<n; j++) {
+        if ((j > 0 && sorted[j] == sorted[j-1]) || isHeld(held, sorted[j]))
+            return DUPLICATED_IDS;
+    }
+
+    /* the whole set must come after what the thread already holds */
+    for (j=0; j<held->nIDs; j++)
+        if (held->rIDList[j] > highest)
+            highest = held->rIDList[j];
+    if (n > 0 && sorted[0] < highest)
+        return POORLY_ORDERED_ACCESS;
+    if (me->trackOrder) {
+        for (j=0; j<n; j++) {
+            if (!isInOrder(me, held, sorted[j]))
+                return POORLY_ORDERED_ACCESS;
+            for (k=0; k<j; k++) {
+                if (reaches(me, sorted[j], sorted[k])) {
+                    __atomic_fetch_add(&me->potentialDeadlocks, 1, __ATOMIC_RELAXED);
+                    return POORLY_ORDERED_ACCESS;
+                }
+            }
+        }
+    }
+
+    for (round=0; round<RESOURCE_LIST_TRYLOCK_ROUNDS; round++) {
+        got = 0;
+        while (got < n && pthread_mutex_trylock(&me->resourceLocks[sorted[got]]) == 0)
+            got++;
+        if (got == n)
+            break;
+        /* hold nothing while waiting, so a busy set never blocks others */
+        while (got > 0)
+            pthread_mutex_unlock(&me->resourceLocks[sorted[--got]]);
+        __atomic_fetch_add(&me->backoffs, 1, __ATOMIC_RELAXED);
+        backoff(round);
+    }
+    if (round == RESOURCE_LIST_TRYLOCK_ROUNDS) {
+        for (j=0; j<n; j++)
+            pthread_mutex_lock(&me->resourceLocks[sorted[j]]);
+    }
+
+    for (j=0; j<n; j++) {
+        recordOrder(me, held, sorted[j]);
+        held->rIDList[held->nIDs++] = sorted[j];
+        held->locked |= 1ull << sorted[j];
+    }
+    return 0;
+}
+
+void ResourceList_release_set(ResourceList* const me, const int* ids, int n) {
+    HeldLocks* held = findHeld(me);
+    int j;
+
+    /* only mutexes acquire_set took: IDs from addLock were never locked */
+    for (j=0; held != NULL && j<n; j++) {
+        int rID = ids[j];
+        if (rID >= 0 && rID < RESOURCE_LIST_MAX_RESOURCES && (held->locked & (1ull << rID))) {
+            ResourceList_removeLock(me, rID);
+            pthread_mutex_unlock(&me->resourceLocks[rID]);
+        }
+    }
+}
+
+int ResourceList_getHeld(const ResourceList* const me, int* ids, int max) {
+    const HeldLocks* held = findHeld(me);
+    int j;
+
+    if (held == NULL)
+        held = &noneHeld;
+    for (j=0; j<held->nIDs && j<max; j++)
+        ids[j] = held->rIDList[j];
+    return held->nIDs;
+}
+
+void ResourceList_setOrderTracking(ResourceList* const me, int enabled) {
+    me->trackOrder = enabled;
+}
+
+unsigned long ResourceList_getPotentialDeadlocks(const ResourceList* const me) {
+    return __atomic_load_n(&me->potentialDeadlocks, __ATOMIC_RELAXED);
+}
+
+/* Without order tracking IDs must increase. With it, any order is fine */
+/* unless the graph already has a path back from rID to a held ID. */
+static char isInOrder(ResourceList* const me, const HeldLocks* held, int rID) {
+    int j;
+
+    if (me->trackOrder && rID >= 0 && rID < RESOURCE_LIST_MAX_RESOURCES) {
+        for (j=0; j<held->nIDs; j++) {
+            if (reaches(me, rID, held->rIDList[j])) {
+                __atomic_fetch_add(&me->potentialDeadlocks, 1, __ATOMIC_RELAXED);
+                return 0;
+            }
+        }
+        return 1;
+    }
+    if (held->nIDs)
+        return rID > held->rIDList[held->nIDs-1];
     else
         return 1;
 }
 
+static char isHeld(const HeldLocks* held, int rID) {
+    int j;
+
+    for (j=0; j<held->nIDs; j++)
+        if (held->rIDList[j] == rID)
+            return 1;
+    return 0;
+}
+
+/* The calling thread's slot for this list, or NULL if it holds nothing in it */
+static HeldLocks* findHeld(const ResourceList* const me) {
+    int j;
+
+    for (j=0; j<RESOURCE_LIST_MAX_LISTS; j++)
+        if (heldLists[j].nIDs > 0 && heldLists[j].owner == me)
+            return &heldLists[j];
+    return NULL;
+}
+
+/* As findHeld, taking a free slot if needed; NULL if the thread has none left */
+static HeldLocks* claimHeld(const ResourceList* const me) {
+    HeldLocks* held = findHeld(me);
+    int j;
+
+    for (j=0; held == NULL && j<RESOURCE_LIST_MAX_LISTS; j++) {
+        if (heldLists[j].nIDs == 0) {
+            held = &heldLists[j];
+            held->owner = me;
+            held->locked = 0;
+        }
+    }
+    return held;
+}
+
+/* Breadth-first walk of the order graph, one bit per resource */
+static char reaches(const ResourceList* const me, int from, int to) {
+    unsigned long long seen = 0;
+    unsigned long long frontier;
+    int j;
+
+    if (to < 0 || to >= RESOURCE_LIST_MAX_RESOURCES)
+        return 0;
+    frontier = 1ull << from;
+    while (frontier) {
+        unsigned long long next = 0;
+        if (frontier & (1ull << to))
+            return 1;
+        seen |= frontier;
+        for (j=0; j<RESOURCE_LIST_MAX_RESOURCES; j++)
+            if (frontier & (1ull << j))
+                next |= __atomic_load_n(&me->orderGraph[j], __ATOMIC_RELAXED);
+        frontier = next & ~seen;
+    }
+    return 0;
+}
+
+/* Every ID the thread holds now comes before rID */
+static void recordOrder(ResourceList* const me, const HeldLocks* held, int rID) {
+    int j;
+
+    if (!me->trackOrder || rID < 0 || rID >= RESOURCE_LIST_MAX_RESOURCES)
+        return;
+    for (j=0; j<held->nIDs; j++) {
+        int h = held->rIDList[j];
+        if (h >= 0 && h < RESOURCE_LIST_MAX_RESOURCES)
+            __atomic_fetch_or(&me->orderGraph[h], 1ull << rID, __ATOMIC_RELAXED);
+    }
+}
+
+/* Spin for 2^round short loops, then let other threads run */
+static void backoff(int round) {
+    volatile unsigned int spin;
+
+    for (spin=0; spin < (16u << round); spin++) {
+    }
+    sched_yield();
+}
+
 struct Mutex* ResourceList_getItsMutex(const ResourceList* const me) {
     return (struct Mutex*)me->itsMutex;
 }
@@ -80,4 +316,4 @@ void ResourceList_Destroy(ResourceList* const me) {
 static void cleanUpRelations(ResourceList* const me) {
     if(me->itsMutex != NULL)
         me->itsMutex = NULL;
-}
\ No newline at end of file
+}
@@ -5,14 +5,43 @@
 #ifndef REALTIME_ORDERLOCK_RESOURCELIST_H
 #define REALTIME_ORDERLOCK_RESOURCELIST_H
 
+#include <pthread.h>
 #include "Mutex.h"
 
+/* Resource IDs are global: 0 .. RESOURCE_LIST_MAX_RESOURCES - 1 */
+#define RESOURCE_LIST_MAX_RESOURCES 64
+/* Locks one thread may hold at a time in one list */
+#define RESOURCE_LIST_MAX_HELD 32
+/* Lists one thread may hold locks in at a time */
+#define RESOURCE_LIST_MAX_LISTS 8
+/* Try-lock rounds in acquire_set before it falls back to blocking, still in order */
+#define RESOURCE_LIST_TRYLOCK_ROUNDS 8
+
+/* Error codes beyond POORLY_ORDERED_ACCESS and DUPLICATED_IDS */
+#define RESOURCE_LIST_TOO_MANY_LOCKS (-1)
+#define RESOURCE_LIST_UNKNOWN_ID (-2)
+
 struct Mutex;
 
+/*
+ * The list of held resource IDs is kept per thread and per ResourceList,
+ * so one thread's locks never make another thread's order check fail,
+ * locks in one list never constrain another list, and removeLock needs
+ * no shared mutex.
+ *
+ * With order tracking on, every acquisition also records "held before"
+ * edges in a lock-order graph shared by all threads. addLock then accepts
+ * any order the graph has not seen reversed, and reports an order that
+ * would close a cycle (a potential deadlock) instead of a strictly
+ * increasing ID check.
+ */
 typedef struct ResourceList ResourceList;
 struct ResourceList {
-    int nIDs;
-    int rIDList[20];
+    pthread_mutex_t resourceLocks[RESOURCE_LIST_MAX_RESOURCES];   /* taken by acquire_set */
+    unsigned long long orderGraph[RESOURCE_LIST_MAX_RESOURCES];   /* bit j of row i: j taken while i held */
+    int trackOrder;
+    unsigned long potentialDeadlocks;   /* orders rejected because they close a cycle */
+    unsigned long backoffs;             /* acquire_set rounds that found a lock busy */
     struct Mutex* itsMutex;
 };
 
@@ -30,6 +59,25 @@ int ResourceList_addLock(ResourceList* const me, int rID);
 /*    lower in the list. */
 void ResourceList_removeLock(ResourceList* const me, int rID);
 
+/*    Locks every resource in ids, in increasing ID order whatever */
+/*    the order of ids. Busy locks are tried again after backing off */
+/*    with nothing held; after RESOURCE_LIST_TRYLOCK_ROUNDS rounds the */
+/*    locks are simply waited for, which the global order keeps */
+/*    deadlock-free. IDs must be above any the thread already holds. */
+/*    Returns 0, or an error code with nothing new held. */
+int ResourceList_acquire_set(ResourceList* const me, const int* ids, int n);
+
+/*    Unlocks a set taken by acquire_set, in any order. IDs that */
+/*    were only added with addLock are left for removeLock. */
+void ResourceList_release_set(ResourceList* const me, const int* ids, int n);
+
+/*    IDs the calling thread holds, in the order they were added */
+int ResourceList_getHeld(const ResourceList* const me, int* ids, int max);
+
+void ResourceList_setOrderTracking(ResourceList* const me, int enabled);
+
+unsigned long ResourceList_getPotentialDeadlocks(const ResourceList* const me);
+
 struct Mutex* ResourceList_getItsMutex(const ResourceList* const me);
 
 void ResourceList_setItsMutex(ResourceList* const me, struct Mutex* p_Mutex);
@@ -0,0 +1,260 @@
+#include <unity.h>
+#include <pthread.h>
+#include "ResourceList.h"
+
+#define STRESS_THREADS 4
+#define STRESS_ROUNDS 20000u
+#define STRESS_RESOURCES 8
+
+// Test fixtures
+ResourceList* p_ResourceList;
+
+void setUp(void) {
+    p_ResourceList = ResourceList_Create();
+}
+
+void tearDown(void) {
+    ResourceList_Destroy(p_ResourceList);
+}
+
+/* True when another thread cannot take the resource right now */
+typedef struct {
+    ResourceList* list;
+    int rID;
+    int busy;
+} Probe;
+
+static void* probe(void* arg) {
+    Probe* p = (Probe*)arg;
+
+    p->busy = 1;
+    if (pthread_mutex_trylock(&p->list->resourceLocks[p->rID]) == 0) {
+        pthread_mutex_unlock(&p->list->resourceLocks[p->rID]);
+        p->busy = 0;
+    }
+    return NULL;
+}
+
+static int lockedElsewhere(int rID) {
+    pthread_t t;
+    Probe p = {p_ResourceList, rID, 0};
+
+    pthread_create(&t, NULL, probe, &p);
+    pthread_join(t, NULL);
+    return p.busy;
+}
+
+void test_acquire_set_sorts_and_locks_every_resource(void) {
+    int ids[3] = {5, 1, 3};
+    int heldIDs[4];
+
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_acquire_set(p_ResourceList, ids, 3));
+    TEST_ASSERT_EQUAL_INT(3, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+    TEST_ASSERT_EQUAL_INT(1, heldIDs[0]);
+    TEST_ASSERT_EQUAL_INT(3, heldIDs[1]);
+    TEST_ASSERT_EQUAL_INT(5, heldIDs[2]);
+    TEST_ASSERT_TRUE(lockedElsewhere(1));
+    TEST_ASSERT_TRUE(lockedElsewhere(5));
+    TEST_ASSERT_FALSE(lockedElsewhere(2));
+
+    ResourceList_release_set(p_ResourceList, ids, 3);
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+    TEST_ASSERT_FALSE(lockedElsewhere(3));
+}
+
+void test_acquire_set_rejects_bad_sets_holding_nothing_new(void) {
+    int dup[2] = {4, 4};
+    int unknown[2] = {1, RESOURCE_LIST_MAX_RESOURCES};
+    int high[1] = {9};
+    int low[2] = {2, 12};
+    int heldIDs[4];
+
+    TEST_ASSERT_EQUAL_INT(DUPLICATED_IDS, ResourceList_acquire_set(p_ResourceList, dup, 2));
+    TEST_ASSERT_EQUAL_INT(RESOURCE_LIST_UNKNOWN_ID, ResourceList_acquire_set(p_ResourceList, unknown, 2));
+    TEST_ASSERT_EQUAL_INT(RESOURCE_LIST_TOO_MANY_LOCKS,
+                          ResourceList_acquire_set(p_ResourceList, high, RESOURCE_LIST_MAX_HELD + 1));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+
+    // Holding 9, a set reaching below it would break the global order
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_acquire_set(p_ResourceList, high, 1));
+    TEST_ASSERT_EQUAL_INT(POORLY_ORDERED_ACCESS, ResourceList_acquire_set(p_ResourceList, low, 2));
+    TEST_ASSERT_EQUAL_INT(1, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+    TEST_ASSERT_FALSE(lockedElsewhere(12));
+    ResourceList_release_set(p_ResourceList, high, 1);
+}
+
+/* Thread B's order check must not see thread A's locks */
+static void* addLowLock(void* arg) {
+    ResourceList* list = (ResourceList*)arg;
+    int status = ResourceList_addLock(list, 2);
+    ResourceList_removeLock(list, 2);
+    return (void*)(long)status;
+}
+
+void test_held_lists_are_per_thread(void) {
+    pthread_t other;
+    void* status;
+
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 7));
+    pthread_create(&other, NULL, addLowLock, p_ResourceList);
+    pthread_join(other, &status);
+    TEST_ASSERT_EQUAL_INT(0, (int)(long)status);
+
+    TEST_ASSERT_EQUAL_INT(POORLY_ORDERED_ACCESS, ResourceList_addLock(p_ResourceList, 2));
+    TEST_ASSERT_EQUAL_INT(DUPLICATED_IDS, ResourceList_addLock(p_ResourceList, 7));
+    ResourceList_removeLock(p_ResourceList, 7);
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 2));
+    ResourceList_removeLock(p_ResourceList, 2);
+}
+
+/* Locks held in one list do not order or show up in another */
+void test_held_lists_are_per_list(void) {
+    ResourceList* other = ResourceList_Create();
+    int heldIDs[4];
+
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 7));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(other, 2));
+    TEST_ASSERT_EQUAL_INT(1, ResourceList_getHeld(other, heldIDs, 4));
+    TEST_ASSERT_EQUAL_INT(2, heldIDs[0]);
+    TEST_ASSERT_EQUAL_INT(1, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+    TEST_ASSERT_EQUAL_INT(7, heldIDs[0]);
+
+    ResourceList_removeLock(p_ResourceList, 7);
+    ResourceList_removeLock(other, 2);
+    ResourceList_Destroy(other);
+}
+
+/* release_set only unlocks what acquire_set locked */
+void test_release_set_skips_ids_from_add_lock(void) {
+    int set[2] = {5, 6};
+    int all[3] = {2, 5, 6};
+    int heldIDs[4];
+
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 2));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_acquire_set(p_ResourceList, set, 2));
+    TEST_ASSERT_FALSE(lockedElsewhere(2));
+    TEST_ASSERT_TRUE(lockedElsewhere(5));
+
+    ResourceList_release_set(p_ResourceList, all, 3);
+    TEST_ASSERT_EQUAL_INT(1, ResourceList_getHeld(p_ResourceList, heldIDs, 4));
+    TEST_ASSERT_EQUAL_INT(2, heldIDs[0]);
+    TEST_ASSERT_FALSE(lockedElsewhere(5));
+    TEST_ASSERT_FALSE(lockedElsewhere(6));
+    ResourceList_removeLock(p_ResourceList, 2);
+}
+
+void test_add_lock_stops_at_the_held_limit(void) {
+    int heldIDs[RESOURCE_LIST_MAX_HELD];
+
+    for (int rID = 0; rID < RESOURCE_LIST_MAX_HELD; rID++) {
+        TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, rID));
+    }
+    TEST_ASSERT_EQUAL_INT(RESOURCE_LIST_TOO_MANY_LOCKS, ResourceList_addLock(p_ResourceList, 100));
+    for (int rID = RESOURCE_LIST_MAX_HELD - 1; rID >= 0; rID -= 2) {
+        ResourceList_removeLock(p_ResourceList, rID);   // any removal order
+    }
+    for (int rID = 0; rID < RESOURCE_LIST_MAX_HELD; rID += 2) {
+        ResourceList_removeLock(p_ResourceList, rID);
+    }
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_getHeld(p_ResourceList, heldIDs, RESOURCE_LIST_MAX_HELD));
+}
+
+void test_order_graph_allows_consistent_orders_and_flags_cycles(void) {
+    int set[2] = {1, 3};
+
+    ResourceList_setOrderTracking(p_ResourceList, 1);
+
+    // 3 then 1 is fine while nothing has taken them the other way round
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 3));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 1));
+    ResourceList_removeLock(p_ResourceList, 1);
+    ResourceList_removeLock(p_ResourceList, 3);
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 3));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 1));
+    ResourceList_removeLock(p_ResourceList, 1);
+    ResourceList_removeLock(p_ResourceList, 3);
+    TEST_ASSERT_EQUAL_UINT(0, ResourceList_getPotentialDeadlocks(p_ResourceList));
+
+    // 1 then 3 would close the cycle 1 -> 3 -> 1
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 1));
+    TEST_ASSERT_EQUAL_INT(POORLY_ORDERED_ACCESS, ResourceList_addLock(p_ResourceList, 3));
+    ResourceList_removeLock(p_ResourceList, 1);
+    TEST_ASSERT_EQUAL_UINT(1, ResourceList_getPotentialDeadlocks(p_ResourceList));
+
+    // So would acquire_set, which always goes 1 then 3
+    TEST_ASSERT_EQUAL_INT(POORLY_ORDERED_ACCESS, ResourceList_acquire_set(p_ResourceList, set, 2));
+    TEST_ASSERT_EQUAL_UINT(2, ResourceList_getPotentialDeadlocks(p_ResourceList));
+}
+
+void test_order_graph_follows_paths(void) {
+    ResourceList_setOrderTracking(p_ResourceList, 1);
+
+    // 10 -> 20 and 20 -> 30 make 30 then 10 a cycle through 20
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 10));
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 20));
+    ResourceList_removeLock(p_ResourceList, 10);
+    TEST_ASSERT_EQUAL_INT(0, ResourceList_addLock(p_ResourceList, 30));
+    ResourceList_removeLock(p_ResourceList, 20);
+    TEST_ASSERT_EQUAL_INT(POORLY_ORDERED_ACCESS, ResourceList_addLock(p_ResourceList, 10));
+    ResourceList_removeLock(p_ResourceList, 30);
+}
+
+/* Stress: overlapping sets; a counter per resource checks mutual exclusion */
+static unsigned long counters[STRESS_RESOURCES];
+
+static void* stressWorker(void* arg) {
+    ResourceList* list = (ResourceList*)arg;
+    unsigned int state = (unsigned int)(unsigned long)pthread_self();
+
+    for (unsigned int round = 0; round < STRESS_ROUNDS; round++) {
+        int ids[3];
+        for (int j = 0; j < 3; j++) {
+            state = state * 1103515245u + 12345u;
+            ids[j] = (int)((state >> 16) % STRESS_RESOURCES);
+        }
+        if (ids[1] == ids[0]) ids[1] = (ids[0] + 1) % STRESS_RESOURCES;
+        while (ids[2] == ids[0] || ids[2] == ids[1]) ids[2] = (ids[2] + 1) % STRESS_RESOURCES;
+
+        if (ResourceList_acquire_set(list, ids, 3) != 0) {
+            return (void*)1;
+        }
+        for (int j = 0; j < 3; j++) {
+            unsigned long c = counters[ids[j]];
+            counters[ids[j]] = c + 1;
+        }
+        ResourceList_release_set(list, ids, 3);
+    }
+    return NULL;
+}
+
+void test_overlapping_sets_never_deadlock(void) {
+    pthread_t threads[STRESS_THREADS];
+    unsigned long total = 0;
+
+    for (int i = 0; i < STRESS_THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, stressWorker, p_ResourceList));
+    }
+    for (int i = 0; i < STRESS_THREADS; i++) {
+        void* status;
+        pthread_join(threads[i], &status);
+        TEST_ASSERT_NULL(status);
+    }
+    for (int r = 0; r < STRESS_RESOURCES; r++) {
+        total += counters[r];
+    }
+    TEST_ASSERT_EQUAL_UINT(3ul * STRESS_THREADS * STRESS_ROUNDS, total);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_acquire_set_sorts_and_locks_every_resource);
+    RUN_TEST(test_acquire_set_rejects_bad_sets_holding_nothing_new);
+    RUN_TEST(test_held_lists_are_per_thread);
+    RUN_TEST(test_held_lists_are_per_list);
+    RUN_TEST(test_release_set_skips_ids_from_add_lock);
+    RUN_TEST(test_add_lock_stops_at_the_held_limit);
+    RUN_TEST(test_order_graph_allows_consistent_orders_and_flags_cycles);
+    RUN_TEST(test_order_graph_follows_paths);
+    RUN_TEST(test_overlapping_sets_never_deadlock);
+    return UNITY_END();
+}
@@ -0,0 +1,214 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "ResourceList.h"
+
+/*
+    Throughput of threads locking random 3-resource sets out of 16, with
+    acquire_set against the old check-and-fail scheme: lock each resource
+    in increasing ID order, check it with addLock against one list shared
+    by every thread, and on POORLY_ORDERED_ACCESS release everything and
+    start over.
+*/
+
+#define OPS_PER_RUN 200000u
+#define RESOURCES 16
+#define SET_SIZE 3
+#define MAX_THREADS 8
+
+/* reference: the shared, mutex-guarded ID list */
+typedef struct {
+    pthread_mutex_t itsMutex;
+    pthread_mutex_t resourceLocks[RESOURCES];
+    int nIDs;
+    int rIDList[20];
+} SharedList;
+
+static int sharedAddLock(SharedList* me, int rID) {
+    int retVal = 0;
+    pthread_mutex_lock(&me->itsMutex);
+    if (me->nIDs == 0 || rID > me->rIDList[me->nIDs - 1])
+        me->rIDList[me->nIDs++] = rID;
+    else
+        retVal = POORLY_ORDERED_ACCESS;
+    pthread_mutex_unlock(&me->itsMutex);
+    return retVal;
+}
+
+static void sharedRemoveLock(SharedList* me, int rID) {
+    pthread_mutex_lock(&me->itsMutex);
+    for (int j = 0; j < me->nIDs; j++) {
+        if (me->rIDList[j] == rID) {
+            for (int k = j; k < me->nIDs - 1; k++)
+                me->rIDList[k] = me->rIDList[k + 1];
+            --me->nIDs;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&me->itsMutex);
+}
+
+typedef struct {
+    ResourceList* list;
+    SharedList* shared;
+    unsigned int ops;
+    unsigned int seed;
+    unsigned long failures;
+} Worker;
+
+static unsigned long counters[RESOURCES];
+
+static void pickSet(unsigned int* state, int* ids) {
+    for (int j = 0; j < SET_SIZE; j++) {
+        int rID;
+        int fresh;
+        do {
+            *state = *state * 1103515245u + 12345u;
+            rID = (int)((*state >> 16) % RESOURCES);
+            fresh = 1;
+            for (int k = 0; k < j; k++)
+                fresh &= ids[k] != rID;
+        } while (!fresh);
+        ids[j] = rID;
+    }
+}
+
+static void sortSet(int* ids) {
+    for (int j = 1; j < SET_SIZE; j++)
+        for (int k = j; k > 0 && ids[k - 1] > ids[k]; k--) {
+            int t = ids[k];
+            ids[k] = ids[k - 1];
+            ids[k - 1] = t;
+        }
+}
+
+static void* acquireSetWorker(void* arg) {
+    Worker* w = (Worker*)arg;
+    int ids[SET_SIZE];
+
+    for (unsigned int i = 0; i < w->ops; i++) {
+        pickSet(&w->seed, ids);
+        while (ResourceList_acquire_set(w->list, ids, SET_SIZE) != 0)
+            w->failures++;
+        for (int j = 0; j < SET_SIZE; j++)
+            counters[ids[j]]++;
+        ResourceList_release_set(w->list, ids, SET_SIZE);
+    }
+    return NULL;
+}
+
+static void* checkAndFailWorker(void* arg) {
+    Worker* w = (Worker*)arg;
+    int ids[SET_SIZE];
+
+    for (unsigned int i = 0; i < w->ops; i++) {
+        int got = 0;
+        pickSet(&w->seed, ids);
+        sortSet(ids);
+        while (got < SET_SIZE) {
+            pthread_mutex_lock(&w->shared->resourceLocks[ids[got]]);
+            if (sharedAddLock(w->shared, ids[got]) == 0) {
+                got++;
+                continue;
+            }
+            // Another thread's higher ID is in the shared list: back out and retry
+            pthread_mutex_unlock(&w->shared->resourceLocks[ids[got]]);
+            while (got > 0) {
+                --got;
+                sharedRemoveLock(w->shared, ids[got]);
+                pthread_mutex_unlock(&w->shared->resourceLocks[ids[got]]);
+            }
+            w->failures++;
+            sched_yield();
+        }
+        for (int j = 0; j < SET_SIZE; j++)
+            counters[ids[j]]++;
+        for (int j = SET_SIZE - 1; j >= 0; j--) {
+            sharedRemoveLock(w->shared, ids[j]);
+            pthread_mutex_unlock(&w->shared->resourceLocks[ids[j]]);
+        }
+    }
+    return NULL;
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Returns set acquisitions per second; *failures counts retries and acquire_set backoffs */
+static double run(int threads, int useAcquireSet, unsigned long* failures) {
+    static SharedList shared;
+    ResourceList* list = ResourceList_Create();
+    pthread_t handles[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    unsigned long total = 0;
+    unsigned int ops = OPS_PER_RUN / (unsigned int)threads;
+    double start;
+    double elapsed;
+
+    TEST_ASSERT_NOT_NULL(list);
+    pthread_mutex_init(&shared.itsMutex, NULL);
+    for (int r = 0; r < RESOURCES; r++) {
+        pthread_mutex_init(&shared.resourceLocks[r], NULL);
+        counters[r] = 0;
+    }
+    shared.nIDs = 0;
+
+    start = seconds();
+    for (int t = 0; t < threads; t++) {
+        workers[t] = (Worker){list, &shared, ops, 2024u + (unsigned int)t * 7919u, 0};
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&handles[t], NULL,
+                                                useAcquireSet ? acquireSetWorker : checkAndFailWorker,
+                                                &workers[t]));
+    }
+    *failures = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(handles[t], NULL);
+        *failures += workers[t].failures;
+    }
+    elapsed = seconds() - start;
+    *failures += list->backoffs;
+
+    for (int r = 0; r < RESOURCES; r++)
+        total += counters[r];
+    TEST_ASSERT_EQUAL_UINT((unsigned long)SET_SIZE * ops * (unsigned int)threads, total);
+
+    for (int r = 0; r < RESOURCES; r++)
+        pthread_mutex_destroy(&shared.resourceLocks[r]);
+    pthread_mutex_destroy(&shared.itsMutex);
+    ResourceList_Destroy(list);
+    return (double)ops * threads / elapsed;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_contention_throughput(void) {
+    printf("\n  %ld online CPUs, %d-resource sets out of %d\n", sysconf(_SC_NPROCESSORS_ONLN), SET_SIZE, RESOURCES);
+    printf("  %-8s %20s %14s %18s %14s\n", "threads", "check-and-fail M/s", "retries/op", "acquire_set M/s",
+           "retries/op");
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        unsigned long oldFailures;
+        unsigned long newFailures;
+        double oldRate = run(threads, 0, &oldFailures);
+        double newRate = run(threads, 1, &newFailures);
+        printf("  %-8d %20.2f %14.3f %18.2f %14.3f\n", threads, oldRate / 1e6,
+               (double)oldFailures / OPS_PER_RUN, newRate / 1e6, (double)newFailures / OPS_PER_RUN);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_contention_throughput);
+    return UNITY_END();
+}
@@ -2,57 +2,98 @@
 // Created by mahon on 1/27/2024.
 //
 
+#define _GNU_SOURCE  /* syscall, posix_memalign */
+
 #include "ThreadBarrier.h"
-#include "ThreadBarrier.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#else
+#include <sched.h>
+#endif
+
+/*
+    Sleep while *word still holds value; returns at once if it has
+    changed. Without futexes the waiter just yields and polls.
+*/
+static void futexWait(unsigned int* word, unsigned int value) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    sched_yield();
+#endif
+}
+
+static void futexWake(unsigned int* word, int count) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/* Spinning only pays off when another core can make progress meanwhile */
+static int defaultSpinCount(void) {
+    return sysconf(_SC_NPROCESSORS_ONLN) > 1 ? THREAD_BARRIER_DEFAULT_SPIN : 0;
+}
 
 void ThreadBarrier_Init(ThreadBarrier* const me) {
     me->currentCount = 0;
     me->expectedCount = 3;
-    me->mutex = OSSemaphore_Create();
-    me->barrier = OSSemaphore_Create();
-    if (me->barrier) {
-        OSSemaphore_lock(me->barrier);
-        printf("BARRIER IS LOCKED FIRST TIME\n");
-    };
+    me->generation = 0;
+    me->sleepers = 0;
+    me->spinCount = defaultSpinCount();
 }
 
 void ThreadBarrier_Cleanup(ThreadBarrier* const me) {
-    OSSemaphore_Destroy(me->barrier);
-    OSSemaphore_Destroy(me->mutex);
+    (void)me;
 }
 
 void ThreadBarrier_reset(ThreadBarrier* const me, int x) {
     me->expectedCount = x;
-    me->currentCount = 0;
+    __atomic_store_n(&me->currentCount, 0, __ATOMIC_RELAXED);
 }
 
-void ThreadBarrier_synchronize(ThreadBarrier* const me) {
+int ThreadBarrier_synchronize(ThreadBarrier* const me) {
     /*
-        protect the critical region around
-        the currentCount
+        read the generation before arriving: it cannot move
+        until this thread's arrival has been counted
     */
-    OSSemaphore_lock(me->mutex);
-    ++me->currentCount;     /* critical region */
-    OSSemaphore_release(me->mutex);
+    unsigned int gen = __atomic_load_n(&me->generation, __ATOMIC_ACQUIRE);
+    int spins;
 
-    /*
-        are conditions for unblocking met?
-        if so, then release the first blocked
-        thread or the highest priority blocked
-        thread (depending on the OS)
-     */
-    if (me->currentCount == me->expectedCount) {
-        printf("Conditions met\n");
-        OSSemaphore_release(me->barrier);
-    };
+    if (__atomic_add_fetch(&me->currentCount, 1, __ATOMIC_ACQ_REL) == (unsigned int)me->expectedCount) {
+        /*
+            last to arrive: ready the count for the next round,
+            then open this one
+        */
+        __atomic_store_n(&me->currentCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&me->generation, gen + 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&me->sleepers, __ATOMIC_SEQ_CST) != 0)
+            futexWake(&me->generation, INT_MAX);
+        return THREAD_BARRIER_SERIAL_THREAD;
+    }
 
-    /*
-        lock the semaphore and when released
-        then release it for the next blocked thread
-    */
-    OSSemaphore_lock(me->barrier);
-    OSSemaphore_release(me->barrier);
+    for (spins = 0; spins < me->spinCount; spins++) {
+        if (__atomic_load_n(&me->generation, __ATOMIC_ACQUIRE) != gen)
+            return 0;
+    }
+    __atomic_add_fetch(&me->sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&me->generation, __ATOMIC_SEQ_CST) == gen)
+        futexWait(&me->generation, gen);
+    __atomic_sub_fetch(&me->sleepers, 1, __ATOMIC_RELAXED);
+    return 0;
+}
 
+void ThreadBarrier_setSpinCount(ThreadBarrier* const me, int spins) {
+    me->spinCount = spins;
 }
 
 ThreadBarrier * ThreadBarrier_Create(void) {
@@ -66,4 +107,77 @@ void ThreadBarrier_Destroy(ThreadBarrier* const me) {
     if(me!=NULL)
         ThreadBarrier_Cleanup(me);
     free(me);
-}
\ No newline at end of file
+}
+
+int DisseminationBarrier_Init(DisseminationBarrier* const me, int nThreads) {
+    void* slots = NULL;
+
+    me->nThreads = 0;
+    me->nRounds = 0;
+    me->slots = NULL;
+    if (nThreads < 1 || nThreads > DISSEMINATION_BARRIER_MAX_THREADS)
+        return -1;
+    if (posix_memalign(&slots, 64, (size_t)nThreads * sizeof(DisseminationSlot)) != 0)
+        return -1;
+    memset(slots, 0, (size_t)nThreads * sizeof(DisseminationSlot));
+    me->slots = (DisseminationSlot*)slots;
+    me->nThreads = nThreads;
+    while ((1 << me->nRounds) < nThreads)
+        me->nRounds++;
+    me->spinCount = defaultSpinCount();
+    return 0;
+}
+
+void DisseminationBarrier_Cleanup(DisseminationBarrier* const me) {
+    free(me->slots);
+    me->slots = NULL;
+}
+
+int DisseminationBarrier_synchronize(DisseminationBarrier* const me, int id) {
+    DisseminationSlot* mine = &me->slots[id];
+    unsigned int target = ++mine->episode;     /* signals each flag must have seen */
+    int round;
+
+    for (round = 0; round < me->nRounds; round++) {
+        DisseminationSlot* partner = &me->slots[(id + (1 << round)) % me->nThreads];
+        unsigned int* flag = &mine->flags[round];
+        unsigned int seen;
+        int spins;
+
+        __atomic_add_fetch(&partner->flags[round], 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&partner->sleeping, __ATOMIC_SEQ_CST))
+            futexWake(&partner->flags[round], 1);
+
+        /* counters only grow, so a partner already in the next episode is harmless */
+        for (spins = 0; spins < me->spinCount; spins++) {
+            if ((int)(__atomic_load_n(flag, __ATOMIC_ACQUIRE) - target) >= 0)
+                break;
+        }
+        if (spins == me->spinCount) {
+            __atomic_store_n(&mine->sleeping, 1, __ATOMIC_SEQ_CST);
+            while ((int)((seen = __atomic_load_n(flag, __ATOMIC_SEQ_CST)) - target) < 0)
+                futexWait(flag, seen);
+            __atomic_store_n(&mine->sleeping, 0, __ATOMIC_RELAXED);
+        }
+    }
+    return id == 0 ? THREAD_BARRIER_SERIAL_THREAD : 0;
+}
+
+void DisseminationBarrier_setSpinCount(DisseminationBarrier* const me, int spins) {
+    me->spinCount = spins;
+}
+
+DisseminationBarrier * DisseminationBarrier_Create(int nThreads) {
+    DisseminationBarrier* me = (DisseminationBarrier *) malloc(sizeof(DisseminationBarrier));
+    if(me!=NULL && DisseminationBarrier_Init(me, nThreads) != 0) {
+        free(me);
+        me = NULL;
+    }
+    return me;
+}
+
+void DisseminationBarrier_Destroy(DisseminationBarrier* const me) {
+    if(me!=NULL)
+        DisseminationBarrier_Cleanup(me);
+    free(me);
+}
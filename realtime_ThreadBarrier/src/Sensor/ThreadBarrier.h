@@ -5,21 +5,32 @@
 #ifndef REALTIME_THREADBARRIER_THREADBARRIER_H
 #define REALTIME_THREADBARRIER_THREADBARRIER_H
 
-/*## auto_generated */
-#include <oxf/Ric.h>
-/*## auto_generated */
-#include "RendezvousExample.h"
-/*## auto_generated */
-#include <oxf/RiCTask.h>
 /*## package RendezvousPattern::RendezvousExample */
 
+/* Returned by synchronize to exactly one thread per round, like PTHREAD_BARRIER_SERIAL_THREAD */
+#define THREAD_BARRIER_SERIAL_THREAD (-1)
+
+/* Polls of the barrier word before a waiter sleeps in the kernel (multi-core only) */
+#define THREAD_BARRIER_DEFAULT_SPIN 4000
+
+/* Dissemination barrier limits: ceil(log2(threads)) rounds each */
+#define DISSEMINATION_BARRIER_MAX_THREADS 1024
+#define DISSEMINATION_BARRIER_MAX_ROUNDS 10
+
 /*## class ThreadBarrier */
+/*
+    Central, reusable barrier. Every round the last thread to arrive
+    resets the count and bumps the generation; the others wait for the
+    generation to change, spinning first and then sleeping on it as a
+    futex. No reset is needed between rounds.
+*/
 typedef struct ThreadBarrier ThreadBarrier;
 struct ThreadBarrier {
-    int currentCount;
+    unsigned int currentCount;      /* arrivals in this generation */
     int expectedCount;
-    OSSemaphore* barrier;
-    OSSemaphore* mutex;
+    unsigned int generation;        /* futex word: bumped when a round completes */
+    unsigned int sleepers;          /* waiters in the kernel, so a round without any skips the wake */
+    int spinCount;
 };
 
 /* Constructors and destructors:*/
@@ -27,10 +38,52 @@ void ThreadBarrier_Init(ThreadBarrier* const me);
 void ThreadBarrier_Cleanup(ThreadBarrier* const me);
 
 /* Operations */
+
+/* Set the thread count; only while no thread is waiting */
 void ThreadBarrier_reset(ThreadBarrier* const me, int x);
-void ThreadBarrier_synchronize(ThreadBarrier* const me);
+
+/* Wait for all expected threads; one of them gets THREAD_BARRIER_SERIAL_THREAD, the rest 0 */
+int ThreadBarrier_synchronize(ThreadBarrier* const me);
+
+void ThreadBarrier_setSpinCount(ThreadBarrier* const me, int spins);
 ThreadBarrier * ThreadBarrier_Create(void);
 void ThreadBarrier_Destroy(ThreadBarrier* const me);
 
+/*## class DisseminationBarrier */
+/*
+    Dissemination barrier for high thread counts. In round k thread i
+    signals thread (i + 2^k) mod n and waits for the signal from
+    (i - 2^k) mod n; after ceil(log2(n)) rounds every thread has heard,
+    directly or not, from all others. There is no shared counter, and
+    every flag lives on its owner's cache line.
+*/
+typedef struct DisseminationSlot DisseminationSlot;
+struct DisseminationSlot {
+    unsigned int flags[DISSEMINATION_BARRIER_MAX_ROUNDS];   /* signals received per round, never reset */
+    unsigned int episode;                                   /* rounds this thread has completed */
+    unsigned int sleeping;                                  /* set while the owner sleeps on a flag */
+} __attribute__((aligned(64)));
+
+typedef struct DisseminationBarrier DisseminationBarrier;
+struct DisseminationBarrier {
+    int nThreads;
+    int nRounds;
+    int spinCount;
+    DisseminationSlot* slots;       /* one per thread */
+};
+
+/* Constructors and destructors:*/
+int DisseminationBarrier_Init(DisseminationBarrier* const me, int nThreads);
+void DisseminationBarrier_Cleanup(DisseminationBarrier* const me);
+
+/* Operations */
+
+/* Wait for all threads; id is the caller's index, 0 .. nThreads-1. Thread 0 gets THREAD_BARRIER_SERIAL_THREAD */
+int DisseminationBarrier_synchronize(DisseminationBarrier* const me, int id);
+
+void DisseminationBarrier_setSpinCount(DisseminationBarrier* const me, int spins);
+DisseminationBarrier * DisseminationBarrier_Create(int nThreads);
+void DisseminationBarrier_Destroy(DisseminationBarrier* const me);
+
 
 #endif //REALTIME_THREADBARRIER_THREADBARRIER_H
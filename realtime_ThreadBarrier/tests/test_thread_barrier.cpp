@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "ThreadBarrier.h"
+}
+
+namespace {
+
+constexpr std::size_t kRounds = 2000;
+
+// Every thread bumps its slot, then checks after the barrier that every
+// other thread has reached the same round; serial returns from that
+// first barrier are counted per round.
+template <typename Sync>
+void runRounds(int threads, Sync sync, std::vector<int>& serialPerRound, bool& sawStragglers) {
+    const std::size_t n = static_cast<std::size_t>(threads);
+    std::vector<std::atomic<int>> progress(n);
+    std::vector<std::thread> workers;
+    std::atomic<bool> stragglers{false};
+
+    for (auto& p : progress) {
+        p = 0;
+    }
+    for (std::size_t id = 0; id < n; id++) {
+        workers.emplace_back([&, id] {
+            for (std::size_t round = 0; round < kRounds; round++) {
+                const int reached = static_cast<int>(round) + 1;
+                progress[id].store(reached);
+                int status = sync(static_cast<int>(id));
+                for (std::size_t other = 0; other < n; other++) {
+                    if (progress[other].load() < reached) {
+                        stragglers = true;
+                    }
+                }
+                if (status == THREAD_BARRIER_SERIAL_THREAD) {
+                    __atomic_add_fetch(&serialPerRound[round], 1, __ATOMIC_RELAXED);
+                }
+                // a second barrier keeps the check above from seeing the next round
+                sync(static_cast<int>(id));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    sawStragglers = stragglers;
+}
+
+}  // namespace
+
+TEST(ThreadBarrierTest, ReusableWithoutReset) {
+    for (int threads : {2, 3, 8}) {
+        ThreadBarrier* barrier = ThreadBarrier_Create();
+        ASSERT_NE(barrier, nullptr);
+        ThreadBarrier_reset(barrier, threads);
+
+        std::vector<int> serial(kRounds, 0);
+        bool stragglers = false;
+        runRounds(threads, [barrier](int) { return ThreadBarrier_synchronize(barrier); }, serial, stragglers);
+
+        EXPECT_FALSE(stragglers);
+        for (std::size_t round = 0; round < kRounds; round++) {
+            ASSERT_EQ(serial[round], 1);
+        }
+        EXPECT_EQ(barrier->generation, 2u * kRounds);
+        ThreadBarrier_Destroy(barrier);
+    }
+}
+
+TEST(ThreadBarrierTest, SpinOnlyAndSleepOnlyWaiters) {
+    for (int spins : {0, 1 << 14}) {
+        ThreadBarrier* barrier = ThreadBarrier_Create();
+        ASSERT_NE(barrier, nullptr);
+        ThreadBarrier_reset(barrier, 4);
+        ThreadBarrier_setSpinCount(barrier, spins);
+
+        std::vector<int> serial(kRounds, 0);
+        bool stragglers = false;
+        runRounds(4, [barrier](int) { return ThreadBarrier_synchronize(barrier); }, serial, stragglers);
+        EXPECT_FALSE(stragglers);
+        ThreadBarrier_Destroy(barrier);
+    }
+}
+
+TEST(ThreadBarrierTest, SingleThreadIsAlwaysSerial) {
+    ThreadBarrier barrier;
+    ThreadBarrier_Init(&barrier);
+    ThreadBarrier_reset(&barrier, 1);
+    EXPECT_EQ(ThreadBarrier_synchronize(&barrier), THREAD_BARRIER_SERIAL_THREAD);
+    EXPECT_EQ(ThreadBarrier_synchronize(&barrier), THREAD_BARRIER_SERIAL_THREAD);
+    ThreadBarrier_Cleanup(&barrier);
+}
+
+TEST(DisseminationBarrierTest, RejectsBadThreadCounts) {
+    EXPECT_EQ(DisseminationBarrier_Create(0), nullptr);
+    EXPECT_EQ(DisseminationBarrier_Create(DISSEMINATION_BARRIER_MAX_THREADS + 1), nullptr);
+
+    DisseminationBarrier* barrier = DisseminationBarrier_Create(5);
+    ASSERT_NE(barrier, nullptr);
+    EXPECT_EQ(barrier->nRounds, 3);
+    DisseminationBarrier_Destroy(barrier);
+}
+
+TEST(DisseminationBarrierTest, EveryThreadCountKeepsRoundsInStep) {
+    for (int threads : {1, 2, 3, 5, 8, 13}) {
+        DisseminationBarrier* barrier = DisseminationBarrier_Create(threads);
+        ASSERT_NE(barrier, nullptr);
+
+        std::vector<int> serial(kRounds, 0);
+        bool stragglers = false;
+        runRounds(threads, [barrier](int id) { return DisseminationBarrier_synchronize(barrier, id); }, serial,
+                  stragglers);
+
+        EXPECT_FALSE(stragglers) << threads << " threads";
+        for (std::size_t round = 0; round < kRounds; round++) {
+            ASSERT_EQ(serial[round], 1);   // always thread 0
+        }
+        DisseminationBarrier_Destroy(barrier);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "ThreadBarrier.h"
+}
+
+// Barrier rounds per second from 2 to 64 threads: pthread_barrier_t, the
+// central futex ThreadBarrier and the DisseminationBarrier. Each thread
+// does no work between rounds, so the figures are pure rendezvous cost.
+
+namespace {
+
+constexpr int kMaxThreads = 64;
+
+int roundsFor(int threads) {
+    return std::max(200, 40000 / threads);
+}
+
+template <typename Sync>
+double roundsPerSecond(int threads, Sync sync) {
+    const int rounds = roundsFor(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int id = 0; id < threads; id++) {
+        workers.emplace_back([&, id] {
+            for (int round = 0; round < rounds; round++) {
+                sync(id);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return rounds / elapsed.count();
+}
+
+}  // namespace
+
+TEST(ThreadBarrierPerformance, RoundsPerSecond) {
+    std::printf("\n  %ld online CPUs\n", sysconf(_SC_NPROCESSORS_ONLN));
+    std::printf("  %-8s %18s %18s %18s\n", "threads", "pthread rounds/s", "central rounds/s", "dissem. rounds/s");
+    for (int threads = 2; threads <= kMaxThreads; threads *= 2) {
+        pthread_barrier_t posix;
+        ASSERT_EQ(pthread_barrier_init(&posix, nullptr, (unsigned)threads), 0);
+        double posixRate = roundsPerSecond(threads, [&](int) { return pthread_barrier_wait(&posix); });
+        pthread_barrier_destroy(&posix);
+
+        ThreadBarrier central;
+        ThreadBarrier_Init(&central);
+        ThreadBarrier_reset(&central, threads);
+        double centralRate = roundsPerSecond(threads, [&](int) { return ThreadBarrier_synchronize(&central); });
+        ThreadBarrier_Cleanup(&central);
+
+        DisseminationBarrier dissemination;
+        ASSERT_EQ(DisseminationBarrier_Init(&dissemination, threads), 0);
+        double disseminationRate =
+            roundsPerSecond(threads, [&](int id) { return DisseminationBarrier_synchronize(&dissemination, id); });
+        DisseminationBarrier_Cleanup(&dissemination);
+
+        std::printf("  %-8d %18.0f %18.0f %18.0f\n", threads, posixRate, centralRate, disseminationRate);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -21,12 +21,11 @@ void FlightDataDisplay_Cleanup(FlightDataDisplay* const me) {
 }
 
 void FlightDataDisplay_showFlightData(FlightDataDisplay* const me) {
-    Attitude a;
-    Position p;
-    a = KinematicData_getAttitude(me->itsKinematicData);
-    p = KinematicData_getPosition(me->itsKinematicData);
-    printf("Roll, pitch, yaw = %f, %f, %f \n", a.roll, a.pitch, a.yaw);
-    printf("Lat, Long, Altitude = %f, %f, %f\n", p.latitude, p.longitude, p.altitude);
+    KinematicSnapshot s;
+    /* one read, so attitude and position come from the same moment */
+    s = KinematicData_getSnapshot(me->itsKinematicData);
+    printf("Roll, pitch, yaw = %f, %f, %f \n", s.attitude.roll, s.attitude.pitch, s.attitude.yaw);
+    printf("Lat, Long, Altitude = %f, %f, %f\n", s.position.latitude, s.position.longitude, s.position.altitude);
 }
 
 struct KinematicData* FlightDataDisplay_getItsKinematicData(const FlightDataDisplay* const me) {
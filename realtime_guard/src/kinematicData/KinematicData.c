@@ -4,12 +4,74 @@
 
 #include "KinematicData.h"
 
+/*
+ * Seqlock helpers. The values are copied field by field with relaxed
+ * atomics so a reader racing a writer sees old or new doubles, never torn
+ * ones; the sequence counter tells it whether the set is consistent.
+ */
+
+static void loadAttitude(const Attitude* const src, Attitude* const dst) {
+    __atomic_load(&src->pitch, &dst->pitch, __ATOMIC_RELAXED);
+    __atomic_load(&src->roll, &dst->roll, __ATOMIC_RELAXED);
+    __atomic_load(&src->yaw, &dst->yaw, __ATOMIC_RELAXED);
+}
+
+static void storeAttitude(Attitude* const dst, Attitude* const src) {
+    __atomic_store(&dst->pitch, &src->pitch, __ATOMIC_RELAXED);
+    __atomic_store(&dst->roll, &src->roll, __ATOMIC_RELAXED);
+    __atomic_store(&dst->yaw, &src->yaw, __ATOMIC_RELAXED);
+}
+
+static void loadPosition(const Position* const src, Position* const dst) {
+    __atomic_load(&src->altitude, &dst->altitude, __ATOMIC_RELAXED);
+    __atomic_load(&src->latitude, &dst->latitude, __ATOMIC_RELAXED);
+    __atomic_load(&src->longitude, &dst->longitude, __ATOMIC_RELAXED);
+}
+
+static void storePosition(Position* const dst, Position* const src) {
+    __atomic_store(&dst->altitude, &src->altitude, __ATOMIC_RELAXED);
+    __atomic_store(&dst->latitude, &src->latitude, __ATOMIC_RELAXED);
+    __atomic_store(&dst->longitude, &src->longitude, __ATOMIC_RELAXED);
+}
+
+/* Opens a write: the counter turns odd before any value changes */
+static void beginWrite(KinematicData* const me) {
+    unsigned int seq = __atomic_load_n(&me->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&me->sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/* Closes a write: the counter turns even after every value is stored */
+static void endWrite(KinematicData* const me) {
+    unsigned int seq = __atomic_load_n(&me->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&me->sequence, seq + 1, __ATOMIC_RELEASE);
+}
+
+/* Waits out a write in progress and returns the even counter */
+static unsigned int beginRead(const KinematicData* const me) {
+    unsigned int seq;
+    while ((seq = __atomic_load_n(&me->sequence, __ATOMIC_ACQUIRE)) & 1u) {
+    }
+    return seq;
+}
+
+/* True when no write overlapped the copy that started at seq */
+static int readIsConsistent(const KinematicData* const me, unsigned int seq) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&me->sequence, __ATOMIC_RELAXED) == seq;
+}
 
 void KinematicData_Init(KinematicData* const me) {
+    KinematicData_InitMode(me, KINEMATIC_DATA_GUARDED);
+}
+
+void KinematicData_InitMode(KinematicData* const me, KinematicDataMode mode) {
 
     Attitude_Init(&(me->attitude));
     Position_Init(&(me->position));
     me->sema = OS_create_semaphore();
+    me->mode = mode;
+    me->sequence = 0;
 }
 
 void KinematicData_Cleanup(KinematicData* const me) {
@@ -19,6 +81,15 @@ void KinematicData_Cleanup(KinematicData* const me) {
 struct Position KinematicData_getPosition(KinematicData* const me) {
     Position p;
 
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        unsigned int seq;
+        do {
+            seq = beginRead(me);
+            loadPosition(&me->position, &p);
+        } while (!readIsConsistent(me, seq));
+        return p;
+    }
+
     /* engage the lock */
     OS_lock_semaphore(me->sema);
 
@@ -30,11 +101,42 @@ struct Position KinematicData_getPosition(KinematicData* const me) {
     return p;
 }
 
+KinematicSnapshot KinematicData_getSnapshot(KinematicData* const me) {
+    KinematicSnapshot s;
+
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        unsigned int seq;
+        do {
+            seq = beginRead(me);
+            loadAttitude(&me->attitude, &s.attitude);
+            loadPosition(&me->position, &s.position);
+        } while (!readIsConsistent(me, seq));
+        return s;
+    }
+
+    /* engage the lock */
+    OS_lock_semaphore(me->sema);
+
+    s.attitude = me->attitude;
+    s.position = me->position;
+
+    /* release the lock */
+    OS_release_semaphore(me->sema);
+
+    return s;
+}
+
 void KinematicData_setAttitude(KinematicData* const me, Attitude a) {
     /* engage the lock */
     OS_lock_semaphore(me->sema);
 
-    me->attitude = a;
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        beginWrite(me);
+        storeAttitude(&me->attitude, &a);
+        endWrite(me);
+    } else {
+        me->attitude = a;
+    }
 
     /* release the lock */
     OS_release_semaphore(me->sema);
@@ -44,7 +146,13 @@ void KinematicData_setPosition(KinematicData* const me, Position p) {
     /* engage the lock */
     OS_lock_semaphore(me->sema);
 
-    me->position = p;
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        beginWrite(me);
+        storePosition(&me->position, &p);
+        endWrite(me);
+    } else {
+        me->position = p;
+    }
 
     /* release the lock */
     OS_release_semaphore(me->sema);
@@ -52,10 +160,32 @@ void KinematicData_setPosition(KinematicData* const me, Position p) {
     /*#]*/
 }
 
+void KinematicData_setSnapshot(KinematicData* const me, KinematicSnapshot s) {
+    /* engage the lock */
+    OS_lock_semaphore(me->sema);
+
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        beginWrite(me);
+        storeAttitude(&me->attitude, &s.attitude);
+        storePosition(&me->position, &s.position);
+        endWrite(me);
+    } else {
+        me->attitude = s.attitude;
+        me->position = s.position;
+    }
+
+    /* release the lock */
+    OS_release_semaphore(me->sema);
+}
+
 KinematicData * KinematicData_Create(void) {
+    return KinematicData_CreateMode(KINEMATIC_DATA_GUARDED);
+}
+
+KinematicData * KinematicData_CreateMode(KinematicDataMode mode) {
     KinematicData* me = (KinematicData *) malloc(sizeof(KinematicData));
     if(me!=NULL) {
-        KinematicData_Init(me);
+        KinematicData_InitMode(me, mode);
     }
     return me;
 }
@@ -70,6 +200,15 @@ void KinematicData_Destroy(KinematicData* const me) {
 Attitude KinematicData_getAttitude(KinematicData* const me) {
     Attitude a;
 
+    if (me->mode == KINEMATIC_DATA_SEQLOCK) {
+        unsigned int seq;
+        do {
+            seq = beginRead(me);
+            loadAttitude(&me->attitude, &a);
+        } while (!readIsConsistent(me, seq));
+        return a;
+    }
+
     /* engage the lock */
     OS_lock_semaphore(me->sema);
 
@@ -79,4 +218,4 @@ Attitude KinematicData_getAttitude(KinematicData* const me) {
     OS_release_semaphore(me->sema);
 
     return a;
-}
\ No newline at end of file
+}
@@ -10,15 +10,42 @@
 #include "OSSemaphore.h"
 #include "Position.h"
 
+/*
+ * How readers are kept consistent with writers.
+ *
+ * KINEMATIC_DATA_GUARDED: every get and set takes the mutex semaphore, so
+ * readers serialize against each other and against the writers.
+ *
+ * KINEMATIC_DATA_SEQLOCK: a writer makes the sequence counter odd, stores
+ * the values, then makes it even again. Readers never take the semaphore;
+ * they copy the values and retry only if the counter was odd or moved
+ * during the copy. Writers still take the semaphore, but only to order
+ * against other writers, so a single writer is never held up by readers.
+ */
+typedef enum KinematicDataMode {
+    KINEMATIC_DATA_GUARDED,
+    KINEMATIC_DATA_SEQLOCK
+} KinematicDataMode;
+
+/* Position and attitude read together */
+typedef struct KinematicSnapshot KinematicSnapshot;
+struct KinematicSnapshot {
+    struct Attitude attitude;
+    struct Position position;
+};
+
 typedef struct KinematicData KinematicData;
 struct KinematicData {
     struct Attitude attitude;
     struct Position position;
     OSSemaphore* sema;      /*## mutex semaphore */
+    KinematicDataMode mode;
+    unsigned int sequence;  /*## seqlock counter, odd while a write is in progress */
 };
 
 /* Constructors and destructors:*/
 void KinematicData_Init(KinematicData* const me);
+void KinematicData_InitMode(KinematicData* const me, KinematicDataMode mode);
 void KinematicData_Cleanup(KinematicData* const me);
 
 /* Operations */
@@ -26,11 +53,18 @@ void KinematicData_Cleanup(KinematicData* const me);
 Attitude KinematicData_getAttitude(KinematicData* const me);
 struct Position KinematicData_getPosition(KinematicData* const me);
 
+/* Attitude and position from the same moment, in one read */
+KinematicSnapshot KinematicData_getSnapshot(KinematicData* const me);
+
 void KinematicData_setAttitude(KinematicData* const me, Attitude a);
 
 void KinematicData_setPosition(KinematicData* const me, Position p);
 
+/* Attitude and position published together, so no reader sees one without the other */
+void KinematicData_setSnapshot(KinematicData* const me, KinematicSnapshot s);
+
 KinematicData * KinematicData_Create(void);
+KinematicData * KinematicData_CreateMode(KinematicDataMode mode);
 
 void KinematicData_Destroy(KinematicData* const me);
 
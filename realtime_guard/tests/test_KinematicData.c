@@ -0,0 +1,183 @@
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include "KinematicData.h"
+
+#define WRITES 50000u
+#define READERS 3
+
+/*
+    Writers publish write number n in every field. A reader checks that
+    each struct it gets holds a single n (no torn doubles), that combined
+    snapshots hold one n throughout, and that n never goes backwards.
+*/
+
+static Attitude makeAttitude(double v) {
+    Attitude a;
+    a.pitch = v;
+    a.roll = v;
+    a.yaw = v;
+    return a;
+}
+
+static Position makePosition(double v) {
+    Position p;
+    p.altitude = v;
+    p.latitude = v;
+    p.longitude = v;
+    return p;
+}
+
+static KinematicSnapshot makeSnapshot(double v) {
+    KinematicSnapshot s;
+    s.attitude = makeAttitude(v);
+    s.position = makePosition(v);
+    return s;
+}
+
+typedef struct {
+    KinematicData* data;
+    int* done;
+    unsigned long reads;
+    unsigned long torn;         /* fields of one struct disagree */
+    unsigned long mismatched;   /* attitude and position from different writes */
+    int wentBackwards;
+} Reader;
+
+static void* reader(void* arg) {
+    Reader* r = (Reader*)arg;
+    double last = 0.0;
+
+    while (!__atomic_load_n(r->done, __ATOMIC_ACQUIRE)) {
+        KinematicSnapshot s = KinematicData_getSnapshot(r->data);
+        double v = s.attitude.pitch;
+
+        if (s.attitude.roll != v || s.attitude.yaw != v ||
+            s.position.latitude != s.position.altitude || s.position.longitude != s.position.altitude) {
+            r->torn++;
+        }
+        if (s.position.altitude != v) {
+            r->mismatched++;
+        }
+        if (v < last) {
+            r->wentBackwards = 1;
+        }
+        last = v;
+        r->reads++;
+    }
+    return NULL;
+}
+
+/* Runs READERS snapshot readers against one writer; combined picks setSnapshot */
+static void runReadersAgainstWriter(KinematicDataMode mode, int combined, Reader* readers) {
+    KinematicData* data = KinematicData_CreateMode(mode);
+    pthread_t threads[READERS];
+    int done = 0;
+
+    TEST_ASSERT_NOT_NULL(data);
+    KinematicData_setSnapshot(data, makeSnapshot(0.0));  // Attitude_Init and Position_Init leave fields unset
+    for (int i = 0; i < READERS; i++) {
+        readers[i] = (Reader){data, &done, 0, 0, 0, 0};
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, reader, &readers[i]));
+    }
+    for (unsigned int n = 1; n <= WRITES; n++) {
+        if (combined) {
+            KinematicData_setSnapshot(data, makeSnapshot((double)n));
+        } else {
+            KinematicData_setAttitude(data, makeAttitude((double)n));
+            KinematicData_setPosition(data, makePosition((double)n));
+        }
+        if (n % 256u == 0) {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT_EQUAL_UINT(0, readers[i].torn);
+        TEST_ASSERT_FALSE(readers[i].wentBackwards);
+    }
+    KinematicData_Destroy(data);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void assertSetAndGet(KinematicDataMode mode) {
+    KinematicData* data = KinematicData_CreateMode(mode);
+    KinematicSnapshot s;
+
+    TEST_ASSERT_NOT_NULL(data);
+    KinematicData_setAttitude(data, makeAttitude(1.5));
+    KinematicData_setPosition(data, makePosition(-2.5));
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, KinematicData_getAttitude(data).yaw);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.5, KinematicData_getPosition(data).latitude);
+
+    s = KinematicData_getSnapshot(data);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, s.attitude.roll);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.5, s.position.altitude);
+
+    KinematicData_setSnapshot(data, makeSnapshot(7.0));
+    TEST_ASSERT_EQUAL_DOUBLE(7.0, KinematicData_getAttitude(data).pitch);
+    TEST_ASSERT_EQUAL_DOUBLE(7.0, KinematicData_getPosition(data).longitude);
+    KinematicData_Destroy(data);
+}
+
+void test_guarded_mode_set_and_get(void) {
+    assertSetAndGet(KINEMATIC_DATA_GUARDED);
+}
+
+void test_seqlock_mode_set_and_get(void) {
+    assertSetAndGet(KINEMATIC_DATA_SEQLOCK);
+}
+
+void test_seqlock_counter_is_even_between_writes(void) {
+    KinematicData data;
+
+    KinematicData_InitMode(&data, KINEMATIC_DATA_SEQLOCK);
+    TEST_ASSERT_EQUAL_UINT(0, data.sequence);
+    KinematicData_setPosition(&data, makePosition(1.0));
+    KinematicData_setAttitude(&data, makeAttitude(1.0));
+    KinematicData_setSnapshot(&data, makeSnapshot(2.0));
+    TEST_ASSERT_EQUAL_UINT(6, data.sequence);
+    KinematicData_Cleanup(&data);
+}
+
+void test_seqlock_snapshots_are_never_torn(void) {
+    Reader readers[READERS];
+
+    runReadersAgainstWriter(KINEMATIC_DATA_SEQLOCK, 1, readers);
+    for (int i = 0; i < READERS; i++) {
+        TEST_ASSERT_EQUAL_UINT(0, readers[i].mismatched);
+    }
+}
+
+void test_seqlock_separate_writes_keep_each_struct_whole(void) {
+    Reader readers[READERS];
+
+    // A snapshot may fall between setAttitude and setPosition, but never inside either
+    runReadersAgainstWriter(KINEMATIC_DATA_SEQLOCK, 0, readers);
+}
+
+void test_guarded_snapshots_are_never_torn(void) {
+    Reader readers[READERS];
+
+    runReadersAgainstWriter(KINEMATIC_DATA_GUARDED, 1, readers);
+    for (int i = 0; i < READERS; i++) {
+        TEST_ASSERT_EQUAL_UINT(0, readers[i].mismatched);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_guarded_mode_set_and_get);
+    RUN_TEST(test_seqlock_mode_set_and_get);
+    RUN_TEST(test_seqlock_counter_is_even_between_writes);
+    RUN_TEST(test_seqlock_snapshots_are_never_torn);
+    RUN_TEST(test_seqlock_separate_writes_keep_each_struct_whole);
+    RUN_TEST(test_guarded_snapshots_are_never_torn);
+    return UNITY_END();
+}
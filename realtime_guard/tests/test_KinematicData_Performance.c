@@ -0,0 +1,119 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime, nanosleep
+
+#include <unity.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "KinematicData.h"
+
+/*
+    Snapshot reads per second with 1 to 32 reader threads against one
+    writer that publishes every 50 us, in the guarded (semaphore) mode and
+    the seqlock mode.
+*/
+
+#define RUN_MS 200
+#define WRITE_PERIOD_NS 50000L
+#define MAX_READERS 32
+
+typedef struct {
+    KinematicData* data;
+    int* done;
+    unsigned long reads;
+    double checksum;
+} Reader;
+
+static void* reader(void* arg) {
+    Reader* r = (Reader*)arg;
+    while (!__atomic_load_n(r->done, __ATOMIC_ACQUIRE)) {
+        KinematicSnapshot s = KinematicData_getSnapshot(r->data);
+        r->checksum += s.position.altitude;
+        r->reads++;
+    }
+    return NULL;
+}
+
+typedef struct {
+    KinematicData* data;
+    int* done;
+    unsigned long writes;
+} Writer;
+
+static void* writer(void* arg) {
+    Writer* w = (Writer*)arg;
+    struct timespec pause = {0, WRITE_PERIOD_NS};
+    KinematicSnapshot s;
+
+    while (!__atomic_load_n(w->done, __ATOMIC_ACQUIRE)) {
+        double v = (double)++w->writes;
+        s.attitude.pitch = s.attitude.roll = s.attitude.yaw = v;
+        s.position.altitude = s.position.latitude = s.position.longitude = v;
+        KinematicData_setSnapshot(w->data, s);
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Returns snapshot reads per second across all readers */
+static double run(KinematicDataMode mode, int nReaders) {
+    static Reader readers[MAX_READERS];
+    pthread_t threads[MAX_READERS];
+    pthread_t writerThread;
+    Writer w;
+    KinematicData* data = KinematicData_CreateMode(mode);
+    struct timespec runTime = {RUN_MS / 1000, (RUN_MS % 1000) * 1000000L};
+    int done = 0;
+    unsigned long reads = 0;
+    double start;
+    double elapsed;
+
+    TEST_ASSERT_NOT_NULL(data);
+    w = (Writer){data, &done, 0};
+    start = seconds();
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&writerThread, NULL, writer, &w));
+    for (int i = 0; i < nReaders; i++) {
+        readers[i] = (Reader){data, &done, 0, 0.0};
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, reader, &readers[i]));
+    }
+    nanosleep(&runTime, NULL);
+    __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < nReaders; i++) {
+        pthread_join(threads[i], NULL);
+        reads += readers[i].reads;
+    }
+    pthread_join(writerThread, NULL);
+    elapsed = seconds() - start;
+
+    TEST_ASSERT_TRUE(w.writes > 0);
+    KinematicData_Destroy(data);
+    return (double)reads / elapsed;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_reader_scaling(void) {
+    printf("\n  %ld online CPUs, one writer every %ld us\n", sysconf(_SC_NPROCESSORS_ONLN), WRITE_PERIOD_NS / 1000);
+    printf("  %-8s %18s %18s %9s\n", "readers", "guarded Mreads/s", "seqlock Mreads/s", "speedup");
+    for (int n = 1; n <= MAX_READERS; n *= 2) {
+        double guarded = run(KINEMATIC_DATA_GUARDED, n);
+        double seqlock = run(KINEMATIC_DATA_SEQLOCK, n);
+        printf("  %-8d %18.2f %18.2f %8.2fx\n", n, guarded / 1e6, seqlock / 1e6, seqlock / guarded);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_reader_scaling);
+    return UNITY_END();
+}
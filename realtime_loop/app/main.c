@@ -4,7 +4,7 @@
  */
 
  #include <unistd.h>  // Header for usleep() function
- #include "GasControlEpochTime.h"
+ #include "GasControlExecutive.h"
  #include "GasActuatorThread.h"
  #include "GasDisplayThread.h"
  #include "GasSensorThread.h"
@@ -73,34 +73,28 @@
    */
   void signalHandler(int sig) {
       printf("\nReceived signal %d. Shutting down...\n", sig);
-      shutdownSystem();
       running = false;
+      GasControlExecutive_stop();
   }
  
  /**
-  * @brief Modified control loop that can be interrupted
+  * @brief Control loop that can be interrupted
+  *
+  * The cyclic executive sleeps until each frame's absolute release time,
+  * so the loop neither spins nor drifts between epochs.
   */
  void runControlLoop(void) {
      // Set initial status message
      GasDisplayThread_setStatusMessage("System running normally");
      
+     if (GasControlExecutive_init() != 0) {
+         fprintf(stderr, "Failed to build the control frame table\n");
+         return;
+     }
      printf("Gas Control System: Starting control loop\n");
      
-     // Main control loop
-     while (running) {
-         startEpochTimer();
-         
-         // Run all threads in sequence
-         GasSensorThread_run();
-         GasActuatorThread_run();
-         GasDisplayThread_run();
-         
-         // Wait for epoch to complete or until interrupted
-         while (!epochTimerHasElapsed() && running) {
-             // Short sleep to prevent CPU spinning
-             sleep(10);  // 1ms sleep
-         }
-     }
+     // Returns once the signal handler stops the executive
+     controlLoop();
  }
  
  int main(int argc, char *argv[]) {
@@ -0,0 +1,213 @@
+#define _POSIX_C_SOURCE 200112L  // clock_nanosleep
+#include "CyclicExecutive.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NS_PER_SEC 1000000000LL
+
+/**
+ * @brief Nanoseconds on the monotonic clock
+ */
+static long long monotonicNow(void* context) {
+    (void)context;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * NS_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * @brief Sleep until an absolute monotonic time, riding out signal interruptions
+ */
+static void monotonicSleepUntil(void* context, long long deadlineNs) {
+    const CyclicExecutive* const me = (const CyclicExecutive*)context;
+    struct timespec deadline;
+    deadline.tv_sec = (time_t)(deadlineNs / NS_PER_SEC);
+    deadline.tv_nsec = (long)(deadlineNs % NS_PER_SEC);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR &&
+           !__atomic_load_n(&me->stopRequested, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+/**
+ * @brief Put one release lateness into the histogram
+ */
+static void recordJitter(CyclicExecutive* const me, long long lateNs) {
+    long long bucket = (lateNs > 0) ? lateNs / 1000 : 0;
+    if (bucket >= CYCLIC_JITTER_BUCKETS) {
+        bucket = CYCLIC_JITTER_BUCKETS - 1;
+    }
+    me->jitter[bucket]++;
+    if (lateNs > me->maxJitterNs) {
+        me->maxJitterNs = lateNs;
+    }
+}
+
+int CyclicExecutive_Init(CyclicExecutive* const me, long long minorFrameNs, int framesPerMajor) {
+    memset(me, 0, sizeof(*me));
+    if (minorFrameNs <= 0 || framesPerMajor < 1 || framesPerMajor > CYCLIC_MAX_FRAMES) {
+        return -1;
+    }
+    me->minorFrameNs = minorFrameNs;
+    me->nFrames = framesPerMajor;
+    CyclicExecutive_setClock(me, NULL, NULL, NULL);
+    return 0;
+}
+
+void CyclicExecutive_Cleanup(CyclicExecutive* const me) {
+    me->nTasks = 0;
+    me->nFrames = 0;
+}
+
+CyclicExecutive* CyclicExecutive_Create(long long minorFrameNs, int framesPerMajor) {
+    CyclicExecutive* me = (CyclicExecutive*)malloc(sizeof(CyclicExecutive));
+    if (me != NULL && CyclicExecutive_Init(me, minorFrameNs, framesPerMajor) != 0) {
+        free(me);
+        me = NULL;
+    }
+    return me;
+}
+
+void CyclicExecutive_Destroy(CyclicExecutive* const me) {
+    if (me != NULL) {
+        CyclicExecutive_Cleanup(me);
+    }
+    free(me);
+}
+
+void CyclicExecutive_setClock(CyclicExecutive* const me, CyclicClockFunction now, CyclicSleepFunction sleepUntil,
+                              void* context) {
+    if (now == NULL || sleepUntil == NULL) {
+        me->now = monotonicNow;
+        me->sleepUntil = monotonicSleepUntil;
+        me->clockContext = me;
+        return;
+    }
+    me->now = now;
+    me->sleepUntil = sleepUntil;
+    me->clockContext = context;
+}
+
+int CyclicExecutive_addTask(CyclicExecutive* const me, const char* name, CyclicTaskFunction run) {
+    if (run == NULL || me->nTasks >= CYCLIC_MAX_TASKS) {
+        return -1;
+    }
+    me->tasks[me->nTasks].name = name;
+    me->tasks[me->nTasks].run = run;
+    me->tasks[me->nTasks].runs = 0;
+    me->tasks[me->nTasks].worstNs = 0;
+    return me->nTasks++;
+}
+
+int CyclicExecutive_assign(CyclicExecutive* const me, int taskId, int frame) {
+    CyclicFrame* f;
+
+    if (taskId < 0 || taskId >= me->nTasks || frame < 0 || frame >= me->nFrames) {
+        return -1;
+    }
+    f = &me->frames[frame];
+    if (f->nTasks >= CYCLIC_MAX_TASKS_PER_FRAME) {
+        return -1;
+    }
+    f->tasks[f->nTasks++] = (unsigned char)taskId;
+    return 0;
+}
+
+int CyclicExecutive_assignEvery(CyclicExecutive* const me, int taskId, int firstFrame, int every) {
+    if (every < 1 || firstFrame < 0 || firstFrame >= me->nFrames) {
+        return -1;
+    }
+    for (int frame = firstFrame; frame < me->nFrames; frame += every) {
+        if (CyclicExecutive_assign(me, taskId, frame) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int CyclicExecutive_run(CyclicExecutive* const me, unsigned long majorFrames) {
+    long long release = me->now(me->clockContext) + me->minorFrameNs;  // first release one frame from now
+    unsigned long major = 0;
+
+    while (majorFrames == 0 || major < majorFrames) {
+        for (int frame = 0; frame < me->nFrames; frame++) {
+            CyclicFrame* f = &me->frames[frame];
+            long long end;
+
+            me->sleepUntil(me->clockContext, release);
+            if (__atomic_load_n(&me->stopRequested, __ATOMIC_ACQUIRE)) {
+                __atomic_store_n(&me->stopRequested, 0, __ATOMIC_RELAXED);  // A stop is consumed by the run it ends
+                return 0;
+            }
+            end = me->now(me->clockContext);
+            recordJitter(me, end - release);
+
+            for (int i = 0; i < f->nTasks; i++) {
+                CyclicTask* task = &me->tasks[f->tasks[i]];
+                long long start = end;
+                task->run();
+                end = me->now(me->clockContext);
+                task->runs++;
+                if (end - start > task->worstNs) {
+                    task->worstNs = end - start;
+                }
+            }
+
+            // The next release stays on the grid, whatever this frame took
+            release += me->minorFrameNs;
+            if (end > release) {
+                f->overruns++;
+                me->overruns++;
+            }
+            me->framesRun++;
+        }
+        major++;
+    }
+    return 0;
+}
+
+void CyclicExecutive_stop(CyclicExecutive* const me) {
+    __atomic_store_n(&me->stopRequested, 1, __ATOMIC_RELEASE);
+}
+
+long long CyclicExecutive_jitterPercentileNs(const CyclicExecutive* const me, double percentile) {
+    unsigned long total = 0;
+    unsigned long seen = 0;
+    unsigned long rank;
+
+    for (int b = 0; b < CYCLIC_JITTER_BUCKETS; b++) {
+        total += me->jitter[b];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    rank = (unsigned long)(percentile / 100.0 * (double)total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > total) {
+        rank = total;
+    }
+    for (int b = 0; b < CYCLIC_JITTER_BUCKETS - 1; b++) {
+        seen += me->jitter[b];
+        if (seen >= rank) {
+            return (long long)(b + 1) * 1000;
+        }
+    }
+    return me->maxJitterNs;  // In the overflow bucket
+}
+
+void CyclicExecutive_resetStatistics(CyclicExecutive* const me) {
+    me->framesRun = 0;
+    me->overruns = 0;
+    me->maxJitterNs = 0;
+    memset(me->jitter, 0, sizeof(me->jitter));
+    for (int i = 0; i < me->nFrames; i++) {
+        me->frames[i].overruns = 0;
+    }
+    for (int i = 0; i < me->nTasks; i++) {
+        me->tasks[i].runs = 0;
+        me->tasks[i].worstNs = 0;
+    }
+}
@@ -0,0 +1,147 @@
+#ifndef CYCLIC_EXECUTIVE_H
+#define CYCLIC_EXECUTIVE_H
+
+/**
+ * @file CyclicExecutive.h
+ * @brief Drift-free cyclic executive: a table of minor frames released on absolute deadlines
+ *
+ * A major frame is a fixed number of minor frames. Each minor frame has a
+ * list of tasks assigned to it, which run in order when the frame is
+ * released. Releases sit on a grid of absolute CLOCK_MONOTONIC deadlines
+ * (start + n * minor frame), slept on with clock_nanosleep(TIMER_ABSTIME),
+ * so task run time never shifts later frames and the thread is idle between
+ * frames.
+ *
+ * A frame whose tasks are still running at the next release is an overrun.
+ * The next frame then starts late but the grid is kept: no frame is skipped.
+ *
+ * The clock and the sleep are hooks (CyclicExecutive_setClock), so the grid
+ * and overrun logic can be driven by simulated time.
+ */
+
+#define CYCLIC_MAX_TASKS 16             /**< Tasks per executive */
+#define CYCLIC_MAX_FRAMES 64            /**< Minor frames per major frame */
+#define CYCLIC_MAX_TASKS_PER_FRAME 8    /**< Tasks assigned to one minor frame */
+#define CYCLIC_JITTER_BUCKETS 1024      /**< 1 us wide; the last bucket collects everything later */
+
+/**
+ * @brief A task is a plain run-once-per-release function, like GasSensorThread_run
+ */
+typedef void (*CyclicTaskFunction)(void);
+
+/**
+ * @brief Time source: current time in nanoseconds on a monotonic scale
+ */
+typedef long long (*CyclicClockFunction)(void* context);
+
+/**
+ * @brief Block until the clock reads at least deadlineNs, or a stop is requested
+ */
+typedef void (*CyclicSleepFunction)(void* context, long long deadlineNs);
+
+typedef struct {
+    const char* name;
+    CyclicTaskFunction run;
+    unsigned long runs;                 /**< Releases executed */
+    long long worstNs;                  /**< Longest single run */
+} CyclicTask;
+
+typedef struct {
+    unsigned char tasks[CYCLIC_MAX_TASKS_PER_FRAME];   /**< Indices into CyclicExecutive.tasks */
+    int nTasks;
+    unsigned long overruns;             /**< Times this frame ran past the next release */
+} CyclicFrame;
+
+typedef struct {
+    long long minorFrameNs;             /**< Minor frame length */
+    int nFrames;                        /**< Minor frames per major frame */
+    CyclicFrame frames[CYCLIC_MAX_FRAMES];
+    CyclicTask tasks[CYCLIC_MAX_TASKS];
+    int nTasks;
+    int stopRequested;                  /**< Set atomically by CyclicExecutive_stop, possibly from a signal handler */
+
+    /* time base, CLOCK_MONOTONIC and clock_nanosleep unless replaced */
+    CyclicClockFunction now;
+    CyclicSleepFunction sleepUntil;
+    void* clockContext;
+
+    /* statistics */
+    unsigned long framesRun;
+    unsigned long overruns;
+    unsigned long jitter[CYCLIC_JITTER_BUCKETS];   /**< Release-to-wake-up lateness histogram */
+    long long maxJitterNs;
+} CyclicExecutive;
+
+/**
+ * @brief Set up an empty frame table
+ *
+ * @param minorFrameNs Length of one minor frame in nanoseconds
+ * @param framesPerMajor Minor frames in one major frame (1..CYCLIC_MAX_FRAMES)
+ * @return int 0 on success, -1 on bad arguments
+ */
+int CyclicExecutive_Init(CyclicExecutive* const me, long long minorFrameNs, int framesPerMajor);
+void CyclicExecutive_Cleanup(CyclicExecutive* const me);
+CyclicExecutive* CyclicExecutive_Create(long long minorFrameNs, int framesPerMajor);
+void CyclicExecutive_Destroy(CyclicExecutive* const me);
+
+/**
+ * @brief Replace the clock and sleep used by run
+ *
+ * Both hooks get the same context. Passing NULL for either restores the
+ * CLOCK_MONOTONIC defaults for both.
+ */
+void CyclicExecutive_setClock(CyclicExecutive* const me, CyclicClockFunction now, CyclicSleepFunction sleepUntil,
+                              void* context);
+
+/**
+ * @brief Register a task
+ *
+ * @return int Task id for the assign calls, or -1 if the table is full
+ */
+int CyclicExecutive_addTask(CyclicExecutive* const me, const char* name, CyclicTaskFunction run);
+
+/**
+ * @brief Run a task in one minor frame of every major frame
+ *
+ * Tasks in a frame run in the order they were assigned.
+ *
+ * @return int 0 on success, -1 on a bad task/frame or a full frame
+ */
+int CyclicExecutive_assign(CyclicExecutive* const me, int taskId, int frame);
+
+/**
+ * @brief Run a task in frames firstFrame, firstFrame + every, ... of every major frame
+ *
+ * @return int 0 on success, -1 if any of those frames cannot take the task
+ */
+int CyclicExecutive_assignEvery(CyclicExecutive* const me, int taskId, int firstFrame, int every);
+
+/**
+ * @brief Release frames on the absolute-deadline grid
+ *
+ * @param majorFrames Major frames to run, or 0 to run until CyclicExecutive_stop
+ * @return int 0 when done or stopped
+ */
+int CyclicExecutive_run(CyclicExecutive* const me, unsigned long majorFrames);
+
+/**
+ * @brief Ask run to return before the next release (async-signal-safe)
+ *
+ * A stop requested before run starts ends that run at its first release.
+ */
+void CyclicExecutive_stop(CyclicExecutive* const me);
+
+/**
+ * @brief Release lateness at a percentile of all frames run so far
+ *
+ * @param percentile 0.0 .. 100.0
+ * @return long long Nanoseconds, rounded up to the histogram's 1 us buckets
+ */
+long long CyclicExecutive_jitterPercentileNs(const CyclicExecutive* const me, double percentile);
+
+/**
+ * @brief Clear run counts, overruns and the jitter histogram
+ */
+void CyclicExecutive_resetStatistics(CyclicExecutive* const me);
+
+#endif /* CYCLIC_EXECUTIVE_H */
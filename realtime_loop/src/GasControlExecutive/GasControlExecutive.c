@@ -2,19 +2,51 @@
 // Created by mahon on 1/25/2024.
 //
 #include "GasControlExecutive.h"
+#include "CyclicExecutive.h"
 #include "GasActuatorThread.h"
-#include "GasControlEpochTime.h"
 #include "GasDisplayThread.h"
 #include "GasSensorThread.h"
-#include <stdbool.h>
 
+/*
+    Default frame table: the old 100 ms epoch is a major frame of four 25 ms
+    minor frames, so sense, actuate and display each get a frame of their
+    own and frame 3 is slack for overruns.
+*/
+#define GAS_CONTROL_MINOR_FRAME_NS (25LL * 1000000LL)
+#define GAS_CONTROL_FRAMES_PER_MAJOR 4
+
+static CyclicExecutive executive;
+
+int GasControlExecutive_init(void) {
+    int sensor;
+    int actuator;
+    int display;
+
+    if (CyclicExecutive_Init(&executive, GAS_CONTROL_MINOR_FRAME_NS, GAS_CONTROL_FRAMES_PER_MAJOR) != 0) {
+        return -1;
+    }
+    sensor = CyclicExecutive_addTask(&executive, "sensor", GasSensorThread_run);
+    actuator = CyclicExecutive_addTask(&executive, "actuator", GasActuatorThread_run);
+    display = CyclicExecutive_addTask(&executive, "display", GasDisplayThread_run);
+    if (CyclicExecutive_assign(&executive, sensor, 0) != 0 ||
+        CyclicExecutive_assign(&executive, actuator, 1) != 0 ||
+        CyclicExecutive_assign(&executive, display, 2) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+CyclicExecutive* GasControlExecutive_getExecutive(void) {
+    return &executive;
+}
+
+void GasControlExecutive_stop(void) {
+    CyclicExecutive_stop(&executive);
+}
 
 void controlLoop(void) {
-    while (true) {
-        startEpochTimer();
-        GasSensorThread_run();
-        GasActuatorThread_run();
-        GasDisplayThread_run();
-        while(!epochTimerHasElapsed()) ;
-    };
+    if (executive.nFrames == 0 && GasControlExecutive_init() != 0) {
+        return;
+    }
+    CyclicExecutive_run(&executive, 0);
 }
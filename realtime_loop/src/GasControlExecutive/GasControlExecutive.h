@@ -1,7 +1,28 @@
 #ifndef REALTIME_LOOP_GASCONTROLEXECUTIVE_H
 #define REALTIME_LOOP_GASCONTROLEXECUTIVE_H
 
+#include "CyclicExecutive.h"
 
+/**
+ * @brief Build the default frame table: sensor, actuator and display in minor frames 0, 1 and 2
+ *
+ * @return int 0 on success, -1 on failure
+ */
+int GasControlExecutive_init(void);
+
+/**
+ * @brief The executive behind controlLoop, for statistics or a custom frame table
+ */
+CyclicExecutive* GasControlExecutive_getExecutive(void);
+
+/**
+ * @brief Make controlLoop return before its next release (async-signal-safe)
+ */
+void GasControlExecutive_stop(void);
+
+/**
+ * @brief Run the frame table until GasControlExecutive_stop, sleeping between frames
+ */
 void controlLoop(void);
 
-#endif //REALTIME_LOOP_GASCONTROLEXECUTIVE_H
\ No newline at end of file
+#endif //REALTIME_LOOP_GASCONTROLEXECUTIVE_H
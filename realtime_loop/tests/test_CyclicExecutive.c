@@ -0,0 +1,215 @@
+#define _POSIX_C_SOURCE 200112L  // nanosleep
+
+#include <unity.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include "CyclicExecutive.h"
+
+#define MINOR_FRAME_NS (2LL * 1000000LL)
+
+// Test fixtures
+static CyclicExecutive executive;
+static char trace[64];
+static int traceLength;
+static long long releases[64];
+static int nReleases;
+
+// Simulated time: sleeping jumps the clock to the deadline plus a chosen
+// wake-up latency, and tasks advance it by the CPU time they stand for
+typedef struct {
+    long long now;
+    long long wakeLatencyNs[4];     // Used in turn, one per sleep
+    int sleeps;
+} SimClock;
+
+static SimClock simClock;
+
+static long long simNow(void* context) {
+    return ((SimClock*)context)->now;
+}
+
+static void simSleepUntil(void* context, long long deadlineNs) {
+    SimClock* clock = (SimClock*)context;
+    long long wake = deadlineNs + clock->wakeLatencyNs[clock->sleeps++ % 4];
+
+    if (wake > clock->now) {
+        clock->now = wake;
+    }
+}
+
+static void record(char task) {
+    if (traceLength < (int)sizeof(trace) - 1) {
+        trace[traceLength++] = task;
+    }
+}
+
+static void taskA(void) { record('A'); }
+static void taskB(void) { record('B'); }
+static void taskC(void) { record('C'); }
+
+// Notes when it was released and uses 100 us of simulated CPU
+static void timestampTask(void) {
+    if (nReleases < 64) {
+        releases[nReleases++] = simClock.now;
+    }
+    simClock.now += 100000;
+}
+
+// Uses one and a half minor frames of simulated CPU, once
+static int slowRuns;
+static void slowOnceTask(void) {
+    if (slowRuns++ == 0) {
+        simClock.now += MINOR_FRAME_NS + MINOR_FRAME_NS / 2;
+    }
+}
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_Init(&executive, MINOR_FRAME_NS, 4));
+    traceLength = 0;
+    nReleases = 0;
+    slowRuns = 0;
+    trace[0] = '\0';
+    memset(&simClock, 0, sizeof(simClock));
+    simClock.now = 1000000000LL;
+}
+
+void tearDown(void) {
+    CyclicExecutive_Cleanup(&executive);
+}
+
+void test_init_rejects_bad_tables(void) {
+    CyclicExecutive other;
+
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_Init(&other, 0, 4));
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_Init(&other, MINOR_FRAME_NS, 0));
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_Init(&other, MINOR_FRAME_NS, CYCLIC_MAX_FRAMES + 1));
+    TEST_ASSERT_NULL(CyclicExecutive_Create(-1, 4));
+
+    int task = CyclicExecutive_addTask(&executive, "a", taskA);
+    TEST_ASSERT_EQUAL_INT(0, task);
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_addTask(&executive, "null", NULL));
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_assign(&executive, task, 4));
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_assign(&executive, task + 1, 0));
+    TEST_ASSERT_EQUAL_INT(-1, CyclicExecutive_assignEvery(&executive, task, 0, 0));
+}
+
+void test_tasks_run_in_their_frames_in_order(void) {
+    int a = CyclicExecutive_addTask(&executive, "a", taskA);
+    int b = CyclicExecutive_addTask(&executive, "b", taskB);
+    int c = CyclicExecutive_addTask(&executive, "c", taskC);
+
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assignEvery(&executive, a, 0, 2));  // frames 0 and 2
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assign(&executive, b, 1));
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assign(&executive, c, 2));        // after a in frame 2
+
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, 2));
+    trace[traceLength] = '\0';
+    TEST_ASSERT_EQUAL_STRING("ABACABAC", trace);
+    TEST_ASSERT_EQUAL_UINT(8, executive.framesRun);
+    TEST_ASSERT_EQUAL_UINT(4, executive.tasks[a].runs);
+    TEST_ASSERT_EQUAL_UINT(2, executive.tasks[c].runs);
+}
+
+void test_releases_stay_on_the_absolute_grid(void) {
+    int t = CyclicExecutive_addTask(&executive, "stamp", timestampTask);
+    long long start = simClock.now;
+
+    simClock.wakeLatencyNs[1] = 3000;    // Every fourth wake-up is on time, the others late
+    simClock.wakeLatencyNs[2] = 250000;
+    simClock.wakeLatencyNs[3] = 40000;
+    CyclicExecutive_setClock(&executive, simNow, simSleepUntil, &simClock);
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assignEvery(&executive, t, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, 8));
+    TEST_ASSERT_EQUAL_INT(32, nReleases);
+
+    // Release n is n + 1 minor frames after run started plus only its own
+    // wake-up latency: late wake-ups do not accumulate
+    for (int n = 0; n < nReleases; n++) {
+        long long expected = start + (long long)(n + 1) * MINOR_FRAME_NS + simClock.wakeLatencyNs[n % 4];
+        TEST_ASSERT_EQUAL_INT64(expected, releases[n]);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, executive.overruns);
+    TEST_ASSERT_EQUAL_INT64(250000, executive.maxJitterNs);
+    TEST_ASSERT_EQUAL_UINT(8, executive.jitter[0]);
+    TEST_ASSERT_EQUAL_UINT(8, executive.jitter[3]);
+    TEST_ASSERT_EQUAL_UINT(8, executive.jitter[40]);
+    TEST_ASSERT_EQUAL_UINT(8, executive.jitter[250]);
+    TEST_ASSERT_EQUAL_INT64(1000, CyclicExecutive_jitterPercentileNs(&executive, 25.0));
+    TEST_ASSERT_EQUAL_INT64(251000, CyclicExecutive_jitterPercentileNs(&executive, 100.0));
+}
+
+void test_overrun_is_counted_and_grid_is_kept(void) {
+    int slow = CyclicExecutive_addTask(&executive, "slow", slowOnceTask);
+    int stamp = CyclicExecutive_addTask(&executive, "stamp", timestampTask);
+    long long start = simClock.now;
+
+    CyclicExecutive_setClock(&executive, simNow, simSleepUntil, &simClock);
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assign(&executive, slow, 0));
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assignEvery(&executive, stamp, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, 2));
+
+    TEST_ASSERT_EQUAL_UINT(1, executive.overruns);
+    TEST_ASSERT_EQUAL_UINT(1, executive.frames[0].overruns);
+    TEST_ASSERT_EQUAL_INT64(MINOR_FRAME_NS + MINOR_FRAME_NS / 2, executive.tasks[slow].worstNs);
+    TEST_ASSERT_EQUAL_UINT(8, executive.framesRun);   // no frame skipped
+
+    // Frame 1 starts as soon as frame 0 finishes, after its release...
+    TEST_ASSERT_EQUAL_INT64(start + 2 * MINOR_FRAME_NS + MINOR_FRAME_NS / 2 + 100000, releases[1]);
+    TEST_ASSERT_EQUAL_INT64(MINOR_FRAME_NS / 2 + 100000, executive.maxJitterNs);
+
+    // ...and the frames after it are back on the grid
+    for (int n = 2; n < nReleases; n++) {
+        TEST_ASSERT_EQUAL_INT64(start + (long long)(n + 1) * MINOR_FRAME_NS, releases[n]);
+    }
+
+    CyclicExecutive_resetStatistics(&executive);
+    TEST_ASSERT_EQUAL_UINT(0, executive.overruns);
+    TEST_ASSERT_EQUAL_INT(0, (int)CyclicExecutive_jitterPercentileNs(&executive, 99.0));
+}
+
+static void* stopLater(void* arg) {
+    struct timespec pause = {0, 20 * 1000000L};
+    nanosleep(&pause, NULL);
+    CyclicExecutive_stop((CyclicExecutive*)arg);
+    return NULL;
+}
+
+void test_stop_ends_an_unbounded_run(void) {
+    pthread_t stopper;
+    int a = CyclicExecutive_addTask(&executive, "a", taskA);
+
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assign(&executive, a, 0));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&stopper, NULL, stopLater, &executive));
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, 0));
+    pthread_join(stopper, NULL);
+    TEST_ASSERT_TRUE(executive.framesRun >= 4);
+
+    // A stop before run ends it at the first release
+    CyclicExecutive_resetStatistics(&executive);
+    CyclicExecutive_stop(&executive);
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, 0));
+    TEST_ASSERT_EQUAL_UINT(0, executive.framesRun);
+}
+
+void test_jitter_percentiles_from_histogram(void) {
+    executive.jitter[0] = 90;     // < 1 us
+    executive.jitter[9] = 9;      // 9..10 us
+    executive.jitter[CYCLIC_JITTER_BUCKETS - 1] = 1;
+    executive.maxJitterNs = 5000000;
+
+    TEST_ASSERT_EQUAL_INT(1000, (int)CyclicExecutive_jitterPercentileNs(&executive, 50.0));
+    TEST_ASSERT_EQUAL_INT(10000, (int)CyclicExecutive_jitterPercentileNs(&executive, 99.0));
+    TEST_ASSERT_EQUAL_INT(5000000, (int)CyclicExecutive_jitterPercentileNs(&executive, 100.0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_rejects_bad_tables);
+    RUN_TEST(test_tasks_run_in_their_frames_in_order);
+    RUN_TEST(test_releases_stay_on_the_absolute_grid);
+    RUN_TEST(test_overrun_is_counted_and_grid_is_kept);
+    RUN_TEST(test_stop_ends_an_unbounded_run);
+    RUN_TEST(test_jitter_percentiles_from_histogram);
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "CyclicExecutive.h"
+
+/*
+    Release jitter and CPU use of the cyclic executive over 1 ms minor
+    frames, next to the old busy-wait epoch loop (start a timer, run, spin on
+    clock_gettime until the period is up) timed over the same frames.
+*/
+
+#define MINOR_FRAME_NS (1000000LL)
+#define FRAMES_PER_MAJOR 10
+#define MAJOR_FRAMES 200u
+
+static volatile unsigned long work;
+
+static void lightTask(void) {
+    for (int i = 0; i < 2000; i++) {
+        work += (unsigned long)i;
+    }
+}
+
+static double clockSeconds(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Reference: start-of-epoch timer plus a spin until the epoch has elapsed
+static double busyWaitCpuPercent(unsigned long frames) {
+    double wall = clockSeconds(CLOCK_MONOTONIC);
+    double cpu = clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+
+    for (unsigned long f = 0; f < frames; f++) {
+        long long start = nowNs();
+        lightTask();
+        while (nowNs() - start < MINOR_FRAME_NS) {
+        }
+    }
+    return 100.0 * (clockSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpu) / (clockSeconds(CLOCK_MONOTONIC) - wall);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_jitter_percentiles_and_cpu(void) {
+    static CyclicExecutive executive;
+    double wall;
+    double cpu;
+    double cyclicCpu;
+    double busyCpu;
+
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_Init(&executive, MINOR_FRAME_NS, FRAMES_PER_MAJOR));
+    int task = CyclicExecutive_addTask(&executive, "light", lightTask);
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_assignEvery(&executive, task, 0, 1));
+
+    wall = clockSeconds(CLOCK_MONOTONIC);
+    cpu = clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    TEST_ASSERT_EQUAL_INT(0, CyclicExecutive_run(&executive, MAJOR_FRAMES));
+    cyclicCpu = 100.0 * (clockSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpu) / (clockSeconds(CLOCK_MONOTONIC) - wall);
+    busyCpu = busyWaitCpuPercent((unsigned long)MAJOR_FRAMES * FRAMES_PER_MAJOR);
+
+    TEST_ASSERT_EQUAL_UINT((unsigned long)MAJOR_FRAMES * FRAMES_PER_MAJOR, executive.framesRun);
+    printf("\n  %lu frames of %lld us, %lu overruns\n", executive.framesRun, MINOR_FRAME_NS / 1000,
+           executive.overruns);
+    printf("  jitter us: p50 %lld  p90 %lld  p99 %lld  p99.9 %lld  max %.1f\n",
+           CyclicExecutive_jitterPercentileNs(&executive, 50.0) / 1000,
+           CyclicExecutive_jitterPercentileNs(&executive, 90.0) / 1000,
+           CyclicExecutive_jitterPercentileNs(&executive, 99.0) / 1000,
+           CyclicExecutive_jitterPercentileNs(&executive, 99.9) / 1000,
+           (double)executive.maxJitterNs / 1000.0);
+    printf("  CPU: cyclic executive %.1f%%, busy-wait epoch loop %.1f%%\n", cyclicCpu, busyCpu);
+    TEST_ASSERT_TRUE(cyclicCpu < busyCpu);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_jitter_percentiles_and_cpu);
+    return UNITY_END();
+}
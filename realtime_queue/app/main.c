@@ -26,6 +26,7 @@ int main() {
 
     // Set up component relationships
     GasController_setItsGasDisplay(controller, display);
+    GasController_setItsGasDataQueue(controller, queue);
     SensorThread_setItsGasDataQueue(sensorThread, queue);
 
     // Main simulation loop
@@ -37,10 +38,7 @@ int main() {
         SensorThread_updateData(sensorThread);
 
         // Process all data in queue
-        GasData data;
-        while (GasDataQueue_remove(queue, &data)) {
-            GasController_handleGasData(controller, &data);
-        }
+        GasController_process_data(controller);
 
         printf("\n");
         sleep(1);  // Wait a second between cycles
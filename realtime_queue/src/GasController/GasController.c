@@ -1,37 +1,68 @@
 #include "GasController.h"
 #include <stdio.h>
 
-GasController* GasController_create(void) {
-    GasController* controller = (GasController*)malloc(sizeof(GasController));
-    if (controller) {
-        controller->queue = GasDataQueue_create();
+void GasController_Init(GasController* const me) {
+    me->itsGasDisplay = NULL;
+    me->itsGasDataQueue = NULL;
+}
+
+void GasController_Cleanup(GasController* const me) {
+    // Display and queue are cleaned up by their owner
+    me->itsGasDisplay = NULL;
+    me->itsGasDataQueue = NULL;
+}
+
+GasController* GasController_Create(void) {
+    GasController* me = (GasController*) malloc(sizeof(GasController));
+    if (me != NULL) {
+        GasController_Init(me);
     }
-    return controller;
+    return me;
+}
+
+void GasController_Destroy(GasController* const me) {
+    if (me != NULL) {
+        GasController_Cleanup(me);
+    }
+    free(me);
+}
+
+void GasController_setItsGasDisplay(GasController* const me, struct GasDisplay* p_GasDisplay) {
+    me->itsGasDisplay = p_GasDisplay;
+}
+
+void GasController_setItsGasDataQueue(GasController* const me, struct GasDataQueue* p_GasDataQueue) {
+    me->itsGasDataQueue = p_GasDataQueue;
 }
 
-void GasController_destroy(GasController* controller) {
-    if (!controller) return;
-    
-    if (controller->queue) {
-        GasDataQueue_destroy(controller->queue);
+void GasController_handleGasData(GasController* const me, const GasData* data) {
+    if (!me || !data) return;
+
+    if (me->itsGasDisplay) {
+        GasDisplay_printGasData(me->itsGasDisplay, data->gType, data->conc, data->flowInCCPerMin);
+    } else {
+        GasData_print(data);  // Print the gas reading
     }
-    free(controller);
-}
-
-void GasController_process_data(GasController* controller) {
-    if (!controller || !controller->queue) return;
-    
-    // Process all data in queue
-    while (!GasDataQueue_is_empty(controller->queue)) {
-        GasData* data = GasDataQueue_pop(controller->queue);
-        if (data) {
-            GasData_print(data);  // Print the gas reading
-            GasData_destroy(data);
+}
+
+size_t GasController_process_data(GasController* const me) {
+    GasData batch[GAS_CONTROLLER_BATCH];
+    size_t total = 0;
+    size_t n;
+
+    if (!me || !me->itsGasDataQueue) return 0;
+
+    // Process all data in queue, one batch per pass over the shared slots
+    while ((n = GasDataQueue_remove_batch(me->itsGasDataQueue, batch, GAS_CONTROLLER_BATCH)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            GasController_handleGasData(me, &batch[i]);
         }
+        total += n;
     }
+    return total;
 }
 
-int GasController_add_data(GasController* controller, GasData* data) {
-    if (!controller || !controller->queue || !data) return 0;
-    return GasDataQueue_push(controller->queue, data);
+int GasController_add_data(GasController* const me, const GasData* data) {
+    if (!me || !me->itsGasDataQueue || !data) return 0;
+    return GasDataQueue_insert(me->itsGasDataQueue, *data);
 }
@@ -3,20 +3,34 @@
 
 #include "GasData.h"
 #include "GasDataQueue.h"
+#include "GasDisplay.h"
 
-// Simple gas controller that processes gas data from the queue
-typedef struct {
-    GasDataQueue* queue;  // Queue of gas data to process
-} GasController;
+#define GAS_CONTROLLER_BATCH 32   // Readings drained from the queue per remove_batch call
 
-// Controller operations
-GasController* GasController_create(void);
-void GasController_destroy(GasController* controller);
+// Gas controller: the single consumer of the GasDataQueue the sensor threads feed
+typedef struct GasController GasController;
+struct GasController {
+    struct GasDisplay* itsGasDisplay;       // Where readings are shown (optional)
+    struct GasDataQueue* itsGasDataQueue;   // Queue of gas data to process
+};
 
-// Process all gas data in queue
-void GasController_process_data(GasController* controller);
+/* Constructors and destructors */
+void GasController_Init(GasController* const me);
+void GasController_Cleanup(GasController* const me);
+GasController* GasController_Create(void);
+void GasController_Destroy(GasController* const me);
 
-// Add new gas data to process
-int GasController_add_data(GasController* controller, GasData* data);
+/* Operations */
+void GasController_setItsGasDisplay(GasController* const me, struct GasDisplay* p_GasDisplay);
+void GasController_setItsGasDataQueue(GasController* const me, struct GasDataQueue* p_GasDataQueue);
+
+// Handle one reading
+void GasController_handleGasData(GasController* const me, const GasData* data);
+
+// Drain the queue in batches; returns the number of readings handled
+size_t GasController_process_data(GasController* const me);
+
+// Add new gas data to process; returns 1 if queued, 0 if the queue was full
+int GasController_add_data(GasController* const me, const GasData* data);
 
 #endif
@@ -10,6 +10,7 @@ void GasData_Init(GasData* const me) {
     me->gType = UNKNOWN_GAS;
     me->conc = 0.0;
     me->flowInCCPerMin = 0;
+    me->timestamp = 0;
 }
 
 void GasData_Cleanup(GasData* const me) {
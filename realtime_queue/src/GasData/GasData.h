@@ -21,6 +21,7 @@ typedef struct GasData {
     GAS_TYPE gType;           // Type of gas
     double conc;              // Concentration of gas
     unsigned int flowInCCPerMin;  // Flow rate in CC/min
+    unsigned long long timestamp; // When the reading was taken, CLOCK_MONOTONIC ns (0 = unknown)
 } GasData;
 
 /* Constructors and destructors */
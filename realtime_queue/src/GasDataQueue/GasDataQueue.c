@@ -1,20 +1,66 @@
+#define _POSIX_C_SOURCE 200112L  // pthread_condattr_setclock, clock_gettime
+
 #include "GasDataQueue.h"
+#include <errno.h>
 #include <stdlib.h>
+#include <time.h>
+
+static unsigned char put(GasDataQueue* const me, GasData data, int countDrop);
+static void wakeConsumer(GasDataQueue* const me);
+static unsigned char waitForData(GasDataQueue* const me, GasData* data, const struct timespec* deadline);
 
 void GasDataQueue_Init(GasDataQueue* const me) {
+    GasDataQueue_InitCapacity(me, QUEUE_SIZE);
+}
+
+int GasDataQueue_InitCapacity(GasDataQueue* const me, size_t capacity) {
+    pthread_condattr_t attr;
+
+    me->cells = NULL;
+    me->mask = 0;
     me->head = 0;
     me->tail = 0;
-    me->count = 0;
+    me->dropped = 0;
+    me->overflows = 0;
+    me->full = 0;
+    me->waiting = 0;
+    pthread_mutex_init(&me->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&me->notEmpty, &attr);
+    pthread_condattr_destroy(&attr);
+
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+    me->cells = (GasDataCell*) malloc(capacity * sizeof(GasDataCell));
+    if (me->cells == NULL) {
+        return -1;
+    }
+    me->mask = capacity - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        me->cells[i].sequence = i;  // slot i is free for the producer of position i
+    }
+    return 0;
 }
 
 void GasDataQueue_Cleanup(GasDataQueue* const me) {
-    // Nothing to clean up for simple data structure
+    free(me->cells);
+    me->cells = NULL;
+    pthread_cond_destroy(&me->notEmpty);
+    pthread_mutex_destroy(&me->lock);
 }
 
 GasDataQueue* GasDataQueue_Create(void) {
+    return GasDataQueue_CreateCapacity(QUEUE_SIZE);
+}
+
+GasDataQueue* GasDataQueue_CreateCapacity(size_t capacity) {
     GasDataQueue* me = (GasDataQueue*) malloc(sizeof(GasDataQueue));
-    if (me != NULL) {
-        GasDataQueue_Init(me);
+    if (me != NULL && GasDataQueue_InitCapacity(me, capacity) != 0) {
+        GasDataQueue_Cleanup(me);
+        free(me);
+        me = NULL;
     }
     return me;
 }
@@ -27,33 +73,163 @@ void GasDataQueue_Destroy(GasDataQueue* const me) {
 }
 
 unsigned char GasDataQueue_insert(GasDataQueue* const me, GasData data) {
-    if (!me || me->count >= QUEUE_SIZE) {
-        return 0;  // Queue full
-    }
-    
-    me->queue[me->head] = data;  // Copy the data structure
-    me->head = (me->head + 1) % QUEUE_SIZE;
-    me->count++;
-    
+    return put(me, data, 1);
+}
+
+unsigned char GasDataQueue_tryInsert(GasDataQueue* const me, GasData data) {
+    return put(me, data, 0);
+}
+
+static unsigned char put(GasDataQueue* const me, GasData data, int countDrop) {
+    GasDataCell* cell;
+    size_t pos;
+
+    if (!me || !me->cells) {
+        return 0;
+    }
+
+    // Claim a position: the slot must have been released for this lap
+    pos = __atomic_load_n(&me->head, __ATOMIC_RELAXED);
+    for (;;) {
+        cell = &me->cells[pos & me->mask];
+        size_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        long diff = (long)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&me->head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The consumer has not freed this slot from the previous lap
+            if (countDrop) {
+                __atomic_fetch_add(&me->dropped, 1, __ATOMIC_RELAXED);
+                if (!__atomic_exchange_n(&me->full, 1, __ATOMIC_RELAXED)) {
+                    __atomic_fetch_add(&me->overflows, 1, __ATOMIC_RELAXED);
+                }
+            }
+            return 0;  // Queue full
+        } else {
+            pos = __atomic_load_n(&me->head, __ATOMIC_RELAXED);  // Another producer got it
+        }
+    }
+
+    cell->data = data;  // Copy the data structure
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+
+    // Pairs with the fence in waitForData: either the consumer sees the data
+    // or we see it waiting
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&me->waiting, __ATOMIC_RELAXED)) {
+        wakeConsumer(me);
+    }
     return 1;  // Success
 }
 
 unsigned char GasDataQueue_remove(GasDataQueue* const me, GasData* data) {
-    if (!me || !data || me->count == 0) {
-        return 0;  // Queue empty or invalid parameters
-    }
-    
-    *data = me->queue[me->tail];  // Copy out the data
-    me->tail = (me->tail + 1) % QUEUE_SIZE;
-    me->count--;
-    
-    return 1;  // Success
+    return (GasDataQueue_remove_batch(me, data, 1) == 1) ? 1 : 0;
+}
+
+size_t GasDataQueue_remove_batch(GasDataQueue* const me, GasData* out, size_t max) {
+    size_t pos;
+    size_t n = 0;
+
+    if (!me || !me->cells || !out) {
+        return 0;  // Invalid parameters
+    }
+
+    pos = me->tail;
+    while (n < max) {
+        GasDataCell* cell = &me->cells[pos & me->mask];
+        if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+            break;  // Empty, or the producer of this slot has not finished
+        }
+        out[n++] = cell->data;  // Copy out the data
+        // Free the slot for the producer one lap ahead
+        __atomic_store_n(&cell->sequence, pos + me->mask + 1, __ATOMIC_RELEASE);
+        pos++;
+    }
+    if (n > 0) {
+        __atomic_store_n(&me->tail, pos, __ATOMIC_RELAXED);
+        if (__atomic_load_n(&me->full, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&me->full, 0, __ATOMIC_RELAXED);  // Next rejection starts a new overflow
+        }
+    }
+    return n;
+}
+
+unsigned char GasDataQueue_removeBlocking(GasDataQueue* const me, GasData* data) {
+    if (GasDataQueue_remove(me, data)) {
+        return 1;
+    }
+    return (me && me->cells && data) ? waitForData(me, data, NULL) : 0;
+}
+
+unsigned char GasDataQueue_removeTimed(GasDataQueue* const me, GasData* data, long timeoutMs) {
+    struct timespec deadline;
+
+    if (GasDataQueue_remove(me, data)) {
+        return 1;
+    }
+    if (!me || !me->cells || !data || timeoutMs <= 0) {
+        return 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return waitForData(me, data, &deadline);
 }
 
 unsigned char GasDataQueue_isEmpty(const GasDataQueue* const me) {
-    return (!me || me->count == 0) ? 1 : 0;
+    if (!me || !me->cells) {
+        return 1;
+    }
+    return (__atomic_load_n(&me->head, __ATOMIC_RELAXED) == __atomic_load_n(&me->tail, __ATOMIC_RELAXED)) ? 1 : 0;
 }
 
 unsigned char GasDataQueue_isFull(const GasDataQueue* const me) {
-    return (me && me->count >= QUEUE_SIZE) ? 1 : 0;
+    if (!me || !me->cells) {
+        return 0;
+    }
+    return (__atomic_load_n(&me->head, __ATOMIC_RELAXED) - __atomic_load_n(&me->tail, __ATOMIC_RELAXED) > me->mask) ? 1 : 0;
+}
+
+size_t GasDataQueue_getCapacity(const GasDataQueue* const me) {
+    return (me && me->cells) ? me->mask + 1 : 0;
+}
+
+unsigned long GasDataQueue_getDropped(const GasDataQueue* const me) {
+    return me ? __atomic_load_n(&me->dropped, __ATOMIC_RELAXED) : 0;
+}
+
+unsigned long GasDataQueue_getOverflows(const GasDataQueue* const me) {
+    return me ? __atomic_load_n(&me->overflows, __ATOMIC_RELAXED) : 0;
+}
+
+/* slow path - only reached when a producer sees the consumer parked */
+static void wakeConsumer(GasDataQueue* const me) {
+    pthread_mutex_lock(&me->lock);
+    pthread_cond_signal(&me->notEmpty);
+    pthread_mutex_unlock(&me->lock);
+}
+
+static unsigned char waitForData(GasDataQueue* const me, GasData* data, const struct timespec* deadline) {
+    unsigned char found = 0;
+    int rc = 0;
+
+    pthread_mutex_lock(&me->lock);
+    __atomic_store_n(&me->waiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    // Re-check under the lock: a producer that published before seeing
+    // waiting == 1 would not signal
+    while (!(found = GasDataQueue_remove(me, data)) && rc != ETIMEDOUT) {
+        rc = (deadline != NULL) ? pthread_cond_timedwait(&me->notEmpty, &me->lock, deadline)
+                                : pthread_cond_wait(&me->notEmpty, &me->lock);
+    }
+    __atomic_store_n(&me->waiting, 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&me->lock);
+    return found;
 }
@@ -7,30 +7,72 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include "../GasData/GasData.h"
 
-#define QUEUE_SIZE 10
+/*
+    Bounded multi-producer / single-consumer queue of GasData.
+
+    Any number of sensor threads may insert at once; exactly one thread (the
+    GasController) removes. Insert and the non-blocking removes never take a
+    lock: every slot carries a sequence number that says whether it is free
+    for the producer of a given lap or holds data for the consumer. The mutex
+    and condition variable are only used to park the consumer when it asks
+    to block on an empty queue.
+
+    A full queue rejects the reading and counts it as dropped. Callers that
+    keep the reading and retry use tryInsert, which rejects without counting.
+*/
+
+#define QUEUE_SIZE 256          // Default capacity, must be a power of two
+
+typedef struct GasDataCell GasDataCell;
+struct GasDataCell {
+    size_t sequence;            // Lap stamp: pos = free for producer, pos + 1 = full
+    GasData data;
+};
 
 typedef struct GasDataQueue GasDataQueue;
 struct GasDataQueue {
-    int head;           // Index for insertion
-    int tail;           // Index for removal
-    int count;          // Number of elements in queue
-    GasData queue[QUEUE_SIZE];  // Circular buffer storing actual gas data
+    GasDataCell* cells;         // Circular buffer storing actual gas data
+    size_t mask;                // capacity - 1
+
+    /* producers */
+    size_t head __attribute__((aligned(64)));   // Next position to claim for insertion
+    unsigned long dropped;      // Readings rejected because the queue was full
+    unsigned long overflows;    // Times the queue went from not full to full
+    int full;                   // Set by the first rejected insert, cleared by remove
+
+    /* consumer */
+    size_t tail __attribute__((aligned(64)));   // Next position to remove
+    int waiting;                // Consumer is (about to be) parked on notEmpty
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
 };
 
 /* Constructor and destructor */
-void GasDataQueue_Init(GasDataQueue* const me);
+void GasDataQueue_Init(GasDataQueue* const me);                                // QUEUE_SIZE slots
+int GasDataQueue_InitCapacity(GasDataQueue* const me, size_t capacity);        // Returns 0, or -1 if capacity is not a power of two or no memory
 void GasDataQueue_Cleanup(GasDataQueue* const me);
 GasDataQueue* GasDataQueue_Create(void);
+GasDataQueue* GasDataQueue_CreateCapacity(size_t capacity);
 void GasDataQueue_Destroy(GasDataQueue* const me);
 
-/* Operations */
+/* Operations - insert from any thread */
 unsigned char GasDataQueue_insert(GasDataQueue* const me, GasData data);      // Returns 1 if successful, 0 if queue full
+unsigned char GasDataQueue_tryInsert(GasDataQueue* const me, GasData data);   // As insert, but a full queue is not a drop
+
+/* Operations - remove from the one consumer thread only */
 unsigned char GasDataQueue_remove(GasDataQueue* const me, GasData* data);     // Returns 1 if successful, 0 if queue empty
+unsigned char GasDataQueue_removeBlocking(GasDataQueue* const me, GasData* data);   // Waits until data arrives
+unsigned char GasDataQueue_removeTimed(GasDataQueue* const me, GasData* data, long timeoutMs);  // Returns 0 on timeout
+size_t GasDataQueue_remove_batch(GasDataQueue* const me, GasData* out, size_t max);     // Returns number removed
 
 /* Queue state checks */
 unsigned char GasDataQueue_isEmpty(const GasDataQueue* const me);
 unsigned char GasDataQueue_isFull(const GasDataQueue* const me);
+size_t GasDataQueue_getCapacity(const GasDataQueue* const me);
+unsigned long GasDataQueue_getDropped(const GasDataQueue* const me);
+unsigned long GasDataQueue_getOverflows(const GasDataQueue* const me);
 
 #endif //REALTIME_QUEUE_GASDATAQUEUE_H
@@ -5,6 +5,16 @@
 // Initialize random seed using static variable
 static int rngInitialized = 0;
 
+// xorshift32: per-sensor state, safe to run on many sensor threads at once
+static double nextNoise(GasSensorBase* const me) {
+    unsigned int x = me->noiseState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    me->noiseState = x;
+    return ((double)(x % 21) - 10.0) / 10.0; // ±1.0 noise
+}
+
 void GasSensorBase_Init(GasSensorBase* const me) {
     if (!rngInitialized) {
         srand((unsigned int)time(NULL));
@@ -15,6 +25,7 @@ void GasSensorBase_Init(GasSensorBase* const me) {
     me->flowRate = 0.0;
     me->health = 100;
     me->isInitialized = 1;
+    me->noiseState = (unsigned int)rand() | 1u;  // xorshift must not start at 0
 }
 
 void GasSensorBase_Cleanup(GasSensorBase* const me) {
@@ -26,10 +37,10 @@ void GasSensorBase_Update(GasSensorBase* const me) {
     if (!me->isInitialized) return;
     
     // Add random noise to readings
-    double noise = ((double)(rand() % 21) - 10.0) / 10.0; // ±1.0 noise
+    double noise = nextNoise(me);
     me->concentration += noise;
     
-    noise = ((double)(rand() % 21) - 10.0) / 10.0;
+    noise = nextNoise(me);
     me->flowRate += noise;
     
     // Keep values in reasonable ranges
@@ -9,6 +9,7 @@ typedef struct {
     double flowRate;      // Flow rate in CC/min
     int health;          // Sensor health (0-100)
     int isInitialized;   // Initialization status
+    unsigned int noiseState;  // Per-sensor noise generator, so sensor threads never share rand()
 } GasSensorBase;
 
 // Standard interface functions all sensors must implement
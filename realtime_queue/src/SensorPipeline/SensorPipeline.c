@@ -0,0 +1,357 @@
+//
+// Sharded sensor pipeline: one producer thread per sensor, one queue per gas type.
+// Merged runs give every sensor its own queue instead.
+//
+
+#define _GNU_SOURCE  // pthread_setaffinity_np
+
+#include "SensorPipeline.h"
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ConsumerArgs {
+    SensorPipeline* me;
+    int shard;
+} ConsumerArgs;
+
+static int shardOf(GAS_TYPE gType);
+static void pinThread(SensorPipeline* const me, int cpu);
+static unsigned long long nowNs(void);
+static void takeReading(PipelineSensor* const s, GasData* g);
+static void* producerThread(void* arg);
+static void* consumerThread(void* arg);
+static void drainShard(SensorPipeline* const me, int shard);
+static void mergeLanes(SensorPipeline* const me);
+
+int SensorPipeline_Init(SensorPipeline* const me, int maxSensors, size_t queueCapacity) {
+    int s;
+
+    memset(me, 0, sizeof(*me));
+    for (s = 0; s < PIPELINE_SHARDS; s++) {
+        if (GasDataQueue_InitCapacity(&me->shards[s], queueCapacity) != 0) {
+            while (s >= 0) {
+                GasDataQueue_Cleanup(&me->shards[s--]);
+            }
+            return -1;
+        }
+        me->consumerCpu[s] = PIPELINE_NO_CPU;
+    }
+    me->sensors = (maxSensors > 0) ? (PipelineSensor*) calloc((size_t)maxSensors, sizeof(PipelineSensor)) : NULL;
+    if (me->sensors == NULL) {
+        for (s = 0; s < PIPELINE_SHARDS; s++) {
+            GasDataQueue_Cleanup(&me->shards[s]);
+        }
+        return -1;
+    }
+    me->maxSensors = maxSensors;
+    me->queueCapacity = queueCapacity;
+    return 0;
+}
+
+void SensorPipeline_Cleanup(SensorPipeline* const me) {
+    int i;
+
+    for (i = 0; i < me->nSensors; i++) {
+        PipelineSensor* s = &me->sensors[i];
+        switch (s->gType) {
+            case O2_GAS: O2Sensor_Cleanup(&s->sensor.o2); break;
+            case N2_GAS: N2Sensor_Cleanup(&s->sensor.n2); break;
+            default:     HeSensor_Cleanup(&s->sensor.he); break;
+        }
+        GasDataQueue_Cleanup(&s->lane);
+    }
+    for (i = 0; i < PIPELINE_SHARDS; i++) {
+        GasDataQueue_Cleanup(&me->shards[i]);
+    }
+    free(me->sensors);
+    me->sensors = NULL;
+    me->nSensors = 0;
+}
+
+SensorPipeline* SensorPipeline_Create(int maxSensors, size_t queueCapacity) {
+    SensorPipeline* me = (SensorPipeline*) malloc(sizeof(SensorPipeline));
+    if (me != NULL && SensorPipeline_Init(me, maxSensors, queueCapacity) != 0) {
+        free(me);
+        me = NULL;
+    }
+    return me;
+}
+
+void SensorPipeline_Destroy(SensorPipeline* const me) {
+    if (me != NULL) {
+        SensorPipeline_Cleanup(me);
+    }
+    free(me);
+}
+
+int SensorPipeline_addSensor(SensorPipeline* const me, GAS_TYPE gType, int cpu) {
+    PipelineSensor* s;
+
+    if (shardOf(gType) < 0 || me->nSensors >= me->maxSensors) {
+        return -1;
+    }
+    s = &me->sensors[me->nSensors];
+    if (GasDataQueue_InitCapacity(&s->lane, me->queueCapacity) != 0) {
+        GasDataQueue_Cleanup(&s->lane);
+        return -1;
+    }
+    s->gType = gType;
+    s->cpu = cpu;
+    s->owner = me;
+    switch (gType) {
+        case O2_GAS: O2Sensor_Init(&s->sensor.o2); break;
+        case N2_GAS: N2Sensor_Init(&s->sensor.n2); break;
+        default:     HeSensor_Init(&s->sensor.he); break;
+    }
+    return me->nSensors++;
+}
+
+void SensorPipeline_setHandler(SensorPipeline* const me, void* instance, GasDataHandler handler) {
+    me->instance = instance;
+    me->handler = handler;
+}
+
+void SensorPipeline_setConsumerCpu(SensorPipeline* const me, GAS_TYPE gType, int cpu) {
+    int shard = shardOf(gType);
+    if (shard >= 0) {
+        me->consumerCpu[shard] = cpu;
+    }
+}
+
+/* operation run(unsigned long, PipelineMode) */
+int SensorPipeline_run(SensorPipeline* const me, unsigned long readingsPerSensor, PipelineMode mode) {
+    pthread_t* producers = (pthread_t*) malloc(sizeof(pthread_t) * (size_t)(me->nSensors + 1));
+    pthread_t consumers[PIPELINE_SHARDS];
+    ConsumerArgs args[PIPELINE_SHARDS];
+    int consumerStarted[PIPELINE_SHARDS] = {0};
+    int started = 0;
+    int status = 0;
+    int i;
+
+    if (producers == NULL) {
+        return -1;
+    }
+    for (i = 0; i < PIPELINE_SHARDS; i++) {
+        me->shardProducers[i] = 0;
+    }
+    me->mode = mode;
+    for (i = 0; i < me->nSensors; i++) {
+        PipelineSensor* s = &me->sensors[i];
+        s->target = readingsPerSensor;
+        s->retries = 0;
+        s->producing = 1;
+        s->pos = 0;
+        s->len = 0;
+        s->drained = 0;
+        me->shardProducers[shardOf(s->gType)]++;
+    }
+    for (i = 0; i < me->nSensors; i++) {
+        if (pthread_create(&producers[started], NULL, producerThread, &me->sensors[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    for (i = started; i < me->nSensors; i++) {
+        // Never started: its shard and lane must not wait for it
+        __atomic_sub_fetch(&me->shardProducers[shardOf(me->sensors[i].gType)], 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&me->sensors[i].producing, 0, __ATOMIC_RELEASE);
+        status = -1;
+    }
+
+    if (mode == PIPELINE_PARALLEL) {
+        for (i = 0; i < PIPELINE_SHARDS; i++) {
+            args[i].me = me;
+            args[i].shard = i;
+            consumerStarted[i] = (pthread_create(&consumers[i], NULL, consumerThread, &args[i]) == 0);
+        }
+        for (i = 0; i < PIPELINE_SHARDS; i++) {
+            if (consumerStarted[i]) {
+                pthread_join(consumers[i], NULL);
+            } else {
+                drainShard(me, i);  // No thread for this shard: drain it here
+            }
+        }
+    } else {
+        mergeLanes(me);
+    }
+
+    for (i = 0; i < started; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    free(producers);
+    return status;
+}
+
+unsigned long SensorPipeline_getConsumed(const SensorPipeline* const me, GAS_TYPE gType) {
+    int shard = shardOf(gType);
+    return (shard >= 0) ? me->consumed[shard] : 0;
+}
+
+unsigned long SensorPipeline_getRetries(const SensorPipeline* const me, GAS_TYPE gType) {
+    unsigned long retries = 0;
+
+    for (int i = 0; i < me->nSensors; i++) {
+        if (me->sensors[i].gType == gType) {
+            retries += me->sensors[i].retries;
+        }
+    }
+    return retries;
+}
+
+GasDataQueue* SensorPipeline_getQueue(SensorPipeline* const me, GAS_TYPE gType) {
+    int shard = shardOf(gType);
+    return (shard >= 0) ? &me->shards[shard] : NULL;
+}
+
+static int shardOf(GAS_TYPE gType) {
+    return (gType >= O2_GAS && gType <= HE_GAS) ? (int)gType - 1 : -1;
+}
+
+static void pinThread(SensorPipeline* const me, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (cpu < 0) {
+        return;
+    }
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        __atomic_fetch_add(&me->pinFailures, 1, __ATOMIC_RELAXED);
+    }
+#else
+    if (cpu >= 0) {
+        __atomic_fetch_add(&me->pinFailures, 1, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+static unsigned long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+static void takeReading(PipelineSensor* const s, GasData* g) {
+    GasSensorBase* base;
+
+    switch (s->gType) {
+        case O2_GAS: O2Sensor_Update(&s->sensor.o2); base = &s->sensor.o2.base; break;
+        case N2_GAS: N2Sensor_Update(&s->sensor.n2); base = &s->sensor.n2.base; break;
+        default:     HeSensor_Update(&s->sensor.he); base = &s->sensor.he.base; break;
+    }
+    g->gType = s->gType;
+    g->conc = base->concentration;
+    g->flowInCCPerMin = (unsigned int)base->flowRate;
+    g->timestamp = nowNs();
+}
+
+/* producer: one sensor, feeding the queue of its gas type, or its own lane when merged */
+static void* producerThread(void* arg) {
+    PipelineSensor* s = (PipelineSensor*) arg;
+    SensorPipeline* me = s->owner;
+    int shard = shardOf(s->gType);
+    GasDataQueue* q = (me->mode == PIPELINE_MERGED) ? &s->lane : &me->shards[shard];
+    GasData g;
+
+    pinThread(me, s->cpu);
+    GasData_Init(&g);
+    for (unsigned long i = 0; i < s->target; i++) {
+        takeReading(s, &g);
+        while (!GasDataQueue_tryInsert(q, g)) {
+            s->retries++;
+            sched_yield();  // Queue full: let the consumer catch up
+        }
+    }
+    __atomic_sub_fetch(&me->shardProducers[shard], 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&s->producing, 0, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* consumerThread(void* arg) {
+    ConsumerArgs* args = (ConsumerArgs*) arg;
+
+    pinThread(args->me, args->me->consumerCpu[args->shard]);
+    drainShard(args->me, args->shard);
+    return NULL;
+}
+
+/* parallel mode: one shard, batch by batch, until its producers are done */
+static void drainShard(SensorPipeline* const me, int shard) {
+    GasDataQueue* q = &me->shards[shard];
+    GasData batch[PIPELINE_BATCH];
+    size_t n;
+
+    for (;;) {
+        n = GasDataQueue_remove_batch(q, batch, PIPELINE_BATCH);
+        if (n == 0) {
+            if (__atomic_load_n(&me->shardProducers[shard], __ATOMIC_ACQUIRE) == 0) {
+                n = GasDataQueue_remove_batch(q, batch, PIPELINE_BATCH);  // Last inserts
+                if (n == 0) {
+                    break;
+                }
+            } else if (GasDataQueue_removeTimed(q, batch, 1)) {
+                n = 1;
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (me->handler) {
+                me->handler(me->instance, &batch[i]);
+            }
+        }
+        me->consumed[shard] += n;
+    }
+}
+
+/* merged mode: k-way merge of the lane heads on the calling thread. A lane
+   has one producer, so it is in timestamp order and its head is the oldest
+   reading that sensor will ever deliver; a shard fed by several sensors is
+   not, because a producer can be preempted between reading the clock and
+   inserting. */
+static void mergeLanes(SensorPipeline* const me) {
+    for (;;) {
+        PipelineSensor* lagging = NULL;
+        PipelineSensor* oldest = NULL;
+
+        for (int i = 0; i < me->nSensors; i++) {
+            PipelineSensor* s = &me->sensors[i];
+            if (s->pos < s->len || s->drained) {
+                continue;
+            }
+            s->pos = 0;
+            s->len = GasDataQueue_remove_batch(&s->lane, s->buffered, PIPELINE_BATCH);
+            if (s->len == 0) {
+                if (__atomic_load_n(&s->producing, __ATOMIC_ACQUIRE)) {
+                    lagging = s;  // Its next reading may be the oldest of all
+                } else {
+                    s->len = GasDataQueue_remove_batch(&s->lane, s->buffered, PIPELINE_BATCH);
+                    s->drained = (s->len == 0);
+                }
+            }
+        }
+        if (lagging != NULL) {
+            if (GasDataQueue_removeTimed(&lagging->lane, lagging->buffered, 1)) {
+                lagging->pos = 0;
+                lagging->len = 1;
+            }
+            continue;
+        }
+        for (int i = 0; i < me->nSensors; i++) {
+            PipelineSensor* s = &me->sensors[i];
+            if (s->pos < s->len &&
+                (oldest == NULL || s->buffered[s->pos].timestamp < oldest->buffered[oldest->pos].timestamp)) {
+                oldest = s;
+            }
+        }
+        if (oldest == NULL) {
+            break;  // Every lane done and drained
+        }
+        if (me->handler) {
+            me->handler(me->instance, &oldest->buffered[oldest->pos]);
+        }
+        oldest->pos++;
+        me->consumed[shardOf(oldest->gType)]++;
+    }
+}
@@ -0,0 +1,90 @@
+//
+// Sharded sensor pipeline: one producer thread per sensor, one queue per gas type.
+// Merged runs give every sensor its own queue instead, so that each queue holds
+// one producer's readings in timestamp order.
+//
+
+#ifndef REALTIME_QUEUE_SENSORPIPELINE_H
+#define REALTIME_QUEUE_SENSORPIPELINE_H
+
+#include <pthread.h>
+#include "../GasData/GasData.h"
+#include "../GasDataQueue/GasDataQueue.h"
+#include "../O2Sensor/O2Sensor.h"
+#include "../N2Sensor/N2Sensor.h"
+#include "../HeSensor/HeSensor.h"
+
+#define PIPELINE_SHARDS 3              // One GasDataQueue per gas type: O2, N2, He
+#define PIPELINE_BATCH 64              // Readings a consumer drains per remove_batch
+#define PIPELINE_NO_CPU (-1)           // Leave a thread unpinned
+
+/* Consumer side */
+typedef enum {
+    PIPELINE_PARALLEL,                 // One consumer thread per gas type, no ordering across types
+    PIPELINE_MERGED                    // The calling thread merges all sensors by timestamp
+} PipelineMode;
+
+typedef void (*GasDataHandler)(void* instance, const GasData* data);
+
+typedef struct PipelineSensor PipelineSensor;
+struct PipelineSensor {
+    GAS_TYPE gType;
+    union {
+        O2Sensor o2;
+        N2Sensor n2;
+        HeSensor he;
+    } sensor;
+    int cpu;                           // Core the producer thread is pinned to, or PIPELINE_NO_CPU
+    unsigned long target;              // Readings to produce in the current run
+    unsigned long retries;             // Inserts retried in the current run because the queue was full
+    int producing;                     // Cleared by the producer thread when it is done
+    struct SensorPipeline* owner;
+
+    /* merged mode: this sensor's own queue and the merger's view of it */
+    GasDataQueue lane;
+    GasData buffered[PIPELINE_BATCH];
+    size_t pos;
+    size_t len;
+    int drained;
+};
+
+typedef struct SensorPipeline SensorPipeline;
+struct SensorPipeline {
+    GasDataQueue shards[PIPELINE_SHARDS];
+    int shardProducers[PIPELINE_SHARDS];     // Producer threads still running, per shard
+    int consumerCpu[PIPELINE_SHARDS];        // Pinning of the parallel consumers
+    unsigned long consumed[PIPELINE_SHARDS]; // Readings handed to the handler, per shard
+    PipelineSensor* sensors;
+    int nSensors;
+    int maxSensors;
+    int pinFailures;                         // Threads that could not be pinned
+    size_t queueCapacity;                    // Of every shard and lane
+    PipelineMode mode;                       // Of the current run
+    GasDataHandler handler;
+    void* instance;
+};
+
+/* Constructors and destructors */
+int SensorPipeline_Init(SensorPipeline* const me, int maxSensors, size_t queueCapacity);   // Returns 0, or -1 on bad capacity / no memory
+void SensorPipeline_Cleanup(SensorPipeline* const me);
+SensorPipeline* SensorPipeline_Create(int maxSensors, size_t queueCapacity);
+void SensorPipeline_Destroy(SensorPipeline* const me);
+
+/* Configuration - before run */
+int SensorPipeline_addSensor(SensorPipeline* const me, GAS_TYPE gType, int cpu);       // Returns sensor index, or -1
+void SensorPipeline_setHandler(SensorPipeline* const me, void* instance, GasDataHandler handler);
+void SensorPipeline_setConsumerCpu(SensorPipeline* const me, GAS_TYPE gType, int cpu);
+
+/* Operations */
+// Every sensor produces readingsPerSensor readings on its own thread. A full
+// queue applies back-pressure (the producer yields and retries), so nothing
+// is lost: SensorPipeline_getRetries counts those retries and the queues'
+// dropped counters stay at zero. Returns 0, or -1 if a thread could not be
+// started.
+int SensorPipeline_run(SensorPipeline* const me, unsigned long readingsPerSensor, PipelineMode mode);
+
+unsigned long SensorPipeline_getConsumed(const SensorPipeline* const me, GAS_TYPE gType);
+unsigned long SensorPipeline_getRetries(const SensorPipeline* const me, GAS_TYPE gType);   // Of the last run
+GasDataQueue* SensorPipeline_getQueue(SensorPipeline* const me, GAS_TYPE gType);
+
+#endif //REALTIME_QUEUE_SENSORPIPELINE_H
@@ -0,0 +1,220 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "GasDataQueue.h"
+#include "GasController.h"
+
+#define STRESS_PRODUCERS 4
+#define STRESS_READINGS 200000u
+
+// Test fixtures
+GasDataQueue* p_GasDataQueue;
+
+void setUp(void) {
+    p_GasDataQueue = GasDataQueue_CreateCapacity(8);
+}
+
+void tearDown(void) {
+    GasDataQueue_Destroy(p_GasDataQueue);
+}
+
+static GasData makeReading(GAS_TYPE type, unsigned int flow) {
+    GasData g;
+    GasData_Init(&g);
+    g.gType = type;
+    g.conc = flow * 0.5;
+    g.flowInCCPerMin = flow;
+    return g;
+}
+
+static double elapsedMs(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 + (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+void test_capacity_must_be_power_of_two(void) {
+    TEST_ASSERT_NULL(GasDataQueue_CreateCapacity(10));
+    TEST_ASSERT_NULL(GasDataQueue_CreateCapacity(1));
+    TEST_ASSERT_EQUAL_UINT(8, GasDataQueue_getCapacity(p_GasDataQueue));
+
+    GasDataQueue* defaultQueue = GasDataQueue_Create();
+    TEST_ASSERT_NOT_NULL(defaultQueue);
+    TEST_ASSERT_EQUAL_UINT(QUEUE_SIZE, GasDataQueue_getCapacity(defaultQueue));
+    GasDataQueue_Destroy(defaultQueue);
+}
+
+void test_remove_copies_out_in_fifo_order(void) {
+    GasData out;
+
+    TEST_ASSERT_TRUE(GasDataQueue_isEmpty(p_GasDataQueue));
+    TEST_ASSERT_FALSE(GasDataQueue_remove(p_GasDataQueue, &out));
+    TEST_ASSERT_TRUE(GasDataQueue_insert(p_GasDataQueue, makeReading(O2_GAS, 1)));
+    TEST_ASSERT_TRUE(GasDataQueue_insert(p_GasDataQueue, makeReading(HE_GAS, 2)));
+
+    TEST_ASSERT_TRUE(GasDataQueue_remove(p_GasDataQueue, &out));
+    TEST_ASSERT_EQUAL(O2_GAS, out.gType);
+    TEST_ASSERT_EQUAL_UINT(1, out.flowInCCPerMin);
+    TEST_ASSERT_TRUE(GasDataQueue_remove(p_GasDataQueue, &out));
+    TEST_ASSERT_EQUAL(HE_GAS, out.gType);
+    TEST_ASSERT_EQUAL_UINT(2, out.flowInCCPerMin);
+    TEST_ASSERT_TRUE(GasDataQueue_isEmpty(p_GasDataQueue));
+}
+
+void test_full_queue_counts_drops_and_overflows(void) {
+    GasData out;
+
+    for (unsigned int i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(GasDataQueue_insert(p_GasDataQueue, makeReading(N2_GAS, i)));
+    }
+    TEST_ASSERT_TRUE(GasDataQueue_isFull(p_GasDataQueue));
+    TEST_ASSERT_FALSE(GasDataQueue_insert(p_GasDataQueue, makeReading(N2_GAS, 8)));
+    TEST_ASSERT_FALSE(GasDataQueue_insert(p_GasDataQueue, makeReading(N2_GAS, 9)));
+    TEST_ASSERT_EQUAL_UINT(2, GasDataQueue_getDropped(p_GasDataQueue));
+    TEST_ASSERT_EQUAL_UINT(1, GasDataQueue_getOverflows(p_GasDataQueue));
+
+    // Freeing a slot ends the overflow; the next rejection starts another
+    TEST_ASSERT_TRUE(GasDataQueue_remove(p_GasDataQueue, &out));
+    TEST_ASSERT_EQUAL_UINT(0, out.flowInCCPerMin);
+    TEST_ASSERT_TRUE(GasDataQueue_insert(p_GasDataQueue, makeReading(N2_GAS, 10)));
+    TEST_ASSERT_FALSE(GasDataQueue_insert(p_GasDataQueue, makeReading(N2_GAS, 11)));
+    TEST_ASSERT_EQUAL_UINT(3, GasDataQueue_getDropped(p_GasDataQueue));
+    TEST_ASSERT_EQUAL_UINT(2, GasDataQueue_getOverflows(p_GasDataQueue));
+}
+
+void test_remove_batch_drains_across_the_wrap(void) {
+    GasData out[8];
+
+    for (unsigned int lap = 0; lap < 3; lap++) {
+        for (unsigned int i = 0; i < 6; i++) {
+            TEST_ASSERT_TRUE(GasDataQueue_insert(p_GasDataQueue, makeReading(O2_GAS, lap * 10 + i)));
+        }
+        TEST_ASSERT_EQUAL_UINT(4, GasDataQueue_remove_batch(p_GasDataQueue, out, 4));
+        TEST_ASSERT_EQUAL_UINT(lap * 10 + 3, out[3].flowInCCPerMin);
+        TEST_ASSERT_EQUAL_UINT(2, GasDataQueue_remove_batch(p_GasDataQueue, out, 8));
+        TEST_ASSERT_EQUAL_UINT(lap * 10 + 5, out[1].flowInCCPerMin);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, GasDataQueue_remove_batch(p_GasDataQueue, out, 8));
+}
+
+void test_timed_remove_times_out_on_empty_queue(void) {
+    struct timespec start;
+    GasData out;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TEST_ASSERT_FALSE(GasDataQueue_removeTimed(p_GasDataQueue, &out, 20));
+    TEST_ASSERT_TRUE(elapsedMs(&start) >= 19.0);
+}
+
+static void* delayedProducer(void* arg) {
+    struct timespec pause = {0, 20 * 1000000L};
+    nanosleep(&pause, NULL);
+    GasDataQueue_insert((GasDataQueue*)arg, makeReading(HE_GAS, 42));
+    return NULL;
+}
+
+void test_blocking_remove_wakes_on_insert(void) {
+    pthread_t producer;
+    GasData out;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, delayedProducer, p_GasDataQueue));
+    TEST_ASSERT_TRUE(GasDataQueue_removeBlocking(p_GasDataQueue, &out));
+    TEST_ASSERT_EQUAL_UINT(42, out.flowInCCPerMin);
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, delayedProducer, p_GasDataQueue));
+    TEST_ASSERT_TRUE(GasDataQueue_removeTimed(p_GasDataQueue, &out, 5000));
+    TEST_ASSERT_EQUAL(HE_GAS, out.gType);
+    pthread_join(producer, NULL);
+}
+
+void test_controller_drains_queue_in_batches(void) {
+    GasDataQueue* queue = GasDataQueue_CreateCapacity(128);
+    GasController* controller = GasController_Create();
+
+    GasController_setItsGasDataQueue(controller, queue);
+    for (unsigned int i = 0; i < 100; i++) {
+        GasData g = makeReading(O2_GAS, i);
+        TEST_ASSERT_TRUE(GasController_add_data(controller, &g));
+    }
+    TEST_ASSERT_EQUAL_UINT(100, GasController_process_data(controller));
+    TEST_ASSERT_TRUE(GasDataQueue_isEmpty(queue));
+
+    GasController_Destroy(controller);
+    GasDataQueue_Destroy(queue);
+}
+
+/* Stress: producers tag readings with (id, sequence) and retry when full */
+typedef struct {
+    GasDataQueue* queue;
+    unsigned int id;
+    unsigned long retries;
+} Producer;
+
+static void* stressProducer(void* arg) {
+    Producer* p = (Producer*)arg;
+    for (unsigned int seq = 0; seq < STRESS_READINGS; seq++) {
+        GasData g = makeReading((GAS_TYPE)(1 + p->id % 3), (p->id << 24) | seq);
+        while (!GasDataQueue_insert(p->queue, g)) {
+            p->retries++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void test_multi_producer_stress_keeps_every_reading_in_order(void) {
+    GasDataQueue* queue = GasDataQueue_CreateCapacity(64);
+    pthread_t threads[STRESS_PRODUCERS];
+    Producer producers[STRESS_PRODUCERS];
+    unsigned int next[STRESS_PRODUCERS] = {0};
+    unsigned long retries = 0;
+    unsigned long received = 0;
+    GasData batch[16];
+
+    for (unsigned int i = 0; i < STRESS_PRODUCERS; i++) {
+        producers[i].queue = queue;
+        producers[i].id = i;
+        producers[i].retries = 0;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, stressProducer, &producers[i]));
+    }
+    while (received < (unsigned long)STRESS_PRODUCERS * STRESS_READINGS) {
+        size_t n = GasDataQueue_remove_batch(queue, batch, 16);
+        if (n == 0) {
+            TEST_ASSERT_TRUE(GasDataQueue_removeTimed(queue, &batch[0], 5000));
+            n = 1;
+        }
+        for (size_t i = 0; i < n; i++) {
+            unsigned int id = batch[i].flowInCCPerMin >> 24;
+            unsigned int seq = batch[i].flowInCCPerMin & 0xFFFFFFu;
+            TEST_ASSERT_TRUE(id < STRESS_PRODUCERS);
+            TEST_ASSERT_EQUAL_UINT(next[id], seq);       // per-producer FIFO, nothing lost
+            TEST_ASSERT_EQUAL_DOUBLE(batch[i].flowInCCPerMin * 0.5, batch[i].conc);  // no torn copies
+            next[id]++;
+        }
+        received += n;
+    }
+    for (unsigned int i = 0; i < STRESS_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+        retries += producers[i].retries;
+    }
+    TEST_ASSERT_TRUE(GasDataQueue_isEmpty(queue));
+    TEST_ASSERT_EQUAL_UINT(retries, GasDataQueue_getDropped(queue));
+    GasDataQueue_Destroy(queue);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_capacity_must_be_power_of_two);
+    RUN_TEST(test_remove_copies_out_in_fifo_order);
+    RUN_TEST(test_full_queue_counts_drops_and_overflows);
+    RUN_TEST(test_remove_batch_drains_across_the_wrap);
+    RUN_TEST(test_timed_remove_times_out_on_empty_queue);
+    RUN_TEST(test_blocking_remove_wakes_on_insert);
+    RUN_TEST(test_controller_drains_queue_in_batches);
+    RUN_TEST(test_multi_producer_stress_keeps_every_reading_in_order);
+    return UNITY_END();
+}
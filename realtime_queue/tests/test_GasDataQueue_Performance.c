@@ -0,0 +1,152 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include "GasDataQueue.h"
+
+/*
+    Throughput of the MPSC GasDataQueue with 1, 2 and 4 producers feeding
+    one consumer, draining one reading at a time and in batches. A ring
+    guarded by one pthread mutex, the usual way to make the old queue
+    thread-safe, is timed the same way as the reference.
+*/
+
+#define READINGS_PER_RUN 2000000u
+#define CAPACITY 1024u
+#define BATCH 64u
+
+typedef enum { DRAIN_SINGLE, DRAIN_BATCH, DRAIN_MUTEX } DrainMode;
+
+/* reference: mutex-guarded ring */
+typedef struct {
+    pthread_mutex_t lock;
+    GasData cells[CAPACITY];
+    size_t head;
+    size_t tail;
+} LockedRing;
+
+static int lockedInsert(LockedRing* r, GasData g) {
+    int ok = 0;
+    pthread_mutex_lock(&r->lock);
+    if (r->head - r->tail < CAPACITY) {
+        r->cells[r->head++ % CAPACITY] = g;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&r->lock);
+    return ok;
+}
+
+static size_t lockedRemoveBatch(LockedRing* r, GasData* out, size_t max) {
+    size_t n = 0;
+    pthread_mutex_lock(&r->lock);
+    while (n < max && r->tail != r->head) {
+        out[n++] = r->cells[r->tail++ % CAPACITY];
+    }
+    pthread_mutex_unlock(&r->lock);
+    return n;
+}
+
+typedef struct {
+    GasDataQueue* queue;
+    LockedRing* ring;
+    unsigned int count;
+} ProducerArgs;
+
+static void* producer(void* arg) {
+    ProducerArgs* a = (ProducerArgs*)arg;
+    GasData g;
+    GasData_Init(&g);
+    g.gType = O2_GAS;
+    for (unsigned int i = 0; i < a->count; i++) {
+        g.flowInCCPerMin = i;
+        while (a->ring ? !lockedInsert(a->ring, g) : !GasDataQueue_insert(a->queue, g)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Returns readings per second; checks every reading arrived */
+static double run(unsigned int producers, DrainMode mode) {
+    static LockedRing ring;
+    GasDataQueue* queue = GasDataQueue_CreateCapacity(CAPACITY);
+    pthread_t threads[4];
+    ProducerArgs args[4];
+    GasData out[BATCH];
+    unsigned long received = 0;
+    unsigned long checksum = 0;
+    unsigned long expected = 0;
+    double start;
+    double elapsed;
+
+    TEST_ASSERT_NOT_NULL(queue);
+    pthread_mutex_init(&ring.lock, NULL);
+    ring.head = ring.tail = 0;
+
+    start = seconds();
+    for (unsigned int p = 0; p < producers; p++) {
+        args[p].queue = queue;
+        args[p].ring = (mode == DRAIN_MUTEX) ? &ring : NULL;
+        args[p].count = READINGS_PER_RUN / producers;
+        expected += (unsigned long)args[p].count * (args[p].count - 1) / 2;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[p], NULL, producer, &args[p]));
+    }
+    while (received < (READINGS_PER_RUN / producers) * producers) {
+        size_t n;
+        switch (mode) {
+            case DRAIN_SINGLE: n = GasDataQueue_remove(queue, out); break;
+            case DRAIN_BATCH:  n = GasDataQueue_remove_batch(queue, out, BATCH); break;
+            default:           n = lockedRemoveBatch(&ring, out, BATCH); break;
+        }
+        if (n == 0) {
+            sched_yield();
+        }
+        for (size_t i = 0; i < n; i++) {
+            checksum += out[i].flowInCCPerMin;
+        }
+        received += n;
+    }
+    for (unsigned int p = 0; p < producers; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    elapsed = seconds() - start;
+
+    TEST_ASSERT_EQUAL_UINT(expected, checksum);
+    pthread_mutex_destroy(&ring.lock);
+    GasDataQueue_Destroy(queue);
+    return (double)received / elapsed;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_mpsc_throughput(void) {
+    static const unsigned int producerCounts[] = {1, 2, 4};
+
+    printf("\n  %-9s %16s %16s %16s\n", "producers", "mutex ring M/s", "remove M/s", "remove_batch M/s");
+    for (size_t i = 0; i < sizeof(producerCounts) / sizeof(producerCounts[0]); i++) {
+        unsigned int p = producerCounts[i];
+        double locked = run(p, DRAIN_MUTEX);
+        double single = run(p, DRAIN_SINGLE);
+        double batch = run(p, DRAIN_BATCH);
+        printf("  %-9u %16.2f %16.2f %16.2f\n", p, locked / 1e6, single / 1e6, batch / 1e6);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mpsc_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#define _GNU_SOURCE  // sched_getaffinity
+
+#include <unity.h>
+#include <sched.h>
+#include "SensorPipeline.h"
+
+// Test fixtures
+SensorPipeline* p_SensorPipeline;
+
+typedef struct {
+    unsigned long perType[4];
+    unsigned long long lastTimestamp;
+    unsigned long outOfOrder;
+} Collector;
+
+void setUp(void) {
+    p_SensorPipeline = SensorPipeline_Create(16, 64);
+}
+
+void tearDown(void) {
+    SensorPipeline_Destroy(p_SensorPipeline);
+}
+
+/* parallel mode calls this from up to three threads, one per gas type */
+static void collect(void* instance, const GasData* data) {
+    Collector* c = (Collector*)instance;
+    __atomic_fetch_add(&c->perType[data->gType], 1, __ATOMIC_RELAXED);
+}
+
+static void collectInOrder(void* instance, const GasData* data) {
+    Collector* c = (Collector*)instance;
+    c->perType[data->gType]++;
+    if (data->timestamp < c->lastTimestamp) {
+        c->outOfOrder++;
+    }
+    c->lastTimestamp = data->timestamp;
+}
+
+void test_add_sensor_checks_type_and_capacity(void) {
+    SensorPipeline* small = SensorPipeline_Create(2, 64);
+
+    TEST_ASSERT_NULL(SensorPipeline_Create(4, 100));  // capacity must be a power of two
+    TEST_ASSERT_EQUAL_INT(-1, SensorPipeline_addSensor(small, UNKNOWN_GAS, PIPELINE_NO_CPU));
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_addSensor(small, O2_GAS, PIPELINE_NO_CPU));
+    TEST_ASSERT_EQUAL_INT(1, SensorPipeline_addSensor(small, HE_GAS, PIPELINE_NO_CPU));
+    TEST_ASSERT_EQUAL_INT(-1, SensorPipeline_addSensor(small, N2_GAS, PIPELINE_NO_CPU));
+    SensorPipeline_Destroy(small);
+}
+
+void test_parallel_mode_delivers_every_reading_to_its_shard(void) {
+    Collector c = {{0}, 0, 0};
+    static const GAS_TYPE types[] = {O2_GAS, O2_GAS, O2_GAS, N2_GAS, HE_GAS, HE_GAS};
+
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(SensorPipeline_addSensor(p_SensorPipeline, types[i], PIPELINE_NO_CPU) >= 0);
+    }
+    SensorPipeline_setHandler(p_SensorPipeline, &c, collect);
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(p_SensorPipeline, 20000, PIPELINE_PARALLEL));
+
+    TEST_ASSERT_EQUAL_UINT(60000, c.perType[O2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[N2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(40000, c.perType[HE_GAS]);
+    TEST_ASSERT_EQUAL_UINT(60000, SensorPipeline_getConsumed(p_SensorPipeline, O2_GAS));
+    TEST_ASSERT_TRUE(GasDataQueue_isEmpty(SensorPipeline_getQueue(p_SensorPipeline, HE_GAS)));
+}
+
+void test_merged_mode_orders_readings_by_timestamp(void) {
+    Collector c = {{0}, 0, 0};
+
+    SensorPipeline_addSensor(p_SensorPipeline, O2_GAS, PIPELINE_NO_CPU);
+    SensorPipeline_addSensor(p_SensorPipeline, N2_GAS, PIPELINE_NO_CPU);
+    SensorPipeline_addSensor(p_SensorPipeline, HE_GAS, PIPELINE_NO_CPU);
+    SensorPipeline_setHandler(p_SensorPipeline, &c, collectInOrder);
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(p_SensorPipeline, 20000, PIPELINE_MERGED));
+
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[O2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[N2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[HE_GAS]);
+    TEST_ASSERT_EQUAL_UINT(0, c.outOfOrder);
+}
+
+void test_merged_mode_orders_several_sensors_per_type(void) {
+    Collector c = {{0}, 0, 0};
+    static const GAS_TYPE types[] = {O2_GAS, O2_GAS, O2_GAS, N2_GAS, N2_GAS, HE_GAS, HE_GAS, HE_GAS};
+
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(SensorPipeline_addSensor(p_SensorPipeline, types[i], PIPELINE_NO_CPU) >= 0);
+    }
+    SensorPipeline_setHandler(p_SensorPipeline, &c, collectInOrder);
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(p_SensorPipeline, 10000, PIPELINE_MERGED));
+
+    TEST_ASSERT_EQUAL_UINT(30000, c.perType[O2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[N2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(30000, c.perType[HE_GAS]);
+    TEST_ASSERT_EQUAL_UINT(30000, SensorPipeline_getConsumed(p_SensorPipeline, HE_GAS));
+    TEST_ASSERT_EQUAL_UINT(0, c.outOfOrder);
+}
+
+void test_back_pressure_is_retried_not_dropped(void) {
+    Collector c = {{0}, 0, 0};
+    SensorPipeline* tiny = SensorPipeline_Create(4, 2);
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(SensorPipeline_addSensor(tiny, O2_GAS, PIPELINE_NO_CPU) >= 0);
+    }
+    SensorPipeline_setHandler(tiny, &c, collect);
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(tiny, 5000, PIPELINE_PARALLEL));
+
+    TEST_ASSERT_EQUAL_UINT(20000, c.perType[O2_GAS]);
+    TEST_ASSERT_EQUAL_UINT(0, GasDataQueue_getDropped(SensorPipeline_getQueue(tiny, O2_GAS)));
+    TEST_ASSERT_EQUAL_UINT(0, SensorPipeline_getRetries(tiny, N2_GAS));
+    SensorPipeline_Destroy(tiny);
+}
+
+void test_threads_can_be_pinned(void) {
+    Collector c = {{0}, 0, 0};
+    cpu_set_t allowed;
+    size_t cpu = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+    while (!CPU_ISSET(cpu, &allowed)) {
+        cpu++;
+    }
+    SensorPipeline_addSensor(p_SensorPipeline, O2_GAS, (int)cpu);
+    SensorPipeline_addSensor(p_SensorPipeline, N2_GAS, (int)cpu);
+    SensorPipeline_setConsumerCpu(p_SensorPipeline, O2_GAS, (int)cpu);
+    SensorPipeline_setHandler(p_SensorPipeline, &c, collect);
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(p_SensorPipeline, 1000, PIPELINE_PARALLEL));
+    TEST_ASSERT_EQUAL_INT(0, p_SensorPipeline->pinFailures);
+    TEST_ASSERT_EQUAL_UINT(1000, c.perType[N2_GAS]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_add_sensor_checks_type_and_capacity);
+    RUN_TEST(test_parallel_mode_delivers_every_reading_to_its_shard);
+    RUN_TEST(test_merged_mode_orders_readings_by_timestamp);
+    RUN_TEST(test_merged_mode_orders_several_sensors_per_type);
+    RUN_TEST(test_back_pressure_is_retried_not_dropped);
+    RUN_TEST(test_threads_can_be_pinned);
+    return UNITY_END();
+}
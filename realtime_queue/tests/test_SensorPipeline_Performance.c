@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "SensorPipeline.h"
+
+/*
+    Readings per second through the sharded pipeline as the number of
+    simulated sensors grows from 3 to 64, for both consumer modes. The
+    total number of readings is the same at every size.
+*/
+
+#define TOTAL_READINGS 600000ul
+#define QUEUE_CAPACITY 1024u
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sink(void* instance, const GasData* data) {
+    (void)instance;
+    (void)data;
+}
+
+static double readingsPerSecond(int sensors, PipelineMode mode) {
+    SensorPipeline* pipeline = SensorPipeline_Create(sensors, QUEUE_CAPACITY);
+    unsigned long perSensor = TOTAL_READINGS / (unsigned long)sensors;
+    unsigned long consumed = 0;
+    double start;
+    double elapsed;
+
+    TEST_ASSERT_NOT_NULL(pipeline);
+    for (int i = 0; i < sensors; i++) {
+        SensorPipeline_addSensor(pipeline, (GAS_TYPE)(O2_GAS + i % PIPELINE_SHARDS), PIPELINE_NO_CPU);
+    }
+    SensorPipeline_setHandler(pipeline, NULL, sink);
+
+    start = seconds();
+    TEST_ASSERT_EQUAL_INT(0, SensorPipeline_run(pipeline, perSensor, mode));
+    elapsed = seconds() - start;
+
+    consumed = SensorPipeline_getConsumed(pipeline, O2_GAS) + SensorPipeline_getConsumed(pipeline, N2_GAS)
+             + SensorPipeline_getConsumed(pipeline, HE_GAS);
+    TEST_ASSERT_EQUAL_UINT(perSensor * (unsigned long)sensors, consumed);
+    SensorPipeline_Destroy(pipeline);
+    return (double)consumed / elapsed;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_readings_per_second_by_sensor_count(void) {
+    static const int sensorCounts[] = {3, 6, 12, 24, 48, 64};
+
+    printf("\n  %ld online CPUs\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("  %-8s %20s %20s\n", "sensors", "parallel readings/s", "merged readings/s");
+    for (size_t i = 0; i < sizeof(sensorCounts) / sizeof(sensorCounts[0]); i++) {
+        double parallel = readingsPerSecond(sensorCounts[i], PIPELINE_PARALLEL);
+        double merged = readingsPerSecond(sensorCounts[i], PIPELINE_MERGED);
+        printf("  %-8d %20.0f %20.0f\n", sensorCounts[i], parallel, merged);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_readings_per_second_by_sensor_count);
+    return UNITY_END();
+}